@@ -5,6 +5,7 @@
 #include <stdexcept>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 
 namespace m {
@@ -27,9 +28,11 @@ struct ConditionPropertyMap
         }
     };
 
+    public:
     using map_t = std::conditional_t<Ordered, std::vector<std::pair<Schema::Identifier, Property>>,
                                               std::unordered_map<Schema::Identifier, Property, IdentifierHash>>;
 
+    private:
     map_t attrs;
 
     public:
@@ -150,35 +153,67 @@ struct Sortedness final : Condition
     enum Order { O_ASC, O_DESC, O_UNDEF /* undefined for single tuple results */ };
 
     using order_t = ConditionPropertyOrderedMap<Order>;
+    ///> pairs of attributes with equal values in every tuple, e.g. the keys of an equi-join
+    using equivalences_t = std::vector<std::pair<Schema::Identifier, Schema::Identifier>>;
 
     private:
     order_t orders_;
+    ///> equivalent attributes share the same position in the lexicographical sort order
+    equivalences_t equivalences_;
 
     public:
     explicit Sortedness(order_t orders) : orders_(orders) { }
+    Sortedness(order_t orders, equivalences_t equivalences)
+        : orders_(std::move(orders))
+        , equivalences_(std::move(equivalences))
+    { }
 
     Sortedness() = default;
     explicit Sortedness(const Sortedness&) = default;
     Sortedness(Sortedness&&) = default;
 
     private:
-    std::unique_ptr<Condition> clone() const override { return std::make_unique<Sortedness>(orders_); }
+    std::unique_ptr<Condition> clone() const override {
+        return std::make_unique<Sortedness>(orders_, equivalences_);
+    }
 
     public:
     order_t & orders() { return orders_; }
     const order_t & orders() const { return orders_; }
 
+    const equivalences_t & equivalences() const { return equivalences_; }
+    /** Declares that \p first and \p second have equal values in every tuple.  Hence, data sorted by one of them is
+     * sorted by the other as well. */
+    void add_equivalence(Schema::Identifier first, Schema::Identifier second) {
+        if (first != second)
+            equivalences_.emplace_back(std::move(first), std::move(second));
+    }
+
+    /** Returns all attributes transitively equivalent to \p id, including \p id itself. */
+    std::vector<Schema::Identifier> equivalence_class(const Schema::Identifier &id) const;
+
+    /** Returns an iterator to the order of \p id or, if \p id is not sorted itself, to the order of an attribute
+     * equivalent to \p id.  Returns `orders().cend()` if no such order exists. */
+    order_t::map_t::const_iterator find(const Schema::Identifier &id) const;
+
+    /** Returns for each entry of `orders()` its position in the lexicographical sort order.  Entries that are
+     * equivalent to a preceding entry share the position of that entry. */
+    std::vector<std::size_t> positions() const;
+
     bool implied_by(const Condition &o) const override {
         auto other = cast<const Sortedness>(&o);
         if (not other) return false;
 
+        const auto this_positions = this->positions();
+        const auto other_positions = other->positions();
         for (auto this_it = this->orders_.begin(); this_it != this->orders_.end(); ++this_it) {
-            const auto other_it = other->orders_.find(this_it->first);
+            const auto other_it = other->find(this_it->first);
             if (other_it == other->orders_.cend())
-                return false; // attribute not found
+                return false; // neither attribute nor an equivalent one found
             if (other_it->second == O_UNDEF or this_it->second == O_UNDEF)
                 continue; // sort order undefined implies attribute order does not matter
-            if (std::distance(this_it, this->orders_.begin()) != std::distance(other_it, other->orders_.cbegin()))
+            if (this_positions[std::distance(this->orders_.begin(), this_it)] !=
+                other_positions[std::distance(other->orders_.cbegin(), other_it)])
                 return false; // different attribute order
             if (this_it->second != other_it->second)
                 return false; // opposite sort order
@@ -186,14 +221,16 @@ struct Sortedness final : Condition
         return true;
     }
 
-    void project_and_rename(const std::vector<std::pair<Schema::Identifier, Schema::Identifier>> &old2new) override {
-        orders_.project_and_rename(old2new);
-    }
+    /** Projects and renames the sort order and the equivalences.  In contrast to other conditions, the order of
+     * attributes is retained rather than taken from \p old2new.  An attribute mapped to multiple new identifiers
+     * yields equivalent attributes.  If all attributes at a position with defined order are projected away, the sort
+     * order is truncated right before that position. */
+    void project_and_rename(const std::vector<std::pair<Schema::Identifier, Schema::Identifier>> &old2new) override;
 
     bool operator==(const Condition &o) const override {
         auto other = cast<const Sortedness>(&o);
         if (not other) return false;
-        return this->orders_ == other->orders_;
+        return this->orders_ == other->orders_ and this->equivalences_ == other->equivalences_;
     }
 };
 
@@ -300,6 +337,14 @@ struct ConditionSet
         type2cond_.insert_or_assign(typeid(Cond), std::move(p));
     }
 
+    template<typename Cond>
+    requires std::is_base_of_v<Condition, Cond>
+    void remove_condition() { type2cond_.erase(typeid(Cond)); }
+
+    template<typename Cond>
+    requires std::is_base_of_v<Condition, Cond>
+    bool has_condition() const { return type2cond_.find(typeid(Cond)) != type2cond_.cend(); }
+
     template<typename Cond>
     requires std::is_base_of_v<Condition, Cond>
     Cond & get_condition() {
@@ -100,7 +100,7 @@ struct Base : crtp<Actual, Base>
     };
 
     private:
-    static state_counters_t state_counters_;
+    static thread_local state_counters_t state_counters_;
 
     public:
     static void RESET_STATE_COUNTERS() { state_counters_ = state_counters_t(); }
@@ -189,7 +189,7 @@ M_LCOV_EXCL_STOP
 
 #ifdef COUNTERS
 template<typename Actual>
-typename Base<Actual>::state_counters_t
+thread_local typename Base<Actual>::state_counters_t
 Base<Actual>::state_counters_;
 #endif
 
@@ -203,7 +203,7 @@ struct SubproblemsArray : Base<SubproblemsArray>
 
     private:
     ///> class-wide allocator, used by all instances
-    static allocator_type allocator_;
+    static thread_local allocator_type allocator_;
 
     public:
     ///> returns a reference to the class-wide allocator
@@ -420,7 +420,7 @@ struct SubproblemTableBottomUp : Base<SubproblemTableBottomUp>
 
     private:
     ///> class-wide allocator, used by all instances
-    static allocator_type allocator_;
+    static thread_local allocator_type allocator_;
 
     public:
     ///> returns a reference to the class-wide allocator
@@ -645,7 +645,7 @@ struct EdgesBottomUp : Base<EdgesBottomUp>
 
     private:
     ///> class-wide allocator, used by all instances
-    static allocator_type allocator_;
+    static thread_local allocator_type allocator_;
 
     public:
     ///> returns a reference to the class-wide allocator
@@ -956,7 +956,7 @@ struct EdgePtrBottomUp : Base<EdgePtrBottomUp>
             state->compute_datasource_to_subproblem_index(G, subproblems, datasource_to_subproblem);
         }
     };
-    static Scratchpad scratchpad_;
+    static thread_local Scratchpad scratchpad_;
 
     private:
     mutable double g_;
@@ -19,7 +19,7 @@ namespace pe {
 
 struct enumerate_tag : const_virtual_crtp_helper<enumerate_tag>::
     returns<void>::
-    crtp_args<PlanTableSmallOrDense&, PlanTableLargeAndSparse&>::
+    crtp_args<PlanTableSmallOrDense&, PlanTableLargeAndSparse&, PlanTableCompact&>::
     args<const QueryGraph&, const CostFunction&> { };
 
 /** An interface for all plan enumerators. */
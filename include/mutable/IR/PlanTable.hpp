@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -16,6 +17,7 @@
 #include <mutable/util/list_allocator.hpp>
 #include <mutable/util/malloc_allocator.hpp>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -369,6 +371,255 @@ struct M_EXPORT PlanTableLargeAndSparse : PlanTableBase<PlanTableLargeAndSparse>
     static size_type OnoLohmannCycle(size_type N) { return N*N - N + 1; }
 };
 
+/** This table represents all explored plans with their sub-plans, estimated size, cost, and further optional
+ * properties.  The `PlanTableCompact` is optimized for "very large" queries, i.e. queries of so many relations that the
+ * `PlanTableLargeAndSparse` exhausts memory.
+ *
+ * Entries are allocated from a pool of fixed-size chunks and located through an open-addressing index of 32 bit entry
+ * indices.  The `DataModel`s of joins are materialized lazily: at most `max_models()` of them are kept at a time and,
+ * when more are needed, the least recently materialized ones are evicted.  An evicted `DataModel` is materialized
+ * again on the next access to its entry, by the `CardinalityEstimator` of the last `update()` estimating the same join
+ * with the same condition that computed the `DataModel` originally.  `DataModel`s set from outside the table, e.g.
+ * those of single data sources, are never evicted.  Eviction requires the `QueryGraph` and is hence disabled for tables
+ * constructed from the number of sources only.  Since the `DataModel`s of joins merely cache estimates, they are also
+ * materialized on accesses to a `const` table. */
+struct M_EXPORT PlanTableCompact : PlanTableBase<PlanTableCompact>
+{
+    friend struct PlanTableDecorator<PlanTableCompact>;
+
+    using allocator_type = malloc_allocator;
+
+    static constexpr size_type CHUNK_SIZE = 1024; ///< number of entries per chunk
+    static constexpr size_type DEFAULT_MAX_MODELS = 1UL << 16; ///< default number of evictable `DataModel`s kept
+
+    /** Statistics of the memory used by a `PlanTableCompact`. */
+    struct memory_statistics
+    {
+        size_type num_entries; ///< number of entries
+        size_type num_models; ///< number of currently materialized, evictable `DataModel`s
+        size_type num_evictions; ///< number of `DataModel`s evicted so far
+        size_type num_materializations; ///< number of evicted `DataModel`s materialized again so far
+        size_type bytes_entries; ///< bytes allocated for entries and their keys
+        size_type bytes_index; ///< bytes allocated for the index and the eviction queue
+
+        friend std::ostream & operator<<(std::ostream &out, const memory_statistics &stats) {
+            return out << stats.num_entries << " entries, " << stats.num_models << " models, "
+                       << stats.num_evictions << " evictions, " << stats.num_materializations << " materializations, "
+                       << stats.bytes_entries << " bytes of entries, " << stats.bytes_index << " bytes of index";
+        }
+    };
+
+    private:
+    static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
+    ///> the allocator of chunks
+    allocator_type allocator_;
+    ///> the number of `DataSource`s in the query
+    size_type num_sources_ = 0;
+    ///> the `QueryGraph` to materialize evicted `DataModel`s for; `nullptr` disables eviction
+    const QueryGraph *G_ = nullptr;
+    ///> the `CardinalityEstimator` of the last `update()`, which materializes evicted `DataModel`s
+    const CardinalityEstimator *CE_ = nullptr;
+    ///> the maximum number of evictable `DataModel`s kept
+    size_type max_models_ = DEFAULT_MAX_MODELS;
+    ///> the chunks of `PlanTableEntry`s; the `i`-th entry is at position `i % CHUNK_SIZE` of chunk `i / CHUNK_SIZE`
+    std::vector<std::unique_ptr<PlanTableEntry[]>> chunks_;
+    ///> the `Subproblem` of each entry, in order of allocation
+    std::vector<Subproblem> keys_;
+    ///> the split of each entry whose join computed its evictable `DataModel`; empty if the table did not compute it
+    std::vector<std::pair<Subproblem, Subproblem>> model_splits_;
+    ///> the join condition of the split in `model_splits_` of each entry, if not empty
+    std::unordered_map<uint32_t, cnf::CNF> model_conditions_;
+    ///> open-addressing index with linear probing, mapping `Subproblem`s to entries; size is a power of two
+    std::vector<uint32_t> index_;
+    ///> entries with evictable `DataModel`s in order of materialization; may contain entries evicted since
+    mutable std::deque<uint32_t> materialized_;
+    ///> the number of evictable `DataModel`s currently materialized
+    mutable size_type num_models_ = 0;
+    size_type num_evictions_ = 0;
+    mutable size_type num_materializations_ = 0;
+
+    public:
+    friend void swap(PlanTableCompact &first, PlanTableCompact &second) {
+        using std::swap;
+        swap(first.allocator_,            second.allocator_);
+        swap(first.num_sources_,          second.num_sources_);
+        swap(first.G_,                    second.G_);
+        swap(first.CE_,                   second.CE_);
+        swap(first.max_models_,           second.max_models_);
+        swap(first.chunks_,               second.chunks_);
+        swap(first.keys_,                 second.keys_);
+        swap(first.model_splits_,         second.model_splits_);
+        swap(first.model_conditions_,     second.model_conditions_);
+        swap(first.index_,                second.index_);
+        swap(first.materialized_,         second.materialized_);
+        swap(first.num_models_,           second.num_models_);
+        swap(first.num_evictions_,        second.num_evictions_);
+        swap(first.num_materializations_, second.num_materializations_);
+    }
+
+    PlanTableCompact() = default;
+    explicit PlanTableCompact(size_type num_sources, size_type num_additional_entries = 0,
+                              allocator_type allocator = allocator_type())
+        : allocator_(std::move(allocator))
+        , num_sources_(num_sources)
+    {
+        const size_type expected = num_sources_ * num_sources_ - num_sources_ + 1 + num_additional_entries;
+        keys_.reserve(expected);
+        model_splits_.reserve(expected);
+        index_.assign(std::max<size_type>(ceil_to_pow_2(2 * expected), 16), EMPTY_SLOT);
+    }
+    explicit PlanTableCompact(const QueryGraph &G, size_type max_models = DEFAULT_MAX_MODELS)
+        : PlanTableCompact(G.num_sources())
+    {
+        G_ = &G;
+        max_models_ = max_models;
+    }
+
+    PlanTableCompact(const PlanTableCompact&) = delete;
+    PlanTableCompact(PlanTableCompact &&other) : PlanTableCompact() { swap(*this, other); }
+
+    ~PlanTableCompact();
+
+    PlanTableCompact & operator=(PlanTableCompact &&other) { swap(*this, other); return *this; }
+
+    bool operator==(const PlanTableCompact &other) const {
+        if (this->num_sources() != other.num_sources()) return false;
+        if (this->size() != other.size()) return false;
+        for (uint32_t idx = 0; idx != keys_.size(); ++idx) {
+            const uint32_t other_idx = other.find(keys_[idx]);
+            if (other_idx == EMPTY_SLOT)
+                return false;
+            if (this->entry(idx) != other.entry(other_idx))
+                return false;
+        }
+        return true;
+    }
+    bool operator!=(const PlanTableCompact &other) const { return not operator==(other); }
+
+    size_type num_sources() const { return num_sources_; }
+    size_type size() const { return keys_.size(); }
+
+    /** Returns the maximum number of evictable `DataModel`s kept materialized. */
+    size_type max_models() const { return max_models_; }
+    /** Sets the maximum number of evictable `DataModel`s kept materialized.  Takes effect on the next `update()`. */
+    void max_models(size_type max_models) { max_models_ = max_models; }
+
+    /** Returns statistics of the memory currently used by this table. */
+    memory_statistics memory_usage() const {
+        return {
+            .num_entries = size(),
+            .num_models = num_models_,
+            .num_evictions = num_evictions_,
+            .num_materializations = num_materializations_,
+            .bytes_entries = chunks_.size() * CHUNK_SIZE * sizeof(PlanTableEntry) +
+                             keys_.capacity() * sizeof(Subproblem),
+            .bytes_index = index_.capacity() * sizeof(uint32_t) + materialized_.size() * sizeof(uint32_t),
+        };
+    }
+
+    PlanTableEntry & at(Subproblem s) {
+        const uint32_t idx = find(s);
+        if (idx == EMPTY_SLOT)
+            throw std::out_of_range("no entry for the given subproblem");
+        return materialize(idx);
+    }
+    const PlanTableEntry & at(Subproblem s) const {
+        const uint32_t idx = find(s);
+        if (idx == EMPTY_SLOT)
+            throw std::out_of_range("no entry for the given subproblem");
+        return materialize(idx);
+    }
+
+    PlanTableEntry & operator[](Subproblem s) {
+        uint32_t idx = find(s);
+        if (idx == EMPTY_SLOT)
+            idx = insert(s);
+        return materialize(idx);
+    }
+    const PlanTableEntry & operator[](Subproblem s) const { return at(s); }
+
+    bool has_plan(Subproblem s) const {
+        if (s.size() == 1) return true;
+        if (const uint32_t idx = find(s); idx != EMPTY_SLOT) {
+            auto &e = entry(idx);
+            M_insist(e.left.empty() == e.right.empty(), "either both sides are not set or both sides are set");
+            return not e.left.empty();
+        } else {
+            return false;
+        }
+    }
+
+    /** Update the entry for `left` joined with `right` (`left|right`) by considering plan `left` join `right`.  Before
+     * that, evicts `DataModel`s until at most `max_models()` are kept, sparing those of `left`, `right`, and
+     * `left|right`.  See `PlanTableBase::update()`. */
+    void update(const QueryGraph &G, const CardinalityEstimator &CE, const CostFunction &CF,
+                Subproblem left, Subproblem right, const cnf::CNF &condition)
+    {
+        CE_ = &CE;
+        evict(left, right);
+        auto &e = operator[](left | right);
+        const bool had_model = bool(e.model);
+        PlanTableBase::update(G, CE, CF, left, right, condition);
+        if (not had_model and e.model and G_) {
+            /*----- Remember how the model was computed, to compute it identically once it was evicted. -----*/
+            const uint32_t idx = find(left | right);
+            model_splits_[idx] = { left, right };
+            if (condition.empty())
+                model_conditions_.erase(idx);
+            else
+                model_conditions_.insert_or_assign(idx, condition);
+            materialized_.push_back(idx);
+            ++num_models_;
+        }
+    }
+
+    void reset_costs() {
+        for (uint32_t idx = 0; idx != keys_.size(); ++idx) {
+            if (not keys_[idx].is_singleton())
+                entry(idx).cost = std::numeric_limits<decltype(PlanTableEntry::cost)>::infinity();
+        }
+    }
+
+    private:
+    PlanTableEntry & entry(uint32_t idx) { return chunks_[idx / CHUNK_SIZE][idx % CHUNK_SIZE]; }
+    const PlanTableEntry & entry(uint32_t idx) const { return chunks_[idx / CHUNK_SIZE][idx % CHUNK_SIZE]; }
+
+    /** Returns the index of the entry of `s`, or `EMPTY_SLOT` if there is none. */
+    uint32_t find(Subproblem s) const {
+        if (index_.empty()) return EMPTY_SLOT;
+        const size_type mask = index_.size() - 1;
+        for (size_type slot = SubproblemHash{}(s) & mask; ; slot = (slot + 1) & mask) {
+            const uint32_t idx = index_[slot];
+            if (idx == EMPTY_SLOT or keys_[idx] == s)
+                return idx;
+        }
+    }
+
+    /** Allocates a new entry for `s`, which must not have an entry yet, and returns its index. */
+    uint32_t insert(Subproblem s);
+
+    /** Materializes the evicted `DataModel` of the entry at `idx`, if any, and returns the entry.  Since `DataModel`s
+     * of joins merely cache estimates, this is permitted on a `const` table. */
+    PlanTableEntry & materialize(uint32_t idx) const;
+
+    /** Evicts `DataModel`s until at most `max_models()` are kept, sparing those of `left`, `right`, and `left|right`. */
+    void evict(Subproblem left, Subproblem right);
+
+    auto begin() {
+        return projecting_iterator(keys_.begin(), [this](auto it) -> auto& { return entry(it - keys_.begin()); });
+    }
+    auto end() {
+        return projecting_iterator(keys_.end(), [this](auto it) -> auto& { return entry(it - keys_.begin()); });
+    }
+
+    public:
+    friend std::ostream & M_EXPORT operator<<(std::ostream &out, const PlanTableCompact &PT);
+
+    void dump(std::ostream &out) const;
+    void dump() const;
+};
+
 template<typename Actual>
 requires requires { typename PlanTableBase<Actual>; }
 struct M_EXPORT PlanTableDecorator
@@ -16,6 +16,7 @@ struct M_EXPORT Options
         PT_auto,
         PT_SmallOrDense,
         PT_LargeAndSparse,
+        PT_Compact,
     };
 
     /*----- Help -----------------------------------------------------------------------------------------------------*/
@@ -60,6 +61,31 @@ struct M_EXPORT Options
     const char *injected_cardinalities_file;
     const char *output_partial_plans_file;
 
+    /** If `true`, compress tables after importing data into them, see `m::compress()`. */
+    bool compress_imports;
+
+    /** If `true`, `CREATE INDEX` bulkloads indexes in the background.  Meanwhile, queries do not use the index. */
+    bool async_index_build;
+    /** The time in milliseconds a command may execute before it is interrupted, or 0 for no limit.  Applies to the
+     * commands executed by `Scheduler::autocommit()`, e.g. the statements of the shell. */
+    unsigned query_timeout = 0;
+
+    /*----- Memory configuration. ------------------------------------------------------------------------------------*/
+    /** If `true`, back the memory of stores with transparent huge pages. */
+    bool transparent_huge_pages = false;
+    /** If `true`, back the memory of stores with explicitly reserved huge pages. */
+    bool explicit_huge_pages = false;
+    /** The NUMA node to bind the memory of stores to, or -1 to not bind the memory. */
+    int numa_node = -1;
+
+    /*----- Durability. ----------------------------------------------------------------------------------------------*/
+    /** The path of the write-ahead log, or `nullptr` to not log committed transactions. */
+    const char *wal = nullptr;
+    /** The size of the write-ahead log in bytes that triggers a checkpoint. */
+    unsigned long wal_checkpoint_size = 64UL << 20;
+    /** The time in microseconds the write-ahead log waits for more commits before every flush. */
+    unsigned wal_group_commit_delay = 0;
+
     /** If `true`, run the procedure to train cost models for query building blocks at startup. */
     bool train_cost_models;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <memory>
 #include <mutable/backend/Backend.hpp>
 #include <mutable/storage/Index.hpp>
@@ -7,7 +8,11 @@
 #include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/memory.hpp>
+#include <mutable/util/Timer.hpp>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 
 namespace m {
@@ -22,6 +27,60 @@ struct WasmEngine
     /** The alignment that is suitable for all built-in types. */
     static constexpr std::size_t WASM_ALIGNMENT = 8;
 
+    /** The size of the window in linear memory a table is mapped into.  Tables exceeding this size are mapped and
+     * scanned chunk by chunk, such that queries may access far more base data than fits into linear memory. */
+    static inline std::size_t table_window_size = 1UL << 30;
+
+    /** Returns the number of bytes required to map all rows of \p table into linear memory. */
+    static std::size_t Table_Size_In_Bytes(const Table &table);
+
+    /** Returns `true` iff \p table exceeds `table_window_size` and must hence be mapped chunk by chunk. */
+    static bool Is_Chunked(const Table &table) { return Table_Size_In_Bytes(table) > table_window_size; }
+
+    /** Returns the name of the global holding the address of \p dict in linear memory. */
+    static std::string Dictionary_Global_Name(const storage::Dictionary &dict);
+
+    /** A `MappingArena` is a long-lived virtual address space in which the memory of tables and dictionaries stays
+     * mapped across queries.  The arena is lent to one `WasmContext` at a time as its linear memory.  Memory that is
+     * already mapped into the arena is reused without any `mmap()`, and is only mapped anew once it outgrows its
+     * mapping.  All other contents of the linear memory, e.g. the heap, are mapped anew by each `WasmContext` past the
+     * `top` of the arena.  The mappings of the memory of an allocator are released when the allocator is destroyed,
+     * e.g. when its table is dropped, and all mappings are released when the arena is destroyed. */
+    struct MappingArena
+    {
+        /** The maximum `top` of the arena.  An arena exceeding it is discarded when it is lent the next time, which
+         * releases the mappings of memory that outgrew its mapping or that was deallocated. */
+        static constexpr std::size_t MAX_TOP = WASM_MAX_MEMORY / 2;
+
+        /** A mapping of memory into the arena. */
+        struct mapping_t
+        {
+            uint32_t off; ///< the address of the mapping in linear memory
+            std::size_t capacity; ///< the number of mapped bytes
+        };
+
+        std::mutex mutex; ///< protects all other members against concurrent `WasmContext`s and destroyed allocators
+        memory::AddressSpace vm = memory::AddressSpace(0); ///< the address space, empty while lent
+        bool is_lent = false; ///< whether the arena is currently lent to a `WasmContext`
+        uint32_t top = 0; ///< the end of all mappings, encoded as offset from the beginning of `vm`
+        ///> maps the ID of the allocator and the offset of mapped memory to its mapping
+        std::map<std::pair<uint64_t, std::size_t>, mapping_t> mappings;
+        ///> the mappings of destroyed allocators that are released once the arena is returned
+        std::vector<mapping_t> released;
+
+        MappingArena();
+        ~MappingArena();
+        MappingArena(const MappingArena&) = delete;
+
+        /** Releases the mappings of the memory of the allocator with ID \p allocator_id.  Installed as
+         * `memory::Allocator::on_destroy`. */
+        static void Release_Mappings(uint64_t allocator_id);
+
+        /** Replaces mapping \p mapping by inaccessible memory, such that the mapped memory can be freed.  The arena
+         * must not be lent. */
+        void unmap(const mapping_t &mapping);
+    };
+
     /** A `WasmContext` holds associated information of a WebAssembly module instance. */
     struct WasmContext
     {
@@ -32,6 +91,7 @@ struct WasmEngine
 
         private:
         config_t config_;
+        bool uses_arena_; ///< whether `vm` is lent from the `MappingArena`
 
         public:
         unsigned id; ///< a unique ID
@@ -42,19 +102,91 @@ struct WasmEngine
         uint32_t heap = 0; ///< beginning of the heap, encoded as offset from the beginning of the virtual address space
         std::vector<std::reference_wrapper<const idx::IndexBase>> indexes; ///< the indexes used in the query
 
+        /** A window in linear memory that successive chunks of a table are mapped into. */
+        struct table_window_t
+        {
+            std::reference_wrapper<const Table> table;
+            uint32_t off; ///< the address of the window in linear memory
+            std::size_t rows_per_chunk; ///< the number of rows of each chunk but the last
+            std::size_t bytes_per_chunk; ///< the page-aligned size of each chunk, i.e.\ the size of the window
+        };
+        std::vector<table_window_t> table_windows; ///< the windows of all tables mapped chunk by chunk
+
+        /** Runtime feedback on the execution of `plan`.  If enabled, the module counts the tuples that each operator
+         * produces in each pipeline, and the host times each pipeline, see `report_feedback()`. */
+        struct feedback_t
+        {
+            /** A counter in linear memory of the tuples that an operator produces into a pipeline. */
+            struct counter_t
+            {
+                std::reference_wrapper<const Operator> op; ///< the logical operator producing the tuples
+                std::size_t pipeline; ///< the pipeline consuming the tuples
+                uint64_t *num_tuples; ///< the counter, i.e.\ its address in the host
+            };
+
+            bool is_enabled = false; ///< whether feedback is collected; must be decided before compilation
+            std::vector<counter_t> counters;
+            std::vector<Timer::duration> pipeline_times; ///< the time spent in each pipeline, excluding nested ones
+            ///> the pipelines currently executing, innermost last, e.g.\ a buffer resuming its pipeline when full
+            std::vector<std::size_t> active_pipelines;
+            Timer::time_point last_switch; ///< the time the innermost active pipeline was entered or resumed
+            std::size_t pipeline = 0; ///< the pipeline whose code is currently generated
+            std::size_t depth = 0; ///< the number of setups of the current pipeline whose teardown is not yet generated
+        };
+        feedback_t feedback;
+
+        /** Enters pipeline \p pipeline while executing the module and pauses the timing of the current pipeline. */
+        void enter_pipeline(std::size_t pipeline);
+        /** Leaves pipeline \p pipeline while executing the module and resumes the timing of the enclosing pipeline. */
+        void leave_pipeline(std::size_t pipeline);
+
         WasmContext(uint32_t id, const MatchBase &plan, config_t configuration, std::size_t size);
+        ~WasmContext();
 
         bool config(config_t cfg) const { return bool(cfg & config_); }
+        /** Returns `true` iff `vm` is lent from the `MappingArena`. */
+        bool uses_arena() const { return uses_arena_; }
 
         /** Maps a table at the current start of `heap` and advances `heap` past the mapped region.  Returns the address
          * (in linear memory) of the mapped table.  Installs guard pages after each mapping.  Acknowledges
-         * `TRAP_GUARD_PAGES`.  */
+         * `TRAP_GUARD_PAGES`.  If the table `Is_Chunked()`, reserves a window for the table instead, maps the first
+         * chunk into that window, and returns the address of the window.  */
         uint32_t map_table(const Table &table);
 
+        /** Maps the entries of \p dict at the current start of `heap` and advances `heap` past the mapped region.
+         * Returns the address (in linear memory) of the mapped entries.  Installs a guard page after the mapping. */
+        uint32_t map_dictionary(const storage::Dictionary &dict);
+
+        /** Maps the first \p bytes bytes of \p mem at the current start of `heap`, advances `heap` past the mapped
+         * region, and installs a guard page after the mapping.  If `vm` is lent from the `MappingArena` and \p mem is
+         * already mapped into it with at least \p bytes bytes, returns that mapping and leaves `heap` unchanged.
+         * Returns the address (in linear memory) of the mapping. */
+        uint32_t map_memory(const memory::Memory &mem, std::size_t bytes);
+
+        /** Returns the index in `table_windows` of the window of \p table. */
+        std::size_t table_window(const Table &table) const;
+
+        /** Maps chunk \p chunk of the table of window \p window into that window, replacing the previously mapped
+         * chunk.  Returns the number of rows of the mapped chunk, or 0 if \p chunk lies past the end of the table. */
+        uint32_t map_table_chunk(std::size_t window, std::size_t chunk);
+
         /** Installs a guard page at the current `heap` and increments `heap` to the next page.  Acknowledges
          * `TRAP_GUARD_PAGES`. */
         void install_guard_page();
 
+        /** Returns `true` iff runtime feedback on executing `plan` is consumed, i.e.\ iff the `AdaptiveCostFunction` is
+         * the `CostFunction` in use or the `FeedbackCardinalityEstimator` is the `CardinalityEstimator` of the
+         * `Database` in use.  Plans with a `LimitOperator` are excluded, since they return early from their pipelines
+         * and hence produce incomplete cardinalities. */
+        bool wants_feedback() const;
+
+        /** Reports the runtime feedback collected while executing `plan` to the `AdaptiveCostFunction` and to the
+         * `FeedbackCardinalityEstimator`, if in use.  The latter learns the true cardinalities of the executed
+         * subplans.  An operator consumes the tuples produced by its children.  The time of a pipeline is split among
+         * the operators consuming tuples in it in proportion to the number of tuples each consumes.  This approximates
+         * the time spent in each operator without timing the operators of fused pipelines individually. */
+        void report_feedback() const;
+
         /** Adds an index to the `WasmContext` and returns its position in the vector as id. */
         std::size_t add_index(const idx::IndexBase &index) {
             indexes.emplace_back(index);
@@ -65,6 +197,8 @@ struct WasmEngine
     private:
     ///> maps unique IDs to `WasmContext` instances
     static inline std::unordered_map<unsigned, std::unique_ptr<WasmContext>> contexts_;
+    ///> the arena keeping tables and dictionaries mapped across `WasmContext`s
+    static MappingArena arena_;
 
     public:
     /** Creates a new `WasmContext` for ID `id` with `size` bytes of virtual address space. */
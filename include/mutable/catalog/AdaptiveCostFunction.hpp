@@ -0,0 +1,154 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutable/catalog/CostFunction.hpp>
+#include <mutable/catalog/CostModel.hpp>
+#include <mutable/util/Timer.hpp>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+
+namespace m {
+
+/** A `CostFunction` that continuously recalibrates its `CostModel`s from runtime feedback.
+ *
+ * Backends report for each executed operator the observed cardinalities together with the time spent in that
+ * operator.  For every kind of operator, the most recent `window_size()` observations are kept.  Every
+ * `refit_interval()` observations the respective `CostModel` is refit by linear regression on the observations in the
+ * window.  This way, the cost function tracks the hardware and data the system currently runs on.  Models predict
+ * runtimes in milliseconds, whereas *C_out*, see `CostFunctionCout`, counts tuples.  To keep the costs of plans
+ * comparable, the models are only used once a model was fit for every kind of operator.  Until then, the costs of all
+ * operators are computed like *C_out*.
+ *
+ * The features of the models are
+ *  - filter:   the cardinality of the input and the selectivity of the filter
+ *  - join:     the cardinalities of the left and right input and the cardinality of the result
+ *  - grouping: the cardinality of the input and the number of groups
+ */
+struct M_EXPORT AdaptiveCostFunction : CostFunctionCRTP<AdaptiveCostFunction>
+{
+    static constexpr std::size_t DEFAULT_WINDOW_SIZE = 256;
+    static constexpr std::size_t DEFAULT_REFIT_INTERVAL = 16;
+
+    /** The observations and the current `CostModel` of one kind of operator. */
+    struct Observations
+    {
+        private:
+        std::size_t num_features_; ///< number of features, *excluding* the y-intercept
+        std::deque<Eigen::RowVectorXd> features_; ///< the observed features, *excluding* the y-intercept
+        std::deque<double> targets_; ///< the observed runtimes in milliseconds
+        std::size_t num_since_refit_ = 0; ///< number of observations since the last refit
+        std::unique_ptr<CostModel> model_; ///< the current model; `nullptr` if no model could be fit yet
+
+        public:
+        explicit Observations(std::size_t num_features) : num_features_(num_features) { }
+
+        std::size_t num_features() const { return num_features_; }
+        std::size_t size() const { return targets_.size(); }
+        bool has_model() const { return bool(model_); }
+        const CostModel & model() const { M_insist(has_model()); return *model_; }
+
+        /** Adds an observation.  Evicts the oldest observation if more than `window_size` observations are held.
+         * Returns `true` iff a refit is due after `refit_interval` observations. */
+        bool add(Eigen::RowVectorXd features, double target, std::size_t window_size, std::size_t refit_interval);
+
+        /** Refits the `CostModel` on the held observations.  Keeps the current model if the observations do not
+         * determine a unique model, e.g. because there are too few or because the features are linearly dependent.
+         * Returns `true` iff a new model was fit. */
+        bool refit();
+
+        /** Drops all observations and the current model. */
+        void clear();
+    };
+
+    private:
+    mutable std::mutex mutex_; ///< protects the observations and models against concurrent refitting
+    std::size_t window_size_ = DEFAULT_WINDOW_SIZE;
+    std::size_t refit_interval_ = DEFAULT_REFIT_INTERVAL;
+    Observations filter_{2};
+    Observations join_{3};
+    Observations grouping_{2};
+
+    public:
+    AdaptiveCostFunction() = default;
+    AdaptiveCostFunction(std::size_t window_size, std::size_t refit_interval)
+        : window_size_(window_size)
+        , refit_interval_(refit_interval)
+    {
+        M_insist(refit_interval_ != 0, "refit interval must not be zero");
+    }
+
+    std::size_t window_size() const { return window_size_; }
+    void window_size(std::size_t size) { std::lock_guard lock(mutex_); window_size_ = size; }
+    std::size_t refit_interval() const { return refit_interval_; }
+    void refit_interval(std::size_t interval) {
+        M_insist(interval != 0, "refit interval must not be zero");
+        std::lock_guard lock(mutex_);
+        refit_interval_ = interval;
+    }
+
+    /*----- Feedback -------------------------------------------------------------------------------------------------*/
+    /** Records that a filter consumed `num_tuples_in` tuples, produced `num_tuples_out` tuples, and took `time`. */
+    void observe_filter(std::size_t num_tuples_in, std::size_t num_tuples_out, Timer::duration time);
+    /** Records that a join of `num_tuples_left` and `num_tuples_right` tuples produced `num_tuples_out` tuples and
+     * took `time`. */
+    void observe_join(std::size_t num_tuples_left, std::size_t num_tuples_right, std::size_t num_tuples_out,
+                      Timer::duration time);
+    /** Records that a grouping consumed `num_tuples_in` tuples, produced `num_groups` groups, and took `time`. */
+    void observe_grouping(std::size_t num_tuples_in, std::size_t num_groups, Timer::duration time);
+
+    /** Forces a refit of all models on the currently held observations. */
+    void refit();
+    /** Drops all observations and fit models. */
+    void clear();
+
+    /** Returns the number of observations currently held for filters, joins, and groupings, in that order. */
+    std::tuple<std::size_t, std::size_t, std::size_t> num_observations() const {
+        std::lock_guard lock(mutex_);
+        return { filter_.size(), join_.size(), grouping_.size() };
+    }
+
+    /*----- Cost prediction ------------------------------------------------------------------------------------------*/
+    /** Returns `true` iff a model was fit for every kind of operator, i.e. iff costs are computed by the models rather
+     * than by *C_out*. */
+    bool has_all_models() const {
+        std::lock_guard lock(mutex_);
+        return has_all_models_unlocked();
+    }
+
+    /** Predicts the runtime in milliseconds of a filter, if a model was fit for filters. */
+    std::optional<double> predict_filter(double cardinality, double selectivity) const;
+    /** Predicts the runtime in milliseconds of a join, if a model was fit for joins. */
+    std::optional<double> predict_join(double cardinality_left, double cardinality_right, double result_size) const;
+    /** Predicts the runtime in milliseconds of a grouping, if a model was fit for groupings. */
+    std::optional<double> predict_grouping(double cardinality, double num_groups) const;
+
+    template<typename PlanTable>
+    double operator()(calculate_filter_cost_tag, PlanTable &&PT, const QueryGraph &G,
+                      const CardinalityEstimator &CE, Subproblem sub, const cnf::CNF &condition) const;
+
+    template<typename PlanTable>
+    double operator()(calculate_join_cost_tag, PlanTable &&PT, const QueryGraph &G, const CardinalityEstimator &CE,
+                      Subproblem left, Subproblem right, const cnf::CNF &condition) const;
+
+    template<typename PlanTable>
+    double operator()(calculate_grouping_cost_tag, PlanTable &&PT, const QueryGraph &G,
+                      const CardinalityEstimator &CE, Subproblem sub,
+                      const std::vector<const ast::Expr*> &group_by) const;
+
+    private:
+    bool has_all_models_unlocked() const {
+        return filter_.has_model() and join_.has_model() and grouping_.has_model();
+    }
+
+    public:
+M_LCOV_EXCL_START
+    friend std::ostream & operator<<(std::ostream &out, const AdaptiveCostFunction &CF);
+    void dump(std::ostream &out) const;
+    void dump() const;
+M_LCOV_EXCL_STOP
+};
+
+}
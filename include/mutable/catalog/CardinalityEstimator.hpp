@@ -6,6 +6,8 @@
 #include <mutable/util/ADT.hpp>
 #include <mutable/util/crtp.hpp>
 #include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <unordered_map>
 #include <vector>
@@ -24,6 +26,7 @@ struct Diagnostic;
 struct GroupingOperator;
 struct LimitOperator;
 struct Operator;
+struct PlanTableCompact;
 struct PlanTableLargeAndSparse;
 struct PlanTableSmallOrDense;
 struct QueryGraph;
@@ -45,12 +48,16 @@ struct M_EXPORT DataModel
 
     /** Assigns `this` to the `Subproblem` `s`, i.e. this model now describes the result of evaluating `s`. */
     virtual void assign_to(Subproblem s) = 0;
+
+    /** Returns a deep copy of `this`, e.g. to hand an independent model to each of several concurrent plan
+     * enumerations. */
+    virtual std::unique_ptr<DataModel> clone() const = 0;
 };
 
 
 struct M_EXPORT estimate_join_all_tag : const_virtual_crtp_helper<estimate_join_all_tag>::
     returns<std::unique_ptr<DataModel>>::
-    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&>::
+    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&, const PlanTableCompact&>::
     args<const QueryGraph&, Subproblem, const cnf::CNF&> { };
 
 struct M_EXPORT CardinalityEstimator : estimate_join_all_tag::base_type
@@ -180,6 +187,9 @@ struct M_EXPORT CartesianProductEstimator : CardinalityEstimatorCRTP<CartesianPr
         CartesianProductDataModel(std::size_t size) : size(size) { }
 
         void assign_to(Subproblem) override { /* nothing to be done */ }
+        std::unique_ptr<DataModel> clone() const override {
+            return std::make_unique<CartesianProductDataModel>(*this);
+        }
     };
 
     CartesianProductEstimator() { }
@@ -244,6 +254,9 @@ struct M_EXPORT InjectionCardinalityEstimator : CardinalityEstimatorCRTP<Injecti
         InjectionCardinalityDataModel & operator=(const InjectionCardinalityDataModel &other) = default;
 
         void assign_to(Subproblem s) override { subproblem_ = s; }
+        std::unique_ptr<DataModel> clone() const override {
+            return std::make_unique<InjectionCardinalityDataModel>(*this);
+        }
     };
 
     private:
@@ -251,6 +264,8 @@ struct M_EXPORT InjectionCardinalityEstimator : CardinalityEstimatorCRTP<Injecti
     mutable std::vector<char> buf_;
     ///> buffer used to construct identifiers
     mutable std::ostringstream oss_;
+    ///> protects the buffers against concurrent estimation, e.g. by parallel plan enumeration
+    mutable std::mutex buffer_mutex_;
 
     std::unordered_map<ThreadSafePooledString, std::size_t> cardinality_table_;
     CartesianProductEstimator fallback_;
@@ -317,6 +332,133 @@ struct M_EXPORT InjectionCardinalityEstimator : CardinalityEstimatorCRTP<Injecti
     ThreadSafePooledString make_identifier(const QueryGraph &G, const Subproblem S) const;
 };
 
+/**
+ * FeedbackCardinalityEstimator that learns cardinalities from past queries.
+ *
+ * After executing a plan, the backend reports the true cardinalities of the executed subplans, keyed by the set of
+ * relations they join -- the same identifiers `InjectionCardinalityEstimator` uses.  Later optimizations are served
+ * these cardinalities.  For subproblems that were not observed yet, the estimate of a fallback estimator is used,
+ * scaled by the observed cardinalities of the inputs.  If a feedback file was passed by the user via commandline, the
+ * observed cardinalities are loaded from and persisted to that file in the JSON format of the
+ * `InjectionCardinalityEstimator`, such that they survive restarts.  Changed observations are persisted in batches,
+ * see `persist_if_due()`, and when the estimator is destroyed.
+ */
+struct M_EXPORT FeedbackCardinalityEstimator : CardinalityEstimatorCRTP<FeedbackCardinalityEstimator>
+{
+    using Subproblem = SmallBitset;
+
+    struct FeedbackDataModel : DataModel
+    {
+        friend struct FeedbackCardinalityEstimator;
+
+        private:
+        Subproblem subproblem_;
+        std::size_t size_;
+        std::unique_ptr<DataModel> fallback_; ///< the `DataModel` of the fallback estimator
+
+        public:
+        FeedbackDataModel(Subproblem S, std::size_t size, std::unique_ptr<DataModel> fallback)
+            : subproblem_(S), size_(size), fallback_(std::move(fallback))
+        { }
+
+        void assign_to(Subproblem s) override { subproblem_ = s; fallback_->assign_to(s); }
+        std::unique_ptr<DataModel> clone() const override {
+            return std::make_unique<FeedbackDataModel>(subproblem_, size_, fallback_->clone());
+        }
+    };
+
+    private:
+    ThreadSafePooledString name_of_database_;
+    std::unique_ptr<CardinalityEstimator> fallback_;
+
+    mutable std::mutex mutex_; ///< protects the table against concurrent feedback and estimation
+    std::unordered_map<ThreadSafePooledString, std::size_t> cardinality_table_;
+    ///> the number of changes to the table since it was last persisted
+    mutable std::size_t num_unpersisted_ = 0;
+
+    public:
+    /** Create a `FeedbackCardinalityEstimator` for the database `name_of_database`.  Previously observed cardinalities
+     * are loaded from the feedback file passed by the user via commandline, if any.
+     *
+     * @param name_of_database the name of the database to create the `FeedbackCardinalityEstimator` for
+     */
+    FeedbackCardinalityEstimator(ThreadSafePooledString name_of_database);
+
+    /** Create a `FeedbackCardinalityEstimator` for the database `name_of_database` with previously observed
+     * cardinalities read from the inputstream `in`.
+     *
+     * @param name_of_database the name of the database to create the `FeedbackCardinalityEstimator` for
+     * @param in inputstream containing the observed cardinalities in JSON format
+     * @param fallback the estimator to use for subproblems that were not observed yet
+     */
+    FeedbackCardinalityEstimator(Diagnostic &diag, ThreadSafePooledString name_of_database, std::istream &in,
+                                 std::unique_ptr<CardinalityEstimator> fallback);
+
+    /** Persists the observed cardinalities, see `persist()`. */
+    ~FeedbackCardinalityEstimator();
+
+    FeedbackCardinalityEstimator(const FeedbackCardinalityEstimator&) = delete;
+
+
+    /*==================================================================================================================
+     * Feedback
+     *================================================================================================================*/
+
+    /** Records that joining all `relations`, including the filters applied to them, produced `cardinality` tuples.
+     * Replaces any previous observation of the same relations. */
+    void observe(std::vector<ThreadSafePooledString> relations, std::size_t cardinality);
+
+    /** Returns the observed cardinality of the join of all `DataSource`s in `S`, if any. */
+    std::optional<std::size_t> lookup(const QueryGraph &G, Subproblem S) const;
+
+    /** Returns the number of observed subproblems. */
+    std::size_t num_observations() const { std::lock_guard lock(mutex_); return cardinality_table_.size(); }
+
+    /** Writes the observed cardinalities in the JSON format of the `InjectionCardinalityEstimator` to `out`. */
+    void write_json(std::ostream &out) const;
+
+    /** Persists the observed cardinalities to the feedback file passed by the user via commandline, if any.  Entries
+     * of other databases in that file are preserved. */
+    void persist() const;
+
+    /** Persists the observed cardinalities, see `persist()`, once the number of changed observations since they were
+     * last persisted reaches the interval passed by the user via commandline. */
+    void persist_if_due() const;
+
+
+    /*==================================================================================================================
+     * Model calculation
+     *================================================================================================================*/
+
+    std::unique_ptr<DataModel> empty_model() const override;
+    std::unique_ptr<DataModel> estimate_scan(const QueryGraph &G, Subproblem P) const override;
+    std::unique_ptr<DataModel>
+    estimate_filter(const QueryGraph &G, const DataModel &data, const cnf::CNF &filter) const override;
+    std::unique_ptr<DataModel>
+    estimate_limit(const QueryGraph &G, const DataModel &data, std::size_t limit, std::size_t offset) const override;
+    std::unique_ptr<DataModel>
+    estimate_grouping(const QueryGraph &G, const DataModel &data, const std::vector<group_type> &groups) const override;
+    std::unique_ptr<DataModel>
+    estimate_join(const QueryGraph &G, const DataModel &left, const DataModel &right,
+                  const cnf::CNF &condition) const override;
+
+    template<typename PlanTable>
+    std::unique_ptr<DataModel>
+    operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph &G, Subproblem to_join,
+               const cnf::CNF &condition) const;
+
+    /*==================================================================================================================
+     * Prediction via model use
+     *================================================================================================================*/
+
+    std::size_t predict_cardinality(const DataModel &data) const override;
+    double predict_number_distinct_values(const DataModel &data) const override;
+
+    private:
+    void read_json(Diagnostic &diag, std::istream &in);
+    void print(std::ostream &out) const override;
+};
+
 /**
  * SpnEstimator that estimates cardinalities based on Sum-Product Networks.
  */
@@ -343,6 +485,7 @@ struct M_EXPORT SpnEstimator : CardinalityEstimatorCRTP<SpnEstimator>
         { }
 
         void assign_to(Subproblem) override { /* nothing to be done */ }
+        std::unique_ptr<DataModel> clone() const override { return std::make_unique<SpnDataModel>(*this); }
     };
 
     private:
@@ -10,6 +10,7 @@
 #include <mutable/catalog/TableFactory.hpp>
 #include <mutable/catalog/Scheduler.hpp>
 #include <mutable/catalog/Schema.hpp>
+#include <mutable/catalog/WriteAheadLog.hpp>
 #include <mutable/IR/PlanEnumerator.hpp>
 #include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/util/ArgParser.hpp>
@@ -224,7 +225,10 @@ struct M_EXPORT Catalog
     std::unordered_map<ThreadSafePooledString, Database*> databases_; ///< the databases
     Database *database_in_use_ = nullptr; ///< the currently used database
     std::unordered_map<ThreadSafePooledString, Function*> standard_functions_; ///< functions defined by the SQL standard
+    ///> user-defined functions, e.g. registered by plugins
+    std::unordered_map<ThreadSafePooledString, std::unique_ptr<ScalarUDF>> user_defined_functions_;
     Timer timer_; ///< a global timer
+    std::unique_ptr<WriteAheadLog> wal_; ///< the write-ahead log; may be `nullptr`
 
     private:
     Catalog();
@@ -244,6 +248,7 @@ struct M_EXPORT Catalog
                 delete DB.second;
             the_catalog_->databases_.clear();
             the_catalog_->database_in_use_ = nullptr;
+            the_catalog_->wal_.reset();
         }
     }
 
@@ -304,10 +309,31 @@ struct M_EXPORT Catalog
     /** Unsets the `Database` that is currenly in use. */
     void unset_database_in_use() { database_in_use_ = nullptr; }
 
+    auto databases_begin() const { return databases_.cbegin(); }
+    auto databases_end() const { return databases_.cend(); }
+
+    /*===== Durability ===============================================================================================*/
+    /** Returns the `WriteAheadLog` that makes committed transactions durable, or `nullptr` if none is enabled. */
+    WriteAheadLog * wal() const { return wal_.get(); }
+    /** Enables the `WriteAheadLog` \p wal, or disables logging if \p wal is `nullptr`. */
+    void wal(std::unique_ptr<WriteAheadLog> wal) { wal_ = std::move(wal); }
+
     /*===== Functions ================================================================================================*/
     /** Returns a reference to the `Function` with the given \p name.  Throws `std::out_of_range` if no such `Function`
      * exists. */
-    const Function * get_function(const ThreadSafePooledString &name) const { return standard_functions_.at(name); }
+    const Function * get_function(const ThreadSafePooledString &name) const {
+        if (auto it = standard_functions_.find(name); it != standard_functions_.end())
+            return it->second;
+        return user_defined_functions_.at(name).get();
+    }
+    /** Registers the user-defined scalar function \p udf.  Throws `m::invalid_argument` if a `Function` with the same
+     * name already exists. */
+    void register_function(std::unique_ptr<ScalarUDF> udf) {
+        if (standard_functions_.contains(udf->name) or user_defined_functions_.contains(udf->name))
+            throw invalid_argument("function with that name already exists");
+        auto name = udf->name;
+        user_defined_functions_.emplace(std::move(name), std::move(udf));
+    }
 
 
     /*------------------------------------------------------------------------------------------------------------------
@@ -17,21 +17,22 @@ struct CardinalityEstimator;
 struct FilterOperator;
 struct GroupingOperator;
 struct JoinOperator;
+struct PlanTableCompact;
 struct PlanTableLargeAndSparse;
 struct PlanTableSmallOrDense;
 struct QueryGraph;
 
 struct calculate_filter_cost_tag : const_virtual_crtp_helper<calculate_filter_cost_tag>::
     returns<double>::
-    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&>::
+    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&, const PlanTableCompact&>::
     args<const QueryGraph&, const CardinalityEstimator&, SmallBitset, const cnf::CNF&> { };
 struct calculate_join_cost_tag : const_virtual_crtp_helper<calculate_join_cost_tag>::
     returns<double>::
-    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&>::
+    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&, const PlanTableCompact&>::
     args<const QueryGraph&, const CardinalityEstimator&, SmallBitset, SmallBitset, const cnf::CNF&> { };
 struct calculate_grouping_cost_tag : const_virtual_crtp_helper<calculate_grouping_cost_tag>::
     returns<double>::
-    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&>::
+    crtp_args<const PlanTableSmallOrDense&, const PlanTableLargeAndSparse&, const PlanTableCompact&>::
     args<const QueryGraph&, const CardinalityEstimator&, SmallBitset, const std::vector<const ast::Expr*>&> { };
 
 struct CostFunction : calculate_filter_cost_tag::base_type
@@ -93,8 +93,21 @@ struct learn_spns : DatabaseInstruction
     void execute(Diagnostic &diag) override;
 };
 
+/** Suggest a data layout for every table in the database from the accesses of previous queries, see
+ * `storage::advise_layout()`.  The data layout of a table can then be changed by `ALTER TABLE ... SET LAYOUT ...`. */
+struct advise_layouts : DatabaseInstruction
+{
+    advise_layouts(std::vector<std::string> args) : DatabaseInstruction(std::move(args)) { }
+
+    void accept(DatabaseCommandVisitor &v) override;
+    void accept(ConstDatabaseCommandVisitor &v) const override;
+
+    void execute(Diagnostic &diag) override;
+};
+
 #define M_DATABASE_INSTRUCTION_LIST(X) \
-    X(learn_spns)
+    X(learn_spns) \
+    X(advise_layouts)
 
 
 /*======================================================================================================================
@@ -108,8 +121,32 @@ struct SQLCommand : DatabaseCommand { };
  * Data Manipulation Language (DML)
  *====================================================================================================================*/
 
-/** Base class for all commands resulting from a *data manipulation language* (DML) statement. */
-struct DMLCommand : SQLCommand { };
+/** Base class for all commands resulting from a *data manipulation language* (DML) statement.  A command inserting or
+ * deleting rows records the IDs of these rows, such that the `WriteAheadLog` can log the rows. */
+struct DMLCommand : SQLCommand
+{
+    private:
+    ///> the table the command inserted rows into or deleted rows from; `nullptr` if none
+    const Table *written_table_ = nullptr;
+    ///> the ranges [begin, end) of the IDs of the rows the command inserted or deleted, in ascending order
+    std::vector<std::pair<std::size_t, std::size_t>> written_rows_;
+
+    public:
+    const Table * written_table() const { return written_table_; }
+    const std::vector<std::pair<std::size_t, std::size_t>> & written_rows() const { return written_rows_; }
+
+    protected:
+    /** Records that the command inserted or deleted the rows [\p begin, \p end) of \p table. */
+    void record_written_rows(const Table &table, std::size_t begin, std::size_t end) {
+        if (begin == end) return;
+        M_insist(not written_table_ or written_table_ == &table, "a command writes to a single table");
+        written_table_ = &table;
+        if (not written_rows_.empty() and written_rows_.back().second == begin)
+            written_rows_.back().second = end; // extend the most recent range if the rows are adjacent
+        else
+            written_rows_.emplace_back(begin, end);
+    }
+};
 
 /** Run a query against the selected database. */
 struct QueryDatabase : DMLCommand
@@ -146,7 +183,8 @@ struct UpdateRecords : DMLCommand
     void execute(Diagnostic &diag) override;
 };
 
-/** Delete records from a `Table` of a `Database`. */
+/** Delete records from a `Table` of a `Database`.  The records are not removed from the `Store` but their lifetime is
+ * ended by their `$ts_end` timestamp, hence the table must be multi-versioned. */
 struct DeleteRecords : DMLCommand
 {
     void accept(DatabaseCommandVisitor &v) override;
@@ -161,12 +199,12 @@ struct ImportDSV : DMLCommand
     using DSVConfig = DSVReader::Config;
 
     private:
-    const Table &table_;
+    Table &table_;
     std::filesystem::path path_;
     DSVConfig cfg_;
 
     public:
-    ImportDSV(const Table &table, std::filesystem::path path, DSVConfig cfg)
+    ImportDSV(Table &table, std::filesystem::path path, DSVConfig cfg)
         : table_(table)
         , path_(path)
         , cfg_(std::move(cfg)) { }
@@ -267,20 +305,39 @@ struct DropTable : DDLCommand
     void execute(Diagnostic &diag) override;
 };
 
+/** Reorganizes the data of a table in another data layout. */
+struct AlterTable : DDLCommand
+{
+    private:
+    ThreadSafePooledString table_name_;
+    ThreadSafePooledString layout_name_; ///< the name of the `storage::DataLayoutFactory` providing the new layout
+
+    public:
+    AlterTable(ThreadSafePooledString table_name, ThreadSafePooledString layout_name)
+        : table_name_(std::move(table_name))
+        , layout_name_(std::move(layout_name))
+    { }
+
+    void accept(DatabaseCommandVisitor &v) override;
+    void accept(ConstDatabaseCommandVisitor &v) const override;
+
+    void execute(Diagnostic &diag) override;
+};
+
 struct CreateIndex : DDLCommand
 {
     private:
     std::unique_ptr<idx::IndexBase> index_;
     ThreadSafePooledString table_name_;
-    ThreadSafePooledString attribute_name_;
+    std::vector<ThreadSafePooledString> attribute_names_; ///< the key attributes, in key order
     ThreadSafePooledString index_name_;
 
     public:
     CreateIndex(std::unique_ptr<idx::IndexBase> index, ThreadSafePooledString table_name,
-                ThreadSafePooledString attribute_name, ThreadSafePooledString index_name)
+                std::vector<ThreadSafePooledString> attribute_names, ThreadSafePooledString index_name)
         : index_(M_notnull(std::move(index)))
         , table_name_(std::move(table_name))
-        , attribute_name_(std::move(attribute_name))
+        , attribute_names_(std::move(attribute_names))
         , index_name_(std::move(index_name))
     { }
 
@@ -316,6 +373,7 @@ struct DropIndex : DDLCommand
     X(UseDatabase) \
     X(CreateTable) \
     X(DropTable) \
+    X(AlterTable) \
     X(CreateIndex) \
     X(DropIndex)
 
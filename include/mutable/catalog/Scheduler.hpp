@@ -3,35 +3,223 @@
 #include <mutable/mutable-config.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/util/Diagnostic.hpp>
+#include <mutable/util/exception.hpp>
+#include <atomic>
+#include <chrono>
 #include <compare>
 #include <future>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
 
 
 namespace m {
 
+struct DatabaseCommand;
+
+/** A `CancellationToken` signals that a command must stop executing, either because it was cancelled explicitly or
+ * because it exceeded its deadline.  While a `Scheduler` executes a command, the token of the command's transaction is
+ * the *current* token of the executing thread.  Long running code, e.g. the pipelines of a `Backend`, polls the current
+ * token by `Check()`, which throws `m::execution_cancelled` to unwind the execution of the command. */
+struct M_EXPORT CancellationToken
+{
+    using clock = std::chrono::steady_clock;
+
+    private:
+    std::atomic<bool> is_cancelled_ = false; ///< whether the token was cancelled explicitly
+    ///> the deadline, in ticks of `clock` since its epoch
+    std::atomic<clock::rep> deadline_ = std::numeric_limits<clock::rep>::max();
+
+    ///> the token of the command executed by the current thread; `nullptr` if none
+    static thread_local const CancellationToken *current_;
+
+    public:
+    CancellationToken() = default;
+    CancellationToken(const CancellationToken&) = delete;
+
+    /** Cancels the token.  Thread-safe. */
+    void cancel() { is_cancelled_.store(true, std::memory_order_relaxed); }
+    /** Returns `true` iff the token was cancelled explicitly. */
+    bool is_cancelled() const { return is_cancelled_.load(std::memory_order_relaxed); }
+
+    /** Sets the deadline after which the token expires.  Thread-safe. */
+    void deadline(clock::time_point deadline) {
+        deadline_.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+    /** Removes the deadline, such that the token never expires. */
+    void clear_deadline() { deadline_.store(std::numeric_limits<clock::rep>::max(), std::memory_order_relaxed); }
+    clock::time_point deadline() const {
+        return clock::time_point(clock::duration(deadline_.load(std::memory_order_relaxed)));
+    }
+    /** Returns `true` iff the deadline of the token has passed. */
+    bool is_expired() const {
+        return clock::now().time_since_epoch().count() >= deadline_.load(std::memory_order_relaxed);
+    }
+
+    /** Returns `true` iff the token was cancelled or has expired, i.e. iff the command must stop executing. */
+    bool is_stopped() const { return is_cancelled() or is_expired(); }
+
+    /** Returns the current token of the calling thread, or `nullptr` if the thread executes no command. */
+    static const CancellationToken * Current() { return current_; }
+
+    /** Throws `m::execution_cancelled` iff the current token of the calling thread was cancelled or has expired. */
+    static void Check() {
+        if (current_ and current_->is_stopped()) [[unlikely]]
+            throw execution_cancelled(current_->is_cancelled() ? "execution was cancelled"
+                                                               : "execution exceeded its timeout");
+    }
+
+    /** Makes a token the current token of the calling thread for the lifetime of the `Scope`. */
+    struct Scope
+    {
+        private:
+        const CancellationToken *previous_;
+
+        public:
+        explicit Scope(const CancellationToken &token) : previous_(std::exchange(current_, &token)) { }
+        Scope(const Scope&) = delete;
+        ~Scope() { current_ = previous_; }
+    };
+};
+
 /** The Scheduler handles the execution of all incoming queries. The implementation stored in the catalog determines
  * when and how queries are executed. */
 struct M_EXPORT Scheduler
 {
     struct Transaction {
+        /** A write of a `Transaction` to the rows in the range [`begin`, `end`) of a multi-versioned table.  Writes are
+         * recorded to stamp the written rows when the transaction commits and to undo the writes when it aborts. */
+        struct Write
+        {
+            enum kind_t { W_Insert, W_Delete } kind; ///< whether the rows were inserted or deleted
+            const Table *table; ///< the table written to
+            std::size_t begin; ///< the ID of the first row written
+            std::size_t end; ///< the ID of the row following the last row written
+        };
+
+        /** An effect of a `Transaction` on the database.  Effects are recorded to write them to the `WriteAheadLog`
+         * when the transaction commits.  Statements modifying the catalog are logged in SQL, whereas rows are logged
+         * physically, i.e. by their values, such that recovery neither re-evaluates statements nor re-reads files. */
+        struct LoggedEffect
+        {
+            enum kind_t {
+                E_Statement, ///< a statement modifying the catalog
+                E_Insert,    ///< rows inserted into a table
+                E_Delete,    ///< rows deleted from a table
+            } kind;
+            std::string database; ///< the name of the database in use by the statement or written to; empty if none
+            std::string table; ///< the name of the table written to; empty for statements
+            std::string data; ///< the statement in SQL, or the rows serialized by `WriteAheadLog::Serialize_Rows()`
+        };
+
         private:
         ///> the Transaction ID
         uint64_t id_;
         ///> the start time of the transaction. Used for multi-versioning and should be set when the transaction executes something.
         int64_t start_time_ = -1;
+        ///> whether the timestamps of written rows are assigned when the transaction commits rather than when it starts
+        bool defers_timestamps_ = false;
+        ///> the writes of the transaction, in the order they were performed
+        std::vector<Write> writes_;
+        ///> the effects of the transaction on the database, in the order they were performed
+        std::vector<LoggedEffect> logged_effects_;
+        ///> the token cancelling the commands of the transaction
+        CancellationToken cancellation_token_;
+        ///> the time every command of the transaction may execute; zero means unlimited
+        std::chrono::milliseconds timeout_ = std::chrono::milliseconds::zero();
 
         ///> Stores the next available Transaction ID, stored atomically to prevent race conditions
         static std::atomic<uint64_t> next_id_;
 
         public:
-        Transaction() : id_(next_id_.fetch_add(1, std::memory_order_relaxed)) { }
+        /** Creates a new `Transaction`.  If \p defers_timestamps, rows written by the transaction are stamped with
+         * `pending_time()` until the transaction commits, otherwise they are stamped with its start time. */
+        explicit Transaction(bool defers_timestamps = false)
+            : id_(next_id_.fetch_add(1, std::memory_order_relaxed))
+            , defers_timestamps_(defers_timestamps)
+        { }
+
+        uint64_t id() const { return id_; }
 
         ///> sets the start time of the Transaction. Should only be set once and only to a positive number.
         void start_time(int64_t time) { M_insist(start_time_ == -1 and time >= 0); start_time_ = time; };
         int64_t start_time() const { return start_time_; };
 
+        bool defers_timestamps() const { return defers_timestamps_; }
+
+        /** Cancels the transaction.  Its command in execution is interrupted and fails, as do all of its commands that
+         * execute later.  The transaction must then be aborted.  Thread-safe. */
+        void cancel() { cancellation_token_.cancel(); }
+        bool is_cancelled() const { return cancellation_token_.is_cancelled(); }
+
+        /** Limits the time every command of the transaction may execute to \p timeout.  A command exceeding its timeout
+         * is interrupted and fails.  Zero means unlimited. */
+        void timeout(std::chrono::milliseconds timeout) { timeout_ = timeout; }
+        std::chrono::milliseconds timeout() const { return timeout_; }
+
+        CancellationToken & cancellation_token() { return cancellation_token_; }
+        const CancellationToken & cancellation_token() const { return cancellation_token_; }
+
+        /** Returns the timestamp marking rows written by this transaction as pending until it commits.  The timestamp
+         * exceeds the start time of every transaction, such that pending rows are not visible to other transactions. */
+        int64_t pending_time() const { return std::numeric_limits<int64_t>::max() - int64_t(id_); }
+        /** Returns the timestamp this transaction writes to `$ts_begin` of inserted rows and to `$ts_end` of deleted
+         * rows. */
+        int64_t write_time() const { return defers_timestamps_ ? pending_time() : start_time_; }
+
+        /** Returns `true` iff a row with the timestamps \p ts_begin and \p ts_end is visible to this transaction, i.e.
+         * iff the row was inserted but not deleted by transactions that committed before this transaction started or by
+         * this transaction itself.  This mirrors the timestamp filter that the pre-optimization `multi-versioning` adds
+         * to queries. */
+        bool sees(int64_t ts_begin, int64_t ts_end) const {
+            const bool is_own_begin = defers_timestamps_ and ts_begin == pending_time();
+            const bool is_own_end = defers_timestamps_ and ts_end == pending_time();
+            return (ts_begin <= start_time_ or is_own_begin) and
+                   (ts_end == -1 or (ts_end > start_time_ and not is_own_end));
+        }
+
+        /** Records that the rows [\p begin, \p end) were inserted into \p table. */
+        void record_insert(const Table &table, std::size_t begin, std::size_t end) {
+            record(Write::W_Insert, table, begin, end);
+        }
+        /** Records that the row \p row_id of \p table was deleted. */
+        void record_delete(const Table &table, std::size_t row_id) {
+            record(Write::W_Delete, table, row_id, row_id + 1);
+        }
+        /** Returns the writes of this transaction, in the order they were performed. */
+        const std::vector<Write> & writes() const { return writes_; }
+
+        /** Records that the statement \p sql modified the catalog while the database \p database was in use. */
+        void log_statement(std::string database, std::string sql) {
+            logged_effects_.push_back(LoggedEffect{ LoggedEffect::E_Statement, std::move(database), std::string(),
+                                                    std::move(sql) });
+        }
+        /** Records that the serialized \p rows were inserted into or deleted from, as given by \p kind, the table
+         * \p table of the database \p database. */
+        void log_rows(LoggedEffect::kind_t kind, std::string database, std::string table, std::string rows) {
+            M_insist(kind != LoggedEffect::E_Statement);
+            logged_effects_.push_back(LoggedEffect{ kind, std::move(database), std::move(table), std::move(rows) });
+        }
+        /** Returns the effects of this transaction on the database, in the order they were performed. */
+        const std::vector<LoggedEffect> & logged_effects() const { return logged_effects_; }
+
         auto operator==(const Transaction &other) const { return id_ == other.id_; };
         auto operator<=>(const Transaction &other) const { return id_ <=> other.id_; };
+
+        private:
+        void record(Write::kind_t kind, const Table &table, std::size_t begin, std::size_t end) {
+            if (begin == end) return;
+            /* Extend the most recent write if the rows are adjacent. */
+            if (not writes_.empty()) {
+                auto &last = writes_.back();
+                if (last.kind == kind and last.table == &table and last.end == begin) {
+                    last.end = end;
+                    return;
+                }
+            }
+            writes_.push_back(Write{ kind, &table, begin, end });
+        }
     };
 
     protected:
@@ -49,16 +237,31 @@ struct M_EXPORT Scheduler
     virtual std::unique_ptr<Transaction> begin_transaction() = 0;
 
     /** Closes the given `Scheduler::Transaction` and commits its changes.
-     * Returns true if the changes were committed successfully. */
+     * Returns true if the changes were committed successfully.  Returns false if the transaction conflicts with another
+     * transaction; then its changes are discarded as if it was aborted. */
     virtual bool commit(std::unique_ptr<Transaction> t) = 0;
 
     /** Closes the given `Scheduler::Transaction` and discards its changes.
      * Returns true if the changes were undone successfully. */
     virtual bool abort(std::unique_ptr<Transaction> t) = 0;
 
-    /** Schedule a `ast::Command` for execution and automatically commits its changes.
+    /** Schedule a `ast::Command` for execution and automatically commits its changes.  The command executes with the
+     * timeout given by `Options::query_timeout`, unless the `WriteAheadLog` is recovering, i.e. replaying the command.
      * Returns true if the `ast::Command` was executed and its changes were committed successfully. */
     bool autocommit(std::unique_ptr<ast::Command> command, Diagnostic &diag);
+
+    protected:
+    /** Executes the command \p cmd within the transaction \p t on the calling thread and records it for the
+     * `WriteAheadLog` if it executed without errors, see `log_command()`.  The execution is interrupted once `t` is
+     * cancelled or the command exceeds the timeout of `t`.  Returns `false` iff the command was interrupted or `t` was
+     * cancelled before; the reason is reported to \p diag. */
+    static bool execute_command(Transaction &t, DatabaseCommand &cmd, Diagnostic &diag);
+
+    /** Records the effects of the command \p cmd, which the transaction \p t executed without errors, for the
+     * `WriteAheadLog` of the `Catalog`.  Data definition commands are recorded by their SQL, data manipulation commands
+     * by the rows they inserted or deleted.  Effects are only recorded if a `WriteAheadLog` is enabled and is not
+     * recovering.  Must be called right after \p cmd executed, by the thread that executed it. */
+    static void log_command(Transaction &t, DatabaseCommand &cmd);
 };
 
 }
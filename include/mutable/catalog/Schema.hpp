@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <iosfwd>
 #include <iterator>
 #include <list>
@@ -33,6 +35,9 @@ struct DataLayoutFactory;
 
 }
 
+// forward declarations
+struct Value;
+
 /** A `Schema` represents a sequence of identifiers, optionally with a prefix, and their associated types.  The `Schema`
  * allows identifiers of the same name with different prefix.  */
 struct M_EXPORT Schema
@@ -582,12 +587,15 @@ struct M_EXPORT Table
     virtual void layout(storage::DataLayout &&new_layout) = 0;
     /** Sets the physical data layout for this table by calling `factory.make()`. */
     virtual void layout(const storage::DataLayoutFactory &factory) = 0;
+    /** Returns the factory that made the physical data layout of this table or `nullptr` if the layout was set
+     * directly. */
+    virtual const storage::DataLayoutFactory * layout_factory() const = 0;
 
     /** Returns all attributes forming the primary key. */
     virtual std::vector<std::reference_wrapper<const Attribute>> primary_key() const = 0;
 
-    /** Adds an attribute with the given `name` to the primary key of this table. Throws `std::out_of_range` if no
-     * attribute with the given `name` exists. */
+    /** Adds an attribute with the given `name` to the primary key of this table and makes it `NOT NULL`.  Throws
+     * `std::out_of_range` if no attribute with the given `name` exists. */
     virtual void add_primary_key(const ThreadSafePooledString &name) = 0;
 
     /** Adds a new attribute with the given `name` and `type` to the table.  Throws `std::invalid_argument` if the
@@ -614,11 +622,13 @@ struct M_EXPORT ConcreteTable : Table
     std::unordered_map<ThreadSafePooledString, table_type::size_type> name_to_attr_; ///< maps attribute names to attributes
     std::unique_ptr<Store> store_; ///< the store backing this table; may be `nullptr`
     storage::DataLayout layout_; ///< the physical data layout for this table
+    ///> the factory that made `layout_`; may be `nullptr`
+    std::unique_ptr<storage::DataLayoutFactory> layout_factory_;
     SmallBitset primary_key_; ///< the primary key of this table, maintained as a `SmallBitset` over attribute id's
 
     public:
-    ConcreteTable(ThreadSafePooledString name) : name_(std::move(name)) { }
-    virtual ~ConcreteTable() = default;
+    ConcreteTable(ThreadSafePooledString name);
+    virtual ~ConcreteTable();
 
     /** Returns the number of non-hidden attributes in this table. */
     std::size_t num_attrs() const override { return end() - begin(); }
@@ -701,9 +711,12 @@ struct M_EXPORT ConcreteTable : Table
     /** Returns a reference to the physical data layout. */
     const storage::DataLayout & layout() const override { M_insist(bool(layout_)); return layout_; }
     /** Sets the physical data layout for this table. */
-    void layout(storage::DataLayout &&new_layout) override { layout_ = std::move(new_layout); }
+    void layout(storage::DataLayout &&new_layout) override;
     /** Sets the physical data layout for this table by calling `factory.make()`. */
     virtual void layout(const storage::DataLayoutFactory &factory) override;
+    /** Returns the factory that made the physical data layout of this table or `nullptr` if the layout was set
+     * directly. */
+    const storage::DataLayoutFactory * layout_factory() const override { return layout_factory_.get(); }
 
     /** Returns all attributes forming the primary key. */
     std::vector<std::reference_wrapper<const Attribute>> primary_key() const override {
@@ -712,11 +725,13 @@ struct M_EXPORT ConcreteTable : Table
             res.emplace_back(operator[](id));
         return res;
     }
-    /** Adds an attribute with the given `name` to the primary key of this table. Throws `std::out_of_range` if no
-     * attribute with the given `name` exists. */
+    /** Adds an attribute with the given `name` to the primary key of this table.  Since the primary key must not be
+     * `NULL`, the attribute becomes `NOT NULL`.  Throws `std::out_of_range` if no attribute with the given `name`
+     * exists. */
     void add_primary_key(const ThreadSafePooledString &name) override {
         auto &attr = at(name);
         primary_key_(attr.id) = true;
+        attr.not_nullable = true;
     }
 
     /** Adds a new attribute with the given `name` and `type` to the table.  Throws `std::invalid_argument` if the
@@ -797,6 +812,7 @@ struct TableDecorator : Table
     virtual const storage::DataLayout & layout() const override { return table_->layout(); }
     virtual void layout(storage::DataLayout &&new_layout) override { table_->layout(std::move(new_layout)); }
     virtual void layout(const storage::DataLayoutFactory &factory) override { table_->layout(factory); }
+    virtual const storage::DataLayoutFactory * layout_factory() const override { return table_->layout_factory(); }
 
     virtual std::vector<std::reference_wrapper<const Attribute>> primary_key() const override { return table_->primary_key(); }
     virtual void add_primary_key(const ThreadSafePooledString &name) override { table_->add_primary_key(name); }
@@ -842,6 +858,7 @@ struct M_EXPORT Function
     M_DECLARE_ENUM(kind_t) kind; ///< the function kind: Scalar, Aggregate, etc.
 
     Function(ThreadSafePooledString name, fnid_t fnid, kind_t kind) : name(std::move(name)), fnid(fnid), kind(kind) { }
+    virtual ~Function() { }
 
     /** Returns `true` iff this is a user-defined function. */
     bool is_UDF() const { return fnid == FN_UDF; }
@@ -865,6 +882,45 @@ struct M_EXPORT Function
 #undef kind_t
 };
 
+/** A user-defined scalar function.  Its signature is given by the scalar types of its parameters and its scalar return
+ * type.  Arguments of numeric type are converted to numeric parameter types implicitly.
+ *
+ * A `ScalarUDF` is implemented by a host callback with a *vectorized* calling convention:  a single call computes the
+ * results of `num_rows` applications, where `args[i]` and `args_are_null[i]` point to the `num_rows` values and `NULL`
+ * bits of the `i`-th argument and the results are written to the `num_rows` entries of `results` and
+ * `results_are_null`.  Backends that compile queries may inline an implementation of their own instead, e.g. the
+ * `WasmBackend` inlines bodies registered with `m::wasm::register_udf_body()`. */
+struct M_EXPORT ScalarUDF : Function
+{
+    /** The maximum number of parameters of a `ScalarUDF`. */
+    static constexpr std::size_t MAX_NUM_PARAMETERS = 16;
+
+    using callback_type = std::function<void(std::size_t num_rows, const Value *const *args,
+                                             const bool *const *args_are_null, Value *results, bool *results_are_null)>;
+
+    std::vector<const PrimitiveType*> parameter_types; ///< the scalar types of the parameters
+    const PrimitiveType *return_type; ///< the scalar return type
+    callback_type callback; ///< the host callback implementing this function; may be empty
+
+    /** Creates a `ScalarUDF` \p name with the parameters \p parameter_types and the return type \p return_type,
+     * implemented by \p callback.  Throws `m::invalid_argument` if the signature is invalid. */
+    ScalarUDF(ThreadSafePooledString name, std::vector<const PrimitiveType*> parameter_types,
+              const PrimitiveType *return_type, callback_type callback = callback_type());
+
+    std::size_t num_parameters() const { return parameter_types.size(); }
+
+    /** Returns `true` iff this function has a host callback. */
+    bool has_callback() const { return bool(callback); }
+
+    /** Invokes the host callback on \p num_rows rows, see `callback_type`. */
+    void operator()(std::size_t num_rows, const Value *const *args, const bool *const *args_are_null, Value *results,
+                    bool *results_are_null) const
+    {
+        M_insist(has_callback(), "UDF has no host callback");
+        callback(num_rows, args, args_are_null, results, results_are_null);
+    }
+};
+
 /** A `Database` is a set of `Table`s, `Function`s, and `Statistics`. */
 struct M_EXPORT Database
 {
@@ -872,20 +928,38 @@ struct M_EXPORT Database
 
     struct index_entry_type
     {
+        /** The state of an index. */
+        enum state_t
+        {
+            S_Building, ///< the index is bulkloaded in the background and must not be used yet
+            S_Valid,    ///< the index is used to answer queries
+            S_Invalid,  ///< the index is outdated and must not be used
+        };
+
         ThreadSafePooledString name; ///< the name of the index
         const Table &table; ///< the table of the index
-        const Attribute &attribute; ///< the indexed attribute
+        std::vector<std::reference_wrapper<const Attribute>> attributes; ///< the indexed attributes, in key order
         std::unique_ptr<idx::IndexBase> index; ///< the actual index
-        bool is_valid; ///< indicates if the index should be used to answer queries
+        std::atomic<state_t> state; ///< the state of the index; written concurrently by a background bulkload
+        ///> the background bulkload of the index, if any; destroyed before `index` and waits for the bulkload
+        std::future<void> build;
 
-        index_entry_type(ThreadSafePooledString name, const Table &table, const Attribute &attribute,
-                         std::unique_ptr<idx::IndexBase> index)
+        index_entry_type(ThreadSafePooledString name, const Table &table,
+                         std::vector<std::reference_wrapper<const Attribute>> attributes,
+                         std::unique_ptr<idx::IndexBase> index, state_t state = S_Valid)
             : name(std::move(name))
             , table(table)
-            , attribute(attribute)
+            , attributes(std::move(attributes))
             , index(std::move(index))
-            , is_valid(true)
+            , state(state)
         { }
+
+        /** Returns `true` iff the index should be used to answer queries. */
+        bool is_valid() const { return state.load() == S_Valid; }
+        /** Returns `true` iff the key of the index consists of the single attribute \p attribute_name. */
+        bool is_on(const ThreadSafePooledString &attribute_name) const {
+            return attributes.size() == 1 and attributes.front().get().name == attribute_name;
+        }
     };
 
     public:
@@ -946,6 +1020,7 @@ struct M_EXPORT Database
     std::unique_ptr<CardinalityEstimator> cardinality_estimator(std::unique_ptr<CardinalityEstimator> CE) {
         auto old = std::move(cardinality_estimator_); cardinality_estimator_ = std::move(CE); return old;
     }
+    CardinalityEstimator & cardinality_estimator() { return *cardinality_estimator_; }
     const CardinalityEstimator & cardinality_estimator() const { return *cardinality_estimator_; }
 
     /*===== Indexes ==================================================================================================*/
@@ -955,12 +1030,53 @@ struct M_EXPORT Database
      * exists. */
     void add_index(std::unique_ptr<idx::IndexBase> index, const ThreadSafePooledString &table_name,
                    const ThreadSafePooledString &attribute_name, ThreadSafePooledString index_name)
+    {
+        add_index(std::move(index), table_name, std::vector<ThreadSafePooledString>{ attribute_name },
+                  std::move(index_name));
+    }
+    /** Adds an index with \p index_name on the composite key of \p attribute_names, in this order, from \p
+     * table_name.  Throws like `add_index()` for a single attribute. */
+    void add_index(std::unique_ptr<idx::IndexBase> index, const ThreadSafePooledString &table_name,
+                   const std::vector<ThreadSafePooledString> &attribute_names, ThreadSafePooledString index_name)
     {
         if (has_index(index_name))
             throw invalid_argument("Index with that name already exists.");
         auto &table = get_table(table_name);
-        auto &attribute = table.at(attribute_name);
-        indexes_.emplace_back(std::move(index_name), table, attribute, std::move(index));
+        auto attributes = get_attributes(table, attribute_names);
+        indexes_.emplace_back(std::move(index_name), table, std::move(attributes), std::move(index));
+    }
+    /** Adds an index like `add_index()` and bulkloads it in the background by invoking \p bulkload.  Until \p
+     * bulkload completed, the index is not used to answer queries.  If the indexes of the table are invalidated
+     * meanwhile, or if \p bulkload throws, the index is left invalid. */
+    void add_index_async(std::unique_ptr<idx::IndexBase> index, const ThreadSafePooledString &table_name,
+                         const ThreadSafePooledString &attribute_name, ThreadSafePooledString index_name,
+                         std::function<void(idx::IndexBase&)> bulkload)
+    {
+        add_index_async(std::move(index), table_name, std::vector<ThreadSafePooledString>{ attribute_name },
+                        std::move(index_name), std::move(bulkload));
+    }
+    /** Adds an index like `add_index()` on a composite key and bulkloads it in the background like
+     * `add_index_async()`. */
+    void add_index_async(std::unique_ptr<idx::IndexBase> index, const ThreadSafePooledString &table_name,
+                         const std::vector<ThreadSafePooledString> &attribute_names, ThreadSafePooledString index_name,
+                         std::function<void(idx::IndexBase&)> bulkload)
+    {
+        if (has_index(index_name))
+            throw invalid_argument("Index with that name already exists.");
+        auto &table = get_table(table_name);
+        auto attributes = get_attributes(table, attribute_names);
+        auto &entry = indexes_.emplace_back(std::move(index_name), table, std::move(attributes), std::move(index),
+                                            index_entry_type::S_Building);
+        entry.build = std::async(std::launch::async, [&entry, bulkload=std::move(bulkload)]() {
+            auto expected = index_entry_type::S_Building;
+            try {
+                bulkload(*entry.index);
+            } catch (...) {
+                entry.state.compare_exchange_strong(expected, index_entry_type::S_Invalid);
+                return;
+            }
+            entry.state.compare_exchange_strong(expected, index_entry_type::S_Valid); // unless invalidated meanwhile
+        });
     }
     /** Drops the index with the given \p index_name.  Throws `m::invalid_argument` if an index with the given \p
      * index_name does not exist. */
@@ -985,6 +1101,8 @@ struct M_EXPORT Database
                 ++it;
         }
     }
+    auto begin_indexes() const { return indexes_.cbegin(); }
+    auto end_indexes() const { return indexes_.cend(); }
     /** Returns `true` iff there is an index with the given \p index_name. */
     bool has_index(const ThreadSafePooledString &index_name) const {
         for (auto it = indexes_.cbegin(); it != indexes_.cend(); ++it)
@@ -1003,7 +1121,7 @@ struct M_EXPORT Database
         if (not table->has_attribute(attribute_name))
             throw m::invalid_argument("Attribute with that name does not exist.");
         for (auto &entry : indexes_) {
-            if (entry.is_valid and entry.table.name() == table_name and entry.attribute.name == attribute_name and
+            if (entry.is_valid() and entry.table.name() == table_name and entry.is_on(attribute_name) and
                 entry.index->method() == method)
             {
                 return true;
@@ -1033,7 +1151,7 @@ struct M_EXPORT Database
         if (not table->has_attribute(attribute_name))
             throw m::invalid_argument("Attribute with that name does not exist.");
         for (auto &entry : indexes_) {
-            if (entry.is_valid and entry.table.name() == table_name and entry.attribute.name == attribute_name and
+            if (entry.is_valid() and entry.table.name() == table_name and entry.is_on(attribute_name) and
                 entry.index->method() == method)
             {
                 return *entry.index;
@@ -1048,9 +1166,37 @@ struct M_EXPORT Database
             throw m::invalid_argument("Table with that name does not exist.");
         for (auto &entry : indexes_) {
             if (entry.table.name() == table_name)
-                entry.is_valid = false;
+                entry.state = index_entry_type::S_Invalid; // also discards a bulkload in the background
         }
     }
+    /** Returns `true` iff an index on an attribute of `Table` \p table_name is being bulkloaded in the background. */
+    bool is_building_indexes(const ThreadSafePooledString &table_name) const {
+        for (auto &entry : indexes_) {
+            if (entry.table.name() == table_name and entry.build.valid() and
+                entry.build.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return true;
+        }
+        return false;
+    }
+    /** Waits until all indexes on attributes of `Table` \p table_name that are bulkloaded in the background are built.
+     * Must be called before the rows or the data layout of the table are modified other than by appending. */
+    void wait_for_indexes(const ThreadSafePooledString &table_name) {
+        for (auto &entry : indexes_) {
+            if (entry.table.name() == table_name and entry.build.valid())
+                entry.build.wait();
+        }
+    }
+
+    private:
+    /** Returns the attributes of \p table with the given \p attribute_names, in this order.  Throws
+     * `std::out_of_range` if an `Attribute` does not exist. */
+    static std::vector<std::reference_wrapper<const Attribute>>
+    get_attributes(const Table &table, const std::vector<ThreadSafePooledString> &attribute_names) {
+        std::vector<std::reference_wrapper<const Attribute>> attributes;
+        for (auto &attribute_name : attribute_names)
+            attributes.emplace_back(table.at(attribute_name));
+        return attributes;
+    }
 };
 
 }
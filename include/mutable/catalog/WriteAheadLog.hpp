@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/mutable-config.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** A `WriteAheadLog` makes committed transactions durable.  When a transaction commits, its effects on the database,
+ * see `Scheduler::Transaction::logged_effects()`, are appended to the log as a single record.  Statements modifying
+ * the catalog are logged in SQL.  Inserted and deleted rows are logged physically, i.e. by their values.  Recovery
+ * replays the effects in the order the transactions committed: it executes the statements, appends the inserted rows,
+ * and ends the lifetime of rows equal to the deleted rows.
+ *
+ * Records are written and synced to disk by a dedicated flush thread.  A committing transaction `append()`s its record
+ * and waits in `flush()` until the record is durable.  All records appended while the flush thread syncs are written
+ * and synced together by the next flush, such that concurrent commits share a single sync (*group commit*).
+ * Optionally, the flush thread delays each flush to gather more commits.
+ *
+ * To bound the size of the log and the time of recovery, a *checkpoint* writes the contents of all databases to a
+ * separate file and truncates the log, see `checkpoint()`.  Records carry increasing *log sequence numbers* (LSNs), and
+ * the checkpoint records the LSN of the last transaction it contains.  Hence, records are never replayed twice, even
+ * if the system crashes after writing the checkpoint but before truncating the log.
+ *
+ * Every record is framed by its size and a checksum.  Recovery stops at the first incomplete or corrupt record, which
+ * was torn by a crash while it was written and hence was never acknowledged as committed, and truncates the log
+ * there. */
+struct M_EXPORT WriteAheadLog
+{
+    private:
+    std::filesystem::path path_; ///< the path of the log
+    std::filesystem::path checkpoint_path_; ///< the path of the checkpoint
+    std::size_t checkpoint_size_; ///< the size of the log in bytes that demands a checkpoint
+    std::chrono::microseconds group_commit_delay_; ///< the time the flush thread waits for more commits before flushing
+    int fd_ = -1; ///< the file descriptor of the log, opened for appending
+
+    mutable std::mutex mutex_; ///< protects all of the following fields
+    std::condition_variable has_pending_; ///< notified when records are appended or the log is closed
+    std::condition_variable is_flushed_; ///< notified when the flush thread synced records or failed to
+    std::string pending_; ///< the framed records appended but not yet written
+    uint64_t next_lsn_ = 1; ///< the LSN of the next record
+    uint64_t flushed_lsn_ = 0; ///< the LSN of the last record that is durable
+    std::size_t size_ = 0; ///< the size of the log in bytes, excluding pending records
+    bool is_closed_ = false; ///< whether the log is destroyed, such that the flush thread exits
+    bool has_failed_ = false; ///< whether writing or syncing the log failed
+
+    std::atomic<bool> is_recovering_ = false; ///< whether `recover()` is replaying the log
+    std::thread flush_thread_; ///< the thread writing and syncing pending records
+
+    public:
+    /** Opens the log at \p path and starts the flush thread.  The checkpoint is stored at \p path with the suffix
+     * `.checkpoint`.  `needs_checkpoint()` holds once the log exceeds \p checkpoint_size bytes.  The flush thread waits
+     * \p group_commit_delay for more commits before every flush.  Throws `m::runtime_error` if the log cannot be
+     * opened. */
+    WriteAheadLog(std::filesystem::path path, std::size_t checkpoint_size,
+                  std::chrono::microseconds group_commit_delay = std::chrono::microseconds(0));
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    /** Writes and syncs all pending records and closes the log. */
+    ~WriteAheadLog();
+
+    const std::filesystem::path & path() const { return path_; }
+    const std::filesystem::path & checkpoint_path() const { return checkpoint_path_; }
+
+    /** Returns the size of the log in bytes, excluding records that are not written yet. */
+    std::size_t size() const { std::lock_guard<std::mutex> lock(mutex_); return size_; }
+
+    /** Returns `true` iff `recover()` is replaying the log.  Replayed statements must not be logged again. */
+    bool is_recovering() const { return is_recovering_.load(); }
+
+    /** Appends the effects of the committing transaction \p t to the log.  Returns the LSN of the appended record,
+     * or `0` if \p t did not modify the database.  The record is durable only after `flush()` returned.  Concurrent
+     * appends must be serialized in the order the transactions commit. */
+    uint64_t append(const Scheduler::Transaction &t);
+
+    /** Waits until the record with the LSN \p lsn and all records preceding it are durable.  Returns immediately if
+     * \p lsn is `0`.  Throws `m::runtime_error` if the log cannot be written or synced. */
+    void flush(uint64_t lsn);
+
+    /** Returns `true` iff the log exceeds the checkpoint size given on construction. */
+    bool needs_checkpoint() const { std::lock_guard<std::mutex> lock(mutex_); return size_ > checkpoint_size_; }
+
+    /** Writes the contents of all databases of the `Catalog` to the checkpoint and truncates the log.  The stores must
+     * only contain committed rows.  Hence, the caller must guarantee that no command executes and no transaction is
+     * active or commits.  The new checkpoint atomically replaces the old one.  Throws `m::runtime_error` if the
+     * checkpoint cannot be written. */
+    void checkpoint();
+
+    /** Restores the databases from the checkpoint and replays the log.  Statements are executed with the default
+     * `Scheduler` of the `Catalog`, rows are written to the stores directly.  Must be called before the first
+     * transaction commits.  Truncates the log after the last intact record.  Afterwards, no database is in use.
+     * Recovery aborts by throwing `m::runtime_error` if an effect cannot be replayed, e.g. if a statement fails or a
+     * deleted row does not exist, since the recovered database would otherwise silently diverge from the committed
+     * one.  Errors of failed statements are reported to \p diag. */
+    void recover(Diagnostic &diag);
+
+    /** Serializes the rows of \p table in the ranges [begin, end) of row IDs \p rows to log them as inserted or
+     * deleted rows.  The ranges must be ascending. */
+    static std::string Serialize_Rows(const Table &table,
+                                      const std::vector<std::pair<std::size_t, std::size_t>> &rows);
+
+    private:
+    /** Writes and syncs pending records until the log is closed. */
+    void work();
+
+    /** Restores the checkpoint and replays the log, see `recover()`. */
+    void replay(Diagnostic &diag);
+};
+
+}
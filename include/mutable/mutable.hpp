@@ -2,12 +2,14 @@
 
 #include <mutable/mutable-config.hpp>
 
+#include <chrono>
 #include <filesystem>
 #include <mutable/backend/Backend.hpp>
 #include <mutable/catalog/CardinalityEstimator.hpp>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/CostFunction.hpp>
 #include <mutable/catalog/DatabaseCommand.hpp>
+#include <mutable/catalog/Scheduler.hpp>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/catalog/Type.hpp>
 #include <mutable/IR/CNF.hpp>
@@ -86,6 +88,25 @@ void M_EXPORT execute_query(Diagnostic &diag, const ast::SelectStmt &stmt, std::
 void M_EXPORT execute_query(Diagnostic &diag, const ast::SelectStmt &stmt, std::unique_ptr<Consumer> consumer,
                             const Backend &backend);
 
+/**
+ * Cancels the transaction \p t.  The command of \p t in execution is interrupted and fails, as do all commands of \p t
+ * that execute later.  Afterwards, \p t must be aborted.  May be called from any thread, e.g. to stop a runaway query.
+ * The `Interpreter` checks for cancellation between two blocks of tuples, WebAssembly backends terminate their engine.
+ *
+ * @param t             the transaction to cancel
+ */
+void M_EXPORT cancel(Scheduler::Transaction &t);
+
+/**
+ * Limits the time every command of the transaction \p t may execute to \p timeout.  A command that exceeds its timeout
+ * is interrupted and fails like a cancelled command, see `cancel()`, but later commands of \p t may still execute.
+ * `Scheduler::autocommit()` uses the timeout given by `Options::query_timeout`.
+ *
+ * @param t             the transaction whose commands to limit
+ * @param timeout       the time every command may execute; zero means unlimited
+ */
+void M_EXPORT set_timeout(Scheduler::Transaction &t, std::chrono::milliseconds timeout);
+
 /**
  * Loads a CSV file into a `Table`.
  *
@@ -103,6 +124,80 @@ void M_EXPORT load_from_CSV(Diagnostic &diag,
                             bool has_header = false,
                             bool skip_header = false);
 
+/**
+ * Compresses the contents of a `Table` by frame-of-reference encoding its integral attributes.  The range of values of
+ * each attribute is determined from the current contents of \p table and the table is reorganized by `change_layout()`
+ * using a bit-packing `storage::FrameOfReferenceLayoutFactory` that decorates the default data layout.
+ * The table's current data layout factory is decorated, if it has one; hidden attributes remain unencoded.  Inserting
+ * values that the encoding cannot represent widens it, see `widen_frame_of_reference()`.  The new layout has a NULL
+ * bitmap iff \p table has a nullable attribute, regardless of whether it currently contains `NULL` values.
+ *
+ * @param table         the table to compress
+ */
+void M_EXPORT compress(Table &table);
+
+/**
+ * Reorganizes the contents of a `Table` in the data layout computed by \p factory.  All rows are loaded from the
+ * current data layout and written to the new data layout by pipelines compiled for the schema of \p table.  The rows
+ * retain their IDs, hence indexes and the zone map of the store remain valid.
+ *
+ * @param table         the table to reorganize
+ * @param factory       the factory computing the new data layout
+ */
+void M_EXPORT change_layout(Table &table, const storage::DataLayoutFactory &factory);
+
+/**
+ * Widens the frame-of-reference encoding of the attributes of a `Table` such that it can represent the values of
+ * \p tup.  Each encoded attribute whose value in \p tup cannot be represented, see
+ * `storage::DataLayout::Leaf::can_encode()`, is encoded with the range its encoding can currently represent extended
+ * by that value.  The table is then reorganized by `change_layout()` while holding `Store::Memory_Latch()`
+ * exclusively.  Writers must not have a partially written row in the table's store.
+ *
+ * @param table         the table whose encoding to widen
+ * @param tup           a tuple of the schema of \p table that is about to be inserted
+ */
+void M_EXPORT widen_frame_of_reference(Table &table, const Tuple &tup);
+
+/**
+ * Writes \p timestamp to the hidden timestamp attribute \p attr, i.e.\ `$ts_begin` or `$ts_end`, of the rows in the
+ * range [\p begin, \p end) of the multi-versioned \p table.
+ *
+ * @param table         the multi-versioned table to write to
+ * @param attr          the name of the timestamp attribute
+ * @param begin         the ID of the first row to write
+ * @param end           the ID of the row following the last row to write
+ * @param timestamp     the timestamp to write
+ */
+void M_EXPORT write_timestamps(const Table &table, const ThreadSafePooledString &attr, std::size_t begin,
+                               std::size_t end, int64_t timestamp);
+
+/**
+ * Returns the value of the hidden timestamp attribute \p attr, i.e.\ `$ts_begin` or `$ts_end`, of the row \p row_id of
+ * the multi-versioned \p table.
+ */
+int64_t M_EXPORT read_timestamp(const Table &table, const ThreadSafePooledString &attr, std::size_t row_id);
+
+/**
+ * Returns the summary of the timestamps of the rows in block \p block of the multi-versioned \p table.  The summary is
+ * computed from the store of \p table unless a valid summary is cached in its `storage::VisibilitySummary`.
+ *
+ * @param table         the multi-versioned table to summarize
+ * @param block         the block to summarize, which must contain at least one row
+ */
+storage::VisibilitySummary::entry_type M_EXPORT summarize_visibility(const Table &table, std::size_t block);
+
+/**
+ * Reclaims the versions of the multi-versioned \p table that are invisible to every transaction with a start time of
+ * at least \p horizon, i.e. the versions ended at or before \p horizon.  The remaining versions are moved to the front
+ * of the store, retaining their order, and the store is truncated.  Hence, row IDs change: the caller must ensure that
+ * no transaction refers to rows of \p table by ID and must invalidate the indexes on \p table.  The zone map of the
+ * store is rebuilt.  Returns the number of reclaimed versions.
+ *
+ * @param table         the multi-versioned table to compact
+ * @param horizon       the start time of the oldest transaction that may read \p table
+ */
+std::size_t M_EXPORT collect_garbage(Table &table, int64_t horizon);
+
 /**
  * Execute the SQL file at `path`.
  *
@@ -119,6 +214,11 @@ struct M_EXPORT StoreWriter
     Schema S; ///< the schema of the tuples to read/write
     mutable std::unique_ptr<m::StackMachine> writer_; ///< the writing `StackMachine`
     mutable const storage::DataLayout *layout_ = nullptr; ///< the last seen `DataLayout`; used to observe updates
+    mutable const void *addr_ = nullptr; ///< the last seen address of the store's memory; used to observe moves
+    ///> the frame-of-reference encoded leaves of the last seen `DataLayout`, whose values must be range checked
+    mutable std::vector<const storage::DataLayout::Leaf*> encoded_leaves_;
+    ///> whether the last seen `DataLayout` contains a NULL bitmap; without, nullable attributes must not be `NULL`
+    mutable bool has_null_bitmap_ = true;
 
     public:
     StoreWriter(Store &store);
@@ -127,7 +227,8 @@ struct M_EXPORT StoreWriter
     /** Returns the `Schema` of `Tuple`s to write. */
     const Schema & schema() const { return S; }
 
-    /** Appends `tup` to the store. */
+    /** Appends `tup` to the store.  Throws `m::invalid_argument` if a value of `tup` cannot be stored in its
+     * frame-of-reference encoded attribute or if a value of `tup` is `NULL` but the data layout has no NULL bitmap. */
     void append(const Tuple &tup) const;
 };
 
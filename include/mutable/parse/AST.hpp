@@ -894,6 +894,22 @@ struct M_EXPORT DropTableStmt : Stmt
     void accept(ConstASTCommandVisitor &v) const override;
 };
 
+/** A SQL statement altering a table.  Currently, the only supported alteration is `SET LAYOUT`, which reorganizes the
+ * data of the table in another data layout. */
+struct M_EXPORT AlterTableStmt : Stmt
+{
+    Token table_name;
+    Token layout_name;
+
+    AlterTableStmt(Token table_name, Token layout_name)
+        : table_name(std::move(table_name))
+        , layout_name(std::move(layout_name))
+    { }
+
+    void accept(ASTCommandVisitor &v) override;
+    void accept(ConstASTCommandVisitor &v) const override;
+};
+
 struct M_EXPORT CreateIndexStmt : Stmt
 {
     Token has_unique;
@@ -1048,6 +1064,7 @@ struct M_EXPORT DSVImportStmt : ImportStmt
     X(m::ast::DropDatabaseStmt) \
     X(m::ast::CreateTableStmt) \
     X(m::ast::DropTableStmt) \
+    X(m::ast::AlterTableStmt) \
     X(m::ast::CreateIndexStmt) \
     X(m::ast::DropIndexStmt) \
     X(m::ast::SelectStmt) \
@@ -4,15 +4,20 @@
 #include <functional>
 #include <memory>
 #include <mutable/mutable-config.hpp>
+#include <mutable/storage/Dictionary.hpp>
 #include <mutable/util/exception.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/Visitor.hpp>
+#include <optional>
+#include <utility>
 #include <vector>
 
 
 namespace m {
 
 // forward declarations
+struct CharacterSequence;
+struct Numeric;
 struct Schema;
 struct Type;
 
@@ -68,7 +73,12 @@ struct M_EXPORT DataLayout
     };
 
     /** The `Leaf` represents exactly one attribue.  It holds the `Type` of the `Attribute` together with a unique
-     * index.  With the unique index it is possible to associate the `Attribute` to this `Leaf`. */
+     * index.  With the unique index it is possible to associate the `Attribute` to this `Leaf`.  A `Leaf` of a
+     * `CharacterSequence` may be *dictionary-encoded*, i.e. it stores a `Dictionary::code_type` per value rather than
+     * the characters, and the values are kept in the `Leaf`'s `Dictionary`.  A `Leaf` of an integral `Numeric` may be
+     * *frame-of-reference encoded*, i.e. it stores the difference of each value to the `Leaf`'s `reference()` in a
+     * narrower integer type or, if *bit-packed*, as unsigned integer of only as many bits as needed, stored as `Bitmap`
+     * without byte alignment. */
     struct M_EXPORT Leaf : Node
     {
         friend struct DataLayout;
@@ -79,15 +89,47 @@ struct M_EXPORT DataLayout
         const m::Type *type_;
         ///> an index that must be unique within the entire `DataLayout`
         size_type idx_;
+        ///> the `Type` of the values physically stored by this `Leaf`, if encoded
+        const m::Type *stored_type_ = nullptr;
+        ///> the dictionary of the values of this `Leaf`, if dictionary-encoded
+        std::unique_ptr<Dictionary> dictionary_;
+        ///> the reference value of this `Leaf`, if frame-of-reference encoded
+        std::optional<int64_t> reference_;
 
         Leaf(const m::Type *type, size_type idx) : type_(type), idx_(idx) { }
 
         public:
-        /** Returns the `Type` of this `Leaf`. */
+        /** Returns the `Type` of this `Leaf`.  For an encoded `Leaf`, this is the `Type` of the *decoded* values. */
         const m::Type * type() const { return type_; }
+        /** Returns the `Type` of the values physically stored by this `Leaf`.  Differs from `type()` iff this `Leaf` is
+         * encoded. */
+        const m::Type * stored_type() const { return stored_type_ ? stored_type_ : type_; }
         /** Returns the index assigned to this `Leaf`.  Must be unique within the entire `DataLayout`. */
         size_type index() const { return idx_; }
 
+        /** Returns `true` iff this `Leaf` is dictionary-encoded. */
+        bool is_dictionary_encoded() const { return bool(dictionary_); }
+        /** Returns the `Dictionary` of this dictionary-encoded `Leaf`.  The `Dictionary` is extended when values are
+         * stored, hence it is mutable even through a `const` `Leaf`. */
+        Dictionary & dictionary() const { M_insist(is_dictionary_encoded()); return *dictionary_; }
+
+        /** Returns `true` iff this `Leaf` is frame-of-reference encoded. */
+        bool is_frame_of_reference_encoded() const { return reference_.has_value(); }
+        /** Returns `true` iff this `Leaf` is frame-of-reference encoded and bit-packed, i.e. its `stored_type()` is a
+         * `Bitmap` whose bits hold the difference of a value to the `reference()` as unsigned integer. */
+        bool is_bit_packed() const;
+        /** Returns the reference value of this frame-of-reference encoded `Leaf`.  A value `v` is stored as
+         * `v - reference()`. */
+        int64_t reference() const { M_insist(is_frame_of_reference_encoded()); return *reference_; }
+        /** Returns the minimum and maximum value that can be stored in this frame-of-reference encoded `Leaf`. */
+        std::pair<int64_t, int64_t> encodable_range() const;
+        /** Returns `true` iff \p value can be stored in this frame-of-reference encoded `Leaf`, i.e. iff its difference
+         * to the `reference()` fits into the `stored_type()`. */
+        bool can_encode(int64_t value) const {
+            auto [min, max] = encodable_range();
+            return min <= value and value <= max;
+        }
+
         size_type num_tuples() const override { return 1; }
 
         void accept(ConstDataLayoutVisitor &v) const override;
@@ -190,6 +232,9 @@ struct M_EXPORT DataLayout
     ///> use an `INode` to store a single child, allowing us to exploit `INode` abstractions within `DataLayout`
     INode inode_;
 
+    ///> returns the `Leaf` with index \p idx; throws `m::invalid_argument` if there is no such `Leaf`
+    Leaf & find_leaf(size_type idx);
+
     /*----- Methods --------------------------------------------------------------------------------------------------*/
     public:
     /** Create a new `DataLayout` for laying out \p num_tuples many tuples in linear memory.  If \p num_tuples is zero,
@@ -221,6 +266,15 @@ struct M_EXPORT DataLayout
      */
     INode & add_inode(size_type num_tuples, uint64_t stride_in_bits);
 
+    /** Dictionary-encodes the `Leaf` with index \p idx, which must currently store `Dictionary::code_type`s, as values
+     * of \p type.  Creates a fresh `Dictionary` for the `Leaf`. */
+    void dictionary_encode(size_type idx, const CharacterSequence *type);
+
+    /** Frame-of-reference encodes the `Leaf` with index \p idx, which must currently store integers or a `Bitmap`
+     * narrower than \p type, as values of \p type relative to \p reference.  A `Leaf` storing a `Bitmap` becomes
+     * bit-packed. */
+    void frame_of_reference_encode(size_type idx, const Numeric *type, int64_t reference);
+
     void accept(ConstDataLayoutVisitor &v) const;
     void for_sibling_leaves(callback_leaves_t callback) const;
 
@@ -246,6 +300,18 @@ M_LCOV_EXCL_STOP
 
 M_DECLARE_VISITOR(ConstDataLayoutVisitor, const storage::DataLayout::Node, M_DATA_LAYOUT_CLASSES)
 
+/*======================================================================================================================
+ * Helper functions for writers
+ *====================================================================================================================*/
+
+/** Returns all frame-of-reference encoded `Leaf`s of \p layout.  Writers must check that the values they store into
+ * these `Leaf`s are representable, see `DataLayout::Leaf::can_encode()`. */
+std::vector<const DataLayout::Leaf*> frame_of_reference_leaves(const DataLayout &layout);
+
+/** Returns `true` iff \p layout for \p num_attrs attributes contains a NULL bitmap, i.e. a `Leaf` with index
+ * \p num_attrs.  Writers must not store `NULL` values into a layout without NULL bitmap. */
+bool has_null_bitmap(const DataLayout &layout, std::size_t num_attrs);
+
 /*======================================================================================================================
  * Helper functions for SIMD support
  *====================================================================================================================*/
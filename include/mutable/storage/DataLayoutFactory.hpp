@@ -2,6 +2,8 @@
 
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/DataLayout.hpp>
+#include <optional>
+#include <utility>
 #include <vector>
 
 
@@ -20,20 +22,36 @@ struct DataLayoutFactory
     /** Creates and returns a *deep copy* of `this`. */
     virtual std::unique_ptr<DataLayoutFactory> clone() const = 0;
 
-    /** Returns a `DataLayout` for the given `Type`s contained in \p schema and length \p num_tuples. */
+    /** Returns a `DataLayout` for the given `Type`s contained in \p schema and length \p num_tuples.  Only entries of
+     * \p schema that are nullable may be `NULL`. */
     DataLayout make(const Schema &schema, std::size_t num_tuples = 0) const {
-        view v(schema.cbegin(), schema.cend(), [](auto it) -> auto & { return it->type; });
-        return make(v.begin(), v.end(), num_tuples);
+        std::vector<const Type*> types;
+        std::vector<bool> nullable;
+        for (auto &e : schema) {
+            types.push_back(e.type);
+            nullable.push_back(e.nullable());
+        }
+        return make(std::move(types), std::move(nullable), num_tuples);
     }
 
-    /** Returns a `DataLayout` for the given `Type`s in the range from \p begin to \p end and length \p num_tuples. */
+    /** Returns a `DataLayout` for the given `Type`s in the range from \p begin to \p end and length \p num_tuples.
+     * All values may be `NULL`. */
     template<typename It>
     DataLayout make(It begin, It end, std::size_t num_tuples = 0) const {
         return make(std::vector<const Type*>(begin, end), num_tuples);
     }
 
-    /** Returns a `DataLayout` for the given \p types and length \p num_tuples (0 means infinite layout). */
-    virtual DataLayout make(std::vector<const Type*> types, std::size_t num_tuples = 0) const = 0;
+    /** Returns a `DataLayout` for the given \p types and length \p num_tuples.  All values may be `NULL`. */
+    DataLayout make(std::vector<const Type*> types, std::size_t num_tuples = 0) const {
+        std::vector<bool> nullable(types.size(), true);
+        return make(std::move(types), std::move(nullable), num_tuples);
+    }
+
+    /** Returns a `DataLayout` for the given \p types and length \p num_tuples (0 means infinite layout).  The `i`-th
+     * entry of \p nullable tells whether values of the `i`-th type may be `NULL`.  The layout contains a NULL bitmap,
+     * i.e. a `Leaf` with index `types.size()` holding one bit per type, iff any value may be `NULL`. */
+    virtual DataLayout make(std::vector<const Type*> types, std::vector<bool> nullable,
+                            std::size_t num_tuples = 0) const = 0;
 
     friend M_EXPORT std::ostream & operator<<(std::ostream &out, const DataLayoutFactory &factory);
 
@@ -49,7 +67,8 @@ struct RowLayoutFactory : DataLayoutFactory
     std::unique_ptr<DataLayoutFactory> clone() const override { return std::make_unique<RowLayoutFactory>(); }
 
     using DataLayoutFactory::make;
-    DataLayout make(std::vector<const Type*> types, std::size_t num_tuples = 0) const override;
+    DataLayout make(std::vector<const Type*> types, std::vector<bool> nullable,
+                    std::size_t num_tuples = 0) const override;
 
     private:
     void print(std::ostream &out) const override { out << "Row"; }
@@ -93,7 +112,8 @@ struct PAXLayoutFactory : DataLayoutFactory
     }
 
     using DataLayoutFactory::make;
-    DataLayout make(std::vector<const Type*> types, std::size_t num_tuples = 0) const override;
+    DataLayout make(std::vector<const Type*> types, std::vector<bool> nullable,
+                    std::size_t num_tuples = 0) const override;
 
     private:
     void print(std::ostream &out) const override {
@@ -106,6 +126,76 @@ struct PAXLayoutFactory : DataLayoutFactory
     }
 };
 
+/** Decorates another `DataLayoutFactory` by dictionary-encoding all `CharacterSequence` attributes.  The decorated
+ * factory lays out a `Dictionary::code_type` in place of each `CharacterSequence`, which usually greatly reduces the
+ * size of a layout and hence the amount of memory to scan. */
+struct DictionaryLayoutFactory : DataLayoutFactory
+{
+    private:
+    std::unique_ptr<DataLayoutFactory> factory_; ///< the decorated factory
+
+    public:
+    explicit DictionaryLayoutFactory(std::unique_ptr<DataLayoutFactory> factory) : factory_(M_notnull(std::move(factory))) { }
+
+    std::unique_ptr<DataLayoutFactory> clone() const override {
+        return std::make_unique<DictionaryLayoutFactory>(factory_->clone());
+    }
+
+    using DataLayoutFactory::make;
+    DataLayout make(std::vector<const Type*> types, std::vector<bool> nullable,
+                    std::size_t num_tuples = 0) const override;
+
+    private:
+    void print(std::ostream &out) const override { out << "Dictionary(" << *factory_ << ")"; }
+};
+
+/** Decorates another `DataLayoutFactory` by frame-of-reference encoding integral `Numeric` attributes whose range of
+ * values is known.  The decorated factory lays out the narrowest signed integer of 1, 2, or 4 bytes that can hold the
+ * difference of each value in the range to the range's midpoint, which serves as reference value.  If bit-packing is
+ * enabled and fewer bits suffice, it instead lays out a `Bitmap` of as many bits as needed to hold the difference of
+ * each value to the range's minimum, which then serves as reference value.  Bit-packing is limited to
+ * `MAX_BIT_PACKING_WIDTH` bits, s.t. a value together with its bit offset always fits into 64 bits.  Attributes
+ * without range or for which no narrower representation suffices are laid out unencoded. */
+struct FrameOfReferenceLayoutFactory : DataLayoutFactory
+{
+    ///> the range of values of an attribute, given by its minimum and maximum value
+    using range_type = std::pair<int64_t, int64_t>;
+
+    ///> the maximum number of bits of a bit-packed value
+    static constexpr std::size_t MAX_BIT_PACKING_WIDTH = 57;
+
+    private:
+    std::unique_ptr<DataLayoutFactory> factory_; ///< the decorated factory
+    std::vector<std::optional<range_type>> ranges_; ///< the range of values of each attribute, if known
+    bool bit_packing_; ///< whether to bit-pack values if fewer bits than whole bytes suffice
+
+    public:
+    FrameOfReferenceLayoutFactory(std::unique_ptr<DataLayoutFactory> factory,
+                                  std::vector<std::optional<range_type>> ranges, bool bit_packing = true)
+        : factory_(M_notnull(std::move(factory)))
+        , ranges_(std::move(ranges))
+        , bit_packing_(bit_packing)
+    { }
+
+    std::unique_ptr<DataLayoutFactory> clone() const override {
+        return std::make_unique<FrameOfReferenceLayoutFactory>(factory_->clone(), ranges_, bit_packing_);
+    }
+
+    /** Returns the decorated factory. */
+    const DataLayoutFactory & factory() const { return *factory_; }
+    /** Returns the range of values of each attribute, if known. */
+    const std::vector<std::optional<range_type>> & ranges() const { return ranges_; }
+    /** Returns `true` iff values are bit-packed if fewer bits than whole bytes suffice. */
+    bool bit_packing() const { return bit_packing_; }
+
+    using DataLayoutFactory::make;
+    DataLayout make(std::vector<const Type*> types, std::vector<bool> nullable,
+                    std::size_t num_tuples = 0) const override;
+
+    private:
+    void print(std::ostream &out) const override { out << "FrameOfReference(" << *factory_ << ")"; }
+};
+
 }
 
 }
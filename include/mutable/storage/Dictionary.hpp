@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <mutable/mutable-config.hpp>
+#include <mutable/util/macro.hpp>
+#include <mutable/util/memory.hpp>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+
+namespace m {
+
+// forward declarations
+struct CharacterSequence;
+
+namespace storage {
+
+/** A `Dictionary` maps the distinct values of a `CharacterSequence` attribute to dense integer codes.  A
+ * dictionary-encoded attribute stores only the code of each value, see `DataLayout::Leaf::dictionary()`.
+ *
+ * The values are laid out in the dictionary's `memory()` as an array of fixed-size, NUL-terminated entries, such that
+ * the entry of a code is found at `memory().addr() + code * entry_size()`.  This allows backends to decode a value by
+ * mere address computation, e.g. after mapping the dictionary into the linear memory of a WebAssembly module.  Codes
+ * are assigned in the order in which values are first encoded and never change.  Codes are *order-preserving*, i.e.
+ * ordered like their values, as long as values are encoded in ascending order, see `is_order_preserving()`.  Hence,
+ * a table is re-encoded with order-preserving codes by encoding its distinct values in ascending order before its rows,
+ * e.g. when its data layout is changed.  Values are ordered byte-wise, like `strcmp()`.  Equality predicates can always
+ * be evaluated on codes, see `find()`, and range predicates on order-preserving codes, see `lower_bound()`.
+ *
+ * A writer may `encode()` values while readers `find()` and `decode()` values concurrently. */
+struct M_EXPORT Dictionary
+{
+    using code_type = uint32_t;
+
+    /** The initial size of the memory of the dictionary.  Memory is only backed once written to.  Whenever the
+     * dictionary exceeds its memory, the memory is doubled. */
+    static constexpr std::size_t ALLOCATION_SIZE = 1UL << 24; ///< 16 MiB
+
+    private:
+    const CharacterSequence *type_; ///< the type of the encoded values
+    std::size_t entry_size_; ///< the size of an entry, in bytes; includes the terminating NUL byte
+    memory::LinearAllocator allocator_; ///< the memory allocator
+    memory::Memory entries_; ///< the memory containing the entries
+    std::unordered_map<std::string, code_type> codes_; ///< maps each value to its code
+    bool is_order_preserving_ = true; ///< whether the codes are ordered like their values
+    ///> guards `codes_` and `is_order_preserving_`; acquire after `Store::Memory_Latch()`, never before
+    mutable std::shared_mutex mutex_;
+
+    public:
+    explicit Dictionary(const CharacterSequence *type);
+    Dictionary(const Dictionary&) = delete;
+
+    /** Returns the type of the encoded values. */
+    const CharacterSequence & type() const { return *type_; }
+    /** Returns the number of distinct values in the dictionary. */
+    std::size_t size() const { std::shared_lock<std::shared_mutex> lock(mutex_); return codes_.size(); }
+    /** Returns the size of an entry, in bytes. */
+    std::size_t entry_size() const { return entry_size_; }
+    /** Returns the memory containing the entries.  The memory may be moved by `encode()` while holding
+     * `Store::Memory_Latch()` exclusively. */
+    const memory::Memory & memory() const { return entries_; }
+
+    /** Returns the code of \p value.  Adds \p value to the dictionary if it is not yet contained.  At most
+     * `type().length` characters of \p value are considered. */
+    code_type encode(const char *value);
+
+    /** Returns the code of \p value, if contained in the dictionary. */
+    std::optional<code_type> find(const char *value) const;
+
+    /** Returns `true` iff the codes are ordered like their values, i.e. iff all values were encoded in ascending
+     * order.  Once a value is encoded that is less than a contained value, codes are no longer order-preserving. */
+    bool is_order_preserving() const { std::shared_lock<std::shared_mutex> lock(mutex_); return is_order_preserving_; }
+
+    /** Returns the number of values in the dictionary that are less than \p value, i.e. the least code whose value is
+     * not less than \p value, or `size()`.  The dictionary must be order-preserving. */
+    code_type lower_bound(const char *value) const { return bound(value, /* is_upper= */ false); }
+    /** Returns the number of values in the dictionary that are not greater than \p value, i.e. the least code whose
+     * value is greater than \p value, or `size()`.  The dictionary must be order-preserving. */
+    code_type upper_bound(const char *value) const { return bound(value, /* is_upper= */ true); }
+
+    /** Returns the NUL-terminated value of \p code.  Code 0 may be decoded even if the dictionary is empty, yielding
+     * the empty string; this is what the unwritten codes of NULL values decode to. */
+    const char * decode(code_type code) const {
+        M_insist(code == 0 or code < size(), "code out of bounds");
+        return entries_.as<const char*>() + code * entry_size_;
+    }
+
+    private:
+    /** Returns the least code whose value is not less than \p value, or greater than \p value if \p is_upper. */
+    code_type bound(const char *value, bool is_upper) const;
+
+    public:
+M_LCOV_EXCL_START
+    void dump(std::ostream &out) const;
+    void dump() const;
+M_LCOV_EXCL_STOP
+};
+
+}
+
+}
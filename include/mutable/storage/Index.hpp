@@ -4,9 +4,13 @@
 #include <cmath>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <mutable/util/concepts.hpp>
 #include <mutable/util/exception.hpp>
 #include <mutable/util/macro.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -16,11 +20,13 @@ namespace m {
 // Forward declarations
 struct Table;
 struct Schema;
+struct Type;
+struct Value;
 
 namespace idx {
 
 /** An enum class that lists all supported index methods. */
-enum class IndexMethod { Array, Rmi };
+enum class IndexMethod { Array, Rmi, Pgm, Composite };
 
 /** The base class for indexes. */
 struct IndexBase
@@ -32,7 +38,8 @@ struct IndexBase
     IndexBase(IndexBase&&) = default;
     virtual ~IndexBase() { }
 
-    /** Bulkloads the index by executing a query on \p table using \p key_schema. */
+    /** Bulkloads the index from the rows of \p table on the key contained in \p key_schema.  The rows are scanned
+     * directly from the data layout of \p table by multiple threads, see `--index-build-threads`. */
     virtual void bulkload(const Table &table, const Schema &key_schema) = 0;
     /* Returns the number of entries in the index. */
     virtual std::size_t num_entries() const = 0;
@@ -41,10 +48,6 @@ struct IndexBase
 
     virtual void dump(std::ostream &out) const = 0;
     virtual void dump() const = 0;
-
-    protected:
-    /** Constructs a query string to select all attributes in \p schema from \p table. */
-    static std::string build_query(const Table &table, const Schema &schema);
 };
 
 /** A simple index based on a sorted array that maps keys to their `tuple_id`. */
@@ -80,9 +83,10 @@ struct ArrayIndex : IndexBase
     public:
     ArrayIndex() : finalized_(false) { }
 
-    /** Bulkloads the index from \p table on the key contained in \p key_schema by executing a query and adding one
-     * entry after another.  The index is finalized in the end.  Throws `m::invalid_arguent` if \p key_schema contains
-     * more than one entry or `key_type` and the attribute type of the entry in \p key_schema do not match. */
+    /** Bulkloads the index from \p table on the key contained in \p key_schema.  Disjoint ranges of rows are scanned in
+     * parallel directly from the data layout of \p table, without executing a query.  The value of each entry is the
+     * ID of its row.  The index is finalized in the end.  Throws `m::invalid_arguent` if \p key_schema contains more
+     * than one entry or `key_type` and the attribute type of the entry in \p key_schema do not match. */
     void bulkload(const Table &table, const Schema &key_schema) override;
 
     /** Returns the number of entries in the index. */
@@ -95,11 +99,8 @@ struct ArrayIndex : IndexBase
      * the vector to be sorted and the index to be usable. */
     void add(const key_type key, const value_type value);
 
-    /** Sorts the underlying vector and flags the index as finalized. */
-    virtual void finalize() {
-        std::sort(data_.begin(), data_.end(), cmp);
-        finalized_ = true;
-    }
+    /** Sorts the underlying vector in parallel and flags the index as finalized. */
+    virtual void finalize();
 
     /** Returns `true` iff the index is currently finalized. */
     bool finalized() const { return finalized_; }
@@ -213,7 +214,8 @@ struct RecursiveModelIndex : ArrayIndex<Key>
     /** Returns the `IndexMethod` of the index. */
     IndexMethod method() const override { return IndexMethod::Rmi; }
 
-    /** Sorts the underlying vector, builds the linear models, and flags the index as finalized. */
+    /** Sorts the underlying vector, builds the linear models, and flags the index as finalized.  The vector is sorted
+     * and the models of the second layer are trained in parallel. */
     void finalize() override;
 
     /** Returns an iterator pointing to the first entry of the vector such that `entry.key` < \p key is `false`, i.e.
@@ -291,6 +293,234 @@ struct RecursiveModelIndex : ArrayIndex<Key>
     }
 };
 
+/** A learned index in the style of the PGM-index that maps keys to their `tuple_id`.  The index approximates the
+ * position of a key in the sorted entries by a sequence of linear *segments*, each fitted to a range of keys such that
+ * its prediction for every key of the range deviates by at most `epsilon()` positions.  Further levels of segments are
+ * fitted to the first keys of the segments of the level below, until a single segment remains.  Unlike the
+ * `RecursiveModelIndex`, every lookup hence searches only a window of at most `2 * epsilon() + 3` entries per level.
+ *
+ * Segments are fitted to *model keys*.  Model keys of arithmetic keys preserve their order.  Model keys of strings are
+ * the first eight characters encoded big-endian, such that they compare like the string prefixes with `strcmp()`.
+ * Strings of equal prefix are then searched by `strcmp()` among the entries of that prefix, which are located by two
+ * lookups of model keys. */
+template<typename Key>
+requires arithmetic<Key> or std::same_as<Key, const char*>
+struct PiecewiseGeometricModelIndex : ArrayIndex<Key>
+{
+    using base_type = ArrayIndex<Key>;
+    using key_type = base_type::key_type;
+    using value_type = base_type::value_type;
+    using entry_type = base_type::entry_type;
+    using container_type = base_type::container_type;
+    using const_iterator = base_type::const_iterator;
+    /** The type of model keys, i.e. integers with flipped sign bit, floating-point numbers, or string prefixes. */
+    using model_key_type = std::conditional_t<std::floating_point<Key>, double, uint64_t>;
+
+    /** A linear segment that predicts the position of the model keys greater than or equal to its first key. */
+    struct Segment
+    {
+        model_key_type key; ///< the first model key of the segment
+        double slope; ///< the increase of the predicted position per unit of model key
+        std::size_t offset; ///< the position of the first model key
+
+        Segment(model_key_type key, double slope, std::size_t offset) : key(key), slope(slope), offset(offset) { }
+
+        double operator()(const model_key_type x) const {
+            return std::fma(slope, distance(key, x), static_cast<double>(offset));
+        }
+    };
+
+    protected:
+    std::vector<std::vector<Segment>> levels_; ///< the levels of segments, starting with the one over the entries
+    std::size_t epsilon_ = 0; ///< the maximum error of the segments
+
+    public:
+    PiecewiseGeometricModelIndex() : base_type() { }
+
+    /** Returns the `IndexMethod` of the index. */
+    IndexMethod method() const override { return IndexMethod::Pgm; }
+
+    /** Sorts the underlying vector, fits the segments with the maximum error given by `--pgm-epsilon`, and flags the
+     * index as finalized.  The vector is sorted and disjoint ranges of the lowest level are fitted in parallel. */
+    void finalize() override;
+
+    /** Returns the maximum error of the segments. */
+    std::size_t epsilon() const { return epsilon_; }
+    /** Returns the number of segments of the lowest level, i.e. the one over the entries. */
+    std::size_t num_segments() const { return levels_.empty() ? 0 : levels_.front().size(); }
+    /** Returns the number of levels of segments. */
+    std::size_t num_levels() const { return levels_.size(); }
+
+    /** Returns an iterator pointing to the first entry of the vector such that `entry.key` < \p key is `false`, i.e.
+     * that is greater than or equal to \p key, or `end()` if no such element is found.  Throws `m::exception` if the
+     * index is not finalized. */
+    const_iterator lower_bound(const key_type key) const override {
+        if (not base_type::finalized()) throw m::exception("Index is not finalized.");
+        if constexpr(std::same_as<key_type, const char*>) {
+            auto [first, last] = prefix_range(key);
+            return std::lower_bound(first, last, key, base_type::cmp);
+        } else {
+            return base_type::begin() + model_lower_bound(model_key(key));
+        }
+    }
+
+    /** Returns an iterator pointing to the first entry of the vector such that `entry.key` < \p key is `true`, i.e.
+     * that is strictly greater than \p key, or `end()` if no such element is found.  Throws `m::exception` if the index
+     * is not finalized. */
+    const_iterator upper_bound(const key_type key) const override {
+        if (not base_type::finalized()) throw m::exception("Index is not finalized.");
+        if constexpr(std::same_as<key_type, const char*>) {
+            auto [first, last] = prefix_range(key);
+            return std::upper_bound(first, last, key, base_type::cmp);
+        } else {
+            auto succ = successor(model_key(key));
+            return succ ? base_type::begin() + model_lower_bound(*succ) : base_type::end();
+        }
+    }
+
+    void dump(std::ostream &out) const override {
+        out << "PiecewiseGeometricModelIndex<" << typeid(key_type).name() << "> with " << num_segments()
+            << " segments in " << num_levels() << " levels" << std::endl;
+    }
+    void dump() const override { dump(std::cerr); }
+
+    /** Returns the model key of \p key. */
+    static model_key_type model_key(const key_type key) {
+        if constexpr(std::same_as<key_type, const char*>) {
+            uint64_t prefix = 0;
+            bool is_end = false;
+            for (std::size_t i = 0; i != sizeof(uint64_t); ++i) {
+                is_end = is_end or key[i] == '\0'; // do not read past the terminating NUL byte
+                prefix = prefix << 8 | (is_end ? 0 : static_cast<unsigned char>(key[i]));
+            }
+            return prefix;
+        } else if constexpr(std::floating_point<key_type>) {
+            return key;
+        } else {
+            return static_cast<uint64_t>(static_cast<int64_t>(key)) ^ (uint64_t(1) << 63); // flip sign bit
+        }
+    }
+
+    /** Returns the smallest model key greater than \p x, or `std::nullopt` if \p x is the greatest model key. */
+    static std::optional<model_key_type> successor(const model_key_type x) {
+        if constexpr(std::floating_point<model_key_type>) {
+            if (x == std::numeric_limits<model_key_type>::infinity()) return std::nullopt;
+            return std::nextafter(x, std::numeric_limits<model_key_type>::infinity());
+        } else {
+            if (x == std::numeric_limits<model_key_type>::max()) return std::nullopt;
+            return x + 1;
+        }
+    }
+
+    /** Returns the distance from model key \p from to model key \p to, or 0 if \p to is not greater. */
+    static double distance(const model_key_type from, const model_key_type to) {
+        if (not (from < to)) return 0.0;
+        return static_cast<double>(to - from); // unsigned model keys do not overflow
+    }
+
+    private:
+    using point_type = std::pair<model_key_type, std::size_t>;
+
+    /** Fits segments with a maximum error of \p epsilon to the points in [\p first, \p last).  The model keys of the
+     * points must be strictly increasing and their positions increasing. */
+    static std::vector<Segment> fit_segments(typename std::vector<point_type>::const_iterator first,
+                                             typename std::vector<point_type>::const_iterator last,
+                                             std::size_t epsilon);
+    /** Returns the position of the first entry whose model key is greater than or equal to \p x. */
+    std::size_t model_lower_bound(const model_key_type x) const;
+    /** Returns the range of the entries whose model key equals the one of \p key. */
+    std::pair<const_iterator, const_iterator> prefix_range(const key_type key) const {
+        const auto x = model_key(key);
+        const auto succ = successor(x);
+        return { base_type::begin() + model_lower_bound(x),
+                 succ ? base_type::begin() + model_lower_bound(*succ) : base_type::end() };
+    }
+    /** Returns the window of positions that contains the position of model key \p x among the \p n elements fitted by
+     * the segments \p segments, as predicted by the segment at index \p segment_id. */
+    std::pair<std::size_t, std::size_t> search_window(const std::vector<Segment> &segments, std::size_t segment_id,
+                                                      std::size_t n, const model_key_type x) const;
+};
+
+/** An index on a composite key of one or more attributes that maps keys to their `tuple_id`.  Every key is stored in
+ * a *normalized* encoding, such that keys compare like the tuples of their attribute values when compared bytewise
+ * with `memcmp()`, where `NULL` compares less than all other values.  Every row is indexed, including rows with
+ * `NULL` values in key attributes.  The encoding of an attribute value has a fixed width determined by the attribute
+ * type, hence the encoding of a prefix of the key attributes is a prefix of the encoded key.  All entries whose key
+ * starts with the same values of the first attributes are therefore stored consecutively, which allows looking up an
+ * equality predicate on a prefix of the key attributes followed by a range predicate on the next attribute, see
+ * `lower_bound()` and `upper_bound()`. */
+struct CompositeIndex : IndexBase
+{
+    using key_type = std::string;
+    using value_type = std::size_t;
+    using entry_type = std::pair<key_type, value_type>;
+    using container_type = std::vector<entry_type>;
+    using const_iterator = typename container_type::const_iterator;
+
+    static constexpr char NULL_BYTE = '\x00'; ///< precedes the encoding of a `NULL` value, such that `NULL` sorts first
+    static constexpr char NOT_NULL_BYTE = '\x01'; ///< precedes the encoding of a non-`NULL` value
+
+    private:
+    container_type data_; ///< A vector holding the index entries consisting of pairs of normalized key and value
+    bool finalized_; ///< flag to signalize whether index is finalized, i.e. array is sorted
+
+    public:
+    CompositeIndex() : finalized_(false) { }
+
+    /** Bulkloads the index from \p table on the key contained in \p key_schema, in the order of its entries.  Rows
+     * are scanned in parallel like for `ArrayIndex::bulkload()`.  `NULL` values are encoded by `encode_null()`.  The
+     * index is finalized in the end.  Throws `m::invalid_argument` if \p key_schema is empty or contains
+     * an entry of a type that cannot be encoded, see `encode()`. */
+    void bulkload(const Table &table, const Schema &key_schema) override;
+
+    /** Returns the number of entries in the index. */
+    std::size_t num_entries() const override { return data_.size(); }
+
+    /** Returns the `IndexMethod` of the index. */
+    IndexMethod method() const override { return IndexMethod::Composite; }
+
+    /** Adds a single pair of normalized \p key and \p value to the index.  Note that `finalize()` has to be called
+     * afterwards for the vector to be sorted and the index to be usable. */
+    void add(key_type key, const value_type value) { data_.emplace_back(std::move(key), value); finalized_ = false; }
+
+    /** Sorts the underlying vector in parallel and flags the index as finalized. */
+    void finalize();
+
+    /** Returns `true` iff the index is currently finalized. */
+    bool finalized() const { return finalized_; }
+
+    /** Returns an iterator pointing to the first entry whose key is greater than or equal to \p prefix, or `end()` if
+     * no such entry exists.  If \p prefix encodes values of the first key attributes, this is the first entry whose
+     * key starts with \p prefix, if any.  Throws `m::exception` if the index is not finalized. */
+    const_iterator lower_bound(std::string_view prefix) const;
+
+    /** Returns an iterator pointing to the first entry whose key is greater than \p prefix and does not start with
+     * \p prefix, or `end()` if no such entry exists.  Hence, the entries whose keys start with \p prefix are exactly
+     * those in [`lower_bound(prefix)`, `upper_bound(prefix)`).  Throws `m::exception` if the index is not finalized. */
+    const_iterator upper_bound(std::string_view prefix) const;
+
+    /** Returns an iterator pointing to the first entry of the index. */
+    const_iterator begin()  const { return data_.cbegin(); }
+    const_iterator cbegin() const { return data_.cbegin(); }
+    /** Returns an interator pointing to the first element following the last entry of the index. */
+    const_iterator end() const  { return data_.cend(); }
+    const_iterator cend() const { return data_.cend(); }
+
+    /** Appends the normalized encoding of the non-`NULL` \p value of type \p type to \p key.  The encoding starts with
+     * `NOT_NULL_BYTE`.  Booleans are encoded as a single byte.  Integers, decimals, dates, and datetimes are encoded
+     * big-endian with the sign bit flipped.  Floating-point numbers are encoded big-endian with the sign bit flipped
+     * if positive and all bits flipped if negative.  Character sequences are padded with NUL bytes to their maximum
+     * length.  Throws `m::invalid_argument` if values of \p type cannot be encoded. */
+    static void encode(key_type &key, const Type &type, const Value &value);
+    /** Appends the normalized encoding of `NULL` of type \p type to \p key, i.e. `NULL_BYTE` followed by as many NUL
+     * bytes as the encoding of a value of \p type.  Throws `m::invalid_argument` if values of \p type cannot be
+     * encoded. */
+    static void encode_null(key_type &key, const Type &type);
+
+    void dump(std::ostream &out) const override { out << "CompositeIndex" << std::endl; }
+    void dump() const override { dump(std::cerr); }
+};
+
 #define M_INDEX_LIST_TEMPLATED(X) \
     X(m::idx::ArrayIndex<bool>) \
     X(m::idx::ArrayIndex<int8_t>) \
@@ -305,7 +535,14 @@ struct RecursiveModelIndex : ArrayIndex<Key>
     X(m::idx::RecursiveModelIndex<int32_t>) \
     X(m::idx::RecursiveModelIndex<int64_t>) \
     X(m::idx::RecursiveModelIndex<float>) \
-    X(m::idx::RecursiveModelIndex<double>)
+    X(m::idx::RecursiveModelIndex<double>) \
+    X(m::idx::PiecewiseGeometricModelIndex<int8_t>) \
+    X(m::idx::PiecewiseGeometricModelIndex<int16_t>) \
+    X(m::idx::PiecewiseGeometricModelIndex<int32_t>) \
+    X(m::idx::PiecewiseGeometricModelIndex<int64_t>) \
+    X(m::idx::PiecewiseGeometricModelIndex<float>) \
+    X(m::idx::PiecewiseGeometricModelIndex<double>) \
+    X(m::idx::PiecewiseGeometricModelIndex<const char*>)
 
 }
 
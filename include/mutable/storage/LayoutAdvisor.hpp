@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <mutable/mutable-config.hpp>
+#include <mutable/util/macro.hpp>
+#include <mutable/util/Pool.hpp>
+
+
+namespace m {
+
+// forward declarations
+struct Operator;
+struct Table;
+
+namespace storage {
+
+/** `AccessStatistics` count the accesses of queries to a `Store`.  An access is either a *point read*, i.e. a scan
+ * filtered by an equality predicate between an attribute of the store and a constant, or a *scan* otherwise.  For each
+ * access, the number of attributes read is recorded.  The statistics are the input of `advise_layout()`. */
+struct M_EXPORT AccessStatistics
+{
+    std::size_t num_point_reads = 0; ///< the number of point reads
+    std::size_t num_scans = 0; ///< the number of scans that are not point reads
+    std::size_t num_attrs_read = 0; ///< the number of attributes read, summed over all accesses
+
+    /** Returns the number of accesses. */
+    std::size_t num_accesses() const { return num_point_reads + num_scans; }
+    /** Returns the average number of attributes read per access. */
+    double avg_attrs_read() const {
+        return num_accesses() ? double(num_attrs_read) / num_accesses() : 0.;
+    }
+
+    /** Records an access reading \p num_attrs attributes, which is a point read iff \p is_point_read. */
+    void record(std::size_t num_attrs, bool is_point_read) {
+        ++(is_point_read ? num_point_reads : num_scans);
+        num_attrs_read += num_attrs;
+    }
+
+    /** Discards all recorded accesses. */
+    void clear() { *this = AccessStatistics(); }
+
+M_LCOV_EXCL_START
+    friend std::ostream & operator<<(std::ostream &out, const AccessStatistics &stats) {
+        return out << stats.num_point_reads << " point reads, " << stats.num_scans << " scans, "
+                   << stats.avg_attrs_read() << " attributes read on average";
+    }
+    void dump(std::ostream &out) const;
+    void dump() const;
+M_LCOV_EXCL_STOP
+};
+
+/** Records the accesses of the logical plan \p plan in the `AccessStatistics` of the stores it scans.  The schemas of
+ * the scans of \p plan must be minimized, see `Operator::minimize_schema()`, such that they only contain the attributes
+ * that are actually read. */
+void M_EXPORT record_accesses(const Operator &plan);
+
+/** Suggests a data layout for \p table from the `AccessStatistics` of its store.  Returns the name of a registered
+ * `DataLayoutFactory`, or nothing if no accesses were recorded.  The suggestion is
+ *
+ * - `Row` if most accesses are point reads of many attributes, such that each access reads a single row,
+ * - `PAX4K` if most accesses are point reads of few attributes, such that each access reads a single small block,
+ * - `PAX64M` if most accesses are scans of few attributes, such that each scanned attribute is read almost sequentially,
+ * - `PAX4M` otherwise. */
+ThreadSafePooledOptionalString M_EXPORT advise_layout(const Table &table);
+
+}
+
+}
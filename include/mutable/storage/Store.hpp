@@ -2,9 +2,14 @@
 
 #include <iostream>
 #include <memory>
+#include <mutable/storage/LayoutAdvisor.hpp>
 #include <mutable/mutable-config.hpp>
+#include <mutable/storage/VisibilitySummary.hpp>
+#include <mutable/storage/ZoneMap.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/memory.hpp>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
@@ -22,11 +27,73 @@ struct M_EXPORT Store
 {
     private:
     const Table &table_; ///< the table defining this store's schema
+    storage::ZoneMap zone_map_; ///< the zone map summarizing the rows of this store
+    ///> the accesses of queries to this store; recorded while planning queries, which only see the store as `const`
+    mutable storage::AccessStatistics access_statistics_;
+    ///> the summary of the timestamps of the rows of this store; computed lazily by readers, which see it as `const`
+    mutable storage::VisibilitySummary visibility_summary_;
 
     protected:
-    Store(const Table &table) : table_(table) {}
+    Store(const Table &table) : table_(table), zone_map_(table) {}
 
     public:
+    /** Returns the backing of the memory of stores as configured by the `Options`, i.e. the backing of stores that are
+     * not given an explicit backing. */
+    static memory::Backing Default_Backing();
+
+    /** Returns the latch guarding the memory of all stores.  Growing a store may move its memory to another virtual
+     * address range or reorganize its contents, so stores hold the latch exclusively while growing.  Readers that
+     * access the memory of stores while other threads append to stores must hold the latch shared, but only while
+     * they access the memory, e.g. for the duration of a scan, see `shared_memory_latch`. */
+    static std::shared_mutex & Memory_Latch();
+
+    struct shared_memory_latch;
+
+    /** Holds `Memory_Latch()` exclusively.  Nests within the calling thread, i.e. if the thread already holds the latch
+     * through another `exclusive_memory_latch`, acquiring it is a no-op.  Hence, operations that move memory, e.g.
+     * growing a dictionary, may run within operations that rewrite stores as a whole, e.g. changing a layout. */
+    struct M_EXPORT exclusive_memory_latch
+    {
+        private:
+        friend struct shared_memory_latch;
+
+        static thread_local bool Held_; ///< whether the calling thread holds `Memory_Latch()` exclusively
+        bool owns_ = false; ///< whether this object acquired `Memory_Latch()`
+
+        public:
+        exclusive_memory_latch() { lock(); }
+        explicit exclusive_memory_latch(std::defer_lock_t) { }
+        exclusive_memory_latch(const exclusive_memory_latch&) = delete;
+        ~exclusive_memory_latch();
+
+        /** Acquires `Memory_Latch()` exclusively, unless the calling thread already holds it. */
+        void lock();
+        /** Returns `true` iff the calling thread holds `Memory_Latch()` exclusively. */
+        bool held() const { return Held_; }
+    };
+
+    /** Holds `Memory_Latch()` shared.  Nests within the calling thread, i.e. if the thread already holds the latch,
+     * shared or exclusively, acquiring it is a no-op.  Hence, a scan may run within another scan or within an operation
+     * that moves memory.  Readers acquire the latch per scan rather than per query, such that a writer growing a store
+     * only waits for the scans in progress. */
+    struct M_EXPORT shared_memory_latch
+    {
+        private:
+        static thread_local bool Held_; ///< whether the calling thread holds `Memory_Latch()` shared
+        bool owns_ = false; ///< whether this object acquired `Memory_Latch()`
+
+        public:
+        shared_memory_latch() { lock(); }
+        explicit shared_memory_latch(std::defer_lock_t) { }
+        shared_memory_latch(const shared_memory_latch&) = delete;
+        ~shared_memory_latch() { unlock(); }
+
+        /** Acquires `Memory_Latch()` shared, unless the calling thread already holds it. */
+        void lock();
+        /** Releases `Memory_Latch()`, if this object acquired it. */
+        void unlock();
+    };
+
     Store(const Store &) = delete;
 
     Store(Store &&) = default;
@@ -35,9 +102,26 @@ struct M_EXPORT Store
 
     const Table &table() const { return table_; }
 
+    /** Returns the zone map summarizing the rows of this store.  Writers of the store report appended rows to it. */
+    storage::ZoneMap & zone_map() { return zone_map_; }
+    /** Returns the zone map summarizing the rows of this store. */
+    const storage::ZoneMap & zone_map() const { return zone_map_; }
+
+    /** Returns the statistics of the accesses of queries to this store. */
+    storage::AccessStatistics & access_statistics() const { return access_statistics_; }
+
+    /** Returns the summary of the timestamps of the rows of this store, if its table is multi-versioned.  Writers of
+     * timestamps invalidate the rows they wrote. */
+    storage::VisibilitySummary & visibility_summary() const { return visibility_summary_; }
+
     /** Returns the memory corresponding to the `Linearization`'s root node. */
     virtual const memory::Memory & memory() const = 0;
 
+    /** Returns `true` iff growing this store leaves its contents at their offsets within `memory()`.  Then, readers
+     * that mapped the memory by offset may keep accessing it while the store grows, without holding
+     * `Memory_Latch()`. */
+    virtual bool grows_in_place() const { return true; }
+
     /** Return the number of rows in this store. */
     virtual std::size_t num_rows() const = 0;
 
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <mutable/mutable-config.hpp>
+#include <mutable/storage/ZoneMap.hpp>
+#include <mutable/util/macro.hpp>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+
+namespace m {
+
+namespace storage {
+
+/** A `VisibilitySummary` summarizes the timestamps `$ts_begin` and `$ts_end` of the rows of a multi-versioned table in
+ * the blocks of the `ZoneMap`.  For each block, it records the minimum and the maximum of either timestamp.  From the
+ * summary of a block, a scan decides whether the timestamp filter of a transaction holds for all rows of the block,
+ * such that the filter need not be evaluated per row, or for no row of the block, such that the block is skipped.
+ *
+ * Timestamps are rewritten in place when transactions commit or abort.  Hence, summaries are computed lazily from the
+ * store, see `m::summarize_visibility()`, and every writer of timestamps must `invalidate()` the rows it wrote.  To
+ * allow for concurrent readers and writers, all methods are thread-safe and a summary computed from rows that were
+ * invalidated meanwhile is discarded, see `version()`. */
+struct M_EXPORT VisibilitySummary
+{
+    /** The number of rows per block, equal to that of the `ZoneMap`. */
+    static constexpr std::size_t NUM_ROWS_PER_BLOCK = ZoneMap::NUM_ROWS_PER_BLOCK;
+
+    /** Whether a predicate holds for the rows of a block. */
+    enum truth { NEVER, SOMETIMES, ALWAYS };
+
+    /** The summary of a single block. */
+    struct entry_type
+    {
+        int64_t min_ts_begin = std::numeric_limits<int64_t>::max();
+        int64_t max_ts_begin = std::numeric_limits<int64_t>::min();
+        int64_t min_ts_end = std::numeric_limits<int64_t>::max();
+        int64_t max_ts_end = std::numeric_limits<int64_t>::min();
+
+        /** Adds a row with the timestamps \p ts_begin and \p ts_end to the summary. */
+        void update(int64_t ts_begin, int64_t ts_end) {
+            min_ts_begin = std::min(min_ts_begin, ts_begin);
+            max_ts_begin = std::max(max_ts_begin, ts_begin);
+            min_ts_end = std::min(min_ts_end, ts_end);
+            max_ts_end = std::max(max_ts_end, ts_end);
+        }
+
+        /** Returns whether the predicate `ts op value` holds for the rows of the summarized block, where `ts` is
+         * `$ts_begin` if \p is_ts_begin and `$ts_end` otherwise. */
+        truth decide(bool is_ts_begin, ZoneMap::cmp_op op, int64_t value) const;
+    };
+
+    private:
+    /** The summary of a block together with the state required to validate it. */
+    struct block_type
+    {
+        entry_type entry;
+        std::size_t num_rows = 0; ///< the number of rows summarized by `entry`
+        uint64_t version = 0; ///< incremented whenever rows of the block are invalidated
+        bool is_valid = false; ///< whether `entry` summarizes the current rows of the block
+    };
+
+    mutable std::mutex mutex_; ///< protects `blocks_`
+    std::vector<block_type> blocks_;
+
+    public:
+    VisibilitySummary() = default;
+    VisibilitySummary(const VisibilitySummary&) = delete;
+    VisibilitySummary(VisibilitySummary &&other) : blocks_(std::move(other.blocks_)) { }
+
+    /** Returns the summary of block \p block if it is valid and summarizes the \p num_rows rows the block currently
+     * contains, and `std::nullopt` otherwise. */
+    std::optional<entry_type> get(std::size_t block, std::size_t num_rows) const;
+
+    /** Returns the version of block \p block.  A summary must be computed *after* obtaining the version of its block
+     * and be handed to `put()` together with that version. */
+    uint64_t version(std::size_t block) const;
+
+    /** Stores the summary \p entry of the first \p num_rows rows of block \p block, computed from the rows as of
+     * version \p version.  The summary is discarded if rows of the block were invalidated since. */
+    void put(std::size_t block, std::size_t num_rows, uint64_t version, const entry_type &entry);
+
+    /** Invalidates the summaries of all blocks containing rows in the range [\p begin, \p end). */
+    void invalidate(std::size_t begin, std::size_t end);
+
+    /** Invalidates the summaries of all blocks. */
+    void clear();
+
+M_LCOV_EXCL_START
+    void dump(std::ostream &out) const;
+    void dump() const;
+M_LCOV_EXCL_STOP
+};
+
+}
+
+}
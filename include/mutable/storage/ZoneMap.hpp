@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/mutable-config.hpp>
+#include <mutable/util/macro.hpp>
+#include <vector>
+
+
+namespace m {
+
+// forward declarations
+struct Table;
+struct Type;
+
+namespace storage {
+
+/** A `ZoneMap` summarizes the rows of a `Store` in *blocks* of `NUM_ROWS_PER_BLOCK` consecutive rows.  For each block
+ * and each tracked attribute, it records the minimum and the maximum of the non-`NULL` values as well as the number of
+ * `NULL` values.  Tracked are all visible attributes of integral, `Date`, `DateTime`, or `double` type.  A scan may
+ * skip every block whose summary proves that no row of the block satisfies the filter condition of the scan.
+ *
+ * Blocks are independent of the `DataLayout` of the table, such that the zone map remains valid when the table is
+ * given a new layout.  The writers of a store, i.e. `StoreWriter` and `DSVReader`, report each row in the order of
+ * appending by calling `update()`.  Rows written by other means are not reported; a zone map that does not summarize
+ * all rows of its store must not be used, see `covers()`.
+ *
+ * Readers may use the zone map while the single writer of the store reports rows, provided they hold
+ * `Store::Memory_Latch()` shared.  The writer holds the latch exclusively while the entries move. */
+struct M_EXPORT ZoneMap
+{
+    /** The number of rows per block.  Must be a multiple of the number of SIMD lanes of any scan. */
+    static constexpr std::size_t NUM_ROWS_PER_BLOCK = 1UL << 14;
+
+    /** The comparison operators of predicates a zone map can decide. */
+    enum cmp_op { EQ, LT, LE, GT, GE };
+
+    /** The summary of a single attribute within a single block. */
+    struct entry_type
+    {
+        Value min; ///< the minimum non-`NULL` value
+        Value max; ///< the maximum non-`NULL` value
+        std::size_t num_nulls = 0; ///< the number of `NULL` values
+    };
+
+    private:
+    const Table &table_; ///< the table whose rows are summarized
+    std::vector<const Type*> types_; ///< maps each attribute ID to its type, or to `nullptr` if not tracked
+    std::vector<entry_type> entries_; ///< the entries, block-major
+    ///> the number of summarized rows; released after the entries of a row are written
+    std::atomic<std::size_t> num_rows_ = 0;
+    std::atomic<bool> is_complete_ = true; ///< `false` iff a row was not reported in the order of appending
+
+    public:
+    explicit ZoneMap(const Table &table) : table_(table) { }
+    ZoneMap(const ZoneMap&) = delete;
+    ZoneMap(ZoneMap &&other)
+        : table_(other.table_)
+        , types_(std::move(other.types_))
+        , entries_(std::move(other.entries_))
+        , num_rows_(other.num_rows_.load())
+        , is_complete_(other.is_complete_.load())
+    { }
+
+    /** Returns the number of summarized rows. */
+    std::size_t num_rows() const { return num_rows_.load(std::memory_order_acquire); }
+    /** Returns the number of blocks. */
+    std::size_t num_blocks() const { return (num_rows() + NUM_ROWS_PER_BLOCK - 1) / NUM_ROWS_PER_BLOCK; }
+    /** Returns `true` iff this zone map summarizes exactly the first \p num_rows rows of its store. */
+    bool covers(std::size_t num_rows) const {
+        return is_complete_.load(std::memory_order_acquire) and this->num_rows() == num_rows;
+    }
+
+    /** Returns `true` iff the attribute with ID \p attr_id is tracked. */
+    bool is_tracked(std::size_t attr_id) const { return attr_id < types_.size() and types_[attr_id]; }
+    /** Returns `true` iff the attribute with ID \p attr_id is tracked as `double`, and as `int64_t` otherwise. */
+    bool is_floating_point(std::size_t attr_id) const;
+
+    /** Returns the summary of the attribute with ID \p attr_id in block \p block. */
+    const entry_type & get(std::size_t block, std::size_t attr_id) const {
+        M_insist(block < num_blocks(), "block out of bounds");
+        M_insist(is_tracked(attr_id), "attribute is not tracked");
+        return entries_[block * types_.size() + attr_id];
+    }
+
+    /** Adds the row with ID \p row_id and the values \p tup to the summary.  The values of \p tup are indexed by
+     * attribute ID.  A row that is not reported in the order of appending renders the zone map incomplete. */
+    void update(std::size_t row_id, const Tuple &tup);
+
+    /** Notifies the zone map that its store was truncated to \p num_rows rows.  Dropping summarized rows renders the
+     * zone map incomplete. */
+    void truncate(std::size_t num_rows) {
+        if (num_rows < num_rows_.load(std::memory_order_relaxed))
+            is_complete_.store(false, std::memory_order_release); // keep the entries, readers may still use them
+    }
+
+    /** Discards all summaries, such that the zone map is complete and summarizes no rows.  Used when the rows of the
+     * store are rewritten, after which each row must be reported anew. */
+    void clear();
+
+    /** Returns `false` iff the predicate `A op value` is proven to be false for every row of block \p block, where `A`
+     * is the attribute with ID \p attr_id. */
+    bool may_satisfy(std::size_t block, std::size_t attr_id, cmp_op op, int64_t value) const;
+    /** Returns `false` iff the predicate `A op value` is proven to be false for every row of block \p block, where `A`
+     * is the attribute with ID \p attr_id. */
+    bool may_satisfy(std::size_t block, std::size_t attr_id, cmp_op op, double value) const;
+
+M_LCOV_EXCL_START
+    void dump(std::ostream &out) const;
+    void dump() const;
+M_LCOV_EXCL_STOP
+};
+
+}
+
+}
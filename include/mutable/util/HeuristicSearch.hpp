@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <functional>
 #include <iosfwd>
@@ -602,6 +604,15 @@ struct SearchConfiguration
 
     /** Budget for the maximum number of expansions.  When the budget is exhausted, search stops. */
     OptField<StaticConfig::PerformAnytimeSearch, uint64_t> expansion_budget = std::numeric_limits<uint64_t>::max();
+
+    /** Wall-clock budget of the search, measured from the start of the search.  When the budget is exhausted, search
+     * stops.  Defaults to no budget. */
+    OptField<StaticConfig::PerformAnytimeSearch, std::chrono::steady_clock::duration> time_budget =
+        std::chrono::steady_clock::duration::max();
+
+    /** An optional flag to stop the search from the outside, e.g. by another search running concurrently.  Once the
+     * flag is set, search stops as if its budget was exhausted. */
+    OptField<StaticConfig::PerformAnytimeSearch, const std::atomic_bool*> stop = nullptr;
 };
 
 template<typename state_type, typename... Context>
@@ -922,16 +933,31 @@ const State & genericAStar<State, Expand, Heuristic, StaticConfig, Context...>::
         }
     }
 
-    /* Lambda function to assure that the budgeted number of expansions is met when using Anytime A*. */
-    auto have_budget = [budget=config.expansion_budget]() mutable -> bool {
+    /* Compute the point in time when the wall-clock budget is exhausted.  Avoid overflow for (almost) infinite
+     * budgets. */
+    using clock = std::chrono::steady_clock;
+    [[maybe_unused]] clock::time_point deadline = clock::time_point::max();
+    if constexpr (use_anytime_search) {
+        const clock::time_point now = clock::now();
+        const clock::duration time_budget = config.time_budget;
+        if (time_budget < clock::time_point::max() - now)
+            deadline = now + time_budget;
+    }
+
+    /* Lambda function to assure that the budgeted number of expansions and the wall-clock budget are met when using
+     * Anytime A*. */
+    auto have_budget = [budget=config.expansion_budget, deadline, &config]() mutable -> bool {
         if constexpr (use_anytime_search) {
-            if (budget) {
-                --budget;
-                return true;
-            } else {
+            if (not budget) {
                 /* Expansion budget exhausted. The search did not terminate with a goal state. */
                 throw budget_exhausted_exception("no goal state found with given expansion budget");
             }
+            --budget;
+            if (deadline != clock::time_point::max() and clock::now() >= deadline)
+                throw budget_exhausted_exception("no goal state found with given time budget");
+            if (const std::atomic_bool *stop = config.stop; stop and stop->load(std::memory_order_relaxed))
+                throw budget_exhausted_exception("search was stopped before reaching a goal state");
+            return true;
         } else {
             return true;
         }
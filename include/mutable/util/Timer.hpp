@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -94,6 +95,8 @@ struct Timer
 
     private:
     std::vector<Measurement> measurements_;
+    ///> serializes starting and stopping `Measurement`s, which happens concurrently if commands execute concurrently
+    static inline std::mutex mutex_;
 
     public:
     auto begin() const { return measurements_.cbegin(); }
@@ -121,6 +124,7 @@ struct Timer
     private:
     /** Start a new `Measurement` with the name `name`.  Returns the ID assigned to that `Measurement`. */
     std::size_t start(std::string name) {
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = std::find_if(measurements_.begin(), measurements_.end(),
                                [&](auto &elem) { return elem.name == name; });
 
@@ -141,6 +145,7 @@ struct Timer
 
     /** Stops the `Measurement` with the given ID. */
     void stop(std::size_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
         M_insist(id < measurements_.size(), "id out of bounds");
         auto &M = measurements_[id];
         M_insist(not M.has_ended(), "cannot stop that measurement because it has already been stopped");
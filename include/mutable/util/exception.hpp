@@ -60,4 +60,11 @@ struct backend_exception : exception
     explicit backend_exception(std::string message) : exception(std::move(message)) { }
 };
 
+/** Signals that the execution of a command was interrupted because it was cancelled or exceeded its timeout, see
+ * `CancellationToken`. */
+struct execution_cancelled : exception
+{
+    explicit execution_cancelled(std::string message) : exception(std::move(message)) { }
+};
+
 }
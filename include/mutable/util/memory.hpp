@@ -2,6 +2,7 @@
 
 #include <mutable/mutable-config.hpp>
 #include <mutable/util/fn.hpp>
+#include <atomic>
 #include <cstdint>
 #include <iostream>
 #include <memory>
@@ -13,21 +14,56 @@ namespace memory {
 
 struct Memory;
 
+/** The size of a huge page, in bytes. */
+constexpr std::size_t HUGE_PAGE_SIZE = 1UL << 21; ///< 2 MiB
+
+/** Describes how the memory of an `Allocator` is physically backed.  Huge pages reduce the number of TLB misses when
+ * accessing large amounts of memory, e.g. when scanning a large store.  Binding memory to a NUMA node avoids remote
+ * memory accesses on multi-socket machines. */
+struct M_EXPORT Backing
+{
+    enum huge_pages_t
+    {
+        HP_None,        ///< back memory with regular pages
+        HP_Transparent, ///< advise the kernel to back memory with transparent huge pages, see `madvise(MADV_HUGEPAGE)`
+        HP_Explicit,    ///< back memory with explicitly reserved huge pages, see `memfd_create(MFD_HUGETLB)`
+    };
+
+    huge_pages_t huge_pages = HP_None; ///< whether and how to use huge pages
+    int numa_node = -1; ///< the NUMA node to bind memory to, or -1 to use the memory policy of the process
+
+    /** Returns the granularity of allocations and mappings, in bytes. */
+    std::size_t granularity() const { return huge_pages == HP_Explicit ? HUGE_PAGE_SIZE : get_pagesize(); }
+};
+
 /** This is the common interface for all memory allocators that support *rewiring*.  */
 struct M_EXPORT Allocator
 {
     friend struct Memory;
 
     private:
+    uint64_t id_; ///< unique ID of this allocator; IDs are never reused, unlike file descriptors
     int fd_; ///< file descriptor of the underlying memory file
+    Backing backing_; ///< how the memory is physically backed
 
     public:
-    Allocator();
+    /** A function called with the ID of each `Allocator` that is destroyed, e.g. to release mappings of its memory
+     * elsewhere.  Must be reset to `nullptr` before the function becomes invalid. */
+    static inline std::atomic<void(*)(uint64_t)> on_destroy{nullptr};
+
+    explicit Allocator(Backing backing = Backing());
     virtual ~Allocator();
 
+    /** Returns the unique ID of this allocator. */
+    uint64_t id() const { return id_; }
     /** Return the file descriptor of the underlying memory file. */
     int fd() const { return fd_; }
 
+    /** Returns how the memory of this allocator is physically backed. */
+    const Backing & backing() const { return backing_; }
+    /** Returns the granularity of allocations and mappings of this allocator's memory, in bytes. */
+    std::size_t granularity() const { return backing_.granularity(); }
+
     /** Creates a new memory object with `size` bytes of freshly allocated memory. */
     virtual Memory allocate(std::size_t size) = 0;
 
@@ -37,10 +73,17 @@ struct M_EXPORT Allocator
 
     /** Helper method to inherit the friend ability to construct a `Memory` object. */
     Memory create_memory(void *addr, std::size_t size, std::size_t offset);
+
+    /** Helper method to inherit the friend ability to modify a `Memory` object. */
+    void update_memory(Memory &mem, void *addr, std::size_t size);
+
+    /** Applies the backing of this allocator to the mapping of `size` bytes at `addr` of the memory file. */
+    void apply_backing(void *addr, std::size_t size) const;
 };
 
 /** This class represents a reserved address space in virtual memory.  It can be used to map the contents of
- * `memory::Memory` instances into one contiguous virtual address range. */
+ * `memory::Memory` instances into one contiguous virtual address range.  The address space is aligned to
+ * `HUGE_PAGE_SIZE`, such that memory backed by huge pages can be mapped into it. */
 struct M_EXPORT AddressSpace
 {
     friend void swap(AddressSpace &first, AddressSpace &second) {
@@ -50,17 +93,19 @@ struct M_EXPORT AddressSpace
     }
 
     private:
-    void *addr_; ///< pointer to the beginning of the virtual address space
-    std::size_t size_; ///< size in bytes of the address space
+    void *addr_ = nullptr; ///< pointer to the beginning of the virtual address space
+    std::size_t size_ = 0; ///< size in bytes of the address space
 
     private:
-    AddressSpace() : addr_(nullptr), size_(0) { }
+    AddressSpace() { }
     public:
     AddressSpace(std::size_t size);
     ~AddressSpace();
     AddressSpace(const AddressSpace&) = delete;
     AddressSpace(AddressSpace &&other) : AddressSpace() { swap(*this, other); }
 
+    AddressSpace & operator=(AddressSpace &&other) { swap(*this, other); return *this; }
+
     /** Returns a pointer to the beginning of the virtual address space. */
     void * addr() const { return addr_; }
     /** Returns the size in bytes of the virtual address space. */
@@ -131,9 +176,10 @@ struct M_EXPORT Memory
 /** This is the simplest kind of allocator. The idea is to keep a pointer at the first memory address of your memory
  * chunk and move it every time an allocation is done. In this allocator, the internal fragmentation is kept to a
  * minimum because all elements are sequentially inserted and the only fragmentation between them is the alignment.
- * Note that allocations are always page aligned and whole multiples of an entire page.  There is no overhead to
- * allocation and existing allocations are never modified.  Deallocation can only reclaim memory if all chronologically
- * later allocations have been deallocated before.  If possible, deallocate memory in the inverse order of allocation.
+ * Note that allocations are always aligned to and whole multiples of the allocator's `granularity()`, i.e. of an entire
+ * page or huge page.  There is no overhead to allocation and existing allocations are never modified.  Deallocation
+ * can only reclaim memory if all chronologically later allocations have been deallocated before.  If possible,
+ * deallocate memory in the inverse order of allocation.
  */
 struct M_EXPORT LinearAllocator : Allocator
 {
@@ -143,12 +189,28 @@ struct M_EXPORT LinearAllocator : Allocator
     ///> stack of allocations; allocations can be marked deallocated for later reclaiming
     std::vector<std::size_t> allocations_;
 
+    /** A virtual address range that an allocation was mapped to before it grew. */
+    struct retired_mapping
+    {
+        std::size_t offset; ///< the offset of the allocation in the memory file
+        void *addr; ///< the start of the address range
+        std::size_t size; ///< the size of the address range
+    };
+    ///> address ranges of grown allocations that are kept mapped until the allocation is deallocated
+    std::vector<retired_mapping> retired_;
+
     public:
-    LinearAllocator() { }
-    ~LinearAllocator() { }
+    explicit LinearAllocator(Backing backing = Backing()) : Allocator(backing) { }
+    ~LinearAllocator();
 
     Memory allocate(std::size_t size) override;
 
+    /** Grows the allocation `mem` to `size` bytes.  `mem` must be the most recent allocation of this allocator.  The
+     * contents are not copied but mapped from the underlying memory file.  However, `mem` may be mapped to a different
+     * virtual address range.  The previous range stays mapped to the same contents until `mem` is deallocated, hence
+     * pointers into `mem` that concurrent readers still hold remain valid but do not cover the grown part. */
+    void grow(Memory &mem, std::size_t size);
+
     /** Returns the offset in the underlying memory file where the next allocation is placed. */
     std::size_t offset() const { return offset_; }
 
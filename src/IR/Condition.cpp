@@ -1,5 +1,7 @@
 #include <mutable/IR/Condition.hpp>
 
+#include <algorithm>
+
 
 using namespace m;
 
@@ -36,3 +38,108 @@ bool ConditionSet::operator==(const ConditionSet &other) const
     }
     return true;
 }
+
+std::vector<Schema::Identifier> Sortedness::equivalence_class(const Schema::Identifier &id) const
+{
+    std::vector<Schema::Identifier> cls{ id };
+    auto contains = [&cls](const Schema::Identifier &x) { return std::find(cls.cbegin(), cls.cend(), x) != cls.cend(); };
+    for (std::size_t i = 0; i != cls.size(); ++i) { // cls grows while iterating, hence index-based
+        for (auto &[first, second] : equivalences_) {
+            if (first == cls[i] and not contains(second))
+                cls.push_back(second);
+            else if (second == cls[i] and not contains(first))
+                cls.push_back(first);
+        }
+    }
+    return cls;
+}
+
+Sortedness::order_t::map_t::const_iterator Sortedness::find(const Schema::Identifier &id) const
+{
+    if (auto it = orders_.find(id); it != orders_.cend())
+        return it;
+    const auto cls = equivalence_class(id);
+    return std::find_if(orders_.cbegin(), orders_.cend(), [&cls](const auto &e) {
+        return std::find(cls.cbegin(), cls.cend(), e.first) != cls.cend();
+    });
+}
+
+std::vector<std::size_t> Sortedness::positions() const
+{
+    std::vector<std::size_t> positions;
+    std::size_t next = 0;
+    for (auto it = orders_.cbegin(); it != orders_.cend(); ++it) {
+        const auto cls = equivalence_class(it->first);
+        auto prev = std::find_if(orders_.cbegin(), it, [&cls](const auto &e) {
+            return std::find(cls.cbegin(), cls.cend(), e.first) != cls.cend();
+        });
+        positions.push_back(prev == it ? next++ : positions[std::distance(orders_.cbegin(), prev)]);
+    }
+    return positions;
+}
+
+void Sortedness::project_and_rename(const std::vector<std::pair<Schema::Identifier, Schema::Identifier>> &old2new)
+{
+    auto renames = [&old2new](const Schema::Identifier &old_id) {
+        std::vector<Schema::Identifier> new_ids;
+        for (auto &[o, n] : old2new) {
+            if (o == old_id)
+                new_ids.push_back(n);
+        }
+        return new_ids;
+    };
+
+    /*----- Rename the equivalences.  An attribute renamed multiple times yields equivalent attributes. -----*/
+    equivalences_t equivalences;
+    for (auto &[first, second] : equivalences_) {
+        for (auto &new_first : renames(first)) {
+            for (auto &new_second : renames(second))
+                equivalences.emplace_back(new_first, new_second);
+        }
+    }
+    for (auto &[old_id, new_id] : old2new) {
+        const auto new_ids = renames(old_id);
+        if (new_ids.front() != new_id)
+            equivalences.emplace_back(new_ids.front(), new_id);
+    }
+
+    /*----- Rename the sort order position by position, retaining the order of positions. -----*/
+    const auto old_positions = positions();
+    std::vector<bool> handled(orders_.end() - orders_.begin(), false);
+    order_t orders;
+    for (auto it = orders_.cbegin(); it != orders_.cend(); ++it) {
+        const auto pos = old_positions[std::distance(orders_.cbegin(), it)];
+        if (handled[pos])
+            continue;
+        handled[pos] = true;
+
+        /*----- Determine the order of this position, i.e. the first defined order of its entries. -----*/
+        Order order = O_UNDEF;
+        for (auto other = it; other != orders_.cend(); ++other) {
+            if (old_positions[std::distance(orders_.cbegin(), other)] == pos and other->second != O_UNDEF) {
+                order = other->second;
+                break;
+            }
+        }
+
+        /*----- Collect the new identifiers of all attributes equivalent to this position. -----*/
+        std::vector<Schema::Identifier> new_ids;
+        for (auto &id : equivalence_class(it->first)) {
+            for (auto &new_id : renames(id)) {
+                if (std::find(new_ids.cbegin(), new_ids.cend(), new_id) == new_ids.cend())
+                    new_ids.push_back(new_id);
+            }
+        }
+
+        if (new_ids.empty()) {
+            if (order == O_UNDEF)
+                continue; // attributes with undefined order do not constrain subsequent positions
+            break; // the data is not sorted by any subsequent position without this one
+        }
+        for (auto &new_id : new_ids)
+            orders.add(new_id, order);
+    }
+
+    orders_ = std::move(orders);
+    equivalences_ = std::move(equivalences);
+}
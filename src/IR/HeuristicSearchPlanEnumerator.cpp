@@ -1,12 +1,17 @@
 #include <mutable/IR/HeuristicSearchPlanEnumerator.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <exception>
 #include <execution>
 #include <functional>
 #include <memory>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/util/fn.hpp>
+#include <mutex>
+#include <thread>
 
 
 using namespace m;
@@ -37,6 +42,10 @@ float weighting_factor = 1.f;
 bool initialize_upper_bound = false;
 /** The expansion budget for Anytime A*. */
 uint64_t expansion_budget = std::numeric_limits<uint64_t>::max();
+/** The wall-clock budget for Anytime A* in milliseconds. */
+uint64_t time_budget = std::numeric_limits<uint64_t>::max();
+/** The number of weighted Anytime A* searches to run concurrently. */
+unsigned num_threads = 1;
 
 }
 
@@ -158,10 +167,10 @@ double goo_path_completion(const State &state, PlanTable &PT, const QueryGraph &
 namespace m::pe::hs {
 namespace search_states {
 
-SubproblemsArray::allocator_type SubproblemsArray::allocator_;
-SubproblemTableBottomUp::allocator_type SubproblemTableBottomUp::allocator_;
-EdgesBottomUp::allocator_type EdgesBottomUp::allocator_;
-EdgePtrBottomUp::Scratchpad EdgePtrBottomUp::scratchpad_;
+thread_local SubproblemsArray::allocator_type SubproblemsArray::allocator_;
+thread_local SubproblemTableBottomUp::allocator_type SubproblemTableBottomUp::allocator_;
+thread_local EdgesBottomUp::allocator_type EdgesBottomUp::allocator_;
+thread_local EdgePtrBottomUp::Scratchpad EdgePtrBottomUp::scratchpad_;
 
 }
 }
@@ -359,6 +368,116 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
 
 namespace {
 
+/** Runs a portfolio of `num_threads` weighted Anytime A* searches concurrently.  Search *i* weighs the heuristic by
+ * `config.weighting_factor * (i + 1)`.  Hence, search 0 runs with the configured weighting factor while the other,
+ * greedier searches quickly find plans of bounded suboptimality.  Vertex expansion writes to the `PlanTable`, so every
+ * search works on a private copy of the base case of `PT`.  All searches share the wall-clock budget and are stopped as
+ * soon as search 0 finished.  The cheapest plan found by any search is then written to `PT`. */
+template<
+    typename PlanTable,
+    typename State,
+    typename Expand,
+    typename SearchAlgorithm,
+    template<typename, typename, typename> typename Heuristic,
+    ai::SearchConfigConcept StaticConfig
+>
+void parallel_heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix &M, const CostFunction &CF,
+                               const CardinalityEstimator &CE, const ai::SearchConfiguration<StaticConfig> &config,
+                               unsigned num_threads)
+{
+    static_assert(StaticConfig::PerformAnytimeSearch and StaticConfig::PerformWeightedSearch,
+                  "parallel search requires weighted Anytime A*");
+    M_insist(num_threads > 1);
+    using plan_table_type = std::remove_cvref_t<PlanTable>;
+    const Subproblem All = Subproblem::All(G.num_sources());
+
+    /*----- Initialize the private plan tables with the base case of `PT`. -----*/
+    std::vector<plan_table_type> plan_tables;
+    plan_tables.reserve(num_threads);
+    for (unsigned id = 0; id != num_threads; ++id) {
+        auto &local = plan_tables.emplace_back(G);
+        for (auto &ds : G.sources()) {
+            const Subproblem s = Subproblem::Singleton(ds->id());
+            local[s].cost = PT[s].cost;
+            local[s].model = PT[s].model->clone();
+        }
+    }
+
+    std::atomic_bool stop(false);
+    std::mutex mutex; // protects the best plan and the error
+    double best_cost = std::numeric_limits<double>::infinity();
+    binary_plan_type best_plan;
+    std::exception_ptr error;
+
+    auto run = [&](unsigned id) {
+        plan_table_type &local = plan_tables[id];
+        try {
+            ai::SearchConfiguration<StaticConfig> local_config;
+            if constexpr (StaticConfig::PerformCostBasedPruning) {
+                local_config.initial_plan = config.initial_plan;
+                local_config.upper_bound = config.upper_bound;
+            }
+            local_config.weighting_factor = float(config.weighting_factor) * (id + 1);
+            local_config.expansion_budget = config.expansion_budget;
+            local_config.time_budget = config.time_budget;
+            local_config.stop = &stop;
+
+            SearchAlgorithm S(local, G, M, CF, CE);
+            m::pe::hs::heuristic_search<
+                PlanTable,
+                State,
+                Expand,
+                SearchAlgorithm,
+                Heuristic,
+                StaticConfig
+            >(local, G, M, CF, CE, S, local_config);
+            if (id == 0)
+                stop = true; // the search with the configured weighting factor is done, stop all other searches
+
+            /*----- Extract the found plan in post-order. -----*/
+            binary_plan_type plan;
+            plan.reserve(G.num_sources() - 1);
+            auto extract = [&local, &plan](auto &extract, Subproblem S) -> void {
+                if (S.is_singleton()) return;
+                const Subproblem left = local[S].left;
+                const Subproblem right = local[S].right;
+                extract(extract, left);
+                extract(extract, right);
+                plan.emplace_back(left, right);
+            };
+            extract(extract, All);
+
+            std::lock_guard lock(mutex);
+            if (local[All].cost < best_cost) {
+                best_cost = local[All].cost;
+                best_plan = std::move(plan);
+            }
+        } catch (...) {
+            stop = true;
+            std::lock_guard lock(mutex);
+            if (not error)
+                error = std::current_exception();
+        }
+    };
+
+    /*----- Run search 0 on the calling thread and all other searches on worker threads. -----*/
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (unsigned id = 1; id != num_threads; ++id)
+        threads.emplace_back(run, id);
+    run(0);
+    for (auto &t : threads)
+        t.join();
+    if (error)
+        std::rethrow_exception(error);
+
+    if (Options::Get().statistics)
+        std::cout << "cheapest plan of " << num_threads << " concurrent searches has cost " << best_cost << std::endl;
+
+    /*----- Write the cheapest plan found to `PT`. -----*/
+    reconstruct_saved_plan(best_plan, PT, G, CE, CF);
+}
+
 template<
     typename PlanTable,
     typename State,
@@ -406,9 +525,15 @@ bool heuristic_search_helper(const char *vertex_str, const char *expand_str, con
 
         if constexpr (StaticConfig::PerformAnytimeSearch) {
             config.expansion_budget = options::expansion_budget;
-        } else if (options::expansion_budget != std::numeric_limits<uint64_t>::max()) {
-            std::cerr << "WARNING: option --hs-budget has no effect for the chosen search configuration"
-                      << std::endl;
+            if (options::time_budget != std::numeric_limits<uint64_t>::max())
+                config.time_budget = std::chrono::milliseconds(options::time_budget);
+        } else {
+            if (options::expansion_budget != std::numeric_limits<uint64_t>::max())
+                std::cerr << "WARNING: option --hs-budget has no effect for the chosen search configuration"
+                          << std::endl;
+            if (options::time_budget != std::numeric_limits<uint64_t>::max())
+                std::cerr << "WARNING: option --hs-time-budget has no effect for the chosen search configuration"
+                          << std::endl;
         }
 
         using H = Heuristic<PlanTable, State, Expand>;
@@ -423,6 +548,23 @@ bool heuristic_search_helper(const char *vertex_str, const char *expand_str, con
             const CardinalityEstimator&
         >;
 
+        if constexpr (StaticConfig::PerformAnytimeSearch and StaticConfig::PerformWeightedSearch) {
+            if (options::num_threads > 1) {
+                parallel_heuristic_search<
+                    PlanTable,
+                    State,
+                    Expand,
+                    SearchAlgorithm,
+                    Heuristic,
+                    StaticConfig
+                >(PT, G, M, CF, CE, config, options::num_threads);
+                return true;
+            }
+        } else if (options::num_threads > 1) {
+            std::cerr << "WARNING: option --hs-threads has no effect for the chosen search configuration"
+                      << std::endl;
+        }
+
         SearchAlgorithm S(PT, G, M, CF, CE);
 
         return m::pe::hs::heuristic_search<
@@ -579,6 +721,7 @@ matched_heuristic_search:;
 // explicit template instantiation
 template void HeuristicSearch::operator()(enumerate_tag, PlanTableSmallOrDense &PT, const QueryGraph &G, const CostFunction &CF) const;
 template void HeuristicSearch::operator()(enumerate_tag, PlanTableLargeAndSparse &PT, const QueryGraph &G, const CostFunction &CF) const;
+template void HeuristicSearch::operator()(enumerate_tag, PlanTableCompact &PT, const QueryGraph &G, const CostFunction &CF) const;
 
 }
 
@@ -646,6 +789,24 @@ void register_heuristic_search_plan_enumerator()
         /* description= */ "the expansion budget to use for Anytime A*",
         [] (uint64_t n) { options::expansion_budget = n; }
     );
+    C.arg_parser().add<uint64_t>(
+        /* group=       */ "HeuristicSearch",
+        /* short=       */ nullptr,
+        /* long=        */ "--hs-time-budget",
+        /* description= */ "the wall-clock budget in milliseconds to use for Anytime A*; when exhausted, the best "
+                           "partial plan found so far is completed greedily",
+        [] (uint64_t ms) { options::time_budget = ms; }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "HeuristicSearch",
+        /* short=       */ nullptr,
+        /* long=        */ "--hs-threads",
+        /* description= */ "the number of weighted Anytime A* searches with increasing weighting factors to run "
+                           "concurrently (0 to use all hardware threads)",
+        [] (unsigned n) {
+            options::num_threads = n ? n : std::max(1U, std::thread::hardware_concurrency());
+        }
+    );
 }
 
 }
@@ -163,9 +163,12 @@ std::pair<std::unique_ptr<Producer>, PlanTableEntry> Optimizer::optimize(QueryGr
             if (G.num_sources() <= 15) {
                 auto [plan, PT] = optimize_with_plantable<PlanTableSmallOrDense>(G);
                 return { std::move(plan), std::move(PT.get_final()) };
-            } else {
+            } else if (G.num_sources() <= 30) {
                 auto [plan, PT] = optimize_with_plantable<PlanTableLargeAndSparse>(G);
                 return { std::move(plan), std::move(PT.get_final()) };
+            } else {
+                auto [plan, PT] = optimize_with_plantable<PlanTableCompact>(G);
+                return { std::move(plan), std::move(PT.get_final()) };
             }
         }
 
@@ -178,6 +181,11 @@ std::pair<std::unique_ptr<Producer>, PlanTableEntry> Optimizer::optimize(QueryGr
             auto [plan, PT] = optimize_with_plantable<PlanTableLargeAndSparse>(G);
             return { std::move(plan), std::move(PT.get_final()) };
         }
+
+        case Options::PT_Compact: {
+            auto [plan, PT] = optimize_with_plantable<PlanTableCompact>(G);
+            return { std::move(plan), std::move(PT.get_final()) };
+        }
     }
 }
 
@@ -316,6 +324,8 @@ void Optimizer::optimize_join_order(const QueryGraph &G, PlanTable &PT) const
                   << "\nEst. result set size: " << CE.predict_cardinality(*PT.get_final().model)
                   << "\nPlan cost: " << PT[PT.get_final().left].cost + PT[PT.get_final().right].cost
                   << std::endl;
+        if constexpr (std::is_same_v<PlanTable, PlanTableCompact>)
+            std::cout << "Plan table: " << PT.memory_usage() << std::endl;
     }
 }
 
@@ -509,4 +519,5 @@ std::unique_ptr<Producer> \
 Optimizer::construct_join_order(const QueryGraph&, const PLANTABLE&, const std::unique_ptr<Producer*[]>&) const
 DEFINE(PlanTableSmallOrDense);
 DEFINE(PlanTableLargeAndSparse);
+DEFINE(PlanTableCompact);
 #undef DEFINE
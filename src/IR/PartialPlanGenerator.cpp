@@ -152,5 +152,7 @@ void PartialPlanGenerator::write_partial_plans_JSON(std::ostream &out, const Que
 /*----- Explicit tempalte instantiations. ----------------------------------------------------------------------------*/
 template void PartialPlanGenerator::for_each_complete_partial_plan(const PlanTableSmallOrDense&, callback_type);
 template void PartialPlanGenerator::for_each_complete_partial_plan(const PlanTableLargeAndSparse&, callback_type);
+template void PartialPlanGenerator::for_each_complete_partial_plan(const PlanTableCompact&, callback_type);
 template void PartialPlanGenerator::write_partial_plans_JSON(std::ostream&, const QueryGraph&, const PlanTableSmallOrDense&, std::function<void(callback_type)>);
 template void PartialPlanGenerator::write_partial_plans_JSON(std::ostream&, const QueryGraph&, const PlanTableLargeAndSparse&, std::function<void(callback_type)>);
+template void PartialPlanGenerator::write_partial_plans_JSON(std::ostream&, const QueryGraph&, const PlanTableCompact&, std::function<void(callback_type)>);
@@ -739,7 +739,8 @@ void TDGOO::operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const
 
 #define INSTANTIATE(NAME, _) \
     template void NAME::operator()(enumerate_tag, PlanTableSmallOrDense &PT, const QueryGraph &G, const CostFunction &CF) const; \
-    template void NAME::operator()(enumerate_tag, PlanTableLargeAndSparse &PT, const QueryGraph &G, const CostFunction &CF) const;
+    template void NAME::operator()(enumerate_tag, PlanTableLargeAndSparse &PT, const QueryGraph &G, const CostFunction &CF) const; \
+    template void NAME::operator()(enumerate_tag, PlanTableCompact &PT, const QueryGraph &G, const CostFunction &CF) const;
 LIST_PE(INSTANTIATE)
 #undef INSTANTIATE
 
@@ -5,6 +5,7 @@
 #include <iomanip>
 #include <ios>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/CNF.hpp>
 #include <vector>
 
 
@@ -145,3 +146,162 @@ std::ostream & m::operator<<(std::ostream &out, const PlanTableLargeAndSparse &P
 void PlanTableLargeAndSparse::dump(std::ostream &out) const { out << *this; out.flush(); }
 void PlanTableLargeAndSparse::dump() const { dump(std::cerr); }
 M_LCOV_EXCL_STOP
+
+
+/*----------------------------------------------------------------------------------------------------------------------
+ * PlanTableCompact
+ *--------------------------------------------------------------------------------------------------------------------*/
+
+PlanTableCompact::~PlanTableCompact()
+{
+    for (uint32_t idx = 0; idx != keys_.size(); ++idx)
+        entry(idx).~PlanTableEntry();
+    for (auto &chunk : chunks_)
+        allocator_.dispose(std::move(chunk), CHUNK_SIZE);
+}
+
+uint32_t PlanTableCompact::insert(Subproblem s)
+{
+    M_insist(find(s) == EMPTY_SLOT, "subproblem already has an entry");
+    M_insist(keys_.size() < EMPTY_SLOT, "too many entries");
+
+    /*----- Grow the index to keep its load factor below 1/2. --------------------------------------------------------*/
+    if (2 * (keys_.size() + 1) > index_.size()) {
+        index_.assign(std::max<size_type>(2 * index_.size(), 16), EMPTY_SLOT);
+        const size_type mask = index_.size() - 1;
+        for (uint32_t idx = 0; idx != keys_.size(); ++idx) {
+            size_type slot = SubproblemHash{}(keys_[idx]) & mask;
+            while (index_[slot] != EMPTY_SLOT)
+                slot = (slot + 1) & mask;
+            index_[slot] = idx;
+        }
+    }
+
+    /*----- Allocate the entry. --------------------------------------------------------------------------------------*/
+    const uint32_t idx = keys_.size();
+    if (idx % CHUNK_SIZE == 0)
+        chunks_.emplace_back(allocator_.template make_unique<PlanTableEntry[]>(CHUNK_SIZE));
+    new (&entry(idx)) PlanTableEntry();
+    keys_.push_back(s);
+    model_splits_.emplace_back();
+
+    /*----- Add the entry to the index. ------------------------------------------------------------------------------*/
+    const size_type mask = index_.size() - 1;
+    size_type slot = SubproblemHash{}(s) & mask;
+    while (index_[slot] != EMPTY_SLOT)
+        slot = (slot + 1) & mask;
+    index_[slot] = idx;
+
+    return idx;
+}
+
+PlanTableEntry & PlanTableCompact::materialize(uint32_t idx) const
+{
+    auto &e = chunks_[idx / CHUNK_SIZE][idx % CHUNK_SIZE]; // the model is a cache, which may be materialized if `const`
+    const auto [left, right] = model_splits_[idx];
+    if (e.model or left.empty() or not G_)
+        return e; // nothing evicted
+
+    /* Materialize the models of the split that computed the evicted model, recursively, and estimate their join with
+     * the same condition.  This never evicts, hence references to entries and their models remain valid. */
+    M_insist(CE_, "models are only evicted by `update()`, which sets the cardinality estimator");
+    auto &entry_left = at(left);
+    auto &entry_right = at(right);
+    M_insist(bool(entry_left.model), "must have a model for the left side");
+    M_insist(bool(entry_right.model), "must have a model for the right side");
+    static const cnf::CNF empty_condition;
+    auto it = model_conditions_.find(idx);
+    e.model = CE_->estimate_join(*G_, *entry_left.model, *entry_right.model,
+                                 it == model_conditions_.end() ? empty_condition : it->second);
+
+    materialized_.push_back(idx);
+    ++num_models_;
+    ++num_materializations_;
+    return e;
+}
+
+void PlanTableCompact::evict(Subproblem left, Subproblem right)
+{
+    /* Visit each queued entry at most once, s.t. we terminate even if only spared entries remain. */
+    for (size_type n = materialized_.size(); num_models_ > max_models_ and n; --n) {
+        const uint32_t idx = materialized_.front();
+        materialized_.pop_front();
+        auto &e = entry(idx);
+        if (not e.model)
+            continue; // already evicted
+        const Subproblem S = keys_[idx];
+        if (S == left or S == right or S == (left | right)) {
+            materialized_.push_back(idx); // spare
+            continue;
+        }
+        e.model.reset();
+        --num_models_;
+        ++num_evictions_;
+    }
+}
+
+M_LCOV_EXCL_START
+std::ostream & m::operator<<(std::ostream &out, const PlanTableCompact &PT)
+{
+    using std::setw;
+
+    auto &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+    auto &CE = DB.cardinality_estimator();
+
+    std::size_t num_sources = PT.num_sources();
+    uint64_t n = 1UL << num_sources;
+
+    /* Compute max length of columns. */
+    auto &entry = PT.get_final();
+    const uint64_t size_len = std::max<uint64_t>(
+        entry.model ? std::ceil(std::log10(CE.predict_cardinality(*entry.model))) : 0,
+        4
+    );
+    const uint64_t cost_len = std::max<uint64_t>(std::ceil(std::log10(entry.cost)), 4);
+    const uint64_t sub_len  = std::max<uint64_t>(num_sources, 5);
+
+    out << std::left << "Plan Table:\n"
+        << std::setw(num_sources) << "Sub"    << "  "
+        << std::setw(size_len)    << "Size"   << "  "
+        << std::setw(cost_len)    << "Cost"   << "  "
+        << std::setw(sub_len)     << "Left"   << "  "
+        << std::setw(sub_len)     << "Right"  << '\n' << std::right;
+
+    std::vector<Subproblem> sorted_keys;
+    sorted_keys.reserve(PT.size());
+    for (auto s : PT.keys_) {
+        if (uint64_t(s) > n)
+            continue; // skip additional entries
+        sorted_keys.push_back(s);
+    }
+    std::sort(sorted_keys.begin(), sorted_keys.end(), [](Subproblem lhs, Subproblem rhs) {
+        return uint64_t(lhs) < uint64_t(rhs);
+    });
+
+    for (auto sub : sorted_keys) {
+        sub.print_fixed_length(out, num_sources);
+        out << "  ";
+        if (PT.has_plan(sub)) {
+            auto &e = PT.at(sub); // materializes evicted models
+            if (e.model)
+                out << std::setw(size_len) << CE.predict_cardinality(*e.model);
+            else
+                out << std::setw(size_len) << '-';
+            out << "  "
+                << std::setw(cost_len) << e.cost << "  "
+                << std::setw(sub_len) << uint64_t(e.left) << "  "
+                << std::setw(sub_len) << uint64_t(e.right) << '\n';
+        } else {
+            out << std::setw(size_len) << '-' << "  "
+                << std::setw(cost_len) << '-' << "  "
+                << std::setw(sub_len)  << '-' << "  "
+                << std::setw(sub_len)  << '-' << '\n';
+        }
+    }
+    return out << PT.memory_usage() << '\n';
+}
+
+void PlanTableCompact::dump(std::ostream &out) const { out << *this; out.flush(); }
+void PlanTableCompact::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
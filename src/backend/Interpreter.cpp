@@ -5,11 +5,14 @@
 #include <cerrno>
 #include <cstdlib>
 #include <iterator>
+#include <mutable/catalog/AdaptiveCostFunction.hpp>
+#include <mutable/catalog/CardinalityEstimator.hpp>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/util/fn.hpp>
 #include <numeric>
+#include <optional>
 #include <type_traits>
 
 
@@ -122,14 +125,16 @@ static StackMachine compile_data_layout(const Schema &tuple_schema, void *addres
                             const uint64_t additional_offset_in_bits = child.offset_in_bits + row_id * child.stride_in_bits;
                             const std::size_t byte_offset = additional_offset_in_bits / 8;
                             const std::size_t bit_offset = additional_offset_in_bits % 8;
-                            M_insist(not bit_offset or child_leaf->type()->is_boolean() or child_leaf->type()->is_bitmap(),
+                            M_insist(not bit_offset or child_leaf->stored_type()->is_boolean() or
+                                     child_leaf->stored_type()->is_bitmap(),
                                      "only booleans and bitmaps may not be byte aligned");
 
                             const std::size_t byte_stride = child.stride_in_bits / 8;
                             const std::size_t bit_stride  = child.stride_in_bits % 8;
-                            M_insist(not bit_stride or child_leaf->type()->is_boolean() or child_leaf->type()->is_bitmap(),
+                            M_insist(not bit_stride or child_leaf->stored_type()->is_boolean() or
+                                     child_leaf->stored_type()->is_bitmap(),
                                      "only booleans and bitmaps may not be byte aligned");
-                            M_insist(bit_stride == 0 or byte_stride == 0,
+                            M_insist(bit_stride == 0 or byte_stride == 0 or child_leaf->is_bit_packed(),
                                      "the stride must be a whole multiple of a byte or less than a byte");
 
                             /* Access NULL bit. */
@@ -233,7 +238,53 @@ static StackMachine compile_data_layout(const Schema &tuple_schema, void *addres
                             const std::size_t offset_id = SM.add_and_emit_load(reinterpret_cast<void*>(offset + byte_offset));
                             leaf2id[child_leaf->index()] = offset_id;
 
-                            if (bit_stride) {
+                            if (child_leaf->is_bit_packed()) {
+                                /* Introduce bit offset of the value within the byte pointed to by the leaf pointer. */
+                                const std::size_t bit_offset_id = SM.add(uint64_t(bit_offset));
+                                leaf2mask[child_leaf->index()] = bit_offset_id;
+                                const uint64_t width = child_leaf->stored_type()->size();
+
+                                if constexpr (IsStore) {
+                                    /* Store difference to reference value. */
+                                    SM.emit_Ld_Ctx(bit_offset_id);
+                                    SM.emit_Ld_Tup(tuple_id, idx);
+                                    SM.add_and_emit_load(child_leaf->reference());
+                                    SM.emit_Sub_i();
+                                    SM.emit_St_Bits(width);
+                                } else {
+                                    /* Load difference and add reference value. */
+                                    SM.emit_Ld_Ctx(bit_offset_id);
+                                    SM.emit_Ld_Bits(width);
+                                    SM.add_and_emit_load(child_leaf->reference());
+                                    SM.emit_Add_i();
+
+                                    if (attr_can_be_null)
+                                        SM.emit_Sel();
+
+                                    /* Store value in output tuple. */
+                                    SM.emit_St_Tup(tuple_id, idx, child_leaf->type());
+                                    SM.emit_Pop();
+                                }
+
+                                if (child.stride_in_bits) {
+                                    /* Advance the bit offset by the attribute's stride and carry whole bytes over to
+                                     * the attribute pointer. */
+                                    SM.emit_Ld_Ctx(bit_offset_id);
+                                    SM.add_and_emit_load(int64_t(child.stride_in_bits));
+                                    SM.emit_Add_i();
+                                    SM.emit_Upd_Ctx(bit_offset_id);
+                                    SM.emit_SARi_i(3); // bit offset / 8
+                                    SM.emit_Ld_Ctx(offset_id);
+                                    SM.emit_Add_p();
+                                    SM.emit_Upd_Ctx(offset_id);
+                                    SM.emit_Pop();
+                                    SM.emit_Ld_Ctx(bit_offset_id);
+                                    SM.add_and_emit_load(int64_t(0b111));
+                                    SM.emit_And_i(); // bit offset % 8
+                                    SM.emit_Upd_Ctx(bit_offset_id);
+                                    SM.emit_Pop();
+                                }
+                            } else if (bit_stride) {
                                 M_insist(child_leaf->type()->is_boolean(), "only booleans are supported yet");
 
                                 if constexpr (IsStore) {
@@ -307,16 +358,35 @@ static StackMachine compile_data_layout(const Schema &tuple_schema, void *addres
                                     SM.emit_Ld_Tup(tuple_id, idx);
 
                                     /* Store value. */
-                                    if (child_leaf->type()->is_boolean())
+                                    if (child_leaf->type()->is_boolean()) {
                                         SM.emit_St_b(bit_offset);
-                                    else
+                                    } else if (child_leaf->is_dictionary_encoded()) {
+                                        SM.emit_St_Dict(SM.add(&child_leaf->dictionary())); // encode and store code
+                                    } else if (child_leaf->is_frame_of_reference_encoded()) {
+                                        /* Store difference to reference value. */
+                                        SM.add_and_emit_load(child_leaf->reference());
+                                        SM.emit_Sub_i();
+                                        SM.emit_St(child_leaf->stored_type());
+                                    } else {
                                         SM.emit_St(child_leaf->type());
+                                    }
                                 } else {
                                     /* Load value. */
-                                    if (child_leaf->type()->is_boolean())
+                                    if (child_leaf->type()->is_boolean()) {
                                         SM.emit_Ld_b(0x1UL << bit_offset); // convert the fixed bit offset to a fixed mask
-                                    else
-                                        SM.emit_Ld(child_leaf->type());
+                                    } else {
+                                        if (child_leaf->is_dictionary_encoded()) {
+                                            SM.emit_Ld_Dict(SM.add(&child_leaf->dictionary())); // decode to entry
+                                            SM.emit_Ld(child_leaf->type());
+                                        } else if (child_leaf->is_frame_of_reference_encoded()) {
+                                            /* Load difference and add reference value. */
+                                            SM.emit_Ld(child_leaf->stored_type());
+                                            SM.add_and_emit_load(child_leaf->reference());
+                                            SM.emit_Add_i();
+                                        } else {
+                                            SM.emit_Ld(child_leaf->type());
+                                        }
+                                    }
 
                                     if (attr_can_be_null)
                                         SM.emit_Sel();
@@ -433,15 +503,16 @@ static StackMachine compile_data_layout(const Schema &tuple_schema, void *addres
                             const std::size_t bit_stride = stride_remaining_in_bits % 8;
 
                             if (bit_stride) {
-                                M_insist(child_leaf->index() == null_bitmap_idx or child_leaf->type()->is_boolean(),
-                                       "only the null bitmap or booleans may cause not byte aligned stride jumps, "
-                                       "bitmaps are not supported yet");
+                                M_insist(child_leaf->index() == null_bitmap_idx or child_leaf->type()->is_boolean() or
+                                         child_leaf->is_bit_packed(),
+                                       "only the null bitmap, booleans, or bit-packed values may cause not byte "
+                                       "aligned stride jumps, bitmaps are not supported yet");
                                 M_insist(child_leaf->index() != null_bitmap_idx or null_bitmap_info.adjustable_offset(),
                                        "only null bitmaps with adjustable offset may cause not byte aligned stride jumps");
                                 M_insist(mask_id != -1UL);
 
                                 /* Reset mask. */
-                                if (child_leaf->index() == null_bitmap_idx) {
+                                if (child_leaf->index() == null_bitmap_idx or child_leaf->is_bit_packed()) {
                                     /* Reset adjustable bit offset to 0. */
                                     if (info.num_tuples != 1) {
                                         /* Check whether counter equals num_tuples. */
@@ -608,6 +679,9 @@ struct JoinData : OperatorData
     Pipeline pipeline;
     std::vector<StackMachine> load_attrs;
 
+    std::size_t num_children_executed = 0; ///< number of children executed, the join stops early on empty input
+    std::size_t num_tuples_out = 0; ///< number of produced join results
+
     JoinData(const JoinOperator &op) : pipeline(op.schema()) { }
 
     void emit_load_attrs(const Schema &in_schema) {
@@ -654,6 +728,10 @@ struct SimpleHashJoinData : JoinData
     Schema key_schema; ///< the `Schema` of the `key`
     Tuple key; ///< `Tuple` to hold the key
 
+    std::size_t num_tuples_build = 0; ///< number of tuples inserted into the hash table
+    std::size_t num_tuples_probe = 0; ///< number of tuples probed against the hash table
+    Timer::duration time = Timer::duration::zero(); ///< time spent in this join, excluding its ancestors
+
     SimpleHashJoinData(const JoinOperator &op)
         : JoinData(op)
         , ht(1024)
@@ -842,6 +920,10 @@ struct HashBasedGroupingData : GroupingData
      * of tuples that belong to this group. */
     std::unordered_map<Tuple, unsigned, hasher, equals> groups;
 
+    std::size_t num_tuples_in = 0; ///< number of tuples consumed
+    std::size_t num_groups = 0; ///< number of groups formed
+    Timer::duration time = Timer::duration::zero(); ///< time spent to build the groups
+
     HashBasedGroupingData(const GroupingOperator &op)
         : GroupingData(op)
         , groups(1024, hasher(op.group_by().size()), equals(op.group_by().size()))
@@ -861,6 +943,10 @@ struct FilterData : OperatorData
     StackMachine filter;
     Tuple res;
 
+    std::size_t num_tuples_in = 0; ///< number of tuples consumed
+    std::size_t num_tuples_out = 0; ///< number of tuples that satisfied the filter
+    Timer::duration time = Timer::duration::zero(); ///< time spent to evaluate the filter, excluding its ancestors
+
     FilterData(const FilterOperator &op, const Schema &pipeline_schema)
         : filter(pipeline_schema)
         , res({ Type::Get_Boolean(Type::TY_Vector) })
@@ -875,6 +961,8 @@ struct DisjunctiveFilterData : OperatorData
     std::vector<StackMachine> predicates;
     Tuple res;
 
+    std::size_t num_tuples_out = 0; ///< number of tuples that satisfied the filter
+
     DisjunctiveFilterData(const DisjunctiveFilterOperator &op, const Schema &pipeline_schema)
         : res({ Type::Get_Boolean(Type::TY_Vector) })
     {
@@ -898,6 +986,8 @@ struct DisjunctiveFilterData : OperatorData
 
 void Pipeline::operator()(const ScanOperator &op)
 {
+    /* The writer may concurrently grow the store.  Latch the memory of stores for the duration of this pipeline. */
+    Store::shared_memory_latch memory_latch;
     auto &store = op.store();
     auto &table = store.table();
     const auto num_rows = store.num_rows();
@@ -915,6 +1005,7 @@ void Pipeline::operator()(const ScanOperator &op)
             Tuple *args[] = { &block_[j] };
             loader(args);
         }
+        CancellationToken::Check(); // interrupt the scan between two blocks
         op.parent()->accept(*this);
     }
     if (i != num_rows) {
@@ -958,11 +1049,15 @@ void Pipeline::operator()(const FilterOperator &op)
         op.data(new FilterData(op, this->schema()));
 
     auto data = as<FilterData>(op.data());
+    const auto begin = Timer::clock::now();
+    data->num_tuples_in += block_.size();
     for (auto it = block_.begin(); it != block_.end(); ++it) {
         Tuple *args[] = { &data->res, &*it };
         data->filter(args);
         if (data->res.is_null(0) or not data->res[0].as_b()) block_.erase(it);
     }
+    data->num_tuples_out += block_.size();
+    data->time += Timer::clock::now() - begin;
     if (not block_.empty())
         op.parent()->accept(*this);
 }
@@ -985,6 +1080,7 @@ void Pipeline::operator()(const DisjunctiveFilterOperator &op)
         block_.erase(it); // no predicate was satisfied ⇒ drop tuple
 satisfied:;
     }
+    data->num_tuples_out += block_.size();
     if (not block_.empty())
         op.parent()->accept(*this);
 }
@@ -995,6 +1091,7 @@ void Pipeline::operator()(const JoinOperator &op)
         /* Perform simple hash join. */
         auto data = as<SimpleHashJoinData>(op.data());
         Tuple *args[2] = { &data->key, nullptr };
+        auto begin = Timer::clock::now();
         if (data->is_probe_phase) {
             if (data->load_attrs.size() != 2) {
                 data->load_probe_key(this->schema());
@@ -1002,13 +1099,17 @@ void Pipeline::operator()(const JoinOperator &op)
             }
             auto &pipeline = data->pipeline;
             std::size_t i = 0;
+            data->num_tuples_probe += block_.size();
             for (auto &t : block_) {
                 args[1] = &t;
                 data->probe_key(args);
                 pipeline.block_.fill();
                 data->ht.for_all(*args[0], [&](std::pair<const Tuple, Tuple> &v) {
                     if (i == pipeline.block_.capacity()) {
+                        data->num_tuples_out += i;
+                        data->time += Timer::clock::now() - begin; // do not account time spent in ancestors
                         pipeline.push(*op.parent());
+                        begin = Timer::clock::now();
                         i = 0;
                     }
 
@@ -1026,8 +1127,12 @@ void Pipeline::operator()(const JoinOperator &op)
 
             if (i != 0) {
                 M_insist(i <= pipeline.block_.capacity());
+                data->num_tuples_out += i;
+                data->time += Timer::clock::now() - begin; // do not account time spent in ancestors
                 pipeline.block_.mask(i == pipeline.block_.capacity() ? -1UL : (1UL << i) - 1);
                 pipeline.push(*op.parent());
+            } else {
+                data->time += Timer::clock::now() - begin;
             }
         } else {
             if (data->load_attrs.size() != 1) {
@@ -1035,11 +1140,13 @@ void Pipeline::operator()(const JoinOperator &op)
                 data->emit_load_attrs(this->schema());
             }
             const auto &tuple_schema = op.child(0)->schema();
+            data->num_tuples_build += block_.size();
             for (auto &t : block_) {
                 args[1] = &t;
                 data->build_key(args);
                 data->ht.insert_with_duplicates(args[0]->clone(data->key_schema), t.clone(tuple_schema));
             }
+            data->time += Timer::clock::now() - begin;
         }
     } else {
         /* Perform nested-loops join. */
@@ -1073,6 +1180,8 @@ void Pipeline::operator()(const JoinOperator &op)
             M_insist(data->load_attrs.size() == size);
 
             for (;;) {
+                /* Poll the token in each iteration, since combinations without a match never push a block. */
+                CancellationToken::Check();
                 if (child_id == size - 1) { // right-most child, which produced the RHS `block_`
                     /* Combine the tuples.  One tuple from each buffer. */
                     pipeline.clear();
@@ -1107,8 +1216,10 @@ void Pipeline::operator()(const JoinOperator &op)
                         }
                     }
 
-                    if (not pipeline.block_.empty())
+                    if (not pipeline.block_.empty()) {
+                        data->num_tuples_out += pipeline.block_.size();
                         pipeline.push(*op.parent());
+                    }
                     --child_id;
                 } else { // child whose tuples have been materialized in a buffer
                     ++positions[child_id];
@@ -1287,6 +1398,8 @@ void Pipeline::operator()(const GroupingOperator &op)
     auto data = as<HashBasedGroupingData>(op.data());
     auto &groups = data->groups;
 
+    const auto begin = Timer::clock::now();
+    data->num_tuples_in += block_.size();
     Tuple key(op.schema());
     for (auto &tuple : block_) {
         Tuple *args[] = { &key, &tuple };
@@ -1300,6 +1413,7 @@ void Pipeline::operator()(const GroupingOperator &op)
         }
         perform_aggregation(*it, tuple, *data);
     }
+    data->time += Timer::clock::now() - begin;
 }
 
 void Pipeline::operator()(const AggregationOperator &op)
@@ -1409,6 +1523,112 @@ void Pipeline::operator()(const SortingOperator &op)
  * Interpreter - Recursive descent
  *====================================================================================================================*/
 
+void Interpreter::execute(const MatchBase &plan) const
+{
+    (*const_cast<Interpreter*>(this))(plan.get_matched_root()); // use former visitor pattern on logical operators
+    report_feedback(plan.get_matched_root());
+}
+
+namespace {
+
+/** Reports the true cardinalities of the subplans of the executed plan rooted in `op` to `CE`.  Only subplans that
+ * exclusively scan, filter, and join are reported, keyed by the aliases of the scanned relations.  Returns these
+ * aliases, or `std::nullopt` if the subplan rooted in `op` is not such a subplan.  If `executed` is `false`, `op` was
+ * skipped because a join stopped early on empty input, and no cardinalities are reported for its subplan.
+ */
+std::optional<std::vector<ThreadSafePooledString>>
+report_cardinalities(const Operator &op, FeedbackCardinalityEstimator &CE, bool executed = true)
+{
+    std::vector<ThreadSafePooledString> relations;
+    std::size_t cardinality;
+
+    if (auto scan = cast<const ScanOperator>(&op)) {
+        relations.emplace_back(scan->alias());
+        cardinality = scan->store().num_rows();
+    } else if (auto filter = cast<const FilterOperator>(&op)) {
+        auto child_relations = report_cardinalities(*filter->child(0), CE, executed);
+        if (not child_relations)
+            return std::nullopt;
+        relations = std::move(*child_relations);
+        if (auto data = cast<FilterData>(op.data()))
+            cardinality = data->num_tuples_out;
+        else if (auto data = cast<DisjunctiveFilterData>(op.data()))
+            cardinality = data->num_tuples_out;
+        else
+            cardinality = 0; // the filter never received a tuple
+    } else if (auto join = cast<const JoinOperator>(&op)) {
+        auto data = cast<JoinData>(op.data());
+        bool is_valid = true;
+        for (std::size_t i = 0; i != join->children().size(); ++i) {
+            const bool child_executed = executed and data and i < data->num_children_executed;
+            if (auto child_relations = report_cardinalities(*join->child(i), CE, child_executed))
+                relations.insert(relations.end(), child_relations->begin(), child_relations->end());
+            else
+                is_valid = false;
+        }
+        if (not is_valid)
+            return std::nullopt;
+        cardinality = data ? data->num_tuples_out : 0;
+    } else {
+        if (auto consumer = cast<const Consumer>(&op)) {
+            for (auto child : consumer->children())
+                report_cardinalities(*child, CE, executed);
+        }
+        return std::nullopt;
+    }
+
+    /* Children are reported first, s.t. a filter on top overwrites the cardinality of the relations it filters. */
+    if (executed)
+        CE.observe(relations, cardinality);
+    return relations;
+}
+
+}
+
+void Interpreter::report_feedback(const Operator &root)
+{
+    auto &C = Catalog::Get();
+
+    /*----- Report cardinalities to the cardinality estimator. -----*/
+    if (C.has_database_in_use()) {
+        if (auto CE = cast<FeedbackCardinalityEstimator>(&C.get_database_in_use().cardinality_estimator())) {
+            /* A limit stops execution early and hence the observed cardinalities are incomplete. */
+            bool has_limit = false;
+            visit(overloaded {
+                [&has_limit](const LimitOperator&) { has_limit = true; },
+                [](auto&&) { },
+            }, root, tag<ConstPreOrderOperatorVisitor>());
+            if (not has_limit) {
+                report_cardinalities(root, *CE);
+                CE->persist_if_due();
+            }
+        }
+    }
+
+    /*----- Report timings to the cost function. -----*/
+    if (not C.has_default_cost_function())
+        return;
+    auto CF = cast<AdaptiveCostFunction>(&C.cost_function());
+    if (not CF)
+        return;
+
+    visit(overloaded {
+        [CF](const FilterOperator &op) {
+            if (auto data = cast<FilterData>(op.data()))
+                CF->observe_filter(data->num_tuples_in, data->num_tuples_out, data->time);
+        },
+        [CF](const JoinOperator &op) {
+            if (auto data = cast<SimpleHashJoinData>(op.data()))
+                CF->observe_join(data->num_tuples_build, data->num_tuples_probe, data->num_tuples_out, data->time);
+        },
+        [CF](const GroupingOperator &op) {
+            if (auto data = cast<HashBasedGroupingData>(op.data()))
+                CF->observe_grouping(data->num_tuples_in, data->num_groups, data->time);
+        },
+        [](auto&&) { /* no feedback */ },
+    }, root, tag<ConstPreOrderOperatorVisitor>());
+}
+
 void Interpreter::operator()(const CallbackOperator &op)
 {
     op.child(0)->accept(*this);
@@ -1453,10 +1673,12 @@ void Interpreter::operator()(const JoinOperator &op)
         op.data(data);
         if (op.has_info())
             data->ht.resize(op.info().estimated_cardinality);
+        data->num_children_executed = 1;
         op.child(0)->accept(*this); // build HT on LHS
         if (data->ht.size() == 0) // no tuples produced
             return;
         data->is_probe_phase = true;
+        data->num_children_executed = 2;
         op.child(1)->accept(*this); // probe HT with RHS
     } else {
         /* Perform nested-loops join. */
@@ -1464,6 +1686,7 @@ void Interpreter::operator()(const JoinOperator &op)
         op.data(data);
         for (std::size_t i = 0, end = op.children().size(); i != end; ++i) {
             data->active_child = i;
+            data->num_children_executed = i + 1;
             auto c = op.child(i);
             c->accept(*this);
             if (i != op.children().size() - 1 and data->buffers[i].empty()) // no tuples produced
@@ -1506,7 +1729,7 @@ void Interpreter::operator()(const GroupingOperator &op)
 
     op.child(0)->accept(*this);
 
-    const auto num_groups = data->groups.size();
+    const auto num_groups = data->num_groups = data->groups.size();
     const auto remainder = num_groups % data->pipeline.block_.capacity();
     auto it = data->groups.begin();
     for (std::size_t i = 0; i != num_groups - remainder; i += data->pipeline.block_.capacity()) {
@@ -6,6 +6,7 @@
 #include <ctime>
 #include <mutable/backend/Backend.hpp>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Scheduler.hpp>
 #include <mutable/IR/Operator.hpp>
 #include <mutable/IR/Tuple.hpp>
 #include <mutable/util/macro.hpp>
@@ -199,7 +200,12 @@ struct Pipeline : ConstOperatorVisitor
         block_[0] = std::move(t);
     }
 
-    void push(const Operator &pipeline_start) { (*this)(pipeline_start); }
+    /** Pushes the block of this pipeline into \p pipeline_start.  Throws `m::execution_cancelled` if the command in
+     * execution was cancelled or exceeded its timeout, such that queries are interrupted between two blocks. */
+    void push(const Operator &pipeline_start) {
+        CancellationToken::Check();
+        (*this)(pipeline_start);
+    }
 
     void clear() { block_.clear(); }
 
@@ -219,9 +225,12 @@ struct Interpreter : Backend, ConstOperatorVisitor
 
     void register_operators(PhysicalOptimizer &phys_opt) const override { register_interpreter_operators(phys_opt); }
 
-    void execute(const MatchBase &plan) const override {
-        (*const_cast<Interpreter*>(this))(plan.get_matched_root()); // use former visitor pattern on logical operators
-    }
+    void execute(const MatchBase &plan) const override;
+
+    /** Reports the cardinalities and timings observed while executing the operator tree rooted in `root` to the
+     * `AdaptiveCostFunction`, if that is the `CostFunction` in use, and to the `FeedbackCardinalityEstimator`, if that
+     * is the `CardinalityEstimator` of the `Database` in use. */
+    static void report_feedback(const Operator &root);
 
     using ConstOperatorVisitor::operator();
 #define DECLARE(CLASS) void operator()(Const<CLASS> &op) override;
@@ -3,6 +3,7 @@
 #include "backend/Interpreter.hpp"
 #include <ctime>
 #include <functional>
+#include <mutable/storage/Dictionary.hpp>
 #include <mutable/util/fn.hpp>
 #include <regex>
 
@@ -107,8 +108,18 @@ void StackMachineBuilder::operator()(Const<ast::FnApplicationExpr> &e)
         default:
             M_unreachable("function kind not implemented");
 
-        case Function::FN_UDF:
-            M_unreachable("UDFs not yet supported");
+        case Function::FN_UDF: {
+            auto &udf = as<const ScalarUDF>(fn);
+            M_insist(e.args.size() == udf.num_parameters());
+            if (not udf.has_callback())
+                throw backend_exception("user-defined function has no host callback");
+            for (std::size_t i = 0; i != e.args.size(); ++i) {
+                (*this)(*e.args[i]);
+                stack_machine_.emit_Cast(udf.parameter_types[i], e.args[i]->type());
+            }
+            stack_machine_.emit_Call(udf);
+            break;
+        }
 
         case Function::FN_ISNULL:
             M_insist(e.args.size() == 1);
@@ -730,6 +741,16 @@ void StackMachine::emit_Print(std::size_t ostream_index, const Type *ty)
     }
 }
 
+void StackMachine::emit_Call(const ScalarUDF &udf)
+{
+    M_insist(udf.has_callback(), "UDF has no host callback");
+    emit_Call_UDF(add(&udf));
+    /* The call pops one entry per parameter and pushes the result. */
+    current_stack_size_ += 1 - int64_t(udf.num_parameters());
+    M_insist(current_stack_size_ >= 0);
+    required_stack_size_ = std::max(required_stack_size_, current_stack_size_);
+}
+
 void StackMachine::emit_Cast(const Type *to_ty, const Type *from_ty)
 {
     auto to   = as<const PrimitiveType>(to_ty);
@@ -1154,6 +1175,30 @@ Ld_b: {
 }
 NEXT;
 
+Ld_Dict: {
+    M_insist(top_ >= 1);
+    std::size_t index = std::size_t(*op_++);
+    M_insist(index < context_.size(), "index out of bounds");
+    auto dict = reinterpret_cast<const storage::Dictionary*>(context_[index].as_p());
+    void *ptr = TOP.as_p();
+    TOP = const_cast<char*>(dict->decode(*reinterpret_cast<const storage::Dictionary::code_type*>(ptr))); // a pointer
+}
+NEXT;
+
+Ld_Bits: {
+    M_insist(top_ >= 2);
+    uint64_t width = uint64_t(*op_++);
+    uint64_t bit_offset = TOP.as_i();
+    M_insist(bit_offset < 8 and width < 64 and bit_offset + width <= 64, "value must fit into 64 bits");
+    POP();
+    auto ptr = reinterpret_cast<const uint8_t*>(TOP.as_p());
+    uint64_t bits = 0;
+    for (uint64_t i = 0; 8 * i < bit_offset + width; ++i) // access only the bytes containing the value
+        bits |= uint64_t(ptr[i]) << (8 * i);
+    TOP = int64_t((bits >> bit_offset) & ((uint64_t(1) << width) - 1));
+}
+NEXT;
+
 #undef LOAD
 
 /*----- Store to memory ----------------------------------------------------------------------------------------------*/
@@ -1203,6 +1248,40 @@ St_b: {
 }
 NEXT;
 
+St_Dict: {
+    M_insist(top_ >= 2);
+    std::size_t index = std::size_t(*op_++);
+    M_insist(index < context_.size(), "index out of bounds");
+    if (TOP_IS_NULL) { POP(); POP(); NEXT; }
+
+    auto dict = reinterpret_cast<storage::Dictionary*>(context_[index].as_p());
+    const char *str = reinterpret_cast<const char*>(TOP.as_p());
+    POP();
+    void *ptr = TOP.as_p();
+    *reinterpret_cast<storage::Dictionary::code_type*>(ptr) = dict->encode(str);
+    POP();
+}
+NEXT;
+
+St_Bits: {
+    M_insist(top_ >= 3);
+    uint64_t width = uint64_t(*op_++);
+    if (TOP_IS_NULL) { POP(); POP(); POP(); NEXT; }
+
+    uint64_t val = TOP.as_i();
+    POP();
+    uint64_t bit_offset = TOP.as_i();
+    M_insist(bit_offset < 8 and width < 64 and bit_offset + width <= 64, "value must fit into 64 bits");
+    POP();
+    auto ptr = reinterpret_cast<uint8_t*>(TOP.as_p());
+    const uint64_t mask = ((uint64_t(1) << width) - 1) << bit_offset;
+    const uint64_t bits = (val << bit_offset) & mask;
+    for (uint64_t i = 0; 8 * i < bit_offset + width; ++i) // update only the bytes containing the value
+        ptr[i] = (ptr[i] & ~uint8_t(mask >> (8 * i))) | uint8_t(bits >> (8 * i));
+    POP();
+}
+NEXT;
+
 #undef STORE
 
 
@@ -1534,6 +1613,34 @@ Cast_f_d: UNARY((float), double);
 Cast_d_i: UNARY((double), int64_t);
 Cast_d_f: UNARY((double), float);
 
+
+/*======================================================================================================================
+ * User-defined functions
+ *====================================================================================================================*/
+
+Call_UDF: {
+    std::size_t idx = std::size_t(*op_++);
+    M_insist(idx < context_.size(), "index out of bounds");
+    auto &udf = *reinterpret_cast<const ScalarUDF*>(context_[idx].as_p());
+    const std::size_t num_args = udf.num_parameters();
+    M_insist(top_ >= num_args);
+
+    /* Call the UDF on a batch of a single row, whose arguments are the top-most entries of the stack. */
+    const std::size_t first = top_ - num_args;
+    const Value *args[ScalarUDF::MAX_NUM_PARAMETERS];
+    const bool *args_are_null[ScalarUDF::MAX_NUM_PARAMETERS];
+    for (std::size_t i = 0; i != num_args; ++i) {
+        args[i] = &values_[first + i];
+        args_are_null[i] = &null_bits_[first + i];
+    }
+    Value result;
+    bool result_is_null = false;
+    udf(1, args, args_are_null, &result, &result_is_null);
+    top_ = first;
+    PUSH(result, result_is_null);
+}
+NEXT;
+
 #undef BINARY
 #undef UNARY
 
@@ -1601,6 +1708,11 @@ void StackMachine::dump(std::ostream &out) const
             case Opcode::Ld_b:
             case Opcode::St_s:
             case Opcode::St_b:
+            case Opcode::Ld_Dict:
+            case Opcode::St_Dict:
+            case Opcode::Ld_Bits:
+            case Opcode::St_Bits:
+            case Opcode::Call_UDF:
                 ++i;
                 out << ' ' << static_cast<int64_t>(ops[i]);
                 /* fall through */
@@ -190,6 +190,10 @@ struct StackMachine
     /** Emit opcodes to convert a value of `Type` `from_ty` to `Type` `to_ty`. */
     void emit_Cast(const Type *to_ty, const Type *from_ty);
 
+    /** Emit a `Call_UDF` instruction calling the `ScalarUDF` `udf` on the top-most `udf.num_parameters()` entries of
+     * the stack, which must be of the parameter types of `udf`. */
+    void emit_Call(const ScalarUDF &udf);
+
     /** Appends the `Value` `val` to the context and returns its assigned index. */
     std::size_t add(Value val) {
         auto idx = context_.size();
@@ -5,7 +5,10 @@
 #include "backend/WasmUtil.hpp"
 #include "mutable/util/macro.hpp"
 #include "storage/Store.hpp"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -14,6 +17,7 @@
 #include <fstream>
 #include <libplatform/libplatform.h>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Scheduler.hpp>
 #include <mutable/IR/PhysicalOptimizer.hpp>
 #include <mutable/IR/Tuple.hpp>
 #include <mutable/Options.hpp>
@@ -23,9 +27,11 @@
 #include <mutable/util/enum_ops.hpp>
 #include <mutable/util/memory.hpp>
 #include <mutable/util/Timer.hpp>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 // must be included after Binaryen due to conflicts, e.g. with `::wasm::Throw`
@@ -531,6 +537,29 @@ void m::wasm::detail::read_result_set(const v8::FunctionCallbackInfo<v8::Value>
     }
 }
 
+void m::wasm::detail::map_table_chunk(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 2);
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    auto window = info[0].As<v8::Uint32>()->Value();
+    auto chunk = info[1].As<v8::Uint32>()->Value();
+    info.GetReturnValue().Set(context.map_table_chunk(window, chunk));
+}
+
+void m::wasm::detail::enter_pipeline(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 1);
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    context.enter_pipeline(info[0].As<v8::Uint32>()->Value());
+}
+
+void m::wasm::detail::leave_pipeline(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 1);
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    context.leave_pipeline(info[0].As<v8::Uint32>()->Value());
+}
+
 template<typename Index, typename V8ValueT, bool IsLower>
 void m::wasm::detail::index_seek(const v8::FunctionCallbackInfo<v8::Value> &info)
 {
@@ -721,6 +750,58 @@ struct CollectTables : ConstOperatorVisitor
     void operator()(const SortingOperator &op) override { recurse(op); }
 };
 
+/** Terminates the execution of an isolate once a `CancellationToken` is cancelled or expires.  Since WebAssembly code
+ * does not poll the token, a separate thread polls it for the lifetime of the watchdog and interrupts the isolate via
+ * `v8::Isolate::TerminateExecution()`. */
+struct ExecutionWatchdog
+{
+    private:
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{10}; ///< the interval in which the token is polled
+
+    std::mutex mutex_;
+    std::condition_variable is_done_; ///< notified when the watched execution completed
+    bool done_ = false; ///< whether the watched execution completed
+    std::atomic<bool> has_terminated_ = false; ///< whether the watchdog terminated the execution
+    std::thread thread_; ///< the thread polling the token
+
+    public:
+    /** Watches the execution of \p isolate on behalf of \p token.  Does nothing if \p token is `nullptr`. */
+    ExecutionWatchdog(v8::Isolate &isolate, const CancellationToken *token) {
+        if (not token)
+            return;
+        thread_ = std::thread([this, &isolate, token]() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (not is_done_.wait_for(lock, POLL_INTERVAL, [this]() { return done_; })) {
+                if (token->is_stopped()) {
+                    has_terminated_ = true;
+                    isolate.TerminateExecution();
+                    return;
+                }
+            }
+        });
+    }
+    ExecutionWatchdog(const ExecutionWatchdog&) = delete;
+
+    ~ExecutionWatchdog() { stop(); }
+
+    /** Stops watching the execution and joins the polling thread.  Afterwards, the watchdog does not terminate the
+     * execution anymore and `has_terminated()` is final. */
+    void stop() {
+        if (not thread_.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        is_done_.notify_one();
+        thread_.join();
+    }
+
+    /** Returns `true` iff the watchdog terminated the execution.  Must only be called after `stop()`, since the
+     * watchdog may terminate the execution until then. */
+    bool has_terminated() const { return has_terminated_.load(); }
+};
+
 
 /*======================================================================================================================
  * V8Engine implementation
@@ -867,6 +948,7 @@ void V8Engine::execute(const m::MatchBase &plan)
     M_insist(bool(isolate_), "must have an isolate");
     v8::Locker locker(isolate_);
     isolate_->Enter();
+    bool is_terminated = false; // whether the execution was terminated because the command was stopped
 
     {
         /* Create required V8 scopes. */
@@ -897,16 +979,34 @@ void V8Engine::execute(const m::MatchBase &plan)
         CREATE_TEMPLATES(idx::RecursiveModelIndex, int64_t,     v8::BigInt, rmi, i8);
         CREATE_TEMPLATES(idx::RecursiveModelIndex, float,       v8::Number, rmi, f);
         CREATE_TEMPLATES(idx::RecursiveModelIndex, double,      v8::Number, rmi, d);
+        CREATE_TEMPLATES(idx::PiecewiseGeometricModelIndex, int8_t,      v8::Int32,  pgm, i1);
+        CREATE_TEMPLATES(idx::PiecewiseGeometricModelIndex, int16_t,     v8::Int32,  pgm, i2);
+        CREATE_TEMPLATES(idx::PiecewiseGeometricModelIndex, int32_t,     v8::Int32,  pgm, i4);
+        CREATE_TEMPLATES(idx::PiecewiseGeometricModelIndex, int64_t,     v8::BigInt, pgm, i8);
+        CREATE_TEMPLATES(idx::PiecewiseGeometricModelIndex, float,       v8::Number, pgm, f);
+        CREATE_TEMPLATES(idx::PiecewiseGeometricModelIndex, double,      v8::Number, pgm, d);
+        CREATE_TEMPLATES(idx::PiecewiseGeometricModelIndex, const char*, v8::String, pgm, p);
 #undef CREATE_TEMPLATES
 
         v8::Local<v8::Context> context = v8::Context::New(isolate_, /* extensions= */ nullptr, global);
         v8::Context::Scope context_scope(context);
 
+        /* The writer may concurrently grow the stores.  Latch the memory of stores while mapping it and generating
+         * code, which reads the zone maps and the visibility summaries of the stores.  The module accesses the stores
+         * through mappings by offset, which stay valid while stores grow in place.  Hence, keep the latch during the
+         * execution only if a store reorganizes its contents when growing. */
+        Store::shared_memory_latch memory_latch;
+        const auto tables = CollectTables::Collect(plan.get_matched_root());
+        const bool is_latched_during_execution = std::any_of(tables.cbegin(), tables.cend(), [](auto &table) {
+            return not table.get().store().grows_in_place();
+        });
+
         /* Create the import object for instantiating the WebAssembly module. */
         WasmContext::config_t wasm_config{0};
         if (options::cdt_port < 1024)
             wasm_config |= WasmContext::TRAP_GUARD_PAGES;
         auto &wasm_context = Create_Wasm_Context_For_ID(Module::ID(), plan, wasm_config);
+        wasm_context.feedback.is_enabled = wasm_context.wants_feedback();
 
         auto imports = v8::Object::New(isolate_);
         auto env = create_env(*isolate_, plan);
@@ -921,6 +1021,8 @@ void V8Engine::execute(const m::MatchBase &plan)
         auto compile_time = C.timer().create_timing("Compile SQL to machine code");
         /* Compile the plan and thereby build the Wasm module. */
         M_TIME_EXPR(compile(plan), "|- Compile SQL to WebAssembly", C.timer());
+        if (not is_latched_during_execution)
+            memory_latch.unlock();
         /* Create a WebAssembly instance object. */
         auto instance = M_TIME_EXPR(instantiate(*isolate_, imports), " ` Compile WebAssembly to machine code", C.timer());
         compile_time.stop();
@@ -940,20 +1042,33 @@ void V8Engine::execute(const m::MatchBase &plan)
             return;
         }
 
-        /* Invoke the exported function `main` of the module. */
+        /* Invoke the exported function `main` of the module.  The execution is terminated once the command in
+         * execution is cancelled or exceeds its timeout. */
         args_t args { v8::Int32::New(isolate_, wasm_context.id), };
-        const uint32_t num_rows =
-            M_TIME_EXPR(main->Call(context, context->Global(), 1, args).ToLocalChecked().As<v8::Uint32>()->Value(),
-                        "Execute machine code", C.timer());
-
-        /* Print total number of result tuples. */
-        auto &root_op = plan.get_matched_root();
-        if (auto print_op = cast<const PrintOperator>(&root_op)) {
-            if (not Options::Get().quiet)
-                print_op->out << num_rows << " rows\n";
-        } else if (auto noop_op = cast<const NoOpOperator>(&root_op)) {
-            if (not Options::Get().quiet)
-                noop_op->out << num_rows << " rows\n";
+        v8::MaybeLocal<v8::Value> result;
+        {
+            ExecutionWatchdog watchdog(*isolate_, CancellationToken::Current());
+            result = M_TIME_EXPR(main->Call(context, context->Global(), 1, args), "Execute machine code", C.timer());
+            watchdog.stop(); // join the watchdog, such that it cannot terminate the execution after reading the flag
+            is_terminated = watchdog.has_terminated();
+        }
+        if (is_terminated) {
+            isolate_->CancelTerminateExecution(); // the isolate is reused by later queries
+        } else {
+            const uint32_t num_rows = result.ToLocalChecked().As<v8::Uint32>()->Value();
+
+            /* Print total number of result tuples. */
+            auto &root_op = plan.get_matched_root();
+            if (auto print_op = cast<const PrintOperator>(&root_op)) {
+                if (not Options::Get().quiet)
+                    print_op->out << num_rows << " rows\n";
+            } else if (auto noop_op = cast<const NoOpOperator>(&root_op)) {
+                if (not Options::Get().quiet)
+                    noop_op->out << num_rows << " rows\n";
+            }
+
+            if (wasm_context.feedback.is_enabled)
+                wasm_context.report_feedback();
         }
         Dispose_Wasm_Context(wasm_context);
     }
@@ -961,6 +1076,11 @@ void V8Engine::execute(const m::MatchBase &plan)
     isolate_->Exit();
     CodeGenContext::Dispose();
     Module::Dispose();
+
+    if (is_terminated) {
+        CancellationToken::Check(); // throws, since the watchdog only terminates stopped commands
+        M_unreachable("execution must only be terminated if the command was stopped");
+    }
 }
 
 __attribute__((constructor(101)))
@@ -993,6 +1113,20 @@ static void register_WasmV8()
         /* description= */ "set the optimization level for Wasm modules (0, 1, or 2)",
                            [] (int i) { options::wasm_optimization_level = i; }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-table-window",
+        /* description= */ "set the size in MiB of the window in linear memory each table is mapped into; larger "
+                           "tables are scanned chunk by chunk",
+                           [] (std::size_t MiB) {
+                               if (MiB == 0) {
+                                   std::cerr << "warning: ignore invalid table window size 0" << std::endl;
+                                   return;
+                               }
+                               WasmEngine::table_window_size = MiB * 1024 * 1024;
+                           }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "WasmV8",
         /* short=       */ nullptr,
@@ -1093,6 +1227,30 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
         oss << table.get().name() << "_num_rows";
         M_DISCARD env->Set(Ctx, to_v8_string(&isolate, oss.str()), v8::Int32::New(&isolate, table.get().store().num_rows()));
         Module::Get().emit_import<uint32_t>(oss.str().c_str());
+
+        if (WasmEngine::Is_Chunked(table.get())) {
+            /* Add the window of a table mapped chunk by chunk to env. */
+            oss.str("");
+            oss << table.get().name() << "_window";
+            M_DISCARD env->Set(Ctx, to_v8_string(&isolate, oss.str()),
+                               v8::Int32::New(&isolate, context.table_window(table.get())));
+            Module::Get().emit_import<uint32_t>(oss.str().c_str());
+        }
+
+        /* Map the dictionaries of dictionary-encoded attributes and add their addresses to env. */
+        table.get().layout().for_sibling_leaves([&](const std::vector<storage::DataLayout::leaf_info_t> &leaves,
+                                                    const storage::DataLayout::level_info_stack_t&, uint64_t)
+        {
+            for (auto &leaf_info : leaves) {
+                if (not leaf_info.leaf.is_dictionary_encoded())
+                    continue;
+                auto &dict = leaf_info.leaf.dictionary();
+                auto name = WasmEngine::Dictionary_Global_Name(dict);
+                M_DISCARD env->Set(Ctx, to_v8_string(&isolate, name),
+                                   v8::Int32::New(&isolate, context.map_dictionary(dict)));
+                Module::Get().emit_import<void*>(name.c_str());
+            }
+        });
     }
 
     /* Map all string literals into the Wasm module. */
@@ -1118,6 +1276,9 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
 
     /* Add functions to environment. */
     Module::Get().emit_function_import<void(void*,uint32_t)>("read_result_set");
+    Module::Get().emit_function_import<uint32_t(uint32_t,uint32_t)>("map_table_chunk");
+    Module::Get().emit_function_import<void(uint32_t)>("enter_pipeline");
+    Module::Get().emit_function_import<void(uint32_t)>("leave_pipeline");
 
 #define EMIT_FUNC_IMPORTS(KEYTYPE, IDXNAME, SUFFIX) \
     Module::Get().emit_function_import<uint32_t(std::size_t,KEYTYPE)>(M_STR(idx_lower_bound_##IDXNAME##_##SUFFIX)); \
@@ -1138,6 +1299,13 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     EMIT_FUNC_IMPORTS(int64_t,     rmi, i8);
     EMIT_FUNC_IMPORTS(float,       rmi, f);
     EMIT_FUNC_IMPORTS(double,      rmi, d);
+    EMIT_FUNC_IMPORTS(int8_t,      pgm, i1);
+    EMIT_FUNC_IMPORTS(int16_t,     pgm, i2);
+    EMIT_FUNC_IMPORTS(int32_t,     pgm, i4);
+    EMIT_FUNC_IMPORTS(int64_t,     pgm, i8);
+    EMIT_FUNC_IMPORTS(float,       pgm, f);
+    EMIT_FUNC_IMPORTS(double,      pgm, d);
+    EMIT_FUNC_IMPORTS(const char*, pgm, p);
 #undef EMIT_FUNC_IMPORTS
 
 #define ADD_FUNC(FUNC, NAME) { \
@@ -1149,6 +1317,9 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     ADD_FUNC_(print)
     ADD_FUNC_(print_memory_consumption)
     ADD_FUNC_(read_result_set)
+    ADD_FUNC_(map_table_chunk)
+    ADD_FUNC_(enter_pipeline)
+    ADD_FUNC_(leave_pipeline)
     ADD_FUNC(_throw, "throw")
 
 #define ADD_FUNCS(IDXTYPE, KEYTYPE, V8TYPE, IDXNAME, SUFFIX) \
@@ -1170,6 +1341,13 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     ADD_FUNCS(idx::RecursiveModelIndex, int64_t,     v8::BigInt,  rmi, i8);
     ADD_FUNCS(idx::RecursiveModelIndex, float,       v8::Number,  rmi, f);
     ADD_FUNCS(idx::RecursiveModelIndex, double,      v8::Number,  rmi, d);
+    ADD_FUNCS(idx::PiecewiseGeometricModelIndex, int8_t,      v8::Int32,   pgm, i1);
+    ADD_FUNCS(idx::PiecewiseGeometricModelIndex, int16_t,     v8::Int32,   pgm, i2);
+    ADD_FUNCS(idx::PiecewiseGeometricModelIndex, int32_t,     v8::Int32,   pgm, i4);
+    ADD_FUNCS(idx::PiecewiseGeometricModelIndex, int64_t,     v8::BigInt,  pgm, i8);
+    ADD_FUNCS(idx::PiecewiseGeometricModelIndex, float,       v8::Number,  pgm, f);
+    ADD_FUNCS(idx::PiecewiseGeometricModelIndex, double,      v8::Number,  pgm, d);
+    ADD_FUNCS(idx::PiecewiseGeometricModelIndex, const char*, v8::String,  pgm, p);
 #undef ADD_FUNCS
 #undef ADD_FUNC_
 #undef ADD_FUNC
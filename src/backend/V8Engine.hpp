@@ -83,6 +83,9 @@ void print(const v8::FunctionCallbackInfo<v8::Value> &info);
 void print_memory_consumption(const v8::FunctionCallbackInfo<v8::Value> &info);
 void set_wasm_instance_raw_memory(const v8::FunctionCallbackInfo<v8::Value> &info);
 void read_result_set(const v8::FunctionCallbackInfo<v8::Value> &info);
+void map_table_chunk(const v8::FunctionCallbackInfo<v8::Value> &info);
+void enter_pipeline(const v8::FunctionCallbackInfo<v8::Value> &info);
+void leave_pipeline(const v8::FunctionCallbackInfo<v8::Value> &info);
 template<typename Index, typename V8ValueT, bool IsLower>
 void index_seek(const v8::FunctionCallbackInfo<v8::Value> &info);
 template<typename Index>
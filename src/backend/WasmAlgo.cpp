@@ -291,6 +291,27 @@ U64x1 m::wasm::murmur3_bit_mix(U64x1 bits)
     return res;
 }
 
+template<std::size_t L>
+requires (L > 1)
+U64<L> m::wasm::murmur3_bit_mix(U64<L> bits)
+{
+    /* Lane-wise variant of the scalar `murmur3_bit_mix()` using the very same constants. */
+    Var<U64<L>> res(bits);
+    res ^= res >> uint32_t(31);
+    res *= U64<L>(0x7fb5d329728ea185UL);
+    res ^= res >> uint32_t(27);
+    res *= U64<L>(0x81dadef4bc2dd44dUL);
+    res ^= res >> uint32_t(33);
+    return res;
+}
+
+// explicit instantiations to prevent linker errors
+template U64x2  m::wasm::murmur3_bit_mix<2>(U64x2);
+template U64x4  m::wasm::murmur3_bit_mix<4>(U64x4);
+template U64x8  m::wasm::murmur3_bit_mix<8>(U64x8);
+template U64x16 m::wasm::murmur3_bit_mix<16>(U64x16);
+template U64x32 m::wasm::murmur3_bit_mix<32>(U64x32);
+
 
 /*----- hash functions -----------------------------------------------------------------------------------------------*/
 
@@ -431,6 +452,37 @@ U64x1 m::wasm::murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> value
     return murmur3_bit_mix(h);
 }
 
+bool m::wasm::is_simd_hashable(const std::vector<const Type*> &types)
+{
+    if (types.size() != 1)
+        return false;
+    auto ty = types.front();
+    return (ty->is_integral() or ty->is_date() or ty->is_date_time()) and ty->size() >= 32;
+}
+
+template<std::size_t L>
+requires (L > 1)
+U64<L> m::wasm::murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> values)
+{
+    M_insist(is_simd_hashable({ values.front().first }), "values cannot be hashed for all SIMD lanes at once");
+
+    /*----- Handle a single value lane-wise exactly like the scalar hash, i.e. mix the zero-extended value. -----*/
+    return std::visit(overloaded {
+        [&]<typename T>(Expr<T, L> val) -> U64<L> requires signed_integral<T> and (sizeof(T) >= 4) {
+            return murmur3_bit_mix<L>(val.insist_not_null().make_unsigned().template to<uint64_t>());
+        },
+        [](auto) -> U64<L> { M_unreachable("value is not SIMD hashable"); },
+        [](std::monostate) -> U64<L> { M_unreachable("invalid variant"); }
+    }, values.front().second);
+}
+
+// explicit instantiations to prevent linker errors
+template U64x2  m::wasm::murmur3_64a_hash<2>(std::vector<std::pair<const Type*, SQL_t>>);
+template U64x4  m::wasm::murmur3_64a_hash<4>(std::vector<std::pair<const Type*, SQL_t>>);
+template U64x8  m::wasm::murmur3_64a_hash<8>(std::vector<std::pair<const Type*, SQL_t>>);
+template U64x16 m::wasm::murmur3_64a_hash<16>(std::vector<std::pair<const Type*, SQL_t>>);
+template U64x32 m::wasm::murmur3_64a_hash<32>(std::vector<std::pair<const Type*, SQL_t>>);
+
 
 /*----- hash tables --------------------------------------------------------------------------------------------------*/
 
@@ -696,15 +748,28 @@ Ptr<void> ChainedHashTable<IsGlobal>::hash_to_bucket(std::vector<SQL_t> key) con
     M_insist(key.size() == key_indices_.size(),
              "provided number of key elements does not match hash table's number of key indices");
 
-    /*----- Collect types of key together with the respective value. -----*/
-    std::vector<std::pair<const Type*, SQL_t>> values;
-    values.reserve(key_indices_.size());
-    auto key_it = key.begin();
-    for (auto k : key_indices_)
-        values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
+    /*----- Compute hash of key using Murmur3_64a, unless it was precomputed. -----*/
+    U64x1 hash = [&]() -> U64x1 {
+        if (precomputed_hash_) {
+            for (auto &k : key) {
+                std::visit(overloaded {
+                    [](auto &v) -> void { v.discard(); }, // since the key is not hashed
+                    [](std::monostate&) -> void { M_unreachable("invalid variant"); },
+                }, k);
+            }
+            U64x1 h = *precomputed_hash_;
+            precomputed_hash_.reset();
+            return h;
+        }
 
-    /*----- Compute hash of key using Murmur3_64a. -----*/
-    U64x1 hash = murmur3_64a_hash(std::move(values));
+        /*----- Collect types of key together with the respective value. -----*/
+        std::vector<std::pair<const Type*, SQL_t>> values;
+        values.reserve(key_indices_.size());
+        auto key_it = key.begin();
+        for (auto k : key_indices_)
+            values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
+        return murmur3_64a_hash(std::move(values));
+    }();
 
     /*----- Compute bucket address. -----*/
     U32x1 bucket_idx = hash.to<uint32_t>() bitand *mask_; // modulo capacity
@@ -1207,6 +1272,9 @@ void ChainedHashTable<IsGlobal>::rehash()
     if (options::insist_no_rehashing)
         Throw(exception::unreachable, "rehashing must not occur");
 
+    /*----- Stash a precomputed hash s.t. it is not consumed by reinserting the entries. -----*/
+    auto precomputed_hash = std::exchange(precomputed_hash_, std::nullopt);
+
     auto emit_rehash = [this](){
         auto S = CodeGenContext::Get().scoped_environment(); // fresh environment to remove predication while rehashing
 
@@ -1310,6 +1378,10 @@ void ChainedHashTable<IsGlobal>::rehash()
         /*----- Emit rehashing code. ------*/
         emit_rehash();
     }
+
+    /*----- Restore the stashed precomputed hash. -----*/
+    if (precomputed_hash)
+        precomputed_hash_.emplace(*precomputed_hash);
 }
 
 // explicit instantiations to prevent linker errors
@@ -1334,15 +1406,28 @@ Ptr<void> OpenAddressingHashTableBase::hash_to_bucket(std::vector<SQL_t> key) co
     M_insist(key.size() == key_indices_.size(),
              "provided number of key elements does not match hash table's number of key indices");
 
-    /*----- Collect types of key together with the respective value. -----*/
-    std::vector<std::pair<const Type*, SQL_t>> values;
-    values.reserve(key_indices_.size());
-    auto key_it = key.begin();
-    for (auto k : key_indices_)
-        values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
+    /*----- Compute hash of key using Murmur3_64a, unless it was precomputed. -----*/
+    U64x1 hash = [&]() -> U64x1 {
+        if (precomputed_hash_) {
+            for (auto &k : key) {
+                std::visit(overloaded {
+                    [](auto &v) -> void { v.discard(); }, // since the key is not hashed
+                    [](std::monostate&) -> void { M_unreachable("invalid variant"); },
+                }, k);
+            }
+            U64x1 h = *precomputed_hash_;
+            precomputed_hash_.reset();
+            return h;
+        }
 
-    /*----- Compute hash of key using Murmur3_64a. -----*/
-    U64x1 hash = murmur3_64a_hash(std::move(values));
+        /*----- Collect types of key together with the respective value. -----*/
+        std::vector<std::pair<const Type*, SQL_t>> values;
+        values.reserve(key_indices_.size());
+        auto key_it = key.begin();
+        for (auto k : key_indices_)
+            values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
+        return murmur3_64a_hash(std::move(values));
+    }();
 
     /*----- Compute bucket address. -----*/
     U32x1 bucket_idx = hash.to<uint32_t>() bitand mask(); // modulo capacity
@@ -2233,6 +2318,9 @@ void OpenAddressingHashTable<IsGlobal, ValueInPlace>::rehash()
     if (options::insist_no_rehashing)
         Throw(exception::unreachable, "rehashing must not occur");
 
+    /*----- Stash a precomputed hash s.t. it is not consumed by reinserting the entries. -----*/
+    auto precomputed_hash = std::exchange(precomputed_hash_, std::nullopt);
+
     auto emit_rehash = [this](){
         auto S = CodeGenContext::Get().scoped_environment(); // fresh environment to remove predication while rehashing
 
@@ -2370,6 +2458,10 @@ void OpenAddressingHashTable<IsGlobal, ValueInPlace>::rehash()
         /*----- Emit rehashing code. ------*/
         emit_rehash();
     }
+
+    /*----- Restore the stashed precomputed hash. -----*/
+    if (precomputed_hash)
+        precomputed_hash_.emplace(*precomputed_hash);
 }
 
 // explicit instantiations to prevent linker errors
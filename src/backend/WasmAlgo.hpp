@@ -36,6 +36,10 @@ void quicksort(Buffer<IsGlobal> &buffer, const std::vector<SortingOperator::orde
 
 /** Mixes the bits of \p bits using the Murmur3 algorithm. */
 U64x1 murmur3_bit_mix(U64x1 bits);
+/** Mixes the bits of each SIMD lane of \p bits using the Murmur3 algorithm. */
+template<std::size_t L>
+requires (L > 1)
+U64<L> murmur3_bit_mix(U64<L> bits);
 
 
 /*----- hash functions -----------------------------------------------------------------------------------------------*/
@@ -47,6 +51,17 @@ U64x1 str_hash(NChar str);
 /** Hashes the elements of \p values where the first element is the type of the value to hash and the second element
  * is the value itself using the Murmur3-64a algorithm. */
 U64x1 murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> values);
+/** Returns `true` iff values of types \p types can be hashed for all SIMD lanes at once, i.e. by the vectorial variant
+ * of `murmur3_64a_hash()`.  Currently, this requires a single value of a 32 or 64 bit integral, `Date`, or `DateTime`
+ * type. */
+bool is_simd_hashable(const std::vector<const Type*> &types);
+/** Hashes the elements of \p values, each a SIMD vector of \tparam L lanes, lane-wise, where the first element is the
+ * type of the value to hash and the second element is the value itself.  The hash of each lane equals the hash
+ * `murmur3_64a_hash()` computes for the values of this lane.  Requires `is_simd_hashable()` for the types of
+ * \p values and the values to not be `NULL`. */
+template<std::size_t L>
+requires (L > 1)
+U64<L> murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> values);
 
 
 /*----- hash tables --------------------------------------------------------------------------------------------------*/
@@ -504,6 +519,8 @@ struct HashTable
     std::reference_wrapper<const Schema> schema_; ///< schema of hash table
     std::vector<index_t> key_indices_; ///< keys of hash table
     std::vector<index_t> value_indices_; ///< values of hash table
+    ///> hash of the key of the next insertion or lookup, if computed by the caller; consumed when computing the bucket
+    mutable std::optional<U64x1> precomputed_hash_;
 
     public:
     HashTable() = delete;
@@ -526,7 +543,10 @@ struct HashTable
     HashTable(const HashTable&) = delete;
     HashTable(HashTable&&) = default;
 
-    virtual ~HashTable() { }
+    virtual ~HashTable() {
+        if (precomputed_hash_)
+            precomputed_hash_->discard(); // since it was never consumed
+    }
 
     const Schema & schema() const { return schema_; }
 
@@ -544,6 +564,14 @@ struct HashTable
     /** Clears the hash table. */
     virtual void clear() = 0;
 
+    /** Provides the hash \p hash of the key of the *next* call to `compute_bucket()`, `emplace()`, `try_emplace()`,
+     * `find()`, or `for_each_in_equal_range()` s.t. this key is not hashed again, e.g. since the hashes of the keys of
+     * all SIMD lanes were computed at once.  \p hash must equal the hash `murmur3_64a_hash()` computes for this key. */
+    void set_precomputed_hash(U64x1 hash) {
+        M_insist(not precomputed_hash_, "precomputed hash was not consumed");
+        precomputed_hash_.emplace(hash);
+    }
+
     /** Computes the bucket for key \p key.  Often used as hint for `find()` and `for_each_in_equal_range()`. */
     virtual Ptr<void> compute_bucket(std::vector<SQL_t> key) const = 0;
 
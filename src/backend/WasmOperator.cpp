@@ -3,10 +3,16 @@
 #include "backend/Interpreter.hpp"
 #include "backend/WasmAlgo.hpp"
 #include "backend/WasmMacro.hpp"
+#include <algorithm>
+#include <cmath>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
 #include <mutable/parse/AST.hpp>
+#include <mutable/storage/VisibilitySummary.hpp>
+#include <mutable/storage/ZoneMap.hpp>
 #include <mutable/util/fn.hpp>
 #include <numeric>
+#include <variant>
 
 
 using namespace m;
@@ -85,7 +91,7 @@ static void add_wasm_operator_args()
         /* short=       */ nullptr,
         /* long=        */ "--join-implementations",
         /* description= */ "a comma seperated list of physical join implementations to consider (`NestedLoops`, "
-                           "`SimpleHash`, or `SortMerge`)",
+                           "`SimpleHash`, `SortMerge`, or `IndexNestedLoops`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::join_implementations = option_configs::JoinImplementation(0UL);
             for (const auto &elem : impls) {
@@ -95,6 +101,8 @@ static void add_wasm_operator_args()
                     options::join_implementations |= option_configs::JoinImplementation::SIMPLE_HASH;
                 else if (strneq(elem.data(), "SortMerge", elem.size()))
                     options::join_implementations |= option_configs::JoinImplementation::SORT_MERGE;
+                else if (strneq(elem.data(), "IndexNestedLoops", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::INDEX_NESTED_LOOPS;
                 else
                     std::cerr << "warning: ignore invalid physical join implementation " << elem << std::endl;
             }
@@ -104,8 +112,8 @@ static void add_wasm_operator_args()
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--index-implementations",
-        /* description= */ "a comma separated list of index implementations to consider for index scans (`Array`, or"
-                           " `Rmi`)",
+        /* description= */ "a comma separated list of index implementations to consider for index scans (`Array`, "
+                           "`Rmi`, `Pgm`, or `Composite`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::index_implementations = option_configs::IndexImplementation(0UL);
             for (const auto &elem : impls) {
@@ -113,6 +121,10 @@ static void add_wasm_operator_args()
                     options::index_implementations |= option_configs::IndexImplementation::ARRAY;
                 else if (strneq(elem.data(), "Rmi", elem.size()))
                     options::index_implementations |= option_configs::IndexImplementation::RMI;
+                else if (strneq(elem.data(), "Pgm", elem.size()))
+                    options::index_implementations |= option_configs::IndexImplementation::PGM;
+                else if (strneq(elem.data(), "Composite", elem.size()))
+                    options::index_implementations |= option_configs::IndexImplementation::COMPOSITE;
                 else
                     std::cerr << "warning: ignore invalid index implementation " << elem << std::endl;
             }
@@ -461,6 +473,23 @@ static void add_wasm_operator_args()
                            "(0 means infinite), ignored in case of --isam-compile-qualifying",
         /* callback=    */ [](std::size_t size){ options::index_sequential_scan_batch_size = size; }
     );
+    C.arg_parser().add<double>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--index-scan-max-selectivity",
+        /* description= */ "set the fraction of visible rows qualifying for an index scan above which a sequential "
+                           "scan with a filter is used instead (1 means never, default 0.05), ignored in case of "
+                           "--index-scan-strategy=Compilation",
+        /* callback=    */ [](double selectivity){ options::index_scan_max_selectivity = selectivity; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--index-scan-sort-tuple-ids",
+        /* description= */ "sort the tuple IDs of index scans, such that rows are accessed in table order rather than "
+                           "in index order",
+        /* callback=    */ [](bool){ options::index_scan_sort_tuple_ids = true; }
+    );
     C.arg_parser().add<std::size_t>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -496,6 +525,30 @@ static void add_wasm_operator_args()
         /* description= */ "set the number of SIMD lanes to prefer",
         /* callback=    */ [](std::size_t lanes){ options::simd_lanes = lanes; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-simd-selection-vectors",
+        /* description= */ "disable consuming the selection vectors of SIMDfied pipelines lane-wise in hash-based "
+                           "grouping and hash join probes, which hash all lanes at once but access the hash table "
+                           "per lane",
+        /* callback=    */ [](bool){ options::simd_selection_vectors = false; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-zone-maps",
+        /* description= */ "disable skipping of blocks of rows using zone maps in scans",
+        /* callback=    */ [](bool){ options::zone_maps = false; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-visibility-summaries",
+        /* description= */ "disable skipping of blocks of rows of multi-versioned tables that are invisible to the "
+                           "transaction and of evaluating timestamp filters for blocks that are visible in scans",
+        /* callback=    */ [](bool){ options::visibility_summaries = false; }
+    );
     C.arg_parser().add<std::vector<std::string_view>>(
         /* group=       */ "Hacks",
         /* short=       */ nullptr,
@@ -556,6 +609,10 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
             phys_opt.register_operator<IndexScan<idx::IndexMethod::Array>>();
         if (bool(options::index_implementations bitand option_configs::IndexImplementation::RMI))
             phys_opt.register_operator<IndexScan<idx::IndexMethod::Rmi>>();
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::PGM))
+            phys_opt.register_operator<IndexScan<idx::IndexMethod::Pgm>>();
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::COMPOSITE))
+            phys_opt.register_operator<IndexScan<idx::IndexMethod::Composite>>();
     }
     if (bool(options::filter_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING))
         phys_opt.register_operator<Filter<false>>();
@@ -582,6 +639,14 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
         if (bool(options::nested_loops_join_selection_strategy bitand option_configs::SelectionStrategy::PREDICATED))
             phys_opt.register_operator<NestedLoopsJoin<true>>();
     }
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::INDEX_NESTED_LOOPS)) {
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::ARRAY))
+            phys_opt.register_operator<IndexNestedLoopsJoin<idx::IndexMethod::Array>>();
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::RMI))
+            phys_opt.register_operator<IndexNestedLoopsJoin<idx::IndexMethod::Rmi>>();
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::PGM))
+            phys_opt.register_operator<IndexNestedLoopsJoin<idx::IndexMethod::Pgm>>();
+    }
     if (bool(options::join_implementations bitand option_configs::JoinImplementation::SIMPLE_HASH)) {
         if (bool(options::simple_hash_join_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING)) {
             phys_opt.register_operator<SimpleHashJoin<false, false>>();
@@ -975,6 +1040,27 @@ Ptr<void> get_base_address(const ThreadSafePooledString &table_name) {
     return Module::Get().get_global<void*>(oss.str().c_str());
 }
 
+/** Returns the index of the window that table \p table_name is mapped into chunk by chunk. */
+U32x1 get_table_window(const ThreadSafePooledString &table_name) {
+    static std::ostringstream oss;
+    oss.str("");
+    oss << table_name << "_window";
+    return Module::Get().get_global<uint32_t>(oss.str().c_str());
+}
+
+/** Maps chunk \p chunk of table \p table into its window in the WebAssembly linear memory and returns the number of
+ * rows of the chunk, or 0 if \p chunk lies past the end of \p table. */
+U32x1 map_table_chunk(const Table &table, U32x1 chunk) {
+    return Module::Get().emit_call<uint32_t>("map_table_chunk", get_table_window(table.name()), chunk);
+}
+
+/** Returns `true` iff \p op is a `ScanOperator` whose table is mapped chunk by chunk, i.e. whose rows are not all
+ * accessible via the table's base address. */
+bool is_chunked_scan(const Operator &op) {
+    auto scan = cast<const ScanOperator>(&op);
+    return scan and WasmEngine::Is_Chunked(scan->store().table());
+}
+
 /** Computes the initial hash table capacity for \p op. The function ensures that the initial capacity is in the range
  * [0, 2^32 - 1] such that the capacity does *not* exceed the `uint32_t` value limit. */
 uint32_t compute_initial_ht_capacity(const Operator &op, double load_factor) {
@@ -992,6 +1078,78 @@ uint32_t compute_initial_ht_capacity(const Operator &op, double load_factor) {
     return std::in_range<uint32_t>(initial_capacity) ? initial_capacity : std::numeric_limits<uint32_t>::max();
 }
 
+/** Returns the `Dictionary` encoding the attribute designated by the grouping key \p key of the grouping \p op if the
+ * codes of this attribute are available in the environment of \p op, i.e. if \p key designates an attribute of a
+ * `ScanOperator` underneath only `FilterOperator`s and if no soft pipeline breaker materializes the strings in between.
+ * Returns `nullptr` otherwise. */
+const storage::Dictionary * scanned_dictionary(const GroupingOperator &op, const ast::Expr &key) {
+    constexpr auto BUFFERED = uint64_t(option_configs::SoftPipelineBreakerStrategy::AFTER_SCAN) bitor
+                              uint64_t(option_configs::SoftPipelineBreakerStrategy::AFTER_FILTER) bitor
+                              uint64_t(option_configs::SoftPipelineBreakerStrategy::AFTER_INDEX_SCAN);
+    if (uint64_t(options::soft_pipeline_breaker) bitand BUFFERED)
+        return nullptr;
+    if (not is<const ast::Designator>(key) or not key.type()->is_character_sequence())
+        return nullptr;
+
+    /*----- Descend through filters to the scan. -----*/
+    const Operator *child = op.child(0);
+    while (auto filter = cast<const FilterOperator>(child))
+        child = filter->child(0);
+    auto scan = cast<const ScanOperator>(child);
+    Schema::Identifier id(key);
+    if (not scan or id.prefix != scan->alias())
+        return nullptr;
+
+    /*----- Find the leaf of the designated attribute, whose index is the index of the attribute in the table. -----*/
+    const auto &table = scan->store().table();
+    const auto layout_schema = table.schema(scan->alias());
+    auto it = layout_schema.find(id);
+    if (it == layout_schema.cend())
+        return nullptr;
+    const std::size_t idx = std::distance(layout_schema.cbegin(), it);
+    const storage::Dictionary *dict = nullptr;
+    table.layout().for_sibling_leaves([&](const std::vector<storage::DataLayout::leaf_info_t> &leaves,
+                                          const storage::DataLayout::level_info_stack_t&, uint64_t)
+    {
+        for (auto &leaf_info : leaves) {
+            if (leaf_info.leaf.index() == idx and leaf_info.leaf.is_dictionary_encoded())
+                dict = &leaf_info.leaf.dictionary();
+        }
+    });
+    return dict;
+}
+
+/** Emits code to compute the hashes of the SIMD-hashable key \p key of type \p type for all SIMD lanes at once and to
+ * spill them to pre-allocated memory such that the hash of lane `i` is located at the `i`-th element.  Returns the raw
+ * pointer to this memory, or `nullptr` if \p key may be `NULL` and must therefore be hashed lane-wise. */
+void * precompute_simd_hashes(const Type *type, SQL_t key) {
+    M_insist(is_simd_hashable({ type }), "key cannot be hashed for all SIMD lanes at once");
+    void *hashes = nullptr;
+    std::visit(overloaded {
+        [&]<sql_type T>(T &k) -> void {
+            if (k.can_be_null()) {
+                k.discard();
+                return;
+            }
+            const auto num_simd_lanes = CodeGenContext::Get().num_simd_lanes();
+            hashes = Module::Allocator().raw_allocate(num_simd_lanes * sizeof(uint64_t), 16);
+            auto store_hashes = [&]<std::size_t L>() {
+                *Ptr<void>(hashes).template to<uint64_t*, L>() = murmur3_64a_hash<L>({ { type, std::move(k) } });
+            };
+            switch (num_simd_lanes) {
+                default: M_unreachable("invalid number of SIMD lanes");
+                case  2: store_hashes.template operator()<2>();  break;
+                case  4: store_hashes.template operator()<4>();  break;
+                case  8: store_hashes.template operator()<8>();  break;
+                case 16: store_hashes.template operator()<16>(); break;
+                case 32: store_hashes.template operator()<32>(); break;
+            }
+        },
+        [](std::monostate&) -> void { M_unreachable("invalid key"); },
+    }, key);
+    return hashes;
+}
+
 ///> helper struct holding the bounds for index scan
 struct index_scan_bounds_t
 {
@@ -1101,6 +1259,484 @@ index_scan_bounds_t extract_index_scan_bounds(const cnf::CNF &cnf)
     return bounds;
 }
 
+///> helper struct holding the bounds for an index scan on a composite key
+struct composite_index_scan_bounds_t
+{
+    const Database::index_entry_type *entry = nullptr; ///< the `idx::CompositeIndex` to scan
+    ///> the bounds of the equality predicates on the first key attributes, in key order
+    std::vector<std::reference_wrapper<const ast::Expr>> prefix;
+    std::optional<std::reference_wrapper<const ast::Expr>> lo, hi; ///< lo and hi bounds on the next key attribute
+    bool is_inclusive_lo = true, is_inclusive_hi = true; ///< flag to indicate if bounds are inclusive
+};
+
+/** Returns `true` iff the valid bound \p bound can be normalized like a value of an attribute of type \p type, see
+ * `idx::CompositeIndex::encode()`. */
+bool is_encodable_bound(const Type &type, const ast::Expr &bound)
+{
+    auto [constant, is_negative] = get_valid_bound(bound);
+    const bool is_integer = constant.tok.type == TK_OCT_INT or constant.tok.type == TK_DEC_INT or
+                            constant.tok.type == TK_HEX_INT;
+    return visit(overloaded {
+        [&](const Boolean&) {
+            return not is_negative and (constant.tok.type == TK_True or constant.tok.type == TK_False);
+        },
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int: {
+                    if (not is_integer) return false;
+                    if (n.size() == 64) return true;
+                    const int64_t i = int64_t(Interpreter::eval(constant));
+                    const int64_t max = (int64_t(1) << (n.size() - 1)) - 1;
+                    return is_negative ? i <= max + 1 : i <= max; // the value must fit into the attribute
+                }
+                case Numeric::N_Decimal:
+                    return false; // decimal constants are not scaled to the attribute
+                case Numeric::N_Float:
+                    return is_integer or constant.tok.type == TK_DEC_FLOAT;
+            }
+            M_unreachable("invalid numeric kind");
+        },
+        [&](const CharacterSequence &cs) {
+            if (is_negative or constant.tok.type != TK_STRING_LITERAL) return false;
+            auto str = reinterpret_cast<const char*>(Interpreter::eval(constant).as_p());
+            return strlen(str) <= cs.length; // longer strings would be truncated by the encoding
+        },
+        [&](const Date&) { return not is_negative and constant.tok.type == TK_DATE; },
+        [&](const DateTime&) { return not is_negative and constant.tok.type == TK_DATE_TIME; },
+        [](auto&&) { return false; },
+    }, type);
+}
+
+/** Appends the normalized encoding of the valid bound \p bound of an attribute of type \p type to \p key.  The bound
+ * must be encodable, see `is_encodable_bound()`.  Bounds of `float` attributes are rounded to `float`, although the
+ * attribute may be compared to the bound as `double`.  Returns the sign of the difference of the encoded value and the
+ * bound in the type of the comparison, i.e. 0 iff the bound is encoded exactly. */
+int encode_bound(std::string &key, const Type &type, const ast::Expr &bound)
+{
+    M_insist(is_encodable_bound(type, bound), "bound must be encodable");
+    auto [constant, is_negative] = get_valid_bound(bound);
+    auto c = Interpreter::eval(constant);
+    int rounding = 0;
+    if (auto n = cast<const Numeric>(&type)) {
+        if (n->kind == Numeric::N_Float) {
+            double d = constant.tok.type == TK_DEC_FLOAT ? double(c) : double(int64_t(c));
+            d = is_negative ? -d : d;
+            if (n->size() == 32) {
+                const float f = d;
+                if (arithmetic_join(n, as<const Numeric>(constant.type()))->size() == 64) // compared as `double`
+                    rounding = (double(f) > d) - (double(f) < d);
+                c = Value(f);
+            } else {
+                c = Value(d);
+            }
+        } else if (is_negative) {
+            c = Value(int64_t(0ULL - uint64_t(int64_t(c)))); // avoids overflow when negating the minimum
+        }
+    }
+    idx::CompositeIndex::encode(key, type, c);
+    return rounding;
+}
+
+/** Finds a valid `idx::CompositeIndex` on \p table that evaluates the filter condition \p cnf and extracts the bounds
+ * for scanning it.  Every clause of \p cnf must consist of a single comparison of an attribute to a valid bound.  The
+ * attributes compared for equality must form a prefix of the key attributes of the index.  Besides, at most the next
+ * key attribute may be compared with at most one lower and at most one upper bound.  Returns `std::nullopt` if no such
+ * index exists. */
+std::optional<composite_index_scan_bounds_t> find_composite_index_scan(const cnf::CNF &cnf, const Table &table)
+{
+    /*----- Collect the bounds of each attribute. -----*/
+    struct attribute_bounds_t
+    {
+        const ast::Expr *eq = nullptr, *lo = nullptr, *hi = nullptr;
+        bool is_inclusive_lo = true, is_inclusive_hi = true;
+    };
+    std::unordered_map<ThreadSafePooledString, attribute_bounds_t> bounds;
+    for (auto &clause : cnf) {
+        if (clause.size() != 1) // disjunctions not supported
+            return std::nullopt;
+        auto &predicate = clause[0];
+        if (predicate.negative()) // negated predicates not supported
+            return std::nullopt;
+        auto binary = cast<const BinaryExpr>(&predicate.expr());
+        if (not binary) // not a binary expression
+            return std::nullopt;
+
+        const bool has_attribute_left = is<const Designator>(binary->lhs);
+        auto designator = cast<const Designator>(has_attribute_left ? binary->lhs.get() : binary->rhs.get());
+        auto &bound = has_attribute_left ? *binary->rhs : *binary->lhs;
+        if (not designator or not is_valid_bound(bound))
+            return std::nullopt;
+        if (not table.has_attribute(designator->attr_name.text.assert_not_none()) or
+            not is_encodable_bound(*table.at(designator->attr_name.text.assert_not_none()).type, bound))
+            return std::nullopt;
+
+        auto &b = bounds[designator->attr_name.text.assert_not_none()];
+        auto set = [&](const ast::Expr *&target, bool *is_inclusive, bool inclusive) {
+            if (b.eq or target) return false; // bound already set
+            target = &bound;
+            if (is_inclusive) *is_inclusive = inclusive;
+            return true;
+        };
+        bool is_set;
+        switch (binary->tok.type) {
+            default:
+                return std::nullopt;
+            case TK_EQUAL:
+                is_set = not b.lo and not b.hi and set(b.eq, nullptr, true);
+                break;
+            case TK_GREATER:
+            case TK_GREATER_EQUAL: {
+                const bool inclusive = binary->tok.type == TK_GREATER_EQUAL;
+                is_set = has_attribute_left ? set(b.lo, &b.is_inclusive_lo, inclusive)
+                                            : set(b.hi, &b.is_inclusive_hi, inclusive);
+                break;
+            }
+            case TK_LESS:
+            case TK_LESS_EQUAL: {
+                const bool inclusive = binary->tok.type == TK_LESS_EQUAL;
+                is_set = has_attribute_left ? set(b.hi, &b.is_inclusive_hi, inclusive)
+                                            : set(b.lo, &b.is_inclusive_lo, inclusive);
+                break;
+            }
+        }
+        if (not is_set)
+            return std::nullopt;
+    }
+    if (bounds.empty())
+        return std::nullopt;
+
+    /*----- Find an index whose key attributes start with the attributes compared for equality. -----*/
+    auto &DB = Catalog::Get().get_database_in_use();
+    for (auto it = DB.begin_indexes(); it != DB.end_indexes(); ++it) {
+        auto &entry = *it;
+        if (not entry.is_valid() or entry.table.name() != table.name() or
+            entry.index->method() != idx::IndexMethod::Composite)
+            continue;
+
+        composite_index_scan_bounds_t result;
+        result.entry = &entry;
+        std::size_t num_attributes = 0; // the number of key attributes with bounds
+        for (auto &attribute : entry.attributes) {
+            auto b = bounds.find(attribute.get().name);
+            if (b == bounds.end())
+                break;
+            ++num_attributes;
+            if (b->second.eq) {
+                result.prefix.emplace_back(*b->second.eq);
+                continue;
+            }
+            if (b->second.lo) {
+                result.lo = std::cref(*b->second.lo);
+                result.is_inclusive_lo = b->second.is_inclusive_lo;
+            }
+            if (b->second.hi) {
+                result.hi = std::cref(*b->second.hi);
+                result.is_inclusive_hi = b->second.is_inclusive_hi;
+            }
+            break; // a range predicate ends the prefix
+        }
+        if (num_attributes == bounds.size()) // all predicates are evaluated by the index
+            return result;
+    }
+    return std::nullopt;
+}
+
+/** The maximum number of row ranges a scan iterates over when skipping blocks using a zone map or a visibility summary.
+ * Ranges are selected at runtime by a chain of comparisons, hence their number is bounded. */
+constexpr std::size_t MAX_NUM_SCAN_RANGES = 64;
+
+/** Converts predicate \p pred into a comparison that a `ZoneMap` of table \p table can decide.  The predicate must
+ * compare a tracked attribute of \p table to a valid bound of matching type.  Returns the attribute ID, the comparison
+ * operator, and the bound on success, and `std::nullopt` otherwise. */
+std::optional<std::tuple<std::size_t, ZoneMap::cmp_op, std::variant<int64_t, double>>>
+get_zone_map_predicate(const cnf::Predicate &pred, const Table &table, const ZoneMap &zone_map)
+{
+    if (pred.negative()) return std::nullopt;
+    auto binary = cast<const BinaryExpr>(&pred.expr());
+    if (not binary) return std::nullopt;
+
+    /*----- Normalize the predicate to `designator op bound`. -----*/
+    const bool has_attribute_left = is<const Designator>(binary->lhs) and is_valid_bound(*binary->rhs);
+    if (not has_attribute_left and not (is<const Designator>(binary->rhs) and is_valid_bound(*binary->lhs)))
+        return std::nullopt;
+    auto &designator = as<const Designator>(has_attribute_left ? *binary->lhs : *binary->rhs);
+    auto [constant, is_negative] = get_valid_bound(has_attribute_left ? *binary->rhs : *binary->lhs);
+
+    ZoneMap::cmp_op op;
+    switch (binary->tok.type) {
+        default:                return std::nullopt;
+        case TK_EQUAL:          op = ZoneMap::EQ; break;
+        case TK_LESS:           op = has_attribute_left ? ZoneMap::LT : ZoneMap::GT; break;
+        case TK_LESS_EQUAL:     op = has_attribute_left ? ZoneMap::LE : ZoneMap::GE; break;
+        case TK_GREATER:        op = has_attribute_left ? ZoneMap::GT : ZoneMap::LT; break;
+        case TK_GREATER_EQUAL:  op = has_attribute_left ? ZoneMap::GE : ZoneMap::LE; break;
+    }
+
+    /*----- The designator must refer to a tracked attribute of `table`. -----*/
+    auto attr = std::get_if<const Attribute*>(&designator.target());
+    if (not attr or &(*attr)->table != &table or not zone_map.is_tracked((*attr)->id))
+        return std::nullopt;
+    const std::size_t id = (*attr)->id;
+    auto &type = *(*attr)->type;
+
+    /*----- The bound must be of the type the attribute is compared with. -----*/
+    if (type.is_double() and (constant.is_integer() or constant.is_float()) and constant.tok.type != TK_HEX_FLOAT) {
+        auto value = Interpreter::eval(constant);
+        const double d = constant.is_float() ? value.as_d() : double(value.as_i());
+        return std::make_tuple(id, op, std::variant<int64_t, double>(is_negative ? -d : d));
+    }
+    if (type.is_integral() and constant.is_integer() and not constant.is_float()) {
+        const int64_t i = Interpreter::eval(constant).as_i();
+        if (is_negative and i == std::numeric_limits<int64_t>::min()) return std::nullopt;
+        return std::make_tuple(id, op, std::variant<int64_t, double>(is_negative ? -i : i));
+    }
+    if (not is_negative and ((type.is_date() and constant.is_date()) or
+                             (type.is_date_time() and constant.is_datetime())))
+        return std::make_tuple(id, op, std::variant<int64_t, double>(Interpreter::eval(constant).as_i()));
+    return std::nullopt;
+}
+
+/** Converts predicate \p pred into a comparison of a timestamp attribute of the multi-versioned table \p table, i.e. of
+ * `$ts_begin` or `$ts_end`, to an integral constant, that a `VisibilitySummary` can decide.  Returns whether the
+ * attribute is `$ts_begin`, the comparison operator, the constant, and whether the comparison is negated on success,
+ * and `std::nullopt` otherwise. */
+std::optional<std::tuple<bool, ZoneMap::cmp_op, int64_t, bool>>
+get_visibility_predicate(const cnf::Predicate &pred, const Table &table)
+{
+    auto binary = cast<const BinaryExpr>(&pred.expr());
+    if (not binary) return std::nullopt;
+
+    /*----- Normalize the predicate to `designator op constant`. -----*/
+    const bool has_attribute_left = is<const Designator>(binary->lhs) and is_valid_bound(*binary->rhs);
+    if (not has_attribute_left and not (is<const Designator>(binary->rhs) and is_valid_bound(*binary->lhs)))
+        return std::nullopt;
+    auto &designator = as<const Designator>(has_attribute_left ? *binary->lhs : *binary->rhs);
+    auto [constant, is_negative] = get_valid_bound(has_attribute_left ? *binary->rhs : *binary->lhs);
+
+    ZoneMap::cmp_op op;
+    bool is_negated = pred.negative();
+    switch (binary->tok.type) {
+        default:                return std::nullopt;
+        case TK_EQUAL:          op = ZoneMap::EQ; break;
+        case TK_BANG_EQUAL:     op = ZoneMap::EQ; is_negated = not is_negated; break;
+        case TK_LESS:           op = has_attribute_left ? ZoneMap::LT : ZoneMap::GT; break;
+        case TK_LESS_EQUAL:     op = has_attribute_left ? ZoneMap::LE : ZoneMap::GE; break;
+        case TK_GREATER:        op = has_attribute_left ? ZoneMap::GT : ZoneMap::LT; break;
+        case TK_GREATER_EQUAL:  op = has_attribute_left ? ZoneMap::GE : ZoneMap::LE; break;
+    }
+
+    /*----- The designator must refer to a timestamp attribute of `table`. -----*/
+    Catalog &C = Catalog::Get();
+    auto attr = std::get_if<const Attribute*>(&designator.target());
+    if (not attr or (*attr)->table.name() != table.name())
+        return std::nullopt;
+    const bool is_ts_begin = (*attr)->name == C.pool("$ts_begin");
+    if (not is_ts_begin and (*attr)->name != C.pool("$ts_end"))
+        return std::nullopt;
+
+    /*----- The constant must be an integer. -----*/
+    if (not constant.is_integer() or constant.is_float())
+        return std::nullopt;
+    const int64_t i = Interpreter::eval(constant).as_i();
+    if (is_negative and i == std::numeric_limits<int64_t>::min()) return std::nullopt;
+    return std::make_tuple(is_ts_begin, op, is_negative ? -i : i, is_negated);
+}
+
+/** Returns the predicates of clause \p clause if it is a *timestamp clause* of the multi-versioned table \p table, i.e.
+ * if it consists of predicates a `VisibilitySummary` can decide only, and `std::nullopt` otherwise. */
+std::optional<std::vector<std::tuple<bool, ZoneMap::cmp_op, int64_t, bool>>>
+get_timestamp_clause(const cnf::Clause &clause, const Table &table)
+{
+    std::vector<std::tuple<bool, ZoneMap::cmp_op, int64_t, bool>> predicates;
+    for (auto &pred : clause) {
+        if (auto p = get_visibility_predicate(pred, table))
+            predicates.push_back(std::move(*p));
+        else
+            return std::nullopt;
+    }
+    return predicates;
+}
+
+/** A range of rows to scan, given by its first and its past-the-end row ID. */
+struct scan_range
+{
+    std::size_t begin;
+    std::size_t end;
+    ///> whether all rows of the range are visible to the transaction of the scan, i.e. satisfy the timestamp clauses
+    bool is_visible;
+};
+
+/** Returns the ranges of rows of the table scanned by \p scan that may satisfy the filter directly above \p scan.
+ * Skipped are the blocks that the zone map of the scanned store proves to not qualify and the blocks that the
+ * visibility summary of the scanned store proves to contain no row satisfying the timestamp clauses of the filter.
+ * Each range begins at a block boundary.  Returns `std::nullopt` if there is no such filter or if neither the zone map
+ * nor the visibility summary can be used. */
+std::optional<std::vector<scan_range>> compute_scan_ranges(const ScanOperator &scan)
+{
+    auto filter = cast<const FilterOperator>(scan.parent());
+    auto &store = scan.store();
+    if (not filter or WasmEngine::Is_Chunked(store.table()) or store.num_rows() == 0)
+        return std::nullopt;
+
+    /*----- Collect the clauses the zone map can decide, i.e. those consisting of decidable predicates only. -----*/
+    auto &zone_map = store.zone_map();
+    using predicate_t = std::tuple<std::size_t, ZoneMap::cmp_op, std::variant<int64_t, double>>;
+    std::vector<std::vector<predicate_t>> clauses;
+    if (options::zone_maps and zone_map.covers(store.num_rows())) {
+        for (auto &clause : filter->filter()) {
+            std::vector<predicate_t> predicates;
+            for (auto &pred : clause) {
+                if (auto p = get_zone_map_predicate(pred, store.table(), zone_map))
+                    predicates.push_back(std::move(*p));
+                else
+                    break;
+            }
+            if (predicates.size() == clause.size())
+                clauses.push_back(std::move(predicates));
+        }
+    }
+
+    /*----- Collect the timestamp clauses, which the visibility summary can decide. -----*/
+    using timestamp_predicate_t = std::tuple<bool, ZoneMap::cmp_op, int64_t, bool>;
+    std::vector<std::vector<timestamp_predicate_t>> timestamp_clauses;
+    if (options::visibility_summaries) {
+        for (auto &clause : filter->filter()) {
+            if (auto predicates = get_timestamp_clause(clause, store.table()))
+                timestamp_clauses.push_back(std::move(*predicates));
+        }
+    }
+
+    if (clauses.empty() and timestamp_clauses.empty())
+        return std::nullopt;
+
+    /*----- Determine the blocks that may contain qualifying rows and merge adjacent ones into ranges. -----*/
+    auto may_satisfy = [&](std::size_t block, const predicate_t &p) {
+        return std::visit([&](auto value) { return zone_map.may_satisfy(block, std::get<0>(p), std::get<1>(p), value); },
+                          std::get<2>(p));
+    };
+    /* Returns whether the timestamp clause `predicates` holds for the rows summarized by `summary`. */
+    auto decide = [](const VisibilitySummary::entry_type &summary,
+                     const std::vector<timestamp_predicate_t> &predicates)
+    {
+        bool is_never = true;
+        for (auto &[is_ts_begin, op, value, is_negated] : predicates) {
+            auto truth = summary.decide(is_ts_begin, op, value);
+            if (is_negated and truth != VisibilitySummary::SOMETIMES)
+                truth = truth == VisibilitySummary::ALWAYS ? VisibilitySummary::NEVER : VisibilitySummary::ALWAYS;
+            if (truth == VisibilitySummary::ALWAYS)
+                return VisibilitySummary::ALWAYS;
+            is_never = is_never and truth == VisibilitySummary::NEVER;
+        }
+        return is_never ? VisibilitySummary::NEVER : VisibilitySummary::SOMETIMES;
+    };
+    std::vector<scan_range> ranges;
+    const std::size_t num_blocks = (store.num_rows() + ZoneMap::NUM_ROWS_PER_BLOCK - 1) / ZoneMap::NUM_ROWS_PER_BLOCK;
+    for (std::size_t block = 0; block != num_blocks; ++block) {
+        const bool qualifies = std::all_of(clauses.cbegin(), clauses.cend(), [&](const auto &predicates) {
+            return std::any_of(predicates.cbegin(), predicates.cend(), [&](auto &p) { return may_satisfy(block, p); });
+        });
+        if (not qualifies) continue;
+
+        bool is_visible = false;
+        if (not timestamp_clauses.empty()) {
+            const auto summary = summarize_visibility(store.table(), block);
+            bool is_dead = false;
+            is_visible = true;
+            for (auto &predicates : timestamp_clauses) {
+                const auto truth = decide(summary, predicates);
+                is_dead = is_dead or truth == VisibilitySummary::NEVER;
+                is_visible = is_visible and truth == VisibilitySummary::ALWAYS;
+            }
+            if (is_dead) continue;
+        }
+
+        const std::size_t begin = block * ZoneMap::NUM_ROWS_PER_BLOCK;
+        const std::size_t end = std::min(begin + ZoneMap::NUM_ROWS_PER_BLOCK, store.num_rows());
+        if (not ranges.empty() and ranges.back().end == begin and ranges.back().is_visible == is_visible)
+            ranges.back().end = end;
+        else
+            ranges.push_back({ begin, end, is_visible });
+    }
+
+    /*----- Bound the number of ranges by repeatedly merging the two ranges with the smallest gap in between.  A merged
+     * range may contain skipped blocks, hence its rows are not proven visible. -----*/
+    while (ranges.size() > MAX_NUM_SCAN_RANGES) {
+        std::size_t min_idx = 0;
+        for (std::size_t idx = 1; idx != ranges.size() - 1; ++idx) {
+            if (ranges[idx + 1].begin - ranges[idx].end < ranges[min_idx + 1].begin - ranges[min_idx].end)
+                min_idx = idx;
+        }
+        ranges[min_idx].end = ranges[min_idx + 1].end;
+        ranges[min_idx].is_visible = false;
+        ranges.erase(ranges.begin() + min_idx + 1);
+    }
+
+    return ranges;
+}
+
+
+/*======================================================================================================================
+ * MatchBase
+ *====================================================================================================================*/
+
+void m::wasm::MatchBase::execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const
+{
+    auto &feedback = WasmEngine::Get_Wasm_Context_By_ID(Module::ID()).feedback;
+    if (not feedback.is_enabled or not pipeline) {
+        execute_operator(std::move(setup), std::move(pipeline), std::move(teardown));
+        return;
+    }
+
+    /*----- Time each pipeline from its outermost setup to its outermost teardown. -----*/
+    setup_t feedback_setup(std::move(setup), [&feedback](){
+        if (feedback.depth++ == 0) {
+            feedback.pipeline = feedback.pipeline_times.size();
+            feedback.pipeline_times.emplace_back(0);
+            Module::Get().emit_call<void>("enter_pipeline", U32x1(uint32_t(feedback.pipeline)));
+        }
+    });
+    teardown_t feedback_teardown(std::move(teardown), [&feedback](){
+        if (feedback.depth != 0 and --feedback.depth == 0)
+            Module::Get().emit_call<void>("leave_pipeline", U32x1(uint32_t(feedback.pipeline)));
+    });
+
+    /*----- Count the tuples produced into each pipeline, i.e. the qualifying ones if predicated. -----*/
+    const Operator &op = get_matched_root();
+    pipeline_t feedback_pipeline = [&feedback, &op, pipeline=std::move(pipeline)](){
+        auto it = std::find_if(feedback.counters.begin(), feedback.counters.end(), [&](const auto &counter) {
+            return &counter.op.get() == &op and counter.pipeline == feedback.pipeline;
+        });
+        if (it == feedback.counters.end()) {
+            uint64_t *num_tuples = Module::Allocator().raw_malloc<uint64_t>();
+            *num_tuples = 0;
+            feedback.counters.push_back({ std::cref(op), feedback.pipeline, num_tuples });
+            it = std::prev(feedback.counters.end());
+        }
+
+        if (auto &env = CodeGenContext::Get().env(); env.predicated()) {
+            switch (CodeGenContext::Get().num_simd_lanes()) {
+                default: M_unreachable("invalid number of simd lanes");
+                case  1: {
+                    *Ptr<U64x1>(it->num_tuples) +=
+                        env.get_predicate<_Boolx1>().is_true_and_not_null().to<uint64_t>();
+                    break;
+                }
+                case 16: {
+                    auto pred = env.get_predicate<_Boolx16>().is_true_and_not_null();
+                    *Ptr<U64x1>(it->num_tuples) += pred.bitmask().popcnt().to<uint64_t>();
+                    break;
+                }
+            }
+        } else {
+            *Ptr<U64x1>(it->num_tuples) += U64x1(uint64_t(CodeGenContext::Get().num_simd_lanes()));
+        }
+
+        pipeline();
+    };
+
+    execute_operator(std::move(feedback_setup), std::move(feedback_pipeline), std::move(feedback_teardown));
+}
+
 
 /*======================================================================================================================
  * NoOp
@@ -1208,6 +1844,22 @@ void Print<SIMDfied>::execute(const Match<Print> &M, setup_t, pipeline_t, teardo
  * Scan
  *====================================================================================================================*/
 
+template<bool SIMDfied>
+double Scan<SIMDfied>::cost(const Match<Scan> &M)
+{
+    double cost = M_CONSTEXPR_COND(SIMDfied, 1.0, 2.0);
+
+    /*----- Scale the cost by the fraction of rows to scan after skipping blocks. -----*/
+    if (auto ranges = compute_scan_ranges(M.scan)) {
+        std::size_t num_rows_to_scan = 0;
+        for (auto &range : *ranges)
+            num_rows_to_scan += range.end - range.begin;
+        cost *= double(num_rows_to_scan) / M.scan.store().num_rows();
+    }
+
+    return cost;
+}
+
 template<bool SIMDfied>
 ConditionSet Scan<SIMDfied>::pre_condition(std::size_t child_idx,
                                            const std::tuple<const ScanOperator*> &partial_inner_nodes)
@@ -1288,16 +1940,32 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
                  : 1;
     CodeGenContext::Get().set_num_simd_lanes(num_simd_lanes);
 
-    /*----- Import the number of rows of `table`. -----*/
-    U32x1 num_rows = get_num_rows(table.name());
+    /*----- Helper to emit \p scan_chunk for the rows of `table`.  A table exceeding its window in linear memory is
+     * mapped chunk by chunk, each chunk starting at tuple ID 0 of the window. -----*/
+    auto for_each_chunk = [&](auto &&scan_chunk) {
+        if (not WasmEngine::Is_Chunked(table)) {
+            scan_chunk(get_num_rows(table.name())); // import the number of rows of `table`
+            return;
+        }
+        Var<U32x1> chunk; // default initialized to 0
+        Var<U32x1> num_rows(map_table_chunk(table, chunk.val()));
+        WHILE (num_rows != 0U) {
+            tuple_id = 0U;
+            scan_chunk(num_rows.val());
+            chunk += 1U;
+            num_rows = map_table_chunk(table, chunk.val());
+        }
+    };
 
     /*----- If no attributes must be loaded, generate a loop just executing the pipeline `num_rows`-times. -----*/
     if (schema.num_entries() == 0) {
         setup();
-        WHILE (tuple_id < num_rows) {
-            tuple_id += uint32_t(num_simd_lanes);
-            pipeline();
-        }
+        for_each_chunk([&](U32x1 num_rows) {
+            WHILE (tuple_id < num_rows) {
+                tuple_id += uint32_t(num_simd_lanes);
+                pipeline();
+            }
+        });
         teardown();
         return;
     }
@@ -1314,11 +1982,43 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
                                                          num_simd_lanes, layout_schema, tuple_id);
 
     /*----- Generate the loop for the actual scan, with the pipeline emitted into the loop body. -----*/
-    inits.attach_to_current();
-    WHILE (tuple_id < num_rows) {
-        loads.attach_to_current();
-        pipeline();
-        jumps.attach_to_current();
+    if (auto ranges = compute_scan_ranges(M.scan)) {
+        /*----- Skip the blocks proven to not qualify, i.e. only scan the rows of `ranges`. -----*/
+        Var<U32x1> range_idx; // default initialized to 0
+        Var<U32x1> range_end;
+        /* Whether the rows of the current range are visible, such that the filter above may omit timestamp clauses. */
+        std::optional<Var<Boolx1>> is_visible_range;
+        if (std::any_of(ranges->cbegin(), ranges->cend(), [](auto &range) { return range.is_visible; }))
+            is_visible_range.emplace(false);
+        WHILE (range_idx < uint32_t(ranges->size())) {
+            for (std::size_t idx = 0; idx != ranges->size(); ++idx) {
+                IF (range_idx == uint32_t(idx)) {
+                    tuple_id = uint32_t((*ranges)[idx].begin);
+                    range_end = uint32_t((*ranges)[idx].end);
+                    if (is_visible_range)
+                        *is_visible_range = (*ranges)[idx].is_visible;
+                };
+            }
+            inits.attach_to_current(); // compute the pointers for the first row of the range
+            if (is_visible_range)
+                CodeGenContext::Get().set_visible_rows(&table, &*is_visible_range);
+            WHILE (tuple_id < range_end) {
+                loads.attach_to_current();
+                pipeline();
+                jumps.attach_to_current();
+            }
+            CodeGenContext::Get().set_visible_rows(nullptr, nullptr);
+            range_idx += 1U;
+        }
+    } else {
+        for_each_chunk([&](U32x1 num_rows) {
+            inits.attach_to_current();
+            WHILE (tuple_id < num_rows) {
+                loads.attach_to_current();
+                pipeline();
+                jumps.attach_to_current();
+            }
+        });
     }
 
     /*----- Emit teardown code. -----*/
@@ -1329,6 +2029,53 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
  * Index Scan
  *====================================================================================================================*/
 
+/** Returns `true` iff an index scan may produce its rows in another order than the one of the index, i.e. if the number
+ * of qualifying rows is known at query compilation, as indicated by \p is_range_interpreted, and the index scan may be
+ * replaced by a sequential scan, or if the tuple IDs are materialized, as indicated by \p is_materialized, and
+ * sorted. */
+bool index_scan_may_reorder(bool is_range_interpreted, bool is_materialized)
+{
+    return (is_range_interpreted and options::index_scan_max_selectivity < 1.0) or
+           (is_materialized and options::index_scan_sort_tuple_ids);
+}
+
+/** Returns the number of rows of the table scanned by \p scan that are visible to the scan, i.e. the number of rows a
+ * sequential scan reads after skipping the blocks that the zone map or the visibility summary prove to not qualify. */
+std::size_t get_num_visible_rows(const ScanOperator &scan)
+{
+    if (auto ranges = compute_scan_ranges(scan)) {
+        std::size_t num_rows = 0;
+        for (auto &range : *ranges)
+            num_rows += range.end - range.begin;
+        return num_rows;
+    }
+    return scan.store().num_rows();
+}
+
+/** Returns `true` iff \p num_results qualifying rows of the table scanned by \p scan exceed the fraction of visible
+ * rows given by `options::index_scan_max_selectivity`.  Loading that many rows by their tuple ID is then more expensive
+ * than scanning the table sequentially. */
+bool index_scan_exceeds_max_selectivity(std::size_t num_results, const ScanOperator &scan)
+{
+    if (options::index_scan_max_selectivity >= 1.0) return false; // never replace index scans, avoid computing ranges
+    return double(num_results) > options::index_scan_max_selectivity * double(get_num_visible_rows(scan));
+}
+
+/** Emits code for a sequential scan of the table scanned by \p M followed by a filter on the condition of \p M,
+ * i.e. the code of the plan the index scan replaced. */
+template<idx::IndexMethod IndexMethod>
+void index_scan_codegen_sequential(const Match<IndexScan<IndexMethod>> &M,
+                                   setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    std::vector<unsharable_shared_ptr<const m::MatchBase>> children;
+    children.push_back(make_unsharable_shared<const Match<Scan<false>>>(
+        &M.scan, std::vector<unsharable_shared_ptr<const m::MatchBase>>()
+    ));
+    const Match<Filter<false>> filter(&M.filter, std::move(children));
+    /* Execute the operator only, since the index scan already counts the tuples produced by the filter. */
+    filter.execute_operator(std::move(setup), std::move(pipeline), std::move(teardown));
+}
+
 template<idx::IndexMethod IndexMethod>
 ConditionSet IndexScan<IndexMethod>::pre_condition(std::size_t child_idx,
                                                    const std::tuple<const FilterOperator*,
@@ -1345,6 +2092,10 @@ ConditionSet IndexScan<IndexMethod>::pre_condition(std::size_t child_idx,
     auto &scan = *std::get<1>(partial_inner_nodes);
     auto &table = scan.store().table();
 
+    /*----- Index scan accesses rows by their absolute tuple ID, hence the table must not be mapped chunk by chunk. --*/
+    if (WasmEngine::Is_Chunked(table))
+        return ConditionSet::Make_Unsatisfiable();
+
     Catalog &C = Catalog::Get();
     auto &DB = C.get_database_in_use();
 
@@ -1441,7 +2192,11 @@ ConditionSet IndexScan<IndexMethod>::post_condition(const Match<IndexScan<IndexM
     /*----- Non-SIMDfied index scan does not introduce SIMD. -----*/
     post_cond.add_condition(NoSIMD());
 
-    /*----- Index scan introduces sortedness on indexed attribute. -----*/
+    /*----- Index scan introduces sortedness on indexed attribute unless it may adapt to the qualifying rows. -----*/
+    if (index_scan_may_reorder(options::index_scan_strategy != option_configs::IndexScanStrategy::COMPILATION,
+                               options::index_scan_strategy == option_configs::IndexScanStrategy::INTERPRETATION))
+        return post_cond;
+
     /* Extract identifier from cnf. */
     auto &cnf = M.filter.filter();
     Schema designators = cnf.get_required();
@@ -1493,7 +2248,7 @@ void index_scan_codegen_compilation(const Index &index, const index_scan_bounds_
         } else if constexpr(std::same_as<sql_type, _Doublex1>) { \
             SET_CALLBACK_FNS(INDEX, d); \
         } else if constexpr(std::same_as<sql_type, NChar>) { \
-            SET_CALLBACK_FNS(IDNEX, p); \
+            SET_CALLBACK_FNS(INDEX, p); \
         } else { \
             M_unreachable("incompatible SQL type"); \
         }
@@ -1501,6 +2256,8 @@ void index_scan_codegen_compilation(const Index &index, const index_scan_bounds_
             RESOLVE_KEYTYPE(array)
         } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
             RESOLVE_KEYTYPE(rmi)
+        } else if constexpr(is_specialization<Index, idx::PiecewiseGeometricModelIndex>) {
+            RESOLVE_KEYTYPE(pgm)
         } else {
             M_unreachable("unknown index type");
         }
@@ -1588,61 +2345,30 @@ void index_scan_codegen_compilation(const Index &index, const index_scan_bounds_
     }
 }
 
-template<idx::IndexMethod IndexMethod, typename Index>
-void index_scan_codegen_interpretation(const Index &index, const index_scan_bounds_t &bounds,
-                                       const Match<IndexScan<IndexMethod>> &M,
-                                       setup_t setup, pipeline_t pipeline, teardown_t teardown)
+/** Emits code to load the rows with the tuple IDs of the index entries in [\p first, \p last) from the table scanned
+ * by \p M and to execute the pipeline on them.  The tuple IDs are materialized at query compilation time as selected
+ * by `options::index_scan_materialization_strategy`, and sorted if `options::index_scan_sort_tuple_ids` is set. */
+template<typename It, typename MatchT>
+void index_scan_codegen_materialized(It first, It last, const MatchT &M,
+                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
 {
-    using key_type = Index::key_type;
-
     static Schema empty_schema;
 
-    /*----- Interpret lo and hi bounds to retrieve index scan range -----*/
-    auto interpret_and_lookup_bound = [&](const ast::Expr &bound, bool is_lower_bound) -> std::size_t {
-        auto [constant, is_negative] = get_valid_bound(bound);
-        auto c = Interpreter::eval(constant);
-        key_type key;
-        if constexpr(m::boolean<key_type>) {
-            key = bool(c);
-            M_insist(not is_negative, "boolean cannot be negative");
-        } else if constexpr(m::integral<key_type>) {
-            auto i64 = int64_t(c);
-            M_insist(std::in_range<key_type>(i64), "integeral constant must be in range");
-            key = key_type(i64);
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<float, key_type>) {
-            auto d = double(c);
-            key = key_type(d);
-            M_insist(key == d, "downcasting should not impact precision");
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<double, key_type>) {
-            key = double(c);
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<const char*, key_type>) {
-            key = reinterpret_cast<const char*>(c.as_p());
-            M_insist(not is_negative, "string cannot be negative");
-        }
-        return std::distance(index.begin(), is_lower_bound ? index.lower_bound(key)
-                                                           : index.upper_bound(key));
-    };
-    std::size_t lo = bool(bounds.lo) ? interpret_and_lookup_bound(bounds.lo->get(), bounds.is_inclusive_lo)
-                                     : 0UL;
-    std::size_t hi = bool(bounds.hi) ? interpret_and_lookup_bound(bounds.hi->get(), not bounds.is_inclusive_hi)
-                                     : index.num_entries();
-    M_insist(lo <= hi, "bounds need to be valid");
-
     if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::MEMORY) {
         /*----- Allocate sufficient memory for results. -----*/
-        uint32_t num_results = hi - lo;
+        M_insist(std::in_range<uint32_t>(std::distance(first, last)), "number of results must fit in uint32_t");
+        uint32_t num_results = std::distance(first, last);
         uint32_t *buffer_address = Module::Allocator().raw_malloc<uint32_t>(num_results);
 
         /*----- Perform index scan and fill memory with results. -----*/
         uint32_t *buffer_ptr = buffer_address;
-        for (auto it = index.begin() + lo; it != index.begin() + hi; ++it) {
+        for (auto it = first; it != last; ++it) {
             M_insist(std::in_range<uint32_t>(it->second), "tuple id must fit in uint32_t");
             *buffer_ptr = it->second;
             ++buffer_ptr;
         }
+        if (options::index_scan_sort_tuple_ids)
+            std::sort(buffer_address, buffer_ptr); // access rows in the order of the table
 
         /*----- Emit setup code *after* allocating memory to guarantee sequential memory allocation for pipeline. -----*/
         setup();
@@ -1692,22 +2418,80 @@ void index_scan_codegen_interpretation(const Index &index, const index_scan_boun
         }
 
         /*----- Perform index sequential scan, emit code to execute pipeline for each tuple. -----*/
-        for (auto it = index.begin() + lo; it != index.begin() + hi; ++it) {
+        std::vector<uint32_t> tuple_ids;
+        tuple_ids.reserve(std::distance(first, last));
+        for (auto it = first; it != last; ++it) {
             M_insist(std::in_range<uint32_t>(it->second), "tuple id must fit in uint32_t");
-            index_scan_parent_pipeline(uint32_t(it->second));
+            tuple_ids.push_back(it->second);
         }
+        if (options::index_scan_sort_tuple_ids)
+            std::sort(tuple_ids.begin(), tuple_ids.end()); // access rows in the order of the table
+        for (auto tuple_id : tuple_ids)
+            index_scan_parent_pipeline(tuple_id);
     } else {
         M_unreachable("unknown materialization strategy");
     }
 }
 
-template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
-void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bounds,
-                               const Match<IndexScan<IndexMethod>> &M,
-                               setup_t setup, pipeline_t pipeline, teardown_t teardown)
-{
-    using key_type = Index::key_type;
-    using sql_type = SqlT;
+template<idx::IndexMethod IndexMethod, typename Index>
+void index_scan_codegen_interpretation(const Index &index, const index_scan_bounds_t &bounds,
+                                       const Match<IndexScan<IndexMethod>> &M,
+                                       setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    using key_type = Index::key_type;
+
+    /*----- Interpret lo and hi bounds to retrieve index scan range -----*/
+    auto interpret_and_lookup_bound = [&](const ast::Expr &bound, bool is_lower_bound) -> std::size_t {
+        auto [constant, is_negative] = get_valid_bound(bound);
+        auto c = Interpreter::eval(constant);
+        key_type key;
+        if constexpr(m::boolean<key_type>) {
+            key = bool(c);
+            M_insist(not is_negative, "boolean cannot be negative");
+        } else if constexpr(m::integral<key_type>) {
+            auto i64 = int64_t(c);
+            M_insist(std::in_range<key_type>(i64), "integeral constant must be in range");
+            key = key_type(i64);
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<float, key_type>) {
+            auto d = double(c);
+            key = key_type(d);
+            M_insist(key == d, "downcasting should not impact precision");
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<double, key_type>) {
+            key = double(c);
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<const char*, key_type>) {
+            key = reinterpret_cast<const char*>(c.as_p());
+            M_insist(not is_negative, "string cannot be negative");
+        }
+        return std::distance(index.begin(), is_lower_bound ? index.lower_bound(key)
+                                                           : index.upper_bound(key));
+    };
+    std::size_t lo = bool(bounds.lo) ? interpret_and_lookup_bound(bounds.lo->get(), bounds.is_inclusive_lo)
+                                     : 0UL;
+    std::size_t hi = bool(bounds.hi) ? interpret_and_lookup_bound(bounds.hi->get(), not bounds.is_inclusive_hi)
+                                     : index.num_entries();
+    M_insist(lo <= hi, "bounds need to be valid");
+
+    /*----- Scan the table sequentially if too many rows qualify. -----*/
+    if (index_scan_exceeds_max_selectivity(hi - lo, M.scan)) {
+        index_scan_codegen_sequential(M, std::move(setup), std::move(pipeline), std::move(teardown));
+        return;
+    }
+
+    /*----- Materialize the tuple IDs in the index scan range. -----*/
+    index_scan_codegen_materialized(index.begin() + lo, index.begin() + hi, M,
+                                    std::move(setup), std::move(pipeline), std::move(teardown));
+}
+
+template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
+void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bounds,
+                               const Match<IndexScan<IndexMethod>> &M,
+                               setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    using key_type = Index::key_type;
+    using sql_type = SqlT;
 
     /*----- Resolve callback function name. -----*/
     const char *scan_fn;
@@ -1730,7 +2514,7 @@ void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bo
     } else if constexpr(std::same_as<sql_type, _Doublex1>) { \
         SET_CALLBACK_FNS(INDEX, d); \
     } else if constexpr(std::same_as<sql_type, NChar>) { \
-        SET_CALLBACK_FNS(IDNEX, p); \
+        SET_CALLBACK_FNS(INDEX, p); \
     } else { \
         M_unreachable("incompatible SQL type"); \
     }
@@ -1738,6 +2522,8 @@ void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bo
         RESOLVE_KEYTYPE(array)
     } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
         RESOLVE_KEYTYPE(rmi)
+    } else if constexpr(is_specialization<Index, idx::PiecewiseGeometricModelIndex>) {
+        RESOLVE_KEYTYPE(pgm)
     } else {
         M_unreachable("unknown index type");
     }
@@ -1784,6 +2570,12 @@ void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bo
     M_insist(std::in_range<uint32_t>(lo), "should fit in uint32_t");
     M_insist(std::in_range<uint32_t>(hi), "should fit in uint32_t");
 
+    /*----- Scan the table sequentially if too many rows qualify. -----*/
+    if (index_scan_exceeds_max_selectivity(hi - lo, M.scan)) {
+        index_scan_codegen_sequential(M, std::move(setup), std::move(pipeline), std::move(teardown));
+        return;
+    }
+
     /*----- Materialize offsets hi and lo. -----*/
     Var<U32x1> begin;
     std::optional<U32x1> end;
@@ -1875,6 +2667,8 @@ template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
 void index_scan_resolve_strategy(const Index &index, const index_scan_bounds_t &bounds, const Match<IndexScan<IndexMethod>> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
 {
     if (options::index_scan_strategy == option_configs::IndexScanStrategy::COMPILATION) {
+        /* The range is only looked up in WebAssembly, hence the number of qualifying rows is unknown and the index scan
+         * is never replaced by a sequential scan, regardless of `options::index_scan_max_selectivity`. */
         index_scan_codegen_compilation<IndexMethod, Index, SqlT>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
     } else if (options::index_scan_strategy == option_configs::IndexScanStrategy::INTERPRETATION) {
         index_scan_codegen_interpretation<IndexMethod, Index>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
@@ -1908,6 +2702,12 @@ void index_scan_resolve_index_method(const index_scan_bounds_t &bounds, const Ma
         index_scan_resolve_strategy<IndexMethod, const idx::RecursiveModelIndex<AttrT>, SqlT>(
             index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
         );
+    } else if constexpr(IndexMethod == idx::IndexMethod::Pgm and
+                        requires { typename idx::PiecewiseGeometricModelIndex<AttrT>; }) {
+        auto &index = as<const idx::PiecewiseGeometricModelIndex<AttrT>>(index_base);
+        index_scan_resolve_strategy<IndexMethod, const idx::PiecewiseGeometricModelIndex<AttrT>, SqlT>(
+            index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
+        );
     } else {
         M_unreachable("invalid index method");
     }
@@ -1977,6 +2777,104 @@ void IndexScan<IndexMethod>::execute(const Match<IndexScan<IndexMethod>> &M,
     index_scan_resolve_attribute_type(M, std::move(setup), std::move(pipeline), std::move(teardown));
 }
 
+template<>
+ConditionSet IndexScan<idx::IndexMethod::Composite>::pre_condition(
+    std::size_t child_idx, const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
+
+    auto &filter = *std::get<0>(partial_inner_nodes);
+    M_insist(not filter.filter().empty(), "Filter condition must not be empty");
+    auto &table = std::get<1>(partial_inner_nodes)->store().table();
+
+    /*----- Index scan accesses rows by their absolute tuple ID, hence the table must not be mapped chunk by chunk. --*/
+    if (WasmEngine::Is_Chunked(table))
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Check if a composite index evaluates the filter condition. -----*/
+    if (not find_composite_index_scan(filter.filter(), table))
+        return ConditionSet::Make_Unsatisfiable();
+
+    return ConditionSet();
+}
+
+template<>
+ConditionSet IndexScan<idx::IndexMethod::Composite>::post_condition(const Match<IndexScan> &M)
+{
+    ConditionSet post_cond;
+
+    /*----- Index scan does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Non-SIMDfied index scan does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    /*----- Index scan introduces sortedness on the key attributes unless it may adapt to the qualifying rows. -----*/
+    if (index_scan_may_reorder(/* is_range_interpreted= */ true, /* is_materialized= */ true))
+        return post_cond;
+    auto &table = M.scan.store().table();
+    auto bounds = find_composite_index_scan(M.filter.filter(), table);
+    M_insist(bool(bounds), "composite index must exist");
+    Sortedness::order_t orders;
+    for (auto &attribute : bounds->entry->attributes)
+        orders.add(Schema::Identifier(M.scan.alias(), attribute.get().name), Sortedness::O_ASC);
+    post_cond.add_condition(Sortedness(std::move(orders)));
+
+    return post_cond;
+}
+
+template<>
+void IndexScan<idx::IndexMethod::Composite>::execute(const Match<IndexScan> &M, setup_t setup, pipeline_t pipeline,
+                                                      teardown_t teardown)
+{
+    auto &schema = M.scan.schema();
+    M_insist(schema == schema.drop_constants().deduplicate(), "Schema of `ScanOperator` must neither contain NULL nor duplicates");
+
+    auto &table = M.scan.store().table();
+    M_insist(not table.layout().is_finite(), "layout for `wasm::IndexScan` must be infinite");
+
+    /*----- Lookup index and bounds. -----*/
+    auto bounds = find_composite_index_scan(M.filter.filter(), table);
+    M_insist(bool(bounds), "composite index must exist");
+    auto &index = as<const idx::CompositeIndex>(*bounds->entry->index);
+    auto &attributes = bounds->entry->attributes;
+
+    /*----- Interpret the bounds and encode them to retrieve the index scan range. -----*/
+    /* The entries whose keys start with the encoded equality prefix are consecutive.  Within these, the range on the
+     * next key attribute is looked up by extending the prefix by the encoded lo and hi bounds. */
+    /* A `NULL` value of a key attribute satisfies no predicate.  `NULL` values sort first, hence entries with `NULL`
+     * values in the prefix are never found, and those with a `NULL` value of the next attribute are excluded by
+     * starting a range that has no lo bound at the first non-`NULL` value. */
+    std::string prefix;
+    bool is_empty = false; // whether an equality predicate cannot be satisfied by any value of its attribute
+    for (std::size_t i = 0; i != bounds->prefix.size(); ++i)
+        is_empty |= encode_bound(prefix, *attributes[i].get().type, bounds->prefix[i].get()) != 0;
+    /* A bound rounded to a value greater than the bound behaves like an inclusive lo bound resp. exclusive hi bound on
+     * the rounded value, i.e. is looked up by `lower_bound()`, and like the opposite if rounded to a smaller value. */
+    auto lookup_bound = [&](const ast::Expr &bound, bool is_lower_bound) {
+        std::string key = prefix;
+        if (const int rounding = encode_bound(key, *attributes[bounds->prefix.size()].get().type, bound))
+            is_lower_bound = rounding > 0;
+        return is_lower_bound ? index.lower_bound(key) : index.upper_bound(key);
+    };
+    auto lo = bool(bounds->lo) ? lookup_bound(bounds->lo->get(), bounds->is_inclusive_lo)
+            : bool(bounds->hi) ? index.lower_bound(prefix + idx::CompositeIndex::NOT_NULL_BYTE)
+                               : index.lower_bound(prefix);
+    auto hi = bool(bounds->hi) ? lookup_bound(bounds->hi->get(), not bounds->is_inclusive_hi)
+                               : index.upper_bound(prefix);
+    if (hi < lo or is_empty) hi = lo; // empty range, e.g. `x > 5 AND x < 3`
+
+    /*----- Scan the table sequentially if too many rows qualify. -----*/
+    if (index_scan_exceeds_max_selectivity(std::distance(lo, hi), M.scan)) {
+        index_scan_codegen_sequential(M, std::move(setup), std::move(pipeline), std::move(teardown));
+        return;
+    }
+
+    /*----- Materialize the tuple IDs in the index scan range. -----*/
+    /* Keys of composite indexes are not accessible from WebAssembly, hence the range is always interpreted. */
+    index_scan_codegen_materialized(lo, hi, M, std::move(setup), std::move(pipeline), std::move(teardown));
+}
+
 
 /*======================================================================================================================
  * Filter
@@ -2035,9 +2933,29 @@ void Filter<Predicated>::execute(const Match<Filter> &M, setup_t setup, pipeline
                 pipeline();
             } else {
                 M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
-                IF (CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()) {
-                    pipeline();
-                };
+                auto [table, is_visible_range] = CodeGenContext::Get().visible_rows();
+                if (is_visible_range) {
+                    /*----- The scan below tells whether the rows of the current range are visible.  Evaluate the
+                     * timestamp clauses only for rows of ranges that are not. -----*/
+                    CodeGenContext::Get().set_visible_rows(nullptr, nullptr); // only for the filter above the scan
+                    cnf::CNF timestamp_clauses, other_clauses;
+                    for (auto &clause : M.filter.filter())
+                        (get_timestamp_clause(clause, *table) ? timestamp_clauses : other_clauses).push_back(clause);
+                    Var<Boolx1> is_visible(is_visible_range->val());
+                    IF (not is_visible.val()) {
+                        is_visible =
+                            CodeGenContext::Get().env().compile<_Boolx1>(timestamp_clauses).is_true_and_not_null();
+                    };
+                    IF (is_visible.val() and
+                        CodeGenContext::Get().env().compile<_Boolx1>(other_clauses).is_true_and_not_null())
+                    {
+                        pipeline();
+                    };
+                } else {
+                    IF (CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()) {
+                        pipeline();
+                    };
+                }
             }
         },
         /* teardown= */ std::move(teardown)
@@ -2275,8 +3193,9 @@ ConditionSet HashBasedGrouping::pre_condition(std::size_t child_idx, const std::
 
     ConditionSet pre_cond;
 
-    /*----- Hash-based grouping does not support SIMD. -----*/
-    pre_cond.add_condition(NoSIMD());
+    /*----- Hash-based grouping does only support SIMD if it may consume the selection vector lane-wise. -----*/
+    if (not options::simd_selection_vectors)
+        pre_cond.add_condition(NoSIMD());
 
     return pre_cond;
 }
@@ -2310,10 +3229,12 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
 
     /*----- Compute hash table schema and information about aggregates, especially AVG aggregates. -----*/
     Schema ht_schema;
-    /* Add key(s). */
+    /* Add key(s).  Dictionary-encoded keys of a scan are grouped by their 32 bit codes instead of their strings. */
+    std::vector<const storage::Dictionary*> key_dicts(num_keys);
     for (std::size_t i = 0; i < num_keys; ++i) {
         auto &e = M.grouping.schema()[i];
-        ht_schema.add(e.id, e.type, e.constraints);
+        key_dicts[i] = scanned_dictionary(M.grouping, M.grouping.group_by()[i].first.get());
+        ht_schema.add(e.id, key_dicts[i] ? Type::Get_Integer(Type::TY_Vector, 4) : e.type, e.constraints);
     }
     /* Add payload. */
     auto p = compute_aggregate_info(M.grouping.aggregates(), M.grouping.schema(), num_keys);
@@ -2354,297 +3275,342 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
 
         std::optional<HashTable::entry_t> dummy; ///< *local* dummy slot
 
-        M.child->execute(
-            /* setup=    */ setup_t::Make_Without_Parent([&](){
-                ht->setup();
-                ht->set_high_watermark(M.load_factor);
-                dummy.emplace(ht->dummy_entry()); // create dummy slot to ignore NULL values in aggregate computations
-            }),
-            /* pipeline= */ [&](){
-                M_insist(bool(dummy));
-                const auto &env = CodeGenContext::Get().env();
+        /*----- Create code to consume a single tuple. -----*/
+        auto consume_tuple = [&](){
+            M_insist(bool(dummy));
+            const auto &env = CodeGenContext::Get().env();
 
-                /*----- Insert key if not yet done. -----*/
-                std::vector<SQL_t> key;
-                for (auto &p : M.grouping.group_by())
-                    key.emplace_back(env.compile(p.first.get()));
-                auto [entry, inserted] = ht->try_emplace(std::move(key));
-
-                /*----- Compute aggregates. -----*/
-                Block init_aggs("hash_based_grouping.init_aggs", false),
-                      update_aggs("hash_based_grouping.update_aggs", false),
-                      update_avg_aggs("hash_based_grouping.update_avg_aggs", false);
-                for (auto &info : aggregates) {
-                    bool is_min = false; ///< flag to indicate whether aggregate function is MIN
-                    switch (info.fnid) {
-                        default:
-                            M_unreachable("unsupported aggregate function");
-                        case m::Function::FN_MIN:
-                            is_min = true; // set flag and delegate to MAX case
-                        case m::Function::FN_MAX: {
-                            M_insist(info.args.size() == 1,
-                                     "MIN and MAX aggregate functions expect exactly one argument");
-                            const auto &arg = *info.args[0];
-                            std::visit(overloaded {
-                                [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
-                                requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
-                                    using type = typename _T::type;
-                                    using T = PrimitiveExpr<type>;
+            /*----- Insert key if not yet done. -----*/
+            std::vector<SQL_t> key;
+            for (std::size_t i = 0; i < num_keys; ++i) {
+                auto &k = M.grouping.group_by()[i].first.get();
+                if (key_dicts[i]) {
+                    Schema::Identifier id(k);
+                    M_insist(env.dictionary(id) == key_dicts[i], "code of dictionary-encoded key not loaded by scan");
+                    NChar str = env.get<NChar>(id);
+                    I32x1 code = env.get_code(id).make_signed();
+                    if (str.can_be_null()) {
+                        key.emplace_back(_I32x1(code, str.is_null()));
+                    } else {
+                        str.discard();
+                        key.emplace_back(_I32x1(code));
+                    }
+                } else {
+                    key.emplace_back(env.compile(k));
+                }
+            }
+            auto [entry, inserted] = ht->try_emplace(std::move(key));
 
-                                    auto _arg = env.compile(arg);
-                                    _T _new_val = convert<_T>(_arg);
+            /*----- Compute aggregates. -----*/
+            Block init_aggs("hash_based_grouping.init_aggs", false),
+                  update_aggs("hash_based_grouping.update_aggs", false),
+                  update_avg_aggs("hash_based_grouping.update_avg_aggs", false);
+            for (auto &info : aggregates) {
+                bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+                switch (info.fnid) {
+                    default:
+                        M_unreachable("unsupported aggregate function");
+                    case m::Function::FN_MIN:
+                        is_min = true; // set flag and delegate to MAX case
+                    case m::Function::FN_MAX: {
+                        M_insist(info.args.size() == 1,
+                                 "MIN and MAX aggregate functions expect exactly one argument");
+                        const auto &arg = *info.args[0];
+                        std::visit(overloaded {
+                            [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
+                            requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
+                                using type = typename _T::type;
+                                using T = PrimitiveExpr<type>;
 
-                                    BLOCK_OPEN(init_aggs) {
-                                        auto [val_, is_null] = _new_val.clone().split();
-                                        T val(val_); // due to structured binding and lambda closure
-                                        IF (is_null) {
-                                            auto neutral = is_min ? T(std::numeric_limits<type>::max())
-                                                                  : T(std::numeric_limits<type>::lowest());
-                                            r.clone().set_value(neutral); // initialize with neutral element +inf or -inf
-                                            if (info.entry.nullable())
-                                                r.clone().set_null(); // first value is NULL
-                                        } ELSE {
-                                            r.clone().set_value(val); // initialize with first value
-                                            if (info.entry.nullable())
-                                                r.clone().set_not_null(); // first value is not NULL
-                                        };
-                                    }
-                                    BLOCK_OPEN(update_aggs) {
-                                        if (_new_val.can_be_null()) {
-                                            M_insist_no_ternary_logic();
-                                            auto [new_val_, new_val_is_null_] = _new_val.split();
-                                            auto [old_min_max_, old_min_max_is_null] = _T(r.clone()).split();
-                                            const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
-
-                                            auto chosen_r = Select(new_val_is_null, dummy->extract<_T>(info.entry.id),
-                                                                                    r.clone());
-                                            if constexpr (std::floating_point<type>) {
-                                                chosen_r.set_value(
-                                                    is_min ? min(old_min_max_, new_val_) // update old min with new value
-                                                           : max(old_min_max_, new_val_) // update old max with new value
-                                                ); // if new value is NULL, only dummy is written
-                                            } else {
-                                                const Var<T> new_val(new_val_),
-                                                             old_min_max(old_min_max_); // due to multiple uses
-                                                auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
+                                auto _arg = env.compile(arg);
+                                _T _new_val = convert<_T>(_arg);
+
+                                BLOCK_OPEN(init_aggs) {
+                                    auto [val_, is_null] = _new_val.clone().split();
+                                    T val(val_); // due to structured binding and lambda closure
+                                    IF (is_null) {
+                                        auto neutral = is_min ? T(std::numeric_limits<type>::max())
+                                                              : T(std::numeric_limits<type>::lowest());
+                                        r.clone().set_value(neutral); // initialize with neutral element +inf or -inf
+                                        if (info.entry.nullable())
+                                            r.clone().set_null(); // first value is NULL
+                                    } ELSE {
+                                        r.clone().set_value(val); // initialize with first value
+                                        if (info.entry.nullable())
+                                            r.clone().set_not_null(); // first value is not NULL
+                                    };
+                                }
+                                BLOCK_OPEN(update_aggs) {
+                                    if (_new_val.can_be_null()) {
+                                        M_insist_no_ternary_logic();
+                                        auto [new_val_, new_val_is_null_] = _new_val.split();
+                                        auto [old_min_max_, old_min_max_is_null] = _T(r.clone()).split();
+                                        const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                        auto chosen_r = Select(new_val_is_null, dummy->extract<_T>(info.entry.id),
+                                                                                r.clone());
+                                        if constexpr (std::floating_point<type>) {
+                                            chosen_r.set_value(
+                                                is_min ? min(old_min_max_, new_val_) // update old min with new value
+                                                       : max(old_min_max_, new_val_) // update old max with new value
+                                            ); // if new value is NULL, only dummy is written
+                                        } else {
+                                            const Var<T> new_val(new_val_),
+                                                         old_min_max(old_min_max_); // due to multiple uses
+                                            auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
 #if 1
-                                                chosen_r.set_value(
-                                                    Select(cmp,
-                                                           new_val, // update to new value
-                                                           old_min_max) // do not update
-                                                ); // if new value is NULL, only dummy is written
+                                            chosen_r.set_value(
+                                                Select(cmp,
+                                                       new_val, // update to new value
+                                                       old_min_max) // do not update
+                                            ); // if new value is NULL, only dummy is written
 #else
-                                                IF (cmp) {
-                                                    r.set_value(new_val);
-                                                };
+                                            IF (cmp) {
+                                                r.set_value(new_val);
+                                            };
 #endif
-                                            }
-                                            r.set_null_bit(
-                                                old_min_max_is_null and new_val_is_null // MIN/MAX is NULL iff all values are NULL
+                                        }
+                                        r.set_null_bit(
+                                            old_min_max_is_null and new_val_is_null // MIN/MAX is NULL iff all values are NULL
+                                        );
+                                    } else {
+                                        auto new_val_ = _new_val.insist_not_null();
+                                        auto old_min_max_ = _T(r.clone()).insist_not_null();
+                                        if constexpr (std::floating_point<type>) {
+                                            r.set_value(
+                                                is_min ? min(old_min_max_, new_val_) // update old min with new value
+                                                       : max(old_min_max_, new_val_) // update old max with new value
                                             );
                                         } else {
-                                            auto new_val_ = _new_val.insist_not_null();
-                                            auto old_min_max_ = _T(r.clone()).insist_not_null();
-                                            if constexpr (std::floating_point<type>) {
-                                                r.set_value(
-                                                    is_min ? min(old_min_max_, new_val_) // update old min with new value
-                                                           : max(old_min_max_, new_val_) // update old max with new value
-                                                );
-                                            } else {
-                                                const Var<T> new_val(new_val_),
-                                                             old_min_max(old_min_max_); // due to multiple uses
-                                                auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
+                                            const Var<T> new_val(new_val_),
+                                                         old_min_max(old_min_max_); // due to multiple uses
+                                            auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
 #if 1
-                                                r.set_value(
-                                                    Select(cmp,
-                                                           new_val, // update to new value
-                                                           old_min_max) // do not update
-                                                );
+                                            r.set_value(
+                                                Select(cmp,
+                                                       new_val, // update to new value
+                                                       old_min_max) // do not update
+                                            );
 #else
-                                                IF (cmp) {
-                                                    r.set_value(new_val);
-                                                };
+                                            IF (cmp) {
+                                                r.set_value(new_val);
+                                            };
 #endif
-                                            }
-                                            /* do not update NULL bit since it is already set to `false` */
                                         }
+                                        /* do not update NULL bit since it is already set to `false` */
                                     }
-                                },
-                                []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
-                                requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
-                                    M_unreachable("invalid type");
-                                },
-                                [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                            }, entry.extract(info.entry.id));
-                            break;
-                        }
-                        case m::Function::FN_AVG: {
-                            auto it = avg_aggregates.find(info.entry.id);
-                            M_insist(it != avg_aggregates.end());
-                            const auto &avg_info = it->second;
-                            M_insist(avg_info.compute_running_avg,
-                                     "AVG aggregate may only occur for running average computations");
-                            M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
-                            const auto &arg = *info.args[0];
-
-                            auto r = entry.extract<_Doublex1>(info.entry.id);
-                            auto _arg = env.compile(arg);
-                            _Doublex1 _new_val = convert<_Doublex1>(_arg);
-
-                            BLOCK_OPEN(init_aggs) {
-                                auto [val_, is_null] = _new_val.clone().split();
-                                Doublex1 val(val_); // due to structured binding and lambda closure
-                                IF (is_null) {
-                                    r.clone().set_value(Doublex1(0.0)); // initialize with neutral element 0
-                                    if (info.entry.nullable())
-                                        r.clone().set_null(); // first value is NULL
-                                } ELSE {
-                                    r.clone().set_value(val); // initialize with first value
-                                    if (info.entry.nullable())
-                                        r.clone().set_not_null(); // first value is not NULL
-                                };
-                            }
-                            BLOCK_OPEN(update_avg_aggs) {
-                                /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
-                                 * Vol 2, section 4.2.2. */
-                                if (_new_val.can_be_null()) {
-                                    M_insist_no_ternary_logic();
-                                    auto [new_val, new_val_is_null_] = _new_val.split();
-                                    auto [old_avg_, old_avg_is_null] = _Doublex1(r.clone()).split();
-                                    const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
-                                    const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
-
-                                    auto delta_absolute = new_val - old_avg;
-                                    auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
-                                    auto delta_relative = delta_absolute / running_count.to<double>();
-
-                                    auto chosen_r = Select(new_val_is_null, dummy->extract<_Doublex1>(info.entry.id),
-                                                                            r.clone());
-                                    chosen_r.set_value(
-                                        old_avg + delta_relative // update old average with new value
-                                    ); // if new value is NULL, only dummy is written
-                                    r.set_null_bit(
-                                        old_avg_is_null and new_val_is_null // AVG is NULL iff all values are NULL
-                                    );
-                                } else {
-                                    auto new_val = _new_val.insist_not_null();
-                                    auto old_avg_ = _Doublex1(r.clone()).insist_not_null();
-                                    const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
-
-                                    auto delta_absolute = new_val - old_avg;
-                                    auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
-                                    auto delta_relative = delta_absolute / running_count.to<double>();
-                                    r.set_value(
-                                        old_avg + delta_relative // update old average with new value
-                                    );
-                                    /* do not update NULL bit since it is already set to `false` */
                                 }
-                            }
-                            break;
-                        }
-                        case m::Function::FN_SUM: {
-                            M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
-                            const auto &arg = *info.args[0];
-                            std::visit(overloaded {
-                                [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
-                                requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
-                                    using type = typename _T::type;
-                                    using T = PrimitiveExpr<type>;
-
-                                    auto _arg = env.compile(arg);
-                                    _T _new_val = convert<_T>(_arg);
+                            },
+                            []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
+                            requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
+                                M_unreachable("invalid type");
+                            },
+                            [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                        }, entry.extract(info.entry.id));
+                        break;
+                    }
+                    case m::Function::FN_AVG: {
+                        auto it = avg_aggregates.find(info.entry.id);
+                        M_insist(it != avg_aggregates.end());
+                        const auto &avg_info = it->second;
+                        M_insist(avg_info.compute_running_avg,
+                                 "AVG aggregate may only occur for running average computations");
+                        M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
+                        const auto &arg = *info.args[0];
 
-                                    BLOCK_OPEN(init_aggs) {
-                                        auto [val_, is_null] = _new_val.clone().split();
-                                        T val(val_); // due to structured binding and lambda closure
-                                        IF (is_null) {
-                                            r.clone().set_value(T(type(0))); // initialize with neutral element 0
-                                            if (info.entry.nullable())
-                                                r.clone().set_null(); // first value is NULL
-                                        } ELSE {
-                                            r.clone().set_value(val); // initialize with first value
-                                            if (info.entry.nullable())
-                                                r.clone().set_not_null(); // first value is not NULL
-                                        };
-                                    }
-                                    BLOCK_OPEN(update_aggs) {
-                                        if (_new_val.can_be_null()) {
-                                            M_insist_no_ternary_logic();
-                                            auto [new_val, new_val_is_null_] = _new_val.split();
-                                            auto [old_sum, old_sum_is_null] = _T(r.clone()).split();
-                                            const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+                        auto r = entry.extract<_Doublex1>(info.entry.id);
+                        auto _arg = env.compile(arg);
+                        _Doublex1 _new_val = convert<_Doublex1>(_arg);
 
-                                            auto chosen_r = Select(new_val_is_null, dummy->extract<_T>(info.entry.id),
-                                                                                    r.clone());
-                                            chosen_r.set_value(
-                                                old_sum + new_val // add new value to old sum
-                                            ); // if new value is NULL, only dummy is written
-                                            r.set_null_bit(
-                                                old_sum_is_null and new_val_is_null // SUM is NULL iff all values are NULL
-                                            );
-                                        } else {
-                                            auto new_val = _new_val.insist_not_null();
-                                            auto old_sum = _T(r.clone()).insist_not_null();
-                                            r.set_value(
-                                                old_sum + new_val // add new value to old sum
-                                            );
-                                            /* do not update NULL bit since it is already set to `false` */
-                                        }
-                                    }
-                                },
-                                []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
-                                requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
-                                    M_unreachable("invalid type");
-                                },
-                                [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                            }, entry.extract(info.entry.id));
-                            break;
+                        BLOCK_OPEN(init_aggs) {
+                            auto [val_, is_null] = _new_val.clone().split();
+                            Doublex1 val(val_); // due to structured binding and lambda closure
+                            IF (is_null) {
+                                r.clone().set_value(Doublex1(0.0)); // initialize with neutral element 0
+                                if (info.entry.nullable())
+                                    r.clone().set_null(); // first value is NULL
+                            } ELSE {
+                                r.clone().set_value(val); // initialize with first value
+                                if (info.entry.nullable())
+                                    r.clone().set_not_null(); // first value is not NULL
+                            };
                         }
-                        case m::Function::FN_COUNT: {
-                            M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
+                        BLOCK_OPEN(update_avg_aggs) {
+                            /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
+                             * Vol 2, section 4.2.2. */
+                            if (_new_val.can_be_null()) {
+                                M_insist_no_ternary_logic();
+                                auto [new_val, new_val_is_null_] = _new_val.split();
+                                auto [old_avg_, old_avg_is_null] = _Doublex1(r.clone()).split();
+                                const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+                                const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
+
+                                auto delta_absolute = new_val - old_avg;
+                                auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
+                                auto delta_relative = delta_absolute / running_count.to<double>();
+
+                                auto chosen_r = Select(new_val_is_null, dummy->extract<_Doublex1>(info.entry.id),
+                                                                        r.clone());
+                                chosen_r.set_value(
+                                    old_avg + delta_relative // update old average with new value
+                                ); // if new value is NULL, only dummy is written
+                                r.set_null_bit(
+                                    old_avg_is_null and new_val_is_null // AVG is NULL iff all values are NULL
+                                );
+                            } else {
+                                auto new_val = _new_val.insist_not_null();
+                                auto old_avg_ = _Doublex1(r.clone()).insist_not_null();
+                                const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
+
+                                auto delta_absolute = new_val - old_avg;
+                                auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
+                                auto delta_relative = delta_absolute / running_count.to<double>();
+                                r.set_value(
+                                    old_avg + delta_relative // update old average with new value
+                                );
+                                /* do not update NULL bit since it is already set to `false` */
+                            }
+                        }
+                        break;
+                    }
+                    case m::Function::FN_SUM: {
+                        M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
+                        const auto &arg = *info.args[0];
+                        std::visit(overloaded {
+                            [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
+                            requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
+                                using type = typename _T::type;
+                                using T = PrimitiveExpr<type>;
 
-                            auto r = entry.get<_I64x1>(info.entry.id); // do not extract to be able to access for AVG case
+                                auto _arg = env.compile(arg);
+                                _T _new_val = convert<_T>(_arg);
 
-                            if (info.args.empty()) {
                                 BLOCK_OPEN(init_aggs) {
-                                    r.clone() = _I64x1(1); // initialize with 1 (for first value)
+                                    auto [val_, is_null] = _new_val.clone().split();
+                                    T val(val_); // due to structured binding and lambda closure
+                                    IF (is_null) {
+                                        r.clone().set_value(T(type(0))); // initialize with neutral element 0
+                                        if (info.entry.nullable())
+                                            r.clone().set_null(); // first value is NULL
+                                    } ELSE {
+                                        r.clone().set_value(val); // initialize with first value
+                                        if (info.entry.nullable())
+                                            r.clone().set_not_null(); // first value is not NULL
+                                    };
                                 }
                                 BLOCK_OPEN(update_aggs) {
-                                    auto old_count = _I64x1(r.clone()).insist_not_null();
-                                    r.set_value(
-                                        old_count + int64_t(1) // increment old count by 1
-                                    );
-                                    /* do not update NULL bit since it is already set to `false` */
+                                    if (_new_val.can_be_null()) {
+                                        M_insist_no_ternary_logic();
+                                        auto [new_val, new_val_is_null_] = _new_val.split();
+                                        auto [old_sum, old_sum_is_null] = _T(r.clone()).split();
+                                        const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                        auto chosen_r = Select(new_val_is_null, dummy->extract<_T>(info.entry.id),
+                                                                                r.clone());
+                                        chosen_r.set_value(
+                                            old_sum + new_val // add new value to old sum
+                                        ); // if new value is NULL, only dummy is written
+                                        r.set_null_bit(
+                                            old_sum_is_null and new_val_is_null // SUM is NULL iff all values are NULL
+                                        );
+                                    } else {
+                                        auto new_val = _new_val.insist_not_null();
+                                        auto old_sum = _T(r.clone()).insist_not_null();
+                                        r.set_value(
+                                            old_sum + new_val // add new value to old sum
+                                        );
+                                        /* do not update NULL bit since it is already set to `false` */
+                                    }
                                 }
-                            } else {
-                                const auto &arg = *info.args[0];
+                            },
+                            []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
+                            requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
+                                M_unreachable("invalid type");
+                            },
+                            [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                        }, entry.extract(info.entry.id));
+                        break;
+                    }
+                    case m::Function::FN_COUNT: {
+                        M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
 
-                                auto _arg = env.compile(arg);
-                                I64x1 new_val_not_null = not_null(_arg).to<int64_t>();
+                        auto r = entry.get<_I64x1>(info.entry.id); // do not extract to be able to access for AVG case
 
-                                BLOCK_OPEN(init_aggs) {
-                                    r.clone() = _I64x1(new_val_not_null.clone()); // initialize with 1 iff first value is present
-                                }
-                                BLOCK_OPEN(update_aggs) {
-                                    auto old_count = _I64x1(r.clone()).insist_not_null();
-                                    r.set_value(
-                                        old_count + new_val_not_null // increment old count by 1 iff new value is present
-                                    );
-                                    /* do not update NULL bit since it is already set to `false` */
-                                }
+                        if (info.args.empty()) {
+                            BLOCK_OPEN(init_aggs) {
+                                r.clone() = _I64x1(1); // initialize with 1 (for first value)
+                            }
+                            BLOCK_OPEN(update_aggs) {
+                                auto old_count = _I64x1(r.clone()).insist_not_null();
+                                r.set_value(
+                                    old_count + int64_t(1) // increment old count by 1
+                                );
+                                /* do not update NULL bit since it is already set to `false` */
+                            }
+                        } else {
+                            const auto &arg = *info.args[0];
+
+                            auto _arg = env.compile(arg);
+                            I64x1 new_val_not_null = not_null(_arg).to<int64_t>();
+
+                            BLOCK_OPEN(init_aggs) {
+                                r.clone() = _I64x1(new_val_not_null.clone()); // initialize with 1 iff first value is present
+                            }
+                            BLOCK_OPEN(update_aggs) {
+                                auto old_count = _I64x1(r.clone()).insist_not_null();
+                                r.set_value(
+                                    old_count + new_val_not_null // increment old count by 1 iff new value is present
+                                );
+                                /* do not update NULL bit since it is already set to `false` */
                             }
-                            break;
                         }
+                        break;
                     }
                 }
+            }
 
-                /*----- If group has been inserted, initialize aggregates. Otherwise, update them. -----*/
-                IF (inserted) {
-                    init_aggs.attach_to_current();
-                } ELSE {
-                    update_aggs.attach_to_current();
-                    update_avg_aggs.attach_to_current(); // after others to ensure that running count is incremented before
-                };
+            /*----- If group has been inserted, initialize aggregates. Otherwise, update them. -----*/
+            IF (inserted) {
+                init_aggs.attach_to_current();
+            } ELSE {
+                update_aggs.attach_to_current();
+                update_avg_aggs.attach_to_current(); // after others to ensure that running count is incremented before
+            };
+        };
+
+        M.child->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){
+                ht->setup();
+                ht->set_high_watermark(M.load_factor);
+                dummy.emplace(ht->dummy_entry()); // create dummy slot to ignore NULL values in aggregate computations
+            }),
+            /* pipeline= */ [&](){
+                const auto num_simd_lanes = CodeGenContext::Get().num_simd_lanes();
+                if (num_simd_lanes == 1) {
+                    consume_tuple();
+                    return;
+                }
+
+                /*----- Compute the hashes of the keys of all SIMD lanes at once, if possible. -----*/
+                std::vector<const Type*> key_types;
+                for (auto &p : M.grouping.group_by())
+                    key_types.push_back(p.first.get().type());
+                void *hashes = nullptr;
+                if (is_simd_hashable(key_types)) {
+                    auto &env = CodeGenContext::Get().env();
+                    hashes = precompute_simd_hashes(key_types.front(),
+                                                    env.compile(M.grouping.group_by().front().first.get()));
+                }
+
+                /*----- Consume each qualifying tuple of the SIMD vectors individually.  There is no gather in
+                 * WebAssembly SIMD, hence the hash table is updated by scalar code per lane. -----*/
+                for_each_qualifying_lane([&](U32x1 lane){
+                    if (hashes)
+                        ht->set_precomputed_hash(*(Ptr<void>(hashes).to<uint64_t*>() + lane.make_signed()));
+                    else
+                        lane.discard();
+                    consume_tuple();
+                });
             },
             /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht->teardown(); })
         );
@@ -2662,6 +3628,13 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
             auto &e = M.grouping.schema()[i];
             key_schema.add(e.id, e.type, e.constraints);
         }
+        auto key_dict = [&](const Schema::Identifier &id) -> const storage::Dictionary* {
+            for (std::size_t i = 0; i < num_keys; ++i) {
+                if (M.grouping.schema()[i].id == id)
+                    return key_dicts[i];
+            }
+            return nullptr;
+        };
 
         /*----- Add computed group tuples to current environment. ----*/
         for (auto &e : M.grouping.schema().deduplicate()) {
@@ -2693,6 +3666,19 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
                     Var<Doublex1> var(avg.insist_not_null());
                     env.add(e.id, _Doublex1(var));
                 }
+            } else if (auto dict = key_dict(e.id)) { // dictionary-encoded key, decode code
+                auto &cs = as<const CharacterSequence>(*e.type);
+                auto [code, is_null] = _I32x1(entry.get<_I32x1>(e.id)).split();
+                Ptr<Charx1> str = decode_dictionary(*dict, code.make_unsigned());
+                if (e.nullable()) {
+                    /* introduce variable s.t. uses only load from it */
+                    Var<Ptr<Charx1>> var(Select(is_null, Ptr<Charx1>::Nullptr(), str));
+                    env.add(e.id, NChar(var, /* can_be_null=*/ true, cs.length, true));
+                } else {
+                    is_null.discard();
+                    Var<Ptr<Charx1>> var(str); // introduce variable s.t. uses only load from it
+                    env.add(e.id, NChar(var, /* can_be_null=*/ false, cs.length, true));
+                }
             } else { // part of key or already computed aggregate
                 std::visit(overloaded {
                     [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
@@ -2762,7 +3748,7 @@ ConditionSet OrderedGrouping::adapt_post_condition(const Match<OrderedGrouping>
     Sortedness::order_t orders;
     const auto &sortedness_child = post_cond_child.get_condition<Sortedness>();
     for (auto &[expr, alias] : M.grouping.group_by()) {
-        auto it = sortedness_child.orders().find(Schema::Identifier(expr));
+        auto it = sortedness_child.find(Schema::Identifier(expr)); // the child may be sorted by an equivalent attribute
         M_insist(it != sortedness_child.orders().cend());
         Schema::Identifier id = alias.has_value() ? Schema::Identifier(alias.assert_not_none())
                                                   : Schema::Identifier(expr);
@@ -4588,118 +5574,437 @@ ConditionSet NestedLoopsJoin<Predicated>::pre_condition(std::size_t, const std::
     return pre_cond;
 }
 
-template<bool Predicated>
-ConditionSet NestedLoopsJoin<Predicated>::adapt_post_conditions(
-    const Match<NestedLoopsJoin>&,
-    std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
+template<bool Predicated>
+ConditionSet NestedLoopsJoin<Predicated>::adapt_post_conditions(
+    const Match<NestedLoopsJoin>&,
+    std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
+{
+    M_insist(post_cond_children.size() >= 2);
+
+    ConditionSet post_cond(post_cond_children.back().get()); // preserve conditions of right-most child
+
+    if constexpr (Predicated) {
+        /*----- Predicated nested-loops join introduces predication. -----*/
+        post_cond.add_or_replace_condition(m::Predicated(true));
+    }
+
+    return post_cond;
+}
+
+template<bool Predicated>
+double NestedLoopsJoin<Predicated>::cost(const Match<NestedLoopsJoin> &M)
+{
+    double cost = 1;
+    for (auto &child : M.children)
+        cost *= child->get_matched_root().info().estimated_cardinality;
+    return cost;
+}
+
+template<bool Predicated>
+void NestedLoopsJoin<Predicated>::execute(const Match<NestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline,
+                                          teardown_t teardown)
+{
+    const auto num_left_children = M.children.size() - 1; // all children but right-most one
+
+    std::vector<Schema> schemas; // to own adapted schemas
+    schemas.reserve(num_left_children);
+    std::vector<GlobalBuffer> buffers;
+    buffers.reserve(num_left_children);
+
+    /*----- Process all but right-most child. -----*/
+    for (std::size_t i = 0; i < num_left_children; ++i) {
+        /*----- Create function for each child. -----*/
+        FUNCTION(nested_loop_join_child_pipeline, void(void))
+        {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+            /*----- Create infinite buffer to materialize the current results. -----*/
+            M_insist(bool(M.materializing_factories_[i]),
+                     "`wasm::NestedLoopsJoin` must have a factory for each materialized child");
+            const auto &schema = schemas.emplace_back(
+                M.children[i]->get_matched_root().schema().drop_constants().deduplicate()
+            );
+            if (i == 0) {
+                /*----- Exactly one child (here left-most one) checks join predicate and resumes pipeline. -----*/
+                buffers.emplace_back(
+                    /* schema=        */ schema,
+                    /* factory=       */ *M.materializing_factories_[i],
+                    /* load_simdfied= */ false,
+                    /* num_tuples=    */ 0, // i.e. infinite
+                    /* setup=         */ setup_t::Make_Without_Parent(),
+                    /* pipeline=      */ [&, pipeline=std::move(pipeline)](){
+                        if constexpr (Predicated) {
+                            CodeGenContext::Get().env().add_predicate(M.join.predicate());
+                            pipeline();
+                        } else {
+                            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+                            IF (CodeGenContext::Get().env().compile<_Boolx1>(M.join.predicate()).is_true_and_not_null()) {
+                                pipeline();
+                            };
+                        }
+                    },
+                    /* teardown=      */ teardown_t::Make_Without_Parent()
+                );
+            } else {
+                /*----- All but exactly one child (here left-most one) load lastly inserted buffer again. -----*/
+                /* All buffers are "connected" with each other by setting the pipeline callback as calling the
+                 * `resume_pipeline_inline()` method of the lastly inserted buffer. Therefore, calling
+                 * `resume_pipeline_inline()` on the lastly inserted buffer will load one tuple from it, recursively
+                 * call `resume_pipeline_inline()` on the buffer created before that which again loads one tuple from
+                 * it, and so on until the buffer inserted first (here the one of the left-most child) will load one
+                 * of its tuples and check the join predicate for this one cartesian-product-combination of result
+                 * tuples. */
+                buffers.emplace_back(
+                    /* schema=        */ schema,
+                    /* factory=       */ *M.materializing_factories_[i],
+                    /* load_simdfied= */ false,
+                    /* num_tuples=    */ 0, // i.e. infinite
+                    /* setup=         */ setup_t::Make_Without_Parent(),
+                    /* pipeline=      */ [&](){ buffers.back().resume_pipeline_inline(); },
+                    /* teardown=      */ teardown_t::Make_Without_Parent()
+                );
+            }
+
+            /*----- Materialize the current result tuple in pipeline. -----*/
+            M.children[i]->execute(
+                /* setup=    */ setup_t::Make_Without_Parent([&](){ buffers.back().setup(); }),
+                /* pipeline= */ [&](){ buffers.back().consume(); },
+                /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffers.back().teardown(); })
+            );
+        }
+        nested_loop_join_child_pipeline(); // call child function
+    }
+
+    /*----- Process right-most child. -----*/
+    M.children.back()->execute(
+        /* setup=    */ std::move(setup),
+        /* pipeline= */ [&](){ buffers.back().resume_pipeline_inline(); },
+        /* teardown= */ std::move(teardown)
+    );
+}
+
+/** The clause of the join predicate of a `wasm::IndexNestedLoopsJoin` that is evaluated by probing the index. */
+struct index_nested_loops_join_key_t
+{
+    const Designator &outer; ///< the join key of the outer relation
+    const Designator &inner; ///< the join key of the inner relation, i.e. the indexed attribute
+    const cnf::Clause &clause; ///< the clause `outer = inner` of the join predicate
+};
+
+/** Returns the first clause of the predicate of \p join that compares an attribute of \p scan for equality with an
+ * attribute of the same type of the other relation such that a valid single-attribute index of method \p method exists
+ * on the former, or `std::nullopt` if there is no such clause.  String keys are not supported. */
+std::optional<index_nested_loops_join_key_t>
+find_index_nested_loops_join_key(const JoinOperator &join, const ScanOperator &scan, idx::IndexMethod method)
+{
+    auto &table = scan.store().table();
+    auto &DB = Catalog::Get().get_database_in_use();
+
+    for (auto &clause : join.predicate()) {
+        if (clause.size() != 1) // disjunctions not supported
+            continue;
+        auto &literal = clause[0];
+        auto binary = cast<const BinaryExpr>(&literal.expr());
+        if (literal.negative() or not binary or binary->tok.type != TK_EQUAL)
+            continue;
+        auto lhs = cast<const Designator>(binary->lhs.get());
+        auto rhs = cast<const Designator>(binary->rhs.get());
+        if (not lhs or not rhs)
+            continue;
+
+        const bool is_inner_lhs = scan.schema().has(Schema::Identifier(*lhs));
+        auto &inner = is_inner_lhs ? *lhs : *rhs;
+        auto &outer = is_inner_lhs ? *rhs : *lhs;
+        if (not scan.schema().has(Schema::Identifier(inner)) or scan.schema().has(Schema::Identifier(outer)))
+            continue; // not a comparison of an attribute of each relation
+
+        /*----- The outer key is passed as is to the index, hence it must be of the key type. -----*/
+        auto &type = *inner.type();
+        if (type != *outer.type())
+            continue;
+        if (not type.is_boolean() and not type.is_numeric() and not type.is_date() and not type.is_date_time())
+            continue;
+
+        if (DB.has_index(table.name(), Schema::Identifier(inner).name, method))
+            return index_nested_loops_join_key_t{ .outer = outer, .inner = inner, .clause = clause };
+    }
+    return std::nullopt;
+}
+
+template<idx::IndexMethod IndexMethod>
+ConditionSet IndexNestedLoopsJoin<IndexMethod>::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const Wildcard*, const ScanOperator*> &partial_inner_nodes)
+{
+    ConditionSet pre_cond;
+
+    if (child_idx == 0) {
+        /*----- Index nested-loops join probes the index with one outer tuple at a time. -----*/
+        pre_cond.add_condition(NoSIMD());
+    } else {
+        M_insist(child_idx == 1);
+        auto &join = *std::get<0>(partial_inner_nodes);
+        auto &scan = *std::get<2>(partial_inner_nodes);
+
+        /*----- Inner tuples are accessed by their absolute tuple ID, hence the table must not be mapped chunk by
+         * chunk. -----*/
+        if (WasmEngine::Is_Chunked(scan.store().table()))
+            return ConditionSet::Make_Unsatisfiable();
+
+        /*----- Check if an index on the inner join key exists. -----*/
+        if (not find_index_nested_loops_join_key(join, scan, IndexMethod))
+            return ConditionSet::Make_Unsatisfiable();
+    }
+
+    return pre_cond;
+}
+
+template<idx::IndexMethod IndexMethod>
+ConditionSet IndexNestedLoopsJoin<IndexMethod>::adapt_post_condition(const Match<IndexNestedLoopsJoin> &M,
+                                                                     const ConditionSet &post_cond_child)
+{
+    ConditionSet post_cond(post_cond_child); // preserve conditions of outer child, which is consumed in order
+
+    if (post_cond.has_condition<Sortedness>()) {
+        /*----- Join keys are equal in every result tuple, hence the outer order carries over to the inner key. -----*/
+        auto key = find_index_nested_loops_join_key(M.join, M.scan, IndexMethod);
+        M_insist(bool(key), "index must exist");
+        post_cond.get_condition<Sortedness>().add_equivalence(Schema::Identifier(key->outer),
+                                                             Schema::Identifier(key->inner));
+    }
+
+    /*----- Index nested-loops join does not introduce predication. -----*/
+    post_cond.add_or_replace_condition(m::Predicated(false));
+
+    /*----- Index nested-loops join does not introduce SIMD. -----*/
+    post_cond.remove_condition<SIMD>();
+    post_cond.add_or_replace_condition(NoSIMD());
+
+    return post_cond;
+}
+
+template<idx::IndexMethod IndexMethod>
+double IndexNestedLoopsJoin<IndexMethod>::cost(const Match<IndexNestedLoopsJoin> &M)
+{
+    /* Each outer tuple searches the index for the first and the last matching entry.  In contrast to the other joins,
+     * the inner relation is neither scanned nor materialized. */
+    const double num_outer = M.outer.info().estimated_cardinality;
+    const double num_inner = M.scan.info().estimated_cardinality;
+    return num_outer * (1.0 + 2.0 * std::log2(num_inner + 1.0));
+}
+
+/** Emits code to probe the index of type \p Index with the join key \p key of each outer tuple of \p M and to execute
+ * the pipeline on each inner tuple of a matching index entry.  Since the outer keys are only known at runtime, the
+ * index is always queried by callbacks to the host. */
+template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
+void index_nested_loops_join_codegen(const Index &index, const index_nested_loops_join_key_t &key,
+                                     const Match<IndexNestedLoopsJoin<IndexMethod>> &M,
+                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    /*----- Resolve callback function names. -----*/
+    const char *scan_fn, *lower_bound_fn, *upper_bound_fn;
+#define SET_CALLBACK_FNS(INDEX, KEY) \
+    scan_fn        = M_STR(idx_scan_##INDEX##_##KEY); \
+    lower_bound_fn = M_STR(idx_lower_bound_##INDEX##_##KEY); \
+    upper_bound_fn = M_STR(idx_upper_bound_##INDEX##_##KEY)
+
+#define RESOLVE_KEYTYPE(INDEX) \
+    if constexpr(std::same_as<SqlT, _Boolx1>) { \
+        SET_CALLBACK_FNS(INDEX, b); \
+    } else if constexpr(std::same_as<SqlT, _I8x1>) { \
+        SET_CALLBACK_FNS(INDEX, i1); \
+    } else if constexpr(std::same_as<SqlT, _I16x1>) { \
+        SET_CALLBACK_FNS(INDEX, i2); \
+    } else if constexpr(std::same_as<SqlT, _I32x1>) { \
+        SET_CALLBACK_FNS(INDEX, i4); \
+    } else if constexpr(std::same_as<SqlT, _I64x1>) { \
+        SET_CALLBACK_FNS(INDEX, i8); \
+    } else if constexpr(std::same_as<SqlT, _Floatx1>) { \
+        SET_CALLBACK_FNS(INDEX, f); \
+    } else if constexpr(std::same_as<SqlT, _Doublex1>) { \
+        SET_CALLBACK_FNS(INDEX, d); \
+    } else { \
+        M_unreachable("incompatible SQL type"); \
+    }
+    if constexpr(is_specialization<Index, idx::ArrayIndex>) {
+        RESOLVE_KEYTYPE(array)
+    } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
+        RESOLVE_KEYTYPE(rmi)
+    } else if constexpr(is_specialization<Index, idx::PiecewiseGeometricModelIndex>) {
+        RESOLVE_KEYTYPE(pgm)
+    } else {
+        M_unreachable("unknown index type");
+    }
+#undef RESOLVE_KEYTYPE
+#undef SET_CALLBACK_FNS
+
+    /*----- Add index to context. -----*/
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    const std::size_t index_id = context.add_index(index);
+
+    /*----- Allocate memory for communication to host. -----*/
+    /* A batch size of 0 is interpreted as infinity, i.e. as the number of rows of the inner relation. */
+    const std::size_t batch_size =
+        M.batch_size == 0 ? std::max<std::size_t>(M.scan.store().num_rows(), 1) : M.batch_size;
+    M_insist(std::in_range<uint32_t>(batch_size), "should fit in uint32_t");
+    uint32_t *buffer_address = Module::Allocator().raw_malloc<uint32_t>(batch_size);
+
+    /*----- Compute the remaining clauses of the join predicate, which are evaluated on each result tuple. -----*/
+    cnf::CNF residual;
+    for (auto &clause : M.join.predicate()) {
+        if (&clause != &key.clause)
+            residual.push_back(clause);
+    }
+
+    /*----- Emit code for the outer relation and probe the index with each outer tuple. -----*/
+    M.child->execute(
+        /* setup=    */ std::move(setup),
+        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
+            auto &env = CodeGenContext::Get().env();
+
+            auto compiled_key = env.compile(key.outer);
+            const Var<SqlT> outer_key(convert<SqlT>(compiled_key)); // introduce variable s.t. uses only load from it
+            IF (outer_key.val().not_null()) { // NULL keys never join and are not contained in the index
+                /*----- Emit host calls to query the index for the range of entries matching the key. -----*/
+                auto compile_lookup = [&](const char *fn) {
+                    return Module::Get().emit_call<uint32_t>(
+                        /* fn=       */ fn,
+                        /* index_id= */ U64x1(index_id),
+                        /* key=      */ outer_key.val().insist_not_null()
+                    );
+                };
+                Var<U32x1> lo(compile_lookup(lower_bound_fn));
+                const Var<U32x1> hi(compile_lookup(upper_bound_fn));
+
+                /*----- Emit loop code. -----*/
+                Var<U32x1> num_tuples_in_batch;
+                Var<Ptr<U32x1>> ptr;
+                WHILE (lo < hi) {
+                    num_tuples_in_batch = Select(hi - lo > uint32_t(batch_size), U32x1(uint32_t(batch_size)), hi - lo);
+                    /* Call host to fill buffer memory with next batch of tuple ids. */
+                    Module::Get().emit_call<void>(
+                        /* fn=           */ scan_fn,
+                        /* index_id=     */ U64x1(index_id),
+                        /* entry_offset= */ lo.val(),
+                        /* address=      */ Ptr<U32x1>(buffer_address),
+                        /* batch_size=   */ num_tuples_in_batch.val()
+                    );
+                    lo += num_tuples_in_batch;
+                    ptr = Ptr<U32x1>(buffer_address);
+                    WHILE(num_tuples_in_batch > 0U) {
+                        static Schema empty_schema;
+                        compile_load_point_access(
+                            /* tuple_value_schema=   */ M.scan.schema(),
+                            /* tuple_address_schema= */ empty_schema,
+                            /* base_address=         */ get_base_address(M.scan.store().table().name()),
+                            /* layout=               */ M.scan.store().table().layout(),
+                            /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
+                            /* tuple_id=             */ *ptr
+                        );
+                        if (residual.empty()) {
+                            pipeline();
+                        } else {
+                            IF (env.compile<_Boolx1>(residual).is_true_and_not_null()) {
+                                pipeline();
+                            };
+                        }
+                        num_tuples_in_batch -= 1U;
+                        ptr += 1;
+                    }
+                }
+            };
+        },
+        /* teardown= */ std::move(teardown)
+    );
+}
+
+/** Resolves the index method and calls the appropriate codegen function. */
+template<idx::IndexMethod IndexMethod, typename AttrT, sql_type SqlT>
+void index_nested_loops_join_resolve_index_method(const index_nested_loops_join_key_t &key,
+                                                  const Match<IndexNestedLoopsJoin<IndexMethod>> &M,
+                                                  setup_t setup, pipeline_t pipeline, teardown_t teardown)
 {
-    M_insist(post_cond_children.size() >= 2);
-
-    ConditionSet post_cond(post_cond_children.back().get()); // preserve conditions of right-most child
+    /*----- Lookup index. -----*/
+    auto &DB = Catalog::Get().get_database_in_use();
+    auto &index_base = DB.get_index(M.scan.store().table().name(), Schema::Identifier(key.inner).name, IndexMethod);
 
-    if constexpr (Predicated) {
-        /*----- Predicated nested-loops join introduces predication. -----*/
-        post_cond.add_or_replace_condition(m::Predicated(true));
+    /*----- Resolve index type. -----*/
+    if constexpr(IndexMethod == idx::IndexMethod::Array and requires { typename idx::ArrayIndex<AttrT>; }) {
+        index_nested_loops_join_codegen<IndexMethod, idx::ArrayIndex<AttrT>, SqlT>(
+            as<const idx::ArrayIndex<AttrT>>(index_base), key, M,
+            std::move(setup), std::move(pipeline), std::move(teardown)
+        );
+    } else if constexpr(IndexMethod == idx::IndexMethod::Rmi and requires { typename idx::RecursiveModelIndex<AttrT>; }) {
+        index_nested_loops_join_codegen<IndexMethod, idx::RecursiveModelIndex<AttrT>, SqlT>(
+            as<const idx::RecursiveModelIndex<AttrT>>(index_base), key, M,
+            std::move(setup), std::move(pipeline), std::move(teardown)
+        );
+    } else if constexpr(IndexMethod == idx::IndexMethod::Pgm and
+                        requires { typename idx::PiecewiseGeometricModelIndex<AttrT>; }) {
+        index_nested_loops_join_codegen<IndexMethod, idx::PiecewiseGeometricModelIndex<AttrT>, SqlT>(
+            as<const idx::PiecewiseGeometricModelIndex<AttrT>>(index_base), key, M,
+            std::move(setup), std::move(pipeline), std::move(teardown)
+        );
+    } else {
+        M_unreachable("invalid index method");
     }
-
-    return post_cond;
 }
 
-template<bool Predicated>
-double NestedLoopsJoin<Predicated>::cost(const Match<NestedLoopsJoin> &M)
+template<idx::IndexMethod IndexMethod>
+void IndexNestedLoopsJoin<IndexMethod>::execute(const Match<IndexNestedLoopsJoin> &M, setup_t setup,
+                                                pipeline_t pipeline, teardown_t teardown)
 {
-    double cost = 1;
-    for (auto &child : M.children)
-        cost *= child->get_matched_root().info().estimated_cardinality;
-    return cost;
-}
+    auto &schema = M.scan.schema();
+    M_insist(schema == schema.drop_constants().deduplicate(),
+             "Schema of `ScanOperator` must neither contain NULL nor duplicates");
 
-template<bool Predicated>
-void NestedLoopsJoin<Predicated>::execute(const Match<NestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline,
-                                          teardown_t teardown)
-{
-    const auto num_left_children = M.children.size() - 1; // all children but right-most one
+    auto &table = M.scan.store().table();
+    M_insist(not table.layout().is_finite(), "layout for `wasm::IndexNestedLoopsJoin` must be infinite");
 
-    std::vector<Schema> schemas; // to own adapted schemas
-    schemas.reserve(num_left_children);
-    std::vector<GlobalBuffer> buffers;
-    buffers.reserve(num_left_children);
+    /*----- Lookup join key. -----*/
+    auto key = find_index_nested_loops_join_key(M.join, M.scan, IndexMethod);
+    M_insist(bool(key), "index must exist");
 
-    /*----- Process all but right-most child. -----*/
-    for (std::size_t i = 0; i < num_left_children; ++i) {
-        /*----- Create function for each child. -----*/
-        FUNCTION(nested_loop_join_child_pipeline, void(void))
-        {
-            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+    /*----- Resolve key type. -----*/
+#define RESOLVE_INDEX_METHOD(ATTRTYPE, SQLTYPE) \
+    index_nested_loops_join_resolve_index_method<IndexMethod, ATTRTYPE, SQLTYPE>( \
+        *key, M, std::move(setup), std::move(pipeline), std::move(teardown) \
+    )
 
-            /*----- Create infinite buffer to materialize the current results. -----*/
-            M_insist(bool(M.materializing_factories_[i]),
-                     "`wasm::NestedLoopsJoin` must have a factory for each materialized child");
-            const auto &schema = schemas.emplace_back(
-                M.children[i]->get_matched_root().schema().drop_constants().deduplicate()
-            );
-            if (i == 0) {
-                /*----- Exactly one child (here left-most one) checks join predicate and resumes pipeline. -----*/
-                buffers.emplace_back(
-                    /* schema=        */ schema,
-                    /* factory=       */ *M.materializing_factories_[i],
-                    /* load_simdfied= */ false,
-                    /* num_tuples=    */ 0, // i.e. infinite
-                    /* setup=         */ setup_t::Make_Without_Parent(),
-                    /* pipeline=      */ [&, pipeline=std::move(pipeline)](){
-                        if constexpr (Predicated) {
-                            CodeGenContext::Get().env().add_predicate(M.join.predicate());
-                            pipeline();
-                        } else {
-                            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
-                            IF (CodeGenContext::Get().env().compile<_Boolx1>(M.join.predicate()).is_true_and_not_null()) {
-                                pipeline();
-                            };
-                        }
-                    },
-                    /* teardown=      */ teardown_t::Make_Without_Parent()
-                );
-            } else {
-                /*----- All but exactly one child (here left-most one) load lastly inserted buffer again. -----*/
-                /* All buffers are "connected" with each other by setting the pipeline callback as calling the
-                 * `resume_pipeline_inline()` method of the lastly inserted buffer. Therefore, calling
-                 * `resume_pipeline_inline()` on the lastly inserted buffer will load one tuple from it, recursively
-                 * call `resume_pipeline_inline()` on the buffer created before that which again loads one tuple from
-                 * it, and so on until the buffer inserted first (here the one of the left-most child) will load one
-                 * of its tuples and check the join predicate for this one cartesian-product-combination of result
-                 * tuples. */
-                buffers.emplace_back(
-                    /* schema=        */ schema,
-                    /* factory=       */ *M.materializing_factories_[i],
-                    /* load_simdfied= */ false,
-                    /* num_tuples=    */ 0, // i.e. infinite
-                    /* setup=         */ setup_t::Make_Without_Parent(),
-                    /* pipeline=      */ [&](){ buffers.back().resume_pipeline_inline(); },
-                    /* teardown=      */ teardown_t::Make_Without_Parent()
-                );
+    visit(overloaded {
+        [&](const Boolean&) { RESOLVE_INDEX_METHOD(bool, _Boolx1); },
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int:
+                case Numeric::N_Decimal:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case  8: RESOLVE_INDEX_METHOD(int8_t,   _I8x1); break;
+                        case 16: RESOLVE_INDEX_METHOD(int16_t, _I16x1); break;
+                        case 32: RESOLVE_INDEX_METHOD(int32_t, _I32x1); break;
+                        case 64: RESOLVE_INDEX_METHOD(int64_t, _I64x1); break;
+                    }
+                    break;
+                case Numeric::N_Float:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case 32: RESOLVE_INDEX_METHOD(float,   _Floatx1); break;
+                        case 64: RESOLVE_INDEX_METHOD(double, _Doublex1); break;
+                    }
+                    break;
             }
+        },
+        [&](const Date&) { RESOLVE_INDEX_METHOD(int32_t, _I32x1); },
+        [&](const DateTime&) { RESOLVE_INDEX_METHOD(int64_t, _I64x1); },
+        [](auto&&) { M_unreachable("invalid type"); },
+    }, *key->inner.type());
 
-            /*----- Materialize the current result tuple in pipeline. -----*/
-            M.children[i]->execute(
-                /* setup=    */ setup_t::Make_Without_Parent([&](){ buffers.back().setup(); }),
-                /* pipeline= */ [&](){ buffers.back().consume(); },
-                /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffers.back().teardown(); })
-            );
-        }
-        nested_loop_join_child_pipeline(); // call child function
-    }
-
-    /*----- Process right-most child. -----*/
-    M.children.back()->execute(
-        /* setup=    */ std::move(setup),
-        /* pipeline= */ [&](){ buffers.back().resume_pipeline_inline(); },
-        /* teardown= */ std::move(teardown)
-    );
+#undef RESOLVE_INDEX_METHOD
 }
 
 template<bool UniqueBuild, bool Predicated>
 ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::pre_condition(
-    std::size_t,
+    std::size_t child_idx,
     const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
 {
     ConditionSet pre_cond;
@@ -4730,21 +6035,32 @@ ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::pre_condition(
         }
     }
 
-    /*----- Simple hash join does not support SIMD. -----*/
-    pre_cond.add_condition(NoSIMD());
+    /*----- Simple hash join does not support SIMD on the build side and does only support SIMD on the probe side if it
+     * may consume the selection vector lane-wise. -----*/
+    if (child_idx == 0 or not options::simd_selection_vectors)
+        pre_cond.add_condition(NoSIMD());
 
     return pre_cond;
 }
 
 template<bool UniqueBuild, bool Predicated>
 ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::adapt_post_conditions(
-    const Match<SimpleHashJoin>&,
+    const Match<SimpleHashJoin> &M,
     std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
 {
     M_insist(post_cond_children.size() == 2);
 
     ConditionSet post_cond(post_cond_children[1].get()); // preserve conditions of right child
 
+    if (post_cond.has_condition<Sortedness>()) {
+        /*----- Join keys are equal in every result tuple, hence the probe side's order carries over to the build side's
+         * keys. -----*/
+        auto [keys_build, keys_probe] = decompose_equi_predicate(M.join.predicate(), M.build.schema());
+        auto &sortedness = post_cond.get_condition<Sortedness>();
+        for (std::size_t i = 0; i != keys_build.size(); ++i)
+            sortedness.add_equivalence(keys_build[i], keys_probe[i]);
+    }
+
     if constexpr (Predicated) {
         /*----- Predicated simple hash join introduces predication. -----*/
         post_cond.add_or_replace_condition(m::Predicated(true));
@@ -4753,6 +6069,10 @@ ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::adapt_post_conditions(
         post_cond.add_or_replace_condition(m::Predicated(false));
     }
 
+    /*----- Simple hash join does not introduce SIMD since the probe side is consumed lane-wise. -----*/
+    post_cond.remove_condition<SIMD>();
+    post_cond.add_or_replace_condition(NoSIMD());
+
     return post_cond;
 }
 
@@ -4859,77 +6179,104 @@ void SimpleHashJoin<UniqueBuild, Predicated>::execute(const Match<SimpleHashJoin
     }
     simple_hash_join_child_pipeline(); // call child function
 
-    M.children[1]->execute(
-        /* setup=    */ setup_t(std::move(setup), [&](){ ht->setup(); }),
-        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
-            auto &env = CodeGenContext::Get().env();
-
-            auto emit_tuple_and_resume_pipeline = [&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
-                /*----- Add found entry from hash table, i.e. from build child, to current environment. -----*/
-                for (auto &e : ht_schema) {
-                    if (not entry.has(e.id)) { // entry may not contain build key in case `ht->find()` was used
-                        M_insist(contains(build_keys, e.id));
-                        M_insist(env.has(e.id), "build key must already be contained in the current environment");
-                        continue;
-                    }
+    /*----- Create code to probe with a single tuple. -----*/
+    auto probe_tuple = [&, pipeline=std::move(pipeline)](){
+        auto &env = CodeGenContext::Get().env();
 
-                    std::visit(overloaded {
-                        [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
-                            Expr<T> value = r;
-                            if (value.can_be_null()) {
-                                Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
-                                env.add(e.id, var);
-                            } else {
-                                /* introduce variable w/o NULL bit s.t. uses only load from it */
-                                Var<PrimitiveExpr<T>> var(value.insist_not_null());
-                                env.add(e.id, Expr<T>(var));
-                            }
-                        },
-                        [&](HashTable::const_reference_t<NChar> &&r) -> void {
-                            NChar value(r);
-                            Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
-                            env.add(e.id, NChar(var, value.can_be_null(), value.length(),
-                                                value.guarantees_terminating_nul()));
-                        },
-                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                    }, entry.extract(e.id));
+        auto emit_tuple_and_resume_pipeline = [&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
+            /*----- Add found entry from hash table, i.e. from build child, to current environment. -----*/
+            for (auto &e : ht_schema) {
+                if (not entry.has(e.id)) { // entry may not contain build key in case `ht->find()` was used
+                    M_insist(contains(build_keys, e.id));
+                    M_insist(env.has(e.id), "build key must already be contained in the current environment");
+                    continue;
                 }
 
-                /*----- Resume pipeline. -----*/
-                pipeline();
-            };
+                std::visit(overloaded {
+                    [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
+                        Expr<T> value = r;
+                        if (value.can_be_null()) {
+                            Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                            env.add(e.id, var);
+                        } else {
+                            /* introduce variable w/o NULL bit s.t. uses only load from it */
+                            Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                            env.add(e.id, Expr<T>(var));
+                        }
+                    },
+                    [&](HashTable::const_reference_t<NChar> &&r) -> void {
+                        NChar value(r);
+                        Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                        env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                            value.guarantees_terminating_nul()));
+                    },
+                    [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                }, entry.extract(e.id));
+            }
 
-            /* TODO: may check for NULL on probe keys as well, branching + predicated version */
-            /*----- Probe with probe key. -----*/
-            std::vector<SQL_t> key;
-            for (auto &probe_key : probe_keys)
-                key.emplace_back(env.get(probe_key));
-            if constexpr (UniqueBuild) {
-                /*----- Add build key to current environment since `ht->find()` will only return the payload values. -----*/
-                for (auto build_it = build_keys.cbegin(), probe_it = probe_keys.cbegin(); build_it != build_keys.cend();
-                     ++build_it, ++probe_it)
-                {
-                    M_insist(probe_it != probe_keys.cend());
-                    if (not env.has(*build_it)) // skip duplicated build keys and only add first occurrence
-                        env.add(*build_it, env.get(*probe_it)); // since build and probe keys match for join partners
-                }
+            /*----- Resume pipeline. -----*/
+            pipeline();
+        };
 
-                /*----- Try to find the *single* possible join partner. -----*/
-                auto p = ht->find(std::move(key));
-                auto &entry = p.first;
-                auto &found = p.second;
-                if constexpr (Predicated) {
-                    env.add_predicate(found);
-                    emit_tuple_and_resume_pipeline(std::move(entry));
-                } else {
-                    IF (found) {
-                        emit_tuple_and_resume_pipeline(std::move(entry));
-                    };
-                }
+        /* TODO: may check for NULL on probe keys as well, branching + predicated version */
+        /*----- Probe with probe key. -----*/
+        std::vector<SQL_t> key;
+        for (auto &probe_key : probe_keys)
+            key.emplace_back(env.get(probe_key));
+        if constexpr (UniqueBuild) {
+            /*----- Add build key to current environment since `ht->find()` will only return the payload values. -----*/
+            for (auto build_it = build_keys.cbegin(), probe_it = probe_keys.cbegin(); build_it != build_keys.cend();
+                 ++build_it, ++probe_it)
+            {
+                M_insist(probe_it != probe_keys.cend());
+                if (not env.has(*build_it)) // skip duplicated build keys and only add first occurrence
+                    env.add(*build_it, env.get(*probe_it)); // since build and probe keys match for join partners
+            }
+
+            /*----- Try to find the *single* possible join partner. -----*/
+            auto p = ht->find(std::move(key));
+            auto &entry = p.first;
+            auto &found = p.second;
+            if constexpr (Predicated) {
+                env.add_predicate(found);
+                emit_tuple_and_resume_pipeline(std::move(entry));
             } else {
-                /*----- Search for *all* join partners. -----*/
-                ht->for_each_in_equal_range(std::move(key), std::move(emit_tuple_and_resume_pipeline), Predicated);
+                IF (found) {
+                    emit_tuple_and_resume_pipeline(std::move(entry));
+                };
+            }
+        } else {
+            /*----- Search for *all* join partners. -----*/
+            ht->for_each_in_equal_range(std::move(key), std::move(emit_tuple_and_resume_pipeline), Predicated);
+        }
+    };
+
+    M.children[1]->execute(
+        /* setup=    */ setup_t(std::move(setup), [&](){ ht->setup(); }),
+        /* pipeline= */ [&](){
+            const auto num_simd_lanes = CodeGenContext::Get().num_simd_lanes();
+            if (num_simd_lanes == 1) {
+                probe_tuple();
+                return;
             }
+
+            /*----- Compute the hashes of the probe keys of all SIMD lanes at once, if possible. -----*/
+            std::vector<const Type*> key_types;
+            for (auto &build_key : build_keys)
+                key_types.push_back(ht_schema[build_key].second.type);
+            void *hashes = nullptr;
+            if (is_simd_hashable(key_types))
+                hashes = precompute_simd_hashes(key_types.front(), CodeGenContext::Get().env().get(probe_keys.front()));
+
+            /*----- Probe with each qualifying tuple of the SIMD vectors individually.  There is no gather in
+             * WebAssembly SIMD, hence the hash table is probed by scalar code per lane. -----*/
+            for_each_qualifying_lane([&](U32x1 lane){
+                if (hashes)
+                    ht->set_precomputed_hash(*(Ptr<void>(hashes).template to<uint64_t*>() + lane.make_signed()));
+                else
+                    lane.discard();
+                probe_tuple();
+            });
         },
         /* teardown= */ teardown_t(std::move(teardown), [&](){ ht->teardown(); })
     );
@@ -5017,34 +6364,44 @@ ConditionSet SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::adap
     /*----- Sort merge join does not introduce SIMD. -----*/
     post_cond.add_condition(NoSIMD());
 
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    auto [keys_parent, keys_child] = decompose_equi_predicate(M.join.predicate(), M.parent.schema());
+
     Sortedness::order_t orders;
+    Sortedness::equivalences_t equivalences;
     if constexpr (not SortLeft) {
         Sortedness sorting_left(post_cond_children[0].get().get_condition<Sortedness>());
         orders.merge(sorting_left.orders()); // preserve sortedness of left child (including order)
+        equivalences = sorting_left.equivalences();
     }
     if constexpr (not SortRight) {
         Sortedness sorting_right(post_cond_children[1].get().get_condition<Sortedness>());
         orders.merge(sorting_right.orders()); // preserve sortedness of right child (including order)
+        equivalences.insert(equivalences.end(), sorting_right.equivalences().cbegin(),
+                            sorting_right.equivalences().cend());
     }
-    if constexpr (SortLeft or SortRight) {
-        /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
-        auto [keys_parent, keys_child] = decompose_equi_predicate(M.join.predicate(), M.parent.schema());
 
-        /*----- Sort merge join does sort the data on the respective key. -----*/
-        if constexpr (SortLeft) {
-            for (auto &key_parent : keys_parent) {
-                if (orders.find(key_parent) == orders.cend())
-                    orders.add(key_parent, Sortedness::O_ASC); // add sortedness for left child
-            }
+    /*----- Sort merge join does sort the data on the respective key. -----*/
+    if constexpr (SortLeft) {
+        for (auto &key_parent : keys_parent) {
+            if (orders.find(key_parent) == orders.cend())
+                orders.add(key_parent, Sortedness::O_ASC); // add sortedness for left child
         }
-        if constexpr (SortRight) {
-            for (auto &key_child : keys_child) {
-                if (orders.find(key_child) == orders.cend())
-                    orders.add(key_child, Sortedness::O_ASC); // add sortedness for right child
-            }
+    }
+    if constexpr (SortRight) {
+        for (auto &key_child : keys_child) {
+            if (orders.find(key_child) == orders.cend())
+                orders.add(key_child, Sortedness::O_ASC); // add sortedness for right child
         }
     }
-    post_cond.add_condition(Sortedness(std::move(orders)));
+
+    /*----- Join keys are equal in every result tuple, hence they share their position in the sort order.  This way,
+     * subsequent operators may exploit the order on either key, e.g. a sort merge join on `B.y` after joining on
+     * `A.x = B.y`. -----*/
+    Sortedness sortedness(std::move(orders), std::move(equivalences));
+    for (std::size_t i = 0; i != keys_parent.size(); ++i)
+        sortedness.add_equivalence(keys_parent[i], keys_child[i]);
+    post_cond.add_condition(std::move(sortedness));
 
     return post_cond;
 }
@@ -5072,8 +6429,8 @@ void SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
     teardown_t teardown)
 {
     auto &env = CodeGenContext::Get().env();
-    const bool needs_buffer_parent = not is<const ScanOperator>(M.parent) or SortLeft;
-    const bool needs_buffer_child  = not is<const ScanOperator>(M.child) or SortRight;
+    const bool needs_buffer_parent = not is<const ScanOperator>(M.parent) or is_chunked_scan(M.parent) or SortLeft;
+    const bool needs_buffer_child  = not is<const ScanOperator>(M.child) or is_chunked_scan(M.child) or SortRight;
 
     /*----- Create infinite buffers to materialize the current results (if necessary). -----*/
     M_insist(bool(M.left_materializing_factory),
@@ -6079,10 +7436,22 @@ void Match<m::wasm::IndexScan<IndexMethod>>::print(std::ostream &out, unsigned l
         indent(out, level) << "wasm::ArrayIndexScan(";
     else if (IndexMethod == idx::IndexMethod::Rmi)
         indent(out, level) << "wasm::RecursiveModelIndexScan(";
+    else if (IndexMethod == idx::IndexMethod::Pgm)
+        indent(out, level) << "wasm::PiecewiseGeometricModelIndexScan(";
+    else if (IndexMethod == idx::IndexMethod::Composite)
+        indent(out, level) << "wasm::CompositeIndexScan(";
     else
         M_unreachable("unknown index");
 
-    if (options::index_scan_strategy == option_configs::IndexScanStrategy::COMPILATION) {
+    if (IndexMethod == idx::IndexMethod::Composite) {
+        out << "Interpretation["; // the range of composite indexes is always interpreted, see `execute()`
+        if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::INLINE)
+            out << "Inline";
+        else if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::MEMORY)
+            out << "Memory";
+        else
+            M_unreachable("unknown materialization strategy");
+    } else if (options::index_scan_strategy == option_configs::IndexScanStrategy::COMPILATION) {
         out << "Compilation[";
         if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::CALLBACK)
             out << "Callback";
@@ -6158,8 +7527,10 @@ void Match<m::wasm::Projection>::print(std::ostream &out, unsigned level) const
 
 void Match<m::wasm::HashBasedGrouping>::print(std::ostream &out, unsigned level) const
 {
-    indent(out, level) << "wasm::HashBasedGrouping " << this->grouping.schema() << print_info(this->grouping)
-                       << " (cumulative cost " << cost() << ')';
+    indent(out, level) << "wasm::HashBasedGrouping ";
+    if (this->child->simdfied())
+        out << "consuming SIMD vectors lane-wise ";
+    out << this->grouping.schema() << print_info(this->grouping) << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
@@ -6208,11 +7579,35 @@ void Match<m::wasm::NestedLoopsJoin<Predicated>>::print(std::ostream &out, unsig
     }
 }
 
+template<idx::IndexMethod IndexMethod>
+void Match<m::wasm::IndexNestedLoopsJoin<IndexMethod>>::print(std::ostream &out, unsigned level) const
+{
+    if (IndexMethod == idx::IndexMethod::Array)
+        indent(out, level) << "wasm::ArrayIndexNestedLoopsJoin(";
+    else if (IndexMethod == idx::IndexMethod::Rmi)
+        indent(out, level) << "wasm::RecursiveModelIndexNestedLoopsJoin(";
+    else if (IndexMethod == idx::IndexMethod::Pgm)
+        indent(out, level) << "wasm::PiecewiseGeometricModelIndexNestedLoopsJoin(";
+    else
+        M_unreachable("unknown index");
+    out << this->scan.alias() << ") ";
+    if (this->buffer_factory_ and this->join.schema().drop_constants().deduplicate().num_entries())
+        out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
+    out << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    indent(out, level) << "inner input " << this->scan.schema() << print_info(this->scan);
+    indent(out, level) << "outer input";
+    this->child->print(out, level + 1);
+}
+
 template<bool Unique, bool Predicated>
 void Match<m::wasm::SimpleHashJoin<Unique, Predicated>>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::" << (Predicated ? "Predicated" : "") << "SimpleHashJoin";
     if (Unique) out << " on UNIQUE key ";
+    if (this->children[1]->simdfied())
+        out << " consuming SIMD vectors lane-wise ";
     if (this->buffer_factory_ and this->join.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
     out << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
@@ -6238,8 +7633,8 @@ void Match<m::wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated
         case 2: out << "sorting left input " << (CmpPredicated ? "predicated " : ""); break;
         case 3: out << "sorting both inputs " << (CmpPredicated ? "predicated " : ""); break;
     }
-    const bool needs_buffer_parent = not is<const ScanOperator>(this->parent) or SortLeft;
-    const bool needs_buffer_child  = not is<const ScanOperator>(this->child) or SortRight;
+    const bool needs_buffer_parent = not is<const ScanOperator>(this->parent) or is_chunked_scan(this->parent) or SortLeft;
+    const bool needs_buffer_child  = not is<const ScanOperator>(this->child) or is_chunked_scan(this->child) or SortRight;
     if (needs_buffer_parent and needs_buffer_child)
         out << "and materializing both inputs ";
     else if (needs_buffer_parent)
@@ -38,16 +38,19 @@ enum class SortingImplementation : uint64_t {
 };
 
 enum class JoinImplementation : uint64_t {
-    ALL          = 0b111,
-    NESTED_LOOPS = 0b001,
-    SIMPLE_HASH  = 0b010,
-    SORT_MERGE   = 0b100,
+    ALL                = 0b1111,
+    NESTED_LOOPS       = 0b0001,
+    SIMPLE_HASH        = 0b0010,
+    SORT_MERGE         = 0b0100,
+    INDEX_NESTED_LOOPS = 0b1000,
 };
 
 enum class IndexImplementation : uint64_t {
-    ALL   = 0b11,
-    ARRAY = 0b01,
-    RMI   = 0b10,
+    ALL       = 0b1111,
+    ARRAY     = 0b0001,
+    RMI       = 0b0010,
+    COMPOSITE = 0b0100,
+    PGM       = 0b1000,
 };
 
 enum class SoftPipelineBreakerStrategy : uint64_t {
@@ -206,6 +209,21 @@ inline std::size_t soft_pipeline_breaker_num_tuples = 0;
  * all results are communicated in a single batch. */
 inline std::size_t index_sequential_scan_batch_size = 1;
 
+/** The fraction of the visible rows of a table qualifying for an index scan above which the index scan is replaced by
+ * a sequential scan with a filter, once the number of qualifying rows is known.  1 means that index scans are never
+ * replaced.  The number of qualifying rows is only known when the range of the index scan is interpreted at query
+ * compilation, hence index scans with `IndexScanStrategy::COMPILATION` are never replaced.
+ *
+ * Loading a row by its tuple ID costs about one cache miss, i.e. roughly 100 ns, whereas a sequential scan streams a
+ * row and evaluates the filter on it in a few nanoseconds.  Hence, an index scan only pays off if at most a few percent
+ * of the rows qualify.  Replaced index scans may produce their rows in the order of the table, hence their sortedness
+ * is not exploited by the optimizer unless this is 1. */
+inline double index_scan_max_selectivity = 0.05;
+
+/** Whether index scans sort the tuple IDs of the qualifying rows, such that rows are accessed in the order of the
+ * table rather than in the order of the index. */
+inline bool index_scan_sort_tuple_ids = false;
+
 /** Which window size should be used for the result set. */
 inline std::size_t result_set_window_size = 0;
 
@@ -221,6 +239,21 @@ inline bool double_pumping = true;
 /** Which number of SIMD lanes to prefer. */
 inline std::size_t simd_lanes = 1;
 
+/** Whether hash-based grouping and the probe side of hash joins consume SIMDfied pipelines lane-wise using the
+ * selection vector instead of requiring their child pipelines to not be SIMDfied.  Only the hashes of the keys are
+ * computed for all SIMD lanes at once.  WebAssembly SIMD provides no gather, hence the hash table is accessed by
+ * scalar code once per qualifying lane, see `for_each_qualifying_lane()`. */
+inline bool simd_selection_vectors = true;
+
+/** Whether scans may skip blocks of rows that the zone map of the scanned store proves to not satisfy the filter above
+ * the scan. */
+inline bool zone_maps = true;
+
+/** Whether scans may skip blocks of rows of multi-versioned tables that are invisible to the transaction of the scan
+ * and whether filters may omit the timestamp clauses for blocks of rows that are visible, as determined by the
+ * visibility summary of the scanned store. */
+inline bool visibility_summaries = true;
+
 /** Which attributes are assumed to be sorted.  For each entry, the first element is the name of the attribute and the
  * second one is `true` iff the attribute is sorted ascending and vice versa. */
 inline std::vector<std::pair<m::Schema::Identifier, bool>> sorted_attributes;
@@ -250,12 +283,17 @@ namespace m {
     X(Scan<true>) \
     X(IndexScan<m::idx::IndexMethod::Array>) \
     X(IndexScan<m::idx::IndexMethod::Rmi>) \
+    X(IndexScan<m::idx::IndexMethod::Pgm>) \
+    X(IndexScan<m::idx::IndexMethod::Composite>) \
     X(Filter<false>) \
     X(Filter<true>) \
     X(Quicksort<false>) \
     X(Quicksort<true>) \
     X(NestedLoopsJoin<false>) \
     X(NestedLoopsJoin<true>) \
+    X(IndexNestedLoopsJoin<m::idx::IndexMethod::Array>) \
+    X(IndexNestedLoopsJoin<m::idx::IndexMethod::Rmi>) \
+    X(IndexNestedLoopsJoin<m::idx::IndexMethod::Pgm>) \
     X(SimpleHashJoin<M_COMMA(false) false>) \
     X(SimpleHashJoin<M_COMMA(false) true>) \
     X(SimpleHashJoin<M_COMMA(true) false>) \
@@ -292,12 +330,17 @@ namespace m {
     X(m::Match<m::wasm::Scan<true>>) \
     X(m::Match<m::wasm::IndexScan<m::idx::IndexMethod::Array>>) \
     X(m::Match<m::wasm::IndexScan<m::idx::IndexMethod::Rmi>>) \
+    X(m::Match<m::wasm::IndexScan<m::idx::IndexMethod::Pgm>>) \
+    X(m::Match<m::wasm::IndexScan<m::idx::IndexMethod::Composite>>) \
     X(m::Match<m::wasm::Filter<false>>) \
     X(m::Match<m::wasm::Filter<true>>) \
     X(m::Match<m::wasm::Quicksort<false>>) \
     X(m::Match<m::wasm::Quicksort<true>>) \
     X(m::Match<m::wasm::NestedLoopsJoin<false>>) \
     X(m::Match<m::wasm::NestedLoopsJoin<true>>) \
+    X(m::Match<m::wasm::IndexNestedLoopsJoin<m::idx::IndexMethod::Array>>) \
+    X(m::Match<m::wasm::IndexNestedLoopsJoin<m::idx::IndexMethod::Rmi>>) \
+    X(m::Match<m::wasm::IndexNestedLoopsJoin<m::idx::IndexMethod::Pgm>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(false) false>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(false) true>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(true) false>>) \
@@ -350,6 +393,9 @@ template<bool CmpPredicated> struct Match<wasm::Quicksort<CmpPredicated>>;
 namespace wasm { template<bool Predicated> struct NestedLoopsJoin; }
 template<bool Predicated> struct Match<wasm::NestedLoopsJoin<Predicated>>;
 
+namespace wasm { template<idx::IndexMethod IndexMethod> struct IndexNestedLoopsJoin; }
+template<idx::IndexMethod IndexMethod> struct Match<wasm::IndexNestedLoopsJoin<IndexMethod>>;
+
 namespace wasm { template<bool UniqueBuild, bool Predicated> struct SimpleHashJoin; }
 template<bool UniqueBuild, bool Predicated> struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>>;
 
@@ -388,7 +434,7 @@ template<bool SIMDfied>
 struct Scan : PhysicalOperator<Scan<SIMDfied>, ScanOperator>
 {
     static void execute(const Match<Scan> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
-    static double cost(const Match<Scan>&) { return M_CONSTEXPR_COND(SIMDfied, 1.0, 2.0); }
+    static double cost(const Match<Scan> &M);
     static ConditionSet pre_condition(std::size_t child_idx,
                                       const std::tuple<const ScanOperator*> &partial_inner_nodes);
     static ConditionSet post_condition(const Match<Scan> &M);
@@ -404,6 +450,17 @@ struct IndexScan : PhysicalOperator<IndexScan<IndexMethod>, pattern_t<FilterOper
     static ConditionSet post_condition(const Match<IndexScan> &M);
 };
 
+/* An index scan on a `idx::CompositeIndex` evaluates an equality predicate on a prefix of the key attributes followed
+ * by an optional range predicate on the next key attribute. */
+template<>
+void IndexScan<idx::IndexMethod::Composite>::execute(const Match<IndexScan> &M, setup_t setup, pipeline_t pipeline,
+                                                      teardown_t teardown);
+template<>
+ConditionSet IndexScan<idx::IndexMethod::Composite>::pre_condition(
+    std::size_t child_idx, const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes);
+template<>
+ConditionSet IndexScan<idx::IndexMethod::Composite>::post_condition(const Match<IndexScan> &M);
+
 template<bool Predicated>
 struct Filter : PhysicalOperator<Filter<Predicated>, FilterOperator>
 {
@@ -528,6 +585,23 @@ struct NestedLoopsJoin : PhysicalOperator<NestedLoopsJoin<Predicated>, JoinOpera
                           std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
 };
 
+/* An index nested-loops join probes an index on the join key of its inner relation, which must be scanned directly,
+ * with the join key of each tuple of its outer relation.  Hence, the inner relation is neither scanned nor
+ * materialized. */
+template<idx::IndexMethod IndexMethod>
+struct IndexNestedLoopsJoin
+    : PhysicalOperator<IndexNestedLoopsJoin<IndexMethod>, pattern_t<JoinOperator, Wildcard, ScanOperator>>
+{
+    static void execute(const Match<IndexNestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline,
+                        teardown_t teardown);
+    static double cost(const Match<IndexNestedLoopsJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const Wildcard*, const ScanOperator*> &partial_inner_nodes);
+    static ConditionSet adapt_post_condition(const Match<IndexNestedLoopsJoin> &M,
+                                             const ConditionSet &post_cond_child);
+};
+
 template<bool UniqueBuild, bool Predicated>
 struct SimpleHashJoin
     : PhysicalOperator<SimpleHashJoin<UniqueBuild, Predicated>, pattern_t<JoinOperator, Wildcard, Wildcard>>
@@ -615,6 +689,16 @@ struct MatchBase : m::MatchBase
 {
     virtual void accept(MatchBaseVisitor &v) = 0;
     virtual void accept(ConstMatchBaseVisitor &v) const = 0;
+
+    /** Returns `true` iff the pipeline of this match produces SIMD vectors, i.e. multiple tuples at once. */
+    virtual bool simdfied() const { return false; }
+
+    /** Executes this match by `execute_operator()`.  If the `WasmContext` collects feedback, additionally emits code to
+     * count the tuples this match produces and to time the pipelines it begins, see `WasmContext::feedback_t`. */
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const final;
+
+    /** Executes the physical operator of this match, see `m::MatchBase::execute()`. */
+    virtual void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const = 0;
 };
 
 /** Intermediate match type for leaves, i.e. physical operator matches without children. */
@@ -659,7 +743,7 @@ struct Match<wasm::NoOp> : wasm::MatchSingleChild
         , noop(*noop)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::NoOp::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -685,7 +769,7 @@ struct Match<wasm::Callback<SIMDfied>> : wasm::MatchSingleChild
         , callback(*callback)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Callback<SIMDfied>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -711,7 +795,7 @@ struct Match<wasm::Print<SIMDfied>> : wasm::MatchSingleChild
         , print_op(*print)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Print<SIMDfied>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -742,7 +826,7 @@ struct Match<wasm::Scan<SIMDfied>> : wasm::MatchLeaf
         M_insist(children.empty());
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         if (buffer_factory_) {
             auto buffer_schema = scan.schema().drop_constants().deduplicate();
             if (buffer_schema.num_entries()) {
@@ -767,6 +851,7 @@ struct Match<wasm::Scan<SIMDfied>> : wasm::MatchLeaf
     }
 
     const Operator & get_matched_root() const override { return scan; }
+    bool simdfied() const override { return SIMDfied; }
 
     void accept(wasm::MatchBaseVisitor &v) override;
     void accept(wasm::ConstMatchBaseVisitor &v) const override;
@@ -797,7 +882,7 @@ struct Match<wasm::IndexScan<IndexMethod>> : wasm::MatchLeaf
         M_insist(children.empty());
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -828,12 +913,13 @@ struct Match<wasm::Filter<Predicated>> : wasm::MatchSingleChild
         , filter(*filter)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
     const Operator & get_matched_root() const override { return filter; }
+    bool simdfied() const override { return Predicated and child->simdfied(); }
 
     void accept(wasm::MatchBaseVisitor &v) override;
     void accept(wasm::ConstMatchBaseVisitor &v) const override;
@@ -859,7 +945,7 @@ struct Match<wasm::LazyDisjunctiveFilter> : wasm::MatchSingleChild
         , filter(*filter)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -895,12 +981,13 @@ struct Match<wasm::Projection> : wasm::MatchBase
         }
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, projection.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
     const Operator & get_matched_root() const override { return projection; }
+    bool simdfied() const override { return child and (*child)->simdfied(); }
 
     void accept(wasm::MatchBaseVisitor &v) override;
     void accept(wasm::ConstMatchBaseVisitor &v) const override;
@@ -925,7 +1012,7 @@ struct Match<wasm::HashBasedGrouping> : wasm::MatchSingleChild
         , grouping(*grouping)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::HashBasedGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -948,7 +1035,7 @@ struct Match<wasm::OrderedGrouping> : wasm::MatchSingleChild
         , grouping(*grouping)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::OrderedGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -971,7 +1058,7 @@ struct Match<wasm::Aggregation> : wasm::MatchSingleChild
         , aggregation(*aggregation)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Aggregation::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -996,7 +1083,7 @@ struct Match<wasm::Quicksort<CmpPredicated>> : wasm::MatchSingleChild
         , sorting(*sorting)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Quicksort<CmpPredicated>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1019,7 +1106,7 @@ struct Match<wasm::NoOpSorting> : wasm::MatchSingleChild
         , sorting(*sorting)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::NoOpSorting::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1053,7 +1140,44 @@ struct Match<wasm::NestedLoopsJoin<Predicated>> : wasm::MatchMultipleChildren
             materializing_factories_.push_back(M_notnull(options::hard_pipeline_breaker_layout.get())->clone());
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        execute_buffered(*this, join.schema(), buffer_factory_, buffer_num_tuples_,
+                         std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<idx::IndexMethod IndexMethod>
+struct Match<wasm::IndexNestedLoopsJoin<IndexMethod>> : wasm::MatchSingleChild
+{
+    const JoinOperator &join;
+    const Wildcard &outer;
+    const ScanOperator &scan;
+    std::size_t batch_size = options::index_sequential_scan_batch_size;
+    private:
+    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
+        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_NESTED_LOOPS_JOIN)
+            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
+            : std::unique_ptr<storage::DataLayoutFactory>();
+    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+
+    public:
+    Match(const JoinOperator *join, const Wildcard *outer, const ScanOperator *scan,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , join(*join)
+        , outer(*outer)
+        , scan(*scan)
+    { }
+
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, join.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -1097,7 +1221,7 @@ struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>> : wasm::MatchMultipl
         M_insist(children.size() == 2);
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, join.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -1132,7 +1256,7 @@ struct Match<wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>
         M_insist(children.size() == 2);
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
             *this, std::move(setup), std::move(pipeline), std::move(teardown)
         );
@@ -1157,7 +1281,7 @@ struct Match<wasm::Limit> : wasm::MatchSingleChild
         , limit(*limit)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Limit::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1202,7 +1326,7 @@ struct Match<wasm::HashBasedGroupJoin> : wasm::MatchMultipleChildren
         M_insist(children.size() == 2);
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_operator(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, grouping.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -280,6 +280,69 @@ void ExprCompiler::operator()(const ast::UnaryExpr &e)
 #undef UNOP
 }
 
+bool ExprCompiler::compile_dictionary_comparison(const ast::BinaryExpr &e)
+{
+    /*----- Match a designator of a dictionary-encoded attribute compared to a non-NULL constant. -----*/
+    auto designator = cast<const ast::Designator>(e.lhs.get());
+    auto constant = cast<const ast::Constant>(e.rhs.get());
+    bool is_swapped = false;
+    if (not designator or not constant) {
+        designator = cast<const ast::Designator>(e.rhs.get());
+        constant = cast<const ast::Constant>(e.lhs.get());
+        is_swapped = true;
+    }
+    if (not designator or not constant or designator->type()->is_none() or constant->type()->is_none())
+        return false;
+    Schema::Identifier id(designator->table_name.text, designator->attr_name.text.assert_not_none());
+    auto dict = env_.dictionary(id);
+    if (not dict)
+        return false;
+
+    /*----- Normalize the comparison to `designator op constant`. -----*/
+    auto op = e.op().type;
+    if (is_swapped) {
+        switch (op) {
+            default:                                          break;
+            case TK_LESS:           op = TK_GREATER;          break;
+            case TK_LESS_EQUAL:     op = TK_GREATER_EQUAL;    break;
+            case TK_GREATER:        op = TK_LESS;             break;
+            case TK_GREATER_EQUAL:  op = TK_LESS_EQUAL;       break;
+        }
+    }
+    if (op != TK_EQUAL and op != TK_BANG_EQUAL and not dict->is_order_preserving())
+        return false; // range predicates require order-preserving codes
+
+    /*----- Compare the code to the code or the code bounds of the constant. -----*/
+    auto value = Interpreter::eval(*constant).as<const char*>();
+    U32x1 code = env_.get_code(id);
+    Boolx1 cmp = [&]() -> Boolx1 {
+        switch (op) {
+            default:
+                M_unreachable("invalid comparison operator");
+            case TK_EQUAL:
+            case TK_BANG_EQUAL:
+                if (auto c = dict->find(value))
+                    return op == TK_EQUAL ? code == *c : code != *c;
+                code.discard();
+                return Boolx1(op == TK_BANG_EQUAL); // value does not occur in the dictionary
+            case TK_LESS:           return code <  dict->lower_bound(value);
+            case TK_LESS_EQUAL:     return code <  dict->upper_bound(value);
+            case TK_GREATER:        return code >= dict->upper_bound(value);
+            case TK_GREATER_EQUAL:  return code >= dict->lower_bound(value);
+        }
+    }();
+
+    /*----- Combine with the NULL information of the designated value. -----*/
+    NChar str = env_.get<NChar>(id);
+    if (str.can_be_null())
+        set(_Boolx1(cmp, str.is_null()));
+    else {
+        str.discard();
+        set(_Boolx1(cmp));
+    }
+    return true;
+}
+
 void ExprCompiler::operator()(const ast::BinaryExpr &e)
 {
     /* This is a helper to apply binary operations to `Expr<T>`s.  It uses SFINAE within `overloaded` to only apply the
@@ -321,6 +384,8 @@ void ExprCompiler::operator()(const ast::BinaryExpr &e)
         if (e.lhs->type()->is_character_sequence()) { \
             M_insist(e.rhs->type()->is_character_sequence()); \
             M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes"); \
+            if (compile_dictionary_comparison(e)) \
+                break; \
             apply_binop( \
                 [](NChar lhs, NChar rhs) -> _Boolx1 { \
                     return strcmp(lhs, rhs, STRCMP_OP); \
@@ -434,8 +499,22 @@ void ExprCompiler::operator()(const ast::FnApplicationExpr &e)
         default:
             M_unreachable("function kind not implemented");
 
-        case m::Function::FN_UDF:
-            M_unreachable("UDFs not yet supported");
+        case m::Function::FN_UDF: {
+            auto &udf = as<const ScalarUDF>(e.get_function());
+            auto body = get_udf_body(udf.name);
+            if (not body)
+                throw backend_exception("user-defined function has no Wasm body");
+            std::vector<SQL_t> args;
+            for (std::size_t i = 0; i != e.args.size(); ++i) {
+                (*this)(*e.args[i]);
+                auto arg = get();
+                if (auto n = cast<const Numeric>(udf.parameter_types[i]))
+                    convert_in_place(arg, n);
+                args.push_back(std::move(arg));
+            }
+            set((*body)(std::move(args)));
+            break;
+        }
 
         /*----- NULL check -------------------------------------------------------------------------------------------*/
         case m::Function::FN_ISNULL: {
@@ -521,6 +600,35 @@ void Environment::dump() const { dump(std::cerr); }
 M_LCOV_EXCL_STOP
 
 
+/*======================================================================================================================
+ * User-defined functions
+ *====================================================================================================================*/
+
+namespace {
+
+/** Returns the Wasm DSL bodies of user-defined functions by name. */
+std::unordered_map<ThreadSafePooledString, udf_body_t> & udf_bodies()
+{
+    static std::unordered_map<ThreadSafePooledString, udf_body_t> bodies;
+    return bodies;
+}
+
+}
+
+void m::wasm::register_udf_body(ThreadSafePooledString name, udf_body_t body)
+{
+    auto res = udf_bodies().emplace(std::move(name), std::move(body));
+    if (not res.second)
+        throw invalid_argument("Wasm body of the user-defined function already registered");
+}
+
+const udf_body_t * m::wasm::get_udf_body(const ThreadSafePooledString &name)
+{
+    auto it = udf_bodies().find(name);
+    return it == udf_bodies().end() ? nullptr : &it->second;
+}
+
+
 /*======================================================================================================================
  * CodeGenContext
  *====================================================================================================================*/
@@ -528,6 +636,109 @@ M_LCOV_EXCL_STOP
 thread_local std::unique_ptr<CodeGenContext> CodeGenContext::the_context_;
 
 
+/*======================================================================================================================
+ * SIMD lanes
+ *====================================================================================================================*/
+
+void m::wasm::for_each_qualifying_lane(const std::function<void(U32x1)> &Pipeline)
+{
+    auto execute = [&]<std::size_t L>(){
+        auto &env = CodeGenContext::Get().env();
+
+        /*----- Compute the selection vector, i.e. the bitmask of the lanes fulfilling the predication predicate. -----*/
+        Var<U32x1> selection(std::numeric_limits<uint32_t>::max() >> (32 - L)); // all lanes qualify
+        if (env.predicated()) {
+            if constexpr (sql_boolean_type<_Bool<L>>)
+                selection = env.extract_predicate<_Bool<L>>().is_true_and_not_null().bitmask();
+            else
+                M_unreachable("invalid number of SIMD lanes");
+        }
+
+        /*----- Spill vectorial values to pre-allocated memory s.t. the value of a single lane can be loaded. -----*/
+        Environment scalars; ///< scalar values, valid for every lane
+        std::vector<std::function<void(Environment&, U32x1)>> loaders; ///< adds the value of a lane to an environment
+        for (auto &id : env.ids()) {
+            std::visit(overloaded {
+                [&]<typename T, std::size_t M>(Expr<T, M> value) -> void {
+                    if constexpr (M == 1) {
+                        scalars.add(id, value);
+                    } else if constexpr (M == L) {
+                        uint32_t *null_bits = nullptr;
+                        const bool can_be_null = value.can_be_null();
+                        auto [val, is_null] = value.split();
+                        if (can_be_null) {
+                            null_bits = Module::Allocator().raw_malloc<uint32_t>();
+                            *Ptr<U32x1>(null_bits) = is_null.bitmask();
+                        } else {
+                            is_null.discard();
+                        }
+
+                        if constexpr (std::same_as<T, bool>) {
+                            /*----- Spill booleans as bitmask. -----*/
+                            uint32_t *bits = Module::Allocator().raw_malloc<uint32_t>();
+                            *Ptr<U32x1>(bits) = val.bitmask();
+                            loaders.emplace_back([id, bits, null_bits](Environment &lane_env, U32x1 lane) {
+                                Boolx1 v = ((*Ptr<U32x1>(bits) >> lane.clone()) bitand 1U) != 0U;
+                                if (null_bits) {
+                                    Boolx1 v_is_null = ((*Ptr<U32x1>(null_bits) >> lane) bitand 1U) != 0U;
+                                    lane_env.add(id, _Boolx1(v, v_is_null));
+                                } else {
+                                    lane.discard();
+                                    lane_env.add(id, _Boolx1(v));
+                                }
+                            });
+                        } else {
+                            /*----- Spill values as whole vectors, i.e. lane `i` is located at the `i`-th element. -----*/
+                            void *values = Module::Allocator().raw_allocate(L * sizeof(T), 16);
+                            *Ptr<void>(values).template to<T*, L>() = val;
+                            loaders.emplace_back([id, values, null_bits](Environment &lane_env, U32x1 lane) {
+                                Ptr<PrimitiveExpr<T>> ptr = Ptr<void>(values).template to<T*>();
+                                PrimitiveExpr<T> v = *(ptr + lane.clone().make_signed());
+                                if (null_bits) {
+                                    Boolx1 v_is_null = ((*Ptr<U32x1>(null_bits) >> lane) bitand 1U) != 0U;
+                                    lane_env.add(id, Expr<T>(v, v_is_null));
+                                } else {
+                                    lane.discard();
+                                    lane_env.add(id, Expr<T>(v));
+                                }
+                            });
+                        }
+                    } else {
+                        M_unreachable("number of SIMD lanes of value does not match the current one");
+                    }
+                },
+                [&](NChar value) -> void { scalars.add(id, value); },
+                [](std::monostate) -> void { M_unreachable("invalid expression"); },
+            }, env.get(id));
+        }
+
+        /*----- Resume pipeline for each qualifying lane, i.e. for each set bit of the selection vector. -----*/
+        CodeGenContext::Get().set_num_simd_lanes(1);
+        WHILE (selection != 0U) {
+            const Var<U32x1> lane(selection.val().ctz());
+            Environment lane_env;
+            lane_env.add(std::move(scalars));
+            for (auto &load : loaders)
+                load(lane_env, lane.val());
+            {
+                auto S = CodeGenContext::Get().scoped_environment(std::move(lane_env));
+                Pipeline(lane.val());
+            }
+            selection = selection bitand (selection - 1U); // clear lowest set bit
+        }
+        CodeGenContext::Get().set_num_simd_lanes(L);
+    };
+    switch (CodeGenContext::Get().num_simd_lanes()) {
+        default: M_unreachable("unsupported number of SIMD lanes");
+        case  2: execute.operator()<2>();  break;
+        case  4: execute.operator()<4>();  break;
+        case  8: execute.operator()<8>();  break;
+        case 16: execute.operator()<16>(); break;
+        case 32: execute.operator()<32>(); break;
+    }
+}
+
+
 /*======================================================================================================================
  * compile data layout
  *====================================================================================================================*/
@@ -536,6 +747,91 @@ namespace m {
 
 namespace wasm {
 
+Ptr<Charx1> decode_dictionary(const storage::Dictionary &dict, U32x1 code)
+{
+    Ptr<void> base = Module::Get().get_global<void*>(WasmEngine::Dictionary_Global_Name(dict).c_str());
+    return (base + (code * uint32_t(dict.entry_size())).make_signed()).to<char*>();
+}
+
+/** Loads the differences stored by the frame-of-reference encoded leaf \p leaf at \p ptr and decodes them by adding the
+ * leaf's reference value.  The stored differences are loaded as narrow integers and widened SIMDfied. */
+template<signed_integral T, std::size_t L>
+PrimitiveExpr<T, L> decode_frame_of_reference(const storage::DataLayout::Leaf &leaf, Ptr<void> ptr)
+{
+    auto decode = [&]<signed_integral Stored>() -> PrimitiveExpr<T, L> {
+        if constexpr (sizeof(Stored) < sizeof(T)) {
+            PrimitiveExpr<Stored, L> stored = *ptr.template to<Stored*, L>();
+            return stored.template to<T>() + PrimitiveExpr<T, L>(T(leaf.reference()));
+        } else {
+            M_unreachable("frame-of-reference encoded values must be stored narrower");
+        }
+    };
+    switch (leaf.stored_type()->size()) {
+        default: M_unreachable("invalid size of frame-of-reference encoded values");
+        case  8: return decode.template operator()<int8_t>();
+        case 16: return decode.template operator()<int16_t>();
+        case 32: return decode.template operator()<int32_t>();
+    }
+}
+
+U64x1 load_bits(Ptr<void> ptr, U64x1 bit_offset, std::size_t width)
+{
+    M_insist(width and 7 + width <= 64, "value must fit into 64 bits together with its bit offset");
+    const std::size_t min_num_bytes = (width + 7) / 8; // number of bytes containing the value at bit offset 0
+    const Var<Ptr<void>> bytes_ptr(ptr);
+    const Var<U64x1> shift(bit_offset);
+
+    Var<U64x1> bits(uint64_t(0));
+    for (std::size_t i = 0; i != min_num_bytes; ++i)
+        bits |= U8x1(*(bytes_ptr + int32_t(i)).to<uint8_t*>()).to<uint64_t>() << uint64_t(8 * i);
+    if (8 * min_num_bytes < 7 + width) {
+        IF (shift + uint64_t(width) > uint64_t(8 * min_num_bytes)) { // value reaches into one more byte
+            bits |= U8x1(*(bytes_ptr + int32_t(min_num_bytes)).to<uint8_t*>()).to<uint64_t>()
+                    << uint64_t(8 * min_num_bytes);
+        };
+    }
+    return (bits >> shift) bitand uint64_t((uint64_t(1) << width) - 1UL);
+}
+
+void store_bits(Ptr<void> ptr, U64x1 bit_offset, std::size_t width, U64x1 value)
+{
+    M_insist(width and 7 + width <= 64, "value must fit into 64 bits together with its bit offset");
+    const std::size_t min_num_bytes = (width + 7) / 8; // number of bytes containing the value at bit offset 0
+    const Var<Ptr<void>> bytes_ptr(ptr);
+    const Var<U64x1> shift(bit_offset);
+    const Var<U64x1> mask(U64x1(uint64_t((uint64_t(1) << width) - 1UL)) << shift);
+    const Var<U64x1> bits((value << shift) bitand mask);
+
+    auto update_byte = [&](std::size_t i) {
+        const Var<Ptr<U8x1>> byte_ptr((bytes_ptr + int32_t(i)).to<uint8_t*>());
+        const Var<U8x1> byte(*byte_ptr);
+        /* Replace the masked bits of the byte, i.e. `(byte & ~mask) | bits`. */
+        *byte_ptr = byte xor ((byte xor (bits >> uint64_t(8 * i)).to<uint8_t>())
+                              bitand (mask >> uint64_t(8 * i)).to<uint8_t>());
+    };
+    for (std::size_t i = 0; i != min_num_bytes; ++i)
+        update_byte(i);
+    if (8 * min_num_bytes < 7 + width) {
+        IF (shift + uint64_t(width) > uint64_t(8 * min_num_bytes)) { // value reaches into one more byte
+            update_byte(min_num_bytes);
+        };
+    }
+}
+
+/** Decodes the difference \p bits loaded from the bit-packed leaf \p leaf by adding the leaf's reference value. */
+template<signed_integral T>
+PrimitiveExpr<T> decode_bit_packed(const storage::DataLayout::Leaf &leaf, U64x1 bits)
+{
+    return (bits.make_signed() + I64x1(leaf.reference())).template to<T>();
+}
+
+/** Encodes \p value for the bit-packed leaf \p leaf as its unsigned difference to the leaf's reference value. */
+template<signed_integral T>
+U64x1 encode_bit_packed(const storage::DataLayout::Leaf &leaf, PrimitiveExpr<T> value)
+{
+    return (value.template to<int64_t>() - I64x1(leaf.reference())).make_unsigned();
+}
+
 /** Compiles the data layout \p layout containing tuples of schema \p layout_schema such that it sequentially
  * stores/loads (depending on \tparam IsStore) tuples of schema \p _tuple_value_schema starting at memory address \p
  * base_address and tuple ID \p tuple_id.  If \tparam SinglePass, the store has to be done in a single pass, i.e. the
@@ -579,6 +875,8 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
     Block inits("inits", false), stores("stores", false), loads("loads", false), jumps("jumps", false);
     ///> the values loaded for the entries in `tuple_value_schema`
     SQL_t values[tuple_value_schema.num_entries()];
+    ///> the dictionaries and codes loaded for the dictionary-encoded entries in `tuple_value_schema`
+    std::vector<std::optional<std::pair<const storage::Dictionary*, U32x1>>> codes(tuple_value_schema.num_entries());
     ///> the addresses for the entries in `tuple_addr_schema`
     SQL_addr_t *addrs;
     if (not tuple_addr_schema.empty())
@@ -1147,7 +1445,68 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                 const auto tuple_value_idx = std::distance(tuple_value_schema.begin(), tuple_value_it);
                 const auto tuple_addr_idx = std::distance(tuple_addr_schema.begin(), tuple_addr_it);
 
-                if (bit_stride) { // entry with bit stride requires dynamic masking (for scalar loading)
+                if (leaf_info.leaf.is_bit_packed() and bit_stride) { // bit-packed entry requires dynamic bit offset
+                    M_insist(L == 1, "SIMDfied loading of bit-packed values not supported");
+
+                    M_insist(bool(inode_iter), "stride requires repetition");
+                    U64x1 leaf_offset_in_bits = leaf_info.offset_in_bits + *inode_iter * leaf_info.stride_in_bits;
+                    U8x1  leaf_bit_offset  = (leaf_offset_in_bits.clone() bitand uint64_t(7)).to<uint8_t>() ; // mod 8
+                    I32x1 leaf_byte_offset = (leaf_offset_in_bits >> uint64_t(3)).make_signed().to<int32_t>(); // div 8
+
+                    /*----- Share pointer and mask with booleans of equal offset (mod 8) and stride. -----*/
+                    key_t key(leaf_info.offset_in_bits % 8, leaf_info.stride_in_bits);
+                    auto [it, inserted] =
+                        M_CONSTEXPR_COND(PointerSharing,
+                                         loading_context.try_emplace(std::move(key)),
+                                         std::make_pair(loading_context.emplace(loading_context.end(), std::move(key), value_t()), true));
+                    M_insist(inserted == not it->second.mask);
+                    if (inserted) {
+                        BLOCK_OPEN(inits) {
+                            /* do not add `leaf_byte_offset` here as it may be different for shared entries */
+                            it->second.ptr = base_address.clone() + *inode_byte_offset;
+                            it->second.mask.emplace(); // default-construct for globals to be assignable
+                            *it->second.mask = 1U << leaf_bit_offset; // the mask's set bit is the value's bit offset
+                        }
+                    } else {
+                        leaf_bit_offset.discard();
+                    }
+                    const auto &ptr = it->second.ptr;
+                    const auto &mask = *it->second.mask;
+                    const std::size_t width = leaf_info.leaf.stored_type()->size();
+
+                    /*----- Store/load value depending on its type. -----*/
+                    auto access = [&]<signed_integral type>() {
+                        if constexpr (L == 1) {
+                            if constexpr (IsStore) {
+                                BLOCK_OPEN(stores) {
+                                    auto [value, is_null] = env.get<Expr<type>>(tuple_it->id).split(); // get value
+                                    is_null.discard(); // handled at NULL bitmap leaf
+                                    store_bits(ptr + leaf_byte_offset, mask.ctz().template to<uint64_t>(), width,
+                                               encode_bit_packed(leaf_info.leaf, value));
+                                }
+                            } else {
+                                BLOCK_OPEN(loads) {
+                                    M_insist(tuple_addr_it == tuple_addr_schema.end(),
+                                             "addresses of bit-packed values not supported");
+                                    Var<PrimitiveExpr<type>> value(decode_bit_packed<type>(
+                                        leaf_info.leaf,
+                                        load_bits(ptr + leaf_byte_offset, mask.ctz().template to<uint64_t>(), width)
+                                    ));
+                                    new (&values[tuple_value_idx]) SQL_t(Expr<type>(value));
+                                }
+                            }
+                        } else {
+                            M_unreachable("SIMDfied loading of bit-packed values not supported");
+                        }
+                    };
+                    switch (as<const Numeric>(leaf_info.leaf.type())->size()) {
+                        default: M_unreachable("invalid size");
+                        case  8: access.template operator()<int8_t>();  break;
+                        case 16: access.template operator()<int16_t>(); break;
+                        case 32: access.template operator()<int32_t>(); break;
+                        case 64: access.template operator()<int64_t>(); break;
+                    }
+                } else if (bit_stride) { // entry with bit stride requires dynamic masking (for scalar loading)
                     M_insist(tuple_it->type->is_boolean(),
                              "leaf bit stride currently only for `Boolean` supported");
                     M_insist(L == 1 or L >= 16,
@@ -1288,8 +1647,24 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                         [&]<sql_type T>() {
                             using type = typename T::type;
                             static constexpr std::size_t lanes = T::num_simd_lanes;
+                            if (leaf_info.leaf.is_bit_packed()) {
+                                if constexpr (signed_integral<type> and lanes == 1) {
+                                    BLOCK_OPEN(stores) {
+                                        auto [value, is_null] = env.get<T>(tuple_it->id).split(); // get value
+                                        is_null.discard(); // handled at NULL bitmap leaf
+                                        store_bits(ptr + static_byte_offset, U64x1(uint64_t(static_bit_offset)),
+                                                   leaf_info.leaf.stored_type()->size(),
+                                                   encode_bit_packed(leaf_info.leaf, value));
+                                    }
+                                } else {
+                                    M_unreachable("only integral values can be bit-packed and stored scalar");
+                                }
+                                return;
+                            }
                             M_insist(static_bit_offset == 0,
                                      "leaf offset of `Numeric`, `Date`, or `DateTime` must be byte aligned");
+                            M_insist(not leaf_info.leaf.is_frame_of_reference_encoded(),
+                                     "storing frame-of-reference encoded values currently not supported");
                             BLOCK_OPEN(stores) {
                                 auto [value, is_null] = env.get<T>(tuple_it->id).split(); // get value
                                 is_null.discard(); // handled at NULL bitmap leaf
@@ -1305,19 +1680,51 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                         [&]<sql_type T>() {
                             using type = typename T::type;
                             static constexpr std::size_t lanes = T::num_simd_lanes;
+                            if (leaf_info.leaf.is_bit_packed()) {
+                                if constexpr (signed_integral<type> and lanes == 1) {
+                                    BLOCK_OPEN(loads) {
+                                        M_insist(tuple_addr_it == tuple_addr_schema.end(),
+                                                 "addresses of bit-packed values not supported");
+                                        Var<PrimitiveExpr<type>> value(decode_bit_packed<type>(
+                                            leaf_info.leaf,
+                                            load_bits(ptr + static_byte_offset, U64x1(uint64_t(static_bit_offset)),
+                                                      leaf_info.leaf.stored_type()->size())
+                                        ));
+                                        new (&values[tuple_value_idx]) SQL_t(T(value));
+                                    }
+                                } else {
+                                    M_unreachable("only integral values can be bit-packed and loaded scalar");
+                                }
+                                return;
+                            }
                             M_insist(static_bit_offset == 0,
                                      "leaf offset of `Numeric`, `Date`, or `DateTime` must be byte aligned");
                             BLOCK_OPEN(loads) {
                                 if (tuple_value_it != tuple_value_schema.end()) {
-                                    Var<PrimitiveExpr<type, lanes>> value(
-                                        *(ptr + static_byte_offset).template to<type*, lanes>()
-                                    );
-                                    new (&values[tuple_value_idx]) SQL_t(T(value));
+                                    if (leaf_info.leaf.is_frame_of_reference_encoded()) {
+                                        if constexpr (signed_integral<type>) {
+                                            Var<PrimitiveExpr<type, lanes>> value(
+                                                decode_frame_of_reference<type, lanes>(leaf_info.leaf,
+                                                                                       ptr + static_byte_offset)
+                                            );
+                                            new (&values[tuple_value_idx]) SQL_t(T(value));
+                                        } else {
+                                            M_unreachable("only integral values can be frame-of-reference encoded");
+                                        }
+                                    } else {
+                                        Var<PrimitiveExpr<type, lanes>> value(
+                                            *(ptr + static_byte_offset).template to<type*, lanes>()
+                                        );
+                                        new (&values[tuple_value_idx]) SQL_t(T(value));
+                                    }
                                 }
-                                if (tuple_addr_it != tuple_addr_schema.end())
+                                if (tuple_addr_it != tuple_addr_schema.end()) {
+                                    M_insist(not leaf_info.leaf.is_frame_of_reference_encoded(),
+                                             "addresses of frame-of-reference encoded values not supported");
                                     new (&addrs[tuple_addr_idx]) SQL_addr_t(
                                         (ptr + static_byte_offset).template to<type*, lanes>()
                                     );
+                                }
                             }
                         },
                         []<typename>() {
@@ -1385,6 +1792,8 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                             M_insist(L == 1, "string SIMDfication currently not supported");
                             M_insist(static_bit_offset == 0, "leaf offset of `CharacterSequence` must be byte aligned");
                             if constexpr (IsStore) {
+                                M_insist(not leaf_info.leaf.is_dictionary_encoded(),
+                                         "storing dictionary-encoded character sequences currently not supported");
                                 /*----- Store value. -----*/
                                 BLOCK_OPEN(stores) {
                                     auto value = env.get<NChar>(tuple_it->id); // get value
@@ -1396,10 +1805,20 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                             } else {
                                 /*----- Load value. -----*/
                                 BLOCK_OPEN(loads) {
-                                    Ptr<Charx1> address((ptr + static_byte_offset).template to<char*>());
-                                    new (&values[tuple_value_idx]) SQL_t(
-                                        NChar(address, layout_entry.nullable(), cs.length, cs.is_varying)
-                                    );
+                                    if (leaf_info.leaf.is_dictionary_encoded()) {
+                                        auto &dict = leaf_info.leaf.dictionary();
+                                        Var<U32x1> code(*(ptr + static_byte_offset).template to<uint32_t*>());
+                                        Var<Ptr<Charx1>> address(decode_dictionary(dict, code));
+                                        new (&values[tuple_value_idx]) SQL_t(
+                                            NChar(address, layout_entry.nullable(), cs.length, true)
+                                        );
+                                        codes[tuple_value_idx].emplace(&dict, U32x1(code)); // keep code for predicates
+                                    } else {
+                                        Ptr<Charx1> address((ptr + static_byte_offset).template to<char*>());
+                                        new (&values[tuple_value_idx]) SQL_t(
+                                            NChar(address, layout_entry.nullable(), cs.length, cs.is_varying)
+                                        );
+                                    }
                                     /* Omit addresses for character sequences. */
                                 }
                             }
@@ -1671,6 +2090,8 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                                 env.add(tuple_entry.id, NChar(_value, /* can_be_null=*/ false, value.length(),
                                                               value.guarantees_terminating_nul()));
                             }
+                            if (codes[idx])
+                                env.add_code(tuple_entry.id, *codes[idx]->first, std::move(codes[idx]->second));
                         }
                     } else {
                         M_unreachable("string SIMDfication currently not supported");
@@ -1947,6 +2368,8 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
 
     ///> the values loaded for the entries in `tuple_value_schema`
     SQL_t values[tuple_value_schema.num_entries()];
+    ///> the dictionaries and codes loaded for the dictionary-encoded entries in `tuple_value_schema`
+    std::vector<std::optional<std::pair<const storage::Dictionary*, U32x1>>> codes(tuple_value_schema.num_entries());
     ///> the addresses for the entries in `tuple_addr_schema`
     SQL_addr_t *addrs;
     if (not tuple_addr_schema.empty())
@@ -2255,7 +2678,41 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                 const auto tuple_value_idx = std::distance(tuple_value_schema.begin(), tuple_value_it);
                 const auto tuple_addr_idx = std::distance(tuple_addr_schema.begin(), tuple_addr_it);
 
-                if (bit_stride) { // entry with bit stride requires dynamic masking
+                if (leaf_info.leaf.is_bit_packed()) { // bit-packed entry requires dynamic bit offset if it has a stride
+                    U64x1 leaf_offset_in_bits = [&]() -> U64x1 {
+                        if (inode_iter and leaf_info.stride_in_bits)
+                            return leaf_info.offset_in_bits + *inode_iter * leaf_info.stride_in_bits;
+                        else
+                            return U64x1(uint64_t(leaf_info.offset_in_bits));
+                    }();
+                    U64x1 leaf_bit_offset  = leaf_offset_in_bits.clone() bitand uint64_t(7); // mod 8
+                    I32x1 leaf_byte_offset = (leaf_offset_in_bits >> uint64_t(3)).make_signed().to<int32_t>(); // div 8
+                    Ptr<void> ptr = inode_ptr + leaf_byte_offset;
+                    const std::size_t width = leaf_info.leaf.stored_type()->size();
+
+                    /*----- Store/load value depending on its type. -----*/
+                    auto access = [&]<signed_integral type>() {
+                        if constexpr (IsStore) {
+                            auto [value, is_null] = env.get<Expr<type>>(tuple_it->id).split(); // get value
+                            is_null.discard(); // handled at NULL bitmap leaf
+                            store_bits(ptr, leaf_bit_offset, width, encode_bit_packed(leaf_info.leaf, value));
+                        } else {
+                            M_insist(tuple_addr_it == tuple_addr_schema.end(),
+                                     "addresses of bit-packed values not supported");
+                            Var<PrimitiveExpr<type>> value(
+                                decode_bit_packed<type>(leaf_info.leaf, load_bits(ptr, leaf_bit_offset, width))
+                            );
+                            new (&values[tuple_value_idx]) SQL_t(Expr<type>(value));
+                        }
+                    };
+                    switch (as<const Numeric>(leaf_info.leaf.type())->size()) {
+                        default: M_unreachable("invalid size");
+                        case  8: access.template operator()<int8_t>();  break;
+                        case 16: access.template operator()<int16_t>(); break;
+                        case 32: access.template operator()<int32_t>(); break;
+                        case 64: access.template operator()<int64_t>(); break;
+                    }
+                } else if (bit_stride) { // entry with bit stride requires dynamic masking
                     M_insist(tuple_it->type->is_boolean(), "leaf bit stride currently only for `Boolean` supported");
 
                     M_insist(bool(inode_iter), "stride requires repetition");
@@ -2306,6 +2763,8 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                         using type = typename T::type;
                         M_insist(static_bit_offset == 0,
                                  "leaf offset of `Numeric`, `Date`, or `DateTime` must be byte aligned");
+                        M_insist(not leaf_info.leaf.is_frame_of_reference_encoded(),
+                                 "storing frame-of-reference encoded values currently not supported");
                         auto [value, is_null] = env.get<T>(tuple_it->id).split(); // get value
                         is_null.discard(); // handled at NULL bitmap leaf
                         *(ptr + static_byte_offset).template to<type*>() = value;
@@ -2316,13 +2775,27 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                         M_insist(static_bit_offset == 0,
                                  "leaf offset of `Numeric`, `Date`, or `DateTime` must be byte aligned");
                         if (tuple_value_it != tuple_value_schema.end()) {
-                            Var<PrimitiveExpr<type>> value(*(ptr.clone() + static_byte_offset).template to<type*>());
-                            new (&values[tuple_value_idx]) SQL_t(T(value));
+                            if (leaf_info.leaf.is_frame_of_reference_encoded()) {
+                                if constexpr (signed_integral<type>) {
+                                    Var<PrimitiveExpr<type>> value(decode_frame_of_reference<type, 1>(
+                                        leaf_info.leaf, ptr.clone() + static_byte_offset
+                                    ));
+                                    new (&values[tuple_value_idx]) SQL_t(T(value));
+                                } else {
+                                    M_unreachable("only integral values can be frame-of-reference encoded");
+                                }
+                            } else {
+                                Var<PrimitiveExpr<type>> value(*(ptr.clone() + static_byte_offset).template to<type*>());
+                                new (&values[tuple_value_idx]) SQL_t(T(value));
+                            }
                         }
-                        if (tuple_addr_it != tuple_addr_schema.end())
+                        if (tuple_addr_it != tuple_addr_schema.end()) {
+                            M_insist(not leaf_info.leaf.is_frame_of_reference_encoded(),
+                                     "addresses of frame-of-reference encoded values not supported");
                             new (&addrs[tuple_addr_idx]) SQL_addr_t(
                                 (ptr.clone() + static_byte_offset).template to<type*>()
                             );
+                        }
                         ptr.discard();
                     };
                     /*----- Select call target (store or load) and visit attribute type. -----*/
@@ -2369,15 +2842,27 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                         },
                         [&](const CharacterSequence &cs) {
                             M_insist(static_bit_offset == 0, "leaf offset of `CharacterSequence` must be byte aligned");
-                            Ptr<Charx1> addr = (ptr + static_byte_offset).template to<char*>();
                             if constexpr (IsStore) {
+                                M_insist(not leaf_info.leaf.is_dictionary_encoded(),
+                                         "storing dictionary-encoded character sequences currently not supported");
                                 /*----- Store value. -----*/
+                                Ptr<Charx1> addr = (ptr + static_byte_offset).template to<char*>();
                                 auto value = env.get<NChar>(tuple_it->id); // get value
                                 IF (value.clone().not_null()) {
                                     strncpy(addr, value, U32x1(cs.size() / 8)).discard();
                                 };
+                            } else if (leaf_info.leaf.is_dictionary_encoded()) {
+                                /*----- Load and decode code. -----*/
+                                auto &dict = leaf_info.leaf.dictionary();
+                                Var<U32x1> code(*(ptr + static_byte_offset).template to<uint32_t*>());
+                                new (&values[tuple_value_idx]) SQL_t(
+                                    NChar(decode_dictionary(dict, code), layout_entry.nullable(), cs.length, true)
+                                );
+                                codes[tuple_value_idx].emplace(&dict, U32x1(code)); // keep code for predicates
+                                /* Omit addresses for character sequences. */
                             } else {
                                 /*----- Load value. -----*/
+                                Ptr<Charx1> addr = (ptr + static_byte_offset).template to<char*>();
                                 new (&values[tuple_value_idx]) SQL_t(
                                     NChar(addr, layout_entry.nullable(), cs.length, cs.is_varying)
                                 );
@@ -2418,6 +2903,8 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                         env.add(tuple_entry.id, NChar(_value, /* can_be_null=*/ false, value.length(),
                                                       value.guarantees_terminating_nul()));
                     }
+                    if (codes[idx])
+                        env.add_code(tuple_entry.id, *codes[idx]->first, std::move(codes[idx]->second));
                 },
                 [](auto) { M_unreachable("SIMDfication currently not supported"); },
                 [](std::monostate) { M_unreachable("value must be loaded beforehand"); },
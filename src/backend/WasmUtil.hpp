@@ -5,6 +5,7 @@
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/IR/PhysicalOptimizer.hpp>
 #include <mutable/parse/AST.hpp>
+#include <mutable/storage/Dictionary.hpp>
 #include <mutable/util/concepts.hpp>
 #include <optional>
 #include <variant>
@@ -484,6 +485,23 @@ inline Bool<L> not_null(SQL_t &variant)
 }
 
 
+/*======================================================================================================================
+ * User-defined functions
+ *====================================================================================================================*/
+
+/** The body of a `ScalarUDF` in the Wasm DSL.  Given the compiled arguments of an application of the function, already
+ * converted to the numeric parameter types, the body emits the code computing the result and returns it.  Thereby, the
+ * body is *inlined* into the query module.  Bodies must support arguments of any number of SIMD lanes. */
+using udf_body_t = std::function<SQL_t(std::vector<SQL_t>)>;
+
+/** Registers \p body as the Wasm DSL body of the user-defined function \p name, e.g. when loading a plugin.  Throws
+ * `m::invalid_argument` if a body is already registered for \p name. */
+void register_udf_body(ThreadSafePooledString name, udf_body_t body);
+
+/** Returns the Wasm DSL body of the user-defined function \p name or `nullptr` if no body is registered. */
+const udf_body_t * get_udf_body(const ThreadSafePooledString &name);
+
+
 /*======================================================================================================================
  * ExprCompiler
  *====================================================================================================================*/
@@ -534,6 +552,10 @@ struct ExprCompiler : ast::ConstASTExprVisitor
     void operator()(const ast::FnApplicationExpr &op) override;
     void operator()(const ast::QueryExpr &op) override;
 
+    /** Tries to compile the comparison \p e of a dictionary-encoded character sequence with a constant on the codes
+     * instead of on the strings.  Returns `true` iff \p e was compiled. */
+    bool compile_dictionary_comparison(const ast::BinaryExpr &e);
+
     SQL_t get() { return std::move(intermediate_result_); }
 
     template<sql_type T>
@@ -564,6 +586,9 @@ struct Environment
     std::unordered_map<Schema::Identifier, SQL_t> exprs_;
     ///> maps `Schema::Identifier`s to `Ptr<Expr<T>>`s that evaluate to the address of the current expression
     std::unordered_map<Schema::Identifier, SQL_addr_t> expr_addrs_;
+    ///> maps `Schema::Identifier`s of dictionary-encoded character sequences to their `Dictionary` and to `U32x1`s that
+    ///> evaluate to the codes of the current values; the values themselves are contained in `exprs_`
+    std::unordered_map<Schema::Identifier, std::pair<const storage::Dictionary*, U32x1>> codes_;
     ///> optional predicate if predication is used
     SQL_boolean_t predicate_;
 
@@ -577,6 +602,8 @@ struct Environment
             discard(p.second);
         for (auto &p : expr_addrs_)
             discard(p.second);
+        for (auto &p : codes_)
+            p.second.second.discard();
         /* do not discard `predicate_` to make sure predication predicate is used if it was set */
     }
 
@@ -601,6 +628,14 @@ struct Environment
     }
     /** Returns `true` iff this `Environment` is empty. */
     bool empty() const { return exprs_.empty() and expr_addrs_.empty(); }
+    ///> Returns the identifiers of all entries, excluding address entries.
+    std::vector<Schema::Identifier> ids() const {
+        std::vector<Schema::Identifier> ids;
+        ids.reserve(exprs_.size());
+        for (auto &p : exprs_)
+            ids.push_back(p.first);
+        return ids;
+    }
 
     /** Clears this `Environment`. */
     void clear() {
@@ -608,8 +643,11 @@ struct Environment
             discard(p.second);
         for (auto &p : expr_addrs_)
             discard(p.second);
+        for (auto &p : codes_)
+            p.second.second.discard();
         exprs_.clear();
         expr_addrs_.clear();
+        codes_.clear();
     }
 
     ///> Adds a mapping from \p id to \p expr.
@@ -636,6 +674,12 @@ struct Environment
         M_insist(res.second, "duplicate ID");
     }
 
+    ///> Adds the code \p code of the current value of \p id, which is dictionary-encoded by \p dict.
+    void add_code(Schema::Identifier id, const storage::Dictionary &dict, U32x1 code) {
+        auto res = codes_.emplace(std::move(id), std::make_pair(&dict, std::move(code)));
+        M_insist(res.second, "duplicate ID");
+    }
+
     ///> **Copies** all entries of \p other into `this`.
     void add(const Environment &other) {
         for (auto &p : other.exprs_) {
@@ -650,6 +694,8 @@ struct Environment
                 [this, &p](auto &e) -> void { this->add_addr(p.first, e.clone()); },
             }, p.second);
         }
+        for (auto &p : other.codes_)
+            this->add_code(p.first, *p.second.first, p.second.second.clone());
     }
     ///> **Moves** all entries of \p other into `this`.
     void add(Environment &&other) {
@@ -657,13 +703,26 @@ struct Environment
         M_insist(other.exprs_.empty(), "duplicate ID not moved from other to this");
         this->expr_addrs_.merge(other.expr_addrs_);
         M_insist(other.expr_addrs_.empty(), "duplicate ID not moved from other to this");
+        this->codes_.merge(other.codes_);
+        M_insist(other.codes_.empty(), "duplicate ID not moved from other to this");
+    }
+
+    private:
+    ///> Removes the code of \p id, if any, s.t. it cannot outlive the value it was loaded with.
+    void erase_code(const Schema::Identifier &id) {
+        if (auto it = codes_.find(id); it != codes_.end()) {
+            it->second.second.discard();
+            codes_.erase(it);
+        }
     }
 
+    public:
     ///> Returns the **moved** entry for identifier \p id.
     SQL_t extract(const Schema::Identifier &id) {
         auto it = exprs_.find(id);
         M_insist(it != exprs_.end(), "identifier not found");
         auto nh = exprs_.extract(it);
+        erase_code(id);
         return std::move(nh.mapped());
     }
     ///> Returns the **moved** entry for identifier \p id.
@@ -672,6 +731,7 @@ struct Environment
         auto it = exprs_.find(id);
         M_insist(it != exprs_.end(), "identifier not found");
         auto nh = exprs_.extract(it);
+        erase_code(id);
         M_insist(std::holds_alternative<T>(nh.mapped()));
         return *std::get_if<T>(&nh.mapped());
     }
@@ -732,6 +792,19 @@ struct Environment
     ///> Returns the **copied** entry for identifier \p id.
     SQL_t operator[](const Schema::Identifier &id) const { return get(id); }
 
+    /** Returns the `Dictionary` encoding the current value of \p id, or `nullptr` if this `Environment` does not
+     * contain the code of \p id.  Only scans of dictionary-encoded attributes add codes, see `add_code()`. */
+    const storage::Dictionary * dictionary(const Schema::Identifier &id) const {
+        auto it = codes_.find(id);
+        return it == codes_.end() ? nullptr : it->second.first;
+    }
+    ///> Returns the **copied** code of the current value of \p id.
+    U32x1 get_code(const Schema::Identifier &id) const {
+        auto it = codes_.find(id);
+        M_insist(it != codes_.end(), "identifier not found");
+        return it->second.second.clone();
+    }
+
 
     /*----- Expression and CNF compilation ---------------------------------------------------------------------------*/
     ///> Compile \p t by delegating compilation to an `ExprCompiler` for `this` `Environment`.
@@ -844,7 +917,8 @@ struct Scope
  * - an `Environment` of named values, e.g. SQL attribute values
  * - an `ExprCompiler` to compile expressions within the current `Environment`
  * - the number of tuples written to the result set
- * / the number of SIMD lanes currently used
+ * - the number of SIMD lanes currently used
+ * - whether the rows currently scanned are visible to the transaction of the scan
  */
 struct CodeGenContext
 {
@@ -858,6 +932,10 @@ struct CodeGenContext
     std::size_t num_simd_lanes_ = 1;
     ///> number of SIMD lanes currently preferred, i.e. 1 for scalar and at least 2 for vectorial values
     std::size_t num_simd_lanes_preferred_ = 1;
+    ///> the table whose rows are currently scanned, if the scan tells whether they are visible, see `visible_rows()`
+    const Table *visible_rows_table_ = nullptr;
+    ///> whether the rows of `visible_rows_table_` currently scanned are visible to the transaction of the scan
+    const Var<Boolx1> *visible_rows_ = nullptr;
 
     public:
     CodeGenContext() = default;
@@ -934,6 +1012,17 @@ struct CodeGenContext
     void update_num_simd_lanes_preferred(std::size_t n) {
         num_simd_lanes_preferred_ = std::max(num_simd_lanes_preferred_, n);
     }
+
+    /** Returns the table whose rows are currently scanned and a variable telling whether these rows are visible to the
+     * transaction of the scan, i.e. whether they satisfy the timestamp clauses of the table.  Returns `nullptr`s if the
+     * scan does not tell. */
+    std::pair<const Table*, const Var<Boolx1>*> visible_rows() const { return { visible_rows_table_, visible_rows_ }; }
+    /** Sets the table \p table whose rows are currently scanned and the variable \p visible_rows telling whether these
+     * rows are visible.  Pass `nullptr`s to unset. */
+    void set_visible_rows(const Table *table, const Var<Boolx1> *visible_rows) {
+        visible_rows_table_ = table;
+        visible_rows_ = visible_rows;
+    }
 };
 
 inline Scope::Scope(Environment inner)
@@ -954,6 +1043,22 @@ inline Environment Scope::extract()
 }
 
 
+/*======================================================================================================================
+ * SIMD lanes
+ *====================================================================================================================*/
+
+/** Resumes \p Pipeline for each *qualifying* tuple of the current SIMD vectors, i.e. for each SIMD lane whose
+ * predication predicate is fulfilled, in ascending lane order.  This way, operators that do not support SIMD consume
+ * the selection vector produced by a SIMDfied pipeline, e.g. a SIMDfied scan followed by a predicated filter.
+ *
+ * The vectorial values of the current `Environment` are spilled to pre-allocated memory once and \p Pipeline is
+ * emitted only once, namely into a loop over the set bits of the bitmask of the predication predicate.  \p Pipeline is
+ * called with the index of the current lane in a fresh, scalar `Environment` binding the values of this lane and
+ * with the number of SIMD lanes set to 1.  Address entries of the current `Environment` are not propagated.  Must only
+ * be called if the number of SIMD lanes currently used is greater than 1. */
+void for_each_qualifying_lane(const std::function<void(U32x1)> &Pipeline);
+
+
 /*======================================================================================================================
  * compile data layout
  *====================================================================================================================*/
@@ -1346,6 +1451,30 @@ _Boolx1 strcmp(NChar left, NChar right, cmp_op op);
 Ptr<Charx1> strncpy(Ptr<Charx1> dst, Ptr<Charx1> src, U32x1 count);
 
 
+/*======================================================================================================================
+ * dictionary decoding
+ *====================================================================================================================*/
+
+/** Returns the address of the entry of \p code in the dictionary \p dict, which must be mapped into the linear memory,
+ * see `WasmEngine::WasmContext::map_dictionary()`. */
+Ptr<Charx1> decode_dictionary(const storage::Dictionary &dict, U32x1 code);
+
+
+/*======================================================================================================================
+ * bit-packed values
+ *====================================================================================================================*/
+
+/** Loads the value of \p width bits that starts at bit \p bit_offset, which must be less than 8, of the byte \p ptr
+ * points to as unsigned integer.  Loads exactly the bytes containing the value, one at a time, to not access memory
+ * beyond the value. */
+U64x1 load_bits(Ptr<void> ptr, U64x1 bit_offset, std::size_t width);
+
+/** Stores the unsigned integer \p value as value of \p width bits that starts at bit \p bit_offset, which must be less
+ * than 8, of the byte \p ptr points to.  Updates exactly the bytes containing the value, one at a time, s.t. the bits
+ * of neighbouring values are retained. */
+void store_bits(Ptr<void> ptr, U64x1 bit_offset, std::size_t width, U64x1 value);
+
+
 /*======================================================================================================================
  * SQL LIKE
  *====================================================================================================================*/
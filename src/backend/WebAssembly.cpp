@@ -1,8 +1,17 @@
 #include "backend/WebAssembly.hpp"
 
 #include "backend/WasmOperator.hpp"
+#include <algorithm>
 #include <binaryen-c.h>
+#include <bit>
 #include <iostream>
+#include <mutable/catalog/AdaptiveCostFunction.hpp>
+#include <mutable/catalog/CardinalityEstimator.hpp>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/storage/Store.hpp>
+#include <numeric>
+#include <optional>
+#include <sstream>
 #include <sys/mman.h>
 #include <utility>
 
@@ -53,51 +62,414 @@ M_LCOV_EXCL_STOP
  * WasmEngine
  *====================================================================================================================*/
 
+WasmEngine::MappingArena WasmEngine::arena_;
+
+WasmEngine::MappingArena::MappingArena() { memory::Allocator::on_destroy = &Release_Mappings; }
+
+WasmEngine::MappingArena::~MappingArena()
+{
+    memory::Allocator::on_destroy = nullptr;
+    std::lock_guard<std::mutex> lock(mutex);
+    mappings.clear();
+    released.clear();
+    vm = memory::AddressSpace(0); // release all mappings
+}
+
+void WasmEngine::MappingArena::Release_Mappings(uint64_t allocator_id)
+{
+    std::lock_guard<std::mutex> lock(arena_.mutex);
+    auto it = arena_.mappings.lower_bound(std::make_pair(allocator_id, std::size_t(0)));
+    while (it != arena_.mappings.end() and it->first.first == allocator_id) {
+        if (arena_.is_lent)
+            arena_.released.push_back(it->second); // the borrower owns the address space, release when returned
+        else
+            arena_.unmap(it->second);
+        it = arena_.mappings.erase(it);
+    }
+}
+
+void WasmEngine::MappingArena::unmap(const mapping_t &mapping)
+{
+    M_insist(not is_lent, "cannot unmap while the arena is lent");
+    M_DISCARD mmap(vm.as<uint8_t*>() + mapping.off, mapping.capacity, PROT_NONE,
+                   MAP_FIXED|MAP_ANONYMOUS|MAP_PRIVATE|MAP_NORESERVE, -1, 0);
+}
+
 WasmEngine::WasmContext::WasmContext(uint32_t id, const MatchBase &plan, config_t config, std::size_t size)
     : config_(config)
+    , uses_arena_(false)
     , id(id)
     , plan(plan)
-    , vm(size)
+    , vm(0)
 {
-    install_guard_page(); // map nullptr page
-
     M_insist(size <= WASM_MAX_MEMORY);
+
+    if (size == WASM_MAX_MEMORY) {
+        /*----- Borrow the arena, unless it is lent to another context.  Discard it if it has grown too large. -----*/
+        std::lock_guard<std::mutex> lock(arena_.mutex);
+        if (not arena_.is_lent) {
+            uses_arena_ = true;
+            if (arena_.vm.size() == 0 or arena_.top > MappingArena::MAX_TOP) {
+                arena_.vm = memory::AddressSpace(size);
+                arena_.top = 0;
+                arena_.mappings.clear();
+                arena_.released.clear();
+            }
+            using std::swap;
+            swap(vm, arena_.vm);
+            arena_.is_lent = true;
+            heap = arena_.top;
+        }
+    }
+    if (not uses_arena_)
+        vm = memory::AddressSpace(size);
+
+    if (heap == 0) {
+        install_guard_page(); // map nullptr page
+        if (uses_arena_) {
+            std::lock_guard<std::mutex> lock(arena_.mutex);
+            arena_.top = heap;
+        }
+    }
 }
 
-uint32_t WasmEngine::WasmContext::map_table(const Table &table)
+WasmEngine::WasmContext::~WasmContext()
 {
-    M_insist(Is_Page_Aligned(heap));
+    if (uses_arena_) {
+        /*----- Return the arena and release the mappings of allocators destroyed meanwhile.  The mappings past its top
+         * are replaced by the next borrower. -----*/
+        std::lock_guard<std::mutex> lock(arena_.mutex);
+        using std::swap;
+        swap(vm, arena_.vm);
+        arena_.is_lent = false;
+        for (auto &mapping : arena_.released)
+            arena_.unmap(mapping);
+        arena_.released.clear();
+    }
+}
 
+std::size_t WasmEngine::Table_Size_In_Bytes(const Table &table)
+{
     const auto num_rows_per_instance = table.layout().child().num_tuples();
     const auto instance_stride_in_bytes = table.layout().stride_in_bits() / 8U;
     const std::size_t num_instances = (table.store().num_rows() + num_rows_per_instance - 1) / num_rows_per_instance;
-    const std::size_t bytes = instance_stride_in_bytes * num_instances;
+    return instance_stride_in_bytes * num_instances;
+}
+
+std::string WasmEngine::Dictionary_Global_Name(const storage::Dictionary &dict)
+{
+    std::ostringstream oss;
+    oss << "dict_" << std::hex << reinterpret_cast<uintptr_t>(&dict);
+    return oss.str();
+}
+
+uint32_t WasmEngine::WasmContext::map_table(const Table &table)
+{
+    M_insist(Is_Page_Aligned(heap));
+
+    if (Is_Chunked(table)) {
+        /*----- Align the window to the granularity of the store's memory, e.g. to huge pages. -----*/
+        const std::size_t granularity = table.store().memory().allocator().granularity();
+        heap = round_up_to_multiple<std::size_t>(heap, granularity);
+
+        /*----- Compute the chunk size.  Each chunk must consist of whole instances of the data layout, start at a
+         * boundary of the granularity of the store's memory, and contain a whole multiple of any number of SIMD
+         * lanes. -----*/
+        constexpr std::size_t MAX_SIMD_LANES = 64;
+        const std::size_t num_rows_per_instance = table.layout().child().num_tuples();
+        const std::size_t instance_stride_in_bytes = table.layout().stride_in_bits() / 8U;
+        const std::size_t num_instances_per_unit = std::lcm(
+            granularity / std::gcd(instance_stride_in_bytes, granularity),
+            MAX_SIMD_LANES / std::gcd(num_rows_per_instance, MAX_SIMD_LANES)
+        );
+        const std::size_t bytes_per_unit = num_instances_per_unit * instance_stride_in_bytes;
+        const std::size_t num_units = std::max<std::size_t>(1, table_window_size / bytes_per_unit);
+
+        /*----- Reserve the window and map the first chunk into it. -----*/
+        const auto off = heap;
+        auto &window = table_windows.emplace_back(table_window_t{
+            .table = std::cref(table),
+            .off = off,
+            .rows_per_chunk = num_units * num_instances_per_unit * num_rows_per_instance,
+            .bytes_per_chunk = num_units * bytes_per_unit,
+        });
+        M_insist(heap + window.bytes_per_chunk <= vm.size(), "table window exceeds linear memory");
+        heap += window.bytes_per_chunk;
+        install_guard_page();
+        map_table_chunk(table_windows.size() - 1, 0);
+        M_insist(Is_Page_Aligned(heap));
+
+        return off;
+    }
+
+    const std::size_t bytes = Table_Size_In_Bytes(table);
 
     /* Map entry into WebAssembly linear memory. */
-    const auto off = heap;
-    const auto aligned_bytes = Ceil_To_Next_Page(bytes);
-    const auto &mem = table.store().memory();
-    if (aligned_bytes) {
+    if (bytes == 0)
+        return heap;
+    return map_memory(table.store().memory(), bytes);
+}
+
+uint32_t WasmEngine::WasmContext::map_dictionary(const storage::Dictionary &dict)
+{
+    /* Map at least one page, such that the code of NULL values can be decoded even if the dictionary is empty. */
+    return map_memory(dict.memory(), std::max<std::size_t>(1, dict.size() * dict.entry_size()));
+}
+
+uint32_t WasmEngine::WasmContext::map_memory(const memory::Memory &mem, std::size_t bytes)
+{
+    M_insist(Is_Page_Aligned(heap));
+    const std::size_t granularity = mem.allocator().granularity();
+    const std::size_t aligned_bytes = round_up_to_multiple(bytes, granularity);
+    M_insist(aligned_bytes <= mem.size(), "bytes exceed the memory");
+
+    if (not uses_arena_) {
+        heap = round_up_to_multiple<std::size_t>(heap, granularity);
+        const auto off = heap;
         mem.map(aligned_bytes, 0, vm, off);
         heap += aligned_bytes;
         install_guard_page();
+        M_insist(Is_Page_Aligned(heap));
+        return off;
     }
+
+    /*----- Reuse the mapping in the arena, if it suffices. -----*/
+    std::lock_guard<std::mutex> lock(arena_.mutex);
+    const auto key = std::make_pair(mem.allocator().id(), mem.offset());
+    if (auto it = arena_.mappings.find(key); it != arena_.mappings.end() and it->second.capacity >= aligned_bytes)
+        return it->second.off;
+
+    /*----- Map the memory anew past the top of the arena.  Reserve spare capacity for the memory to grow into, such
+     * that growing memory is remapped only a logarithmic number of times. -----*/
+    M_insist(heap >= arena_.top, "mappings into the arena must precede all other mappings");
+    heap = round_up_to_multiple<std::size_t>(heap, granularity);
+    const auto off = heap;
+    std::size_t capacity = std::min(std::bit_ceil(aligned_bytes), mem.size());
+    if (off + capacity + get_pagesize() > vm.size())
+        capacity = aligned_bytes; // no spare capacity available
+    mem.map(capacity, 0, vm, off);
+    heap += capacity;
+    install_guard_page();
     M_insist(Is_Page_Aligned(heap));
 
+    arena_.mappings[key] = MappingArena::mapping_t{ .off = off, .capacity = capacity };
+    arena_.top = heap;
     return off;
 }
 
+std::size_t WasmEngine::WasmContext::table_window(const Table &table) const
+{
+    auto it = std::find_if(table_windows.cbegin(), table_windows.cend(),
+                           [&table](const table_window_t &W) { return &W.table.get() == &table; });
+    M_insist(it != table_windows.cend(), "table is not mapped chunk by chunk");
+    return std::distance(table_windows.cbegin(), it);
+}
+
+uint32_t WasmEngine::WasmContext::map_table_chunk(std::size_t window, std::size_t chunk)
+{
+    M_insist(window < table_windows.size());
+    auto &W = table_windows[window];
+    auto &table = W.table.get();
+    Store::shared_memory_latch memory_latch; // the writer may concurrently grow the store
+
+    const std::size_t num_rows = table.store().num_rows();
+    const std::size_t first_row = chunk * W.rows_per_chunk;
+    if (first_row >= num_rows)
+        return 0; // past the end
+
+    /*----- Map the chunk into the window.  Chunks start at instance boundaries, hence tuple IDs within the window are
+     * relative to the beginning of the chunk. -----*/
+    const std::size_t num_rows_chunk = std::min(W.rows_per_chunk, num_rows - first_row);
+    const std::size_t num_rows_per_instance = table.layout().child().num_tuples();
+    const std::size_t instance_stride_in_bytes = table.layout().stride_in_bits() / 8U;
+    const std::size_t num_instances = (num_rows_chunk + num_rows_per_instance - 1) / num_rows_per_instance;
+    const std::size_t bytes = round_up_to_multiple(num_instances * instance_stride_in_bytes,
+                                                   table.store().memory().allocator().granularity());
+    table.store().memory().map(bytes, chunk * W.bytes_per_chunk, vm, W.off);
+
+    M_insist(std::in_range<uint32_t>(num_rows_chunk), "chunk must not exceed 2^32 rows");
+    return num_rows_chunk;
+}
+
 void WasmEngine::WasmContext::install_guard_page()
 {
     M_insist(Is_Page_Aligned(heap));
     if (not config(TRAP_GUARD_PAGES)) {
         /* Map the guard page to a fresh, zeroed page. */
         M_DISCARD mmap(vm.as<uint8_t*>() + heap, get_pagesize(), PROT_READ, MAP_FIXED|MAP_ANONYMOUS|MAP_PRIVATE, -1, 0);
+    } else if (uses_arena_) {
+        /* The arena may have been mapped past its top by a previous borrower, hence revoke any access explicitly. */
+        M_DISCARD mmap(vm.as<uint8_t*>() + heap, get_pagesize(), PROT_NONE, MAP_FIXED|MAP_ANONYMOUS|MAP_PRIVATE, -1, 0);
     }
     heap += get_pagesize(); // install guard page
     M_insist(Is_Page_Aligned(heap));
 }
 
+void WasmEngine::WasmContext::enter_pipeline(std::size_t pipeline)
+{
+    M_insist(pipeline < feedback.pipeline_times.size(), "invalid pipeline");
+    const auto now = Timer::clock::now();
+    if (not feedback.active_pipelines.empty())
+        feedback.pipeline_times[feedback.active_pipelines.back()] += now - feedback.last_switch;
+    feedback.active_pipelines.push_back(pipeline);
+    feedback.last_switch = now;
+}
+
+void WasmEngine::WasmContext::leave_pipeline(std::size_t pipeline)
+{
+    M_insist(not feedback.active_pipelines.empty() and feedback.active_pipelines.back() == pipeline,
+             "pipelines must be left in reverse order of entering them");
+    const auto now = Timer::clock::now();
+    feedback.pipeline_times[pipeline] += now - feedback.last_switch;
+    feedback.active_pipelines.pop_back();
+    feedback.last_switch = now;
+}
+
+namespace {
+
+/** Reports the true cardinalities of the subplans of the executed plan rooted in `op` to `CE`.  `num_tuples` returns
+ * the number of tuples an operator produced, or `std::nullopt` if they were not counted.  Only subplans that
+ * exclusively scan, filter, and join are reported, keyed by the aliases of the scanned relations.  Returns these
+ * aliases, or `std::nullopt` if the subplan rooted in `op` is not such a subplan.  Filters and joins whose tuples were
+ * not counted, e.g. because they are fused with their parent, are not reported, but their subplans are. */
+template<typename NumTuples>
+std::optional<std::vector<ThreadSafePooledString>>
+report_cardinalities(const Operator &op, FeedbackCardinalityEstimator &CE, const NumTuples &num_tuples)
+{
+    std::vector<ThreadSafePooledString> relations;
+    std::optional<std::size_t> cardinality;
+
+    if (auto scan = cast<const ScanOperator>(&op)) {
+        relations.emplace_back(scan->alias());
+        cardinality = scan->store().num_rows();
+    } else if (auto filter = cast<const FilterOperator>(&op)) {
+        auto child_relations = report_cardinalities(*filter->child(0), CE, num_tuples);
+        if (not child_relations)
+            return std::nullopt;
+        relations = std::move(*child_relations);
+        cardinality = num_tuples(op);
+    } else if (auto join = cast<const JoinOperator>(&op)) {
+        bool is_valid = true;
+        for (auto child : join->children()) {
+            if (auto child_relations = report_cardinalities(*child, CE, num_tuples))
+                relations.insert(relations.end(), child_relations->begin(), child_relations->end());
+            else
+                is_valid = false;
+        }
+        if (not is_valid)
+            return std::nullopt;
+        cardinality = num_tuples(op);
+    } else {
+        if (auto consumer = cast<const Consumer>(&op)) {
+            for (auto child : consumer->children())
+                report_cardinalities(*child, CE, num_tuples);
+        }
+        return std::nullopt;
+    }
+
+    /* Children are reported first, s.t. a filter on top overwrites the cardinality of the relations it filters. */
+    if (cardinality)
+        CE.observe(relations, *cardinality);
+    return relations;
+}
+
+}
+
+bool WasmEngine::WasmContext::wants_feedback() const
+{
+    auto &C = Catalog::Get();
+    const bool has_feedback_estimator = C.has_database_in_use() and
+        cast<FeedbackCardinalityEstimator>(&C.get_database_in_use().cardinality_estimator());
+    const bool has_adaptive_cost_function =
+        C.has_default_cost_function() and cast<AdaptiveCostFunction>(&C.cost_function());
+    if (not has_feedback_estimator and not has_adaptive_cost_function)
+        return false;
+
+    bool has_limit = false;
+    visit(overloaded {
+        [&has_limit](const LimitOperator&) { has_limit = true; },
+        [](auto&&) { },
+    }, plan.get_matched_root(), tag<ConstPreOrderOperatorVisitor>());
+    return not has_limit;
+}
+
+void WasmEngine::WasmContext::report_feedback() const
+{
+    M_insist(feedback.is_enabled, "feedback must be collected to be reported");
+    auto &C = Catalog::Get();
+
+    /*----- Sum the tuples produced by each operator and the tuples consumed in each pipeline. -----*/
+    std::unordered_map<const Operator*, std::size_t> num_tuples_out;
+    std::vector<std::size_t> pipeline_num_tuples(feedback.pipeline_times.size(), 0);
+    for (auto &counter : feedback.counters) {
+        num_tuples_out[&counter.op.get()] += *counter.num_tuples;
+        pipeline_num_tuples[counter.pipeline] += *counter.num_tuples;
+    }
+
+    /* Returns the number of tuples produced by `op`, or `std::nullopt` if they were not counted, e.g. because `op` is
+     * fused with its parent. */
+    auto num_tuples = [&num_tuples_out](const Operator &op) -> std::optional<std::size_t> {
+        if (auto it = num_tuples_out.find(&op); it != num_tuples_out.end())
+            return it->second;
+        return std::nullopt;
+    };
+
+    /*----- Report cardinalities to the cardinality estimator. -----*/
+    if (C.has_database_in_use()) {
+        if (auto CE = cast<FeedbackCardinalityEstimator>(&C.get_database_in_use().cardinality_estimator())) {
+            report_cardinalities(plan.get_matched_root(), *CE, num_tuples);
+            CE->persist_if_due();
+        }
+    }
+
+    /*----- Report timings to the cost function. -----*/
+    if (not C.has_default_cost_function())
+        return;
+    auto CF = cast<AdaptiveCostFunction>(&C.cost_function());
+    if (not CF)
+        return;
+
+    /* Returns the time attributed to `op`, i.e. the shares of the pipeline times of the tuples `op` consumes. */
+    auto time_in = [this, &pipeline_num_tuples](const Consumer &op) {
+        Timer::duration time(0);
+        for (auto &counter : feedback.counters) {
+            const auto &children = op.children();
+            if (std::find(children.begin(), children.end(), &counter.op.get()) == children.end())
+                continue; // not consumed by `op`
+            if (const std::size_t total = pipeline_num_tuples[counter.pipeline]) {
+                const double share = double(*counter.num_tuples) / total;
+                time += std::chrono::duration_cast<Timer::duration>(feedback.pipeline_times[counter.pipeline] * share);
+            }
+        }
+        return time;
+    };
+
+    visit(overloaded {
+        [&](const FilterOperator &op) {
+            auto in = num_tuples(*op.child(0));
+            auto out = num_tuples(op);
+            if (in and out)
+                CF->observe_filter(*in, *out, time_in(op));
+        },
+        [&](const JoinOperator &op) {
+            if (op.children().size() != 2)
+                return;
+            auto left = num_tuples(*op.child(0));
+            auto right = num_tuples(*op.child(1));
+            auto out = num_tuples(op);
+            if (left and right and out)
+                CF->observe_join(*left, *right, *out, time_in(op));
+        },
+        [&](const GroupingOperator &op) {
+            auto in = num_tuples(*op.child(0));
+            auto groups = num_tuples(op);
+            if (in and groups)
+                CF->observe_grouping(*in, *groups, time_in(op));
+        },
+        [](auto&&) { /* no feedback */ },
+    }, plan.get_matched_root(), tag<ConstPreOrderOperatorVisitor>());
+}
+
 
 /*======================================================================================================================
  * WasmBackend
@@ -0,0 +1,305 @@
+#include <mutable/catalog/AdaptiveCostFunction.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutable/catalog/CardinalityEstimator.hpp>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/PlanTable.hpp>
+
+
+using namespace m;
+using namespace m::ast;
+
+
+/*======================================================================================================================
+ * Helper functions
+ *====================================================================================================================*/
+
+namespace {
+
+double to_millis(Timer::duration time)
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(time).count() / 1e6;
+}
+
+template<typename... Features>
+Eigen::RowVectorXd make_features(Features... features)
+{
+    Eigen::RowVectorXd feature_vector(sizeof...(Features));
+    std::size_t i = 0;
+    ((feature_vector(i++) = double(features)), ...);
+    return feature_vector;
+}
+
+/** Predicts the target of `model` for the given `features` and clamps the prediction to be non-negative, as linear
+ * models may well extrapolate to negative runtimes. */
+template<typename... Features>
+double predict(const CostModel &model, Features... features)
+{
+    return std::max(0., model.predict_target(make_features(features...)));
+}
+
+}
+
+
+/*======================================================================================================================
+ * AdaptiveCostFunction::Observations
+ *====================================================================================================================*/
+
+bool AdaptiveCostFunction::Observations::add(Eigen::RowVectorXd features, double target, std::size_t window_size,
+                                             std::size_t refit_interval)
+{
+    M_insist(std::size_t(features.cols()) == num_features_, "number of features does not match");
+    features_.emplace_back(std::move(features));
+    targets_.emplace_back(target);
+    while (targets_.size() > window_size) {
+        features_.pop_front();
+        targets_.pop_front();
+    }
+    return ++num_since_refit_ >= refit_interval;
+}
+
+bool AdaptiveCostFunction::Observations::refit()
+{
+    num_since_refit_ = 0;
+
+    const std::size_t num_rows = targets_.size();
+    const std::size_t num_cols = num_features_ + 1; // add 1 for y-intercept coefficient
+    if (num_rows < num_cols)
+        return false; // underdetermined
+
+    Eigen::MatrixXd X(num_rows, num_cols);
+    Eigen::VectorXd y(num_rows);
+    for (std::size_t i = 0; i != num_rows; ++i) {
+        X(i, 0) = 1; // add 1 for y-intercept
+        X.row(i).rightCols(num_features_) = features_[i];
+        y(i) = targets_[i];
+    }
+
+    /* The closed-form solution of linear regression requires X^T X to be invertible.  This is not the case if features
+     * are linearly dependent, e.g. when all observed filters had the same selectivity. */
+    const Eigen::MatrixXd XtX = X.transpose() * X;
+    if (not Eigen::FullPivLU<Eigen::MatrixXd>(XtX).isInvertible())
+        return false;
+
+    model_ = std::make_unique<CostModel>(X, y);
+    return true;
+}
+
+void AdaptiveCostFunction::Observations::clear()
+{
+    features_.clear();
+    targets_.clear();
+    num_since_refit_ = 0;
+    model_.reset();
+}
+
+
+/*======================================================================================================================
+ * AdaptiveCostFunction
+ *====================================================================================================================*/
+
+/*----- Feedback -----------------------------------------------------------------------------------------------------*/
+
+void AdaptiveCostFunction::observe_filter(std::size_t num_tuples_in, std::size_t num_tuples_out, Timer::duration time)
+{
+    if (num_tuples_in == 0)
+        return; // selectivity is undefined
+    const double selectivity = double(num_tuples_out) / double(num_tuples_in);
+    std::lock_guard lock(mutex_);
+    if (filter_.add(make_features(num_tuples_in, selectivity), to_millis(time), window_size_, refit_interval_))
+        filter_.refit();
+}
+
+void AdaptiveCostFunction::observe_join(std::size_t num_tuples_left, std::size_t num_tuples_right,
+                                        std::size_t num_tuples_out, Timer::duration time)
+{
+    std::lock_guard lock(mutex_);
+    if (join_.add(make_features(num_tuples_left, num_tuples_right, num_tuples_out), to_millis(time), window_size_,
+                  refit_interval_))
+        join_.refit();
+}
+
+void AdaptiveCostFunction::observe_grouping(std::size_t num_tuples_in, std::size_t num_groups, Timer::duration time)
+{
+    std::lock_guard lock(mutex_);
+    if (grouping_.add(make_features(num_tuples_in, num_groups), to_millis(time), window_size_, refit_interval_))
+        grouping_.refit();
+}
+
+void AdaptiveCostFunction::refit()
+{
+    std::lock_guard lock(mutex_);
+    filter_.refit();
+    join_.refit();
+    grouping_.refit();
+}
+
+void AdaptiveCostFunction::clear()
+{
+    std::lock_guard lock(mutex_);
+    filter_.clear();
+    join_.clear();
+    grouping_.clear();
+}
+
+/*----- Cost prediction ----------------------------------------------------------------------------------------------*/
+
+std::optional<double> AdaptiveCostFunction::predict_filter(double cardinality, double selectivity) const
+{
+    std::lock_guard lock(mutex_);
+    if (not filter_.has_model()) return std::nullopt;
+    return predict(filter_.model(), cardinality, selectivity);
+}
+
+std::optional<double> AdaptiveCostFunction::predict_join(double cardinality_left, double cardinality_right,
+                                                         double result_size) const
+{
+    std::lock_guard lock(mutex_);
+    if (not join_.has_model()) return std::nullopt;
+    return predict(join_.model(), cardinality_left, cardinality_right, result_size);
+}
+
+std::optional<double> AdaptiveCostFunction::predict_grouping(double cardinality, double num_groups) const
+{
+    std::lock_guard lock(mutex_);
+    if (not grouping_.has_model()) return std::nullopt;
+    return predict(grouping_.model(), cardinality, num_groups);
+}
+
+template<typename PlanTable>
+double AdaptiveCostFunction::operator()(calculate_filter_cost_tag, PlanTable &&PT, const QueryGraph &G,
+                                        const CardinalityEstimator &CE, Subproblem sub,
+                                        const cnf::CNF &condition) const
+{
+    const double cardinality = CE.predict_cardinality(*PT[sub].model);
+    if (cardinality == 0)
+        return PT[sub].cost;
+    auto post_filter = CE.estimate_filter(G, *PT[sub].model, condition);
+    const double selectivity = CE.predict_cardinality(*post_filter) / cardinality;
+
+    std::lock_guard lock(mutex_);
+    if (has_all_models_unlocked())
+        return predict(filter_.model(), cardinality, selectivity) + PT[sub].cost;
+    return cardinality + PT[sub].cost; // fall back to C_out
+}
+
+template<typename PlanTable>
+double AdaptiveCostFunction::operator()(calculate_join_cost_tag, PlanTable &&PT, const QueryGraph&,
+                                        const CardinalityEstimator &CE, Subproblem left, Subproblem right,
+                                        const cnf::CNF&) const
+{
+    const double cardinality_left = CE.predict_cardinality(*PT[left].model);
+    const double cardinality_right = CE.predict_cardinality(*PT[right].model);
+    const double result_size = CE.predict_cardinality(*PT[left|right].model);
+
+    std::lock_guard lock(mutex_);
+    if (has_all_models_unlocked())
+        return predict(join_.model(), cardinality_left, cardinality_right, result_size) +
+               PT[left].cost + PT[right].cost;
+    return result_size + PT[left].cost + PT[right].cost; // fall back to C_out
+}
+
+template<typename PlanTable>
+double AdaptiveCostFunction::operator()(calculate_grouping_cost_tag, PlanTable &&PT, const QueryGraph&,
+                                        const CardinalityEstimator &CE, Subproblem sub,
+                                        const std::vector<const Expr*>&) const
+{
+    const double cardinality = CE.predict_cardinality(*PT[sub].model);
+    double num_groups;
+    try {
+        num_groups = CE.predict_number_distinct_values(*PT[sub].model);
+    } catch (CardinalityEstimator::data_model_exception) {
+        num_groups = cardinality; // pessimistically assume every tuple forms its own group
+    }
+
+    std::lock_guard lock(mutex_);
+    if (has_all_models_unlocked())
+        return predict(grouping_.model(), cardinality, num_groups) + PT[sub].cost;
+    return cardinality + PT[sub].cost; // fall back to C_out
+}
+
+M_LCOV_EXCL_START
+std::ostream & m::operator<<(std::ostream &out, const AdaptiveCostFunction &CF)
+{
+    std::lock_guard lock(CF.mutex_);
+    out << "AdaptiveCostFunction (window size " << CF.window_size_ << ", refit interval " << CF.refit_interval_
+        << ")\n";
+    auto print = [&out](const char *name, const AdaptiveCostFunction::Observations &O) {
+        out << "  " << name << ": " << O.size() << " observations, ";
+        if (O.has_model())
+            out << O.model();
+        else
+            out << "no model\n";
+    };
+    print("filter", CF.filter_);
+    print("join", CF.join_);
+    print("grouping", CF.grouping_);
+    return out;
+}
+
+void AdaptiveCostFunction::dump(std::ostream &out) const
+{
+    out << *this;
+    out.flush();
+}
+
+void AdaptiveCostFunction::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
+
+#define INSTANTIATE(PLAN_TABLE) \
+    template double AdaptiveCostFunction::operator()<const PLAN_TABLE&>( \
+        calculate_filter_cost_tag, const PLAN_TABLE &PT, const QueryGraph &G, const CardinalityEstimator &CE, \
+        Subproblem sub, const cnf::CNF &condition) const; \
+    template double AdaptiveCostFunction::operator()<const PLAN_TABLE&>( \
+        calculate_join_cost_tag, const PLAN_TABLE &PT, const QueryGraph &G, const CardinalityEstimator &CE, \
+        Subproblem left, Subproblem right, const cnf::CNF &condition) const; \
+    template double AdaptiveCostFunction::operator()<const PLAN_TABLE&>( \
+        calculate_grouping_cost_tag, const PLAN_TABLE &PT, const QueryGraph &G, const CardinalityEstimator &CE, \
+        Subproblem sub, const std::vector<const Expr*> &group_by) const;
+INSTANTIATE(PlanTableSmallOrDense)
+INSTANTIATE(PlanTableLargeAndSparse)
+INSTANTIATE(PlanTableCompact)
+#undef INSTANTIATE
+
+
+/*======================================================================================================================
+ * Registration
+ *====================================================================================================================*/
+
+__attribute__((constructor(202)))
+static void register_adaptive_cost_function()
+{
+    Catalog &C = Catalog::Get();
+    C.register_cost_function(
+        C.pool("AdaptiveCostFunction"),
+        std::make_unique<AdaptiveCostFunction>(),
+        "cost models continuously refit by linear regression on runtime feedback of executed operators"
+    );
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cost function",
+        /* short=       */ nullptr,
+        /* long=        */ "--adaptive-cost-window",
+        /* description= */ "number of most recent observations per operator to fit adaptive cost models on",
+        /* callback=    */ [&C](std::size_t size) {
+            as<AdaptiveCostFunction>(C.cost_function(C.pool("AdaptiveCostFunction"))).window_size(size);
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cost function",
+        /* short=       */ nullptr,
+        /* long=        */ "--adaptive-cost-refit-interval",
+        /* description= */ "number of observations per operator after which adaptive cost models are refit",
+        /* callback=    */ [&C](std::size_t interval) {
+            if (interval == 0) {
+                std::cerr << "warning: ignore invalid refit interval 0" << std::endl;
+                return;
+            }
+            as<AdaptiveCostFunction>(C.cost_function(C.pool("AdaptiveCostFunction"))).refit_interval(interval);
+        }
+    );
+}
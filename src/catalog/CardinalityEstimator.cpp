@@ -4,10 +4,12 @@
 #include "catalog/SpnWrapper.hpp"
 #include "util/Spn.hpp"
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <limits>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/IR/CNF.hpp>
 #include <mutable/IR/Operator.hpp>
@@ -27,6 +29,9 @@ namespace {
 namespace options {
 
 std::filesystem::path injected_cardinalities_file;
+std::filesystem::path feedback_cardinalities_file;
+const char *feedback_fallback = "CartesianProduct";
+std::size_t feedback_persist_interval = 64;
 
 }
 
@@ -138,6 +143,10 @@ template
 std::unique_ptr<DataModel>
 CartesianProductEstimator::operator()(estimate_join_all_tag, const PlanTableLargeAndSparse&, const QueryGraph&,
                                       Subproblem, const cnf::CNF&) const;
+template
+std::unique_ptr<DataModel>
+CartesianProductEstimator::operator()(estimate_join_all_tag, const PlanTableCompact&, const QueryGraph&,
+                                      Subproblem, const cnf::CNF&) const;
 
 std::size_t CartesianProductEstimator::predict_cardinality(const DataModel &data) const
 {
@@ -291,6 +300,7 @@ InjectionCardinalityEstimator::estimate_grouping(const QueryGraph&, const DataMo
         return std::make_unique<InjectionCardinalityDataModel>(data.subproblem_, 1); // single group
 
     /* Combine grouping keys into an identifier. */
+    std::unique_lock lock(buffer_mutex_);
     oss_.str("");
     oss_ << "g";
     for (auto [grp, alias] : exprs) {
@@ -301,6 +311,7 @@ InjectionCardinalityEstimator::estimate_grouping(const QueryGraph&, const DataMo
             oss_ << grp.get();
     }
     ThreadSafePooledString id = Catalog::Get().pool(oss_.str().c_str());
+    lock.unlock();
 
     if (auto it = cardinality_table_.find(id); it != cardinality_table_.end()) {
         /* Clamp injected cardinality to at most the cardinality of the grouping's child since it cannot produce more
@@ -378,6 +389,11 @@ std::unique_ptr<DataModel>
 InjectionCardinalityEstimator::operator()(estimate_join_all_tag, const PlanTableLargeAndSparse&, const QueryGraph&,
                                           Subproblem, const cnf::CNF&) const;
 
+template
+std::unique_ptr<DataModel>
+InjectionCardinalityEstimator::operator()(estimate_join_all_tag, const PlanTableCompact&, const QueryGraph&,
+                                          Subproblem, const cnf::CNF&) const;
+
 std::size_t InjectionCardinalityEstimator::predict_cardinality(const DataModel &data) const
 {
     return as<const InjectionCardinalityDataModel>(data).size_;
@@ -413,6 +429,7 @@ ThreadSafePooledString InjectionCardinalityEstimator::make_identifier(const Quer
         names.emplace_back(G.sources()[id]->name());
     std::sort(names.begin(), names.end(), [](auto lhs, auto rhs){ return strcmp(*lhs, *rhs) < 0; });
 
+    std::lock_guard lock(buffer_mutex_);
     buf_.clear();
     for (auto it = names.begin(); it != names.end(); ++it) {
         if (it != names.begin())
@@ -425,6 +442,375 @@ ThreadSafePooledString InjectionCardinalityEstimator::make_identifier(const Quer
 }
 
 
+/*======================================================================================================================
+ * FeedbackCardinalityEstimator
+ *====================================================================================================================*/
+
+namespace {
+
+/** Returns the identifier of the join of the relations `names`, i.e. the sorted names joined by '$'. */
+ThreadSafePooledString make_relations_identifier(std::vector<ThreadSafePooledString> &names)
+{
+    std::sort(names.begin(), names.end(), [](auto lhs, auto rhs){ return strcmp(*lhs, *rhs) < 0; });
+    std::string id;
+    for (auto it = names.begin(); it != names.end(); ++it) {
+        if (it != names.begin())
+            id += '$';
+        id += **it;
+    }
+    return Catalog::Get().pool(id.c_str());
+}
+
+/** Scales `size` by the ratio of `fallback_out` to `fallback_in`, i.e. by the selectivity predicted by the fallback
+ * estimator. */
+std::size_t scale(std::size_t size, double fallback_in, double fallback_out)
+{
+    if (fallback_in == 0)
+        return 0;
+    const double scaled = std::round(size * (fallback_out / fallback_in));
+    if (scaled >= double(std::numeric_limits<std::size_t>::max()))
+        return std::numeric_limits<std::size_t>::max(); // saturate rather than overflow
+    return scaled;
+}
+
+/** Returns the product of `lhs` and `rhs`, saturated to the largest `std::size_t`. */
+std::size_t saturating_mul(std::size_t lhs, std::size_t rhs)
+{
+    std::size_t product;
+    if (__builtin_mul_overflow(lhs, rhs, &product))
+        return std::numeric_limits<std::size_t>::max();
+    return product;
+}
+
+std::unique_ptr<CardinalityEstimator> create_fallback(const ThreadSafePooledString &name_of_database)
+{
+    auto &C = Catalog::Get();
+    if (streq(options::feedback_fallback, "Feedback")) {
+        std::cerr << "warning: the feedback estimator cannot fall back to itself, use CartesianProduct instead"
+                  << std::endl;
+        return C.create_cardinality_estimator(C.pool("CartesianProduct"), name_of_database);
+    }
+    return C.create_cardinality_estimator(C.pool(options::feedback_fallback), name_of_database);
+}
+
+}
+
+/*----- Constructors -------------------------------------------------------------------------------------------------*/
+
+FeedbackCardinalityEstimator::FeedbackCardinalityEstimator(ThreadSafePooledString name_of_database)
+    : name_of_database_(std::move(name_of_database))
+    , fallback_(create_fallback(name_of_database_))
+{
+    if (options::feedback_cardinalities_file.empty())
+        return; // observations are not persisted
+
+    if (std::ifstream in(options::feedback_cardinalities_file); in) {
+        Diagnostic diag(Options::Get().has_color, std::cout, std::cerr);
+        read_json(diag, in);
+    } // else no observations yet, the file is created on the first call to `persist()`
+}
+
+FeedbackCardinalityEstimator::~FeedbackCardinalityEstimator() { persist(); }
+
+FeedbackCardinalityEstimator::FeedbackCardinalityEstimator(Diagnostic &diag, ThreadSafePooledString name_of_database,
+                                                           std::istream &in,
+                                                           std::unique_ptr<CardinalityEstimator> fallback)
+    : name_of_database_(std::move(name_of_database))
+    , fallback_(std::move(fallback))
+{
+    read_json(diag, in);
+}
+
+void FeedbackCardinalityEstimator::read_json(Diagnostic &diag, std::istream &in)
+{
+    Catalog &C = Catalog::Get();
+    Position pos("FeedbackCardinalityEstimator");
+
+    using json = nlohmann::json;
+    json cardinalities;
+    try {
+        in >> cardinalities;
+    } catch (json::parse_error parse_error) {
+        diag.w(pos) << "The file could not be parsed as json. Parser error output:\n"
+                    << parse_error.what() << "\n"
+                    << "Previously observed cardinalities are ignored.\n";
+        return;
+    }
+    auto database_entry = cardinalities.find(*name_of_database_);
+    if (database_entry == cardinalities.end())
+        return; // no observations for this database yet
+
+    std::vector<ThreadSafePooledString> names;
+    for (auto &subproblem_entry : *database_entry) {
+        try {
+            names.clear();
+            for (auto &relation : subproblem_entry.at("relations"))
+                names.emplace_back(C.pool(relation.get<std::string>().c_str()));
+            cardinality_table_[make_relations_identifier(names)] = subproblem_entry.at("size").get<std::size_t>();
+        } catch (json::exception &exception) {
+            diag.w(pos) << "The entry " << subproblem_entry << " for the db \"" << name_of_database_ << "\""
+                        << " does not have the required form of {\"relations\": ..., \"size\": ... } "
+                        << "and will thus be ignored.\n";
+        }
+    }
+}
+
+/*----- Feedback -----------------------------------------------------------------------------------------------------*/
+
+void FeedbackCardinalityEstimator::observe(std::vector<ThreadSafePooledString> relations, std::size_t cardinality)
+{
+    M_insist(not relations.empty(), "cannot observe the join of no relations");
+    auto id = make_relations_identifier(relations);
+    std::lock_guard lock(mutex_);
+    auto [it, inserted] = cardinality_table_.try_emplace(std::move(id), cardinality);
+    if (inserted or it->second != cardinality) {
+        it->second = cardinality;
+        ++num_unpersisted_;
+    }
+}
+
+std::optional<std::size_t> FeedbackCardinalityEstimator::lookup(const QueryGraph &G, Subproblem S) const
+{
+    static thread_local std::vector<ThreadSafePooledString> names;
+    names.clear();
+    for (auto id : S)
+        names.emplace_back(G.sources()[id]->name().assert_not_none());
+    auto id = make_relations_identifier(names);
+
+    std::lock_guard lock(mutex_);
+    if (auto it = cardinality_table_.find(id); it != cardinality_table_.end())
+        return it->second;
+    return std::nullopt;
+}
+
+namespace {
+
+nlohmann::json to_json(const std::unordered_map<ThreadSafePooledString, std::size_t> &cardinality_table)
+{
+    using json = nlohmann::json;
+    json entries = json::array();
+    for (auto &[id, size] : cardinality_table) {
+        json relations = json::array();
+        std::string_view sv(*id);
+        for (std::size_t pos = 0;;) {
+            const auto end = sv.find('$', pos);
+            relations.emplace_back(sv.substr(pos, end - pos));
+            if (end == std::string_view::npos) break;
+            pos = end + 1;
+        }
+        entries.push_back({ { "relations", std::move(relations) }, { "size", size } });
+    }
+    return entries;
+}
+
+}
+
+void FeedbackCardinalityEstimator::write_json(std::ostream &out) const
+{
+    using json = nlohmann::json;
+    json file = json::object();
+    {
+        std::lock_guard lock(mutex_);
+        file[*name_of_database_] = to_json(cardinality_table_);
+    }
+    out << file.dump(4) << '\n';
+}
+
+void FeedbackCardinalityEstimator::persist() const
+{
+    if (options::feedback_cardinalities_file.empty())
+        return;
+
+    using json = nlohmann::json;
+    std::lock_guard lock(mutex_);
+    if (num_unpersisted_ == 0)
+        return;
+
+    /* Preserve the entries of other databases. */
+    json file = json::object();
+    if (std::ifstream in(options::feedback_cardinalities_file); in) {
+        try {
+            in >> file;
+        } catch (json::parse_error) {
+            file = json::object(); // overwrite corrupt file
+        }
+        if (not file.is_object())
+            file = json::object();
+    }
+    file[*name_of_database_] = to_json(cardinality_table_);
+
+    /* Write to a temporary file first and then rename it, such that the file is never left partially written. */
+    auto tmp = options::feedback_cardinalities_file;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp);
+        out << file.dump(4) << '\n';
+        if (not out) {
+            std::cerr << "warning: could not write cardinality feedback to " << tmp << std::endl;
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, options::feedback_cardinalities_file, ec);
+    if (ec) {
+        std::cerr << "warning: could not write cardinality feedback to " << options::feedback_cardinalities_file
+                  << ": " << ec.message() << std::endl;
+        return;
+    }
+    num_unpersisted_ = 0;
+}
+
+void FeedbackCardinalityEstimator::persist_if_due() const
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (num_unpersisted_ < options::feedback_persist_interval)
+            return;
+    }
+    persist();
+}
+
+/*----- Model calculation --------------------------------------------------------------------------------------------*/
+
+std::unique_ptr<DataModel> FeedbackCardinalityEstimator::empty_model() const
+{
+    return std::make_unique<FeedbackDataModel>(Subproblem(), 0, fallback_->empty_model());
+}
+
+std::unique_ptr<DataModel> FeedbackCardinalityEstimator::estimate_scan(const QueryGraph &G, Subproblem P) const
+{
+    auto fallback_model = fallback_->estimate_scan(G, P);
+    const std::size_t size = lookup(G, P).value_or(fallback_->predict_cardinality(*fallback_model));
+    return std::make_unique<FeedbackDataModel>(P, size, std::move(fallback_model));
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_filter(const QueryGraph &G, const DataModel &_data,
+                                              const cnf::CNF &filter) const
+{
+    auto &data = as<const FeedbackDataModel>(_data);
+    auto fallback_model = fallback_->estimate_filter(G, *data.fallback_, filter);
+
+    /* Observed cardinalities already include the effects of filters on the observed relations. */
+    if (auto size = lookup(G, data.subproblem_))
+        return std::make_unique<FeedbackDataModel>(data.subproblem_, *size, std::move(fallback_model));
+
+    const std::size_t size = scale(data.size_, fallback_->predict_cardinality(*data.fallback_),
+                                   fallback_->predict_cardinality(*fallback_model));
+    return std::make_unique<FeedbackDataModel>(data.subproblem_, size, std::move(fallback_model));
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_limit(const QueryGraph &G, const DataModel &_data, std::size_t limit,
+                                             std::size_t offset) const
+{
+    auto &data = as<const FeedbackDataModel>(_data);
+    const std::size_t remaining = offset > data.size_ ? 0UL : data.size_ - offset;
+    return std::make_unique<FeedbackDataModel>(data.subproblem_, std::min(remaining, limit),
+                                               fallback_->estimate_limit(G, *data.fallback_, limit, offset));
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_grouping(const QueryGraph &G, const DataModel &_data,
+                                                const std::vector<group_type> &groups) const
+{
+    auto &data = as<const FeedbackDataModel>(_data);
+    auto fallback_model = fallback_->estimate_grouping(G, *data.fallback_, groups);
+    if (groups.empty())
+        return std::make_unique<FeedbackDataModel>(data.subproblem_, 1, std::move(fallback_model)); // single group
+
+    /* A grouping cannot produce more groups than it receives tuples. */
+    const std::size_t size = std::min(data.size_, fallback_->predict_cardinality(*fallback_model));
+    return std::make_unique<FeedbackDataModel>(data.subproblem_, size, std::move(fallback_model));
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_join(const QueryGraph &G, const DataModel &_left, const DataModel &_right,
+                                            const cnf::CNF &condition) const
+{
+    auto &left  = as<const FeedbackDataModel>(_left);
+    auto &right = as<const FeedbackDataModel>(_right);
+
+    const Subproblem subproblem = left.subproblem_ | right.subproblem_;
+    auto fallback_model = fallback_->estimate_join(G, *left.fallback_, *right.fallback_, condition);
+
+    /* Clamp observed cardinality to at most the cardinality of the cartesian product of the join's children since
+     * the children may have been estimated from other observations. */
+    const std::size_t max_cardinality = saturating_mul(left.size_, right.size_);
+    if (auto size = lookup(G, subproblem))
+        return std::make_unique<FeedbackDataModel>(subproblem, std::min(*size, max_cardinality),
+                                                   std::move(fallback_model));
+
+    /* Apply the join selectivity predicted by the fallback estimator to the (possibly observed) children. */
+    const double fallback_product = double(fallback_->predict_cardinality(*left.fallback_)) *
+                                    double(fallback_->predict_cardinality(*right.fallback_));
+    const std::size_t size = scale(max_cardinality, fallback_product, fallback_->predict_cardinality(*fallback_model));
+    return std::make_unique<FeedbackDataModel>(subproblem, size, std::move(fallback_model));
+}
+
+template<typename PlanTable>
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph &G,
+                                         Subproblem to_join, const cnf::CNF &condition) const
+{
+    M_insist(to_join.size() >= 2, "must join at least two data sources");
+
+    /* Join the fallback models of all data sources pairwise, applying the entire condition only once. */
+    auto ds_it = to_join.begin();
+    auto &first = as<const FeedbackDataModel>(*PT[ds_it.as_set()].model);
+    const DataModel *fallback_current = first.fallback_.get();
+    std::unique_ptr<DataModel> fallback_model;
+    double fallback_product = fallback_->predict_cardinality(*first.fallback_);
+    std::size_t max_cardinality = first.size_;
+    for (++ds_it; ds_it != to_join.end(); ++ds_it) {
+        auto &model = as<const FeedbackDataModel>(*PT[ds_it.as_set()].model);
+        fallback_model = fallback_->estimate_join(G, *fallback_current, *model.fallback_,
+                                                  fallback_model ? cnf::CNF() : condition);
+        fallback_current = fallback_model.get();
+        fallback_product *= fallback_->predict_cardinality(*model.fallback_);
+        max_cardinality = saturating_mul(max_cardinality, model.size_);
+    }
+
+    if (auto size = lookup(G, to_join))
+        return std::make_unique<FeedbackDataModel>(to_join, std::min(*size, max_cardinality),
+                                                   std::move(fallback_model));
+
+    const std::size_t size = scale(max_cardinality, fallback_product, fallback_->predict_cardinality(*fallback_model));
+    return std::make_unique<FeedbackDataModel>(to_join, size, std::move(fallback_model));
+}
+
+std::size_t FeedbackCardinalityEstimator::predict_cardinality(const DataModel &data) const
+{
+    return as<const FeedbackDataModel>(data).size_;
+}
+
+double FeedbackCardinalityEstimator::predict_number_distinct_values(const DataModel &data) const
+{
+    return fallback_->predict_number_distinct_values(*as<const FeedbackDataModel>(data).fallback_);
+}
+
+M_LCOV_EXCL_START
+void FeedbackCardinalityEstimator::print(std::ostream &out) const
+{
+    constexpr uint32_t max_rows_printed = 100;     /// Number of rows of the cardinality_table printed
+    std::lock_guard lock(mutex_);
+    std::size_t sub_len = 13;                         /// Length of Subproblem column
+    for (auto &entry : cardinality_table_)
+        sub_len = std::max(sub_len, strlen(*entry.first));
+
+    out << std::left << "FeedbackCardinalityEstimator (" << cardinality_table_.size() << " observations)\n"
+        << std::setw(sub_len) << "Subproblem" << "Size" << "\n" << std::right;
+
+    uint32_t counter = 0;
+    for (auto &entry : cardinality_table_) {
+        if (counter >= max_rows_printed) break;
+        out << std::left << std::setw(sub_len) << entry.first << entry.second << "\n";
+        counter++;
+    }
+}
+M_LCOV_EXCL_STOP
+
+
 /*======================================================================================================================
  * SpnEstimator
  *====================================================================================================================*/
@@ -801,6 +1187,7 @@ void SpnEstimator::print(std::ostream&) const { }
 #define LIST_CE(X) \
     X(CartesianProductEstimator, "CartesianProduct", "estimates cardinalities as Cartesian product") \
     X(InjectionCardinalityEstimator, "Injected", "estimates cardinalities based on a JSON file") \
+    X(FeedbackCardinalityEstimator, "Feedback", "estimates cardinalities based on observations of past queries") \
     X(SpnEstimator, "Spn", "estimates cardinalities based on Sum-Product Networks")
 
 #define INSTANTIATE(TYPE, _1, _2) \
@@ -808,6 +1195,9 @@ void SpnEstimator::print(std::ostream&) const { }
                                                          const QueryGraph &G, Subproblem to_join, \
                                                          const cnf::CNF &condition) const; \
     template std::unique_ptr<DataModel> TYPE::operator()(estimate_join_all_tag, PlanTableLargeAndSparse &&PT, \
+                                                         const QueryGraph &G, Subproblem to_join, \
+                                                         const cnf::CNF &condition) const; \
+    template std::unique_ptr<DataModel> TYPE::operator()(estimate_join_all_tag, PlanTableCompact &&PT, \
                                                          const QueryGraph &G, Subproblem to_join, \
                                                          const cnf::CNF &condition) const;
 LIST_CE(INSTANTIATE)
@@ -865,4 +1255,31 @@ Example for injected cardinalities file:\n\
             options::injected_cardinalities_file = path;
         }
     );
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--cardinality-feedback-file",
+        /* description= */ "load and persist cardinalities observed by the Feedback estimator in the given JSON file",
+        [] (const char *path) {
+            options::feedback_cardinalities_file = path;
+        }
+    );
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--cardinality-feedback-fallback",
+        /* description= */ "the estimator the Feedback estimator falls back to for unobserved subproblems",
+        [] (const char *name) {
+            options::feedback_fallback = name;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--cardinality-feedback-persist-interval",
+        /* description= */ "number of changed observations after which the Feedback estimator persists them",
+        [] (std::size_t interval) {
+            options::feedback_persist_interval = interval;
+        }
+    );
 }
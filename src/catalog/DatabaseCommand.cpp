@@ -1,12 +1,15 @@
 #include <mutable/catalog/DatabaseCommand.hpp>
 
+#include "backend/Interpreter.hpp"
 #include "backend/StackMachine.hpp"
+#include <atomic>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/IR/Optimizer.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/storage/Index.hpp>
+#include <mutable/storage/LayoutAdvisor.hpp>
 #include <mutable/util/DotTool.hpp>
 
 
@@ -36,6 +39,22 @@ void learn_spns::execute(Diagnostic &diag)
     if (not Options::Get().quiet) { diag.out() << "Learned SPN on every table in " << DB.name << ".\n"; }
 }
 
+void advise_layouts::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    for (auto it = DB.begin_tables(); it != DB.end_tables(); ++it) {
+        auto &table = *it->second;
+        diag.out() << table.name() << ": ";
+        if (auto layout = storage::advise_layout(table); layout.has_value())
+            diag.out() << layout << " (" << table.store().access_statistics() << ")\n";
+        else
+            diag.out() << "no accesses recorded\n";
+    }
+}
+
 __attribute__((constructor(201)))
 static void register_instructions()
 {
@@ -43,6 +62,7 @@ static void register_instructions()
 #define REGISTER(NAME, DESCRIPTION) \
     C.register_instruction<NAME>(C.pool(#NAME), DESCRIPTION)
     REGISTER(learn_spns, "create an SPN for every table in the database");
+    REGISTER(advise_layouts, "suggest a data layout for every table in the database from the accesses of queries");
 #undef REGISTER
 }
 
@@ -90,6 +110,7 @@ void QueryDatabase::execute(Diagnostic &diag)
         producer = (*post_opt.second).operator()(std::move(producer));
     logical_plan_computation.stop();
     M_insist(bool(producer), "logical plan must have been computed");
+    storage::record_accesses(*producer);
 
     if (Options::Get().plan)
         producer->dump(diag.out());
@@ -148,6 +169,7 @@ void InsertRecords::execute(Diagnostic&)
     });
 
     /* Write all tuples to the store. */
+    const std::size_t first_row = store.num_rows();
     for (auto &t : I.tuples) {
         StackMachine get_tuple(Schema{});
         for (std::size_t i = 0; i != t.size(); ++i) {
@@ -174,14 +196,24 @@ void InsertRecords::execute(Diagnostic&)
 
         /*----- set timestamps if available. -----*/
         if (ts_begin != T.end_hidden()) {
-            tup.set(ts_begin->id, Value(transaction()->start_time()));
-            /* Set $ts_end to -1. It is a special value representing infinity. */
+            tup.set(ts_begin->id, Value(transaction()->write_time()));
+            /* Set $ts_end to -1. It is a special value representing infinity.  If timestamps are deferred, concurrent
+             * readers may observe the row while it is written.  Hence, the row is ended until written completely. */
             M_insist(ts_end != T.end_hidden());
-            tup.set(ts_end->id, Value(-1));
+            tup.set(ts_end->id, Value(transaction()->defers_timestamps() ? 0 : -1));
         }
 
         W.append(tup);
     }
+
+    if (ts_begin != T.end_hidden()) {
+        if (transaction()->defers_timestamps()) {
+            std::atomic_thread_fence(std::memory_order_release);
+            write_timestamps(T, ts_end->name, first_row, store.num_rows(), -1); // publish the written rows
+        }
+        transaction()->record_insert(T, first_row, store.num_rows());
+    }
+    record_written_rows(T, first_row, store.num_rows());
     /* Invalidate all indexes on the table. */
     DB.invalidate_indexes(T.name());
 }
@@ -193,7 +225,55 @@ void UpdateRecords::execute(Diagnostic&)
 
 void DeleteRecords::execute(Diagnostic&)
 {
-    M_unreachable("not yet implemented");
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    auto &D = ast<ast::DeleteStmt>();
+    auto &T = DB.get_table(D.table_name.text.assert_not_none());
+    auto &store = T.store();
+    const std::size_t num_rows = store.num_rows();
+    if (num_rows == 0) return;
+
+    /* Rows are not removed from the store but their lifetime is ended by setting `$ts_end`.  Sema ensures that the
+     * table is multi-versioned. */
+    const Schema S = T.schema();
+    auto ts_begin = C.pool("$ts_begin");
+    auto ts_end = C.pool("$ts_end");
+    const std::size_t idx_ts_begin = S[{T.name(), ts_begin}].first;
+    const std::size_t idx_ts_end = S[{T.name(), ts_end}].first;
+
+    /* Compile the predicate of the WHERE clause, if any. */
+    StackMachine predicate(S);
+    Tuple res({ Type::Get_Boolean(Type::TY_Vector) });
+    if (D.where) {
+        predicate.emit(*as<const ast::WhereClause>(*D.where).where, 1);
+        predicate.emit_St_Tup_b(0, 0);
+    }
+
+    auto loader = Interpreter::compile_load(S, store.memory().addr(), T.layout(), S);
+    Tuple row(S);
+    Tuple *load_args[] = { &row };
+    Tuple *predicate_args[] = { &res, &row };
+    for (std::size_t row_id = 0; row_id != num_rows; ++row_id) {
+        loader(load_args); // the loader advances to the next row with each invocation
+
+        /* Only rows visible to this transaction can be deleted. */
+        if (not transaction()->sees(row[idx_ts_begin].as_i(), row[idx_ts_end].as_i()))
+            continue;
+        if (D.where) {
+            predicate(predicate_args);
+            if (res.is_null(0) or not res[0].as_b())
+                continue;
+        }
+
+        /* End the lifetime of the row.  If the row was deleted by a concurrent transaction, which has not yet
+         * committed or committed after this transaction started, keep its `$ts_end`.  The conflict is detected when
+         * the transactions commit. */
+        if (row[idx_ts_end].as_i() == -1)
+            write_timestamps(T, ts_end, row_id, row_id + 1, transaction()->write_time());
+        transaction()->record_delete(T, row_id);
+        record_written_rows(T, row_id, row_id + 1);
+    }
 }
 
 void ImportDSV::execute(Diagnostic &diag)
@@ -211,7 +291,13 @@ void ImportDSV::execute(Diagnostic &diag)
                 diag.err() << ": " << strerror(errsv);
             diag.err() << std::endl;
         } else {
+            const std::size_t first_row = table_.store().num_rows();
             M_TIME_EXPR(R(file, path_.c_str()), "Read DSV file", C.timer());
+            record_written_rows(table_, first_row, table_.store().num_rows());
+            if (Options::Get().compress_imports) {
+                C.get_database_in_use().wait_for_indexes(table_.name()); // compressing changes the data layout
+                M_TIME_EXPR(compress(table_), "Compress table", C.timer());
+            }
         }
     } catch (m::invalid_argument e) {
         diag.err() << "Error reading DSV file: " << e.what() << "\n";
@@ -293,36 +379,68 @@ void DropTable::execute(Diagnostic &diag)
     }
 }
 
+void AlterTable::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    try {
+        auto &table = DB.get_table(table_name_);
+        auto &factory = C.data_layout(layout_name_);
+        DB.wait_for_indexes(table_name_); // indexes bulkloaded in the background scan the old data layout
+        M_TIME_EXPR(change_layout(table, factory), "Change the data layout", C.timer());
+        if (not Options::Get().quiet)
+            diag.out() << "Changed data layout of table " << table_name_ << " to " << layout_name_ << ".\n";
+    } catch (std::out_of_range) {
+        diag.err() << "Table " << table_name_ << " does not exist in Database " << DB.name << ".\n";
+    } catch (std::invalid_argument) {
+        diag.err() << "Data layout " << layout_name_ << " does not exist.\n";
+    }
+}
+
 void CreateIndex::execute(Diagnostic &diag)
 {
     auto &C = Catalog::Get();
     auto &DB = C.get_database_in_use();
     const auto &table = DB.get_table(table_name_);
 
-    /* Compute bulkloading schema from attribute name. */
+    /* Compute bulkloading schema from attribute names, in key order. */
     Schema schema;
-    for (auto &entry : table.schema()) {
-        if (entry.id.name == attribute_name_) {
-            schema.add(entry);
-            break; // only one-dimensional indexes are supported
-        }
-    }
+    const Schema table_schema = table.schema();
+    for (auto &attribute_name : attribute_names_)
+        schema.add(table_schema[{ table.name(), attribute_name }].second);
 
-    /* Bulkload index. */
-    try {
-        M_TIME_EXPR(index_->bulkload(table, schema), "Bulkload index", C.timer());
-    } catch (invalid_argument) {
-        diag.err() << "Could not bulkload index." << '\n';
+    /* Bulkload index, either in the background while queries keep scanning the table, or right away. */
+    const bool is_async = Options::Get().async_index_build;
+    if (not is_async) {
+        try {
+            M_TIME_EXPR(index_->bulkload(table, schema), "Bulkload index", C.timer());
+        } catch (invalid_argument) {
+            diag.err() << "Could not bulkload index." << '\n';
+        }
     }
 
     /* Add index to database. */
     try {
-        DB.add_index(std::move(index_), table_name_, attribute_name_, index_name_);
+        if (is_async) {
+            /* The build outlives this command, hence report errors through a copy of `diag`. */
+            DB.add_index_async(std::move(index_), table_name_, attribute_names_, index_name_,
+                               [&table, schema, diag](idx::IndexBase &index) mutable {
+                                   try {
+                                       index.bulkload(table, schema);
+                                   } catch (invalid_argument) {
+                                       diag.err() << "Could not bulkload index." << '\n';
+                                       throw; // leave the index invalid
+                                   }
+                               });
+        } else {
+            DB.add_index(std::move(index_), table_name_, attribute_names_, index_name_);
+        }
         if (not Options::Get().quiet)
-            diag.out() << "Created index " << index_name_ << ".\n";
+            diag.out() << (is_async ? "Building index " : "Created index ") << index_name_ << ".\n";
     } catch (std::out_of_range) {
-        diag.err() << "Table " << table_name_ << " or Attribute " << attribute_name_ << " does not exist in Database "
-                   << DB.name << ".\n";
+        diag.err() << "Table " << table_name_ << " or one of its key attributes does not exist in Database " << DB.name
+                   << ".\n";
     } catch (invalid_argument) {
         diag.err() << "Index " << index_name_ << " already exists in Database " << DB.name << ".\n";
     }
@@ -0,0 +1,427 @@
+#include "catalog/MVCCScheduler.hpp"
+
+#include "parse/Sema.hpp"
+#include <mutable/catalog/WriteAheadLog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
+#include <mutable/storage/Store.hpp>
+#include <unordered_set>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Returns `true` iff the writes \p first and \p second write to a common row. */
+bool overlap(const Scheduler::Transaction::Write &first, const Scheduler::Transaction::Write &second)
+{
+    return first.table == second.table and first.begin < second.end and second.begin < first.end;
+}
+
+/** Undoes the writes of \p t, in the inverse order they were performed. */
+void undo(const Scheduler::Transaction &t)
+{
+    Catalog &C = Catalog::Get();
+    auto ts_begin = C.pool("$ts_begin");
+    auto ts_end = C.pool("$ts_end");
+
+    for (auto it = t.writes().rbegin(); it != t.writes().rend(); ++it) {
+        auto &write = *it;
+        switch (write.kind) {
+            case Scheduler::Transaction::Write::W_Insert:
+                /* Mark the inserted rows as dead.  End the rows first, such that they never become visible. */
+                write_timestamps(*write.table, ts_end, write.begin, write.end, 0);
+                write_timestamps(*write.table, ts_begin, write.begin, write.end, 0);
+                break;
+
+            case Scheduler::Transaction::Write::W_Delete:
+                /* Revive the deleted rows, unless they were not ended by `t` but by a concurrent transaction. */
+                for (std::size_t row_id = write.begin; row_id != write.end; ++row_id) {
+                    if (read_timestamp(*write.table, ts_end, row_id) == t.pending_time())
+                        write_timestamps(*write.table, ts_end, row_id, row_id + 1, -1);
+                }
+                break;
+        }
+    }
+}
+
+}
+
+
+/*======================================================================================================================
+ * CommandQueue
+ *====================================================================================================================*/
+
+std::optional<m::Scheduler::queued_command> MVCCScheduler::CommandQueue::pop(bool is_reader)
+{
+    /* Finds the oldest command of the requested kind whose transaction has neither a command in execution nor an older
+     * queued command. */
+    auto find_next = [this, is_reader]() {
+        std::unordered_set<uint64_t> blocked_transactions;
+        for (auto it = command_list_.begin(); it != command_list_.end(); ++it) {
+            const uint64_t id = std::get<0>(*it).id();
+            if (running_transactions_.contains(id) or blocked_transactions.contains(id))
+                continue;
+            if (is<const ast::SelectStmt>(*std::get<1>(*it)) == is_reader)
+                return it;
+            blocked_transactions.insert(id); // younger commands of this transaction must wait for this command
+        }
+        return command_list_.end();
+    };
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto next = command_list_.end();
+    changed_.wait(lock, [&]() {
+        // always wake up if the queue is closed
+        if (closed_) [[unlikely]]
+            return true;
+        next = find_next();
+        return next != command_list_.end();
+    });
+    if (closed_) [[unlikely]] return std::nullopt;
+
+    queued_command res = std::move(*next);
+    command_list_.erase(next);
+    running_transactions_.insert(std::get<0>(res).id());
+    return { std::move(res) };
+}
+
+void MVCCScheduler::CommandQueue::push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag,
+                                       std::promise<bool> promise)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        /* Since the command queue is closed, no more command will be executed
+         * => set the promise of this newly pushed command to false right away */
+        promise.set_value(false);
+        return;
+    }
+    command_list_.emplace_back(t, std::move(command), diag, std::move(promise));
+    lock.unlock();
+    changed_.notify_all(); // wake up both worker threads, only one of them may execute the command
+}
+
+void MVCCScheduler::CommandQueue::done(const Transaction &t)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    M_insist(running_transactions_.contains(t.id()), "transaction has no command in execution");
+    running_transactions_.erase(t.id());
+    lock.unlock();
+    changed_.notify_all(); // younger commands of `t` may now be executed by either worker thread
+}
+
+void MVCCScheduler::CommandQueue::close()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    while (not command_list_.empty()) {
+        std::get<3>(command_list_.front()).set_value(false);
+        command_list_.pop_front();
+    }
+    lock.unlock();
+    changed_.notify_all();
+}
+
+
+/*======================================================================================================================
+ * MVCCScheduler
+ *====================================================================================================================*/
+
+MVCCScheduler::~MVCCScheduler()
+{
+    command_queue_.close();
+    if (reader_thread_.joinable())
+        reader_thread_.join();
+    if (writer_thread_.joinable())
+        writer_thread_.join();
+
+    {
+        std::lock_guard<std::mutex> lock(commit_mutex_);
+        is_closed_ = true;
+    }
+    gc_requested_.notify_one();
+    if (gc_thread_.joinable())
+        gc_thread_.join();
+}
+
+std::future<bool> MVCCScheduler::schedule_command(Transaction &t, std::unique_ptr<ast::Command> command,
+                                                  Diagnostic &diag)
+{
+    std::promise<bool> execution_completed;
+    auto execution_completed_future = execution_completed.get_future();
+    command_queue_.push(t, std::move(command), diag, std::move(execution_completed));
+
+    // Creating the worker threads not here but in the constructor of `MVCCScheduler` causes deadlocks.
+    std::call_once(start_threads_, [this]() {
+        reader_thread_ = std::thread(&MVCCScheduler::work, this, /* is_reader= */ true);
+        writer_thread_ = std::thread(&MVCCScheduler::work, this, /* is_reader= */ false);
+        gc_thread_ = std::thread(&MVCCScheduler::work_gc, this);
+    });
+    return execution_completed_future;
+}
+
+std::unique_ptr<Scheduler::Transaction> MVCCScheduler::begin_transaction()
+{
+    return std::make_unique<Transaction>(/* defers_timestamps= */ true);
+}
+
+bool MVCCScheduler::commit(std::unique_ptr<Transaction> t)
+{
+    Catalog &C = Catalog::Get();
+    std::shared_lock<std::shared_mutex> catalog_latch(catalog_latch_); // tables must not be dropped while stamped
+    std::unique_lock<std::mutex> lock(commit_mutex_);
+    if (t->start_time() == -1)
+        return true; // the transaction did not execute anything
+
+    /* The writer thread may concurrently append to the stores we stamp. */
+    std::shared_lock<std::shared_mutex> memory_latch(Store::Memory_Latch());
+
+    /*----- Validate the transaction: the first committer wins. -----*/
+    for (auto &committed : committed_deletes_) {
+        if (committed.commit_time <= t->start_time())
+            continue; // the deletes were visible to `t`, hence `t` cannot have deleted the same rows
+        for (auto &write : t->writes()) {
+            if (write.kind != Transaction::Write::W_Delete)
+                continue;
+            for (auto &other : committed.deletes) {
+                if (overlap(write, other)) {
+                    undo(*t);
+                    add_gc_candidates(*t, Transaction::Write::W_Insert, 0); // the undone inserts are dead
+                    close(*t);
+                    return false;
+                }
+            }
+        }
+    }
+
+    /*----- Stamp the written rows with the commit time. -----*/
+    if (not t->writes().empty()) {
+        const int64_t commit_time = next_timestamp_++;
+        if (next_timestamp_ < 0) [[unlikely]] M_unreachable("Transaction timestamp overflow");
+
+        std::vector<Transaction::Write> deletes;
+        for (auto &write : t->writes()) {
+            switch (write.kind) {
+                case Transaction::Write::W_Insert:
+                    write_timestamps(*write.table, C.pool("$ts_begin"), write.begin, write.end, commit_time);
+                    break;
+
+                case Transaction::Write::W_Delete:
+                    write_timestamps(*write.table, C.pool("$ts_end"), write.begin, write.end, commit_time);
+                    deletes.push_back(write);
+                    break;
+            }
+        }
+        if (not deletes.empty())
+            committed_deletes_.push_back(CommittedDeletes{ commit_time, std::move(deletes) });
+        add_gc_candidates(*t, Transaction::Write::W_Delete, commit_time);
+    }
+
+    /*----- Log the transaction.  Commits are serialized, hence the log orders transactions by their commit. -----*/
+    auto wal = C.wal();
+    const uint64_t lsn = wal ? wal->append(*t) : 0;
+
+    close(*t);
+    memory_latch.unlock();
+    lock.unlock();
+    catalog_latch.unlock();
+
+    /* Wait until the transaction is durable.  Transactions committing meanwhile share the flush. */
+    if (lsn) {
+        wal->flush(lsn);
+        if (wal->needs_checkpoint())
+            checkpoint();
+    }
+    return true;
+}
+
+bool MVCCScheduler::abort(std::unique_ptr<Transaction> t)
+{
+    std::shared_lock<std::shared_mutex> catalog_latch(catalog_latch_); // tables must not be dropped while undone
+    std::lock_guard<std::mutex> lock(commit_mutex_);
+    if (t->start_time() == -1)
+        return true; // the transaction did not execute anything
+
+    /* The writer thread may concurrently append to the stores we undo writes in. */
+    std::shared_lock<std::shared_mutex> memory_latch(Store::Memory_Latch());
+    undo(*t);
+    add_gc_candidates(*t, Transaction::Write::W_Insert, 0); // the undone inserts are dead
+    close(*t);
+    return true;
+}
+
+void MVCCScheduler::checkpoint()
+{
+    /* A checkpoint reads all stores.  Hence, no command must execute and no transaction must commit or abort. */
+    std::unique_lock<std::shared_mutex> catalog_latch(catalog_latch_);
+    std::lock_guard<std::mutex> lock(commit_mutex_);
+    auto wal = Catalog::Get().wal();
+    if (not wal or not active_transactions_.empty())
+        return; // rows written by active transactions are not committed yet
+    wal->checkpoint();
+}
+
+void MVCCScheduler::collect_garbage()
+{
+    /* Compacting a table moves the rows that indexes are bulkloaded from in the background.  Wait for these builds
+     * before excluding all commands, such that commands keep executing meanwhile. */
+    {
+        std::shared_lock<std::shared_mutex> catalog_latch(catalog_latch_);
+        std::vector<ThreadSafePooledString> table_names;
+        {
+            std::lock_guard<std::mutex> lock(commit_mutex_);
+            for (auto &[table, _] : gc_candidates_)
+                table_names.push_back(table->name());
+        }
+        Catalog &C = Catalog::Get();
+        if (C.has_database_in_use()) {
+            for (auto &table_name : table_names) {
+                if (C.get_database_in_use().has_table(table_name))
+                    C.get_database_in_use().wait_for_indexes(table_name);
+            }
+        }
+    }
+
+    /* Compacting a table moves its rows.  Hence, no command must execute and no transaction must commit or abort. */
+    std::unique_lock<std::shared_mutex> catalog_latch(catalog_latch_);
+    std::lock_guard<std::mutex> lock(commit_mutex_);
+    Catalog &C = Catalog::Get();
+    if (gc_candidates_.empty() or not C.has_database_in_use())
+        return;
+
+    /* Versions ended at or before the start time of the oldest active transaction are invisible to every active
+     * transaction.  Future transactions start at `next_timestamp_` or later. */
+    const int64_t horizon = active_transactions_.empty() ? next_timestamp_ : active_transactions_.begin()->first;
+
+    /* Rows of tables that are referred to by ID must not move. */
+    std::unordered_set<const Table*> pinned_tables;
+    for (auto &[_, t] : active_transactions_) {
+        for (auto &write : t->writes())
+            pinned_tables.insert(write.table);
+    }
+    for (auto &committed : committed_deletes_) {
+        for (auto &write : committed.deletes)
+            pinned_tables.insert(write.table);
+    }
+
+    auto &DB = C.get_database_in_use();
+    for (auto it = DB.begin_tables(); it != DB.end_tables(); ++it) {
+        Table &table = *it->second;
+        auto candidate = gc_candidates_.find(&table);
+        if (candidate == gc_candidates_.end() or candidate->second > horizon or pinned_tables.contains(&table))
+            continue; // no garbage or not yet collectable
+        if (DB.is_building_indexes(table.name()))
+            continue; // a build started meanwhile, collect later rather than wait while excluding all commands
+        if (m::collect_garbage(table, horizon))
+            DB.invalidate_indexes(table.name()); // row IDs changed
+        gc_candidates_.erase(candidate);
+    }
+}
+
+void MVCCScheduler::work(bool is_reader)
+{
+    while (auto ret = command_queue_.pop(is_reader)) {
+        auto [t, ast, diag, promise] = std::move(ret.value());
+        start(t);
+
+        bool err;
+        {
+            /* Data definition commands and instructions may modify the catalog and the layout of stores arbitrarily.
+             * Hence, they execute exclusively.  So do imports that compress the table afterwards, since compressing
+             * rewrites all rows in a new data layout.  Queries and data manipulation execute concurrently. */
+            const bool is_import = is<const ast::DSVImportStmt>(*ast);
+            const bool is_exclusive = not is_reader and not is<const ast::InsertStmt>(*ast) and
+                                      not is<const ast::UpdateStmt>(*ast) and not is<const ast::DeleteStmt>(*ast) and
+                                      (not is_import or Options::Get().compress_imports);
+            std::shared_lock<std::shared_mutex> shared_catalog_latch(catalog_latch_, std::defer_lock);
+            std::unique_lock<std::shared_mutex> exclusive_catalog_latch(catalog_latch_, std::defer_lock);
+            if (is_exclusive)
+                exclusive_catalog_latch.lock();
+            else
+                shared_catalog_latch.lock();
+
+            ast::Sema sema(diag);
+            err = diag.num_errors() > 0; // parser errors
+
+            diag.clear();
+            auto cmd = sema.analyze(std::move(ast));
+            err |= diag.num_errors() > 0; // sema errors
+
+            M_insist(not err == bool(cmd), "when there are no errors, Sema must have returned a command");
+            if (not err and cmd) {
+                cmd->transaction(&t);
+                err = not execute_command(t, *cmd, diag);
+            }
+        }
+
+        command_queue_.done(t);
+        promise.set_value(not err);
+    }
+}
+
+void MVCCScheduler::work_gc()
+{
+    std::unique_lock<std::mutex> lock(commit_mutex_);
+    for (;;) {
+        gc_requested_.wait(lock, [this]() { return is_closed_ or (is_background_gc_enabled_ and is_gc_requested_); });
+        if (is_closed_)
+            return;
+        is_gc_requested_ = false;
+        lock.unlock();
+        collect_garbage(); // acquires the catalog latch before the commit mutex, like commits do
+        lock.lock();
+    }
+}
+
+void MVCCScheduler::start(Transaction &t)
+{
+    std::lock_guard<std::mutex> lock(commit_mutex_);
+    if (t.start_time() != -1) return;
+
+    /* The start time is assigned while no transaction commits, such that the snapshot of `t` contains either all or
+     * none of the writes of a committing transaction. */
+    t.start_time(next_timestamp_++);
+    if (next_timestamp_ < 0) [[unlikely]] M_unreachable("Transaction timestamp overflow");
+    active_transactions_.emplace(t.start_time(), &t);
+}
+
+void MVCCScheduler::add_gc_candidates(const Transaction &t, Transaction::Write::kind_t kind, int64_t time)
+{
+    for (auto &write : t.writes()) {
+        if (write.kind != kind)
+            continue;
+        auto [it, inserted] = gc_candidates_.emplace(write.table, time);
+        if (not inserted)
+            it->second = std::max(it->second, time);
+    }
+}
+
+void MVCCScheduler::close(const Transaction &t)
+{
+    active_transactions_.erase(t.start_time());
+
+    /* Committed deletes can only conflict with transactions that started before the deletes were committed. */
+    while (not committed_deletes_.empty() and
+           (active_transactions_.empty() or
+            committed_deletes_.front().commit_time <= active_transactions_.begin()->first))
+        committed_deletes_.pop_front();
+
+    /* Closing `t` may have advanced the horizon of garbage collection or may have produced garbage. */
+    if (not gc_candidates_.empty()) {
+        is_gc_requested_ = true;
+        gc_requested_.notify_one();
+    }
+}
+
+__attribute__((constructor(202)))
+static void register_scheduler()
+{
+    Catalog &C = Catalog::Get();
+    C.register_scheduler(
+        C.pool("MVCCScheduler"),
+        std::make_unique<MVCCScheduler>(),
+        "executes queries concurrently to writes on snapshots of multi-versioned tables"
+    );
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <mutable/catalog/Scheduler.hpp>
+#include <condition_variable>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace m {
+
+/** This class implements a Scheduler that uses *multi-version concurrency control* (MVCC) to execute the commands of
+ * different transactions concurrently.  The rows of multi-versioned tables carry the timestamps `$ts_begin` and
+ * `$ts_end`, from which every transaction reads the snapshot as of its start time.
+ *
+ * Queries execute on a *reader* thread, all other commands execute on a *writer* thread.  Hence, a long running query
+ * does not block writers and vice versa.  Commands of the same transaction execute in the order they were scheduled.
+ * Data definition commands and instructions execute exclusively, i.e. while no other command executes.
+ *
+ * Rows written by a transaction are stamped with the transaction's pending time, that is invisible to other
+ * transactions, until the transaction commits.  On commit, the transaction is validated *first-committer-wins*: if a
+ * transaction that committed after this transaction started has deleted one of the rows this transaction deleted, this
+ * transaction is aborted.  Otherwise, the written rows are stamped with the commit time.  On abort, the writes of the
+ * transaction are undone by their log, see `Scheduler::Transaction::writes()`.
+ *
+ * Versions that are ended before the oldest active transaction started are invisible to every transaction.  A
+ * *garbage collector* thread reclaims them by compacting the tables of the database in use whose versions were ended by
+ * deletes or aborts, see `collect_garbage()`. */
+struct MVCCScheduler : Scheduler
+{
+    private:
+    /** A thread-safe queue of commands, from which the reader and the writer thread pop the commands they execute. */
+    struct CommandQueue
+    {
+        private:
+        std::list<queued_command> command_list_;
+        std::unordered_set<uint64_t> running_transactions_; ///< IDs of the transactions with a command in execution
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        bool closed_ = false;
+
+        public:
+        /** Returns the next queued query if \p is_reader, or the next queued command of another kind otherwise.  The
+         * returned command is the oldest command of its kind whose transaction has neither a command in execution nor
+         * an older queued command.  Blocks until there is such a command.  Returns `std::nullopt` if the queue is
+         * closed. */
+        std::optional<queued_command> pop(bool is_reader);
+        /** Inserts the command into the queue. */
+        void push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag, std::promise<bool> promise);
+        /** Marks the command of `t` in execution as completed. */
+        void done(const Transaction &t);
+        void close(); ///< empties and closes the queue without executing the remaining `ast::Command`s.
+    };
+
+    /** The rows deleted by a committed transaction, required to validate concurrent transactions. */
+    struct CommittedDeletes
+    {
+        int64_t commit_time;
+        std::vector<Transaction::Write> deletes;
+    };
+
+    CommandQueue command_queue_; ///< the queue of commands to execute
+    std::once_flag start_threads_; ///< used to start the worker threads on the first scheduled command
+    std::thread reader_thread_; ///< the worker thread that executes queries
+    std::thread writer_thread_; ///< the worker thread that executes all other commands
+    ///> held shared by queries and data manipulation, exclusively by data definition and instructions
+    std::shared_mutex catalog_latch_;
+
+    ///> serializes commits with each other and with the assignment of start times
+    std::mutex commit_mutex_;
+    int64_t next_timestamp_ = 0; ///< the next start or commit time
+    ///> maps the start times of all started, but not yet closed transactions to these transactions
+    std::map<int64_t, const Transaction*> active_transactions_;
+    ///> the deletes of committed transactions that may conflict with active transactions, ordered by commit time
+    std::list<CommittedDeletes> committed_deletes_;
+
+    std::thread gc_thread_; ///< the thread collecting garbage in the background
+    std::condition_variable gc_requested_; ///< notified with `commit_mutex_` held when a transaction is closed
+    ///> maps the tables containing versions that may be garbage to the latest time at which such a version was ended
+    std::unordered_map<const Table*, int64_t> gc_candidates_;
+    bool is_gc_requested_ = false; ///< whether garbage may be collected since the last collection
+    bool is_background_gc_enabled_ = true; ///< whether the garbage collector thread collects garbage
+    bool is_closed_ = false; ///< whether the scheduler is destroyed, such that the garbage collector thread exits
+
+    public:
+    MVCCScheduler() = default;
+    ~MVCCScheduler();
+
+    std::future<bool> schedule_command(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag) override;
+
+    std::unique_ptr<Transaction> begin_transaction() override;
+
+    bool commit(std::unique_ptr<Transaction> t) override;
+
+    bool abort(std::unique_ptr<Transaction> t) override;
+
+    /** Reclaims the versions that are invisible to every active and future transaction from the candidate tables of the
+     * database in use.  Tables with rows that are referred to by ID, i.e. written by active transactions or deleted by
+     * committed transactions that active transactions are validated against, are left for a later collection.  Waits
+     * for all commands in execution to complete.  Invalidates the indexes of the compacted tables. */
+    void collect_garbage();
+
+    /** Takes a checkpoint of the `WriteAheadLog` of the `Catalog`, if any.  Waits for all commands in execution to
+     * complete.  A checkpoint must only contain committed rows, hence it is skipped while transactions are active. */
+    void checkpoint();
+
+    /** Enables or disables collecting garbage in the background.  If disabled, garbage is only collected by explicit
+     * calls to `collect_garbage()`. */
+    void background_gc(bool enable) {
+        std::lock_guard<std::mutex> lock(commit_mutex_);
+        is_background_gc_enabled_ = enable;
+    }
+
+    private:
+    /** The method run by the worker threads.  Executes queries if \p is_reader, all other commands otherwise. */
+    void work(bool is_reader);
+    /** The method run by the garbage collector thread.  Collects garbage whenever a transaction was closed. */
+    void work_gc();
+
+    /** Assigns a start time to `t` if it has none. */
+    void start(Transaction &t);
+    /** Registers the tables of the writes of `t` of kind \p kind as candidates for garbage collection, whose versions
+     * were ended at \p time.  Requires `commit_mutex_` to be held. */
+    void add_gc_candidates(const Transaction &t, Transaction::Write::kind_t kind, int64_t time);
+    /** Removes `t` from the active transactions, discards committed deletes that cannot conflict with any active
+     * transaction anymore, and requests garbage collection.  Requires `commit_mutex_` to be held. */
+    void close(const Transaction &t);
+};
+
+}
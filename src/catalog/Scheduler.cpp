@@ -1,22 +1,85 @@
 #include <mutable/catalog/Scheduler.hpp>
 
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/DatabaseCommand.hpp>
+#include <mutable/catalog/WriteAheadLog.hpp>
+#include <mutable/Options.hpp>
+#include <sstream>
+
 
 using namespace m;
 
 
+thread_local const CancellationToken *CancellationToken::current_ = nullptr;
+
 std::atomic<uint64_t> Scheduler::Transaction::next_id_;
 
 bool Scheduler::autocommit (std::unique_ptr<ast::Command> command, Diagnostic &diag) {
     auto t = begin_transaction();
+    /* Only user-issued commands are limited.  Statements replayed by recovery must complete, otherwise the recovered
+     * database would silently lack their effects. */
+    auto wal = Catalog::Get().wal();
+    if (not wal or not wal->is_recovering())
+        t->timeout(std::chrono::milliseconds(Options::Get().query_timeout));
     auto res_future = schedule_command(*t, std::move(command), diag);
     res_future.wait();
     if (res_future.get()) {
-        bool res = commit(std::move(t));
-        M_insist(res);
-        return res;
+        return commit(std::move(t)); // may fail if the transaction conflicts with another transaction
     } else {
         bool aborted = abort(std::move(t));
         M_insist(aborted);
         return false;
     }
 }
+
+bool Scheduler::execute_command(Transaction &t, DatabaseCommand &cmd, Diagnostic &diag)
+{
+    auto &token = t.cancellation_token();
+    if (t.timeout() > std::chrono::milliseconds::zero())
+        token.deadline(CancellationToken::clock::now() + t.timeout());
+    else
+        token.clear_deadline();
+
+    CancellationToken::Scope scope(token);
+    try {
+        CancellationToken::Check(); // the transaction may have been cancelled while the command was queued
+        cmd.execute(diag);
+    } catch (const execution_cancelled &e) {
+        diag.err() << "Command interrupted: " << e.what() << ".\n";
+        return false;
+    }
+    if (diag.num_errors() == 0)
+        log_command(t, cmd);
+    return true;
+}
+
+void Scheduler::log_command(Transaction &t, DatabaseCommand &cmd)
+{
+    Catalog &C = Catalog::Get();
+    auto wal = C.wal();
+    if (not wal or wal->is_recovering())
+        return;
+
+    std::string database = C.has_database_in_use() ? std::string(*C.get_database_in_use().name) : std::string();
+
+    /* Rows are logged by their values.  Replaying the statement instead would depend on the snapshot it read, e.g. the
+     * rows a `DELETE` saw, and on external state, e.g. the file an `IMPORT` read. */
+    if (auto dml = cast<const DMLCommand>(&cmd)) {
+        auto table = dml->written_table();
+        if (not table)
+            return; // the command did not write any rows, e.g. a query
+        const auto kind = is<const DeleteRecords>(cmd) ? Transaction::LoggedEffect::E_Delete
+                                                       : Transaction::LoggedEffect::E_Insert;
+        t.log_rows(kind, std::move(database), std::string(*table->name()),
+                   WriteAheadLog::Serialize_Rows(*table, dml->written_rows()));
+        return;
+    }
+
+    /* Only statements that modify the catalog are logged.  `USE` merely changes the session. */
+    if (not is<const DDLCommand>(cmd) or is<const UseDatabase>(cmd))
+        return;
+
+    std::ostringstream sql;
+    sql << cmd.ast();
+    t.log_statement(std::move(database), sql.str());
+}
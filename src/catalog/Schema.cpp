@@ -13,6 +13,7 @@
 #include <mutable/lex/Token.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/parse/AST.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/util/enum_ops.hpp>
 #include <mutable/util/fn.hpp>
 #include <stdexcept>
@@ -98,9 +99,25 @@ Schema ConcreteTable::schema(const ThreadSafePooledOptionalString &alias) const
     return S;
 }
 
+ConcreteTable::ConcreteTable(ThreadSafePooledString name) : name_(std::move(name)) { }
+
+ConcreteTable::~ConcreteTable() = default;
+
+void ConcreteTable::layout(storage::DataLayout &&new_layout)
+{
+    layout_ = std::move(new_layout);
+    layout_factory_.reset(); // the layout was not made by a factory
+}
+
 void ConcreteTable::layout(const storage::DataLayoutFactory &factory) {
-    view v(cbegin_all(), cend_all(), [](auto it) -> auto & { return it->type; });
-    layout_ = factory.make(v.begin(), v.end());
+    std::vector<const Type*> types;
+    std::vector<bool> nullable;
+    for (auto attr = cbegin_all(); attr != cend_all(); ++attr) {
+        types.push_back(attr->type);
+        nullable.push_back(not attr->not_nullable);
+    }
+    layout_ = factory.make(std::move(types), std::move(nullable));
+    layout_factory_ = factory.clone();
 }
 
 M_LCOV_EXCL_START
@@ -196,6 +213,43 @@ void apply_timestamp_filter(QueryGraph &G)
                 );
                 ts_begin_filter_clause->type(Type::Get_Boolean(Type::TY_Vector));
 
+                /* If the transaction defers its timestamps, the rows it has written are stamped with its pending time
+                 * until it commits.  Build predicates comparing a timestamp attribute to the pending time, such that the
+                 * transaction sees its own writes. */
+                const bool defers_timestamps = G.transaction()->defers_timestamps();
+                auto make_pending_time_predicate = [&](const ast::Token &ts, ast::Token tok) {
+                    std::unique_ptr<ast::Expr> designator = std::make_unique<ast::Designator>(
+                            ts,
+                            table_name,
+                            ts,
+                            Type::Get_Integer(Type::TY_Vector, 8),
+                            &bt->table()[ts.text.assert_not_none()]
+                    );
+                    std::unique_ptr<ast::Expr> pending_time_constant = std::make_unique<ast::Constant>(ast::Token(
+                            pos,
+                            C.pool(std::to_string(G.transaction()->pending_time()).c_str()),
+                            m::TK_DEC_INT
+                    ));
+                    pending_time_constant->type(Type::Get_Integer(Type::TY_Vector, 8));
+                    std::unique_ptr<ast::Expr> predicate = std::make_unique<ast::BinaryExpr>(
+                            std::move(tok),
+                            std::move(designator),
+                            std::move(pending_time_constant)
+                    );
+                    predicate->type(Type::Get_Boolean(Type::TY_Vector));
+                    return predicate;
+                };
+
+                // $ts_begin <= TST OR $ts_begin = PT, where PT := pending time of the transaction
+                if (defers_timestamps) {
+                    ts_begin_filter_clause = std::make_unique<ast::BinaryExpr>(
+                            ast::Token(pos, C.pool("OR"), TK_Or),
+                            std::move(ts_begin_filter_clause),
+                            make_pending_time_predicate(ts_begin, ast::Token(pos, C.pool("="), TK_EQUAL))
+                    );
+                    ts_begin_filter_clause->type(Type::Get_Boolean(Type::TY_Vector));
+                }
+
                 // $ts_end
                 std::unique_ptr<ast::Expr> ts_end_designator = std::make_unique<ast::Designator>(
                         ts_end,
@@ -221,6 +275,16 @@ void apply_timestamp_filter(QueryGraph &G)
                 );
                 ts_end_greater_transaction_expr->type(Type::Get_Boolean(Type::TY_Vector));
 
+                // $ts_end > TST AND $ts_end != PT
+                if (defers_timestamps) {
+                    ts_end_greater_transaction_expr = std::make_unique<ast::BinaryExpr>(
+                            ast::Token(pos, C.pool("AND"), TK_And),
+                            std::move(ts_end_greater_transaction_expr),
+                            make_pending_time_predicate(ts_end, ast::Token(pos, C.pool("!="), TK_BANG_EQUAL))
+                    );
+                    ts_end_greater_transaction_expr->type(Type::Get_Boolean(Type::TY_Vector));
+                }
+
                 // $ts_end
                 std::unique_ptr<ast::Expr> ts_end_designator_2 = std::make_unique<ast::Designator>(
                         ts_end,
@@ -297,6 +361,31 @@ void Function::dump(std::ostream &out) const
 M_LCOV_EXCL_STOP
 
 
+/*======================================================================================================================
+ * ScalarUDF
+ *====================================================================================================================*/
+
+ScalarUDF::ScalarUDF(ThreadSafePooledString name, std::vector<const PrimitiveType*> parameter_types,
+                     const PrimitiveType *return_type, callback_type callback)
+    : Function(std::move(name), FN_UDF, FN_Scalar)
+    , parameter_types(std::move(parameter_types))
+    , return_type(return_type)
+    , callback(std::move(callback))
+{
+    if (this->parameter_types.size() > MAX_NUM_PARAMETERS)
+        throw invalid_argument("too many parameters for a user-defined function");
+    for (auto ty : this->parameter_types) {
+        if (not ty)
+            throw invalid_argument("missing parameter type of user-defined function");
+    }
+    if (not return_type)
+        throw invalid_argument("missing return type of user-defined function");
+    for (auto &ty : this->parameter_types)
+        ty = ty->as_scalar();
+    this->return_type = return_type->as_scalar();
+}
+
+
 /*======================================================================================================================
  * Database
  *====================================================================================================================*/
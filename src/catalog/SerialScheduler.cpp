@@ -1,5 +1,6 @@
 #include "catalog/SerialScheduler.hpp"
 #include "parse/Sema.hpp"
+#include <mutable/catalog/WriteAheadLog.hpp>
 #include <mutable/mutable.hpp>
 
 
@@ -118,7 +119,15 @@ std::unique_ptr<SerialScheduler::Transaction> SerialScheduler::begin_transaction
 bool SerialScheduler::commit(std::unique_ptr<SerialScheduler::Transaction> t) {
     /* TODO: When autocommit is not used as the default anymore, the transaction must check for conflicts with
      * other transactions that were introduced in the time between when this transaction executed statements and now. */
+    auto wal = Catalog::Get().wal();
+    const uint64_t lsn = wal ? wal->append(*t) : 0;
+    if (wal and wal->needs_checkpoint())
+        wal->checkpoint(); // no command executes while `t` is running
     query_queue_.stop_transaction(*t);
+
+    /* Wait until the transaction is durable.  The next transaction may already execute and share the flush. */
+    if (lsn)
+        wal->flush(lsn);
     return true;
 }
 
@@ -155,8 +164,7 @@ void SerialScheduler::schedule_thread()
         M_insist(not err == bool(cmd), "when there are no errors, Sema must have returned a command");
         if (not err and cmd) {
             cmd->transaction(&t);
-            cmd->execute(diag);
-            promise.set_value(true);
+            promise.set_value(execute_command(t, *cmd, diag));
             continue;
         }
         promise.set_value(false);
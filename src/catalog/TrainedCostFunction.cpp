@@ -71,6 +71,9 @@ double TrainedCostFunction::operator()<const PlanTableSmallOrDense&>(calculate_f
 template
 double TrainedCostFunction::operator()<const PlanTableLargeAndSparse&>(calculate_filter_cost_tag, const PlanTableLargeAndSparse &PT, const QueryGraph &G,
                                        const CardinalityEstimator &CE, Subproblem sub, const cnf::CNF &condition) const;
+template
+double TrainedCostFunction::operator()<const PlanTableCompact&>(calculate_filter_cost_tag, const PlanTableCompact &PT, const QueryGraph &G,
+                                       const CardinalityEstimator &CE, Subproblem sub, const cnf::CNF &condition) const;
 
 
 template
@@ -81,6 +84,10 @@ template
 double TrainedCostFunction::operator()<const PlanTableLargeAndSparse&>(calculate_join_cost_tag, const PlanTableLargeAndSparse &PT, const QueryGraph &G,
                                        const CardinalityEstimator &CE, Subproblem left, Subproblem right,
                                        const cnf::CNF &condition) const;
+template
+double TrainedCostFunction::operator()<const PlanTableCompact&>(calculate_join_cost_tag, const PlanTableCompact &PT, const QueryGraph &G,
+                                       const CardinalityEstimator &CE, Subproblem left, Subproblem right,
+                                       const cnf::CNF &condition) const;
 
 template
 double TrainedCostFunction::operator()<const PlanTableSmallOrDense&>(calculate_grouping_cost_tag, const PlanTableSmallOrDense &PT, const QueryGraph&,
@@ -90,3 +97,7 @@ template
 double TrainedCostFunction::operator()<const PlanTableLargeAndSparse&>(calculate_grouping_cost_tag, const PlanTableLargeAndSparse &PT, const QueryGraph&,
                                        const CardinalityEstimator &CE, Subproblem sub,
                                        const std::vector<const Expr*>&) const;
+template
+double TrainedCostFunction::operator()<const PlanTableCompact&>(calculate_grouping_cost_tag, const PlanTableCompact &PT, const QueryGraph&,
+                                       const CardinalityEstimator &CE, Subproblem sub,
+                                       const std::vector<const Expr*>&) const;
@@ -0,0 +1,745 @@
+#include <mutable/catalog/WriteAheadLog.hpp>
+
+#include "backend/Interpreter.hpp"
+#include "parse/Parser.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/util/exception.hpp>
+#include <sstream>
+#include <string_view>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+
+
+using namespace m;
+
+
+namespace {
+
+/** The size in bytes of the frame preceding the payload of each record, i.e. its size and its checksum. */
+constexpr std::size_t FRAME_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+/** The size in bytes of the payload after which a checkpoint starts a new record of rows. */
+constexpr std::size_t MAX_ROWS_PAYLOAD_SIZE = 1UL << 20;
+
+/** The kinds of records of a checkpoint. */
+enum checkpoint_record_t : char
+{
+    CR_Header = 'C',    ///< the LSN of the last transaction contained in the checkpoint
+    CR_Statement = 'S', ///< a statement creating a database, a table, or an index
+    CR_Rows = 'R',      ///< rows of a table
+};
+
+/** Computes the FNV-1a hash of the \p size bytes at \p data.  The hash detects records torn by a crash. */
+uint64_t checksum(const char *data, std::size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325UL;
+    for (std::size_t i = 0; i != size; ++i) {
+        hash ^= uint8_t(data[i]);
+        hash *= 0x100000001b3UL;
+    }
+    return hash;
+}
+
+/** Serializes values into the payload of a record. */
+struct PayloadWriter
+{
+    std::string payload;
+
+    template<typename T>
+    requires std::is_arithmetic_v<T>
+    void put(T value) { payload.append(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+    void put(std::string_view str) {
+        put(uint32_t(str.size()));
+        payload.append(str);
+    }
+};
+
+/** Deserializes values from the payload of a record.  Throws `m::runtime_error` if the payload is exhausted. */
+struct PayloadReader
+{
+    std::string_view payload;
+
+    bool empty() const { return payload.empty(); }
+
+    template<typename T>
+    requires std::is_arithmetic_v<T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+
+    std::string_view get_string() { return take(get<uint32_t>()); }
+
+    private:
+    std::string_view take(std::size_t size) {
+        if (payload.size() < size)
+            throw runtime_error("malformed record");
+        auto res = payload.substr(0, size);
+        payload.remove_prefix(size);
+        return res;
+    }
+};
+
+/** Appends \p payload framed by its size and its checksum to \p out. */
+void frame(std::string &out, const std::string &payload)
+{
+    const uint32_t size = payload.size();
+    const uint64_t hash = checksum(payload.data(), payload.size());
+    out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.append(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    out.append(payload);
+}
+
+/** Returns the payloads of the intact records at the beginning of \p contents and the offset following the last of
+ * them. */
+std::pair<std::vector<std::string_view>, std::size_t> unframe(std::string_view contents)
+{
+    std::vector<std::string_view> payloads;
+    std::size_t offset = 0;
+    while (contents.size() - offset >= FRAME_SIZE) {
+        uint32_t size;
+        uint64_t hash;
+        std::memcpy(&size, contents.data() + offset, sizeof(size));
+        std::memcpy(&hash, contents.data() + offset + sizeof(size), sizeof(hash));
+        if (contents.size() - offset - FRAME_SIZE < size)
+            break; // incomplete record
+        auto payload = contents.substr(offset + FRAME_SIZE, size);
+        if (checksum(payload.data(), payload.size()) != hash)
+            break; // corrupt record
+        payloads.push_back(payload);
+        offset += FRAME_SIZE + size;
+    }
+    return { std::move(payloads), offset };
+}
+
+/** Returns the contents of the file at \p path, or an empty string if there is no such file. */
+std::string read_file(const std::filesystem::path &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (not in)
+        return std::string();
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/** Writes all of \p data to the file descriptor \p fd.  Returns `false` on failure. */
+bool write_all(int fd, std::string_view data)
+{
+    while (not data.empty()) {
+        const ssize_t n = ::write(fd, data.data(), data.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data.remove_prefix(n);
+    }
+    return true;
+}
+
+/** Syncs the contents of the file with the file descriptor \p fd to disk.  Returns `false` on failure. */
+bool sync(int fd)
+{
+#if __linux
+    return ::fdatasync(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+/** Throws an `m::runtime_error` describing the last failed system call on \p path. */
+[[noreturn]] void throw_io_error(const std::filesystem::path &path)
+{
+    throw runtime_error("I/O error on " + path.string() + ": " + std::strerror(errno));
+}
+
+/*----- Checkpoint ---------------------------------------------------------------------------------------------------*/
+
+/** Returns the statement creating \p table with its constraints. */
+std::string create_table_statement(const Table &table)
+{
+    auto primary_key = table.primary_key();
+    std::ostringstream oss;
+    oss << "CREATE TABLE " << table.name() << "\n(";
+    for (auto it = table.begin(), end = table.end(); it != end; ++it) {
+        auto &attr = *it;
+        if (it != table.begin()) oss << ',';
+        oss << "\n    " << attr.name << ' ' << *attr.type;
+        const bool is_primary_key = std::any_of(primary_key.cbegin(), primary_key.cend(),
+                                                [&attr](auto &ref) { return &ref.get() == &attr; });
+        if (is_primary_key)
+            oss << " PRIMARY KEY"; // implies NOT NULL
+        else if (attr.not_nullable)
+            oss << " NOT NULL";
+        if (attr.unique)
+            oss << " UNIQUE";
+        if (attr.reference)
+            oss << " REFERENCES " << attr.reference->table.name() << '(' << attr.reference->name << ')';
+    }
+    oss << "\n);";
+    return oss.str();
+}
+
+/** Writes the records of a checkpoint to a file, buffering them. */
+struct CheckpointWriter
+{
+    private:
+    int fd_;
+    const std::filesystem::path &path_;
+    std::string buffer_;
+
+    public:
+    CheckpointWriter(int fd, const std::filesystem::path &path) : fd_(fd), path_(path) { }
+
+    void write(const PayloadWriter &record) {
+        frame(buffer_, record.payload);
+        if (buffer_.size() >= MAX_ROWS_PAYLOAD_SIZE)
+            flush();
+    }
+
+    void flush() {
+        if (not write_all(fd_, buffer_))
+            throw_io_error(path_);
+        buffer_.clear();
+    }
+};
+
+/** Returns the index of the attribute \p name in \p S, or `S.num_entries()` if \p S has no such attribute. */
+std::size_t index_of(const Schema &S, const ThreadSafePooledString &name)
+{
+    for (std::size_t i = 0; i != S.num_entries(); ++i) {
+        if (S[i].id.name == name)
+            return i;
+    }
+    return S.num_entries();
+}
+
+/** Appends the values of the attributes of \p tup that are not hidden to \p record. */
+void put_row(PayloadWriter &record, const Schema &S, const Tuple &tup)
+{
+    for (std::size_t i = 0; i != S.num_entries(); ++i) {
+        if (S[i].constraints & Schema::entry_type::IS_HIDDEN)
+            continue;
+        const bool is_null = tup.is_null(i);
+        record.put(uint8_t(is_null));
+        if (is_null)
+            continue;
+        auto &val = tup[i];
+        if (S[i].type->is_boolean()) {
+            record.put(uint8_t(val.as_b()));
+        } else if (auto cs = cast<const CharacterSequence>(S[i].type)) {
+            auto str = reinterpret_cast<const char*>(val.as_p());
+            record.put(std::string_view(str, strnlen(str, cs->length)));
+        } else if (S[i].type->is_float()) {
+            record.put(val.as_f());
+        } else if (S[i].type->is_double()) {
+            record.put(val.as_d());
+        } else {
+            record.put(val.as_i()); // integers, decimals, dates, and datetimes
+        }
+    }
+}
+
+/** Reads the values of the attributes of \p tup that are not hidden from \p reader, see `put_row()`. */
+void get_row(PayloadReader &reader, const Schema &S, Tuple &tup)
+{
+    for (std::size_t i = 0; i != S.num_entries(); ++i) {
+        if (S[i].constraints & Schema::entry_type::IS_HIDDEN)
+            continue;
+        if (reader.get<uint8_t>()) {
+            tup.null(i);
+            continue;
+        }
+        if (S[i].type->is_boolean()) {
+            tup.set(i, bool(reader.get<uint8_t>()));
+        } else if (auto cs = cast<const CharacterSequence>(S[i].type)) {
+            auto str = reader.get_string();
+            if (str.size() > cs->length)
+                throw runtime_error("malformed record");
+            auto dst = reinterpret_cast<char*>(tup[i].as_p());
+            std::memcpy(dst, str.data(), str.size());
+            dst[str.size()] = '\0';
+            tup.not_null(i);
+        } else if (S[i].type->is_float()) {
+            tup.set(i, reader.get<float>());
+        } else if (S[i].type->is_double()) {
+            tup.set(i, reader.get<double>());
+        } else {
+            tup.set(i, reader.get<int64_t>());
+        }
+    }
+}
+
+/** Writes the rows of \p table in database \p DB that are not ended to \p writer. */
+void write_rows(CheckpointWriter &writer, const Database &DB, const Table &table)
+{
+    Catalog &C = Catalog::Get();
+    if (table.store().num_rows() == 0)
+        return;
+
+    const Schema S = table.schema();
+    const std::size_t idx_ts_end = index_of(S, C.pool("$ts_end"));
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+
+    auto start_record = [&]() {
+        PayloadWriter record;
+        record.put(char(CR_Rows));
+        record.put(std::string_view(*DB.name));
+        record.put(std::string_view(*table.name()));
+        return record;
+    };
+    PayloadWriter record = start_record();
+    const std::size_t header_size = record.payload.size();
+    for (std::size_t row_id = 0; row_id != table.store().num_rows(); ++row_id) {
+        loader(args);
+        if (idx_ts_end != S.num_entries() and tup[idx_ts_end].as_i() != -1)
+            continue; // the row was deleted or its insert was aborted
+        put_row(record, S, tup);
+
+        if (record.payload.size() >= MAX_ROWS_PAYLOAD_SIZE) {
+            writer.write(record);
+            record = start_record();
+        }
+    }
+    if (record.payload.size() != header_size)
+        writer.write(record);
+}
+
+/** Writes the records creating \p table, its rows, and the tables it references to \p writer, unless \p table is
+ * contained in \p written. */
+void write_table(CheckpointWriter &writer, const Database &DB, const Table &table,
+                 std::unordered_set<const Table*> &written)
+{
+    if (not written.insert(&table).second)
+        return;
+    /* Referenced tables must be created first. */
+    for (auto &attr : table) {
+        if (attr.reference and &attr.reference->table != &table)
+            write_table(writer, DB, attr.reference->table, written);
+    }
+
+    PayloadWriter record;
+    record.put(char(CR_Statement));
+    record.put(std::string_view(*DB.name));
+    record.put(create_table_statement(table));
+    writer.write(record);
+    write_rows(writer, DB, table);
+}
+
+/** Returns the table \p table_name of the database \p db_name.  Throws `m::runtime_error` if there is no such table. */
+Table & get_table(const ThreadSafePooledString &db_name, const ThreadSafePooledString &table_name)
+{
+    Catalog &C = Catalog::Get();
+    if (not C.has_database(db_name) or not C.get_database(db_name).has_table(table_name))
+        throw runtime_error("cannot replay rows of unknown table " + std::string(*table_name));
+    return C.get_database(db_name).get_table(table_name);
+}
+
+/** Reads the rows of the record \p reader into the table \p table_name of the database \p db_name.  Throws
+ * `m::runtime_error` if there is no such table. */
+void load_rows(PayloadReader &reader, const ThreadSafePooledString &db_name,
+               const ThreadSafePooledString &table_name)
+{
+    Catalog &C = Catalog::Get();
+    auto &table = get_table(db_name, table_name);
+    StoreWriter W(table.store());
+    const Schema &S = W.schema();
+    const std::size_t idx_ts_begin = index_of(S, C.pool("$ts_begin"));
+    const std::size_t idx_ts_end = index_of(S, C.pool("$ts_end"));
+    Tuple tup(S);
+    /* Restored rows are visible to every transaction. */
+    if (idx_ts_begin != S.num_entries())
+        tup.set(idx_ts_begin, int64_t(0));
+    if (idx_ts_end != S.num_entries())
+        tup.set(idx_ts_end, int64_t(-1));
+
+    while (not reader.empty()) {
+        get_row(reader, S, tup);
+        W.append(tup);
+    }
+    C.get_database(db_name).invalidate_indexes(table_name); // indexes created before the rows were appended
+}
+
+/** Ends the lifetime of one visible row of the table \p table_name of the database \p db_name per row of the record
+ * \p reader that equals it.  Throws `m::runtime_error` if there is no such table or if a row has no equal. */
+void delete_rows(PayloadReader &reader, const ThreadSafePooledString &db_name,
+                 const ThreadSafePooledString &table_name)
+{
+    Catalog &C = Catalog::Get();
+    auto &table = get_table(db_name, table_name);
+    const Schema S = table.schema();
+    auto ts_end = C.pool("$ts_end");
+    const std::size_t idx_ts_end = index_of(S, ts_end);
+    if (idx_ts_end == S.num_entries())
+        throw runtime_error("cannot replay delete from table " + std::string(*table_name) +
+                            " because it is not multi-versioned");
+
+    /*----- Count the deleted rows by their serialization, which is equal for equal rows. -----*/
+    std::unordered_map<std::string, std::size_t> deleted;
+    std::size_t num_deleted = 0;
+    {
+        Tuple tup(S);
+        while (not reader.empty()) {
+            get_row(reader, S, tup);
+            PayloadWriter row;
+            put_row(row, S, tup);
+            ++deleted[std::move(row.payload)];
+            ++num_deleted;
+        }
+    }
+
+    /*----- End the lifetime of equal visible rows.  Recovered rows are visible to every transaction. -----*/
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t row_id = 0; num_deleted and row_id != table.store().num_rows(); ++row_id) {
+        loader(args);
+        if (tup[idx_ts_end].as_i() != -1)
+            continue; // the row is deleted already
+        PayloadWriter row;
+        put_row(row, S, tup);
+        auto it = deleted.find(row.payload);
+        if (it == deleted.end() or it->second == 0)
+            continue;
+        --it->second;
+        --num_deleted;
+        write_timestamps(table, ts_end, row_id, row_id + 1, 0);
+    }
+    if (num_deleted)
+        throw runtime_error("cannot replay delete from table " + std::string(*table_name) + " because " +
+                            std::to_string(num_deleted) + " of its deleted rows do not exist");
+}
+
+/*----- Recovery -----------------------------------------------------------------------------------------------------*/
+
+/** Executes the statement \p sql with the database \p db_name in use.  Throws `m::runtime_error` if the statement
+ * fails; its errors are reported to \p diag. */
+void replay_statement(Diagnostic &diag, std::string_view db_name, std::string_view sql)
+{
+    Catalog &C = Catalog::Get();
+    if (not db_name.empty()) {
+        auto name = C.pool(db_name);
+        if (not C.has_database(name))
+            throw runtime_error("cannot replay statement of unknown database " + std::string(db_name));
+        C.set_database_in_use(C.get_database(name));
+    }
+
+    const auto num_errors = diag.num_errors();
+    std::istringstream in{std::string(sql)};
+    ast::Lexer lexer(diag, C.get_pool(), "write-ahead log", in);
+    ast::Parser parser(lexer);
+    auto ast = parser.parse();
+    if (diag.num_errors() != num_errors)
+        throw runtime_error("cannot parse statement " + std::string(sql));
+    /* The scheduler clears the errors of `diag` before it analyzes the statement.  Hence, all remaining errors are
+     * errors of the statement, including those of its execution, which does not fail the command. */
+    if (not C.scheduler().autocommit(std::move(ast), diag) or diag.num_errors())
+        throw runtime_error("cannot replay statement " + std::string(sql));
+}
+
+/** Replays the effect of the kind \p kind that \p reader contains. */
+void replay_effect(Diagnostic &diag, Scheduler::Transaction::LoggedEffect::kind_t kind, PayloadReader &reader)
+{
+    Catalog &C = Catalog::Get();
+    auto db_name = reader.get_string();
+    switch (kind) {
+        case Scheduler::Transaction::LoggedEffect::E_Statement:
+            replay_statement(diag, db_name, reader.get_string());
+            break;
+
+        case Scheduler::Transaction::LoggedEffect::E_Insert:
+        case Scheduler::Transaction::LoggedEffect::E_Delete: {
+            auto table_name = C.pool(reader.get_string());
+            PayloadReader rows{reader.get_string()};
+            if (kind == Scheduler::Transaction::LoggedEffect::E_Insert)
+                load_rows(rows, C.pool(db_name), table_name);
+            else
+                delete_rows(rows, C.pool(db_name), table_name);
+            break;
+        }
+    }
+}
+}
+
+
+WriteAheadLog::WriteAheadLog(std::filesystem::path path, std::size_t checkpoint_size,
+                             std::chrono::microseconds group_commit_delay)
+    : path_(std::move(path))
+    , checkpoint_path_(path_.string() + ".checkpoint")
+    , checkpoint_size_(checkpoint_size)
+    , group_commit_delay_(group_commit_delay)
+{
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ == -1)
+        throw_io_error(path_);
+    flush_thread_ = std::thread(&WriteAheadLog::work, this);
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_closed_ = true;
+    }
+    has_pending_.notify_one();
+    flush_thread_.join();
+    ::close(fd_);
+}
+
+uint64_t WriteAheadLog::append(const Scheduler::Transaction &t)
+{
+    if (t.logged_effects().empty())
+        return 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t lsn = next_lsn_++;
+    PayloadWriter record;
+    record.put(lsn);
+    record.put(uint32_t(t.logged_effects().size()));
+    for (auto &effect : t.logged_effects()) {
+        record.put(uint8_t(effect.kind));
+        record.put(effect.database);
+        if (effect.kind != Scheduler::Transaction::LoggedEffect::E_Statement)
+            record.put(effect.table);
+        record.put(effect.data);
+    }
+    frame(pending_, record.payload);
+    has_pending_.notify_one();
+    return lsn;
+}
+
+void WriteAheadLog::flush(uint64_t lsn)
+{
+    if (lsn == 0)
+        return;
+    std::unique_lock<std::mutex> lock(mutex_);
+    is_flushed_.wait(lock, [this, lsn]() { return has_failed_ or flushed_lsn_ >= lsn; });
+    if (flushed_lsn_ < lsn)
+        throw runtime_error("failed to write the write-ahead log " + path_.string());
+}
+
+void WriteAheadLog::work()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        has_pending_.wait(lock, [this]() { return is_closed_ or not pending_.empty(); });
+        if (pending_.empty())
+            return; // the log is closed and all records are written
+
+        if (group_commit_delay_.count() and not is_closed_) {
+            /* Give more transactions the chance to commit and share the sync. */
+            lock.unlock();
+            std::this_thread::sleep_for(group_commit_delay_);
+            lock.lock();
+        }
+
+        std::string records;
+        records.swap(pending_);
+        const uint64_t lsn = next_lsn_ - 1;
+        lock.unlock();
+        const bool is_written = not has_failed_ and write_all(fd_, records) and sync(fd_);
+        lock.lock();
+
+        if (is_written) {
+            flushed_lsn_ = lsn;
+            size_ += records.size();
+        } else {
+            has_failed_ = true;
+        }
+        is_flushed_.notify_all();
+    }
+}
+
+void WriteAheadLog::checkpoint()
+{
+    Catalog &C = Catalog::Get();
+
+    /* The log must not contain records that are written after it is truncated. */
+    uint64_t lsn;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lsn = next_lsn_ - 1;
+    }
+    flush(lsn);
+
+    /*----- Write the new checkpoint to a temporary file. -----*/
+    const std::filesystem::path tmp_path = checkpoint_path_.string() + ".tmp";
+    const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1)
+        throw_io_error(tmp_path);
+    try {
+        CheckpointWriter writer(fd, tmp_path);
+        PayloadWriter header;
+        header.put(char(CR_Header));
+        header.put(lsn);
+        writer.write(header);
+
+        for (auto it = C.databases_begin(); it != C.databases_end(); ++it) {
+            const Database &DB = *it->second;
+            PayloadWriter create_db;
+            create_db.put(char(CR_Statement));
+            create_db.put(std::string_view());
+            create_db.put("CREATE DATABASE " + std::string(*DB.name) + ";");
+            writer.write(create_db);
+
+            std::unordered_set<const Table*> written;
+            for (auto table = DB.begin_tables(); table != DB.end_tables(); ++table)
+                write_table(writer, DB, *table->second, written);
+
+            for (auto idx = DB.begin_indexes(); idx != DB.end_indexes(); ++idx) {
+                if (idx->state == Database::index_entry_type::S_Invalid)
+                    continue; // the index is outdated and would be rebuilt differently
+                std::ostringstream oss;
+                oss << "CREATE INDEX " << idx->name << " ON " << idx->table.name() << " USING ";
+                switch (idx->index->method()) {
+                    case idx::IndexMethod::Rmi: oss << "rmi ("; break;
+                    case idx::IndexMethod::Pgm: oss << "pgm ("; break;
+                    default:                    oss << "array ("; break; // composite keys are stored by arrays
+                }
+                for (auto it = idx->attributes.cbegin(); it != idx->attributes.cend(); ++it) {
+                    if (it != idx->attributes.cbegin()) oss << ", ";
+                    oss << it->get().name;
+                }
+                oss << ");";
+                PayloadWriter create_index;
+                create_index.put(char(CR_Statement));
+                create_index.put(std::string_view(*DB.name));
+                create_index.put(oss.str());
+                writer.write(create_index);
+            }
+        }
+        writer.flush();
+        if (not sync(fd))
+            throw_io_error(tmp_path);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+
+    /*----- Atomically replace the old checkpoint and persist the rename. -----*/
+    if (std::rename(tmp_path.c_str(), checkpoint_path_.c_str()) != 0)
+        throw_io_error(checkpoint_path_);
+    auto dir = checkpoint_path_.parent_path();
+    if (dir.empty()) dir = ".";
+    if (const int dir_fd = ::open(dir.c_str(), O_RDONLY | O_CLOEXEC); dir_fd != -1) {
+        ::fsync(dir_fd);
+        ::close(dir_fd);
+    }
+
+    /*----- Truncate the log.  Its records are contained in the checkpoint. -----*/
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (::ftruncate(fd_, 0) != 0 or not sync(fd_))
+        throw_io_error(path_);
+    size_ = 0;
+}
+
+std::string WriteAheadLog::Serialize_Rows(const Table &table,
+                                          const std::vector<std::pair<std::size_t, std::size_t>> &rows)
+{
+    PayloadWriter record;
+    if (rows.empty())
+        return record.payload;
+
+    /* Load the rows from the first logged row on, skipping the rows between the ranges. */
+    const Schema S = table.schema();
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, rows.front().first);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    std::size_t row_id = rows.front().first;
+    for (auto [begin, end] : rows) {
+        M_insist(row_id <= begin, "ranges must be ascending");
+        for (; row_id != end; ++row_id) {
+            loader(args);
+            if (row_id >= begin)
+                put_row(record, S, tup);
+        }
+    }
+    return std::move(record.payload);
+}
+
+void WriteAheadLog::recover(Diagnostic &diag)
+{
+    /* A failed recovery leaves the databases incomplete.  Hence, the caller must not continue with them, but the log
+     * must not stay in recovery either. */
+    is_recovering_ = true;
+    try {
+        replay(diag);
+    } catch (...) {
+        is_recovering_ = false;
+        throw;
+    }
+    is_recovering_ = false;
+}
+
+void WriteAheadLog::replay(Diagnostic &diag)
+{
+    Catalog &C = Catalog::Get();
+    uint64_t last_lsn = 0;
+
+    /*----- Restore the checkpoint. -----*/
+    const std::string checkpoint = read_file(checkpoint_path_);
+    if (not checkpoint.empty()) {
+        auto [payloads, offset] = unframe(checkpoint);
+        if (offset != checkpoint.size() or payloads.empty())
+            throw runtime_error("corrupt checkpoint " + checkpoint_path_.string());
+
+        PayloadReader header{payloads.front()};
+        if (header.get<char>() != CR_Header)
+            throw runtime_error("corrupt checkpoint " + checkpoint_path_.string());
+        last_lsn = header.get<uint64_t>();
+
+        for (auto it = std::next(payloads.begin()); it != payloads.end(); ++it) {
+            PayloadReader reader{*it};
+            const char kind = reader.get<char>();
+            auto db_name = reader.get_string();
+            if (kind == CR_Statement) {
+                replay_statement(diag, db_name, reader.get_string());
+            } else if (kind == CR_Rows) {
+                auto table_name = reader.get_string();
+                load_rows(reader, C.pool(db_name), C.pool(table_name));
+            } else {
+                throw runtime_error("corrupt checkpoint " + checkpoint_path_.string());
+            }
+        }
+    }
+
+    /*----- Replay the transactions of the log that are not contained in the checkpoint. -----*/
+    const std::string log = read_file(path_);
+    auto [payloads, offset] = unframe(log);
+    for (auto payload : payloads) {
+        PayloadReader reader{payload};
+        const uint64_t lsn = reader.get<uint64_t>();
+        if (lsn <= last_lsn)
+            continue; // the checkpoint was written but the log was not truncated before a crash
+        const uint32_t num_effects = reader.get<uint32_t>();
+        for (uint32_t i = 0; i != num_effects; ++i) {
+            const uint8_t kind = reader.get<uint8_t>();
+            if (kind > Scheduler::Transaction::LoggedEffect::E_Delete)
+                throw runtime_error("malformed record");
+            replay_effect(diag, Scheduler::Transaction::LoggedEffect::kind_t(kind), reader);
+        }
+        last_lsn = lsn;
+    }
+
+    /* A torn record at the end of the log was never acknowledged as committed.  Discard it. */
+    if (offset != log.size() and (::ftruncate(fd_, offset) != 0 or not sync(fd_)))
+        throw_io_error(path_);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        next_lsn_ = last_lsn + 1;
+        flushed_lsn_ = last_lsn;
+        size_ = offset;
+    }
+    C.unset_database_in_use();
+}
@@ -2,6 +2,7 @@
 
 #include "backend/Interpreter.hpp"
 #include "backend/StackMachine.hpp"
+#include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <exception>
@@ -10,6 +11,7 @@
 #include <map>
 #include <memory>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
 #include <mutable/storage/DataLayout.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/macro.hpp>
@@ -41,6 +43,9 @@ void DSVReader::operator()(std::istream &in, const char *name)
     /* Declare reference to the `StackMachine` for the current `Linearization`. */
     std::unique_ptr<StackMachine> W;
     const DataLayout *layout = nullptr;
+    const void *addr = nullptr;
+    std::vector<const DataLayout::Leaf*> encoded_leaves; // frame-of-reference encoded leaves of `layout`
+    bool has_null_bitmap = true; // whether `layout` contains a NULL bitmap
 
     /* Allocate intermediate tuple. */
     tup = Tuple(S);
@@ -96,6 +101,7 @@ void DSVReader::operator()(std::istream &in, const char *name)
     });
 
     /*----- Read data. -----------------------------------------------------------------------------------------------*/
+    const std::size_t first_row = store.num_rows();
     std::size_t idx = 0;
     while (in.good() and idx < config().num_rows) {
         ++idx;
@@ -125,29 +131,77 @@ void DSVReader::operator()(std::istream &in, const char *name)
         if (c != EOF and c != '\n') {
             diag.e(pos) << "Expected end of row.\n";
             discard_row();
+            --idx;
+            store.drop(); // drop the unfinished row
         } else {
+            if (layout != &table.layout() or addr != store.memory().addr()) {
+                /* The data layout was updated or the store was moved while growing, recompile stack machine. */
+                layout = &table.layout();
+                addr = store.memory().addr();
+                W = std::make_unique<StackMachine>(Interpreter::compile_store(S, store.memory().addr(), *layout,
+                                                                              S, store.num_rows() - 1));
+                encoded_leaves = frame_of_reference_leaves(*layout);
+                has_null_bitmap = m::storage::has_null_bitmap(*layout, S.num_entries());
+            }
+            /*----- check that NULL values can be stored. -----*/
+            if (not has_null_bitmap) {
+                for (std::size_t i = 0; i != S.num_entries(); ++i) {
+                    if (not table[i].not_nullable and tup.is_null(i)) {
+                        diag.e(pos) << "Value of attribute " << table[i].name
+                                    << " is NULL but its data layout has no NULL bitmap.\n";
+                        --idx;
+                        store.drop(); // drop the row
+                        goto end_of_row;
+                    }
+                }
+            }
+            /*----- check that values fit into frame-of-reference encoded attributes. -----*/
+            for (auto leaf : encoded_leaves) {
+                if (not tup.is_null(leaf->index()) and not leaf->can_encode(tup[leaf->index()].as_i())) {
+                    /* Re-encode the table with a range that covers the value.  The table is not `const`, the reader
+                     * merely does not modify its schema. */
+                    store.drop(); // drop the row, which is not written yet
+                    widen_frame_of_reference(const_cast<Table&>(table), tup);
+                    store.append();
+                    layout = nullptr; // the data layout was updated in place, recompile stack machine below
+                    break;
+                }
+            }
             if (layout != &table.layout()) {
-                /* The data layout was updated, recompile stack machine. */
                 layout = &table.layout();
                 W = std::make_unique<StackMachine>(Interpreter::compile_store(S, store.memory().addr(), *layout,
                                                                               S, store.num_rows() - 1));
+                encoded_leaves = frame_of_reference_leaves(*layout);
             }
             /*----- set timestamps if available. -----*/
             if (this->transaction and ts_begin != table.end_hidden()) {
-                tup.set(ts_begin->id, Value(transaction->start_time()));
-                /* Set $ts_end to -1. It is a special value representing infinity. */
+                tup.set(ts_begin->id, Value(transaction->write_time()));
+                /* Set $ts_end to -1. It is a special value representing infinity.  If timestamps are deferred, the row
+                 * is ended until all rows are read, see below. */
                 M_insist(ts_end != table.end_hidden());
-                tup.set(ts_end->id, Value(-1));
+                tup.set(ts_end->id, Value(transaction->defers_timestamps() ? 0 : -1));
             }
 
             Tuple *args[] = { &tup };
             (*W)(args); // write tuple to store
+            store.zone_map().update(store.num_rows() - 1, tup);
         }
 end_of_row:
         M_insist(c == EOF or c == '\n');
         step();
     }
 
+    /*----- Publish the read rows and record them in the transaction. -----*/
+    if (this->transaction and ts_begin != table.end_hidden()) {
+        if (transaction->defers_timestamps()) {
+            /* Concurrent readers may observe rows while they are written.  Hence, rows are ended until written
+             * completely. */
+            std::atomic_thread_fence(std::memory_order_release);
+            write_timestamps(table, ts_end->name, first_row, store.num_rows(), -1);
+        }
+        transaction->record_insert(table, first_row, store.num_rows());
+    }
+
     this->in = nullptr;
 }
 
@@ -7,12 +7,15 @@
 #include "lex/Lexer.hpp"
 #include "parse/Parser.hpp"
 #include "parse/Sema.hpp"
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <mutable/catalog/DatabaseCommand.hpp>
 #include <mutable/io/Reader.hpp>
 #include <mutable/IR/Tuple.hpp>
 #include <mutable/Options.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/util/Diagnostic.hpp>
 
 
@@ -260,6 +263,11 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
         T.store(C.create_store(T));
     } else if (auto S = cast<const ast::DropTableStmt>(&stmt)) {
         M_unreachable("not implemented");
+    } else if (auto S = cast<const ast::AlterTableStmt>(&stmt)) {
+        auto &DB = C.get_database_in_use();
+        auto &T = DB.get_table(S->table_name.text.assert_not_none());
+        auto &factory = C.data_layout(S->layout_name.text.assert_not_none());
+        M_TIME_EXPR(change_layout(T, factory), "Change the data layout", timer);
     } else if (auto S = cast<const ast::DSVImportStmt>(&stmt)) {
         auto &DB = C.get_database_in_use();
         auto &T = DB.get_table(S->table_name.text.assert_not_none());
@@ -286,6 +294,8 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
                 diag.err() << std::endl;
             } else {
                 M_TIME_EXPR(R(file, *S->path.text), "Read DSV file", timer);
+                if (Options::Get().compress_imports)
+                    M_TIME_EXPR(compress(T), "Compress table", timer);
             }
         } catch (m::invalid_argument e) {
             diag.err() << "Error reading DSV file: " << e.what() << "\n";
@@ -382,6 +392,269 @@ void m::execute_query(Diagnostic &diag, const SelectStmt &stmt, std::unique_ptr<
     execute_physical_plan(diag, *physical_plan, backend);
 }
 
+void m::cancel(Scheduler::Transaction &t) { t.cancel(); }
+
+void m::set_timeout(Scheduler::Transaction &t, std::chrono::milliseconds timeout) { t.timeout(timeout); }
+
+namespace {
+
+/** Returns a clone of the factory that made the data layout of \p table, stripped of its frame-of-reference encoding.
+ * If the data layout was not made by a factory, returns a clone of the default data layout factory. */
+std::unique_ptr<storage::DataLayoutFactory> unencoded_layout_factory(const Table &table)
+{
+    auto factory = table.layout_factory();
+    if (not factory)
+        return Catalog::Get().data_layout().clone();
+    if (auto FOR = cast<const storage::FrameOfReferenceLayoutFactory>(factory))
+        return FOR->factory().clone();
+    return factory->clone();
+}
+
+/** Encodes the distinct values of each dictionary-encoded attribute in \p tuples into the `Dictionary` of the
+ * attribute in \p layout, in ascending order.  Storing \p tuples in \p layout afterwards does not add values to the
+ * dictionaries, hence the codes of fresh dictionaries stay order-preserving. */
+void encode_dictionaries_in_order(const storage::DataLayout &layout, const std::vector<Tuple> &tuples)
+{
+    layout.for_sibling_leaves([&](const std::vector<storage::DataLayout::leaf_info_t> &leaves,
+                                  const storage::DataLayout::level_info_stack_t&, uint64_t)
+    {
+        for (auto &leaf_info : leaves) {
+            if (not leaf_info.leaf.is_dictionary_encoded())
+                continue;
+            auto &dict = leaf_info.leaf.dictionary();
+            const auto idx = leaf_info.leaf.index();
+            std::vector<std::string> values;
+            for (auto &tup : tuples) {
+                if (tup.is_null(idx))
+                    continue;
+                auto str = reinterpret_cast<const char*>(tup[idx].as_p());
+                values.emplace_back(str, strnlen(str, dict.type().length));
+            }
+            std::sort(values.begin(), values.end()); // byte-wise, like `strcmp()`
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+            for (auto &value : values)
+                dict.encode(value.c_str());
+        }
+    });
+}
+
+}
+
+void m::compress(Table &table)
+{
+    auto &store = table.store();
+    const Schema S = table.schema();
+    const std::size_t num_rows = store.num_rows();
+
+    /*----- Determine the range of values of each integral attribute. -----*/
+    std::vector<std::optional<storage::FrameOfReferenceLayoutFactory::range_type>> ranges(S.num_entries());
+    if (num_rows) {
+        auto loader = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S);
+        Tuple tup(S);
+        for (std::size_t i = 0; i != num_rows; ++i) {
+            Tuple *args[] = { &tup };
+            loader(args);
+
+            for (std::size_t idx = 0; idx != S.num_entries(); ++idx) {
+                auto n = cast<const Numeric>(S[idx].type);
+                if (not n or n->kind == Numeric::N_Float or tup.is_null(idx))
+                    continue;
+                if (S[idx].constraints & Schema::entry_type::IS_HIDDEN)
+                    continue; // hidden attributes, e.g. timestamps, are written without widening their encoding
+                const int64_t value = tup[idx].as_i();
+                if (auto &range = ranges[idx])
+                    *range = { std::min(range->first, value), std::max(range->second, value) };
+                else
+                    range.emplace(value, value);
+            }
+        }
+    }
+
+    /*----- Lay out the table anew, decorating its current data layout factory.  Nullable attributes keep their NULL
+     * bits, even if they currently contain no `NULL` values, such that `NULL` values can be inserted later. -----*/
+    change_layout(table, storage::FrameOfReferenceLayoutFactory(unencoded_layout_factory(table), std::move(ranges)));
+}
+
+void m::change_layout(Table &table, const storage::DataLayoutFactory &factory)
+{
+    auto &store = table.store();
+    const Schema S = table.schema();
+    const std::size_t num_rows = store.num_rows();
+
+    /*----- Load all rows from the current data layout. -----*/
+    std::vector<Tuple> tuples;
+    tuples.reserve(num_rows);
+    if (num_rows) {
+        auto loader = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S);
+        for (std::size_t i = 0; i != num_rows; ++i) {
+            auto &tup = tuples.emplace_back(S);
+            Tuple *args[] = { &tup };
+            loader(args);
+        }
+    }
+
+    /*----- Lay out the table anew and write all rows back, with order-preserving dictionary codes. -----*/
+    table.layout(factory);
+    encode_dictionaries_in_order(table.layout(), tuples);
+    if (num_rows) {
+        auto writer = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S);
+        for (auto &tup : tuples) {
+            Tuple *args[] = { &tup };
+            writer(args);
+        }
+    }
+}
+
+void m::widen_frame_of_reference(Table &table, const Tuple &tup)
+{
+    using range_type = storage::FrameOfReferenceLayoutFactory::range_type;
+    const std::size_t num_entries = table.schema().num_entries();
+
+    /*----- Compute the range each frame-of-reference encoded attribute can represent, extended by its value in `tup`
+     * if necessary.  Extending the representable range at least doubles it, hence an attribute is widened at most
+     * once per bit of width. -----*/
+    std::vector<std::optional<range_type>> ranges(num_entries);
+    bool widen = false;
+    for (auto leaf : storage::frame_of_reference_leaves(table.layout())) {
+        range_type range = leaf->encodable_range();
+        if (not tup.is_null(leaf->index()) and not leaf->can_encode(tup[leaf->index()].as_i())) {
+            const int64_t value = tup[leaf->index()].as_i();
+            range = { std::min(range.first, value), std::max(range.second, value) };
+            widen = true;
+        }
+        ranges[leaf->index()] = range;
+    }
+    if (not widen) return;
+
+    /*----- Lay out the table anew, bit-packing iff the current encoding does.  Readers must not observe the rows while
+     * they are rewritten. -----*/
+    auto FOR = cast<const storage::FrameOfReferenceLayoutFactory>(table.layout_factory());
+    const bool bit_packing = not FOR or FOR->bit_packing();
+    Store::exclusive_memory_latch latch;
+    change_layout(table, storage::FrameOfReferenceLayoutFactory(unencoded_layout_factory(table), std::move(ranges),
+                                                                bit_packing));
+}
+
+namespace {
+
+/** Returns a `Schema` with the single hidden timestamp attribute \p attr of \p table. */
+Schema timestamp_schema(const Table &table, const ThreadSafePooledString &attr)
+{
+    Schema S;
+    S.add({ table.name(), attr }, Type::Get_Integer(Type::TY_Vector, 8), Schema::entry_type::NOT_NULLABLE);
+    return S;
+}
+
+}
+
+void m::write_timestamps(const Table &table, const ThreadSafePooledString &attr, std::size_t begin, std::size_t end,
+                         int64_t timestamp)
+{
+    if (begin == end) return;
+    M_insist(begin < end and end <= table.store().num_rows(), "rows out of bounds");
+
+    const Schema S = timestamp_schema(table, attr);
+    auto writer = Interpreter::compile_store(S, table.store().memory().addr(), table.layout(), table.schema(), begin);
+    Tuple tup(S);
+    tup.set(0, timestamp);
+    Tuple *args[] = { &tup };
+    for (std::size_t i = begin; i != end; ++i)
+        writer(args); // the writer advances to the next row with each invocation
+    table.store().visibility_summary().invalidate(begin, end); // after writing, see `VisibilitySummary::version()`
+}
+
+int64_t m::read_timestamp(const Table &table, const ThreadSafePooledString &attr, std::size_t row_id)
+{
+    M_insist(row_id < table.store().num_rows(), "row out of bounds");
+
+    const Schema S = timestamp_schema(table, attr);
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), table.schema(), row_id);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    loader(args);
+    return tup.get(0).as_i();
+}
+
+storage::VisibilitySummary::entry_type m::summarize_visibility(const Table &table, std::size_t block)
+{
+    using storage::VisibilitySummary;
+    Catalog &C = Catalog::Get();
+    auto &store = table.store();
+    auto &summary = store.visibility_summary();
+    const std::size_t begin = block * VisibilitySummary::NUM_ROWS_PER_BLOCK;
+    M_insist(begin < store.num_rows(), "block out of bounds");
+    const std::size_t num_rows = std::min(VisibilitySummary::NUM_ROWS_PER_BLOCK, store.num_rows() - begin);
+
+    if (auto entry = summary.get(block, num_rows))
+        return *entry;
+
+    /*----- Summarize the timestamps of the rows of the block. -----*/
+    const uint64_t version = summary.version(block);
+    Schema S;
+    S.add({ table.name(), C.pool("$ts_begin") }, Type::Get_Integer(Type::TY_Vector, 8),
+          Schema::entry_type::NOT_NULLABLE);
+    S.add({ table.name(), C.pool("$ts_end") }, Type::Get_Integer(Type::TY_Vector, 8), Schema::entry_type::NOT_NULLABLE);
+    auto loader = Interpreter::compile_load(S, store.memory().addr(), table.layout(), table.schema(), begin);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    VisibilitySummary::entry_type entry;
+    for (std::size_t i = 0; i != num_rows; ++i) {
+        loader(args);
+        entry.update(tup.get(0).as_i(), tup.get(1).as_i());
+    }
+
+    summary.put(block, num_rows, version, entry);
+    return entry;
+}
+
+std::size_t m::collect_garbage(Table &table, int64_t horizon)
+{
+    Catalog &C = Catalog::Get();
+    auto &store = table.store();
+    const Schema S = table.schema();
+    const std::size_t num_rows = store.num_rows();
+    if (num_rows == 0)
+        return 0;
+    const std::size_t idx_ts_end = S[{ table.name(), C.pool("$ts_end") }].first;
+
+    /*----- Load all rows and retain the versions that are not ended or ended after `horizon`.  Versions that are ended
+     * by an active transaction carry its pending time, which exceeds every horizon. -----*/
+    std::vector<Tuple> tuples;
+    {
+        auto loader = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S);
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        for (std::size_t i = 0; i != num_rows; ++i) {
+            loader(args);
+            const int64_t ts_end = tup.get(idx_ts_end).as_i();
+            if (ts_end == -1 or ts_end > horizon)
+                tuples.push_back(tup.clone(S));
+        }
+    }
+    const std::size_t num_reclaimed = num_rows - tuples.size();
+    if (num_reclaimed == 0)
+        return 0;
+
+    /*----- Write the retained versions to the front of the store and drop the remaining rows. -----*/
+    if (not tuples.empty()) {
+        auto writer = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S);
+        for (auto &tup : tuples) {
+            Tuple *args[] = { &tup };
+            writer(args);
+        }
+    }
+    for (std::size_t i = 0; i != num_reclaimed; ++i)
+        store.drop();
+
+    /*----- Summarize the moved rows anew. -----*/
+    store.zone_map().clear();
+    for (std::size_t i = 0; i != tuples.size(); ++i)
+        store.zone_map().update(i, tuples[i]);
+    store.visibility_summary().clear();
+
+    return num_reclaimed;
+}
+
 void m::load_from_CSV(Diagnostic &diag, Table &table, const std::filesystem::path &path, std::size_t num_rows,
                       bool has_header, bool skip_header)
 {
@@ -448,12 +721,37 @@ m::StoreWriter::~StoreWriter() { }
 void m::StoreWriter::append(const Tuple &tup) const
 {
     store_.append();
-    if (layout_ != &store_.table().layout()) {
+    if (layout_ != &store_.table().layout() or addr_ != store_.memory().addr()) {
+        /* The data layout was updated or the store was moved while growing, recompile stack machine. */
         layout_ = &store_.table().layout();
+        addr_ = store_.memory().addr();
         writer_ = std::make_unique<m::StackMachine>(m::Interpreter::compile_store(S, store_.memory().addr(), *layout_,
                                                                                   S, store_.num_rows() - 1));
+        encoded_leaves_ = storage::frame_of_reference_leaves(*layout_);
+        has_null_bitmap_ = storage::has_null_bitmap(*layout_, S.num_entries());
+    }
+
+    if (not has_null_bitmap_) {
+        for (std::size_t idx = 0; idx != S.num_entries(); ++idx) {
+            if (S[idx].nullable() and tup.is_null(idx)) {
+                store_.drop(); // drop the appended row
+                throw invalid_argument("NULL value in attribute of data layout without NULL bitmap");
+            }
+        }
+    }
+
+    for (auto leaf : encoded_leaves_) {
+        if (not tup.is_null(leaf->index()) and not leaf->can_encode(tup[leaf->index()].as_i())) {
+            /* Re-encode the table with a range that covers the value and append again.  The store's table is not
+             * `const`, the store merely does not modify it. */
+            store_.drop(); // drop the appended row, which is not written yet
+            widen_frame_of_reference(const_cast<Table&>(store_.table()), tup);
+            layout_ = nullptr; // the data layout was updated in place, recompile stack machine
+            return append(tup);
+        }
     }
 
     Tuple *args[] = { const_cast<Tuple*>(&tup) };
     (*writer_)(args);
+    store_.zone_map().update(store_.num_rows() - 1, tup);
 }
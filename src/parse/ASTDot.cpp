@@ -356,6 +356,11 @@ void ASTDot::operator()(Const<DropTableStmt>&)
     // TODO implement
 }
 
+void ASTDot::operator()(Const<AlterTableStmt>&)
+{
+    // TODO implement
+}
+
 void ASTDot::operator()(Const<CreateIndexStmt>&)
 {
     // TODO implement
@@ -327,6 +327,14 @@ void ASTDumper::operator()(Const<DropTableStmt> &s)
     --indent_;
 }
 
+void ASTDumper::operator()(Const<AlterTableStmt> &s)
+{
+    indent() << "AlterTableStmt: table " << s.table_name.text << " (" << s.table_name.pos << ')';
+    ++indent_;
+    indent() << "layout: " << s.layout_name.text << " (" << s.layout_name.pos << ')';
+    --indent_;
+}
+
 void ASTDumper::operator()(Const<CreateIndexStmt> &s)
 {
     indent() << "CreateIndexStmt:";
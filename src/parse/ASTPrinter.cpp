@@ -235,6 +235,11 @@ void ASTPrinter::operator()(Const<DropTableStmt> &s)
     out << ';';
 }
 
+void ASTPrinter::operator()(Const<AlterTableStmt> &s)
+{
+    out << "ALTER TABLE " << s.table_name.text << " SET LAYOUT " << s.layout_name.text << ';';
+}
+
 void ASTPrinter::operator()(Const<CreateIndexStmt> &s)
 {
     out << "CREATE ";
@@ -174,6 +174,7 @@ std::unique_ptr<Stmt> Parser::parse_Stmt()
             }
             break;
 
+        case TK_Alter:  stmt = parse_AlterTableStmt(); break;
         case TK_Use:    stmt = parse_UseDatabaseStmt(); break;
         case TK_Select: stmt = parse_SelectStmt(); break;
         case TK_Insert: stmt = parse_InsertStmt(); break;
@@ -392,6 +393,36 @@ std::unique_ptr<Stmt> Parser::parse_DropTableStmt()
     return std::make_unique<DropTableStmt>(std::move(table_names), has_if_exists);
 }
 
+std::unique_ptr<Stmt> Parser::parse_AlterTableStmt()
+{
+    Token start = token();
+
+    /* 'ALTER' 'TABLE' */
+    if (not expect(TK_Alter)) {
+        consume();
+        return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+    }
+
+    if (not expect(TK_Table))
+        return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+
+    /* identifier */
+    Token table_name = token();
+    if (not expect(TK_IDENTIFIER))
+        return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+
+    /* 'SET' 'LAYOUT' identifier */
+    if (not expect(TK_Set))
+        return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+    if (not expect(TK_Layout))
+        return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+    Token layout_name = token();
+    if (not expect(TK_IDENTIFIER))
+        return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+
+    return std::make_unique<AlterTableStmt>(std::move(table_name), std::move(layout_name));
+}
+
 std::unique_ptr<Stmt> Parser::parse_CreateIndexStmt()
 {
     Token start = token();
@@ -546,10 +546,40 @@ void Sema::operator()(FnApplicationExpr &e)
         default:
             M_unreachable("Function not implemented");
 
-        case Function::FN_UDF:
-            diag.e(d->attr_name.pos) << "User-defined functions are not yet supported.\n";
-            d->type_ = e.type_ = Type::Get_Error();
-            return;
+        case Function::FN_UDF: {
+            auto &udf = as<const ScalarUDF>(*e.func_);
+            if (e.args.size() != udf.num_parameters()) {
+                diag.e(d->attr_name.pos) << "Function " << *d << " expects " << udf.num_parameters()
+                                         << " argument(s) but " << e.args.size() << " were given.\n";
+                d->type_ = e.type_ = Type::Get_Error();
+                return;
+            }
+
+            /* The result is vectorial iff any argument is vectorial. */
+            bool is_vectorial = false;
+            std::vector<const Type*> parameter_types;
+            for (std::size_t i = 0; i != e.args.size(); ++i) {
+                auto &arg = *e.args[i];
+                if (arg.type()->is_error()) {
+                    /* skip argument of error type */
+                    d->type_ = e.type_ = Type::Get_Error();
+                    return;
+                }
+                const PrimitiveType *arg_type = cast<const PrimitiveType>(arg.type());
+                if (not arg_type or not is_comparable(arg_type, udf.parameter_types[i])) {
+                    diag.e(d->attr_name.pos) << "Argument " << i + 1 << " of function " << *d << " must be of type "
+                                             << *udf.parameter_types[i] << ".\n";
+                    d->type_ = e.type_ = Type::Get_Error();
+                    return;
+                }
+                is_vectorial = is_vectorial or arg_type->is_vectorial();
+                parameter_types.push_back(udf.parameter_types[i]);
+            }
+
+            e.type_ = is_vectorial ? udf.return_type->as_vectorial() : udf.return_type->as_scalar();
+            d->type_ = Type::Get_Function(e.type_, std::move(parameter_types));
+            break;
+        }
 
         case Function::FN_MIN:
         case Function::FN_MAX:
@@ -1608,6 +1638,36 @@ void Sema::operator()(DropTableStmt &s)
         command_ = std::make_unique<DropTable>(std::move(table_names));
 }
 
+void Sema::operator()(AlterTableStmt &s)
+{
+    RequireContext RCtx(this, s);
+    Catalog &C = Catalog::Get();
+
+    if (not C.has_database_in_use()) {
+        diag.err() << "No database selected.\n";
+        return;
+    }
+    auto &DB = C.get_database_in_use();
+
+    /* Check that the table exists. */
+    auto table_name = s.table_name.text.assert_not_none();
+    if (not DB.has_table(table_name)) {
+        diag.e(s.table_name.pos) << "Table " << table_name << " does not exist in database " << DB.name << ".\n";
+        return;
+    }
+
+    /* Check that the data layout exists. */
+    auto layout_name = s.layout_name.text.assert_not_none();
+    try {
+        C.data_layout(layout_name);
+    } catch (std::invalid_argument) {
+        diag.e(s.layout_name.pos) << "Data layout " << layout_name << " does not exist.\n";
+        return;
+    }
+
+    command_ = std::make_unique<AlterTable>(std::move(table_name), std::move(layout_name));
+}
+
 void Sema::operator()(CreateIndexStmt &s)
 {
     RequireContext RCtx(this, s);
@@ -1667,6 +1727,8 @@ void Sema::operator()(CreateIndexStmt &s)
                 break;
             else if (s.method.text == C.pool("rmi")) // ok
                 break;
+            else if (s.method.text == C.pool("pgm")) // ok
+                break;
             else { // unknown method, not ok
                 diag.e(s.method.pos) << "Index method " << s.method.text << " not supported.\n";
                 return;
@@ -1677,28 +1739,39 @@ void Sema::operator()(CreateIndexStmt &s)
             return;
     }
 
-    /* Check that at most one key field is set. */
-    if (s.key_fields.size() > 1) {
-        diag.err() << "More than one key field for indexes not supported.\n";
-        return;
-    }
-
-    /* Compute attribute from key field. */
+    /* Compute attributes from key fields. */
+    std::vector<ThreadSafePooledString> attribute_names;
     for (auto it = s.key_fields.cbegin(), end = s.key_fields.cend(); it != end; ++it) {
         auto field = it->get();
         if (auto d = cast<Designator>(field)) {
-            if (not table.has_attribute(d->attr_name.text.assert_not_none())) {
+            auto attribute_name = d->attr_name.text.assert_not_none();
+            if (not table.has_attribute(attribute_name)) {
                 diag.e(d->tok.pos) << "Attribute " << d->attr_name.text << " does not exists in table "
                                    << table_name << ".\n";
                 return;
             }
+            if (contains(attribute_names, attribute_name)) {
+                diag.e(d->tok.pos) << "Attribute " << d->attr_name.text << " occurs more than once in the key.\n";
+                return;
+            }
+            attribute_names.push_back(std::move(attribute_name));
         } else {
             diag.e(field->tok.pos) << "Non-attribute key fields for indexes not supported.\n";
             return;
         }
     }
-    auto attribute_name = cast<Designator>(s.key_fields.front())->attr_name.text.assert_not_none();
-    auto &attribute = table.at(attribute_name);
+
+    /* Composite keys of more than one key field are stored in normalized encoding by a sorted array. */
+    if (attribute_names.size() > 1) {
+        if (s.method.type == TK_IDENTIFIER and (s.method.text == C.pool("rmi") or s.method.text == C.pool("pgm"))) {
+            diag.e(s.method.pos) << "Index method " << s.method.text << " not supported for composite keys.\n";
+            return;
+        }
+        command_ = std::make_unique<CreateIndex>(std::make_unique<idx::CompositeIndex>(), std::move(table_name),
+                                                 std::move(attribute_names), std::move(index_name));
+        return;
+    }
+    auto &attribute = table.at(attribute_names.front());
 
     /* Build index based on selected method and key type. */
     std::unique_ptr<idx::IndexBase> index;
@@ -1746,6 +1819,8 @@ void Sema::operator()(CreateIndexStmt &s)
                 set_index.operator()<idx::ArrayIndex>();
             else if (s.method.text == C.pool("rmi"))
                 set_index.operator()<idx::RecursiveModelIndex>();
+            else if (s.method.text == C.pool("pgm"))
+                set_index.operator()<idx::PiecewiseGeometricModelIndex>();
             break;
         default:
             M_unreachable("invalid token type");
@@ -1753,7 +1828,7 @@ void Sema::operator()(CreateIndexStmt &s)
     if (not index) // No index was set
         return;
 
-    command_ = std::make_unique<CreateIndex>(std::move(index), std::move(table_name), std::move(attribute_name),
+    command_ = std::make_unique<CreateIndex>(std::move(index), std::move(table_name), std::move(attribute_names),
                                              std::move(index_name));
 }
 
@@ -1892,9 +1967,36 @@ void Sema::operator()(UpdateStmt &s)
 void Sema::operator()(DeleteStmt &s)
 {
     RequireContext RCtx(this, s);
-    /* TODO */
-    (void) s;
-    M_unreachable("Not implemented.");
+    SemaContext &Ctx = get_context();
+    Catalog &C = Catalog::Get();
+
+    if (not C.has_database_in_use()) {
+        diag.e(s.table_name.pos) << "No database in use.\n";
+        return;
+    }
+    auto &DB = C.get_database_in_use();
+
+    const Table *tbl;
+    try {
+        tbl = &DB.get_table(s.table_name.text.assert_not_none());
+    } catch (std::out_of_range) {
+        diag.e(s.table_name.pos) << "Table " << s.table_name.text << " does not exist in database " << DB.name << ".\n";
+        return;
+    }
+
+    /* Rows are deleted by ending their lifetime, which requires the timestamps of a multi-versioned table. */
+    if (not is<const MultiVersioningTable>(tbl)) {
+        diag.e(s.table_name.pos) << "Cannot delete from table " << s.table_name.text
+                                 << " because it is not multi-versioned.\n";
+        return;
+    }
+
+    /* Analyze the WHERE clause with the table as the only source. */
+    Ctx.sources.emplace(tbl->name(), std::make_pair(std::cref(*tbl), 0U));
+    if (s.where) (*this)(*s.where);
+
+    if (not is_nested() and not diag.num_errors())
+        command_ = std::make_unique<DeleteRecords>();
 }
 
 void Sema::operator()(DSVImportStmt &s)
@@ -1908,7 +2010,7 @@ void Sema::operator()(DSVImportStmt &s)
     }
     auto &DB = C.get_database_in_use();
 
-    const Table *table = nullptr;
+    Table *table = nullptr;
     try {
         table = &DB.get_table(s.table_name.text.assert_not_none());
     } catch (std::out_of_range) {
@@ -326,6 +326,10 @@ int main(int argc, const char **argv)
         nullptr, "--plan-table-las",                                                    /* Short, Long      */
         "use the plan table optimized for large and sparse query graphs",               /* Description      */
         [&](bool) { Options::Get().plan_table_type = Options::PT_LargeAndSparse; });    /* Callback         */
+    ADD(bool, Options::Get().plan_table_type, Options::PT_auto,                         /* Type, Var, Init  */
+        nullptr, "--plan-table-compact",                                                /* Short, Long      */
+        "use the compact plan table optimized for very large query graphs",             /* Description      */
+        [&](bool) { Options::Get().plan_table_type = Options::PT_Compact; });           /* Callback         */
 
     ADD(bool, Options::Get().list_data_layouts, false,      /* Type, Var, Init  */
         nullptr, "--list-data-layouts",                     /* Short, Long      */
@@ -384,6 +388,53 @@ int main(int argc, const char **argv)
             show_any_help = true;
         }
     );
+    ADD(bool, Options::Get().compress_imports, false,                           /* Type, Var, Init  */
+        nullptr, "--compress-imports",                                          /* Short, Long      */
+        "compress tables by frame-of-reference encoding after importing data",  /* Description      */
+        [&](bool) { Options::Get().compress_imports = true; }                   /* Callback         */
+    );
+    ADD(bool, Options::Get().async_index_build, false,                          /* Type, Var, Init  */
+        nullptr, "--async-index-build",                                         /* Short, Long      */
+        "bulkload indexes in the background while queries scan the tables",     /* Description      */
+        [&](bool) { Options::Get().async_index_build = true; }                  /* Callback         */
+    );
+    ADD(unsigned, Options::Get().query_timeout, 0,                              /* Type, Var, Init  */
+        nullptr, "--query-timeout",                                             /* Short, Long      */
+        "milliseconds a statement may execute before it is interrupted",        /* Description      */
+        [&](unsigned timeout) { Options::Get().query_timeout = timeout; }       /* Callback         */
+    );
+    /*------ Memory --------------------------------------------------------------------------------------------------*/
+    ADD(bool, Options::Get().transparent_huge_pages, false,                     /* Type, Var, Init  */
+        nullptr, "--transparent-huge-pages",                                    /* Short, Long      */
+        "back the memory of stores with transparent huge pages",                /* Description      */
+        [&](bool) { Options::Get().transparent_huge_pages = true; }             /* Callback         */
+    );
+    ADD(bool, Options::Get().explicit_huge_pages, false,                        /* Type, Var, Init  */
+        nullptr, "--explicit-huge-pages",                                       /* Short, Long      */
+        "back the memory of stores with explicitly reserved 2 MiB huge pages",  /* Description      */
+        [&](bool) { Options::Get().explicit_huge_pages = true; }                /* Callback         */
+    );
+    ADD(int, Options::Get().numa_node, -1,                                      /* Type, Var, Init  */
+        nullptr, "--numa-node",                                                 /* Short, Long      */
+        "bind the memory of stores to the given NUMA node",                     /* Description      */
+        [&](int node) { Options::Get().numa_node = node; }                      /* Callback         */
+    );
+    /*------ Durability ----------------------------------------------------------------------------------------------*/
+    ADD(const char*, Options::Get().wal, nullptr,                               /* Type, Var, Init  */
+        nullptr, "--wal",                                                       /* Short, Long      */
+        "log transactions to the given write-ahead log and recover from it",    /* Description      */
+        [&](const char *path) { Options::Get().wal = path; }                    /* Callback         */
+    );
+    ADD(unsigned long, Options::Get().wal_checkpoint_size, 64UL << 20,          /* Type, Var, Init  */
+        nullptr, "--wal-checkpoint-size",                                       /* Short, Long      */
+        "the size of the write-ahead log in bytes that triggers a checkpoint",  /* Description      */
+        [&](unsigned long size) { Options::Get().wal_checkpoint_size = size; }  /* Callback         */
+    );
+    ADD(unsigned, Options::Get().wal_group_commit_delay, 0,                     /* Type, Var, Init  */
+        nullptr, "--wal-group-commit-delay",                                    /* Short, Long      */
+        "microseconds the write-ahead log waits for more commits to flush",     /* Description      */
+        [&](unsigned delay) { Options::Get().wal_group_commit_delay = delay; }  /* Callback         */
+    );
     /*------ Cost Model Generation -----------------------------------------------------------------------------------*/
     ADD(bool, Options::Get().train_cost_models, false,                  /* Type, Var, Init  */
         nullptr, "--train-cost-models",                                 /* Short, Long      */
@@ -547,6 +598,13 @@ Immanuel Haffner\
         C.default_cost_function(C.pool("TrainedCostFunction"));
     }
 
+    /* ----- Write-ahead log -----------------------------------------------------------------------------------------*/
+    if (Options::Get().wal) {
+        C.wal(std::make_unique<WriteAheadLog>(Options::Get().wal, Options::Get().wal_checkpoint_size,
+                                              std::chrono::microseconds(Options::Get().wal_group_commit_delay)));
+        C.wal()->recover(diag);
+    }
+
     /* ----- Replxx configuration ------------------------------------------------------------------------------------*/
     Replxx rx;
     rx.install_window_change_handler();
@@ -1,6 +1,7 @@
 #include "storage/ColumnStore.hpp"
 
 #include "backend/StackMachine.hpp"
+#include <cstring>
 #include <mutable/catalog/Catalog.hpp>
 #include <numeric>
 
@@ -8,26 +9,43 @@
 using namespace m;
 
 
-ColumnStore::ColumnStore(const Table &table)
+ColumnStore::ColumnStore(const Table &table, memory::Backing backing)
     : Store(table)
+    , allocator_(backing)
 {
-    uint64_t max_attr_size = 0;
-
     /* Allocate memory for the attributes columns and the null bitmap column. */
-    data_ = allocator_.allocate(ALLOCATION_SIZE * (table.num_attrs() + 1));
+    data_ = allocator_.allocate(column_size_ * (table.num_attrs() + 1));
 
     /* Compute the capacity depending on the column with the largest attribute size. */
     for (auto attr = table.begin_all(); attr != table.end_all(); ++attr) {
         auto size = attr->type->size();
         row_size_ += size;
-        max_attr_size = std::max(max_attr_size, size);
+        max_attr_size_ = std::max<std::size_t>(max_attr_size_, size);
     }
     uint32_t num_attrs = table.num_attrs();
     row_size_ += num_attrs;
     uint64_t null_bitmap_size = /* pad_null_bitmap= */ 1 ? ((num_attrs + 7) / 8) * 8 : num_attrs;
-    max_attr_size = std::max(max_attr_size, null_bitmap_size);
+    max_attr_size_ = std::max<std::size_t>(max_attr_size_, null_bitmap_size);
+
+    capacity_ = (column_size_ * 8) / max_attr_size_;
+}
+
+void ColumnStore::grow()
+{
+    exclusive_memory_latch latch; // exclude readers while the memory moves
+    const std::size_t num_columns = table().num_attrs() + 1;
+    const std::size_t old_column_size = column_size_;
+    allocator_.grow(data_, 2 * old_column_size * num_columns);
+    column_size_ = 2 * old_column_size;
+
+    /* Move the columns to their new offsets, starting with the last column to not overwrite any column.  Only move
+     * the part of each column in use to not touch unused memory. */
+    const std::size_t bytes_in_use = std::min(old_column_size, (num_rows_ * max_attr_size_ + 7) / 8);
+    auto base = data_.as<uint8_t*>();
+    for (std::size_t attr_id = num_columns; attr_id-- > 1; )
+        std::memmove(base + column_size_ * attr_id, base + old_column_size * attr_id, bytes_in_use);
 
-    capacity_ = (ALLOCATION_SIZE * 8) / max_attr_size;
+    capacity_ = (column_size_ * 8) / max_attr_size_;
 }
 
 ColumnStore::~ColumnStore() { }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/memory.hpp>
@@ -10,6 +11,8 @@ namespace m {
 /** This class implements a column store. */
 struct ColumnStore : Store
 {
+    /** The initial size of the memory of the store.  Memory is only backed once written to, hence memory consumption
+     * is proportional to the data.  Whenever the store exceeds its memory, the memory is doubled. */
 #ifndef NDEBUG
     static constexpr std::size_t ALLOCATION_SIZE = 1UL << 30; ///< 1 GiB
 #else
@@ -19,42 +22,60 @@ struct ColumnStore : Store
     private:
     memory::LinearAllocator allocator_; ///< the memory allocator
     memory::Memory data_;
-    std::size_t num_rows_ = 0;
+    ///> the number of rows in use; written by the single writer of the store with release semantics, such that readers
+    ///> acquiring it observe the memory of the store as grown
+    std::atomic<std::size_t> num_rows_ = 0;
     std::size_t capacity_;
     std::size_t row_size_ = 0;
+    std::size_t max_attr_size_ = 0; ///< the size of the largest entry of any column, in bits
+    std::size_t column_size_ = ALLOCATION_SIZE; ///< the size of the memory of each column, in bytes
 
     public:
-    ColumnStore(const Table &table);
+    ColumnStore(const Table &table, memory::Backing backing = Default_Backing());
     ~ColumnStore();
 
-    virtual std::size_t num_rows() const override { return num_rows_; }
+    virtual std::size_t num_rows() const override { return num_rows_.load(std::memory_order_acquire); }
 
     /** Returns the effective size of a row, in bits. */
     std::size_t row_size() const { return row_size_; }
+    /** Returns the number of rows that fit into the current memory of the store. */
+    std::size_t capacity() const { return capacity_; }
 
     void append() override {
-        if (num_rows_ == capacity_)
-            throw std::logic_error("row store exceeds capacity");
-        ++num_rows_;
+        const std::size_t num_rows = num_rows_.load(std::memory_order_relaxed);
+        if (num_rows == capacity_)
+            grow();
+        num_rows_.store(num_rows + 1, std::memory_order_release);
     }
 
     void drop() override {
-        M_insist(num_rows_);
-        --num_rows_;
+        const std::size_t num_rows = num_rows_.load(std::memory_order_relaxed);
+        M_insist(num_rows);
+        num_rows_.store(num_rows - 1, std::memory_order_release);
+        zone_map().truncate(num_rows - 1);
+        visibility_summary().invalidate(num_rows - 1, num_rows);
     }
 
     /** Returns the memory of the store. */
     const memory::Memory & memory() const override { return data_; }
-    /** Returns the memory address where the column assigned to the attribute with id `attr_id` starts.
+    /** Growing moves the columns to new offsets. */
+    bool grows_in_place() const override { return false; }
+    /** Returns the memory address where the column assigned to the attribute with id `attr_id` starts.  The address
+     * is invalidated when the store grows.
      * Return the address of the NULL bitmap column if `attr_id == table().size()`. */
     void * memory(std::size_t attr_id) const {
         M_insist(attr_id <= table().num_attrs());
-        auto offset = ALLOCATION_SIZE * attr_id;
+        auto offset = column_size_ * attr_id;
         return reinterpret_cast<uint8_t*>(data_.addr()) + offset;
     }
 
     void dump(std::ostream &out) const override;
     using Store::dump;
+
+    private:
+    /** Doubles the memory of each column and moves the columns to their new offsets.  The store may be moved to a
+     * different virtual address range. */
+    void grow();
 };
 
 }
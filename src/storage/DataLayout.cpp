@@ -1,7 +1,9 @@
 #include <mutable/storage/DataLayout.hpp>
 
+#include <limits>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/catalog/Type.hpp>
+#include <unordered_map>
 
 
 using namespace m;
@@ -21,6 +23,28 @@ DataLayout::Node::~Node() { }
 
 void DataLayout::Leaf::accept(ConstDataLayoutVisitor &v) const { v(*this); };
 
+bool DataLayout::Leaf::is_bit_packed() const
+{
+    return is_frame_of_reference_encoded() and stored_type()->is_bitmap();
+}
+
+std::pair<int64_t, int64_t> DataLayout::Leaf::encodable_range() const
+{
+    constexpr int64_t MIN = std::numeric_limits<int64_t>::min();
+    constexpr int64_t MAX = std::numeric_limits<int64_t>::max();
+    const int64_t ref = reference();
+
+    if (is_bit_packed()) { // unsigned differences from 0 to 2^size-1
+        int64_t max;
+        if (__builtin_add_overflow(ref, (int64_t(1) << stored_type()->size()) - 1, &max))
+            max = MAX;
+        return { ref, max };
+    }
+
+    const int64_t bound = int64_t(1) << (stored_type()->size() - 1); // signed differences from -bound to bound-1
+    return { ref < MIN + bound ? MIN : ref - bound, ref > MAX - bound ? MAX : ref + bound - 1 };
+}
+
 
 /*----------------------------------------------------------------------------------------------------------------------
  * DataLayout::INode
@@ -117,8 +141,13 @@ void DataLayout::INode::print(std::ostream &out, unsigned int indentation) const
 
         auto &child = *it;
         if (auto child_leaf = cast<const Leaf>(child.ptr.get())) {
-            out << "Leaf " << child_leaf->index() << " of type " << *child_leaf->type() << " with bit offset "
-                << child.offset_in_bits << " and bit stride " << child.stride_in_bits;
+            out << "Leaf " << child_leaf->index() << " of type " << *child_leaf->type();
+            if (child_leaf->is_dictionary_encoded())
+                out << " (dictionary-encoded)";
+            else if (child_leaf->is_frame_of_reference_encoded())
+                out << " (frame-of-reference encoded as " << *child_leaf->stored_type() << " relative to "
+                    << child_leaf->reference() << ')';
+            out << " with bit offset " << child.offset_in_bits << " and bit stride " << child.stride_in_bits;
         } else {
             auto child_inode = as<const INode>(child.ptr.get());
             out << "INode of " << child_inode->num_tuples() << " tuple(s) with bit offset " << child.offset_in_bits
@@ -156,6 +185,47 @@ DataLayout::INode & DataLayout::add_inode(size_type num_tuples, uint64_t stride_
     return *inode;
 }
 
+DataLayout::Leaf & DataLayout::find_leaf(size_type idx)
+{
+    auto find_leaf_impl = [idx](INode &inode, auto &find_leaf_ref) -> Leaf * {
+        for (auto &child : inode.children_) {
+            if (auto child_leaf = cast<Leaf>(child.ptr.get())) {
+                if (child_leaf->index() == idx)
+                    return child_leaf;
+            } else if (auto leaf = find_leaf_ref(as<INode>(*child.ptr), find_leaf_ref)) {
+                return leaf;
+            }
+        }
+        return nullptr;
+    };
+    auto leaf = find_leaf_impl(inode_, find_leaf_impl);
+    if (not leaf)
+        throw m::invalid_argument("no leaf with the given index");
+    return *leaf;
+}
+
+void DataLayout::dictionary_encode(size_type idx, const CharacterSequence *type)
+{
+    auto &leaf = find_leaf(idx);
+    M_insist(leaf.type()->size() == 8 * sizeof(Dictionary::code_type), "leaf must be laid out for codes");
+
+    leaf.stored_type_ = leaf.type_;
+    leaf.type_ = type;
+    leaf.dictionary_ = std::make_unique<Dictionary>(type);
+}
+
+void DataLayout::frame_of_reference_encode(size_type idx, const Numeric *type, int64_t reference)
+{
+    auto &leaf = find_leaf(idx);
+    M_insist(type->kind != Numeric::N_Float, "only integral values can be frame-of-reference encoded");
+    M_insist((leaf.type()->is_integral() or leaf.type()->is_bitmap()) and leaf.type()->size() < type->size(),
+             "leaf must be laid out for narrower integers or bits");
+
+    leaf.stored_type_ = leaf.type_;
+    leaf.type_ = type;
+    leaf.reference_ = reference;
+}
+
 void DataLayout::accept(ConstDataLayoutVisitor &v) const { v(*this); }
 
 void DataLayout::for_sibling_leaves(DataLayout::callback_leaves_t callback) const
@@ -165,6 +235,33 @@ void DataLayout::for_sibling_leaves(DataLayout::callback_leaves_t callback) cons
 }
 
 
+/*======================================================================================================================
+ * Helper functions for writers
+ *====================================================================================================================*/
+
+std::vector<const DataLayout::Leaf*> m::storage::frame_of_reference_leaves(const DataLayout &layout)
+{
+    std::vector<const DataLayout::Leaf*> leaves;
+    layout.for_sibling_leaves([&](const auto &sibling_leaves, const auto&, uint64_t) {
+        for (auto &leaf_info : sibling_leaves) {
+            if (leaf_info.leaf.is_frame_of_reference_encoded())
+                leaves.push_back(&leaf_info.leaf);
+        }
+    });
+    return leaves;
+}
+
+bool m::storage::has_null_bitmap(const DataLayout &layout, std::size_t num_attrs)
+{
+    bool found = false;
+    layout.for_sibling_leaves([&](const auto &sibling_leaves, const auto&, uint64_t) {
+        for (auto &leaf_info : sibling_leaves)
+            found = found or leaf_info.leaf.index() == num_attrs;
+    });
+    return found;
+}
+
+
 /*======================================================================================================================
  * Helper functions for SIMD support
  *====================================================================================================================*/
@@ -218,6 +315,8 @@ bool m::storage::supports_simd(const DataLayout &layout, const Schema &layout_sc
                     continue; // entry not contained in tuple schema
                 M_insist(*tuple_it->type == *child_leaf.type());
 
+                if (child_leaf.is_bit_packed())
+                    return false; // bit-packed values are decoded scalar
                 if (bit_stride) {
                     if (child.stride_in_bits != 1)
                         return false; // stride must be 1 bit
@@ -228,7 +327,7 @@ bool m::storage::supports_simd(const DataLayout &layout, const Schema &layout_sc
                         return false; // string SIMDfication currently not supported
                 }
 
-                const uint64_t size_in_bytes = (tuple_it->type->size() + 7) / 8;
+                const uint64_t size_in_bytes = (child_leaf.stored_type()->size() + 7) / 8;
                 num_simd_lanes = std::max<std::size_t>(num_simd_lanes, 16 / size_in_bytes); // repeat to fill 128bit SIMD vector
             }
         }
@@ -247,12 +346,20 @@ std::size_t m::storage::get_num_simd_lanes(const DataLayout &layout, const Schem
     M_insist(supports_simd(layout, layout_schema, tuple_schema),
              "layout must support SIMD to retrieve its number of SIMD lanes");
 
+    /* Collect the sizes of the values stored by the leaves; encoded leaves store values narrower than their type. */
+    std::unordered_map<DataLayout::size_type, uint64_t> stored_sizes;
+    layout.for_sibling_leaves([&](const auto &leaves, const auto&, uint64_t) {
+        for (auto &leaf_info : leaves)
+            stored_sizes.emplace(leaf_info.leaf.index(), leaf_info.leaf.stored_type()->size());
+    });
+
     std::size_t num_simd_lanes = 1;
     for (auto &tuple_entry : tuple_schema) {
-        if (layout_schema[tuple_entry.id].second.nullable())
+        auto [layout_idx, layout_entry] = layout_schema[tuple_entry.id];
+        if (layout_entry.nullable())
             return 16; // repeat 16 times for 128bit SIMD vector; return immediately since this is the max. #lanes
 
-        const uint64_t size_in_bytes = (tuple_entry.type->size() + 7) / 8;
+        const uint64_t size_in_bytes = (stored_sizes.at(layout_idx) + 7) / 8;
         num_simd_lanes = std::max<std::size_t>(num_simd_lanes, 16 / size_in_bytes); // repeat to fill 128bit SIMD vector
     }
 
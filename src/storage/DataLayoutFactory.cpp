@@ -1,5 +1,6 @@
 #include <mutable/storage/DataLayoutFactory.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Type.hpp>
@@ -26,7 +27,7 @@ namespace options {
 /** Whether to reorder attributes when creating data layouts. */
 bool attribute_reordering = true;
 
-/** Whether to remove the NULL bitmap in all created data layouts. */
+/** Whether to remove the NULL bitmap in all created data layouts, even if values may be `NULL`. */
 bool remove_null_bitmap = false;
 
 /** Whether to pack one tuple less than theoretically possible in a created PAX data layout. */
@@ -51,7 +52,8 @@ static void add_storage_args()
         /* group=       */ "Storage",
         /* short=       */ nullptr,
         /* long=        */ "--remove-null-bitmap",
-        /* description= */ "remove the NULL bitmap in all created data layouts",
+        /* description= */ "remove the NULL bitmap in all created data layouts, even if values may be NULL; only used "
+                           "for benchmarking purposes",
         /* callback=    */ [](bool){ options::remove_null_bitmap = true; }
     );
     C.arg_parser().add<bool>(
@@ -86,9 +88,22 @@ compute_attribute_order(const std::vector<const Type*> &types)
     return indices;
 }
 
-DataLayout RowLayoutFactory::make(std::vector<const Type*> types, std::size_t num_tuples) const
+/** Returns `true` iff a created data layout for types that may be `NULL` as given by \p nullable needs a NULL bitmap.
+ * A NULL bitmap is omitted if no value may be `NULL`, e.g. since all attributes are declared `NOT NULL`, or if the CLI
+ * option `--remove-null-bitmap` is set. */
+bool needs_null_bitmap(const std::vector<bool> &nullable)
+{
+    if (options::remove_null_bitmap)
+        return false;
+    return std::find(nullable.begin(), nullable.end(), true) != nullable.end();
+}
+
+DataLayout RowLayoutFactory::make(std::vector<const Type*> types, std::vector<bool> nullable,
+                                   std::size_t num_tuples) const
 {
     M_insist(not types.empty(), "cannot make layout for zero types");
+    M_insist(types.size() == nullable.size(), "nullability must be given for each type");
+    const bool has_null_bitmap = needs_null_bitmap(nullable);
 
     auto indices = compute_attribute_order(types);
     uint64_t offsets[types.size()]; // in bits
@@ -107,7 +122,7 @@ DataLayout RowLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
     const uint64_t null_bitmap_offset = offset_in_bits;
 
     /*----- Compute row size with padding. -----*/
-    if (not options::remove_null_bitmap)
+    if (has_null_bitmap)
         offset_in_bits += types.size(); // space for NULL bitmap
     if (uint64_t rem = offset_in_bits % alignment_in_bits; rem)
         offset_in_bits += alignment_in_bits - rem;
@@ -118,7 +133,7 @@ DataLayout RowLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
     auto &row = layout.add_inode(1, row_size_in_bits);
     for (std::size_t idx = 0; idx != types.size(); ++idx)
         row.add_leaf(types[idx], idx, offsets[idx], 0); // add attribute
-    if (not options::remove_null_bitmap) {
+    if (has_null_bitmap) {
         row.add_leaf( // add NULL bitmap
             /* type=           */ Type::Get_Bitmap(Type::TY_Vector, types.size()),
             /* idx=            */ types.size(),
@@ -130,9 +145,12 @@ DataLayout RowLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
     return layout;
 }
 
-DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::size_t num_tuples) const
+DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::vector<bool> nullable,
+                                   std::size_t num_tuples) const
 {
     M_insist(not types.empty(), "cannot make layout for zero types");
+    M_insist(types.size() == nullable.size(), "nullability must be given for each type");
+    const bool has_null_bitmap = needs_null_bitmap(nullable);
 
     auto indices = compute_attribute_order(types);
     uint64_t offsets[types.size() + 1]; // in bits
@@ -155,7 +173,7 @@ DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
 
     /*----- Compute NULL bitmap offset in a virtual row. -----*/
     const uint64_t null_bitmap_size_in_bits =
-        options::remove_null_bitmap ? 0 : std::max(ceil_to_pow_2(types.size()), 8UL); // add padding to support SIMDfication
+        has_null_bitmap ? std::max(ceil_to_pow_2(types.size()), 8UL) : 0; // add padding to support SIMDfication
     offsets[types.size()] = offset_in_bits;
     if (null_bitmap_size_in_bits % 8)
         ++num_not_byte_aligned;
@@ -214,7 +232,7 @@ DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
     auto &pax_block = layout.add_inode(num_rows_per_block, num_blocks_per_row * block_size_in_bits);
     for (std::size_t idx = 0; idx != types.size(); ++idx)
         pax_block.add_leaf(types[idx], idx, offsets[idx], types[idx]->size());
-    if (not options::remove_null_bitmap) {
+    if (has_null_bitmap) {
         pax_block.add_leaf( // add NULL bitmap
             /* type=           */ Type::Get_Bitmap(Type::TY_Vector, types.size()),
             /* idx=            */ types.size(),
@@ -226,6 +244,72 @@ DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
     return layout;
 }
 
+DataLayout DictionaryLayoutFactory::make(std::vector<const Type*> types, std::vector<bool> nullable,
+                                         std::size_t num_tuples) const
+{
+    /*----- Lay out codes in place of character sequences. -----*/
+    std::vector<const Type*> stored_types(types);
+    for (auto &type : stored_types) {
+        if (type->is_character_sequence())
+            type = Type::Get_Integer(Type::TY_Vector, sizeof(Dictionary::code_type));
+    }
+    DataLayout layout = factory_->make(std::move(stored_types), std::move(nullable), num_tuples);
+
+    /*----- Dictionary-encode the leaves of character sequences. -----*/
+    for (std::size_t idx = 0; idx != types.size(); ++idx) {
+        if (auto cs = cast<const CharacterSequence>(types[idx]))
+            layout.dictionary_encode(idx, cs);
+    }
+
+    return layout;
+}
+
+DataLayout FrameOfReferenceLayoutFactory::make(std::vector<const Type*> types, std::vector<bool> nullable,
+                                               std::size_t num_tuples) const
+{
+    if (types.size() != ranges_.size())
+        throw invalid_argument("number of types does not match number of ranges");
+
+    /*----- Lay out the narrowest sufficient integer or bits in place of integral numerics with known range. -----*/
+    std::vector<const Type*> stored_types(types);
+    std::vector<std::optional<int64_t>> references(types.size());
+    for (std::size_t idx = 0; idx != types.size(); ++idx) {
+        auto n = cast<const Numeric>(types[idx]);
+        if (not n or n->kind == Numeric::N_Float or not ranges_[idx])
+            continue;
+
+        auto [min, max] = *ranges_[idx];
+        M_insist(min <= max, "invalid range");
+        const uint64_t span = uint64_t(max) - uint64_t(min); // may exceed `int64_t`
+        const std::size_t num_bits = span ? 64 - __builtin_clzl(span) : 1; // bits needed for the span
+
+        for (std::size_t num_bytes = 1; 8 * num_bytes < n->size(); num_bytes *= 2) {
+            if (span >> (8 * num_bytes) == 0) { // span fits into `num_bytes` bytes
+                stored_types[idx] = Type::Get_Integer(Type::TY_Vector, num_bytes);
+                /* Use the midpoint rounded up as reference, s.t. the differences range from -2^(8*num_bytes-1) to
+                 * 2^(8*num_bytes-1)-1 in the worst case. */
+                references[idx] = int64_t(uint64_t(min) + (span - span / 2));
+                break;
+            }
+        }
+
+        /* Bit-pack if fewer bits than the laid out integer suffice. */
+        if (bit_packing_ and num_bits <= MAX_BIT_PACKING_WIDTH and num_bits < stored_types[idx]->size()) {
+            stored_types[idx] = Type::Get_Bitmap(Type::TY_Vector, num_bits);
+            references[idx] = min; // differences range from 0 to 2^num_bits-1
+        }
+    }
+    DataLayout layout = factory_->make(std::move(stored_types), std::move(nullable), num_tuples);
+
+    /*----- Frame-of-reference encode the leaves of narrowed numerics. -----*/
+    for (std::size_t idx = 0; idx != types.size(); ++idx) {
+        if (references[idx])
+            layout.frame_of_reference_encode(idx, as<const Numeric>(types[idx]), *references[idx]);
+    }
+
+    return layout;
+}
+
 __attribute__((constructor(202)))
 static void register_data_layouts()
 {
@@ -243,5 +327,17 @@ static void register_data_layouts()
     REGISTER_PAX_TUPLES(PAX128Tup, 128, "stores attributes using PAX layout with blocks for 128 tuples");
     REGISTER_PAX_TUPLES(PAX1024Tup, 1024, "stores attributes using PAX layout with blocks for 1024 tuples");
     C.register_data_layout(C.pool("Row"), std::make_unique<RowLayoutFactory>(), "stores attributes in row-major order");
+    C.register_data_layout(
+        C.pool("PAX4M_Dict"),
+        std::make_unique<DictionaryLayoutFactory>(
+            std::make_unique<PAXLayoutFactory>(PAXLayoutFactory::NBytes, 1UL << 22)
+        ),
+        "stores attributes using PAX layout with 4MiB blocks and dictionary-encoded character sequences"
+    );
+    C.register_data_layout(
+        C.pool("Row_Dict"),
+        std::make_unique<DictionaryLayoutFactory>(std::make_unique<RowLayoutFactory>()),
+        "stores attributes in row-major order with dictionary-encoded character sequences"
+    );
 #undef REGISTER_PAX
 }
@@ -0,0 +1,95 @@
+#include <mutable/storage/Dictionary.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/storage/Store.hpp>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+Dictionary::Dictionary(const CharacterSequence *type)
+    : type_(M_notnull(type))
+    , entry_size_(type->length + 1) // add terminating NUL byte
+{
+    entries_ = allocator_.allocate(std::max(ALLOCATION_SIZE, entry_size_));
+}
+
+Dictionary::code_type Dictionary::encode(const char *value)
+{
+    std::string str(value, strnlen(value, type_->length));
+    Store::exclusive_memory_latch memory_latch(std::defer_lock);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    code_type code;
+    for (;;) {
+        if (auto it = codes_.find(str); it != codes_.end())
+            return it->second;
+
+        M_insist(std::in_range<code_type>(codes_.size()), "too many distinct values for the code type");
+        code = codes_.size();
+        if ((code + 1) * entry_size_ <= entries_.size())
+            break;
+        if (memory_latch.held()) {
+            allocator_.grow(entries_, 2 * entries_.size()); // double the memory
+            break;
+        }
+
+        /* Exclude readers while the memory moves.  Readers acquire the memory latch before `mutex_`, so release
+         * `mutex_` to acquire both in the same order and check again. */
+        lock.unlock();
+        memory_latch.lock();
+        lock.lock();
+    }
+
+    char *entry = entries_.as<char*>() + code * entry_size_;
+    if (is_order_preserving_ and code != 0 and std::strcmp(str.c_str(), entry - entry_size_) < 0)
+        is_order_preserving_ = false; // the new value is less than the greatest value
+    std::memcpy(entry, str.c_str(), str.length() + 1); // copy value including terminating NUL byte
+    codes_.emplace(std::move(str), code);
+    return code;
+}
+
+std::optional<Dictionary::code_type> Dictionary::find(const char *value) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (auto it = codes_.find(std::string(value, strnlen(value, type_->length))); it != codes_.end())
+        return it->second;
+    return std::nullopt;
+}
+
+Dictionary::code_type Dictionary::bound(const char *value, bool is_upper) const
+{
+    std::string str(value, strnlen(value, type_->length));
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    M_insist(is_order_preserving_, "bounds require order-preserving codes");
+
+    /* Binary search for the first code whose value is not less (greater, if `is_upper`) than `str`.  The codes are
+     * ordered like their values. */
+    code_type first = 0, count = codes_.size();
+    while (count) {
+        const code_type half = count / 2;
+        const int cmp = std::strcmp(entries_.as<const char*>() + (first + half) * entry_size_, str.c_str());
+        if (cmp < 0 or (is_upper and cmp == 0)) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+M_LCOV_EXCL_START
+void Dictionary::dump(std::ostream &out) const
+{
+    out << "Dictionary at " << entries_.addr() << " of type " << *type_ << " with " << size() << " value(s), "
+        << entry_size_ << " bytes per entry" << (is_order_preserving() ? ", order-preserving" : "") << std::endl;
+}
+
+void Dictionary::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
@@ -1,11 +1,14 @@
 #include <mutable/storage/Index.hpp>
 
+#include "backend/Interpreter.hpp"
+#include <atomic>
+#include <iterator>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/catalog/Type.hpp>
 #include <mutable/mutable.hpp>
-#include <mutable/Options.hpp>
-#include <mutable/util/Timer.hpp>
-#include <sstream>
+#include <mutable/storage/Store.hpp>
+#include <shared_mutex>
+#include <thread>
 
 
 using namespace m;
@@ -17,6 +20,10 @@ namespace options {
 
 /** Which ratio of linear models to index entries should be used for `idx::RecursiveModelIndex`. */
 double rmi_model_entry_ratio = 0.01;
+/** The maximum error of the segments of `idx::PiecewiseGeometricModelIndex`. */
+unsigned pgm_epsilon = 64;
+/** The number of threads building an index, or 0 to use all hardware threads. */
+unsigned index_build_threads = 0;
 
 }
 
@@ -33,28 +40,95 @@ static void add_index_args()
         /* description= */ "specify the ratio of linear models to index entries for recursive model indexes",
         /* callback=    */ [](double rmi_model_entry_ratio){ options::rmi_model_entry_ratio = rmi_model_entry_ratio; }
     );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Index",
+        /* short=       */ nullptr,
+        /* long=        */ "--pgm-epsilon",
+        /* description= */ "specify the maximum error in positions of the segments of PGM indexes (default: 64)",
+        /* callback=    */ [](unsigned pgm_epsilon){ options::pgm_epsilon = pgm_epsilon; }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Index",
+        /* short=       */ nullptr,
+        /* long=        */ "--index-build-threads",
+        /* description= */ "specify the number of threads building an index (default: all hardware threads)",
+        /* callback=    */ [](unsigned index_build_threads){ options::index_build_threads = index_build_threads; }
+    );
 }
 
+/** The number of rows a thread scans at once when bulkloading an index. */
+constexpr std::size_t NUM_ROWS_PER_CHUNK = 1UL << 16;
+/** The minimal number of entries per thread for sorting an index in parallel. */
+constexpr std::size_t MIN_ENTRIES_PER_THREAD = 1UL << 14;
+
+/** Returns the number of threads building an index. */
+std::size_t num_build_threads()
+{
+    if (options::index_build_threads)
+        return options::index_build_threads;
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/** Invokes \p fn for every `i` in [0, \p n), distributing the invocations dynamically among `num_build_threads()`
+ * threads. */
+template<typename Fn>
+void parallel_for(std::size_t n, Fn &&fn)
+{
+    const std::size_t num_threads = std::min(n, num_build_threads());
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i != n; ++i)
+            fn(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto work = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;)
+            fn(i);
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (std::size_t t = 1; t != num_threads; ++t)
+        threads.emplace_back(work);
+    work(); // the calling thread participates
+    for (auto &thread : threads)
+        thread.join();
 }
 
-std::string IndexBase::build_query(const Table &table, const Schema &schema)
+/** Sorts the range [\p begin, \p end) by \p cmp.  Sorts one run per thread in parallel and merges pairs of adjacent
+ * runs in parallel until a single run remains. */
+template<typename It, typename Cmp>
+void parallel_sort(It begin, It end, Cmp cmp)
 {
-    std::ostringstream oss;
-    oss << "SELECT ";
-    for (std::size_t i = 0; i != schema.num_entries(); ++i) {
-        if (i != 0) oss << ", ";
-        oss << schema.at(i).id;
+    const std::size_t n = std::distance(begin, end);
+    const std::size_t num_runs = std::clamp<std::size_t>(n / MIN_ENTRIES_PER_THREAD, 1, num_build_threads());
+    if (num_runs == 1) {
+        std::sort(begin, end, cmp);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(num_runs + 1);
+    for (std::size_t i = 0; i <= num_runs; ++i)
+        bounds[i] = n * i / num_runs;
+    parallel_for(num_runs, [&](std::size_t i) { std::sort(begin + bounds[i], begin + bounds[i + 1], cmp); });
+
+    for (std::size_t width = 1; width < num_runs; width *= 2) {
+        const std::size_t num_merges = (num_runs + 2 * width - 1) / (2 * width);
+        parallel_for(num_merges, [&](std::size_t i) {
+            const std::size_t first = 2 * i * width;
+            const std::size_t middle = std::min(first + width, num_runs);
+            const std::size_t last = std::min(first + 2 * width, num_runs);
+            if (middle != last)
+                std::inplace_merge(begin + bounds[first], begin + bounds[middle], begin + bounds[last], cmp);
+        });
     }
-    oss << " FROM " << table.name() << ';';
-    return oss.str();
+}
+
 }
 
 template<typename Key>
 void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
 {
-    /* XXX: Disable timer during execution to not print times for query that is performed as part of bulkloading. */
-    const auto &old_timer = std::exchange(Catalog::Get().timer(), Timer());
-
     /* Check that key schema contains a single entry. */
     if (key_schema.num_entries() != 1)
         throw invalid_argument("Key schema should contain exactly one entry.");
@@ -95,15 +169,6 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
     }, *attribute_type);
 #undef CHECk
 
-    /* Build the query to retrieve keys. */
-    auto query = build_query(table, key_schema);
-
-    /* Create the diagnostics object. */
-    Diagnostic diag(Options::Get().has_color, std::cout, std::cerr);
-
-    /* Compute statement from query string. */
-    auto stmt = statement_from_string(diag, query);
-
     /* Define get function based on key_type. */
     std::function<key_type(const Tuple&)> fn_get;
     if constexpr(integral<key_type>)
@@ -111,31 +176,42 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
     else // bool, float, double, const char*
         fn_get = [](const Tuple &t) { return t.get(0).as<key_type>(); };
 
-    /* Define callback operator to add keys to index. */
-    std::size_t tuple_id = 0;
-    auto fn_add = [&](const Schema&, const Tuple &tuple) {
-        if (not tuple.is_null(0))
-            this->add(fn_get(tuple), tuple_id);
-        tuple_id++;
-    };
-    auto consumer = std::make_unique<CallbackOperator>(fn_add);
-
-    /* Create backend on which the query is exectued.  We are using the `Interpreter` as the `wasm::Scan` might have
-     * been deactivated via CLI which results in not finding a plan for the query.
-     * TODO: We plan on using the default `Backend` set in the `Catalog` with temporarily adjusting the options to make
-     * sure `wasm::Scan` is available. */
-    static thread_local std::unique_ptr<Backend> backend;
-    if (not backend)
-        backend = Catalog::Get().create_backend(Catalog::Get().pool("Interpreter"));
+    /* Scan chunks of rows in parallel.  Rows appended meanwhile are not indexed. */
+    const Schema layout_schema = table.schema();
+    const std::size_t num_rows = table.store().num_rows();
+    const std::size_t num_chunks = (num_rows + NUM_ROWS_PER_CHUNK - 1) / NUM_ROWS_PER_CHUNK;
+    std::vector<container_type> chunks(num_chunks);
+    parallel_for(num_chunks, [&](std::size_t chunk) {
+        const std::size_t begin = chunk * NUM_ROWS_PER_CHUNK;
+        const std::size_t end = std::min(begin + NUM_ROWS_PER_CHUNK, num_rows);
+        std::shared_lock<std::shared_mutex> latch(Store::Memory_Latch()); // the store must not move while scanned
+        auto loader = Interpreter::compile_load(key_schema, table.store().memory().addr(), table.layout(),
+                                                layout_schema, begin);
+        Tuple tup(key_schema);
+        Tuple *args[] = { &tup };
+        auto &entries = chunks[chunk];
+        entries.reserve(end - begin);
+        for (std::size_t row_id = begin; row_id != end; ++row_id) {
+            loader(args);
+            if (tup.is_null(0))
+                continue;
+            if constexpr(std::same_as<key_type, const char*>)
+                entries.emplace_back(Catalog::Get().pool(fn_get(tup)), row_id);
+            else
+                entries.emplace_back(fn_get(tup), row_id);
+        }
+    });
 
-    /* Execute query to insert tuples. */
-    m::execute_query(diag, as<ast::SelectStmt>(*stmt), std::move(consumer), *backend);
+    /* Concatenate the entries of all chunks. */
+    std::size_t num_entries = data_.size();
+    for (auto &entries : chunks)
+        num_entries += entries.size();
+    data_.reserve(num_entries);
+    for (auto &entries : chunks)
+        data_.insert(data_.end(), entries.begin(), entries.end());
 
     /* Finalize index. */
     finalize();
-
-    /* XXX: Reenable timer. */
-    std::exchange(Catalog::Get().timer(), std::move(old_timer));
 }
 
 template<typename Key>
@@ -150,17 +226,25 @@ void ArrayIndex<Key>::add(const key_type key, const value_type value)
     finalized_ = false;
 }
 
+template<typename Key>
+void ArrayIndex<Key>::finalize()
+{
+    parallel_sort(data_.begin(), data_.end(), cmp);
+    finalized_ = true;
+}
+
 template<arithmetic Key>
 void RecursiveModelIndex<Key>::finalize()
 {
     /* Sort data. */
-    std::sort(base_type::data_.begin(), base_type::data_.end(), base_type::cmp);
+    parallel_sort(base_type::data_.begin(), base_type::data_.end(), base_type::cmp);
 
     /* Compute number of models. */
     auto begin = base_type::begin();
     auto end = base_type::end();
     std::size_t n_keys = std::distance(begin, end);
     std::size_t n_models = std::max<std::size_t>(1, n_keys * options::rmi_model_entry_ratio);
+    models_.clear();
     models_.reserve(n_models + 1);
 
     /* Train first layer. */
@@ -173,55 +257,321 @@ void RecursiveModelIndex<Key>::finalize()
         )
     );
 
-    /* Train second layer. */
-    auto get_segment_id = [&](entry_type e) { return std::clamp<double>(models_[0](e.first), 0, n_models - 1);  };
-    std::size_t segment_start = 0;
-    std::size_t segment_id = 0;
-    for (std::size_t i = 0; i != n_keys; ++i) {
-        auto pos = begin + i;
-        std::size_t pred_segment_id = get_segment_id(*pos);
-        if (pred_segment_id > segment_id) {
-            models_.emplace_back(
-                LinearModel::train_linear_regression(
-                    /* begin=  */ begin + segment_start,
-                    /* end=    */ pos,
-                    /* offset= */ segment_start
-                )
+    /* Compute the segments of the second layer.  The first layer is monotonic, hence segment `j` consists of the
+     * entries in [`bounds[j]`, `bounds[j + 1]`). */
+    auto get_segment_id = [&](const entry_type &e) -> std::size_t {
+        return std::clamp<double>(models_[0](e.first), 0, n_models - 1);
+    };
+    std::vector<std::size_t> bounds(n_models + 1);
+    parallel_for(n_models, [&](std::size_t j) {
+        auto first = std::partition_point(begin, end, [&](const entry_type &e) { return get_segment_id(e) < j; });
+        bounds[j] = std::distance(begin, first);
+    });
+    bounds[n_models] = n_keys;
+
+    /* Train second layer in parallel.  A model of an empty segment predicts the position of the last entry preceding
+     * the segment. */
+    models_.resize(n_models + 1, LinearModel(0.0, 0.0));
+    parallel_for(n_models, [&](std::size_t j) {
+        if (bounds[j] != bounds[j + 1]) {
+            models_[j + 1] = LinearModel::train_linear_regression(
+                /* begin=  */ begin + bounds[j],
+                /* end=    */ begin + bounds[j + 1],
+                /* offset= */ bounds[j]
             );
-            for (std::size_t j = segment_id + 1; j < pred_segment_id; ++j) {
-                models_.emplace_back(
-                    LinearModel::train_linear_regression(
-                        /* begin=  */ pos - 1,
-                        /* end=    */ pos,
-                        /* offset= */ i - 1
-                    )
-                );
-            }
-            segment_id = pred_segment_id;
-            segment_start = i;
+        } else if (bounds[j] != 0) {
+            models_[j + 1] = LinearModel::train_linear_regression(
+                /* begin=  */ begin + bounds[j] - 1,
+                /* end=    */ begin + bounds[j],
+                /* offset= */ bounds[j] - 1
+            );
+        }
+    });
+
+    /* Mark index as finalized. */
+    base_type::finalized_ = true;
+};
 
+template<typename Key>
+requires arithmetic<Key> or std::same_as<Key, const char*>
+std::vector<typename PiecewiseGeometricModelIndex<Key>::Segment>
+PiecewiseGeometricModelIndex<Key>::fit_segments(typename std::vector<point_type>::const_iterator first,
+                                                typename std::vector<point_type>::const_iterator last,
+                                                std::size_t epsilon)
+{
+    /* Every segment starts at a point.  The slopes of lines through that point which predict all points added so far
+     * within `epsilon` form a cone, which shrinks with every point added.  A point outside the cone starts the next
+     * segment. */
+    const double eps = epsilon;
+    std::vector<Segment> segments;
+    for (auto it = first; it != last;) {
+        const auto [x0, y0] = *it;
+        double slope_lo = 0.0;
+        double slope_hi = std::numeric_limits<double>::infinity();
+        for (++it; it != last; ++it) {
+            const double dx = distance(x0, it->first);
+            const double dy = static_cast<double>(it->second - y0);
+            if (dx == 0.0) { // model keys too close to be distinguished
+                if (dy > eps) break;
+                continue;
+            }
+            const double lo = std::max(slope_lo, (dy - eps) / dx);
+            const double hi = std::min(slope_hi, (dy + eps) / dx);
+            if (lo > hi) break;
+            slope_lo = lo;
+            slope_hi = hi;
         }
+        segments.emplace_back(x0, slope_hi == std::numeric_limits<double>::infinity() ? slope_lo
+                                                                                      : (slope_lo + slope_hi) / 2, y0);
     }
-    models_.emplace_back(
-        LinearModel::train_linear_regression(
-            /* begin=  */ begin + segment_start,
-            /* end=    */ end,
-            /* offset= */ segment_start
-        )
-    );
-    for (std::size_t j = segment_id + 1; j < n_models; ++j) {
-        models_.emplace_back(
-            LinearModel::train_linear_regression(
-                /* begin=  */ end - 1,
-                /* end=    */ end,
-                /* offset= */ n_keys - 1
-            )
-        );
+    return segments;
+}
+
+template<typename Key>
+requires arithmetic<Key> or std::same_as<Key, const char*>
+void PiecewiseGeometricModelIndex<Key>::finalize()
+{
+    /* Sort data. */
+    auto &data = base_type::data_;
+    parallel_sort(data.begin(), data.end(), base_type::cmp);
+    epsilon_ = options::pgm_epsilon;
+    levels_.clear();
+
+    /* Compute the points to fit, i.e. every distinct model key with the position of its first entry.  If the entries
+     * of a model key are followed by a gap in the model keys, the successor of the model key is added with the
+     * position of the next entry, such that the position of every model key in the gap is bounded as well. */
+    std::vector<point_type> points;
+    for (std::size_t pos = 0; pos != data.size();) {
+        const auto x = model_key(data[pos].first);
+        std::size_t next = pos + 1;
+        while (next != data.size() and model_key(data[next].first) == x)
+            ++next;
+        points.emplace_back(x, pos);
+        auto succ = successor(x);
+        if (next != pos + 1 and succ and (next == data.size() or *succ < model_key(data[next].first)))
+            points.emplace_back(*succ, next);
+        pos = next;
+    }
+    if (points.empty()) {
+        base_type::finalized_ = true;
+        return;
+    }
+
+    /* Fit the lowest level.  Disjoint ranges of points are fitted in parallel, hence no segment spans two ranges. */
+    const std::size_t num_ranges = std::clamp<std::size_t>(points.size() / MIN_ENTRIES_PER_THREAD, 1,
+                                                           num_build_threads());
+    std::vector<std::vector<Segment>> ranges(num_ranges);
+    parallel_for(num_ranges, [&](std::size_t i) {
+        ranges[i] = fit_segments(points.cbegin() + points.size() * i / num_ranges,
+                                 points.cbegin() + points.size() * (i + 1) / num_ranges, epsilon_);
+    });
+    auto &lowest = levels_.emplace_back();
+    for (auto &segments : ranges)
+        lowest.insert(lowest.end(), segments.begin(), segments.end());
+
+    /* Fit the upper levels to the first keys of the segments of the level below until a single segment remains. */
+    while (levels_.back().size() > 1) {
+        points.clear();
+        for (std::size_t i = 0; i != levels_.back().size(); ++i)
+            points.emplace_back(levels_.back()[i].key, i);
+        levels_.push_back(fit_segments(points.cbegin(), points.cend(), epsilon_));
     }
 
     /* Mark index as finalized. */
     base_type::finalized_ = true;
-};
+}
+
+template<typename Key>
+requires arithmetic<Key> or std::same_as<Key, const char*>
+std::pair<std::size_t, std::size_t>
+PiecewiseGeometricModelIndex<Key>::search_window(const std::vector<Segment> &segments, std::size_t segment_id,
+                                                 std::size_t n, const model_key_type x) const
+{
+    /* The position lies between the first positions of the segment and its successor.  The segment errs by at most
+     * `epsilon_` for every point it was fitted to, and by one more position for model keys between two points.  Allow
+     * one more position for rounding. */
+    const auto &segment = segments[segment_id];
+    const std::size_t lo = segment.offset;
+    const std::size_t hi = segment_id + 1 == segments.size() ? n : segments[segment_id + 1].offset;
+    const double pred = segment(x);
+    const std::size_t pos = pred >= lo ? static_cast<std::size_t>(std::min<double>(pred, hi)) : lo; // NaN yields `lo`
+    return { pos - std::min(pos - lo, epsilon_ + 1), std::min(pos + epsilon_ + 2, hi) };
+}
+
+template<typename Key>
+requires arithmetic<Key> or std::same_as<Key, const char*>
+std::size_t PiecewiseGeometricModelIndex<Key>::model_lower_bound(const model_key_type x) const
+{
+    if (levels_.empty())
+        return 0;
+
+    /*----- Descend the levels to find the last segment of the lowest level whose first key is not greater. -----*/
+    auto key_less = [](const model_key_type x, const Segment &s) { return x < s.key; };
+    std::size_t segment_id = 0; // the segment of the current level
+    for (std::size_t level = levels_.size() - 1; level != 0; --level) {
+        const auto &below = levels_[level - 1];
+        auto [first, last] = search_window(levels_[level], segment_id, below.size(), x);
+        auto it = std::upper_bound(below.begin() + first, below.begin() + last, x, key_less);
+        if ((it != below.begin() and x < (it - 1)->key) or (it != below.end() and not key_less(x, *it)))
+            it = std::upper_bound(below.begin(), below.end(), x, key_less); // not contained in window
+        segment_id = it == below.begin() ? 0 : std::distance(below.begin(), it) - 1;
+    }
+
+    /*----- Search the window predicted by the segment of the lowest level. -----*/
+    auto &data = base_type::data_;
+    auto entry_less = [](const entry_type &e, const model_key_type x) { return model_key(e.first) < x; };
+    auto [first, last] = search_window(levels_.front(), segment_id, data.size(), x);
+    auto it = std::lower_bound(data.begin() + first, data.begin() + last, x, entry_less);
+    if ((it != data.begin() and not entry_less(*(it - 1), x)) or (it != data.end() and entry_less(*it, x)))
+        it = std::lower_bound(data.begin(), data.end(), x, entry_less); // not contained in window
+    return std::distance(data.begin(), it);
+}
+
+void CompositeIndex::bulkload(const Table &table, const Schema &key_schema)
+{
+    /* Check that key schema contains at least one entry and that all key types can be encoded. */
+    if (key_schema.num_entries() == 0)
+        throw invalid_argument("Key schema should contain at least one entry.");
+    for (auto &entry : key_schema) {
+        const bool is_encodable = visit(overloaded {
+            [](const Boolean&) { return true; },
+            [](const Numeric&) { return true; },
+            [](const CharacterSequence&) { return true; },
+            [](const Date&) { return true; },
+            [](const DateTime&) { return true; },
+            [](auto&&) { return false; },
+        }, *entry.type);
+        if (not is_encodable)
+            throw invalid_argument("Key type cannot be encoded.");
+    }
+
+    /* Scan chunks of rows in parallel.  Rows appended meanwhile are not indexed. */
+    const Schema layout_schema = table.schema();
+    const std::size_t num_rows = table.store().num_rows();
+    const std::size_t num_chunks = (num_rows + NUM_ROWS_PER_CHUNK - 1) / NUM_ROWS_PER_CHUNK;
+    std::vector<container_type> chunks(num_chunks);
+    parallel_for(num_chunks, [&](std::size_t chunk) {
+        const std::size_t begin = chunk * NUM_ROWS_PER_CHUNK;
+        const std::size_t end = std::min(begin + NUM_ROWS_PER_CHUNK, num_rows);
+        std::shared_lock<std::shared_mutex> latch(Store::Memory_Latch()); // the store must not move while scanned
+        auto loader = Interpreter::compile_load(key_schema, table.store().memory().addr(), table.layout(),
+                                                layout_schema, begin);
+        Tuple tup(key_schema);
+        Tuple *args[] = { &tup };
+        auto &entries = chunks[chunk];
+        entries.reserve(end - begin);
+        for (std::size_t row_id = begin; row_id != end; ++row_id) {
+            loader(args);
+            key_type key;
+            for (std::size_t i = 0; i != key_schema.num_entries(); ++i) {
+                if (tup.is_null(i))
+                    encode_null(key, *key_schema[i].type);
+                else
+                    encode(key, *key_schema[i].type, tup.get(i));
+            }
+            entries.emplace_back(std::move(key), row_id);
+        }
+    });
+
+    /* Concatenate the entries of all chunks. */
+    std::size_t num_entries = data_.size();
+    for (auto &entries : chunks)
+        num_entries += entries.size();
+    data_.reserve(num_entries);
+    for (auto &entries : chunks)
+        std::move(entries.begin(), entries.end(), std::back_inserter(data_));
+
+    /* Finalize index. */
+    finalize();
+}
+
+void CompositeIndex::finalize()
+{
+    parallel_sort(data_.begin(), data_.end(), [](const entry_type &lhs, const entry_type &rhs) {
+        return lhs.first < rhs.first; // compares bytewise like `memcmp()`
+    });
+    finalized_ = true;
+}
+
+CompositeIndex::const_iterator CompositeIndex::lower_bound(std::string_view prefix) const
+{
+    if (not finalized_) throw m::exception("Index is not finalized.");
+    return std::lower_bound(data_.begin(), data_.end(), prefix, [](const entry_type &e, std::string_view prefix) {
+        return std::string_view(e.first) < prefix;
+    });
+}
+
+CompositeIndex::const_iterator CompositeIndex::upper_bound(std::string_view prefix) const
+{
+    if (not finalized_) throw m::exception("Index is not finalized.");
+    return std::upper_bound(data_.begin(), data_.end(), prefix, [](std::string_view prefix, const entry_type &e) {
+        return std::string_view(e.first).substr(0, prefix.size()) > prefix;
+    });
+}
+
+void CompositeIndex::encode(key_type &key, const Type &type, const Value &value)
+{
+    /* Appends the lowest `num_bytes` bytes of `bits` in big-endian byte order. */
+    auto append = [&key](uint64_t bits, std::size_t num_bytes) {
+        for (std::size_t i = num_bytes; i-- != 0;)
+            key.push_back(char((bits >> (8 * i)) & 0xff));
+    };
+    /* Flips the sign bit of a two's complement integer of `num_bytes` bytes, such that it compares unsigned. */
+    auto append_signed = [&append](int64_t i, std::size_t num_bytes) {
+        append(uint64_t(i) ^ (uint64_t(1) << (8 * num_bytes - 1)), num_bytes);
+    };
+    /* Flips all bits of negative and the sign bit of positive floating-point numbers, such that they compare
+     * unsigned. */
+    auto append_float = [&append]<typename T>(T f) {
+        using bits_type = std::conditional_t<std::same_as<T, float>, uint32_t, uint64_t>;
+        constexpr bits_type sign_bit = bits_type(1) << (8 * sizeof(T) - 1);
+        bits_type bits;
+        std::memcpy(&bits, &f, sizeof(T));
+        append(bits & sign_bit ? bits_type(~bits) : bits_type(bits | sign_bit), sizeof(T));
+    };
+
+    key.push_back(NOT_NULL_BYTE);
+    visit(overloaded {
+        [&](const Boolean&) { append(value.as_b(), 1); },
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int:
+                case Numeric::N_Decimal:
+                    append_signed(value.as_i(), n.size() / 8);
+                    break;
+                case Numeric::N_Float:
+                    if (n.size() == 32)
+                        append_float(value.as_f());
+                    else
+                        append_float(value.as_d());
+                    break;
+            }
+        },
+        [&](const CharacterSequence &cs) {
+            auto str = value.as<const char*>();
+            const std::size_t len = strnlen(str, cs.length);
+            key.append(str, len);
+            key.append(cs.length - len, '\0'); // NUL bytes compare less than all characters, like `strcmp()`
+        },
+        [&](const Date&) { append_signed(value.as_i(), 4); },
+        [&](const DateTime&) { append_signed(value.as_i(), 8); },
+        [](auto&&) { throw invalid_argument("Key type cannot be encoded."); },
+    }, type);
+}
+
+void CompositeIndex::encode_null(key_type &key, const Type &type)
+{
+    const std::size_t num_bytes = visit(overloaded {
+        [](const Boolean&) -> std::size_t { return 1; },
+        [](const Numeric &n) -> std::size_t { return n.size() / 8; },
+        [](const CharacterSequence &cs) -> std::size_t { return cs.length; },
+        [](const Date&) -> std::size_t { return 4; },
+        [](const DateTime&) -> std::size_t { return 8; },
+        [](auto&&) -> std::size_t { throw invalid_argument("Key type cannot be encoded."); },
+    }, type);
+    key.push_back(NULL_BYTE);
+    key.append(num_bytes, '\0'); // fixed width, such that encodings of prefixes remain prefixes
+}
 
 // explicit instantiations to prevent linker errors
 #define INSTANTIATE(CLASS) \
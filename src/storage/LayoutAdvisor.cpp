@@ -0,0 +1,87 @@
+#include <mutable/storage/LayoutAdvisor.hpp>
+
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/CNF.hpp>
+#include <mutable/IR/Operator.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/storage/Store.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** The minimal fraction of point reads among all accesses for an access pattern to be dominated by point reads. */
+constexpr double MIN_POINT_READ_FRACTION = .5;
+/** The minimal fraction of attributes read per access for an access pattern to be *wide*. */
+constexpr double MIN_WIDE_ATTRS_FRACTION = .5;
+
+/** Returns `true` iff \p filter contains a clause that is a single equality predicate between an attribute of \p
+ * table and a constant, i.e. iff \p filter selects rows by point lookup. */
+bool is_point_read(const cnf::CNF &filter, const Table &table)
+{
+    auto is_attribute_of_table = [&table](const ast::Expr &e) {
+        auto designator = cast<const ast::Designator>(&e);
+        if (not designator) return false;
+        auto attr = std::get_if<const Attribute*>(&designator->target());
+        return attr and &(*attr)->table == &table;
+    };
+
+    for (auto &clause : filter) {
+        if (clause.size() != 1) continue;
+        auto &pred = clause[0];
+        if (pred.negative()) continue;
+        auto binary = cast<const ast::BinaryExpr>(&pred.expr());
+        if (not binary or binary->tok.type != TK_EQUAL) continue;
+        if ((is_attribute_of_table(*binary->lhs) and is<const ast::Constant>(*binary->rhs)) or
+            (is_attribute_of_table(*binary->rhs) and is<const ast::Constant>(*binary->lhs)))
+            return true;
+    }
+    return false;
+}
+
+/** Records the accesses of \p op and its descendants.  \p filter is the filter directly above \p op, if any. */
+void record_accesses_recursive(const Operator &op, const cnf::CNF *filter)
+{
+    if (auto scan = cast<const ScanOperator>(&op)) {
+        auto &store = scan->store();
+        const bool point_read = filter and is_point_read(*filter, store.table());
+        store.access_statistics().record(scan->schema().num_entries(), point_read);
+        return;
+    }
+
+    if (auto consumer = cast<const Consumer>(&op)) {
+        auto filter_op = cast<const FilterOperator>(&op);
+        for (auto child : consumer->children())
+            record_accesses_recursive(*child, filter_op ? &filter_op->filter() : nullptr);
+    }
+}
+
+}
+
+
+M_LCOV_EXCL_START
+void AccessStatistics::dump(std::ostream &out) const { out << *this << std::endl; }
+void AccessStatistics::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
+
+void m::storage::record_accesses(const Operator &plan) { record_accesses_recursive(plan, nullptr); }
+
+ThreadSafePooledOptionalString m::storage::advise_layout(const Table &table)
+{
+    Catalog &C = Catalog::Get();
+    auto &stats = table.store().access_statistics();
+    if (stats.num_accesses() == 0)
+        return ThreadSafePooledOptionalString();
+
+    const bool is_point_read_dominated =
+        double(stats.num_point_reads) >= MIN_POINT_READ_FRACTION * stats.num_accesses();
+    const bool is_wide = table.num_attrs() and stats.avg_attrs_read() >= MIN_WIDE_ATTRS_FRACTION * table.num_attrs();
+
+    if (is_point_read_dominated)
+        return C.pool(is_wide ? "Row" : "PAX4K");
+    return C.pool(is_wide ? "PAX4M" : "PAX64M");
+}
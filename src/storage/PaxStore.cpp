@@ -11,8 +11,9 @@
 using namespace m;
 
 
-PaxStore::PaxStore(const Table &table, uint32_t block_size_in_bytes)
+PaxStore::PaxStore(const Table &table, uint32_t block_size_in_bytes, memory::Backing backing)
     : Store(table)
+    , allocator_(backing)
     , offsets_(new uint32_t[table.num_attrs() + 1]) // add one slot for the offset of the meta data
     , block_size_(block_size_in_bytes)
 {
@@ -90,6 +91,13 @@ void PaxStore::compute_block_offsets()
     delete[] attrs;
 }
 
+void PaxStore::grow()
+{
+    exclusive_memory_latch latch; // exclude readers while the memory moves
+    allocator_.grow(data_, 2 * data_.size());
+    capacity_ = (data_.size() / block_size_) * num_rows_per_block_;
+}
+
 M_LCOV_EXCL_START
 void PaxStore::dump(std::ostream &out) const
 {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/memory.hpp>
@@ -10,6 +11,8 @@ namespace m {
 /** This class implements a generic PAX store. */
 struct PaxStore : Store
 {
+    /** The initial size of the memory of the store.  Memory is only backed once written to, hence memory consumption
+     * is proportional to the data.  Whenever the store exceeds its memory, the memory is doubled. */
 #ifndef NDEBUG
     static constexpr std::size_t ALLOCATION_SIZE = 1UL << 30; ///< 1 GiB
 #else
@@ -21,19 +24,24 @@ struct PaxStore : Store
     private:
     memory::LinearAllocator allocator_; ///< the memory allocator
     memory::Memory data_; ///< the underlying memory containing the data
-    std::size_t num_rows_ = 0; ///< the number of rows in use
+    ///> the number of rows in use; written by the single writer of the store with release semantics, such that readers
+    ///> acquiring it observe the memory of the store as grown
+    std::atomic<std::size_t> num_rows_ = 0;
     std::size_t capacity_; ///< the number of available rows
     uint32_t *offsets_; ///< the offsets of each column within a PAX block, in bits
     uint32_t block_size_; ///< the size of a PAX block, in bytes; includes padding
     std::size_t num_rows_per_block_; ///< the number of rows within a PAX block
 
     public:
-    PaxStore(const Table &table, uint32_t block_size_in_bytes = BLOCK_SIZE);
+    PaxStore(const Table &table, uint32_t block_size_in_bytes = BLOCK_SIZE,
+             memory::Backing backing = Default_Backing());
     ~PaxStore();
 
-    virtual std::size_t num_rows() const override { return num_rows_; }
+    virtual std::size_t num_rows() const override { return num_rows_.load(std::memory_order_acquire); }
     std::size_t num_rows_per_block() const { return num_rows_per_block_; }
     uint32_t block_size() const { return block_size_; }
+    /** Returns the number of rows that fit into the current memory of the store. */
+    std::size_t capacity() const { return capacity_; }
 
     uint32_t offset(uint32_t idx) const {
         M_insist(idx <= table().num_attrs(), "index out of range");
@@ -42,14 +50,18 @@ struct PaxStore : Store
     uint32_t offset(const Attribute &attr) const { return offset(attr.id); }
 
     void append() override {
-        if (num_rows_ == capacity_)
-            throw std::logic_error("row store exceeds capacity");
-        ++num_rows_;
+        const std::size_t num_rows = num_rows_.load(std::memory_order_relaxed);
+        if (num_rows == capacity_)
+            grow();
+        num_rows_.store(num_rows + 1, std::memory_order_release);
     }
 
     void drop() override {
-        M_insist(num_rows_);
-        --num_rows_;
+        const std::size_t num_rows = num_rows_.load(std::memory_order_relaxed);
+        M_insist(num_rows);
+        num_rows_.store(num_rows - 1, std::memory_order_release);
+        zone_map().truncate(num_rows - 1);
+        visibility_summary().invalidate(num_rows - 1, num_rows);
     }
 
     /** Returns the memory of the store. */
@@ -63,6 +75,9 @@ struct PaxStore : Store
      * block, and the capacity.  Tries to maximize the number of rows within a PAX block by storing the attributes in
      * descending order of their size, avoiding padding.  */
     void compute_block_offsets();
+
+    /** Doubles the memory of the store.  The store may be moved to a different virtual address range. */
+    void grow();
 };
 
 }
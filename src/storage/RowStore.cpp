@@ -14,8 +14,9 @@
 using namespace m;
 
 
-RowStore::RowStore(const Table &table)
+RowStore::RowStore(const Table &table, memory::Backing backing)
     : Store(table)
+    , allocator_(backing)
     , offsets_(new uint32_t[table.num_attrs() + 1]) // add one slot for the offset of the meta data
 {
     compute_offsets();
@@ -28,6 +29,13 @@ RowStore::~RowStore()
     delete[] offsets_;
 }
 
+void RowStore::grow()
+{
+    exclusive_memory_latch latch; // exclude readers while the memory moves
+    allocator_.grow(data_, 2 * data_.size());
+    capacity_ = data_.size() / (row_size_ / 8);
+}
+
 void RowStore::compute_offsets()
 {
     /* TODO: use `PhysicalSchema` with additional bitmap-type to compute offsets. */
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/memory.hpp>
@@ -10,6 +11,8 @@ namespace m {
 /** This class implements a row store. */
 struct RowStore : Store
 {
+    /** The initial size of the memory of the store.  Memory is only backed once written to, hence memory consumption
+     * is proportional to the data.  Whenever the store exceeds its memory, the memory is doubled. */
 #ifndef NDEBUG
     static constexpr std::size_t ALLOCATION_SIZE = 1UL << 30; ///< 1 GiB
 #else
@@ -19,16 +22,18 @@ struct RowStore : Store
     private:
     memory::LinearAllocator allocator_; ///< the memory allocator
     memory::Memory data_; ///< the underlying memory containing the data
-    std::size_t num_rows_ = 0; ///< the number of rows in use
+    ///> the number of rows in use; written by the single writer of the store with release semantics, such that readers
+    ///> acquiring it observe the memory of the store as grown
+    std::atomic<std::size_t> num_rows_ = 0;
     std::size_t capacity_; ///< the number of available rows
     uint32_t *offsets_; ///< the offsets from the first column, in bits, of all columns
     uint32_t row_size_; ///< the size of a row, in bits; includes NULL bitmap and other meta data
 
     public:
-    RowStore(const Table &table);
+    RowStore(const Table &table, memory::Backing backing = Default_Backing());
     ~RowStore();
 
-    virtual std::size_t num_rows() const override { return num_rows_; }
+    virtual std::size_t num_rows() const override { return num_rows_.load(std::memory_order_acquire); }
 
     int offset(uint32_t idx) const {
         M_insist(idx <= table().num_attrs(), "index out of range");
@@ -38,16 +43,22 @@ struct RowStore : Store
 
     /** Returns the effective size of a row, in bits. */
     std::size_t row_size() const { return row_size_; }
+    /** Returns the number of rows that fit into the current memory of the store. */
+    std::size_t capacity() const { return capacity_; }
 
     void append() override {
-        if (num_rows_ == capacity_)
-            throw std::logic_error("row store exceeds capacity");
-        ++num_rows_;
+        const std::size_t num_rows = num_rows_.load(std::memory_order_relaxed);
+        if (num_rows == capacity_)
+            grow();
+        num_rows_.store(num_rows + 1, std::memory_order_release);
     }
 
     void drop() override {
-        M_insist(num_rows_);
-        --num_rows_;
+        const std::size_t num_rows = num_rows_.load(std::memory_order_relaxed);
+        M_insist(num_rows);
+        num_rows_.store(num_rows - 1, std::memory_order_release);
+        zone_map().truncate(num_rows - 1);
+        visibility_summary().invalidate(num_rows - 1, num_rows);
     }
 
     /** Returns the memory of the store. */
@@ -63,6 +74,9 @@ struct RowStore : Store
      * in descending order of their size, avoiding padding.  */
     void compute_offsets();
 
+    /** Doubles the memory of the store.  The store may be moved to a different virtual address range. */
+    void grow();
+
     /** Return a pointer to the `idx`th row. */
     uintptr_t at(std::size_t idx) const { return data_.as<uintptr_t>() + row_size_/8 * idx; }
 };
@@ -1,6 +1,7 @@
 #include "storage/Store.hpp"
 
 #include <cmath>
+#include <mutable/Options.hpp>
 
 
 using namespace m;
@@ -10,6 +11,56 @@ using namespace m;
  * Store
  *====================================================================================================================*/
 
+memory::Backing Store::Default_Backing()
+{
+    memory::Backing backing;
+    if (Options::Get().explicit_huge_pages)
+        backing.huge_pages = memory::Backing::HP_Explicit;
+    else if (Options::Get().transparent_huge_pages)
+        backing.huge_pages = memory::Backing::HP_Transparent;
+    backing.numa_node = Options::Get().numa_node;
+    return backing;
+}
+
+std::shared_mutex & Store::Memory_Latch()
+{
+    static std::shared_mutex latch;
+    return latch;
+}
+
+thread_local bool Store::exclusive_memory_latch::Held_ = false;
+
+Store::exclusive_memory_latch::~exclusive_memory_latch()
+{
+    if (owns_) {
+        Held_ = false;
+        Memory_Latch().unlock();
+    }
+}
+
+void Store::exclusive_memory_latch::lock()
+{
+    if (Held_) return; // already held by the calling thread
+    Memory_Latch().lock();
+    Held_ = owns_ = true;
+}
+
+thread_local bool Store::shared_memory_latch::Held_ = false;
+
+void Store::shared_memory_latch::lock()
+{
+    if (Held_ or exclusive_memory_latch::Held_) return; // already held by the calling thread
+    Memory_Latch().lock_shared();
+    Held_ = owns_ = true;
+}
+
+void Store::shared_memory_latch::unlock()
+{
+    if (not owns_) return;
+    Held_ = owns_ = false;
+    Memory_Latch().unlock_shared();
+}
+
 M_LCOV_EXCL_START
 void Store::dump() const { dump(std::cerr); }
 M_LCOV_EXCL_STOP
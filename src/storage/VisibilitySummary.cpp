@@ -0,0 +1,98 @@
+#include <mutable/storage/VisibilitySummary.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Returns whether `x op value` holds for the values `x` in `[min, max]`. */
+VisibilitySummary::truth decide_range(int64_t min, int64_t max, ZoneMap::cmp_op op, int64_t value)
+{
+    M_insist(min <= max, "empty range");
+    auto decide = [](bool always, bool never) {
+        return always ? VisibilitySummary::ALWAYS : (never ? VisibilitySummary::NEVER : VisibilitySummary::SOMETIMES);
+    };
+    switch (op) {
+        case ZoneMap::EQ: return decide(min == value and max == value, value < min or value > max);
+        case ZoneMap::LT: return decide(max <  value, min >= value);
+        case ZoneMap::LE: return decide(max <= value, min >  value);
+        case ZoneMap::GT: return decide(min >  value, max <= value);
+        case ZoneMap::GE: return decide(min >= value, max <  value);
+    }
+    M_unreachable("invalid comparison operator");
+}
+
+}
+
+VisibilitySummary::truth VisibilitySummary::entry_type::decide(bool is_ts_begin, ZoneMap::cmp_op op,
+                                                               int64_t value) const
+{
+    return is_ts_begin ? decide_range(min_ts_begin, max_ts_begin, op, value)
+                       : decide_range(min_ts_end, max_ts_end, op, value);
+}
+
+std::optional<VisibilitySummary::entry_type> VisibilitySummary::get(std::size_t block, std::size_t num_rows) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (block >= blocks_.size() or not blocks_[block].is_valid or blocks_[block].num_rows != num_rows)
+        return std::nullopt;
+    return blocks_[block].entry;
+}
+
+uint64_t VisibilitySummary::version(std::size_t block) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return block < blocks_.size() ? blocks_[block].version : 0;
+}
+
+void VisibilitySummary::put(std::size_t block, std::size_t num_rows, uint64_t version, const entry_type &entry)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (blocks_.size() <= block)
+        blocks_.resize(block + 1);
+    auto &b = blocks_[block];
+    if (b.version != version)
+        return; // rows of the block were invalidated while the summary was computed
+    b.entry = entry;
+    b.num_rows = num_rows;
+    b.is_valid = true;
+}
+
+void VisibilitySummary::invalidate(std::size_t begin, std::size_t end)
+{
+    if (begin >= end) return;
+    const std::size_t first_block = begin / NUM_ROWS_PER_BLOCK;
+    const std::size_t last_block = (end - 1) / NUM_ROWS_PER_BLOCK;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    /* Blocks without a summary are versioned as well, such that a concurrently computed summary is discarded. */
+    if (blocks_.size() <= last_block)
+        blocks_.resize(last_block + 1);
+    for (std::size_t block = first_block; block <= last_block; ++block) {
+        blocks_[block].is_valid = false;
+        ++blocks_[block].version;
+    }
+}
+
+void VisibilitySummary::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &b : blocks_) {
+        b.is_valid = false;
+        ++b.version;
+    }
+}
+
+M_LCOV_EXCL_START
+void VisibilitySummary::dump(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto num_valid = std::count_if(blocks_.cbegin(), blocks_.cend(), [](auto &b) { return b.is_valid; });
+    out << "VisibilitySummary with " << num_valid << " valid summaries of " << blocks_.size() << " block(s)"
+        << std::endl;
+}
+
+void VisibilitySummary::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
@@ -0,0 +1,128 @@
+#include <mutable/storage/ZoneMap.hpp>
+
+#include <limits>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/storage/Store.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Returns `false` iff `x op value` is false for every `x` in `[min, max]`.  An empty range, i.e. `min > max`, does not
+ * satisfy any predicate. */
+template<typename T>
+bool may_satisfy_range(T min, T max, ZoneMap::cmp_op op, T value)
+{
+    if (min > max) return false; // no non-NULL values
+    switch (op) {
+        case ZoneMap::EQ: return min <= value and value <= max;
+        case ZoneMap::LT: return min <  value;
+        case ZoneMap::LE: return min <= value;
+        case ZoneMap::GT: return max >  value;
+        case ZoneMap::GE: return max >= value;
+    }
+    M_unreachable("invalid comparison operator");
+}
+
+}
+
+bool ZoneMap::is_floating_point(std::size_t attr_id) const
+{
+    M_insist(is_tracked(attr_id), "attribute is not tracked");
+    return types_[attr_id]->is_double();
+}
+
+void ZoneMap::update(std::size_t row_id, const Tuple &tup)
+{
+    if (not is_complete_.load(std::memory_order_relaxed)) return;
+    const std::size_t num_rows = num_rows_.load(std::memory_order_relaxed);
+    if (row_id != num_rows) {
+        is_complete_.store(false, std::memory_order_release); // rows were not reported in order, give up
+        return;
+    }
+
+    if (num_rows == 0) {
+        /*----- Determine the tracked attributes. -----*/
+        types_.clear();
+        for (auto &attr : table_) {
+            if (types_.size() <= attr.id)
+                types_.resize(attr.id + 1, nullptr);
+            if (attr.type->is_integral() or attr.type->is_date() or attr.type->is_date_time() or attr.type->is_double())
+                types_[attr.id] = attr.type;
+        }
+    }
+
+    if (num_rows % NUM_ROWS_PER_BLOCK == 0) {
+        /*----- Start a new block with empty ranges.  Exclude readers if the entries move. -----*/
+        Store::exclusive_memory_latch latch(std::defer_lock);
+        if (entries_.size() + types_.size() > entries_.capacity())
+            latch.lock();
+        for (auto ty : types_) {
+            entry_type e;
+            if (ty and ty->is_double()) {
+                e.min = std::numeric_limits<double>::infinity();
+                e.max = -std::numeric_limits<double>::infinity();
+            } else {
+                e.min = std::numeric_limits<int64_t>::max();
+                e.max = std::numeric_limits<int64_t>::min();
+            }
+            entries_.push_back(e);
+        }
+    }
+
+    entry_type *block = &entries_[(num_rows / NUM_ROWS_PER_BLOCK) * types_.size()];
+    for (std::size_t id = 0; id != types_.size(); ++id) {
+        if (not types_[id]) continue;
+        auto &e = block[id];
+        if (tup.is_null(id)) {
+            ++e.num_nulls;
+        } else if (types_[id]->is_double()) {
+            const double d = tup[id].as_d();
+            e.min = std::min(e.min.as_d(), d);
+            e.max = std::max(e.max.as_d(), d);
+        } else {
+            const int64_t i = tup[id].as_i();
+            e.min = std::min(e.min.as_i(), i);
+            e.max = std::max(e.max.as_i(), i);
+        }
+    }
+    num_rows_.store(num_rows + 1, std::memory_order_release); // publish the entries of the row
+}
+
+void ZoneMap::clear()
+{
+    entries_.clear();
+    num_rows_.store(0, std::memory_order_release);
+    is_complete_.store(true, std::memory_order_release);
+}
+
+bool ZoneMap::may_satisfy(std::size_t block, std::size_t attr_id, cmp_op op, int64_t value) const
+{
+    M_insist(not is_floating_point(attr_id), "attribute is not tracked as integer");
+    auto &e = get(block, attr_id);
+    return may_satisfy_range(e.min.as_i(), e.max.as_i(), op, value);
+}
+
+bool ZoneMap::may_satisfy(std::size_t block, std::size_t attr_id, cmp_op op, double value) const
+{
+    M_insist(is_floating_point(attr_id), "attribute is not tracked as double");
+    auto &e = get(block, attr_id);
+    return may_satisfy_range(e.min.as_d(), e.max.as_d(), op, value);
+}
+
+M_LCOV_EXCL_START
+void ZoneMap::dump(std::ostream &out) const
+{
+    out << "ZoneMap of table " << table_.name() << " with " << num_rows() << " row(s) in " << num_blocks()
+        << " block(s)";
+    if (not is_complete_.load())
+        out << ", incomplete";
+    out << std::endl;
+}
+
+void ZoneMap::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
@@ -1,6 +1,7 @@
 #include <mutable/util/memory.hpp>
 
 #include <mutable/util/macro.hpp>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstring>
@@ -8,8 +9,11 @@
 #include <stdexcept>
 
 #if __linux
+#include <linux/memfd.h>
+#include <linux/mempolicy.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <unistd.h>
 #elif __APPLE__
@@ -28,11 +32,29 @@ using namespace m::memory;
  * Allocator
  *====================================================================================================================*/
 
-Allocator::Allocator()
+namespace {
+
+/** The number of bits of the node mask passed to `mbind()`, i.e. the number of NUMA nodes supported. */
+constexpr std::size_t MAX_NUMA_NODES = 1024;
+
+}
+
+Allocator::Allocator(Backing backing)
+    : backing_(backing)
 {
+    static std::atomic<uint64_t> next_id(0);
+    id_ = next_id++;
+
+    if (backing_.numa_node >= int(MAX_NUMA_NODES))
+        throw std::invalid_argument("NUMA node out of range");
 #if __linux
-    fd_ = memfd_create("rewire_allocator", MFD_CLOEXEC);
+    unsigned flags = MFD_CLOEXEC;
+    if (backing_.huge_pages == Backing::HP_Explicit)
+        flags |= MFD_HUGETLB | MFD_HUGE_2MB; // must match `HUGE_PAGE_SIZE`
+    fd_ = memfd_create("rewire_allocator", flags);
 #elif __APPLE__
+    if (backing_.huge_pages == Backing::HP_Explicit)
+        throw std::invalid_argument("explicit huge pages are not supported on this platform");
     auto name = std::to_string(getpid());
     fd_ = shm_open(name.c_str(), O_RDWR | O_TRUNC | O_CREAT, S_IRUSR | S_IWUSR);
     shm_unlink(name.c_str());
@@ -44,6 +66,8 @@ Allocator::Allocator()
 
 Allocator::~Allocator()
 {
+    if (auto hook = on_destroy.load())
+        hook(id_);
     close(fd_);
 }
 
@@ -52,6 +76,35 @@ Memory Allocator::create_memory(void *addr, std::size_t size, std::size_t offset
     return Memory(*this, addr, size, offset);
 }
 
+void Allocator::update_memory(Memory &mem, void *addr, std::size_t size)
+{
+    M_insist(&mem.allocator() == this, "memory has not been allocated by this allocator");
+    mem.addr_ = addr;
+    mem.size_ = size;
+}
+
+void Allocator::apply_backing(void *addr, std::size_t size) const
+{
+#if __linux
+    if (backing_.huge_pages == Backing::HP_Transparent and madvise(addr, size, MADV_HUGEPAGE))
+        throw std::runtime_error(strerror(errno));
+    if (backing_.numa_node >= 0) {
+        /* The memory policy of a mapping of the memory file is shared by all mappings of the same range of the file,
+         * hence it also applies to pages faulted in through mappings into other address spaces. */
+        unsigned long nodemask[MAX_NUMA_NODES / (sizeof(unsigned long) * CHAR_BIT)] = { 0 };
+        nodemask[backing_.numa_node / (sizeof(unsigned long) * CHAR_BIT)] |=
+            1UL << (backing_.numa_node % (sizeof(unsigned long) * CHAR_BIT));
+        if (syscall(SYS_mbind, addr, size, MPOL_BIND, nodemask, MAX_NUMA_NODES, /* flags= */ 0))
+            throw std::runtime_error(strerror(errno));
+    }
+#elif __APPLE__
+    /* Nothing to be done.
+     * Neither transparent huge pages nor NUMA memory policies are supported on macOS. */
+    (void) addr;
+    (void) size;
+#endif
+}
+
 
 /*======================================================================================================================
  * AddressSpace
@@ -61,9 +114,24 @@ AddressSpace::AddressSpace(std::size_t size)
 {
     if (size != 0) {
         auto aligned_size = Ceil_To_Next_Page(size);
-        addr_ = mmap(nullptr, aligned_size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, /* fd= */ -1, /* offset= */ 0);
-        if (addr_ == MAP_FAILED)
+
+        /* Reserve an additional huge page to align the beginning of the address space to huge pages. */
+        const std::size_t reserved_size = aligned_size + HUGE_PAGE_SIZE;
+        void *addr = mmap(nullptr, reserved_size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, /* fd= */ -1, /* offset= */ 0);
+        if (addr == MAP_FAILED)
             throw std::runtime_error(strerror(errno));
+
+        /* Release the unaligned head and the excess tail of the reservation. */
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(addr);
+        const uintptr_t aligned_begin = (begin + HUGE_PAGE_SIZE - 1UL) & ~(HUGE_PAGE_SIZE - 1UL);
+        if (aligned_begin != begin)
+            munmap(addr, aligned_begin - begin);
+        const uintptr_t end = begin + reserved_size;
+        const uintptr_t aligned_end = aligned_begin + aligned_size;
+        if (aligned_end != end)
+            munmap(reinterpret_cast<void*>(aligned_end), end - aligned_end);
+
+        addr_ = reinterpret_cast<void*>(aligned_begin);
         size_ = aligned_size;
     }
 }
@@ -84,14 +152,15 @@ Memory::Memory(Allocator &allocator, void *addr, std::size_t size, std::size_t o
 
 void Memory::map(std::size_t size, std::size_t offset_src, const AddressSpace &vm, std::size_t offset_dst) const
 {
+    const std::size_t granularity = allocator().granularity();
     M_insist(size <= this->size(), "size exceeds memory size");
     M_insist(offset_src < this->size(), "source offset out of bounds");
-    M_insist(Is_Page_Aligned(offset_src), "source offset is not page aligned");
+    M_insist(offset_src % granularity == 0, "source offset is not aligned to the granularity of the allocator");
     M_insist(offset_src + size <= this->size(), "source range out of bounds");
 
     M_insist(size <= vm.size(), "size exceeds address space");
     M_insist(offset_dst < vm.size(), "destination offset out of bounds");
-    M_insist(Is_Page_Aligned(offset_dst), "destination offset is not page aligned");
+    M_insist(offset_dst % granularity == 0, "destination offset is not aligned to the granularity of the allocator");
     M_insist(offset_dst + size <= vm.size(), "destination range out of bounds");
 
     void *dst_addr = vm.as<uint8_t*>() + offset_dst;
@@ -101,6 +170,7 @@ void Memory::map(std::size_t size, std::size_t offset_src, const AddressSpace &v
         throw std::runtime_error(strerror(errno));
     if (addr != dst_addr)
         throw std::runtime_error("MAP_FIXED failed");
+    allocator().apply_backing(addr, size);
 }
 
 M_LCOV_EXCL_START
@@ -117,11 +187,17 @@ M_LCOV_EXCL_STOP
  * LinearAllocator
  *====================================================================================================================*/
 
+LinearAllocator::~LinearAllocator()
+{
+    for (auto &R : retired_)
+        munmap(R.addr, R.size);
+}
+
 Memory LinearAllocator::allocate(std::size_t size)
 {
     if (size == 0) return Memory();
 
-    const std::size_t aligned_size = Ceil_To_Next_Page(size);
+    const std::size_t aligned_size = round_up_to_multiple(size, granularity());
     M_insist(aligned_size >= size, "size must be ceiled");
     M_insist(Is_Page_Aligned(aligned_size), "not page aligned");
 #if __linux
@@ -135,6 +211,7 @@ Memory LinearAllocator::allocate(std::size_t size)
     void *addr = mmap(nullptr, aligned_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd(), offset_);
     if (addr == MAP_FAILED)
         throw std::runtime_error(strerror(errno));
+    apply_backing(addr, aligned_size);
 
     auto mem = create_memory(addr, aligned_size, offset_);
     allocations_.push_back(offset_);
@@ -142,6 +219,44 @@ Memory LinearAllocator::allocate(std::size_t size)
     return mem;
 }
 
+void LinearAllocator::grow(Memory &mem, std::size_t size)
+{
+    if (&mem.allocator() != this)
+        throw std::invalid_argument("memory has not been allocated by this allocator");
+    if (allocations_.empty() or allocations_.back() != mem.offset())
+        throw std::invalid_argument("only the most recent allocation can grow");
+
+    const std::size_t aligned_size = round_up_to_multiple(size, granularity());
+    if (aligned_size <= mem.size())
+        return; // nothing to be done
+
+#if __linux
+    if (ftruncate(fd(), mem.offset() + aligned_size))
+        throw std::runtime_error(strerror(errno));
+
+    /* Try to grow the mapping in place. */
+    if (void *addr = mremap(mem.addr(), mem.size(), aligned_size, /* flags= */ 0); addr != MAP_FAILED) {
+        apply_backing(addr, aligned_size);
+        update_memory(mem, addr, aligned_size);
+        offset_ = mem.offset() + aligned_size;
+        return;
+    }
+#elif __APPLE__
+    /* Nothing to be done.
+     * Memory has been preallocated because resizing with `ftruncate()` is not supported on macOS.  */
+#endif
+
+    /* Map the grown allocation to a fresh virtual address range.  The contents are shared through the memory file.
+     * Readers may still access the previous range, hence keep it mapped until the allocation is deallocated. */
+    void *addr = mmap(nullptr, aligned_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd(), mem.offset());
+    if (addr == MAP_FAILED)
+        throw std::runtime_error(strerror(errno));
+    retired_.push_back(retired_mapping{ .offset = mem.offset(), .addr = mem.addr(), .size = mem.size() });
+    apply_backing(addr, aligned_size);
+    update_memory(mem, addr, aligned_size);
+    offset_ = mem.offset() + aligned_size;
+}
+
 namespace {
 
 /** Set MSB of a std::size_t. */
@@ -169,8 +284,13 @@ void LinearAllocator::deallocate(Memory &&mem)
     if (it == allocations_.rend())
         throw std::invalid_argument("memory has not been allocated by this allocator or has already been deallocated");
 
-    /* Unmap the mapped memory. */
+    /* Unmap the mapped memory, including the address ranges it was mapped to before it grew. */
     munmap(mem.addr(), mem.size());
+    std::erase_if(retired_, [&mem](const retired_mapping &R) {
+        if (R.offset != mem.offset()) return false;
+        munmap(R.addr, R.size);
+        return true;
+    });
 
 #if __linux
     *it = mark_for_deallocation(mem.offset());
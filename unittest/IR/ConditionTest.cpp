@@ -0,0 +1,88 @@
+#include "catch2/catch.hpp"
+
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/Condition.hpp>
+
+
+using namespace m;
+
+
+TEST_CASE("Sortedness/equivalences", "[core][ir][condition]")
+{
+    auto &C = Catalog::Get();
+    const Schema::Identifier Ax(C.pool("A"), C.pool("x"));
+    const Schema::Identifier Ay(C.pool("A"), C.pool("y"));
+    const Schema::Identifier Bx(C.pool("B"), C.pool("x"));
+    const Schema::Identifier Cx(C.pool("C"), C.pool("x"));
+
+    /* Result of a sort merge join on `A.x = B.x`, sorted by `A.x` and then `A.y`. */
+    Sortedness::order_t orders;
+    orders.add(Ax, Sortedness::O_ASC);
+    orders.add(Bx, Sortedness::O_ASC);
+    orders.add(Ay, Sortedness::O_DESC);
+    Sortedness joined(std::move(orders));
+    joined.add_equivalence(Ax, Bx);
+
+    SECTION("positions")
+    {
+        CHECK(joined.positions() == std::vector<std::size_t>{ 0, 0, 1 });
+        REQUIRE(joined.find(Bx) != joined.orders().cend());
+        CHECK(joined.find(Bx)->first == Bx);
+        CHECK(joined.find(Cx) == joined.orders().cend());
+    }
+
+    SECTION("implied_by")
+    {
+        Sortedness::order_t on_Bx;
+        on_Bx.add(Bx, Sortedness::O_ASC);
+        CHECK(Sortedness(std::move(on_Bx)).implied_by(joined));
+
+        Sortedness::order_t on_Bx_Ay;
+        on_Bx_Ay.add(Bx, Sortedness::O_ASC);
+        on_Bx_Ay.add(Ay, Sortedness::O_DESC);
+        CHECK(Sortedness(std::move(on_Bx_Ay)).implied_by(joined));
+
+        Sortedness::order_t on_Ay;
+        on_Ay.add(Ay, Sortedness::O_DESC);
+        CHECK_FALSE(Sortedness(std::move(on_Ay)).implied_by(joined));
+
+        /* Joining `C.x = B.x` on top makes `C.x` equivalent to `A.x` as well. */
+        Sortedness transitive(joined);
+        transitive.add_equivalence(Cx, Bx);
+        Sortedness::order_t on_Cx;
+        on_Cx.add(Cx, Sortedness::O_ASC);
+        CHECK(Sortedness(std::move(on_Cx)).implied_by(transitive));
+    }
+
+    SECTION("project_and_rename")
+    {
+        SECTION("keep equivalent attribute")
+        {
+            /* Projecting away `A.x` retains the order on `B.x`. */
+            joined.project_and_rename({ { Bx, Bx }, { Ay, Ay } });
+            CHECK(joined.positions() == std::vector<std::size_t>{ 0, 1 });
+            CHECK(joined.orders().cbegin()->first == Bx);
+            CHECK(std::next(joined.orders().cbegin())->first == Ay);
+        }
+
+        SECTION("retain order")
+        {
+            joined.project_and_rename({ { Ay, Ay }, { Ax, Ax } });
+            REQUIRE(joined.positions() == std::vector<std::size_t>{ 0, 1 });
+            CHECK(joined.orders().cbegin()->first == Ax);
+        }
+
+        SECTION("truncate")
+        {
+            /* Without any of `A.x` and `B.x`, the data is not sorted by `A.y`. */
+            joined.project_and_rename({ { Ay, Ay } });
+            CHECK(joined.orders().empty());
+        }
+
+        SECTION("rename to multiple")
+        {
+            joined.project_and_rename({ { Ax, Ax }, { Ay, Ay }, { Ay, Cx } });
+            CHECK(joined.positions() == std::vector<std::size_t>{ 0, 1, 1 });
+        }
+    }
+}
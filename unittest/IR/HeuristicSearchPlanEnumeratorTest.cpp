@@ -1,5 +1,7 @@
 #include "catch2/catch.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <mutable/catalog/CardinalityEstimator.hpp>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/CostFunctionCout.hpp>
@@ -1007,6 +1009,85 @@ TEST_CASE("AnytimeAStar_general_functionality_and_TopDown_path_completion", "[co
         CHECK(S.num_cached_heuristic_value() == 0);
     }
 
+    SECTION("BottomUp_zero_time_budget_0")
+    {
+        /* Run heuristic search. */
+        using H = heuristics::zero<PlanTable, State, expansions::BottomUpComplete>;
+
+        using SearchAlgorithm = ai::genericAStar<
+            State, expansions::BottomUpComplete, H, config::anytimeAStar,
+            /*----- context -----*/
+            PlanTable&,
+            const QueryGraph&,
+            const AdjacencyMatrix&,
+            const CostFunction&,
+            const CardinalityEstimator&
+        >;
+
+        SearchAlgorithm S(plan_table, G, M, C_out, db.cardinality_estimator());
+
+        ai::SearchConfiguration<config::anytimeAStar> config;
+        config.time_budget = std::chrono::steady_clock::duration::zero();
+
+        bool search_result = heuristic_search<PlanTable,
+                                              search_states::SubproblemsArray,
+                                              expansions::BottomUpComplete,
+                                              SearchAlgorithm,
+                                              heuristics::zero,
+                                              config::anytimeAStar
+                                              >(plan_table, G, M, C_out, db.cardinality_estimator(), S, config);
+
+        /* The time budget is exhausted immediately, hence the same plan as with an expansion budget of 0 is expected. */
+        expected.update(G, db.cardinality_estimator(), C_out, R0, R1, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R0|R1, R3, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R0|R1|R3, R2, condition);
+
+        CHECK(search_result == true);
+        CHECK(expected == plan_table);
+        CHECK(plan_table[All].cost == 15140);
+        CHECK(State::NUM_STATES_EXPANDED() == 0);
+    }
+
+    SECTION("BottomUp_zero_stopped")
+    {
+        /* Run heuristic search. */
+        using H = heuristics::zero<PlanTable, State, expansions::BottomUpComplete>;
+
+        using SearchAlgorithm = ai::genericAStar<
+            State, expansions::BottomUpComplete, H, config::anytimeAStar,
+            /*----- context -----*/
+            PlanTable&,
+            const QueryGraph&,
+            const AdjacencyMatrix&,
+            const CostFunction&,
+            const CardinalityEstimator&
+        >;
+
+        SearchAlgorithm S(plan_table, G, M, C_out, db.cardinality_estimator());
+
+        std::atomic_bool stop(true);
+        ai::SearchConfiguration<config::anytimeAStar> config;
+        config.stop = &stop;
+
+        bool search_result = heuristic_search<PlanTable,
+                                              search_states::SubproblemsArray,
+                                              expansions::BottomUpComplete,
+                                              SearchAlgorithm,
+                                              heuristics::zero,
+                                              config::anytimeAStar
+                                              >(plan_table, G, M, C_out, db.cardinality_estimator(), S, config);
+
+        /* The search is stopped before the first expansion, hence the same plan as with an expansion budget of 0 is expected. */
+        expected.update(G, db.cardinality_estimator(), C_out, R0, R1, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R0|R1, R3, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R0|R1|R3, R2, condition);
+
+        CHECK(search_result == true);
+        CHECK(expected == plan_table);
+        CHECK(plan_table[All].cost == 15140);
+        CHECK(State::NUM_STATES_EXPANDED() == 0);
+    }
+
 
     SECTION("BottomUp_sum_budget_max")
     {
@@ -4552,3 +4633,106 @@ TEST_CASE("AnytimeAStar_OptFields", "[core][IR]")
         CHECK(SM.num_none_to_beam() == 0);
     }
 }
+
+/*======================================================================================================================
+ * Portfolio of concurrent weighted Anytime A* searches
+ *====================================================================================================================*/
+
+TEST_CASE("HeuristicSearch_portfolio", "[core][IR]")
+{
+    using Subproblem = SmallBitset;
+    using PlanTable = PlanTableSmallOrDense;
+
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    /* Create tables. */
+    ThreadSafePooledString col_id = Cat.pool("id");
+    ThreadSafePooledString col_fid = Cat.pool("fid");
+    for (const char *name : { "R0", "R1", "R2", "R3" }) {
+        Table &tbl = db.add_table(Cat.pool(name));
+        tbl.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+        tbl.push_back(col_fid, Type::Get_Integer(Type::TY_Vector, 4));
+        tbl.store(Cat.create_store(tbl));
+        tbl.layout(Cat.data_layout());
+    }
+
+    /* Define query: chain query
+     *
+     * R0 - R1 - R2 - R3
+     *
+     */
+    const std::string query = " SELECT * \
+                                FROM R0, R1, R2, R3 \
+                                WHERE R0.fid = R1.id \
+                                  AND R1.fid = R2.id \
+                                  AND R2.fid = R3.id;";
+
+    Diagnostic diag(false, std::cout, std::cerr);
+    auto stmt = m::statement_from_string(diag, query);
+    REQUIRE(not diag.num_errors());
+    auto query_graph = QueryGraph::Build(*stmt);
+    auto &G = *query_graph.get();
+
+    const Subproblem R0(1);
+    const Subproblem R1(2);
+    const Subproblem R2(4);
+    const Subproblem R3(8);
+    const Subproblem All = Subproblem::All(G.num_sources());
+
+    /* Initialize the `InjectionCardinalityEstimator`. */
+    std::istringstream json_input;
+    json_input.str("{ \"mine\": [ \
+                   {\"relations\": [\"R0\"], \"size\":1500}, \
+                   {\"relations\": [\"R1\"], \"size\":2000}, \
+                   {\"relations\": [\"R2\"], \"size\":1000}, \
+                   {\"relations\": [\"R3\"], \"size\":500}, \
+                   {\"relations\": [\"R0\", \"R1\"], \"size\":40}, \
+                   {\"relations\": [\"R1\", \"R2\"], \"size\":150}, \
+                   {\"relations\": [\"R2\", \"R3\"], \"size\":3200}, \
+                   {\"relations\": [\"R0\", \"R1\", \"R2\"], \"size\":50000}, \
+                   {\"relations\": [\"R1\", \"R2\", \"R3\"], \"size\":700}, \
+                   {\"relations\": [\"R0\", \"R1\", \"R2\", \"R3\"], \"size\":15000} \
+                   ]}");
+    db.cardinality_estimator(std::make_unique<InjectionCardinalityEstimator>(diag, Cat.pool("mine"), json_input));
+
+    PlanTable plan_table(G);
+    init_PT_base_case(G, plan_table, db.cardinality_estimator());
+    CostFunctionCout C_out;
+
+    /* Run four concurrent searches.  With the zero heuristic, every weighting factor yields the optimal plan. */
+    const char *enable[] = { "unittest", "--hs-search", "weighted_anytimeAStar", "--hs-threads", "4", nullptr };
+    Cat.arg_parser().parse_args(5, enable);
+
+    auto &PE = Cat.plan_enumerator(Cat.pool("HeuristicSearch"));
+    for (unsigned repetition = 0; repetition != 8; ++repetition) {
+        PlanTable PT(G);
+        init_PT_base_case(G, PT, db.cardinality_estimator());
+        PE(G, C_out, PT);
+        CHECK(PT[All].cost == 15850);
+        if (repetition == 0)
+            plan_table = std::move(PT);
+    }
+
+    /* Restore the default search configuration. */
+    const char *disable[] = { "unittest", "--hs-search", "AStar", "--hs-threads", "1", nullptr };
+    Cat.arg_parser().parse_args(5, disable);
+
+    /* Check for the optimal plan ((R1 ⋈ R2) ⋈ R3) ⋈ R0. */
+    CHECK((plan_table[All].left == R0 or plan_table[All].right == R0));
+    CHECK(plan_table.has_plan(R1|R2|R3));
+    CHECK(plan_table.has_plan(R1|R2));
+    CHECK(plan_table[plan_table[All].left].cost + plan_table[plan_table[All].right].cost == 850);
+
+    /* The base case of the portfolio's private plan tables must be independent copies of the caller's models. */
+    for (auto &ds : G.sources()) {
+        const Subproblem s = Subproblem::Singleton(ds->id());
+        auto clone = plan_table[s].model->clone();
+        CHECK(clone.get() != plan_table[s].model.get());
+        CHECK(db.cardinality_estimator().predict_cardinality(*clone) ==
+              db.cardinality_estimator().predict_cardinality(*plan_table[s].model));
+    }
+}
@@ -391,3 +391,144 @@ WHERE A.id = C.aid AND A.id = D.aid AND B.id = D.bid AND C.id = D.cid;";
         }
     }
 }
+
+TEST_CASE("PlanEnumerator/PlanTableCompact", "[core][IR]")
+{
+    using Subproblem = SmallBitset;
+
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    Diagnostic diag(false, std::cout, std::cerr);
+    CostFunctionCout C_out;
+    auto &CE = db.cardinality_estimator();
+
+    /* Create tables. */
+    ThreadSafePooledString col_id = Cat.pool("id");
+    const std::size_t num_rows[] = { 5, 10, 8, 12 };
+    const char *names[] = { "A", "B", "C", "D" };
+    for (std::size_t i = 0; i != 4; ++i) {
+        Table &tbl = db.add_table(Cat.pool(names[i]));
+        tbl.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+        tbl.store(Cat.create_store(tbl));
+        tbl.layout(Cat.data_layout());
+        for (std::size_t j = 0; j < num_rows[i]; ++j) { tbl.store().append(); }
+    }
+
+    /* Define query:
+     *
+     *    C
+     *   / \
+     *  A---D---B
+     */
+    const std::string query = "\
+SELECT * \
+FROM A, B, C, D \
+WHERE A.id = C.id AND A.id = D.id AND B.id = D.id AND C.id = D.id;";
+    auto stmt = m::statement_from_string(diag, query);
+    REQUIRE(not diag.num_errors());
+    auto query_graph = QueryGraph::Build(*stmt);
+    auto &G = *query_graph.get();
+
+    /* Keep at most a single `DataModel` of a join materialized to enforce evictions. */
+    PlanTableSmallOrDense expected(G);
+    pe_test::init_PT_base_case(G, expected);
+    PlanTableCompact plan_table(G, /* max_models= */ 1);
+    pe_test::init_PT_base_case(G, plan_table);
+
+    auto &PE = Cat.plan_enumerator(Cat.pool("DPccp"));
+    PE(G, C_out, expected);
+    PE(G, C_out, plan_table);
+    CHECK(plan_table.memory_usage().num_evictions != 0);
+
+    for (uint64_t i = 1; i != 1UL << G.num_sources(); ++i) {
+        const Subproblem S(i);
+        REQUIRE(expected.has_plan(S) == plan_table.has_plan(S));
+        if (not expected.has_plan(S)) continue;
+        CHECK(expected[S] == plan_table[S]);
+        REQUIRE(bool(plan_table[S].model)); // evicted models are materialized on access
+        CHECK(CE.predict_cardinality(*expected[S].model) == CE.predict_cardinality(*plan_table[S].model));
+    }
+    CHECK(plan_table.memory_usage().num_materializations != 0);
+}
+
+namespace {
+
+/** A `CartesianProductEstimator` whose join estimates shrink with the number of clauses of the join condition. */
+struct ConditionalEstimator : CartesianProductEstimator
+{
+    std::unique_ptr<DataModel> estimate_join(const QueryGraph&, const DataModel &left, const DataModel &right,
+                                             const cnf::CNF &condition) const override
+    {
+        const auto &l = as<const CartesianProductDataModel>(left);
+        const auto &r = as<const CartesianProductDataModel>(right);
+        return std::make_unique<CartesianProductDataModel>(l.size * r.size / (condition.size() + 1));
+    }
+};
+
+}
+
+TEST_CASE("PlanEnumerator/PlanTableCompact/materialize", "[core][IR]")
+{
+    using Subproblem = SmallBitset;
+
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    Diagnostic diag(false, std::cout, std::cerr);
+    CostFunctionCout C_out;
+    ConditionalEstimator CE;
+
+    ThreadSafePooledString col_id = Cat.pool("id");
+    const char *names[] = { "A", "B", "C" };
+    for (auto name : names) {
+        Table &tbl = db.add_table(Cat.pool(name));
+        tbl.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+        tbl.store(Cat.create_store(tbl));
+        tbl.layout(Cat.data_layout());
+        for (std::size_t j = 0; j != 10; ++j) { tbl.store().append(); }
+    }
+
+    auto stmt = m::statement_from_string(diag, "SELECT * FROM A, B, C WHERE A.id = B.id AND B.id = C.id;");
+    REQUIRE(not diag.num_errors());
+    auto query_graph = QueryGraph::Build(*stmt);
+    auto &G = *query_graph.get();
+
+    /* Keep at most a single `DataModel` of a join materialized to enforce evictions. */
+    PlanTableCompact plan_table(G, /* max_models= */ 1);
+    for (auto &ds : G.sources()) {
+        const Subproblem s = Subproblem::Singleton(ds->id());
+        plan_table[s].cost = 0;
+        plan_table[s].model = CE.estimate_scan(G, s);
+    }
+
+    /* Join the two sources of the first join by its condition. */
+    REQUIRE(not G.joins().empty());
+    const Join &join = *G.joins().front();
+    REQUIRE(join.sources().size() == 2);
+    REQUIRE(not join.condition().empty());
+    const Subproblem left = Subproblem::Singleton(join.sources()[0].get().id());
+    const Subproblem right = Subproblem::Singleton(join.sources()[1].get().id());
+    const Subproblem other = Subproblem::All(G.num_sources()) - (left|right);
+
+    plan_table.update(G, CE, C_out, left, right, join.condition());
+    REQUIRE(bool(plan_table[left|right].model));
+    const std::size_t expected = CE.predict_cardinality(*plan_table[left|right].model);
+    CHECK(expected == 100 / (join.condition().size() + 1));
+
+    /* Compute two more join models, which exceed `max_models` and evict the first one. */
+    plan_table.update(G, CE, C_out, left, other, cnf::CNF{});
+    plan_table.update(G, CE, C_out, right, other, cnf::CNF{});
+    CHECK(plan_table.memory_usage().num_evictions != 0);
+
+    /* The evicted model is materialized with the join condition and the estimator of its `update()`. */
+    const auto &const_plan_table = plan_table;
+    REQUIRE(bool(const_plan_table[left|right].model));
+    CHECK(CE.predict_cardinality(*const_plan_table[left|right].model) == expected);
+    CHECK(plan_table.memory_usage().num_materializations != 0);
+}
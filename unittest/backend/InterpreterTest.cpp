@@ -3,8 +3,11 @@
 #include "storage/RowStore.hpp"
 #include "storage/ColumnStore.hpp"
 #include "storage/PaxStore.hpp"
+#include <chrono>
+#include <mutable/catalog/Scheduler.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/storage/DataLayoutFactory.hpp>
+#include <thread>
 
 
 using namespace m;
@@ -1107,3 +1110,61 @@ TEST_CASE("PaxStore/access", "[core][backend]")
         REQUIRE(num_tuples == 30);
     }
 }
+
+/*======================================================================================================================
+ * Cancellation.
+ *====================================================================================================================*/
+
+TEST_CASE("Interpreter/cancellation", "[core][backend]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    C.default_backend(C.pool("Interpreter"));
+
+    auto &DB = C.add_database(C.pool("test_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+    table.push_back(C.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+    {
+        StoreWriter W(table.store());
+        Tuple tup(W.schema());
+        for (int64_t id = 0; id != 1000; ++id) {
+            tup.set(0, id);
+            W.append(tup);
+        }
+    }
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    auto &S = C.scheduler(C.pool("SerialScheduler"));
+    auto t = S.begin_transaction();
+    /* The cross join combines 10^9 tuples of which none qualifies, hence it never pushes a block to its parent. */
+    auto stmt = statement_from_string(diag,
+                                      "SELECT COUNT(*) FROM t AS a, t AS b, t AS c WHERE a.id + b.id + c.id < 0;");
+    REQUIRE(diag.num_errors() == 0);
+
+    SECTION("timeout")
+    {
+        set_timeout(*t, std::chrono::milliseconds(1));
+        auto result = S.schedule_command(*t, std::move(stmt), diag);
+        CHECK_FALSE(result.get());
+        CHECK_FALSE(t->is_cancelled());
+    }
+
+    SECTION("cancel from another thread")
+    {
+        auto result = S.schedule_command(*t, std::move(stmt), diag);
+        std::thread canceller([&t]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            cancel(*t);
+        });
+        CHECK_FALSE(result.get());
+        canceller.join();
+        CHECK(t->is_cancelled());
+    }
+
+    CHECK(diag.num_errors() != 0);
+    CHECK(S.abort(std::move(t)));
+}
@@ -747,6 +747,67 @@ TEST_CASE("StackMachine/emit_Cast", "[core][backend]")
     }
 }
 
+/*======================================================================================================================
+ * User-defined functions
+ *====================================================================================================================*/
+
+TEST_CASE("StackMachine/UDF/Call", "[core][backend]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &db = C.add_database(C.pool("mydb"));
+    C.set_database_in_use(db);
+    Table &tbl = db.add_table(C.pool("tbl"));
+    tbl.push_back(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 4));
+    tbl.push_back(C.pool("b"), Type::Get_Double(Type::TY_Vector));
+
+    /* Register a UDF computing `x + w * y`, which is NULL if any argument is NULL. */
+    std::size_t num_calls = 0;
+    auto weighted = [&num_calls](std::size_t num_rows, const Value *const *args, const bool *const *args_are_null,
+                                 Value *results, bool *results_are_null)
+    {
+        ++num_calls;
+        for (std::size_t i = 0; i != num_rows; ++i) {
+            results_are_null[i] = args_are_null[0][i] or args_are_null[1][i] or args_are_null[2][i];
+            if (not results_are_null[i])
+                results[i] = args[0][i].as_d() + args[1][i].as_d() * args[2][i].as_d();
+        }
+    };
+    const PrimitiveType *ty_double = Type::Get_Double(Type::TY_Scalar);
+    std::vector<const PrimitiveType*> parameter_types{ ty_double, ty_double, ty_double };
+    C.register_function(std::make_unique<ScalarUDF>(C.pool("weighted"), std::move(parameter_types), ty_double,
+                                                    weighted));
+
+    Schema schema;
+    schema.add({tbl.name(), C.pool("a")}, tbl[C.pool("a")].type);
+    schema.add({tbl.name(), C.pool("b")}, tbl[C.pool("b")].type);
+
+    Diagnostic diag(true, std::cout, std::cerr);
+    auto stmt = statement_from_string(diag, "SELECT weighted(a, 2, b) FROM tbl;");
+    REQUIRE(diag.num_errors() == 0);
+    auto select = as<SelectStmt>(*stmt).select.get();
+    auto expr = as<SelectClause>(select)->select[0].first.get();
+    REQUIRE(expr->type()->is_double());
+
+    StackMachine eval(schema);
+    eval.emit(*expr, 1);
+    eval.emit_St_Tup(0, 0, expr->type());
+    Tuple in(schema);
+    Tuple out({ expr->type() });
+    Tuple *args[] = { &out, &in };
+
+    in.set(0, int64_t(3));
+    in.set(1, 0.5);
+    eval(args);
+    REQUIRE_FALSE(out.is_null(0));
+    CHECK(out[0].as_d() == 4.);
+
+    in.null(1);
+    eval(args);
+    CHECK(out.is_null(0));
+    CHECK(num_calls == 2);
+}
+
 /*======================================================================================================================
  * Control flow operations
  *====================================================================================================================*/
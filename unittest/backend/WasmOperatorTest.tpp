@@ -1,6 +1,7 @@
 /* vim: set filetype=cpp: */
 #include "backend/WasmOperator.hpp"
 #include "backend/WasmUtil.hpp"
+#include <sys/mman.h>
 
 #ifndef BACKEND_NAME
 #error "must define BACKEND_NAME before including this file"
@@ -479,3 +480,69 @@ TEST_CASE("Wasm/" BACKEND_NAME "/Scan", "[core][wasm]")
     m::WasmEngine::Dispose_Wasm_Context(Module::ID());
     Module::Dispose();
 }
+
+TEST_CASE("Wasm/" BACKEND_NAME "/MappingArena", "[core][wasm]")
+{
+    static const Match<DummyOp> dummy_plan; ///< only needed to create Wasm context without having a physical plan
+    auto &C = Catalog::Get();
+
+    /* Create table. */
+    m::ConcreteTable table(C.pool("arena_table"));
+    table.push_back(C.pool("i64"), m::Type::Get_Integer(m::Type::TY_Vector, 8));
+    table.store(std::make_unique<DummyStore>(table));
+    table.layout(RowLayoutFactory());
+    for (std::size_t i = 0; i != 100; ++i)
+        table.store().append();
+
+    /* Map the table into the arena. */
+    auto &first = m::WasmEngine::Create_Wasm_Context_For_ID(1000, dummy_plan);
+    REQUIRE(first.uses_arena());
+    const auto off = first.map_table(table);
+    const auto heap = first.heap;
+
+    /* A context created while the arena is lent maps the table on its own. */
+    auto &other = m::WasmEngine::Create_Wasm_Context_For_ID(1001, dummy_plan);
+    CHECK_FALSE(other.uses_arena());
+    m::WasmEngine::Dispose_Wasm_Context(other);
+    m::WasmEngine::Dispose_Wasm_Context(first);
+
+    /* The next context reuses the mapping of the table. */
+    auto &second = m::WasmEngine::Create_Wasm_Context_For_ID(1002, dummy_plan);
+    REQUIRE(second.uses_arena());
+    CHECK(second.heap == heap);
+    CHECK(second.map_table(table) == off);
+    CHECK(second.heap == heap);
+    m::WasmEngine::Dispose_Wasm_Context(second);
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/MappingArena/release", "[core][wasm]")
+{
+    static const Match<DummyOp> dummy_plan; ///< only needed to create Wasm context without having a physical plan
+    auto &C = Catalog::Get();
+
+    /* Create table and write to its memory, such that the mapped page is resident. */
+    auto table = std::make_unique<m::ConcreteTable>(C.pool("arena_release_table"));
+    table->push_back(C.pool("i64"), m::Type::Get_Integer(m::Type::TY_Vector, 8));
+    table->store(std::make_unique<DummyStore>(*table));
+    table->layout(RowLayoutFactory());
+    table->store().append();
+    table->store().memory().as<uint8_t*>()[0] = 42;
+
+    /* Map the table into the arena. */
+    auto &first = m::WasmEngine::Create_Wasm_Context_For_ID(1003, dummy_plan);
+    REQUIRE(first.uses_arena());
+    const auto off = first.map_table(*table);
+    CHECK(first.vm.as<uint8_t*>()[off] == 42);
+
+    /* Drop the table while the arena is lent.  Its mapping is released once the arena is returned. */
+    table.reset();
+    CHECK(first.vm.as<uint8_t*>()[off] == 42);
+    m::WasmEngine::Dispose_Wasm_Context(first);
+
+    auto &second = m::WasmEngine::Create_Wasm_Context_For_ID(1004, dummy_plan);
+    REQUIRE(second.uses_arena());
+    unsigned char is_resident;
+    REQUIRE(mincore(second.vm.as<uint8_t*>() + off, get_pagesize(), &is_resident) == 0);
+    CHECK_FALSE(is_resident & 0x1);
+    m::WasmEngine::Dispose_Wasm_Context(second);
+}
@@ -3,9 +3,20 @@
 
 #include "backend/V8Engine.hpp"
 #include "backend/WebAssembly.hpp"
+#include <algorithm>
+#include <map>
+#include <mutable/catalog/AdaptiveCostFunction.hpp>
+#include <mutable/catalog/CardinalityEstimator.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Index.hpp>
 #include <mutable/util/concepts.hpp>
+#include <optional>
+#include <set>
+#include <sstream>
 #include <string>
 #include <v8.h>
+#include <vector>
 
 
 using namespace m::memory;
@@ -147,6 +158,8 @@ struct invoke_v8<PrimitiveExpr<ReturnType, ReturnL>(PrimitiveExpr<ParamTypes, Pa
         Module::Get().emit_function_import<void(void*,uint32_t)>("read_result_set");
         auto func_read_result_set = v8::Function::New(context, read_result_set).ToLocalChecked();
         env->Set(context, mkstr(*isolate_, "read_result_set"), func_read_result_set).Check();
+        auto func_map_table_chunk = v8::Function::New(context, map_table_chunk).ToLocalChecked();
+        env->Set(context, mkstr(*isolate_, "map_table_chunk"), func_map_table_chunk).Check();
         M_DISCARD imports->Set(context, mkstr(*isolate_, "imports"), env);
 
         /* Create a WebAssembly instance object. */
@@ -253,3 +266,629 @@ struct invoke_v8<void(PrimitiveExpr<ParamTypes, ParamLs>...)>
 #include "WasmDSLTest.tpp"
 #include "WasmOperatorTest.tpp"
 #include "WasmUtilTest.tpp"
+
+
+/*======================================================================================================================
+ * Test cases requiring host functions of the V8 embedding
+ *====================================================================================================================*/
+
+TEST_CASE("Wasm/" BACKEND_NAME "/ChunkedScan", "[core][wasm]")
+{
+    Module::Init(); // fresh module
+    static const Match<DummyOp> dummy_plan; ///< only needed to create Wasm context without having a physical plan
+    auto &wasm_context = m::WasmEngine::Create_Wasm_Context_For_ID(Module::ID(), dummy_plan); // create fresh wasm context
+    auto &C = Catalog::Get();
+
+    /* Create table. */
+    m::ConcreteTable table(C.pool("chunked_table"));
+    table.push_back(C.pool("i64"), m::Type::Get_Integer(m::Type::TY_Vector, 8));
+    table.store(std::make_unique<DummyStore>(table));
+
+    /* Create C struct be able to store the data directly into memory. */
+    struct Row
+    {
+        int64_t i64;
+        uint8_t is_null:1;
+        /* 63 bits padding */
+    };
+
+    /* Create data layout. */
+    DataLayout layout;
+    auto &row = layout.add_inode(1, sizeof(Row) * 8);
+    row.add_leaf(table[0].type, 0, 0, 0);
+    row.add_leaf(m::Type::Get_Bitmap(m::Type::TY_Vector, 1), 1, 64, 0);
+    table.layout(std::move(layout));
+
+    /* Store data directly into memory of table through C struct. */
+    constexpr std::size_t num_rows = 1000;
+    Row *row_ptr = table.store().memory().as<Row*>();
+    for (std::size_t idx = 0; idx != num_rows; ++idx, ++row_ptr) {
+        row_ptr->i64 = idx;
+        row_ptr->is_null = 0;
+        table.store().append();
+    }
+
+    /* Shrink the table window to a single page, such that the table is mapped and scanned chunk by chunk. */
+    const std::size_t old_table_window_size = m::WasmEngine::table_window_size;
+    m::WasmEngine::table_window_size = get_pagesize();
+    REQUIRE(m::WasmEngine::Is_Chunked(table));
+
+    /* Create match for the scan operator for the table. */
+    m::ScanOperator scan(table.store(), table.name());
+    m::Match<Scan<false>> M(&scan, {});
+
+    /* Map table into wasm memory and add the mapped address and the window as global variables. */
+    auto off = wasm_context.map_table(table);
+    REQUIRE(wasm_context.table_windows.size() == 1);
+    const std::size_t rows_per_chunk = wasm_context.table_windows.front().rows_per_chunk;
+    CHECK(rows_per_chunk < num_rows); // the table spans several chunks
+    CHECK(num_rows % rows_per_chunk != 0); // the last chunk is partial
+    std::ostringstream oss;
+    oss << table.name() << "_mem";
+    Module::Get().emit_global<void*>(oss.str(), false, off);
+    oss.str("");
+    oss << table.name() << "_window";
+    Module::Get().emit_global<uint32_t>(oss.str(), false, wasm_context.table_window(table));
+    Module::Get().emit_function_import<uint32_t(uint32_t,uint32_t)>("map_table_chunk");
+
+    CodeGenContext::Init(); // create fresh codegen context
+    FUNCTION(scan_code, int64_t(void)) {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for function
+
+        /* Sum up all values and count the scanned rows. */
+        const auto id = table.schema()[0].id;
+        Var<I64x1> sum(0);
+        Var<U32x1> count(0U);
+        Scan<false>::execute(M, setup_t::Make_Without_Parent(), [&]() {
+            sum += CodeGenContext::Get().env().get<_I64x1>(id).insist_not_null();
+            count += 1U;
+        }, teardown_t::Make_Without_Parent());
+        WASM_CHECK(count == uint32_t(num_rows), "number of scanned rows mismatch");
+        RETURN(sum);
+    }
+    CodeGenContext::Dispose(); // dispose codegen context
+
+    CHECK_RESULT(int64_t(num_rows * (num_rows - 1) / 2), scan_code);
+
+    m::WasmEngine::table_window_size = old_table_window_size;
+    m::WasmEngine::Dispose_Wasm_Context(Module::ID());
+    Module::Dispose();
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/IndexScan/Composite", "[core][wasm]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("index_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+    table.push_back(C.pool("a"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    table.push_back(C.pool("f"), m::Type::Get_Float(m::Type::TY_Vector));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    /* Insert all pairs of `a` in [0, 4) and `f` in { 0.0, 0.1, ..., 0.9 } as `float`, and a row with `f` being NULL. */
+    m::StoreWriter W(table.store());
+    m::Tuple tup(W.schema());
+    for (int64_t a = 0; a != 4; ++a) {
+        for (int i = 0; i != 10; ++i) {
+            tup.set(0, a);
+            tup.set(1, float(i) / 10);
+            W.append(tup);
+        }
+    }
+    tup.set(0, int64_t(1));
+    tup.null(1);
+    W.append(tup);
+
+    /* Create the index on `(a, f)`. */
+    const m::Schema S = table.schema();
+    m::Schema key_schema;
+    key_schema.add(S[0]);
+    key_schema.add(S[1]);
+    auto index = std::make_unique<m::idx::CompositeIndex>();
+    index->bulkload(table, key_schema);
+    DB.add_index(std::move(index), table.name(), std::vector<m::ThreadSafePooledString>{ C.pool("a"), C.pool("f") },
+                 C.pool("idx_a_f"));
+
+    /* Scan the table only by index scans and never fall back to a sequential scan. */
+    const auto old_scan_implementations = m::wasm::options::scan_implementations;
+    const auto old_index_scan_max_selectivity = m::wasm::options::index_scan_max_selectivity;
+    m::wasm::options::scan_implementations = m::wasm::option_configs::ScanImplementation::INDEX_SCAN;
+    m::wasm::options::index_scan_max_selectivity = 1.;
+
+    std::ostringstream out, err;
+    m::Diagnostic diag(false, out, err);
+    auto backend = C.create_backend(C.pool("WasmV8"));
+    /* Returns the number of rows of `t` that satisfy `condition`. */
+    auto count = [&](const std::string &condition) {
+        auto stmt = m::statement_from_string(diag, "SELECT a, f FROM t WHERE " + condition + ";");
+        REQUIRE(diag.num_errors() == 0);
+        std::size_t num_rows = 0;
+        auto callback = std::make_unique<m::CallbackOperator>([&](const m::Schema&, const m::Tuple&) { ++num_rows; });
+        m::execute_query(diag, m::as<const m::ast::SelectStmt>(*stmt), std::move(callback), *backend);
+        REQUIRE(diag.num_errors() == 0);
+        return num_rows;
+    };
+
+    SECTION("equality on prefix includes NULL values of the next attribute")
+    {
+        CHECK(count("a = 1") == 11);
+        CHECK(count("a = 2") == 10);
+    }
+
+    SECTION("range excludes NULL values")
+    {
+        CHECK(count("a = 1 AND f < 0.5") == 5);
+        CHECK(count("a = 1 AND f > 0.5") == 4);
+    }
+
+    SECTION("inclusive float bounds are compared as double")
+    {
+        /* `float(0.3)` is greater than 0.3, hence the row of `f = float(0.3)` does not satisfy `f <= 0.3`. */
+        CHECK(count("a = 1 AND f <= 0.3") == 3);
+        CHECK(count("a = 1 AND f >= 0.3") == 7);
+        /* `float(0.2)` is greater than 0.2 as well. */
+        CHECK(count("a = 1 AND f < 0.2") == 2);
+        CHECK(count("a = 1 AND f > 0.2") == 8);
+        /* No `float` equals 0.3 when compared as `double`. */
+        CHECK(count("a = 1 AND f = 0.3") == 0);
+    }
+
+    m::wasm::options::scan_implementations = old_scan_implementations;
+    m::wasm::options::index_scan_max_selectivity = old_index_scan_max_selectivity;
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/IndexScan/Adaptation", "[core][wasm]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("adaptation_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+    table.push_back(C.pool("k"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    table.push_back(C.pool("i"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    /* The `i`-th row has the key `k = 37 * i mod 100`.  Since 37 and 100 are coprime, the keys are a permutation of
+     * [0, 100), hence the order of the index differs from the order of the table. */
+    constexpr int64_t num_rows = 100;
+    m::StoreWriter W(table.store());
+    m::Tuple tup(W.schema());
+    for (int64_t i = 0; i != num_rows; ++i) {
+        tup.set(0, 37 * i % num_rows);
+        tup.set(1, i);
+        W.append(tup);
+    }
+
+    const m::Schema S = table.schema();
+    m::Schema key_schema;
+    key_schema.add(S[0]);
+    auto index = std::make_unique<m::idx::ArrayIndex<int32_t>>();
+    index->bulkload(table, key_schema);
+    DB.add_index(std::move(index), table.name(), C.pool("k"), C.pool("idx_k"));
+
+    /* Scan the table only by index scans on the array index, whose range is interpreted at query compilation. */
+    const auto old_scan_implementations = m::wasm::options::scan_implementations;
+    const auto old_index_implementations = m::wasm::options::index_implementations;
+    const auto old_index_scan_strategy = m::wasm::options::index_scan_strategy;
+    const auto old_index_scan_max_selectivity = m::wasm::options::index_scan_max_selectivity;
+    const auto old_index_scan_sort_tuple_ids = m::wasm::options::index_scan_sort_tuple_ids;
+    m::wasm::options::scan_implementations = m::wasm::option_configs::ScanImplementation::INDEX_SCAN;
+    m::wasm::options::index_implementations = m::wasm::option_configs::IndexImplementation::ARRAY;
+    m::wasm::options::index_scan_strategy = m::wasm::option_configs::IndexScanStrategy::INTERPRETATION;
+
+    std::ostringstream out, err;
+    m::Diagnostic diag(false, out, err);
+    auto backend = C.create_backend(C.pool("WasmV8"));
+    /* Returns the rows `(k, i)` of the result of `query` in the order they are produced. */
+    using result_t = std::vector<std::pair<int64_t, int64_t>>;
+    auto execute = [&](const std::string &query) {
+        auto stmt = m::statement_from_string(diag, query);
+        REQUIRE(diag.num_errors() == 0);
+        result_t rows;
+        auto callback = std::make_unique<m::CallbackOperator>([&](const m::Schema&, const m::Tuple &tup) {
+            rows.emplace_back(tup[0].as_i(), tup[1].as_i());
+        });
+        m::execute_query(diag, m::as<const m::ast::SelectStmt>(*stmt), std::move(callback), *backend);
+        REQUIRE(diag.num_errors() == 0);
+        return rows;
+    };
+    /* Returns the rows with a key less than `bound`, in the order of the index, i.e. sorted by `k`, or in the order of
+     * the table, i.e. sorted by `i`. */
+    auto expected = [&](int64_t bound, bool is_index_order) {
+        result_t rows;
+        for (int64_t i = 0; i != num_rows; ++i) {
+            if (37 * i % num_rows < bound)
+                rows.emplace_back(37 * i % num_rows, i);
+        }
+        if (is_index_order)
+            std::sort(rows.begin(), rows.end());
+        return rows;
+    };
+
+    SECTION("range above the threshold is scanned sequentially")
+    {
+        m::wasm::options::index_scan_sort_tuple_ids = false;
+
+        m::wasm::options::index_scan_max_selectivity = 1.;
+        CHECK(execute("SELECT k, i FROM t WHERE k < 50;") == expected(50, /* is_index_order= */ true));
+
+        /* 50 % of the rows qualify, hence the index scan is replaced and the rows are produced in table order. */
+        m::wasm::options::index_scan_max_selectivity = .1;
+        CHECK(execute("SELECT k, i FROM t WHERE k < 50;") == expected(50, /* is_index_order= */ false));
+        /* 5 % of the rows qualify, hence the index scan is kept. */
+        CHECK(execute("SELECT k, i FROM t WHERE k < 5;") == expected(5, /* is_index_order= */ true));
+    }
+
+    SECTION("sorted tuple IDs")
+    {
+        m::wasm::options::index_scan_max_selectivity = 1.;
+
+        m::wasm::options::index_scan_sort_tuple_ids = true;
+        CHECK(execute("SELECT k, i FROM t WHERE k < 50;") == expected(50, /* is_index_order= */ false));
+
+        m::wasm::options::index_scan_sort_tuple_ids = false;
+        CHECK(execute("SELECT k, i FROM t WHERE k < 50;") == expected(50, /* is_index_order= */ true));
+    }
+
+    SECTION("sortedness is not exploited if the index scan may reorder")
+    {
+        /* The index scan may not produce its rows in index order, hence the optimizer must not omit the sort. */
+        m::wasm::options::index_scan_sort_tuple_ids = false;
+        m::wasm::options::index_scan_max_selectivity = .1;
+        CHECK(execute("SELECT k, i FROM t WHERE k < 50 ORDER BY k;") == expected(50, /* is_index_order= */ true));
+
+        m::wasm::options::index_scan_sort_tuple_ids = true;
+        m::wasm::options::index_scan_max_selectivity = 1.;
+        CHECK(execute("SELECT k, i FROM t WHERE k < 50 ORDER BY k;") == expected(50, /* is_index_order= */ true));
+    }
+
+    m::wasm::options::scan_implementations = old_scan_implementations;
+    m::wasm::options::index_implementations = old_index_implementations;
+    m::wasm::options::index_scan_strategy = old_index_scan_strategy;
+    m::wasm::options::index_scan_max_selectivity = old_index_scan_max_selectivity;
+    m::wasm::options::index_scan_sort_tuple_ids = old_index_scan_sort_tuple_ids;
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/IndexNestedLoopsJoin", "[core][wasm]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("inlj_db"));
+    C.set_database_in_use(DB);
+
+    /* Returns a new table `name` of the nullable 32-bit integer key `k` and the 32-bit integer payload `payload`,
+     * filled with `rows` where `std::nullopt` denotes a NULL key, and indexed on `k` by an array index and an RMI. */
+    using row_t = std::pair<std::optional<int32_t>, int32_t>;
+    auto create_table = [&](const char *name, const char *payload, const std::vector<row_t> &rows) {
+        auto &table = DB.add_table(C.pool(name));
+        table.push_back(C.pool("k"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+        table.push_back(C.pool(payload), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+        table.layout(C.data_layout());
+        table.store(C.create_store(table));
+
+        m::StoreWriter W(table.store());
+        m::Tuple tup(W.schema());
+        for (auto &[k, p] : rows) {
+            if (k)
+                tup.set(0, int64_t(*k));
+            else
+                tup.null(0);
+            tup.set(1, int64_t(p));
+            W.append(tup);
+        }
+
+        const m::Schema S = table.schema();
+        m::Schema key_schema;
+        key_schema.add(S[0]);
+        auto array = std::make_unique<m::idx::ArrayIndex<int32_t>>();
+        array->bulkload(table, key_schema);
+        DB.add_index(std::move(array), table.name(), C.pool("k"), C.pool((std::string(name) + "_array").c_str()));
+        auto rmi = std::make_unique<m::idx::RecursiveModelIndex<int32_t>>();
+        rmi->bulkload(table, key_schema);
+        DB.add_index(std::move(rmi), table.name(), C.pool("k"), C.pool((std::string(name) + "_rmi").c_str()));
+    };
+
+    /* `r` contains each key in [0, 8) twice and two NULL keys, `s` contains each even key in [0, 16) twice and a NULL
+     * key.  Both relations contain duplicate and NULL keys and are indexed, since the index nested-loops join is only
+     * considered if its inner relation, i.e. the scan it probes, is the right child of the join, and the plan
+     * enumerator decides which relation that is. */
+    std::vector<row_t> rows_r, rows_s;
+    for (int32_t v = 0; v != 16; ++v)
+        rows_r.emplace_back(v % 8, v);
+    rows_r.emplace_back(std::nullopt, 16);
+    rows_r.emplace_back(std::nullopt, 17);
+    for (int32_t j = 0; j != 2; ++j) {
+        for (int32_t k = 0; k != 16; k += 2)
+            rows_s.emplace_back(k, 10 * k + j);
+    }
+    rows_s.emplace_back(std::nullopt, 0);
+    create_table("r", "v", rows_r);
+    create_table("s", "w", rows_s);
+
+    /* Returns the expected result of joining `r` and `s` on their keys, restricted to `r.v < s.w` if `residual`. */
+    using result_t = std::multiset<std::pair<int64_t, int64_t>>;
+    auto expected = [&](bool residual) {
+        result_t result;
+        for (auto &[k_r, v] : rows_r) {
+            for (auto &[k_s, w] : rows_s) {
+                if (k_r and k_s and *k_r == *k_s and (not residual or v < w))
+                    result.emplace(v, w);
+            }
+        }
+        return result;
+    };
+
+    /* Join only by index nested-loops joins, such that planning fails if the operator cannot be used. */
+    const auto old_join_implementations = m::wasm::options::join_implementations;
+    const auto old_index_implementations = m::wasm::options::index_implementations;
+    const auto old_batch_size = m::wasm::options::index_sequential_scan_batch_size;
+    m::wasm::options::join_implementations = m::wasm::option_configs::JoinImplementation::INDEX_NESTED_LOOPS;
+
+    std::ostringstream out, err;
+    m::Diagnostic diag(false, out, err);
+    auto backend = C.create_backend(C.pool("WasmV8"));
+    /* Returns the rows of the result of `query` as multiset of pairs of the first and the second attribute. */
+    auto execute = [&](const std::string &query) {
+        auto stmt = m::statement_from_string(diag, query);
+        REQUIRE(diag.num_errors() == 0);
+        result_t rows;
+        auto callback = std::make_unique<m::CallbackOperator>([&](const m::Schema&, const m::Tuple &tup) {
+            rows.emplace(tup[0].as_i(), tup[1].as_i());
+        });
+        m::execute_query(diag, m::as<const m::ast::SelectStmt>(*stmt), std::move(callback), *backend);
+        REQUIRE(diag.num_errors() == 0);
+        return rows;
+    };
+
+    /* Fetch all matching tuple IDs at once with batch size 0, i.e. infinity, and one at a time with batch size 1. */
+    const std::size_t batch_size = GENERATE(0, 1);
+    m::wasm::options::index_sequential_scan_batch_size = batch_size;
+
+    SECTION("array index")
+    {
+        m::wasm::options::index_implementations = m::wasm::option_configs::IndexImplementation::ARRAY;
+        CHECK(execute("SELECT r.v, s.w FROM r, s WHERE r.k = s.k;") == expected(false));
+        CHECK(execute("SELECT r.v, s.w FROM r, s WHERE r.k = s.k AND r.v < s.w;") == expected(true));
+    }
+
+    SECTION("recursive model index")
+    {
+        m::wasm::options::index_implementations = m::wasm::option_configs::IndexImplementation::RMI;
+        CHECK(execute("SELECT r.v, s.w FROM r, s WHERE r.k = s.k;") == expected(false));
+        CHECK(execute("SELECT r.v, s.w FROM r, s WHERE r.k = s.k AND r.v < s.w;") == expected(true));
+    }
+
+    m::wasm::options::join_implementations = old_join_implementations;
+    m::wasm::options::index_implementations = old_index_implementations;
+    m::wasm::options::index_sequential_scan_batch_size = old_batch_size;
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/Feedback/CostFunction", "[core][wasm]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("feedback_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+    table.push_back(C.pool("k"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    table.push_back(C.pool("i"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    constexpr int64_t num_rows = 100;
+    m::StoreWriter W(table.store());
+    m::Tuple tup(W.schema());
+    for (int64_t i = 0; i != num_rows; ++i) {
+        tup.set(0, i % 10);
+        tup.set(1, i);
+        W.append(tup);
+    }
+
+    /* Collect feedback on the executed operators by using the adaptive cost function. */
+    const auto old_cost_function = C.default_cost_function_name();
+    C.default_cost_function(C.pool("AdaptiveCostFunction"));
+    auto &CF = m::as<m::AdaptiveCostFunction>(C.cost_function());
+    CF.clear();
+
+    std::ostringstream out, err;
+    m::Diagnostic diag(false, out, err);
+    auto backend = C.create_backend(C.pool("WasmV8"));
+    /* Returns the number of rows of the result of `query`. */
+    auto execute = [&](const std::string &query) {
+        auto stmt = m::statement_from_string(diag, query);
+        REQUIRE(diag.num_errors() == 0);
+        std::size_t num_results = 0;
+        auto callback = std::make_unique<m::CallbackOperator>([&](const m::Schema&, const m::Tuple&) {
+            ++num_results;
+        });
+        m::execute_query(diag, m::as<const m::ast::SelectStmt>(*stmt), std::move(callback), *backend);
+        REQUIRE(diag.num_errors() == 0);
+        return num_results;
+    };
+
+    SECTION("filter")
+    {
+        CHECK(execute("SELECT k, i FROM t WHERE k < 5;") == 50);
+        CHECK(CF.num_observations() == std::make_tuple(1UL, 0UL, 0UL));
+    }
+
+    SECTION("join")
+    {
+        CHECK(execute("SELECT a.k, b.i FROM t AS a, t AS b WHERE a.i = b.i;") == num_rows);
+        CHECK(CF.num_observations() == std::make_tuple(0UL, 1UL, 0UL));
+    }
+
+    SECTION("grouping")
+    {
+        CHECK(execute("SELECT k, COUNT(*) FROM t GROUP BY k;") == 10);
+        CHECK(CF.num_observations() == std::make_tuple(0UL, 0UL, 1UL));
+    }
+
+    SECTION("no feedback for plans with a limit")
+    {
+        CHECK(execute("SELECT k, i FROM t WHERE k < 5 LIMIT 3;") == 3);
+        CHECK(CF.num_observations() == std::make_tuple(0UL, 0UL, 0UL));
+    }
+
+    CF.clear();
+    C.default_cost_function(old_cost_function);
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/Feedback/Cardinalities", "[core][wasm]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("feedback_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+    table.push_back(C.pool("k"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    table.push_back(C.pool("i"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    constexpr int64_t num_rows = 100;
+    m::StoreWriter W(table.store());
+    m::Tuple tup(W.schema());
+    for (int64_t i = 0; i != num_rows; ++i) {
+        tup.set(0, i % 10);
+        tup.set(1, i);
+        W.append(tup);
+    }
+
+    /* Learn the cardinalities of executed subplans. */
+    DB.cardinality_estimator(std::make_unique<m::FeedbackCardinalityEstimator>(DB.name));
+    auto &CE = m::as<m::FeedbackCardinalityEstimator>(DB.cardinality_estimator());
+
+    std::ostringstream out, err;
+    m::Diagnostic diag(false, out, err);
+    auto backend = C.create_backend(C.pool("WasmV8"));
+    /* Executes `query` and returns its query graph, to look up the learned cardinalities of its subproblems.  The
+     * statements are kept alive as long as their query graphs. */
+    std::vector<std::unique_ptr<m::ast::Stmt>> stmts;
+    auto execute = [&](const std::string &query) {
+        auto &stmt = stmts.emplace_back(m::statement_from_string(diag, query));
+        REQUIRE(diag.num_errors() == 0);
+        auto G = m::QueryGraph::Build(*stmt);
+        m::execute_query(diag, m::as<const m::ast::SelectStmt>(*stmt),
+                         std::make_unique<m::CallbackOperator>([](const m::Schema&, const m::Tuple&) { }), *backend);
+        REQUIRE(diag.num_errors() == 0);
+        return G;
+    };
+
+    SECTION("filter")
+    {
+        auto G = execute("SELECT k, i FROM t WHERE k < 5;");
+        CHECK(CE.num_observations() == 1);
+        CHECK(CE.lookup(*G, m::SmallBitset::Singleton(0)) == 50);
+    }
+
+    SECTION("join")
+    {
+        auto G = execute("SELECT a.k, b.i FROM t AS a, t AS b WHERE a.i = b.i AND a.k < 5;");
+        CHECK(CE.num_observations() == 3);
+        CHECK(CE.lookup(*G, m::SmallBitset::Singleton(0)) == 50);
+        CHECK(CE.lookup(*G, m::SmallBitset::Singleton(1)) == num_rows);
+        CHECK(CE.lookup(*G, m::SmallBitset(0b11)) == 50);
+    }
+
+    SECTION("no feedback for plans with a limit")
+    {
+        execute("SELECT k, i FROM t WHERE k < 5 LIMIT 3;");
+        CHECK(CE.num_observations() == 0);
+    }
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/SIMD/SelectionVectors", "[core][wasm]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("simd_db"));
+    C.set_database_in_use(DB);
+
+    /* Returns a new table `name` of the non-nullable 32-bit integer attributes `attributes`, stored in a PAX layout
+     * that supports SIMD. */
+    auto create_table = [&](const char *name, std::initializer_list<const char*> attributes) -> m::Table & {
+        auto &table = DB.add_table(C.pool(name));
+        for (auto attr : attributes) {
+            table.push_back(C.pool(attr), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+            table.at(C.pool(attr)).not_nullable = true;
+        }
+        table.layout(m::storage::PAXLayoutFactory(m::storage::PAXLayoutFactory::NTuples, 16));
+        table.store(C.create_store(table));
+        return table;
+    };
+
+    /* Insert `a` in [0, 256) and `b = a % 8` into `r`, and the even values in [0, 16) into `s`.  The number of rows of
+     * `r` is a whole multiple of the number of SIMD lanes, such that `r` can be scanned SIMDfied. */
+    auto &R = create_table("r", { "a", "b" });
+    {
+        m::StoreWriter W(R.store());
+        m::Tuple tup(W.schema());
+        for (int64_t a = 0; a != 256; ++a) {
+            tup.set(0, a);
+            tup.set(1, a % 8);
+            W.append(tup);
+        }
+    }
+    auto &S = create_table("s", { "k" });
+    {
+        m::StoreWriter W(S.store());
+        m::Tuple tup(W.schema());
+        for (int64_t k = 0; k != 16; k += 2) {
+            tup.set(0, k);
+            W.append(tup);
+        }
+    }
+
+    /* Filter `r` predicated, such that a SIMDfied scan of `r` produces a selection vector. */
+    const auto old_filter_selection_strategy = m::wasm::options::filter_selection_strategy;
+    const auto old_grouping_implementations = m::wasm::options::grouping_implementations;
+    const auto old_join_implementations = m::wasm::options::join_implementations;
+    const auto old_simd_selection_vectors = m::wasm::options::simd_selection_vectors;
+    m::wasm::options::filter_selection_strategy = m::wasm::option_configs::SelectionStrategy::PREDICATED;
+    m::wasm::options::grouping_implementations = m::wasm::option_configs::GroupingImplementation::HASH_BASED;
+    m::wasm::options::join_implementations = m::wasm::option_configs::JoinImplementation::SIMPLE_HASH;
+
+    std::ostringstream out, err;
+    m::Diagnostic diag(false, out, err);
+    auto backend = C.create_backend(C.pool("WasmV8"));
+    /* Returns the rows of the result of `query` as map from the first to the second attribute. */
+    auto execute = [&](const std::string &query) {
+        auto stmt = m::statement_from_string(diag, query);
+        REQUIRE(diag.num_errors() == 0);
+        std::map<int64_t, int64_t> rows;
+        auto callback = std::make_unique<m::CallbackOperator>([&](const m::Schema&, const m::Tuple &tup) {
+            rows.emplace(tup[0].as_i(), tup[1].as_i());
+        });
+        m::execute_query(diag, m::as<const m::ast::SelectStmt>(*stmt), std::move(callback), *backend);
+        REQUIRE(diag.num_errors() == 0);
+        return rows;
+    };
+
+    /* Run each query once consuming the selection vector lane-wise and once with scalar child pipelines. */
+    const bool simd_selection_vectors = GENERATE(true, false);
+    m::wasm::options::simd_selection_vectors = simd_selection_vectors;
+
+    SECTION("hash-based grouping")
+    {
+        /* Of the rows with `a < 100`, the groups of `b` in [0, 4) contain 13 rows, the others 12 rows. */
+        const std::map<int64_t, int64_t> expected{ { 0, 13 }, { 1, 13 }, { 2, 13 }, { 3, 13 },
+                                                   { 4, 12 }, { 5, 12 }, { 6, 12 }, { 7, 12 } };
+        CHECK(execute("SELECT b, COUNT(*) FROM r WHERE a < 100 GROUP BY b;") == expected);
+    }
+
+    SECTION("hash join probe")
+    {
+        /* Of the rows with `a < 100`, only those with an even `b` find a join partner. */
+        const std::map<int64_t, int64_t> expected{ { 0, 13 }, { 2, 13 }, { 4, 12 }, { 6, 12 } };
+        CHECK(execute("SELECT r.b, COUNT(*) FROM r, s WHERE r.b = s.k AND r.a < 100 GROUP BY r.b;") == expected);
+    }
+
+    m::wasm::options::filter_selection_strategy = old_filter_selection_strategy;
+    m::wasm::options::grouping_implementations = old_grouping_implementations;
+    m::wasm::options::join_implementations = old_join_implementations;
+    m::wasm::options::simd_selection_vectors = old_simd_selection_vectors;
+}
@@ -0,0 +1,80 @@
+#include "catch2/catch.hpp"
+
+#include <chrono>
+#include <mutable/catalog/AdaptiveCostFunction.hpp>
+
+
+using namespace m;
+using namespace std::chrono;
+
+
+TEST_CASE("AdaptiveCostFunction/no model without observations", "[core][catalog][costfunction]")
+{
+    AdaptiveCostFunction CF;
+    CHECK_FALSE(CF.predict_filter(100, .5).has_value());
+    CHECK_FALSE(CF.predict_join(100, 100, 100).has_value());
+    CHECK_FALSE(CF.predict_grouping(100, 10).has_value());
+    CHECK_FALSE(CF.has_all_models());
+}
+
+TEST_CASE("AdaptiveCostFunction/refit", "[core][catalog][costfunction]")
+{
+    AdaptiveCostFunction CF(/* window_size= */ 64, /* refit_interval= */ 8);
+
+    /* Runtime in ms is 1 + 0.01 * |in| + 2 * selectivity. */
+    auto runtime = [](double in, double selectivity) {
+        return duration_cast<Timer::duration>(duration<double, std::milli>(1. + .01 * in + 2. * selectivity));
+    };
+
+    SECTION("too few observations")
+    {
+        for (std::size_t i = 1; i != 8; ++i)
+            CF.observe_filter(i * 100, i * 10, runtime(i * 100, .1));
+        CHECK_FALSE(CF.predict_filter(1000, .5).has_value());
+    }
+
+    SECTION("linearly dependent features")
+    {
+        /* All observations have the same selectivity, hence the model is not uniquely determined. */
+        for (std::size_t i = 1; i <= 8; ++i)
+            CF.observe_filter(i * 100, i * 10, runtime(i * 100, .1));
+        CHECK_FALSE(CF.predict_filter(1000, .5).has_value());
+    }
+
+    SECTION("fit")
+    {
+        for (std::size_t i = 1; i <= 8; ++i) {
+            const std::size_t out = (i * 100) * (i % 4) / 4;
+            CF.observe_filter(i * 100, out, runtime(i * 100, double(out) / (i * 100)));
+        }
+        auto prediction = CF.predict_filter(1000, .5);
+        REQUIRE(prediction.has_value());
+        CHECK(*prediction == Approx(1. + .01 * 1000 + 2. * .5).epsilon(1e-3));
+        CHECK_FALSE(CF.has_all_models()); // costs are still computed like C_out, in the same unit for all operators
+    }
+
+    SECTION("all models")
+    {
+        for (std::size_t i = 1; i <= 8; ++i) {
+            const std::size_t out = (i * 100) * (i % 4) / 4;
+            CF.observe_filter(i * 100, out, runtime(i * 100, double(out) / (i * 100)));
+            CF.observe_join(i * 100, (i % 3 + 1) * 50, (i % 4 + 1) * 10, milliseconds(i));
+            CF.observe_grouping(i * 100, i % 5 + 1, milliseconds(i));
+        }
+        CHECK(CF.predict_join(100, 100, 100).has_value());
+        CHECK(CF.predict_grouping(100, 10).has_value());
+        CHECK(CF.has_all_models());
+    }
+
+    SECTION("window")
+    {
+        CF.window_size(16);
+        for (std::size_t i = 1; i <= 32; ++i)
+            CF.observe_grouping(i * 100, i % 5 + 1, milliseconds(i));
+        CHECK(std::get<2>(CF.num_observations()) == 16);
+
+        CF.clear();
+        CHECK(std::get<2>(CF.num_observations()) == 0);
+        CHECK_FALSE(CF.predict_grouping(100, 10).has_value());
+    }
+}
@@ -3,6 +3,7 @@
 #include "parse/Parser.hpp"
 #include "parse/Sema.hpp"
 #include <cstring>
+#include <limits>
 #include <mutable/catalog/CardinalityEstimator.hpp>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/mutable.hpp>
@@ -267,3 +268,145 @@ TEST_CASE("Cartesian estimator estimates", "[core][catalog][cardinality]")
         CHECK(CE.predict_cardinality(*join_model) == 50);
     }
 }
+
+TEST_CASE("Feedback estimator estimates", "[core][catalog][cardinality]")
+{
+    using Subproblem = SmallBitset;
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create pooled strings. */
+    ThreadSafePooledString str_A = Cat.pool("A");
+    ThreadSafePooledString str_B = Cat.pool("B");
+    ThreadSafePooledString str_C = Cat.pool("C");
+
+    ThreadSafePooledString col_id  = Cat.pool("id");
+    ThreadSafePooledString col_aid = Cat.pool("aid");
+
+    /* Create tables. */
+    Table &tbl_A = db.add_table(str_A);
+    Table &tbl_B = db.add_table(str_B);
+    Table &tbl_C = db.add_table(str_C);
+
+    /* Add columns to tables. */
+    tbl_A.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(col_aid, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_C.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_C.push_back(col_aid, Type::Get_Integer(Type::TY_Vector, 4));
+
+    /* Add data to tables. */
+    std::size_t num_rows_A = 5;
+    std::size_t num_rows_B = 10;
+    std::size_t num_rows_C = 8;
+    tbl_A.store(Cat.create_store(tbl_A));
+    tbl_B.store(Cat.create_store(tbl_B));
+    tbl_C.store(Cat.create_store(tbl_C));
+    tbl_A.layout(Cat.data_layout());
+    tbl_B.layout(Cat.data_layout());
+    tbl_C.layout(Cat.data_layout());
+    for (std::size_t i = 0; i < num_rows_A; ++i) { tbl_A.store().append(); }
+    for (std::size_t i = 0; i < num_rows_B; ++i) { tbl_B.store().append(); }
+    for (std::size_t i = 0; i < num_rows_C; ++i) { tbl_C.store().append(); }
+
+    /* Define query:
+     *
+     * A -- B -- C
+     */
+    const char *query = "SELECT * \
+                         FROM A, B, C \
+                         WHERE A.id = C.aid AND A.id = B.aid;";
+    auto S = m::statement_from_string(diag, query);
+    M_insist(diag.num_errors() == 0);
+    auto G = QueryGraph::Build(*S);
+    std::istringstream json_input;
+    json_input.str("{ \"mine\": [ \
+                   {\"relations\": [\"A\"], \"size\":2}, \
+                   {\"relations\": [\"B\", \"A\"], \"size\":7} \
+                   ]}");
+    FeedbackCardinalityEstimator FCE(diag, Cat.pool("mine"), json_input, std::make_unique<CartesianProductEstimator>());
+    REQUIRE(FCE.num_observations() == 2);
+    cnf::CNF condition;
+
+    SECTION("estimate_scan")
+    {
+        auto observed_model = FCE.estimate_scan(*G, Subproblem::Singleton(0));
+        CHECK(FCE.predict_cardinality(*observed_model) == 2);
+        auto fallback_model = FCE.estimate_scan(*G, Subproblem::Singleton(2));
+        CHECK(FCE.predict_cardinality(*fallback_model) == 8);
+    }
+
+    SECTION("estimate_join")
+    {
+        auto model_A = FCE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto model_B = FCE.estimate_scan(*G, Subproblem::Singleton(1));
+        auto model_C = FCE.estimate_scan(*G, Subproblem::Singleton(2));
+        auto observed_join = FCE.estimate_join(*G, *model_A, *model_B, condition);
+        CHECK(FCE.predict_cardinality(*observed_join) == 7);
+        /* Fall back to the Cartesian product of the observed cardinality of A and the cardinality of C. */
+        auto fallback_join = FCE.estimate_join(*G, *model_A, *model_C, condition);
+        CHECK(FCE.predict_cardinality(*fallback_join) == 16);
+    }
+
+    SECTION("observe")
+    {
+        FCE.observe({ str_C, str_A }, 3);
+        FCE.observe({ str_A }, 4); // replaces previous observation
+        CHECK(FCE.num_observations() == 3);
+
+        auto model_A = FCE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto model_C = FCE.estimate_scan(*G, Subproblem::Singleton(2));
+        CHECK(FCE.predict_cardinality(*model_A) == 4);
+        auto join = FCE.estimate_join(*G, *model_C, *model_A, condition);
+        CHECK(FCE.predict_cardinality(*join) == 3);
+    }
+
+    SECTION("saturate")
+    {
+        constexpr std::size_t MAX = std::numeric_limits<std::size_t>::max();
+        FCE.observe({ str_A }, MAX / 2);
+        auto model_A = FCE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto model_B = FCE.estimate_scan(*G, Subproblem::Singleton(1));
+        auto model_C = FCE.estimate_scan(*G, Subproblem::Singleton(2));
+        /* The product of the observed cardinality of A and the cardinality of C exceeds the range of `std::size_t`. */
+        auto join = FCE.estimate_join(*G, *model_A, *model_C, condition);
+        CHECK(FCE.predict_cardinality(*join) == MAX);
+        auto observed_join = FCE.estimate_join(*G, *model_A, *model_B, condition);
+        CHECK(FCE.predict_cardinality(*observed_join) == 7);
+    }
+
+    SECTION("write and read JSON")
+    {
+        FCE.observe({ str_A, str_B, str_C }, 1);
+        std::stringstream json_output;
+        FCE.write_json(json_output);
+        FeedbackCardinalityEstimator restored(diag, Cat.pool("mine"), json_output,
+                                              std::make_unique<CartesianProductEstimator>());
+        CHECK(restored.num_observations() == 3);
+        auto model_A = restored.estimate_scan(*G, Subproblem::Singleton(0));
+        auto model_B = restored.estimate_scan(*G, Subproblem::Singleton(1));
+        auto model_C = restored.estimate_scan(*G, Subproblem::Singleton(2));
+        auto model_AB = restored.estimate_join(*G, *model_A, *model_B, condition);
+        auto model_ABC = restored.estimate_join(*G, *model_AB, *model_C, condition);
+        CHECK(restored.predict_cardinality(*model_ABC) == 1);
+    }
+
+    SECTION("wrong database, fall back")
+    {
+        std::istringstream json_input_wrong_db;
+        json_input_wrong_db.str("{ \"mine\": [{\"relations\": [\"A\", \"B\"], \"size\":1000}]}");
+        FeedbackCardinalityEstimator fce_wrong_db(diag, Cat.pool("yours"), json_input_wrong_db,
+                                                  std::make_unique<CartesianProductEstimator>());
+        CHECK(fce_wrong_db.num_observations() == 0);
+        auto model_A = fce_wrong_db.estimate_scan(*G, Subproblem::Singleton(0));
+        auto model_B = fce_wrong_db.estimate_scan(*G, Subproblem::Singleton(1));
+        auto join = fce_wrong_db.estimate_join(*G, *model_A, *model_B, condition);
+        CHECK(fce_wrong_db.predict_cardinality(*join) == 50);
+    }
+}
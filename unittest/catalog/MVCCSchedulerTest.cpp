@@ -0,0 +1,260 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "catalog/MVCCScheduler.hpp"
+#include "parse/Parser.hpp"
+#include "storage/RowStore.hpp"
+#include <algorithm>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/mutable.hpp>
+#include <sstream>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Creates a database with the multi-versioned table `t` of a single attribute `id` and uses that database. */
+Table & create_table()
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    ConcreteTableFactoryDecorator<MultiVersioningTable> factory(std::make_unique<ConcreteTableFactory>());
+    auto &table = DB.add(factory.make(C.pool("t")));
+    table.push_back(C.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+    return table;
+}
+
+/** Returns the `MVCCScheduler`, which collects garbage only when requested explicitly, such that tests may inspect
+ * stores without synchronization. */
+MVCCScheduler & get_scheduler()
+{
+    Catalog &C = Catalog::Get();
+    auto &S = as<MVCCScheduler>(C.scheduler(C.pool("MVCCScheduler")));
+    S.background_gc(false);
+    return S;
+}
+
+/** Executes the statement \p sql within the transaction \p t.  Returns `true` iff the statement was executed. */
+bool execute(Scheduler &S, Scheduler::Transaction &t, const char *sql)
+{
+    Catalog &C = Catalog::Get();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    std::istringstream in(sql);
+    ast::Lexer lexer(diag, C.get_pool(), "-", in);
+    ast::Parser parser(lexer);
+    return S.schedule_command(t, parser.parse(), diag).get();
+}
+
+/** Returns the sorted IDs of all rows of \p table that are visible to the transaction \p t. */
+std::vector<int32_t> visible_ids(const Table &table, const Scheduler::Transaction &t)
+{
+    Catalog &C = Catalog::Get();
+    const Schema S = table.schema();
+    const std::size_t idx_ts_begin = S[{ table.name(), C.pool("$ts_begin") }].first;
+    const std::size_t idx_ts_end = S[{ table.name(), C.pool("$ts_end") }].first;
+    const std::size_t idx_id = S[{ table.name(), C.pool("id") }].first;
+
+    std::vector<int32_t> ids;
+    if (table.store().num_rows() == 0)
+        return ids;
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t i = 0; i != table.store().num_rows(); ++i) {
+        loader(args);
+        if (t.sees(tup[idx_ts_begin].as_i(), tup[idx_ts_end].as_i()))
+            ids.push_back(tup[idx_id].as_i());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+}
+
+
+TEST_CASE("MVCCScheduler/snapshots", "[core][catalog][scheduler]")
+{
+    auto &table = create_table();
+    Catalog &C = Catalog::Get();
+    auto &S = get_scheduler();
+
+    auto t1 = S.begin_transaction();
+    REQUIRE(execute(S, *t1, "INSERT INTO t VALUES (1), (2);"));
+    auto t2 = S.begin_transaction();
+    REQUIRE(execute(S, *t2, ";")); // start the transaction
+
+    /*----- Uncommitted inserts are only visible to the inserting transaction. -----*/
+    CHECK(visible_ids(table, *t1) == std::vector<int32_t>{ 1, 2 });
+    CHECK(visible_ids(table, *t2).empty());
+
+    SECTION("commit")
+    {
+        CHECK(S.commit(std::move(t1)));
+        CHECK(visible_ids(table, *t2).empty()); // the snapshot of `t2` precedes the commit
+
+        auto t3 = S.begin_transaction();
+        REQUIRE(execute(S, *t3, ";"));
+        CHECK(visible_ids(table, *t3) == std::vector<int32_t>{ 1, 2 });
+        CHECK(S.commit(std::move(t3)));
+    }
+
+    SECTION("abort")
+    {
+        CHECK(S.abort(std::move(t1)));
+        for (std::size_t row_id = 0; row_id != table.store().num_rows(); ++row_id) {
+            CHECK(read_timestamp(table, C.pool("$ts_begin"), row_id) == 0);
+            CHECK(read_timestamp(table, C.pool("$ts_end"), row_id) == 0);
+        }
+
+        auto t3 = S.begin_transaction();
+        REQUIRE(execute(S, *t3, ";"));
+        CHECK(visible_ids(table, *t3).empty());
+        CHECK(S.commit(std::move(t3)));
+    }
+
+    CHECK(S.commit(std::move(t2)));
+}
+
+TEST_CASE("MVCCScheduler/first-committer-wins", "[core][catalog][scheduler]")
+{
+    auto &table = create_table();
+    auto &S = get_scheduler();
+
+    auto t0 = S.begin_transaction();
+    REQUIRE(execute(S, *t0, "INSERT INTO t VALUES (1), (2), (3);"));
+    REQUIRE(S.commit(std::move(t0)));
+
+    auto t1 = S.begin_transaction();
+    auto t2 = S.begin_transaction();
+    REQUIRE(execute(S, *t1, ";")); // start the transactions
+    REQUIRE(execute(S, *t2, ";"));
+    std::vector<int32_t> expected; // the IDs visible after both transactions are closed
+
+    SECTION("conflicting deletes")
+    {
+        REQUIRE(execute(S, *t1, "DELETE FROM t WHERE id = 2;"));
+        REQUIRE(execute(S, *t2, "DELETE FROM t WHERE id = 2;"));
+        CHECK(visible_ids(table, *t1) == std::vector<int32_t>{ 1, 3 });
+
+        CHECK(S.commit(std::move(t1)));
+        CHECK_FALSE(S.commit(std::move(t2))); // `t2` conflicts with `t1`, which committed first
+        expected = { 1, 3 };
+    }
+
+    SECTION("disjoint deletes")
+    {
+        REQUIRE(execute(S, *t1, "DELETE FROM t WHERE id = 1;"));
+        REQUIRE(execute(S, *t2, "DELETE FROM t WHERE id = 3;"));
+        CHECK(visible_ids(table, *t1) == std::vector<int32_t>{ 2, 3 });
+        CHECK(visible_ids(table, *t2) == std::vector<int32_t>{ 1, 2 });
+
+        CHECK(S.commit(std::move(t1)));
+        CHECK(S.commit(std::move(t2)));
+        expected = { 2 };
+    }
+
+    SECTION("aborted delete")
+    {
+        REQUIRE(execute(S, *t1, "DELETE FROM t WHERE id = 2;"));
+        REQUIRE(execute(S, *t2, "DELETE FROM t WHERE id = 2;"));
+        CHECK(S.abort(std::move(t1)));
+        CHECK(S.commit(std::move(t2))); // `t1` did not commit, hence there is no conflict
+        expected = { 1, 3 };
+    }
+
+    auto t3 = S.begin_transaction();
+    REQUIRE(execute(S, *t3, ";"));
+    CHECK(visible_ids(table, *t3) == expected);
+    CHECK(S.commit(std::move(t3)));
+}
+
+TEST_CASE("MVCCScheduler/garbage collection", "[core][catalog][scheduler]")
+{
+    auto &table = create_table();
+    auto &S = get_scheduler();
+
+    auto t0 = S.begin_transaction();
+    REQUIRE(execute(S, *t0, "INSERT INTO t VALUES (1), (2), (3);"));
+    REQUIRE(S.commit(std::move(t0)));
+    std::vector<int32_t> expected; // the IDs visible after garbage was collected
+
+    SECTION("deleted versions")
+    {
+        auto t1 = S.begin_transaction();
+        REQUIRE(execute(S, *t1, ";")); // start the transaction before the delete commits
+        auto t2 = S.begin_transaction();
+        REQUIRE(execute(S, *t2, "DELETE FROM t WHERE id = 2;"));
+        REQUIRE(S.commit(std::move(t2)));
+
+        /*----- `t1` may still read the deleted version, hence it must not be reclaimed. -----*/
+        S.collect_garbage();
+        CHECK(table.store().num_rows() == 3);
+        CHECK(visible_ids(table, *t1) == std::vector<int32_t>{ 1, 2, 3 });
+
+        REQUIRE(S.commit(std::move(t1)));
+        S.collect_garbage();
+        CHECK(table.store().num_rows() == 2);
+        expected = { 1, 3 };
+    }
+
+    SECTION("aborted versions")
+    {
+        auto t1 = S.begin_transaction();
+        REQUIRE(execute(S, *t1, "INSERT INTO t VALUES (4), (5);"));
+        CHECK(table.store().num_rows() == 5);
+        REQUIRE(S.abort(std::move(t1)));
+
+        S.collect_garbage();
+        CHECK(table.store().num_rows() == 3);
+        expected = { 1, 2, 3 };
+    }
+
+    auto t3 = S.begin_transaction();
+    REQUIRE(execute(S, *t3, ";"));
+    CHECK(visible_ids(table, *t3) == expected);
+    CHECK(S.commit(std::move(t3)));
+}
+
+TEST_CASE("MVCCScheduler/cancellation", "[core][catalog][scheduler]")
+{
+    auto &table = create_table();
+    auto &S = get_scheduler();
+
+    auto t0 = S.begin_transaction();
+    REQUIRE(execute(S, *t0, "INSERT INTO t VALUES (1), (2);"));
+    REQUIRE(S.commit(std::move(t0)));
+
+    SECTION("cancelled transaction")
+    {
+        auto t1 = S.begin_transaction();
+        REQUIRE(execute(S, *t1, "INSERT INTO t VALUES (3);"));
+        cancel(*t1);
+        CHECK(t1->is_cancelled());
+        CHECK_FALSE(execute(S, *t1, "INSERT INTO t VALUES (4);")); // commands after the cancellation fail
+        CHECK(S.abort(std::move(t1)));
+    }
+
+    SECTION("timeout")
+    {
+        auto t1 = S.begin_transaction();
+        set_timeout(*t1, std::chrono::milliseconds(1000));
+        CHECK(execute(S, *t1, "INSERT INTO t VALUES (3);")); // completes before its timeout
+        CHECK_FALSE(t1->is_cancelled());
+        CHECK(S.abort(std::move(t1)));
+    }
+
+    auto t2 = S.begin_transaction();
+    REQUIRE(execute(S, *t2, ";"));
+    CHECK(visible_ids(table, *t2) == std::vector<int32_t>{ 1, 2 });
+    CHECK(S.commit(std::move(t2)));
+}
@@ -0,0 +1,42 @@
+#include "catch2/catch.hpp"
+
+#include <chrono>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/util/exception.hpp>
+
+
+using namespace m;
+
+
+TEST_CASE("CancellationToken", "[core][catalog][scheduler]")
+{
+    CancellationToken token;
+    CHECK_FALSE(token.is_stopped());
+    CHECK(CancellationToken::Current() == nullptr);
+    CHECK_NOTHROW(CancellationToken::Check()); // no command in execution
+
+    {
+        CancellationToken::Scope scope(token);
+        CHECK(CancellationToken::Current() == &token);
+        CHECK_NOTHROW(CancellationToken::Check());
+
+        SECTION("deadline")
+        {
+            token.deadline(CancellationToken::clock::now() - std::chrono::milliseconds(1));
+            CHECK(token.is_expired());
+            CHECK_FALSE(token.is_cancelled());
+            CHECK_THROWS_AS(CancellationToken::Check(), execution_cancelled);
+
+            token.clear_deadline();
+            CHECK_FALSE(token.is_stopped());
+        }
+
+        SECTION("cancel")
+        {
+            token.cancel();
+            CHECK(token.is_cancelled());
+            CHECK_THROWS_AS(CancellationToken::Check(), execution_cancelled);
+        }
+    }
+    CHECK(CancellationToken::Current() == nullptr);
+}
@@ -0,0 +1,205 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "parse/Parser.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/WriteAheadLog.hpp>
+#include <mutable/mutable.hpp>
+#include <sstream>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Returns the path of a write-ahead log in the temporary directory after removing the log and its checkpoint. */
+std::filesystem::path fresh_path()
+{
+    auto path = std::filesystem::temp_directory_path() / "mutable_WriteAheadLogTest.wal";
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".checkpoint");
+    return path;
+}
+
+/** Clears the `Catalog` and enables a write-ahead log at \p path. */
+void open_wal(const std::filesystem::path &path)
+{
+    Catalog::Clear();
+    Catalog::Get().wal(std::make_unique<WriteAheadLog>(path, 1UL << 20));
+}
+
+/** Executes the statement \p sql and commits it.  Returns `true` iff the statement was committed. */
+bool execute(const char *sql)
+{
+    Catalog &C = Catalog::Get();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    std::istringstream in(sql);
+    ast::Lexer lexer(diag, C.get_pool(), "-", in);
+    ast::Parser parser(lexer);
+    return C.scheduler().autocommit(parser.parse(), diag);
+}
+
+/** Returns the sorted IDs of all rows of table `t` of database `db` that are not deleted. */
+std::vector<int32_t> ids()
+{
+    Catalog &C = Catalog::Get();
+    auto &table = C.get_database(C.pool("db")).get_table(C.pool("t"));
+    const Schema S = table.schema();
+    std::vector<int32_t> ids;
+    if (table.store().num_rows() == 0)
+        return ids;
+
+    const std::size_t idx_id = S[{ table.name(), C.pool("id") }].first;
+    std::optional<std::size_t> idx_ts_end;
+    for (std::size_t i = 0; i != S.num_entries(); ++i) {
+        if (S[i].id.name == C.pool("$ts_end"))
+            idx_ts_end = i;
+    }
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t i = 0; i != table.store().num_rows(); ++i) {
+        loader(args);
+        if (not idx_ts_end or tup[*idx_ts_end].as_i() == -1)
+            ids.push_back(tup[idx_id].as_i());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+/** Clears the `Catalog` and recovers it from the write-ahead log at \p path.  Returns the number of errors. */
+unsigned recover(const std::filesystem::path &path)
+{
+    open_wal(path);
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    Catalog::Get().wal()->recover(diag);
+    return diag.num_errors();
+}
+
+}
+
+
+TEST_CASE("WriteAheadLog/recover", "[core][catalog][wal]")
+{
+    const auto path = fresh_path();
+    open_wal(path);
+    REQUIRE(execute("CREATE DATABASE db;"));
+    REQUIRE(execute("USE db;"));
+    REQUIRE(execute("CREATE TABLE t ( id INT(4) PRIMARY KEY, name CHAR(8) );"));
+    REQUIRE(execute("INSERT INTO t VALUES (1, \"a\"), (2, \"b\");"));
+    REQUIRE(execute("DELETE FROM t WHERE id = 1;"));
+    REQUIRE(execute("SELECT * FROM t;"));
+    CHECK(Catalog::Get().wal()->size() > 0);
+    std::vector<int32_t> expected = { 2 };
+
+    SECTION("log only")
+    {
+        CHECK_FALSE(std::filesystem::exists(Catalog::Get().wal()->checkpoint_path()));
+    }
+
+    SECTION("checkpoint")
+    {
+        Catalog::Get().wal()->checkpoint();
+        CHECK(Catalog::Get().wal()->size() == 0);
+        CHECK(std::filesystem::file_size(path) == 0);
+        CHECK(std::filesystem::exists(Catalog::Get().wal()->checkpoint_path()));
+
+        /*----- Transactions after the checkpoint are logged. -----*/
+        REQUIRE(execute("INSERT INTO t VALUES (3, \"c\");"));
+        CHECK(Catalog::Get().wal()->size() > 0);
+        expected = { 2, 3 };
+    }
+
+    CHECK(recover(path) == 0);
+    Catalog &C = Catalog::Get();
+    CHECK_FALSE(C.has_database_in_use());
+    REQUIRE(C.has_database(C.pool("db")));
+    CHECK(ids() == expected);
+
+    /*----- Recovered transactions are not logged again, but new transactions are. -----*/
+    const auto size = C.wal()->size();
+    REQUIRE(execute("USE db;"));
+    REQUIRE(execute("INSERT INTO t VALUES (4, \"d\");"));
+    CHECK(C.wal()->size() > size);
+    expected.push_back(4);
+    CHECK(recover(path) == 0);
+    CHECK(ids() == expected);
+    Catalog::Clear();
+}
+
+TEST_CASE("WriteAheadLog/torn record", "[core][catalog][wal]")
+{
+    const auto path = fresh_path();
+    open_wal(path);
+    REQUIRE(execute("CREATE DATABASE db;"));
+    REQUIRE(execute("USE db;"));
+    REQUIRE(execute("CREATE TABLE t ( id INT(4) );"));
+    REQUIRE(execute("INSERT INTO t VALUES (1);"));
+    Catalog::Clear(); // closes the log
+    const auto size = std::filesystem::file_size(path);
+
+    /*----- Simulate a crash while a record was written. -----*/
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "torn";
+    }
+
+    CHECK(recover(path) == 0);
+    CHECK(std::filesystem::file_size(path) == size);
+    CHECK(ids() == std::vector<int32_t>{ 1 });
+    Catalog::Clear();
+}
+
+TEST_CASE("WriteAheadLog/physical records", "[core][catalog][wal]")
+{
+    const auto path = fresh_path();
+    const auto dsv = std::filesystem::temp_directory_path() / "mutable_WriteAheadLogTest.csv";
+    {
+        std::ofstream out(dsv);
+        out << "1,\"a\"\n2,\"b\"\n3,\"c\"\n";
+    }
+    const std::string import = "IMPORT INTO t DSV \"" + dsv.string() + "\";";
+
+    open_wal(path);
+    REQUIRE(execute("CREATE DATABASE db;"));
+    REQUIRE(execute("USE db;"));
+    REQUIRE(execute("CREATE TABLE t ( id INT(4), name CHAR(8) );"));
+    REQUIRE(execute(import.c_str()));
+    REQUIRE(execute("INSERT INTO t VALUES (4, \"d\"), (4, \"d\"), (5, \"e\");"));
+    REQUIRE(execute("DELETE FROM t WHERE id = 2 OR id = 4;"));
+    REQUIRE(execute("INSERT INTO t VALUES (4, \"d\");"));
+    REQUIRE(ids() == std::vector<int32_t>{ 1, 3, 4, 5 });
+
+    /*----- Imported rows are logged, hence recovery does not read the file again. -----*/
+    std::filesystem::remove(dsv);
+    CHECK(recover(path) == 0);
+    CHECK(ids() == std::vector<int32_t>{ 1, 3, 4, 5 });
+    Catalog::Clear();
+}
+
+TEST_CASE("WriteAheadLog/failed replay", "[core][catalog][wal]")
+{
+    const auto path = fresh_path();
+    open_wal(path);
+    REQUIRE(execute("CREATE DATABASE db;"));
+    REQUIRE(execute("USE db;"));
+    REQUIRE(execute("CREATE TABLE t ( id INT(4) );"));
+    REQUIRE(execute("INSERT INTO t VALUES (1);"));
+    Catalog::Clear(); // closes the log
+
+    /*----- Replaying the creation of an existing database fails, which must abort the recovery. -----*/
+    REQUIRE(execute("CREATE DATABASE db;"));
+    Catalog &C = Catalog::Get();
+    C.wal(std::make_unique<WriteAheadLog>(path, 1UL << 20));
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    CHECK_THROWS_AS(C.wal()->recover(diag), m::runtime_error);
+    CHECK_FALSE(C.wal()->is_recovering());
+    Catalog::Clear();
+}
@@ -1300,6 +1300,50 @@ TEST_CASE("Parser::parse_DropTableStmt() sanity tests", "[core][parse][unit]")
     }
 }
 
+TEST_CASE("Parser::parse_AlterTableStmt()", "[core][parse][unit]")
+{
+    test_triple_t triples[] = {
+        /* { alter table statement, fully-parenthesized alter table statement, next token } */
+
+        { "ALTER TABLE t SET LAYOUT Row", "ALTER TABLE t SET LAYOUT Row;", TK_EOF },
+        { "ALTER TABLE t SET LAYOUT PAX64K", "ALTER TABLE t SET LAYOUT PAX64K;", TK_EOF },
+    };
+
+    auto parse = [](ast::Parser &p) { return p.parse_AlterTableStmt(); };
+    for (auto triple : triples)
+        test_parse_positive<ast::AlterTableStmt, ast::Stmt>(triple, parse);
+}
+
+TEST_CASE("Parser::parse_AlterTableStmt() sanity tests", "[core][parse][unit]")
+{
+    const char * statements[] = {
+        "ALTER t SET LAYOUT Row",
+        "alter TABLE t SET LAYOUT Row",
+        "ALTER TABLE 1 SET LAYOUT Row",
+        "ALTER TABLE t LAYOUT Row",
+        "ALTER TABLE t SET Row",
+        "ALTER TABLE t SET LAYOUT 1",
+        "",
+        "ALTER",
+        "ALTER TABLE",
+        "ALTER TABLE t",
+        "ALTER TABLE t SET LAYOUT",
+    };
+
+    for (auto s : statements) {
+        LEXER(s);
+        ast::Parser parser(lexer);
+        auto ast = parser.parse_AlterTableStmt();
+        if (diag.num_errors() == 0)
+            std::cerr << "UNEXPECTED PASS for input \"" << s << '"' << std::endl;
+        CHECK(diag.num_errors() > 0);
+        CHECK_FALSE(err.str().empty());
+        if (not is<ast::ErrorStmt>(ast))
+            std::cerr << "Input \"" << s << "\" is not parsed as ErrorStmt" << std::endl;
+        CHECK(is<ast::ErrorStmt>(ast));
+    }
+}
+
 TEST_CASE("Parser::parse_CreateIndexStmt()", "[core][parse][unit]")
 {
     test_triple_t triples[] = {
@@ -1738,6 +1782,11 @@ TEST_CASE("Parser::parse_Stmt()", "[core][parse][unit]")
         test_parse_positive<CreateTableStmt, Stmt>(triple, parse);
     }
 
+    {
+        test_triple_t triple = { "ALTER TABLE A SET LAYOUT Row;", "ALTER TABLE A SET LAYOUT Row;", TK_EOF };
+        test_parse_positive<AlterTableStmt, Stmt>(triple, parse);
+    }
+
     {
         test_triple_t triple = { "SELECT * FROM A;", "SELECT *\nFROM A;", TK_EOF };
         test_parse_positive<SelectStmt, Stmt>(triple, parse);
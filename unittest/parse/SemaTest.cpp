@@ -705,6 +705,85 @@ TEST_CASE("Sema/Expressions/Functions", "[core][parse][sema]")
     }
 }
 
+TEST_CASE("Sema/Expressions/Functions/UDF", "[core][parse][sema]")
+{
+    Catalog::Clear();
+
+    /* Create a dummy DB and a dummy table, and register a UDF with an integral and a floating-point parameter. */
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("mydb"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("mytable"));
+    table.push_back(C.pool("v"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("b"), Type::Get_Boolean(Type::TY_Vector));
+    C.register_function(std::make_unique<ScalarUDF>(
+        C.pool("score"),
+        std::vector<const PrimitiveType*>{ Type::Get_Integer(Type::TY_Scalar, 8), Type::Get_Double(Type::TY_Scalar) },
+        Type::Get_Double(Type::TY_Scalar)
+    ));
+    CHECK_THROWS_AS(C.register_function(std::make_unique<ScalarUDF>(
+        C.pool("score"), std::vector<const PrimitiveType*>{}, Type::Get_Double(Type::TY_Scalar)
+    )), m::invalid_argument);
+
+    SECTION("Numeric arguments are converted.")
+    {
+        LEXER("SELECT score(v, 42) FROM mytable;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+
+        auto &selects = as<SelectClause>(stmt->select.get())->select;
+        REQUIRE(selects.size() == 1);
+        CHECK(selects[0].first->type() == Type::Get_Double(Type::TY_Vector)); // vectorial since `v` is vectorial
+    }
+
+    SECTION("Scalar arguments yield a scalar result.")
+    {
+        LEXER("SELECT score(1, 2.5) FROM mytable;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        auto &selects = as<SelectClause>(stmt->select.get())->select;
+        REQUIRE(selects.size() == 1);
+        CHECK(selects[0].first->type() == Type::Get_Double(Type::TY_Scalar));
+    }
+
+    SECTION("Wrong number of arguments.")
+    {
+        LEXER("SELECT score(v) FROM mytable;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() > 0);
+        REQUIRE_FALSE(err.str().empty());
+    }
+
+    SECTION("Wrong argument type.")
+    {
+        LEXER("SELECT score(v, b) FROM mytable;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() > 0);
+        REQUIRE_FALSE(err.str().empty());
+    }
+}
+
 TEST_CASE("Sema/Expressions/Designator", "[core][parse][sema]")
 {
     Catalog::Clear();
@@ -2360,6 +2439,61 @@ TEST_CASE("Sema/Statements/DropTable", "[core][parse][sema]")
     }
 }
 
+TEST_CASE("Sema/Statements/AlterTable", "[core][parse][sema]")
+{
+    Catalog::Clear();
+
+    /* Create a dummy DB and a dummy table. */
+    Catalog &C = Catalog::Get();
+    ThreadSafePooledString db_name = C.pool("mydb");
+    auto &DB = C.add_database(db_name);
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("mytable"));
+    table.push_back(C.pool("a"), Type::Get_Boolean(Type::TY_Vector));
+
+    SECTION("Alter Table Statement is ok.")
+    {
+        LEXER("ALTER TABLE mytable SET LAYOUT Row;");
+        Parser parser(lexer);
+        auto stmt = as<AlterTableStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+    }
+
+    SECTION("Alter Table Statement for table which does not exist.")
+    {
+        LEXER("ALTER TABLE foo SET LAYOUT Row;");
+        Parser parser(lexer);
+        auto stmt = as<AlterTableStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
+    SECTION("Alter Table Statement for data layout which does not exist.")
+    {
+        LEXER("ALTER TABLE mytable SET LAYOUT foo;");
+        Parser parser(lexer);
+        auto stmt = as<AlterTableStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+}
+
 TEST_CASE("Sema/Statements/Select", "[core][parse][sema]")
 {
     Catalog::Clear();
@@ -2491,6 +2625,62 @@ TEST_CASE("Sema/Statements/CreateIndex", "[core][parse][sema]")
         REQUIRE(not err.str().empty());
     }
 
+    SECTION("Create Index Statement using PGM index is ok.")
+    {
+        LEXER("CREATE INDEX idx ON mytable USING pgm (b);");
+        Parser parser(lexer);
+        auto stmt = as<CreateIndexStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+    }
+
+    SECTION("Create Index Statement on composite key is ok.")
+    {
+        LEXER("CREATE INDEX idx ON mytable(a, b);");
+        Parser parser(lexer);
+        auto stmt = as<CreateIndexStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+    }
+
+    SECTION("Create Index Statement on composite key with duplicate attribute.")
+    {
+        LEXER("CREATE INDEX idx ON mytable(a, b, a);");
+        Parser parser(lexer);
+        auto stmt = as<CreateIndexStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
+    SECTION("Create Index Statement on composite key with unsupported index method.")
+    {
+        LEXER("CREATE INDEX idx ON mytable USING rmi (b, a);");
+        Parser parser(lexer);
+        auto stmt = as<CreateIndexStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
     SECTION("Create Index Statement with already existing index name.")
     {
         /* Create index idx on mytable(a). */
@@ -2744,22 +2934,38 @@ TEST_CASE("Sema/Statements/Update", "[core][parse][sema]")
 {
     //TODO
 }
+#endif
 
 TEST_CASE("Sema/Statements/Delete", "[core][parse][sema]")
 {
     Catalog::Clear();
 
-    //Create a dummy DB and a dummy table with integer and boolean vectorial attribute.
+    /* Create a dummy DB with a multi-versioned and a plain table with integer and boolean vectorial attribute. */
     Catalog &C = Catalog::Get();
-    const char *db_name = "mydb";
-    auto &DB = C.add_database(db_name);
-    //C.set_database_in_use(DB);
-    auto &table = DB.add_table(C.pool("mytable"));
+    auto &DB = C.add_database(C.pool("mydb"));
+    ConcreteTableFactoryDecorator<MultiVersioningTable> factory(std::make_unique<ConcreteTableFactory>());
+    auto &table = DB.add(factory.make(C.pool("mytable")));
     table.push_back(C.pool("v"), Type::Get_Integer(Type::TY_Vector, 4));
     table.push_back(C.pool("b"), Type::Get_Boolean(Type::TY_Vector));
+    auto &plain = DB.add_table(C.pool("plain"));
+    plain.push_back(C.pool("v"), Type::Get_Integer(Type::TY_Vector, 4));
+
+    SECTION("DELETE without database in use")
+    {
+        LEXER("DELETE FROM mytable;");
+        Parser parser(lexer);
+        auto stmt = as<DeleteStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
 
     SECTION("DELETE all rows without deleting the table")
     {
+        C.set_database_in_use(DB);
         LEXER("DELETE FROM mytable;");
         Parser parser(lexer);
         auto stmt = as<DeleteStmt>(parser.parse());
@@ -2774,6 +2980,7 @@ TEST_CASE("Sema/Statements/Delete", "[core][parse][sema]")
 
     SECTION("DELETE with WHERE")
     {
+        C.set_database_in_use(DB);
         LEXER("DELETE FROM mytable WHERE v=0;");
         Parser parser(lexer);
         auto stmt = as<DeleteStmt>(parser.parse());
@@ -2785,8 +2992,49 @@ TEST_CASE("Sema/Statements/Delete", "[core][parse][sema]")
         REQUIRE(diag.num_errors() == 0);
         REQUIRE(err.str().empty());
     }
+
+    SECTION("DELETE with non-boolean WHERE")
+    {
+        C.set_database_in_use(DB);
+        LEXER("DELETE FROM mytable WHERE v;");
+        Parser parser(lexer);
+        auto stmt = as<DeleteStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
+    SECTION("DELETE from non-existing table")
+    {
+        C.set_database_in_use(DB);
+        LEXER("DELETE FROM nonexisting;");
+        Parser parser(lexer);
+        auto stmt = as<DeleteStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
+    SECTION("DELETE from table without multi-versioning")
+    {
+        C.set_database_in_use(DB);
+        LEXER("DELETE FROM plain WHERE v=0;");
+        Parser parser(lexer);
+        auto stmt = as<DeleteStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
 }
-#endif
 
 TEST_CASE("Sema/Statements/DSVImport", "[core][parse][sema]")
 {
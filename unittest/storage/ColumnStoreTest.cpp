@@ -86,7 +86,11 @@ TEST_CASE("ColumnStore sanity checks", "[core][storage][columnstore]")
     SECTION("append")
     {
         std::size_t capacity = ColumnStore::ALLOCATION_SIZE / 2048;
+        REQUIRE(store.capacity() == capacity);
         while (store.num_rows() < capacity) store.append();
-        REQUIRE_THROWS_AS(store.append(), std::logic_error);
+        store.append(); // grow
+        CHECK(store.num_rows() == capacity + 1);
+        CHECK(store.capacity() == 2 * capacity);
+        CHECK(store.memory().size() >= 2 * ColumnStore::ALLOCATION_SIZE * (table.num_attrs() + 1));
     }
 }
@@ -0,0 +1,116 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/RowStore.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+TEST_CASE("DataLayoutFactory/NULL bitmap", "[core][storage][datalayout]")
+{
+    std::vector<const Type*> types = {
+        Type::Get_Integer(Type::TY_Vector, 4),
+        Type::Get_Double(Type::TY_Vector),
+    };
+
+    SECTION("Row")
+    {
+        RowLayoutFactory factory;
+        CHECK(has_null_bitmap(factory.make(types), types.size()));
+        CHECK(has_null_bitmap(factory.make(types, { false, true }), types.size()));
+
+        DataLayout layout = factory.make(types, { false, false });
+        CHECK_FALSE(has_null_bitmap(layout, types.size()));
+        CHECK(layout.stride_in_bits() == 128); // 32 bit and 64 bit values, padded, without NULL bitmap
+    }
+
+    SECTION("PAX")
+    {
+        PAXLayoutFactory factory(PAXLayoutFactory::NTuples, 16);
+        CHECK(has_null_bitmap(factory.make(types), types.size()));
+        CHECK(has_null_bitmap(factory.make(types, { true, false }), types.size()));
+        CHECK_FALSE(has_null_bitmap(factory.make(types, { false, false }), types.size()));
+    }
+}
+
+TEST_CASE("DataLayoutFactory/NOT NULL constraints", "[core][storage][datalayout]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("val"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.add_primary_key(C.pool("id"));
+    CHECK(table.at(C.pool("id")).not_nullable);
+
+    SECTION("nullable attribute")
+    {
+        table.store(std::make_unique<RowStore>(table));
+        table.layout(RowLayoutFactory());
+        CHECK(has_null_bitmap(table.layout(), table.num_attrs()));
+
+        StoreWriter W(table.store());
+        Tuple tup(W.schema());
+        tup.set(0, int32_t(1));
+        tup.null(1);
+        W.append(tup);
+        CHECK(table.store().num_rows() == 1);
+    }
+
+    SECTION("no nullable attribute")
+    {
+        table.at(C.pool("val")).not_nullable = true;
+        table.store(std::make_unique<RowStore>(table));
+        table.layout(RowLayoutFactory());
+        CHECK_FALSE(has_null_bitmap(table.layout(), table.num_attrs()));
+    }
+
+    SECTION("compress without NULL values")
+    {
+        table.store(std::make_unique<RowStore>(table));
+        table.layout(RowLayoutFactory());
+
+        StoreWriter W(table.store());
+        Tuple tup(W.schema());
+        for (int32_t i = 0; i != 10; ++i) {
+            tup.set(0, i);
+            tup.set(1, 2 * i);
+            W.append(tup);
+        }
+        compress(table);
+        CHECK(has_null_bitmap(table.layout(), table.num_attrs())); // `val` is nullable
+
+        /*----- Check that NULL values can still be inserted. -----*/
+        StoreWriter W2(table.store());
+        tup.null(1);
+        W2.append(tup);
+        CHECK(table.store().num_rows() == 11);
+        Tuple res(W.schema());
+        Tuple *args[] = { &res };
+        Interpreter::compile_load(W.schema(), table.store().memory().addr(), table.layout(), W.schema(), 10)(args);
+        CHECK(res.is_null(1));
+    }
+
+    SECTION("compress without nullable attribute")
+    {
+        table.at(C.pool("val")).not_nullable = true;
+        table.store(std::make_unique<RowStore>(table));
+        table.layout(RowLayoutFactory());
+
+        StoreWriter W(table.store());
+        Tuple tup(W.schema());
+        for (int32_t i = 0; i != 10; ++i) {
+            tup.set(0, i);
+            tup.set(1, 2 * i);
+            W.append(tup);
+        }
+        compress(table);
+        CHECK_FALSE(has_null_bitmap(table.layout(), table.num_attrs()));
+    }
+}
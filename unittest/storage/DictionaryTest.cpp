@@ -0,0 +1,237 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/RowStore.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Dictionary.hpp>
+#include <mutable/storage/Store.hpp>
+#include <shared_mutex>
+#include <thread>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+TEST_CASE("Dictionary", "[core][storage][dictionary]")
+{
+    Dictionary dict(Type::Get_Char(Type::TY_Vector, 4));
+    REQUIRE(dict.size() == 0);
+    REQUIRE(dict.entry_size() == 5);
+    CHECK(std::strcmp(dict.decode(0), "") == 0); // NULL values decode to the empty string
+
+    SECTION("encode")
+    {
+        CHECK(dict.encode("abc") == 0);
+        CHECK(dict.encode("xyz") == 1);
+        CHECK(dict.encode("abc") == 0);
+        CHECK(dict.size() == 2);
+        CHECK(std::strcmp(dict.decode(0), "abc") == 0);
+        CHECK(std::strcmp(dict.decode(1), "xyz") == 0);
+    }
+
+    SECTION("truncate to length")
+    {
+        CHECK(dict.encode("abcdef") == 0);
+        CHECK(dict.encode("abcd") == 0);
+        CHECK(std::strcmp(dict.decode(0), "abcd") == 0);
+    }
+
+    SECTION("find")
+    {
+        dict.encode("abc");
+        CHECK(dict.find("abc") == 0);
+        CHECK_FALSE(dict.find("xyz").has_value());
+        CHECK(dict.size() == 1);
+    }
+
+    SECTION("order-preserving")
+    {
+        CHECK(dict.is_order_preserving()); // empty
+        dict.encode("abc");
+        dict.encode("abd");
+        dict.encode("abd");
+        CHECK(dict.is_order_preserving());
+        dict.encode("aaa"); // smaller than its predecessor
+        CHECK_FALSE(dict.is_order_preserving());
+        dict.encode("zzz");
+        CHECK_FALSE(dict.is_order_preserving()); // never restored
+    }
+
+    SECTION("bounds")
+    {
+        for (auto value : { "b", "d", "f" })
+            dict.encode(value);
+        CHECK(dict.lower_bound("a") == 0);
+        CHECK(dict.upper_bound("a") == 0);
+        CHECK(dict.lower_bound("d") == 1);
+        CHECK(dict.upper_bound("d") == 2);
+        CHECK(dict.lower_bound("e") == 2);
+        CHECK(dict.upper_bound("e") == 2);
+        CHECK(dict.lower_bound("g") == 3);
+        CHECK(dict.upper_bound("g") == 3);
+        CHECK(dict.lower_bound("") == 0);
+    }
+
+    SECTION("grow")
+    {
+        Dictionary dict(Type::Get_Char(Type::TY_Vector, 8));
+        const std::size_t num_entries = Dictionary::ALLOCATION_SIZE / dict.entry_size() + 1;
+        const std::size_t initial_size = dict.memory().size();
+        char buf[9];
+        for (std::size_t i = 0; i != num_entries; ++i) {
+            std::snprintf(buf, sizeof(buf), "%08zx", i);
+            dict.encode(buf);
+        }
+        CHECK(dict.size() == num_entries);
+        CHECK(dict.memory().size() == 2 * initial_size);
+        CHECK(std::strcmp(dict.decode(0), "00000000") == 0);
+        CHECK(std::strcmp(dict.decode(num_entries - 1), buf) == 0);
+    }
+
+    SECTION("concurrent encode and find")
+    {
+        Dictionary dict(Type::Get_Char(Type::TY_Vector, 8));
+        const std::size_t num_entries = Dictionary::ALLOCATION_SIZE / dict.entry_size() + 1; // grows once
+
+        /* A reader looks up values while the writer encodes them, holding the memory latch like MVCC readers do. */
+        std::atomic_bool done(false);
+        std::size_t num_found = 0;
+        std::size_t num_mismatches = 0;
+        std::thread reader([&]() {
+            char buf[9];
+            std::size_t i = 0;
+            while (not done) {
+                std::shared_lock<std::shared_mutex> latch(Store::Memory_Latch());
+                std::snprintf(buf, sizeof(buf), "%08zx", i);
+                if (auto code = dict.find(buf)) {
+                    num_mismatches += std::strcmp(dict.decode(*code), buf) != 0;
+                    ++num_found;
+                    ++i;
+                }
+            }
+        });
+
+        char buf[9];
+        for (std::size_t i = 0; i != num_entries; ++i) {
+            std::snprintf(buf, sizeof(buf), "%08zx", i);
+            CHECK(dict.encode(buf) == i);
+        }
+        done = true;
+        reader.join();
+
+        CHECK(dict.size() == num_entries);
+        CHECK(num_found <= num_entries);
+        CHECK(num_mismatches == 0);
+    }
+}
+
+TEST_CASE("DictionaryLayoutFactory", "[core][storage][dictionary]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("i4"),     Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("char15"), Type::Get_Char(Type::TY_Vector, 15));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(DictionaryLayoutFactory(std::make_unique<RowLayoutFactory>()));
+
+    /*----- Check the layout. -----*/
+    auto &row = as<const DataLayout::INode>(table.layout().child());
+    REQUIRE(row.num_children() == 3); // two attributes and the NULL bitmap
+    const DataLayout::Leaf *char15 = nullptr;
+    for (auto &child : row) {
+        auto &leaf = as<const DataLayout::Leaf>(*child.ptr);
+        if (leaf.index() == 1)
+            char15 = &leaf;
+        else
+            CHECK_FALSE(leaf.is_dictionary_encoded());
+    }
+    REQUIRE(char15);
+    REQUIRE(char15->is_dictionary_encoded());
+    CHECK(*char15->type() == *Type::Get_Char(Type::TY_Vector, 15));
+    CHECK(row.num_tuples() == 1);
+    CHECK(table.layout().stride_in_bits() == 96); // two 32 bit values and the NULL bitmap, padded
+
+    /*----- Store and load tuples. -----*/
+    Schema S = table.schema();
+    const char *values[] = { "Hello", "World", "Hello", "" };
+    for (std::size_t i = 0; i != std::size(values); ++i) {
+        table.store().append();
+        Tuple tup(S);
+        tup.set(0, int64_t(i));
+        tup.set(1, values[i]);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_store(S, table.store().memory().addr(), table.layout(), S, i)(args);
+    }
+    CHECK(char15->dictionary().size() == 3);
+
+    for (std::size_t i = 0; i != std::size(values); ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+        CHECK(tup.get(0).as<int64_t>() == int64_t(i));
+        CHECK(std::strcmp(tup.get(1).as<const char*>(), values[i]) == 0);
+    }
+}
+
+TEST_CASE("DictionaryLayoutFactory/order-preserving codes", "[core][storage][dictionary]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("char7"), Type::Get_Char(Type::TY_Vector, 7));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+
+    /*----- Insert values in non-sorted order, with duplicates and a NULL value. -----*/
+    const char *values[] = { "pear", "apple", "plum", "apple", nullptr, "fig" };
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (auto value : values) {
+        if (value)
+            tup.set(0, value);
+        else
+            tup.null(0);
+        W.append(tup);
+    }
+
+    /*----- Reorganize to a dictionary-encoded layout, which encodes the values in ascending order. -----*/
+    change_layout(table, DictionaryLayoutFactory(std::make_unique<RowLayoutFactory>()));
+    auto &row = as<const DataLayout::INode>(table.layout().child());
+    const DataLayout::Leaf *char7 = nullptr;
+    for (auto &child : row) {
+        auto &leaf = as<const DataLayout::Leaf>(*child.ptr);
+        if (leaf.index() == 0)
+            char7 = &leaf;
+    }
+    REQUIRE(char7);
+    REQUIRE(char7->is_dictionary_encoded());
+    auto &dict = char7->dictionary();
+    CHECK(dict.is_order_preserving());
+    REQUIRE(dict.size() == 4);
+    CHECK(dict.find("apple") == 0);
+    CHECK(dict.find("fig") == 1);
+    CHECK(dict.find("pear") == 2);
+    CHECK(dict.find("plum") == 3);
+    CHECK(dict.lower_bound("g") == 2);
+
+    /*----- The contents are unchanged. -----*/
+    const Schema &S = W.schema();
+    for (std::size_t i = 0; i != std::size(values); ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+        if (values[i])
+            CHECK(std::strcmp(tup.get(0).as<const char*>(), values[i]) == 0);
+        else
+            CHECK(tup.is_null(0));
+    }
+}
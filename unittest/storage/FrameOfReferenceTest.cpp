@@ -0,0 +1,335 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/RowStore.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Returns the `Leaf` with index \p idx of the row layout \p layout. */
+const DataLayout::Leaf & get_leaf(const DataLayout &layout, std::size_t idx)
+{
+    for (auto &child : as<const DataLayout::INode>(layout.child())) {
+        auto &leaf = as<const DataLayout::Leaf>(*child.ptr);
+        if (leaf.index() == idx)
+            return leaf;
+    }
+    throw std::out_of_range("no leaf with the given index");
+}
+
+}
+
+TEST_CASE("FrameOfReferenceLayoutFactory", "[core][storage][frame_of_reference]")
+{
+    using range_type = FrameOfReferenceLayoutFactory::range_type;
+
+    std::vector<const Type*> types = {
+        Type::Get_Integer(Type::TY_Vector, 8),
+        Type::Get_Integer(Type::TY_Vector, 4),
+        Type::Get_Integer(Type::TY_Vector, 2),
+        Type::Get_Float(Type::TY_Vector),
+        Type::Get_Integer(Type::TY_Vector, 8),
+    };
+    std::vector<std::optional<range_type>> ranges = {
+        range_type(-1000, 1000), // fits into 11 bits or 2 bytes
+        range_type(100, 355),    // fits into 1 byte
+        range_type(0, 1000),     // fits into 10 bits, no narrower integer suffices
+        range_type(0, 1),        // not integral
+        std::nullopt,            // range unknown
+    };
+
+    SECTION("bit-packing")
+    {
+        FrameOfReferenceLayoutFactory factory(std::make_unique<RowLayoutFactory>(), ranges);
+        DataLayout layout = factory.make(types.begin(), types.end());
+
+        /*----- Check the encoded leaves. -----*/
+        auto &i8 = get_leaf(layout, 0);
+        REQUIRE(i8.is_bit_packed());
+        CHECK(*i8.type() == *types[0]);
+        CHECK(*i8.stored_type() == *Type::Get_Bitmap(Type::TY_Vector, 11));
+        CHECK(i8.reference() == -1000);
+        CHECK(i8.encodable_range() == range_type(-1000, 1047));
+        CHECK(i8.can_encode(-1000));
+        CHECK(i8.can_encode(1047));
+        CHECK_FALSE(i8.can_encode(-1001));
+        CHECK_FALSE(i8.can_encode(1048));
+
+        auto &i4 = get_leaf(layout, 1);
+        REQUIRE(i4.is_frame_of_reference_encoded());
+        CHECK_FALSE(i4.is_bit_packed()); // 8 bits suffice, hence a whole byte is laid out
+        CHECK(*i4.stored_type() == *Type::Get_Integer(Type::TY_Vector, 1));
+        CHECK(i4.reference() == 228);
+
+        auto &i2 = get_leaf(layout, 2);
+        REQUIRE(i2.is_bit_packed());
+        CHECK(*i2.stored_type() == *Type::Get_Bitmap(Type::TY_Vector, 10));
+        CHECK(i2.reference() == 0);
+
+        for (std::size_t idx = 3; idx != types.size(); ++idx) {
+            auto &leaf = get_leaf(layout, idx);
+            CHECK_FALSE(leaf.is_frame_of_reference_encoded());
+            CHECK(leaf.stored_type() == leaf.type());
+        }
+    }
+
+    SECTION("whole bytes")
+    {
+        FrameOfReferenceLayoutFactory factory(std::make_unique<RowLayoutFactory>(), ranges, false);
+        DataLayout layout = factory.make(types.begin(), types.end());
+
+        /*----- Check the encoded leaves. -----*/
+        auto &i8 = get_leaf(layout, 0);
+        REQUIRE(i8.is_frame_of_reference_encoded());
+        CHECK_FALSE(i8.is_bit_packed());
+        CHECK(*i8.type() == *types[0]);
+        CHECK(*i8.stored_type() == *Type::Get_Integer(Type::TY_Vector, 2));
+        CHECK(i8.reference() == 0);
+
+        auto &i4 = get_leaf(layout, 1);
+        REQUIRE(i4.is_frame_of_reference_encoded());
+        CHECK(*i4.type() == *types[1]);
+        CHECK(*i4.stored_type() == *Type::Get_Integer(Type::TY_Vector, 1));
+        CHECK(i4.reference() == 228);
+        CHECK(i4.can_encode(100));
+        CHECK(i4.can_encode(355));
+        CHECK_FALSE(i4.can_encode(99));
+        CHECK_FALSE(i4.can_encode(356));
+
+        for (std::size_t idx = 2; idx != types.size(); ++idx) {
+            auto &leaf = get_leaf(layout, idx);
+            CHECK_FALSE(leaf.is_frame_of_reference_encoded());
+            CHECK(leaf.stored_type() == leaf.type());
+        }
+    }
+
+    /*----- Check that the number of ranges must match. -----*/
+    ranges.pop_back();
+    FrameOfReferenceLayoutFactory mismatch(std::make_unique<RowLayoutFactory>(), std::move(ranges));
+    CHECK_THROWS_AS(mismatch.make(types.begin(), types.end()), m::invalid_argument);
+}
+
+TEST_CASE("FrameOfReferenceLayoutFactory/store and load", "[core][storage][frame_of_reference]")
+{
+    using range_type = FrameOfReferenceLayoutFactory::range_type;
+
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("i8"), Type::Get_Integer(Type::TY_Vector, 8));
+    table.push_back(C.pool("i4"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    const int64_t base = -(int64_t(1) << 40);
+    table.layout(FrameOfReferenceLayoutFactory(std::make_unique<RowLayoutFactory>(), {
+        range_type(base, base + 60000), range_type(-5, 5)
+    }));
+    CHECK(table.layout().stride_in_bits() == 32); // 16 bit and 4 bit values and the NULL bitmap, padded
+    CHECK(get_leaf(table.layout(), 1).is_bit_packed());
+
+    /*----- Store and load tuples. -----*/
+    Schema S = table.schema();
+    const int64_t values[][2] = { { base, -5 }, { base + 60000, 5 }, { base + 42, 0 } };
+    for (std::size_t i = 0; i != std::size(values); ++i) {
+        table.store().append();
+        Tuple tup(S);
+        tup.set(0, values[i][0]);
+        if (i == 2)
+            tup.null(1);
+        else
+            tup.set(1, values[i][1]);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_store(S, table.store().memory().addr(), table.layout(), S, i)(args);
+    }
+
+    for (std::size_t i = 0; i != std::size(values); ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+        CHECK(tup.get(0).as_i() == values[i][0]);
+        if (i == 2)
+            CHECK(tup.is_null(1));
+        else
+            CHECK(tup.get(1).as_i() == values[i][1]);
+    }
+}
+
+TEST_CASE("compress", "[core][storage][frame_of_reference]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("i8"), Type::Get_Integer(Type::TY_Vector, 8));
+    table.push_back(C.pool("f"),  Type::Get_Float(Type::TY_Vector));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (int64_t i = 0; i != 100; ++i) {
+        tup.set(0, 1000 + i);
+        tup.set(1, float(i) / 2);
+        W.append(tup);
+    }
+
+    compress(table);
+
+    /*----- Check the layout. -----*/
+    auto &i8 = get_leaf(table.layout(), 0);
+    REQUIRE(i8.is_bit_packed());
+    CHECK(*i8.stored_type() == *Type::Get_Bitmap(Type::TY_Vector, 7));
+    CHECK(i8.reference() == 1000);
+    CHECK_FALSE(get_leaf(table.layout(), 1).is_frame_of_reference_encoded());
+
+    /*----- Check the contents. -----*/
+    const Schema &S = W.schema();
+    for (std::size_t i = 0; i != 100; ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+        CHECK(tup.get(0).as_i() == int64_t(1000 + i));
+        CHECK(tup.get(1).as_f() == float(i) / 2);
+    }
+
+    /*----- Check that values out of range widen the encoding. -----*/
+    StoreWriter W2(table.store());
+    tup.set(0, int64_t(1000 + 127));
+    W2.append(tup);
+    CHECK(table.store().num_rows() == 101);
+    CHECK(*get_leaf(table.layout(), 0).stored_type() == *Type::Get_Bitmap(Type::TY_Vector, 7));
+    tup.set(0, int64_t(1000 + 128));
+    W2.append(tup);
+    CHECK(table.store().num_rows() == 102);
+    {
+        auto &i8 = get_leaf(table.layout(), 0);
+        REQUIRE(i8.is_frame_of_reference_encoded());
+        CHECK_FALSE(i8.is_bit_packed()); // 8 bits suffice, hence a whole byte is laid out
+        CHECK(*i8.stored_type() == *Type::Get_Integer(Type::TY_Vector, 1));
+        CHECK(i8.reference() == 1064);
+    }
+    for (std::size_t i = 0; i != 102; ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+        CHECK(tup.get(0).as_i() == int64_t(1000 + (i < 100 ? i : 127 + (i - 100))));
+    }
+}
+
+TEST_CASE("compress/layout factory", "[core][storage][frame_of_reference]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("i4"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(PAXLayoutFactory(PAXLayoutFactory::NTuples, 16));
+
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (int32_t i = 0; i != 100; ++i) {
+        tup.set(0, int64_t(i));
+        W.append(tup);
+    }
+
+    /*----- Check that compressing decorates the table's current data layout factory. -----*/
+    compress(table);
+    auto FOR = cast<const FrameOfReferenceLayoutFactory>(table.layout_factory());
+    REQUIRE(FOR);
+    CHECK(cast<const PAXLayoutFactory>(&FOR->factory()));
+    CHECK(table.layout().child().num_tuples() == 16);
+
+    /*----- Check that compressing again does not nest the encoding. -----*/
+    compress(table);
+    FOR = cast<const FrameOfReferenceLayoutFactory>(table.layout_factory());
+    REQUIRE(FOR);
+    CHECK(cast<const PAXLayoutFactory>(&FOR->factory()));
+
+    const Schema &S = W.schema();
+    for (std::size_t i = 0; i != 100; ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+        CHECK(tup.get(0).as_i() == int64_t(i));
+    }
+}
+
+TEST_CASE("compress/bit-packing", "[core][storage][frame_of_reference]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("i4"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("i8"), Type::Get_Integer(Type::TY_Vector, 8));
+    table.store(std::make_unique<RowStore>(table));
+
+    auto value = [](std::size_t i) { return int64_t(i * 37 % 3001); }; // 12 bits
+    auto other = [](std::size_t i) { return int64_t(i % 7) - 3; }; // 3 bits
+
+    SECTION("row layout")
+    {
+        table.layout(RowLayoutFactory());
+    }
+
+    SECTION("PAX layout")
+    {
+        table.layout(PAXLayoutFactory(PAXLayoutFactory::NTuples, 10)); // 3 bit values of a block end within a byte
+    }
+
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (std::size_t i = 0; i != 100; ++i) {
+        tup.set(0, value(i));
+        if (i % 10 == 0)
+            tup.null(1);
+        else
+            tup.set(1, other(i));
+        W.append(tup);
+    }
+
+    compress(table);
+
+    /*----- Check the layout. -----*/
+    auto &i4 = get_leaf(table.layout(), 0);
+    REQUIRE(i4.is_bit_packed());
+    CHECK(*i4.stored_type() == *Type::Get_Bitmap(Type::TY_Vector, 12));
+    CHECK(i4.reference() == 0);
+    auto &i8 = get_leaf(table.layout(), 1);
+    REQUIRE(i8.is_bit_packed());
+    CHECK(*i8.stored_type() == *Type::Get_Bitmap(Type::TY_Vector, 3));
+    CHECK(i8.reference() == -3);
+    if (table.layout().child().num_tuples() == 1)
+        CHECK(table.layout().stride_in_bits() == 24); // 12 bit and 3 bit values and the NULL bitmap, padded
+
+    /*----- Check the contents, loading each row individually and all rows sequentially. -----*/
+    const Schema &S = W.schema();
+    auto check = [&](const Tuple &tup, std::size_t i) {
+        CHECK(tup.get(0).as_i() == value(i));
+        if (i % 10 == 0)
+            CHECK(tup.is_null(1));
+        else
+            CHECK(tup.get(1).as_i() == other(i));
+    };
+    for (std::size_t i = 0; i != 100; ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+        check(tup, i);
+    }
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S);
+    for (std::size_t i = 0; i != 100; ++i) {
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        loader(args);
+        check(tup, i);
+    }
+}
@@ -6,6 +6,9 @@
 #include <mutable/util/concepts.hpp>
 #include <mutable/util/Diagnostic.hpp>
 #include "storage/PaxStore.hpp"
+#include <future>
+#include <limits>
+#include <optional>
 
 
 using namespace m;
@@ -119,3 +122,273 @@ TEMPLATE_TEST_CASE("ArrayIndex::bulkload() with Numeric types", "[core][storage]
     /* Index should not contain NULL. */
     REQUIRE(idx.num_entries() == keys.size());
 }
+
+namespace {
+
+/** Creates the table `t` with the single attribute `val` of type `INT(4)` in the database in use and fills it with
+ * \p num_rows rows, where row `i` has the value `num_rows - i`. */
+Table & create_table(std::size_t num_rows)
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+    table.push_back(C.pool("val"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (std::size_t i = 0; i != num_rows; ++i) {
+        tup.set(0, int64_t(num_rows - i));
+        W.append(tup);
+    }
+    return table;
+}
+
+}
+
+TEMPLATE_TEST_CASE("ArrayIndex::bulkload() in parallel", "[core][storage][index]",
+                   ArrayIndex<int32_t>, RecursiveModelIndex<int32_t>, PiecewiseGeometricModelIndex<int32_t>)
+{
+    constexpr std::size_t num_rows = 300000; // multiple chunks of rows and multiple sorted runs
+    auto &table = create_table(num_rows);
+
+    TestType idx;
+    idx.bulkload(table, table.schema());
+    REQUIRE(idx.finalized());
+    REQUIRE(idx.num_entries() == num_rows);
+
+    /* Check sortedness and contents of index. */
+    for (auto it = idx.begin() + 1; it != idx.end(); ++it)
+        REQUIRE((it - 1)->first < it->first);
+    for (int32_t key : { 1, 2, 1000, 123456, int32_t(num_rows) }) {
+        auto it = idx.lower_bound(key);
+        REQUIRE(it != idx.end());
+        CHECK(it->first == key);
+        CHECK(it->second == num_rows - key);
+    }
+    CHECK(idx.lower_bound(0) == idx.begin());
+    CHECK(idx.upper_bound(int32_t(num_rows)) == idx.end());
+}
+
+TEMPLATE_TEST_CASE("PiecewiseGeometricModelIndex lookups with duplicates", "[core][storage][index]",
+                   int16_t, int64_t, double)
+{
+    /* Add skewed keys, where small keys occur many times, and the extreme keys. */
+    PiecewiseGeometricModelIndex<TestType> idx;
+    ArrayIndex<TestType> expected;
+    std::size_t i = 0;
+    for (int64_t k = 1; k <= 150; ++k) {
+        for (int64_t n = 0; n != 1000 / k; ++n, ++i) {
+            idx.add(TestType(k * k), i);
+            expected.add(TestType(k * k), i);
+        }
+    }
+    for (TestType k : { std::numeric_limits<TestType>::lowest(), std::numeric_limits<TestType>::max() }) {
+        idx.add(k, i);
+        expected.add(k, i++);
+    }
+    idx.finalize();
+    expected.finalize();
+    REQUIRE(idx.num_entries() == expected.num_entries());
+    CHECK(idx.num_levels() > 0);
+
+    /* Lookups of present and absent keys find the same positions as a binary search. */
+    for (int64_t k = -1; k <= 152 * 152; ++k) {
+        const TestType key(k);
+        REQUIRE(std::distance(idx.begin(), idx.lower_bound(key)) ==
+                std::distance(expected.begin(), expected.lower_bound(key)));
+        REQUIRE(std::distance(idx.begin(), idx.upper_bound(key)) ==
+                std::distance(expected.begin(), expected.upper_bound(key)));
+    }
+    CHECK(idx.lower_bound(std::numeric_limits<TestType>::lowest()) == idx.begin());
+    CHECK(idx.upper_bound(std::numeric_limits<TestType>::max()) == idx.end());
+}
+
+TEST_CASE("PiecewiseGeometricModelIndex lookups with strings", "[core][storage][index]")
+{
+    /* Keys share prefixes longer than the eight characters of their model keys. */
+    std::vector<std::string> keys;
+    for (const char *prefix : { "", "a", "abcdefgh", "abcdefghij", "zz" }) {
+        for (int i = 0; i != 100; ++i)
+            keys.push_back(prefix + std::to_string(i % 50));
+    }
+    PiecewiseGeometricModelIndex<const char*> idx;
+    ArrayIndex<const char*> expected;
+    for (std::size_t i = 0; i != keys.size(); ++i) {
+        idx.add(keys[i].c_str(), i);
+        expected.add(keys[i].c_str(), i);
+    }
+    idx.finalize();
+    expected.finalize();
+
+    std::vector<std::string> probes = keys;
+    for (const char *probe : { "", "0", "abcdefgh", "abcdefgh5", "abcdefghi", "abcdefghij99", "b", "zzz", "\x7f" })
+        probes.emplace_back(probe);
+    for (auto &probe : probes) {
+        REQUIRE(std::distance(idx.begin(), idx.lower_bound(probe.c_str())) ==
+                std::distance(expected.begin(), expected.lower_bound(probe.c_str())));
+        REQUIRE(std::distance(idx.begin(), idx.upper_bound(probe.c_str())) ==
+                std::distance(expected.begin(), expected.upper_bound(probe.c_str())));
+    }
+}
+
+TEST_CASE("Database::add_index_async()", "[core][storage][index]")
+{
+    auto &table = create_table(1000);
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+    const Schema key_schema = table.schema();
+
+    /* Block the bulkload until the test releases it. */
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    DB.add_index_async(std::make_unique<ArrayIndex<int32_t>>(), table.name(), C.pool("val"), C.pool("idx"),
+                       [&](IndexBase &index) { released.wait(); index.bulkload(table, key_schema); });
+    CHECK(DB.has_index(C.pool("idx")));
+    CHECK_FALSE(DB.has_index(table.name(), C.pool("val"), IndexMethod::Array)); // not used while building
+
+    SECTION("completed")
+    {
+        release.set_value();
+        DB.wait_for_indexes(table.name());
+        REQUIRE(DB.has_index(table.name(), C.pool("val"), IndexMethod::Array));
+        CHECK(DB.get_index(table.name(), C.pool("val"), IndexMethod::Array).num_entries() == 1000);
+    }
+
+    SECTION("invalidated while building")
+    {
+        DB.invalidate_indexes(table.name());
+        release.set_value();
+        DB.wait_for_indexes(table.name());
+        CHECK_FALSE(DB.has_index(table.name(), C.pool("val"), IndexMethod::Array));
+    }
+}
+
+TEST_CASE("CompositeIndex::encode()", "[core][storage][index]")
+{
+    /* Returns the normalized encoding of `value` of type `type`. */
+    auto encode = [](const Type &type, Value value) {
+        CompositeIndex::key_type key;
+        CompositeIndex::encode(key, type, value);
+        return key;
+    };
+
+    /* Returns the normalized encoding of `NULL` of type `type`. */
+    auto encode_null = [](const Type &type) {
+        CompositeIndex::key_type key;
+        CompositeIndex::encode_null(key, type);
+        return key;
+    };
+
+    /*----- Encodings compare like their values and start with a NULL indicator byte. -----*/
+    auto i4 = Type::Get_Integer(Type::TY_Vector, 4);
+    CHECK(encode(*i4, int64_t(-5)).size() == 5);
+    CHECK(encode(*i4, int64_t(-5)) < encode(*i4, int64_t(-1)));
+    CHECK(encode(*i4, int64_t(-1)) < encode(*i4, int64_t(0)));
+    CHECK(encode(*i4, int64_t(0)) < encode(*i4, int64_t(256)));
+
+    auto d = Type::Get_Double(Type::TY_Vector);
+    CHECK(encode(*d, -2.5) < encode(*d, -0.5));
+    CHECK(encode(*d, -0.5) < encode(*d, 0.));
+    CHECK(encode(*d, 0.) < encode(*d, 1e-3));
+    CHECK(encode(*d, 1e-3) < encode(*d, 7.));
+
+    auto c = Type::Get_Char(Type::TY_Vector, 4);
+    CHECK(encode(*c, "ab").size() == 5);
+    CHECK(encode(*c, "ab") < encode(*c, "abc"));
+    CHECK(encode(*c, "abc") < encode(*c, "b"));
+
+    /*----- `NULL` has an encoding of the same width that compares less than all values. -----*/
+    CHECK(encode_null(*i4).size() == 5);
+    CHECK(encode_null(*i4) < encode(*i4, int64_t(std::numeric_limits<int32_t>::min())));
+    CHECK(encode_null(*d) < encode(*d, -std::numeric_limits<double>::infinity()));
+    CHECK(encode_null(*c).size() == 5);
+    CHECK(encode_null(*c) < encode(*c, ""));
+}
+
+TEST_CASE("CompositeIndex::bulkload()", "[core][storage][index]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+    table.push_back(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("b"), Type::Get_Integer(Type::TY_Vector, 8));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    /*----- Insert all pairs of `a` in [-2, 2) and `b` in [0, 10), and a row with `b` being NULL. -----*/
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (int64_t a = -2; a != 2; ++a) {
+        for (int64_t b = 9; b >= 0; --b) {
+            tup.set(0, a);
+            tup.set(1, b);
+            W.append(tup);
+        }
+    }
+    tup.set(0, int64_t(0));
+    tup.null(1);
+    W.append(tup);
+
+    /*----- Bulkload the index on `(a, b)`. -----*/
+    const Schema S = table.schema();
+    REQUIRE_THROWS_AS(CompositeIndex().bulkload(table, Schema()), invalid_argument);
+    Schema key_schema;
+    key_schema.add(S[0]);
+    key_schema.add(S[1]);
+    CompositeIndex idx;
+    idx.bulkload(table, key_schema);
+    REQUIRE(idx.finalized());
+    REQUIRE(idx.num_entries() == 41); // the row with NULL is indexed as well
+    for (auto it = idx.begin() + 1; it != idx.end(); ++it)
+        REQUIRE((it - 1)->first < it->first);
+
+    /* Returns the encoding of the prefix `a` or `(a, b)`. */
+    auto prefix = [&](int64_t a, std::optional<int64_t> b = std::nullopt) {
+        CompositeIndex::key_type key;
+        CompositeIndex::encode(key, *S[0].type, a);
+        if (b) CompositeIndex::encode(key, *S[1].type, *b);
+        return key;
+    };
+
+    SECTION("equality on prefix")
+    {
+        auto first = idx.lower_bound(prefix(-1));
+        auto last = idx.upper_bound(prefix(-1));
+        REQUIRE(std::distance(first, last) == 10);
+        CHECK(first->second == 10 + 9); // row of `(-1, 0)`
+        CHECK((last - 1)->second == 10); // row of `(-1, 9)`
+        CHECK(idx.lower_bound(prefix(5)) == idx.end());
+        CHECK(idx.lower_bound(prefix(-5)) == idx.upper_bound(prefix(-5)));
+
+        /* The row of `(0, NULL)` starts the entries of `a = 0`. */
+        first = idx.lower_bound(prefix(0));
+        last = idx.upper_bound(prefix(0));
+        REQUIRE(std::distance(first, last) == 11);
+        CHECK(first->second == 40);
+        CHECK(std::distance(idx.lower_bound(prefix(0) + CompositeIndex::NOT_NULL_BYTE), last) == 10);
+    }
+
+    SECTION("equality on prefix and range on last attribute")
+    {
+        /* a = 1 AND b >= 3 AND b < 7 */
+        auto first = idx.lower_bound(prefix(1, 3));
+        auto last = idx.lower_bound(prefix(1, 7));
+        REQUIRE(std::distance(first, last) == 4);
+        CHECK(first->second == 30 + 6); // row of `(1, 3)`
+
+        /* a = 1 AND b > 3 AND b <= 7 */
+        first = idx.upper_bound(prefix(1, 3));
+        last = idx.upper_bound(prefix(1, 7));
+        REQUIRE(std::distance(first, last) == 4);
+        CHECK(first->second == 30 + 5); // row of `(1, 4)`
+
+        /* a = 1 AND b > 8 */
+        CHECK(std::distance(idx.upper_bound(prefix(1, 8)), idx.upper_bound(prefix(1))) == 1);
+    }
+}
@@ -0,0 +1,116 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/RowStore.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/LayoutAdvisor.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+TEST_CASE("LayoutAdvisor/advise_layout", "[core][storage][layout_advisor]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    for (auto name : { "a", "b", "c", "d" })
+        table.push_back(C.pool(name), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+    auto &stats = table.store().access_statistics();
+
+    CHECK_FALSE(advise_layout(table).has_value());
+
+    SECTION("wide point reads")
+    {
+        stats.record(4, true);
+        stats.record(3, true);
+        stats.record(1, false);
+        CHECK(stats.num_accesses() == 3);
+        CHECK(stats.avg_attrs_read() == Approx(8. / 3));
+        CHECK(advise_layout(table) == C.pool("Row"));
+    }
+
+    SECTION("narrow point reads")
+    {
+        stats.record(1, true);
+        stats.record(1, true);
+        CHECK(advise_layout(table) == C.pool("PAX4K"));
+    }
+
+    SECTION("wide scans")
+    {
+        stats.record(4, false);
+        stats.record(2, false);
+        stats.record(1, true);
+        CHECK(advise_layout(table) == C.pool("PAX4M"));
+    }
+
+    SECTION("narrow scans")
+    {
+        stats.record(1, false);
+        stats.record(2, false);
+        CHECK(advise_layout(table) == C.pool("PAX64M"));
+    }
+
+    SECTION("clear")
+    {
+        stats.record(1, false);
+        stats.clear();
+        CHECK(stats.num_accesses() == 0);
+        CHECK_FALSE(advise_layout(table).has_value());
+    }
+}
+
+TEST_CASE("change_layout", "[core][storage][layout_advisor]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("i8"), Type::Get_Integer(Type::TY_Vector, 8));
+    table.push_back(C.pool("f"),  Type::Get_Float(Type::TY_Vector));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (int64_t i = 0; i != 100; ++i) {
+        tup.set(0, i);
+        if (i % 7 == 0)
+            tup.null(1);
+        else
+            tup.set(1, float(i) / 2);
+        W.append(tup);
+    }
+
+    auto check_contents = [&]() {
+        const Schema &S = W.schema();
+        for (std::size_t i = 0; i != 100; ++i) {
+            Tuple tup(S);
+            Tuple *args[] = { &tup };
+            Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S, i)(args);
+            CHECK(tup.get(0).as_i() == int64_t(i));
+            if (i % 7 == 0)
+                CHECK(tup.is_null(1));
+            else
+                CHECK(tup.get(1).as_f() == float(i) / 2);
+        }
+    };
+
+    /*----- Reorganize from row to PAX layout. -----*/
+    change_layout(table, PAXLayoutFactory(PAXLayoutFactory::NTuples, 16));
+    CHECK_FALSE(table.layout().is_finite());
+    CHECK(table.layout().child().num_tuples() == 16);
+    check_contents();
+
+    /*----- Reorganize back to row layout. -----*/
+    change_layout(table, C.data_layout(C.pool("Row")));
+    CHECK(table.layout().child().num_tuples() == 1);
+    check_contents();
+}
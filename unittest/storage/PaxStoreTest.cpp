@@ -111,7 +111,11 @@ TEST_CASE("PaxStore sanity checks", "[core][storage][columnstore]")
 
     SECTION("append")
     {
+        REQUIRE(store.capacity() == capacity);
         while (store.num_rows() < capacity) store.append();
-        REQUIRE_THROWS_AS(store.append(), std::logic_error);
+        store.append(); // grow
+        CHECK(store.num_rows() == capacity + 1);
+        CHECK(store.capacity() == 2 * capacity);
+        CHECK(store.memory().size() == 2 * PaxStore::ALLOCATION_SIZE);
     }
 }
@@ -107,7 +107,11 @@ TEST_CASE("RowStore sanity checks", "[core][storage][columnstore]")
 
     SECTION("append")
     {
+        REQUIRE(store.capacity() == capacity);
         while (store.num_rows() < capacity) store.append();
-        REQUIRE_THROWS_AS(store.append(), std::logic_error);
+        store.append(); // grow
+        CHECK(store.num_rows() == capacity + 1);
+        CHECK(store.capacity() == 2 * capacity);
+        CHECK(store.memory().size() == 2 * RowStore::ALLOCATION_SIZE);
     }
 }
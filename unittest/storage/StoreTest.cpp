@@ -7,6 +7,9 @@
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/memory.hpp>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 
 
 using namespace m;
@@ -50,3 +53,61 @@ TEST_CASE("Store", "[core][storage]")
         TEST(PaxStore);
     }
 }
+
+TEST_CASE("Store/grows_in_place", "[core][storage]")
+{
+    Catalog &C = Catalog::Get();
+    ConcreteTable table(C.pool("mytable"));
+    table.push_back(C.pool("i4"), Type::Get_Integer(Type::TY_Vector, 4));
+
+    CHECK(C.create_store(C.pool("RowStore"), table)->grows_in_place());
+    CHECK(C.create_store(C.pool("PaxStore"), table)->grows_in_place());
+    CHECK_FALSE(C.create_store(C.pool("ColumnStore"), table)->grows_in_place()); // columns move when growing
+}
+
+TEST_CASE("Store/shared_memory_latch", "[core][storage]")
+{
+    /* Tries to acquire the latch exclusively from another thread, like a writer growing a store. */
+    auto is_latched = []() {
+        bool is_latched;
+        std::thread writer([&is_latched]() {
+            std::unique_lock<std::shared_mutex> lock(Store::Memory_Latch(), std::try_to_lock);
+            is_latched = not lock.owns_lock();
+        });
+        writer.join();
+        return is_latched;
+    };
+
+    SECTION("nesting")
+    {
+        {
+            Store::shared_memory_latch outer;
+            CHECK(is_latched());
+            {
+                Store::shared_memory_latch inner; // must not acquire the latch again
+                CHECK(is_latched());
+            }
+            CHECK(is_latched()); // still held by `outer`
+        }
+        CHECK_FALSE(is_latched());
+    }
+
+    SECTION("unlock")
+    {
+        Store::shared_memory_latch latch;
+        latch.unlock();
+        CHECK_FALSE(is_latched());
+        latch.lock();
+        CHECK(is_latched());
+    }
+
+    SECTION("within exclusive latch")
+    {
+        Store::exclusive_memory_latch exclusive;
+        {
+            Store::shared_memory_latch shared; // must not deadlock
+            CHECK(is_latched());
+        }
+        CHECK(is_latched()); // still held exclusively
+    }
+}
@@ -0,0 +1,143 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/RowStore.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/VisibilitySummary.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+TEST_CASE("VisibilitySummary/decide", "[core][storage][visibility_summary]")
+{
+    VisibilitySummary::entry_type e;
+    e.update(3, -1);
+    e.update(5, -1);
+
+    CHECK(e.decide(true, ZoneMap::LE, 5) == VisibilitySummary::ALWAYS);
+    CHECK(e.decide(true, ZoneMap::LE, 4) == VisibilitySummary::SOMETIMES);
+    CHECK(e.decide(true, ZoneMap::LE, 2) == VisibilitySummary::NEVER);
+    CHECK(e.decide(true, ZoneMap::GT, 2) == VisibilitySummary::ALWAYS);
+    CHECK(e.decide(true, ZoneMap::GT, 5) == VisibilitySummary::NEVER);
+    CHECK(e.decide(true, ZoneMap::EQ, 4) == VisibilitySummary::SOMETIMES);
+    CHECK(e.decide(true, ZoneMap::EQ, 6) == VisibilitySummary::NEVER);
+    CHECK(e.decide(false, ZoneMap::EQ, -1) == VisibilitySummary::ALWAYS);
+    CHECK(e.decide(false, ZoneMap::GT, 4) == VisibilitySummary::NEVER);
+}
+
+TEST_CASE("VisibilitySummary/summarize_visibility", "[core][storage][visibility_summary]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    ConcreteTableFactoryDecorator<MultiVersioningTable> factory(std::make_unique<ConcreteTableFactory>());
+    auto &table = DB.add(factory.make(C.pool("test")));
+    table.push_back(C.pool("i4"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+
+    /*----- Fill two blocks, each with versions that began at the block's index and that are not ended. -----*/
+    constexpr std::size_t num_rows = VisibilitySummary::NUM_ROWS_PER_BLOCK + 10;
+    StoreWriter W(table.store());
+    const Schema &S = W.schema();
+    const std::size_t idx_ts_begin = S[{ table.name(), C.pool("$ts_begin") }].first;
+    const std::size_t idx_ts_end = S[{ table.name(), C.pool("$ts_end") }].first;
+    Tuple tup(S);
+    for (std::size_t i = 0; i != num_rows; ++i) {
+        tup.set(S[{ table.name(), C.pool("i4") }].first, int64_t(i));
+        tup.set(idx_ts_begin, int64_t(i / VisibilitySummary::NUM_ROWS_PER_BLOCK));
+        tup.set(idx_ts_end, int64_t(-1));
+        W.append(tup);
+    }
+
+    auto e0 = summarize_visibility(table, 0);
+    CHECK(e0.min_ts_begin == 0);
+    CHECK(e0.max_ts_begin == 0);
+    CHECK(e0.min_ts_end == -1);
+    CHECK(e0.max_ts_end == -1);
+    auto e1 = summarize_visibility(table, 1);
+    CHECK(e1.min_ts_begin == 1);
+    CHECK(e1.max_ts_begin == 1);
+
+    auto &summary = table.store().visibility_summary();
+    CHECK(summary.get(0, VisibilitySummary::NUM_ROWS_PER_BLOCK).has_value());
+    CHECK(summary.get(1, 10).has_value());
+    CHECK_FALSE(summary.get(1, 11).has_value()); // the summary does not cover rows appended later
+
+    SECTION("writing timestamps invalidates")
+    {
+        write_timestamps(table, C.pool("$ts_end"), 1, 2, 7);
+        CHECK_FALSE(summary.get(0, VisibilitySummary::NUM_ROWS_PER_BLOCK).has_value());
+        CHECK(summary.get(1, 10).has_value());
+
+        e0 = summarize_visibility(table, 0);
+        CHECK(e0.min_ts_end == -1);
+        CHECK(e0.max_ts_end == 7);
+    }
+
+    SECTION("dropping rows invalidates")
+    {
+        table.store().drop();
+        CHECK_FALSE(summary.get(1, 10).has_value());
+        CHECK(summary.get(0, VisibilitySummary::NUM_ROWS_PER_BLOCK).has_value());
+    }
+
+    SECTION("outdated summaries are discarded")
+    {
+        const uint64_t version = summary.version(1);
+        summary.invalidate(num_rows - 1, num_rows);
+        summary.put(1, 10, version, e1);
+        CHECK_FALSE(summary.get(1, 10).has_value());
+    }
+}
+
+TEST_CASE("collect_garbage", "[core][storage][visibility_summary]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    ConcreteTableFactoryDecorator<MultiVersioningTable> factory(std::make_unique<ConcreteTableFactory>());
+    auto &table = DB.add(factory.make(C.pool("test")));
+    table.push_back(C.pool("i4"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+
+    /*----- Insert versions ended at times 0 to 9 interleaved with versions that are not ended. -----*/
+    StoreWriter W(table.store());
+    const Schema &S = W.schema();
+    const std::size_t idx_i4 = S[{ table.name(), C.pool("i4") }].first;
+    const std::size_t idx_ts_end = S[{ table.name(), C.pool("$ts_end") }].first;
+    Tuple tup(S);
+    for (int64_t i = 0; i != 20; ++i) {
+        tup.set(idx_i4, i);
+        tup.set(S[{ table.name(), C.pool("$ts_begin") }].first, int64_t(0));
+        tup.set(idx_ts_end, i % 2 ? int64_t(-1) : i / 2);
+        W.append(tup);
+    }
+
+    CHECK(collect_garbage(table, 4) == 5); // the versions ended at times 0 to 4
+    REQUIRE(table.store().num_rows() == 15);
+    CHECK(table.store().zone_map().covers(15));
+    CHECK(collect_garbage(table, 4) == 0);
+
+    /*----- The retained versions are compacted in their order. -----*/
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i != 20; ++i) {
+        if (i % 2 or i / 2 > 4)
+            expected.push_back(i);
+    }
+    std::vector<int64_t> values;
+    auto loader = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S);
+    Tuple *args[] = { &tup };
+    for (std::size_t row_id = 0; row_id != table.store().num_rows(); ++row_id) {
+        loader(args);
+        values.push_back(tup.get(idx_i4).as_i());
+        CHECK((tup.get(idx_ts_end).as_i() == -1 or tup.get(idx_ts_end).as_i() > 4));
+    }
+    CHECK(values == expected);
+    CHECK(table.store().zone_map().get(0, table[C.pool("i4")].id).min.as_i() == 1);
+}
@@ -0,0 +1,85 @@
+#include "catch2/catch.hpp"
+
+#include "storage/RowStore.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/ZoneMap.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+TEST_CASE("ZoneMap", "[core][storage][zone_map]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    table.push_back(C.pool("i4"),     Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("d"),      Type::Get_Double(Type::TY_Vector));
+    table.push_back(C.pool("char15"), Type::Get_Char(Type::TY_Vector, 15));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(RowLayoutFactory());
+
+    /*----- Fill two blocks; the second block contains only NULL values for `d`. -----*/
+    constexpr std::size_t num_rows = ZoneMap::NUM_ROWS_PER_BLOCK + 10;
+    StoreWriter W(table.store());
+    Tuple tup(W.schema());
+    for (std::size_t i = 0; i != num_rows; ++i) {
+        tup.set(0, int64_t(i));
+        if (i < ZoneMap::NUM_ROWS_PER_BLOCK)
+            tup.set(1, double(i) / 2);
+        else
+            tup.null(1);
+        tup.set(2, "abc");
+        W.append(tup);
+    }
+
+    auto &zone_map = table.store().zone_map();
+    REQUIRE(zone_map.covers(num_rows));
+    REQUIRE(zone_map.num_blocks() == 2);
+    CHECK(zone_map.is_tracked(0));
+    CHECK(zone_map.is_tracked(1));
+    CHECK_FALSE(zone_map.is_tracked(2));
+    CHECK(zone_map.is_floating_point(1));
+
+    SECTION("summaries")
+    {
+        CHECK(zone_map.get(0, 0).min.as_i() == 0);
+        CHECK(zone_map.get(0, 0).max.as_i() == int64_t(ZoneMap::NUM_ROWS_PER_BLOCK - 1));
+        CHECK(zone_map.get(1, 0).min.as_i() == int64_t(ZoneMap::NUM_ROWS_PER_BLOCK));
+        CHECK(zone_map.get(1, 0).max.as_i() == int64_t(num_rows - 1));
+        CHECK(zone_map.get(0, 1).num_nulls == 0);
+        CHECK(zone_map.get(1, 1).num_nulls == 10);
+    }
+
+    SECTION("may_satisfy")
+    {
+        CHECK(zone_map.may_satisfy(0, 0, ZoneMap::EQ, int64_t(42)));
+        CHECK_FALSE(zone_map.may_satisfy(1, 0, ZoneMap::EQ, int64_t(42)));
+        CHECK(zone_map.may_satisfy(0, 0, ZoneMap::LE, int64_t(0)));
+        CHECK_FALSE(zone_map.may_satisfy(0, 0, ZoneMap::LT, int64_t(0)));
+        CHECK_FALSE(zone_map.may_satisfy(0, 0, ZoneMap::GT, int64_t(ZoneMap::NUM_ROWS_PER_BLOCK - 1)));
+        CHECK(zone_map.may_satisfy(1, 0, ZoneMap::GE, int64_t(num_rows - 1)));
+        CHECK(zone_map.may_satisfy(0, 1, ZoneMap::LT, 0.5));
+        CHECK_FALSE(zone_map.may_satisfy(0, 1, ZoneMap::LT, 0.));
+        CHECK_FALSE(zone_map.may_satisfy(1, 1, ZoneMap::GE, 0.)); // only NULL values
+    }
+
+    SECTION("dropping summarized rows renders the zone map incomplete")
+    {
+        table.store().drop();
+        CHECK_FALSE(zone_map.covers(num_rows - 1));
+        W.append(tup);
+        CHECK_FALSE(zone_map.covers(num_rows));
+    }
+
+    SECTION("rows not reported render the zone map incomplete")
+    {
+        table.store().append(); // append a row without reporting it
+        W.append(tup);
+        CHECK_FALSE(zone_map.covers(table.store().num_rows()));
+    }
+}
@@ -13,6 +13,21 @@ TEST_CASE("memory::AddressSpace", "[core][util][memory]")
     AddressSpace vm(10000);
     REQUIRE(vm.addr());
     REQUIRE(vm.size() >= 10000);
+    REQUIRE(vm.as<uintptr_t>() % HUGE_PAGE_SIZE == 0);
+}
+
+TEST_CASE("memory::Backing", "[core][util][memory]")
+{
+    Backing backing;
+    CHECK(backing.granularity() == get_pagesize());
+    backing.huge_pages = Backing::HP_Transparent;
+    CHECK(backing.granularity() == get_pagesize());
+    backing.huge_pages = Backing::HP_Explicit;
+    CHECK(backing.granularity() == HUGE_PAGE_SIZE);
+
+    Backing invalid_node;
+    invalid_node.numa_node = 1 << 20;
+    CHECK_THROWS_AS(LinearAllocator(invalid_node), std::invalid_argument);
 }
 
 TEST_CASE("memory::Memory/c'tor", "[core][util][memory]")
@@ -90,6 +105,38 @@ TEST_CASE("memory::LinearAllocator", "[core][util][memory]")
 #elif __APPLE__
 #endif
 
+    SECTION("grow")
+    {
+        auto mem = A.allocate(PAGE_SIZE);
+        auto pi = mem.as<unsigned*>();
+        for (std::size_t i = 0; i != INTS_PER_PAGE; ++i)
+            pi[i] = i;
+
+        A.grow(mem, 3 * PAGE_SIZE);
+        CHECK(mem.size() == 3 * PAGE_SIZE);
+        CHECK(A.offset() == 3 * PAGE_SIZE);
+
+        /* Check contents are retained and grown memory is writable. */
+        auto old_pi = pi;
+        pi = mem.as<unsigned*>();
+        for (std::size_t i = 0; i != INTS_PER_PAGE; ++i)
+            REQUIRE(pi[i] == i);
+        for (std::size_t i = INTS_PER_PAGE; i != 3 * INTS_PER_PAGE; ++i)
+            pi[i] = i;
+        for (std::size_t i = 0; i != 3 * INTS_PER_PAGE; ++i)
+            REQUIRE(pi[i] == i);
+
+        /* Check the previous address range is still mapped to the same contents. */
+        pi[0] = 42;
+        CHECK(old_pi[0] == 42);
+        for (std::size_t i = 1; i != INTS_PER_PAGE; ++i)
+            REQUIRE(old_pi[i] == i);
+
+        /* Only the most recent allocation can grow. */
+        auto mem1 = A.allocate(PAGE_SIZE);
+        REQUIRE_THROWS_AS(A.grow(mem, 4 * PAGE_SIZE), std::invalid_argument);
+    }
+
     SECTION("map to address space")
     {
         auto mem = A.allocate(2 * PAGE_SIZE); // 2 pages